@@ -0,0 +1,270 @@
+/*********************************************************************
+ * \file		Logger.cpp
+ * \brief		Queue and writer thread behind the Logger
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		1 September 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its contents without the
+ *				prior written consent of DigiPen Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#if __has_include(<format>)
+#include <format>
+#endif
+
+namespace {
+    constexpr auto WRITER_IDLE_TIMEOUT = std::chrono::milliseconds(10); // Upper bound on a missed wake-up.
+    constexpr std::string_view TRUNCATED_SUFFIX = "...";
+
+    const char* LevelTag(Logger::Level level) {
+        switch (level) {
+        case Logger::Level::DEBUG: return " [DEBUG] ";
+        case Logger::Level::INFO:  return " [INFO] ";
+        case Logger::Level::WARN:  return " [WARN] ";
+        case Logger::Level::ERR:   return " [ERROR] ";
+        }
+        return " ";
+    }
+}
+
+Logger::Logger() : records(std::make_unique<Record[]>(QUEUE_CAPACITY)) {
+    static_assert((QUEUE_CAPACITY & (QUEUE_CAPACITY - 1)) == 0, "QUEUE_CAPACITY must be a power of two");
+
+    for (size_t i = 0; i < QUEUE_CAPACITY; ++i) {
+        records[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    logBuffer.reserve(MAX_LOGS);
+
+#ifndef INSTALLER
+    std::filesystem::path logDir = "../Logs";
+    if (!std::filesystem::exists(logDir)) {
+        std::filesystem::create_directories(logDir);
+    }
+    fileStream.open(logDir / "log.txt", std::ios::app);
+
+    writer = std::thread(&Logger::WriterLoop, this);
+
+    if (!fileStream.is_open()) {
+        Log(Level::WARN, "Unable to create log files for this session");
+    }
+#endif
+}
+
+Logger::~Logger() {
+    if (writer.joinable()) {
+        stopping.store(true, std::memory_order_release);
+        wakeCondition.notify_one();
+        writer.join();
+    }
+
+    if (fileStream.is_open()) {
+        fileStream.close();
+    }
+#if defined(_DEBUG) && defined(_MSC_VER)
+    // To prevent timezone database allocations from being reported as memory leaks.
+    std::chrono::get_tzdb_list().~tzdb_list();
+#endif
+}
+
+std::ostringstream& Logger::GetThreadStream() {
+    // Constructing a stream is expensive, so each thread keeps one and empties it for every message.
+    thread_local std::ostringstream stream;
+    stream.str(std::string{});
+    stream.clear();
+    return stream;
+}
+
+void Logger::Enqueue(Level level, std::string_view message) {
+    std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+
+    // Claim a slot. A slot is free for position p when its sequence equals p.
+    uint64_t position = enqueuePosition.load(std::memory_order_relaxed);
+    Record* record = nullptr;
+    while (true) {
+        record = &records[position & (QUEUE_CAPACITY - 1)];
+        uint64_t sequence = record->sequence.load(std::memory_order_acquire);
+        int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+
+        if (difference == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (difference < 0) {
+            // The writer has not caught up with this slot yet; the queue is full.
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    record->level = level;
+    record->time = now;
+    if (message.size() > MAX_MESSAGE_LENGTH) {
+        size_t kept = MAX_MESSAGE_LENGTH - TRUNCATED_SUFFIX.size();
+        std::memcpy(record->text, message.data(), kept);
+        std::memcpy(record->text + kept, TRUNCATED_SUFFIX.data(), TRUNCATED_SUFFIX.size());
+        record->length = static_cast<uint32_t>(MAX_MESSAGE_LENGTH);
+    }
+    else {
+        std::memcpy(record->text, message.data(), message.size());
+        record->length = static_cast<uint32_t>(message.size());
+    }
+    record->sequence.store(position + 1, std::memory_order_release);
+
+    if (writerIdle.load(std::memory_order_relaxed)) {
+        wakeCondition.notify_one();
+    }
+}
+
+void Logger::Flush() {
+    if (!writer.joinable()) {
+        return;
+    }
+
+    uint64_t target = enqueuePosition.load(std::memory_order_acquire);
+    wakeCondition.notify_one();
+
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    flushedCondition.wait(lock, [this, target] {
+        return writtenPosition.load(std::memory_order_acquire) >= target;
+    });
+}
+
+void Logger::WriterLoop() {
+    std::string batch;
+
+    while (true) {
+        bool stop = stopping.load(std::memory_order_acquire);
+        size_t count = Drain(batch);
+
+        if (!batch.empty()) {
+            if (fileStream.is_open()) {
+                fileStream.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+                fileStream.flush();
+            }
+            batch.clear();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            writtenPosition.store(dequeuePosition, std::memory_order_release);
+        }
+        flushedCondition.notify_all();
+
+        if (count > 0) {
+            continue;
+        }
+        if (stop) {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        writerIdle.store(true, std::memory_order_relaxed);
+        wakeCondition.wait_for(lock, WRITER_IDLE_TIMEOUT);
+        writerIdle.store(false, std::memory_order_relaxed);
+    }
+}
+
+size_t Logger::Drain(std::string& batch) {
+    size_t count = 0;
+
+    while (true) {
+        Record& record = records[dequeuePosition & (QUEUE_CAPACITY - 1)];
+        if (record.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+            break;
+        }
+
+        AppendLine(batch, record.level, record.time, std::string_view(record.text, record.length));
+
+        // Hand the slot back to the producers for the next lap around the queue.
+        record.sequence.store(dequeuePosition + QUEUE_CAPACITY, std::memory_order_release);
+        ++dequeuePosition;
+        ++count;
+    }
+
+    uint64_t dropped = droppedCount.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        std::string message = std::to_string(dropped) + " log messages were dropped because the log queue was full";
+        AppendLine(batch, Level::WARN, std::chrono::system_clock::now(), message);
+    }
+
+    return count;
+}
+
+void Logger::AppendLine(std::string& batch, Level level, std::chrono::system_clock::time_point time, std::string_view message) {
+    std::string line = FormatTimestamp(time);
+    line += LevelTag(level);
+    line += message;
+
+    batch += line;
+    batch += '\n';
+
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+        if (logBuffer.size() < MAX_LOGS) {
+            logBuffer.push_back(std::move(line));
+        }
+        else {
+            // Overwrite the oldest message.
+            logBuffer[logBufferStart] = std::move(line);
+            logBufferStart = (logBufferStart + 1) % MAX_LOGS;
+        }
+    }
+    bufferVersion.fetch_add(1, std::memory_order_release);
+}
+
+std::string const& Logger::FormatTimestamp(std::chrono::system_clock::time_point time) {
+    std::chrono::sys_seconds second = std::chrono::floor<std::chrono::seconds>(time);
+    if (second == cachedSecond && !cachedTimestamp.empty()) {
+        return cachedTimestamp;
+    }
+    cachedSecond = second;
+
+#if defined(__cpp_lib_format) && defined(__cpp_lib_chrono) && __cpp_lib_chrono >= 201907L
+    // Looking up the zone is the slow part; the database does not change while the engine runs.
+    static const std::chrono::time_zone* zone = std::chrono::current_zone();
+    cachedTimestamp = std::format("{:%Y-%m-%d %X}", zone->to_local(second));
+#else
+    // Standard libraries without time zone support (e.g. Linux headless builds).
+    std::time_t seconds = std::chrono::system_clock::to_time_t(second);
+    std::tm localTime{};
+    localtime_r(&seconds, &localTime);
+    std::ostringstream stream;
+    stream << std::put_time(&localTime, "%Y-%m-%d %X");
+    cachedTimestamp = stream.str();
+#endif
+
+    return cachedTimestamp;
+}
+
+std::vector<std::string> Logger::GetSafeLogBuffer() const {
+    std::lock_guard<std::mutex> lock(logMutex); // Ensure thread safety
+
+    std::vector<std::string> logs;
+    logs.reserve(logBuffer.size());
+    for (size_t i = 0; i < logBuffer.size(); ++i) {
+        logs.push_back(logBuffer[(logBufferStart + i) % logBuffer.size()]);
+    }
+    return logs;
+}
+
+void Logger::ClearBuffer() {
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+        logBuffer.clear();
+        logBufferStart = 0;
+    }
+    bufferVersion.fetch_add(1, std::memory_order_release);
+}
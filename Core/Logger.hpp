@@ -16,6 +16,7 @@
 #ifndef LOGGER_HPP
 #define LOGGER_HPP
 
+#ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX // Prevents Windows.h from defining min and max macros
 #ifdef APIENTRY
@@ -23,13 +24,21 @@
 #endif
 
 #include <Windows.h>
-#include <iostream>
-#include <fstream>
-#include <string>
-#include <sstream>
-#include <filesystem>
+#endif
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
 #include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #define BLUE			9
 #define GREEN			10
@@ -37,13 +46,22 @@
 #define YELLOW			14
 #define WHITE			15
 
+// Messages below this level are compiled out: 0 DEBUG, 1 INFO, 2 WARN, 3 ERR.
+#ifndef KIGEN_LOG_LEVEL
+#define KIGEN_LOG_LEVEL 0
+#endif
+
 /**
  * \class Logger
- * \brief Singleton class responsible for logging messages to both the console and a log file.
+ * \brief Singleton class responsible for logging messages to a log file and the editor console.
  *
  * The Logger class provides functionality for logging messages with different levels (DEBUG, INFO, WARN, ERR).
- * The log messages are written to both the console and a file. Additionally, the logger can be configured to
- * only display messages of a certain severity level or higher.
+ * Log only formats the message on the calling thread and pushes it into a bounded lock-free queue. A background
+ * thread stamps the time, appends the message to the console buffer and writes it to the log file in batches, so
+ * logging never blocks on the file. When the queue is full, messages are dropped and the number lost is logged once
+ * there is room again.
+ *
+ * Messages can be filtered at compile time with KIGEN_LOG_LEVEL, and at runtime with SetLevel.
  */
 class Logger {
 public:
@@ -58,6 +76,11 @@ public:
         ERR     /**< Error messages */
     };
 
+    static constexpr Level COMPILED_LEVEL = static_cast<Level>(KIGEN_LOG_LEVEL); /**< Lowest level compiled in. */
+    static constexpr size_t MAX_LOGS = 100;             /**< Number of messages kept for the editor console. */
+    static constexpr size_t QUEUE_CAPACITY = 4096;      /**< Number of messages that can wait for the writer. Power of two. */
+    static constexpr size_t MAX_MESSAGE_LENGTH = 480;   /**< Longer messages are truncated. */
+
     // Delete copy constructor and assignment operator to enforce singleton pattern
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
@@ -74,17 +97,9 @@ public:
     /**
      * \brief Destructor for the Logger class.
      *
-     * Closes the log file if it is open, and handles any necessary cleanup in debug mode.
+     * Writes out the messages still queued, stops the writer thread and closes the log file.
      */
-    ~Logger() {
-        if (fileStream.is_open()) {
-            fileStream.close();
-        }
-#ifdef _DEBUG
-        // To prevent timezone database allocations from being reported as memory leaks.
-        std::chrono::get_tzdb_list().~tzdb_list();
-#endif
-    }
+    ~Logger();
 
     /**
      * \brief Sets the logging level for the Logger.
@@ -93,14 +108,25 @@ public:
      * \param level The minimum severity level for log messages.
      */
     void SetLevel(Level level) {
-        logLevel = level;
+        logLevel.store(level, std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Checks whether messages of a level are logged.
+     *
+     * Use this to skip building expensive log arguments.
+     * \param level The severity level to check.
+     * \return True if messages of this level are logged.
+     */
+    bool IsEnabled(Level level) const {
+        return level >= COMPILED_LEVEL && level >= logLevel.load(std::memory_order_relaxed);
     }
 
     /**
      * \brief Logs a message to the console and the log file.
      *
      * This template function accepts a variable number of arguments and formats them as part of the log message.
-     * The log message is time-stamped and formatted according to the severity level.
+     * The message is queued and written by the logger thread; the time stamp is taken when this is called.
      *
      * \tparam Args Variadic template parameters representing the parts of the log message.
      * \param level The severity level of the log message.
@@ -112,73 +138,37 @@ public:
 #else
     template<typename... Args>
     void Log(Level level, const Args&... args) {
-        static const size_t MAX_LOGS = 100;
-
-        if (level < logLevel) {
+        // With a constant level, the compile-time check removes the whole call.
+        if (level < COMPILED_LEVEL || level < logLevel.load(std::memory_order_relaxed)) {
             return;
         }
 
-        std::ostringstream stream;
-
-        // Time stamping
-        std::chrono::local_time<std::chrono::system_clock::duration> currTime
-            = std::chrono::current_zone()->to_local(std::chrono::system_clock::now());
-
-        stream << std::format("{:%Y-%m-%d %X}", currTime);
-
-        switch (level) {
-        case Level::DEBUG:
-            SetConsoleTextAttribute(m_hConsole, WHITE);
-            stream << " [DEBUG] ";
-            break;
-        case Level::INFO:
-            SetConsoleTextAttribute(m_hConsole, BLUE);
-            stream << " [INFO] ";
-            break;
-        case Level::WARN:
-            SetConsoleTextAttribute(m_hConsole, YELLOW);
-            stream << " [WARN] ";
-            break;
-        case Level::ERR:
-            SetConsoleTextAttribute(m_hConsole, RED);
-            stream << " [ERROR] ";
-            break;
-        }
-
+        std::ostringstream& stream = GetThreadStream();
         (stream << ... << args);
-
-        // Output to console and file
-        std::string logMessage = stream.str();
-
-        // Add to log buffer (thread-safe)
-        {
-            std::lock_guard<std::mutex> lock(logMutex);
-
-            logBuffer.push_back(logMessage);
-
-            // Ensure buffer size does not exceed MAX_LOGS
-            if (logBuffer.size() > MAX_LOGS) {
-                logBuffer.erase(logBuffer.begin(), logBuffer.begin() + (logBuffer.size() - MAX_LOGS));
-            }
-        }
-
-
-
-        if (fileStream.is_open()) {
-            fileStream << logMessage << std::endl;
-        }
+        Enqueue(level, stream.view());
     }
 #endif
 
+    /**
+     * \brief Blocks until every message logged before this call has been written to the log file.
+     */
+    void Flush();
+
     /**
     * \brief Retrieves a thread-safe copy of the log buffer.
     *
     * The log buffer contains recent log messages and is used to display logs in a UI or for debugging purposes.
-    * \return A copy of the log messages stored in the buffer.
+    * \return A copy of the log messages stored in the buffer, oldest first.
     */
-    std::vector<std::string> GetSafeLogBuffer() {
-        std::lock_guard<std::mutex> lock(logMutex); // Ensure thread safety
-        return logBuffer; // Return a copy of the log buffer
+    std::vector<std::string> GetSafeLogBuffer() const;
+
+    /**
+    * \brief Returns a number that changes whenever the log buffer changes.
+    *
+    * Lets the editor console skip copying the buffer on frames where nothing was logged.
+    */
+    uint64_t GetBufferVersion() const {
+        return bufferVersion.load(std::memory_order_acquire);
     }
 
     /**
@@ -186,40 +176,81 @@ public:
     *
     * This method ensures thread safety while clearing the stored log messages.
     */
-    void ClearBuffer() {
-        std::lock_guard<std::mutex> lock(logMutex);
-        logBuffer.clear();
-    }
-
-
+    void ClearBuffer();
 
 private:
-    std::ofstream fileStream; /**< The output stream for writing log messages to a file. */
-    Level logLevel = Level::DEBUG; /**< The minimum severity level for log messages. */
+    /**
+     * \struct Record
+     * \brief One queued message. The sequence number tells producers and the writer whose turn the slot is.
+     */
+    struct Record {
+        std::atomic<uint64_t> sequence;
+        Level level;
+        std::chrono::system_clock::time_point time;
+        uint32_t length;
+        char text[MAX_MESSAGE_LENGTH];
+    };
 
-    std::vector<std::string> logBuffer;  // Log cache for UI
+    std::ofstream fileStream; /**< The output stream for writing log messages to a file. */
+    std::atomic<Level> logLevel = Level::DEBUG; /**< The minimum severity level for log messages. */
+
+    // Bounded multi-producer, single-consumer queue of messages waiting for the writer thread.
+    std::unique_ptr<Record[]> records;
+    std::atomic<uint64_t> enqueuePosition = 0;      // Next slot claimed by a producer.
+    uint64_t dequeuePosition = 0;                   // Next slot read by the writer. Only used by the writer.
+    std::atomic<uint64_t> droppedCount = 0;         // Messages lost because the queue was full.
+
+    std::thread writer;
+    std::atomic<bool> stopping = false;
+    std::atomic<bool> writerIdle = false;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;          // Wakes the writer when it is idle.
+    std::atomic<uint64_t> writtenPosition = 0;      // Queue position up to which everything has been written.
+    std::condition_variable flushedCondition;       // Signalled by the writer after every batch.
+
+    // Cached time stamp, so the time zone conversion runs once per second instead of once per message.
+    std::chrono::sys_seconds cachedSecond{};
+    std::string cachedTimestamp;
+
+    std::vector<std::string> logBuffer;  // Ring of the last MAX_LOGS messages for the editor console
+    size_t logBufferStart = 0;           // Index of the oldest message in logBuffer
+    std::atomic<uint64_t> bufferVersion = 0;
     mutable std::mutex logMutex;         // Thread safety for logBuffer
 
-    HANDLE m_hConsole = GetStdHandle(STD_OUTPUT_HANDLE); /**< Handle for setting the console text color. */
-
     /**
      * \brief Private constructor for the Logger class.
      *
-     * The constructor initializes the log file in the "Logs" directory and handles any initialization required
-     * for the logging system.
+     * The constructor initializes the log file in the "Logs" directory and starts the writer thread.
      */
-    Logger() {
-#ifndef INSTALLER
-        std::filesystem::path logDir = "../Logs";
-        if (!std::filesystem::exists(logDir)) {
-            std::filesystem::create_directories(logDir);
-        }
-        fileStream.open(logDir / "log.txt", std::ios::app);
-        if (!fileStream.is_open()) {
-            Log(Level::WARN, "Unable to create log files for this session");
-        }
-#endif
-    }
+    Logger();
+
+    /**
+     * \brief Returns the calling thread's message stream, emptied for a new message.
+     */
+    static std::ostringstream& GetThreadStream();
+
+    /**
+     * \brief Copies a formatted message into the queue, or counts it as dropped if the queue is full.
+     */
+    void Enqueue(Level level, std::string_view message);
+
+    /**
+     * \brief Writer thread: drains the queue and writes the messages in batches until the logger is destroyed.
+     */
+    void WriterLoop();
+
+    /**
+     * \brief Formats the queued messages into batch and adds them to the console buffer.
+     * \return Number of messages taken from the queue.
+     */
+    size_t Drain(std::string& batch);
+
+    /**
+     * \brief Appends one finished log line to the batch and the console buffer.
+     */
+    void AppendLine(std::string& batch, Level level, std::chrono::system_clock::time_point time, std::string_view message);
+
+    std::string const& FormatTimestamp(std::chrono::system_clock::time_point time);
 };
 
 #endif // LOGGER_HPP
@@ -405,8 +405,8 @@ struct Mat4 {
 	\return
 		*this * rhs.
 	*************************************************************************/
-	Vec4 operator*(const Vec4& rhs);
-	Vec3 operator*(const Vec3& rhs);
+	Vec4 operator*(const Vec4& rhs) const;
+	Vec3 operator*(const Vec3& rhs) const;
 
 	/*!***********************************************************************
 	\brief
@@ -22,7 +22,7 @@ namespace Math {
 
 }
 
-inline Vec4 Mat4::operator*(const Vec4& rhs) {
+inline Vec4 Mat4::operator*(const Vec4& rhs) const {
 	Vec4 vec4;
 	for (unsigned int i = 0; i < 4; ++i) {
 		vec4[i] = GetElement(i, 0) * rhs[0] +
@@ -33,7 +33,7 @@ inline Vec4 Mat4::operator*(const Vec4& rhs) {
 	return vec4;
 }
 
-inline Vec3 Mat4::operator*(const Vec3& rhs) {
+inline Vec3 Mat4::operator*(const Vec3& rhs) const {
 	Vec3 vec3;
 	for (unsigned int i = 0; i < 3; ++i) {
 		vec3[i] = GetElement(i, 0) * rhs.x +
@@ -18,6 +18,7 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 
 #include <ostream>
 #include <cmath>
+#include <cfloat>
 
 struct Vec3;
 struct Vec4;
@@ -17,6 +17,7 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 
 #include <ostream>
 #include <cmath>
+#include <cfloat>
 #include <algorithm>
 
 struct Vec2;
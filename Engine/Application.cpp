@@ -22,13 +22,15 @@
 #include "Timer.hpp"
 #include "Utility/EngineConfig.hpp"
 #include "Utility/Serializer.hpp"
+#include "Utility/JobSystem.hpp"
+#include "Utility/Profiler.hpp"
+#include "Graphics/Texture.hpp"
+#include "Graphics/TextureLoader.hpp"
+#include "AssetManager.hpp"
 
 #include "Tools/Gui.hpp"
 #include "Tools/Scripting/ScriptEngine.hpp"
 
- //Process Time Test
-#include "Tools/ProcessTime.hpp"
-ProcessTime processTime;
 #include "Audio/AudioManager.hpp"
 #include "Utility/EngineState.hpp"
 
@@ -66,9 +68,22 @@ void Application::Init()
 	}
 
 	GraphicsManager::GetInstance().SetInternalFormat(config.graphicsQuality);
+	GraphicsManager::GetInstance().spriteInstancing = config.spriteInstancing;
+	GraphicsManager::GetInstance().viewCulling = config.viewCulling;
+	GraphicsManager::GetInstance().cullMargin = config.cullMargin;
+	Texture::useAtlas = config.textureAtlas;
+	if (Texture::useAtlas) Texture::LoadAtlasLayout("../Assets/TextureAtlas.layout");
+	TextureLoader::GetInstance().SetUploadBudget(config.textureUploadBudget);
+
+	auto megabytes = [](double size) { return static_cast<size_t>(size * 1024.0 * 1024.0); };
+	AssetManager::GetInstance().SetBudget<Texture>(megabytes(config.textureBudget));
+	AssetManager::GetInstance().SetBudget<Font>(megabytes(config.fontBudget));
+	AssetManager::GetInstance().SetBudget<VideoClip>(megabytes(config.videoBudget));
+	AssetManager::GetInstance().SetBudget<AudioClip>(megabytes(config.audioBudget));
+	JobSystem::GetInstance().Initialize(config.workerThreads);
 
 	ScriptEngine::Init();
-	processTime.CreateDelta();
+	PROFILE_THREAD("Main");
 
 	// Register focus change callback
 	glfwSetWindowFocusCallback(m_context->GetWindow(),
@@ -104,24 +119,31 @@ void Application::Run()
 		if (!appIsRunning) {
 			break;
 		}
-		TIMER.Update();
-		SceneManager::GetInstance().UpdateScene(TIMER.GetDeltaTime(), TIMER.GetFixedDT(), TIMER.GetNumOfSteps());
-		//glfwSetWindowTitle(m_context.get()->GetWindow(), std::to_string(TIMER.GetFPS()).c_str());
+		{
+			PROFILE_SCOPE("Frame");
+
+			TIMER.Update();
+			SceneManager::GetInstance().UpdateScene(TIMER.GetDeltaTime(), TIMER.GetFixedDT(), TIMER.GetNumOfSteps());
+			//glfwSetWindowTitle(m_context.get()->GetWindow(), std::to_string(TIMER.GetFPS()).c_str());
 #ifndef INSTALLER
-		ExecuteMainThreadQueue();
-		processTime.StartDelta();//audio start timer
-
-		processTime.EndDelta(ProcessTime::AUDIO);//audio end timer
-		processTime.deltaTime.Update();//delta stop timer
-		ProcessTime::CalculatePercentageTime();//calculate percentage and prints
-		ProcessTime::UpdateTime();//fps calculator, WIP
-		if (gameWindowMode == GameWindowMode::ENGINE)
-			Gui::Update(static_cast<int>(GraphicsManager::GetInstance().frameBuffers[0].frameTexture->id));
+			ExecuteMainThreadQueue();
+			if (gameWindowMode == GameWindowMode::ENGINE) {
+				PROFILE_SCOPE("Editor GUI");
+				Gui::Update(static_cast<int>(GraphicsManager::GetInstance().frameBuffers[0].frameTexture->id));
+			}
 #endif // INSTALLER
 
-		m_context->SwapBuffers();
-		InputManager::GetInstance().Update();
-		EventManager::GetInstance().ProcessEvents();
+			{
+				PROFILE_SCOPE("Swap Buffers");
+				m_context->SwapBuffers();
+			}
+			{
+				PROFILE_SCOPE("Input & Events");
+				InputManager::GetInstance().Update();
+				EventManager::GetInstance().ProcessEvents();
+			}
+		}
+		PROFILE_FRAME();
 	}
 
 	SceneManager::GetInstance().ExitScene();
@@ -132,10 +154,14 @@ void Application::Exit()
 	delete m_streamRedirector;
 	m_streamRedirector = nullptr;
 
+	// Write out a capture that was still running when the window closed.
+	Profiler::GetInstance().StopCapture();
+
 #ifndef INSTALLER
 	Gui::Exit();
 #endif
 	ScriptEngine::Shutdown();
+	JobSystem::GetInstance().Shutdown();
 	glfwTerminate();
 }
 
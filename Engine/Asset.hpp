@@ -15,6 +15,7 @@
 #ifndef ASSET_HPP
 #define ASSET_HPP
 
+#include <cstddef>
 #include <string>
 
  /**
@@ -44,6 +45,31 @@ public:
 	 */
 	virtual bool LoadFromFile(const std::string& fileName) = 0;
 
+	/**
+	 * \brief Memory the loaded asset holds, counted against the budget of its type in the AssetManager.
+	 *
+	 * \return The size in bytes, or 0 if it is not known.
+	 */
+	virtual size_t GetMemorySize() const { return 0; }
+
+	static constexpr int NO_PAGE = -1;
+
+	/**
+	 * \brief Page of storage the asset shares with other assets of its type, such as an atlas page.
+	 *
+	 * A page is counted once against the budget, on top of GetMemorySize, and is only evicted
+	 * with every asset on it, once none of them is referenced.
+	 *
+	 * \param pageSize Set to the bytes the page holds, if the asset is on one.
+	 * \return The page, or NO_PAGE if the asset is stored on its own.
+	 */
+	virtual int GetPage(size_t& /*pageSize*/) const { return NO_PAGE; }
+
+	/**
+	 * \brief Checks the asset frees its memory when it is destroyed, so it can be evicted on its own.
+	 */
+	virtual bool IsEvictableAlone() const { return true; }
+
 	std::string name;
 };
 
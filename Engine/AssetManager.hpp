@@ -15,13 +15,52 @@
 #ifndef ASSET_MANAGER_HPP
 #define ASSET_MANAGER_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
+#include "Asset.hpp"
 #include "Utility/MetadataHandler.hpp"
 #include "Logger.hpp"
 
 class Texture;
+class Font;
+class AudioClip;
+class VideoClip;
+class Shader;
+
+/**
+ * \brief Name an asset type is reported under in the residency stats.
+ */
+template <typename T> struct AssetTypeName { static constexpr const char* NAME = "Asset"; };
+template <> struct AssetTypeName<Texture> { static constexpr const char* NAME = "Texture"; };
+template <> struct AssetTypeName<Font> { static constexpr const char* NAME = "Font"; };
+template <> struct AssetTypeName<AudioClip> { static constexpr const char* NAME = "AudioClip"; };
+template <> struct AssetTypeName<VideoClip> { static constexpr const char* NAME = "VideoClip"; };
+template <> struct AssetTypeName<Shader> { static constexpr const char* NAME = "Shader"; };
+
+/**
+ * \struct AssetResidency
+ * \brief What the assets of one type hold in memory, for the editor and the headless runner to report.
+ */
+struct AssetResidency {
+	const char* type = "";
+	size_t resident = 0;		// Assets loaded
+	size_t referenced = 0;		// Assets an owner holds a reference to, loaded or not
+	size_t pages = 0;			// Shared pages the loaded assets are on, such as atlas pages
+	size_t bytes = 0;			// Memory the loaded assets hold, each page counted once
+	size_t budget = 0;			// Bytes the unreferenced assets are evicted down to
+	uint64_t loads = 0;			// Assets loaded since the start
+	uint64_t unloads = 0;		// Assets unloaded, by eviction or along with the rest of their type
+};
 
 /**
  * \class AssetManager
@@ -29,6 +68,11 @@ class Texture;
  *
  * The AssetManager is a singleton class that manages different types of assets (e.g., textures, sounds).
  * It provides methods to load assets from files, retrieve assets, and unload assets.
+ *
+ * Owners hold references on the assets they need, usually through an AssetHandle. Loaded assets
+ * stay loaded after their last reference is released, so a scene that uses them next finds them
+ * loaded, until Trim evicts the least recently used of them to fit the budget of their type.
+ * Assets that share a page of storage, like images in an atlas page, are evicted a page at a time.
  */
 class AssetManager {
 public:
@@ -63,7 +107,7 @@ public:
 				return nullptr;
 			}
 
-			map[uuid] = asset;
+			Insert<T>(uuid, asset);
 			return asset;
 		}
 
@@ -94,11 +138,11 @@ public:
 
 			//std::string uuid = MetadataHandler::ParseUUIDFromMeta(metaFile);
 
-			map[uuid] = asset;
+			Insert<T>(uuid, asset);
 			return asset;
 		}
 
-		return map.at(uuid);
+		return Touch(map.at(uuid), GetStore<T>());
 	}
 
 	/**
@@ -113,17 +157,29 @@ public:
 		auto& map = GetAssetMap<T>();
 		auto it = map.find(name);
 		if (it != map.end())
-			return it->second;
+			return Touch(it->second, GetStore<T>());
 		else {
 			// try to load, lazy initialising
 			return Load<T>(name);
 		}
 	}
 
+	/**
+	 * \brief Retrieves an asset by name without loading it.
+	 *
+	 * \return A shared pointer to the asset, or nullptr if it has not been loaded.
+	 */
+	template <typename T>
+	std::shared_ptr<T> Find(const std::string& name) {
+		auto& map = GetAssetMap<T>();
+		auto it = map.find(name);
+		return it != map.end() ? Touch(it->second, GetStore<T>()) : nullptr;
+	}
+
 	template <typename T = Texture>
 	std::shared_ptr<T> CreateTexture(const std::string& name) {
 		std::shared_ptr<T> asset = std::make_shared<T>();
-		GetAssetMap<T>()[name] = asset;
+		Insert<T>(name, asset);
 		return asset;
 	}
 
@@ -135,21 +191,226 @@ public:
 	 */
 	template <typename T>
 	void Unload(const std::string& name) {
-		auto& map = GetAssetMap<T>();
-		map.erase(name);
+		auto& store = GetStore<T>();
+		store.unloads += store.assets.erase(name);
 	}
 
 	template <typename T>
 	void UnloadAllOfType() {
-		GetAssetMap<T>().clear();
+		auto& store = GetStore<T>();
+		store.unloads += store.assets.size();
+		store.assets.clear();
+	}
+
+	/**
+	 * \brief Takes a reference on an asset, so it is not evicted while the owner needs it.
+	 *
+	 * The asset does not need to be loaded yet. It is loaded as before, the first time it is used.
+	 * Prefer holding an AssetHandle, which releases the reference when it is destroyed.
+	 *
+	 * \tparam T The type of the asset.
+	 * \param uuid The UUID of the asset.
+	 */
+	template <typename T>
+	void Retain(const std::string& uuid) {
+		auto& store = GetStore<T>();
+		++store.references[uuid];
+
+		auto it = store.assets.find(uuid);
+		if (it != store.assets.end()) {
+			Touch(it->second, store);
+		}
+	}
+
+	/**
+	 * \brief Releases a reference taken by Retain. An asset without references stays loaded until
+	 *        its type is trimmed down to its budget.
+	 *
+	 * \tparam T The type of the asset.
+	 * \param uuid The UUID of the asset.
+	 */
+	template <typename T>
+	void Release(const std::string& uuid) {
+		auto& store = GetStore<T>();
+		auto it = store.references.find(uuid);
+		if (it == store.references.end()) {
+			Logger::Instance().Log(Logger::Level::WARN, "[AssetManager] Release: No reference held on " + uuid);
+			return;
+		}
+		if (--it->second == 0) {
+			store.references.erase(it);
+		}
+
+		// Counts as a use, so the assets released last are the last evicted
+		auto asset = store.assets.find(uuid);
+		if (asset != store.assets.end()) {
+			Touch(asset->second, store);
+		}
+	}
+
+	/**
+	 * \brief Sets the memory the assets of a type may hold before the unreferenced ones are evicted.
+	 *
+	 * \tparam T The type of the assets.
+	 * \param bytes The budget in bytes.
+	 */
+	template <typename T>
+	void SetBudget(size_t bytes) {
+		GetStore<T>().budget = bytes;
+	}
+
+	/**
+	 * \brief Checks the loaded assets of a type fit in its budget.
+	 */
+	template <typename T>
+	bool IsWithinBudget() {
+		auto& store = GetStore<T>();
+		return GetResidentBytes(store) <= store.budget;
+	}
+
+	/**
+	 * \brief Evicts the assets of a type that nothing holds a reference to, least recently used
+	 *        first, until the rest fit in the budget of the type.
+	 *
+	 * Assets on a page are evicted together, once none of the assets on it is referenced, and a
+	 * page is as recent as the last use of any asset on it. Assets that are on no page are only
+	 * evicted if they free their memory when destroyed.
+	 *
+	 * \tparam T The type of the assets.
+	 * \return The number of assets evicted.
+	 */
+	template <typename T>
+	size_t Trim() {
+		auto& store = GetStore<T>();
+		size_t bytes = GetResidentBytes(store);
+		if (bytes <= store.budget) {
+			return 0;
+		}
+
+		// An asset alone, or every asset on a page
+		struct Eviction {
+			uint64_t lastUse = 0;
+			size_t bytes = 0;
+			bool isReferenced = false;
+			std::vector<std::string> uuids;
+		};
+		std::vector<Eviction> evictions;
+		std::unordered_map<int, size_t> pageEvictions;
+		for (auto const& [uuid, resident] : store.assets) {
+			bool isReferenced = store.references.count(uuid) > 0;
+			size_t pageSize = 0;
+			int page = resident.base->GetPage(pageSize);
+			size_t index = evictions.size();
+			if (page == IAsset::NO_PAGE) {
+				if (isReferenced || !resident.base->IsEvictableAlone()) {
+					continue;
+				}
+				evictions.emplace_back();
+			}
+			else {
+				auto [it, isNew] = pageEvictions.try_emplace(page, index);
+				if (isNew) {
+					evictions.emplace_back().bytes = pageSize;
+				}
+				index = it->second;
+			}
+
+			Eviction& eviction = evictions[index];
+			eviction.lastUse = std::max(eviction.lastUse, resident.lastUse.load(std::memory_order_relaxed));
+			eviction.bytes += resident.base->GetMemorySize();
+			eviction.isReferenced = eviction.isReferenced || isReferenced;
+			eviction.uuids.push_back(uuid);
+		}
+		evictions.erase(std::remove_if(evictions.begin(), evictions.end(),
+			[](Eviction const& eviction) { return eviction.isReferenced; }), evictions.end());
+		std::sort(evictions.begin(), evictions.end(),
+			[](Eviction const& a, Eviction const& b) { return a.lastUse < b.lastUse; });
+
+		size_t evicted = 0;
+		for (Eviction const& eviction : evictions) {
+			if (bytes <= store.budget) {
+				break;
+			}
+			for (std::string const& uuid : eviction.uuids) {
+				store.assets.erase(uuid);
+			}
+			bytes -= std::min(bytes, eviction.bytes);
+			evicted += eviction.uuids.size();
+		}
+		store.unloads += evicted;
+		return evicted;
+	}
+
+	/**
+	 * \brief Retrieves what the assets of a type hold in memory.
+	 */
+	template <typename T>
+	AssetResidency GetResidency() {
+		auto& store = GetStore<T>();
+		AssetResidency residency;
+		residency.type = AssetTypeName<T>::NAME;
+		residency.resident = store.assets.size();
+		residency.referenced = store.references.size();
+		residency.bytes = GetResidentBytes(store, &residency.pages);
+		residency.budget = store.budget;
+		residency.loads = store.loads;
+		residency.unloads = store.unloads;
+		return residency;
+	}
+
+	/**
+	 * \brief Retrieves what the assets of every type used so far hold in memory.
+	 */
+	std::vector<AssetResidency> GetResidency() {
+		std::vector<AssetResidency> residency;
+		for (auto const& query : m_residencyQueries) {
+			residency.push_back(query());
+		}
+		return residency;
 	}
 
 private:
+	/**
+	 * \brief A loaded asset and when it was last used.
+	 */
+	template <typename T>
+	struct Resident {
+		std::shared_ptr<T> asset;
+		IAsset const* base = nullptr;		// The asset, for its size without the complete type
+		std::atomic<uint64_t> lastUse{ 0 };	// Systems look assets up from worker threads
+	};
+
+	/**
+	 * \brief The loaded assets of a type, the references held on them and their budget.
+	 */
+	template <typename T>
+	struct AssetStore {
+		std::unordered_map<std::string, Resident<T>> assets;
+		std::unordered_map<std::string, uint32_t> references;	// Only the assets with references held on them
+		std::atomic<uint64_t> useClock{ 0 };
+		size_t budget = std::numeric_limits<size_t>::max();
+		uint64_t loads = 0;
+		uint64_t unloads = 0;
+	};
+
 	/**
 	 * \brief Private constructor for the singleton pattern.
 	 */
 	AssetManager() {}
 
+	/**
+	 * \brief Retrieves the assets of a specific type.
+	 *
+	 * \tparam T The type of the assets.
+	 * \return A reference to the store of assets for the specified type.
+	 */
+	template <typename T>
+	AssetStore<T>& GetStore() {
+		static AssetStore<T> store;
+		[[maybe_unused]] static bool isRegistered = (m_residencyQueries.push_back([this]() { return GetResidency<T>(); }), true);
+		return store;
+	}
+
 	/**
 	 * \brief Retrieves the map of assets for a specific type.
 	 *
@@ -157,10 +418,99 @@ private:
 	 * \return A reference to the map of assets for the specified type.
 	 */
 	template <typename T>
-	std::unordered_map<std::string, std::shared_ptr<T>>& GetAssetMap() {
-		static std::unordered_map<std::string, std::shared_ptr<T>> assetMap;
-		return assetMap;
+	std::unordered_map<std::string, Resident<T>>& GetAssetMap() {
+		return GetStore<T>().assets;
 	}
+
+	template <typename T>
+	void Insert(const std::string& uuid, std::shared_ptr<T> const& asset) {
+		auto& store = GetStore<T>();
+		Resident<T>& resident = store.assets[uuid];
+		resident.asset = asset;
+		resident.base = asset.get();
+		Touch(resident, store);
+		++store.loads;
+	}
+
+	template <typename T>
+	static std::shared_ptr<T> const& Touch(Resident<T>& resident, AssetStore<T>& store) {
+		resident.lastUse.store(store.useClock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		return resident.asset;
+	}
+
+	template <typename T>
+	static size_t GetResidentBytes(AssetStore<T> const& store, size_t* pageCount = nullptr) {
+		size_t bytes = 0;
+		std::unordered_set<int> pages;
+		for (auto const& [uuid, resident] : store.assets) {
+			bytes += resident.base->GetMemorySize();
+
+			// A page is held once, however many assets are on it
+			size_t pageSize = 0;
+			int page = resident.base->GetPage(pageSize);
+			if (page != IAsset::NO_PAGE && pages.insert(page).second) {
+				bytes += pageSize;
+			}
+		}
+		if (pageCount) {
+			*pageCount = pages.size();
+		}
+		return bytes;
+	}
+
+	std::vector<std::function<AssetResidency()>> m_residencyQueries;
+};
+
+/**
+ * \class AssetHandle
+ * \brief Holds a reference on an asset for as long as the handle lives, so the asset is not
+ *        evicted while its owner needs it.
+ *
+ * \tparam T The type of the asset.
+ */
+template <typename T>
+class AssetHandle {
+public:
+	AssetHandle() = default;
+
+	explicit AssetHandle(std::string uuid) : m_uuid(std::move(uuid)) {
+		if (!m_uuid.empty()) {
+			AssetManager::GetInstance().Retain<T>(m_uuid);
+		}
+	}
+
+	AssetHandle(AssetHandle const& other) : AssetHandle(other.m_uuid) {}
+
+	AssetHandle(AssetHandle&& other) noexcept : m_uuid(std::move(other.m_uuid)) {
+		other.m_uuid.clear();
+	}
+
+	AssetHandle& operator=(AssetHandle other) noexcept {
+		std::swap(m_uuid, other.m_uuid);
+		return *this;
+	}
+
+	~AssetHandle() { Reset(); }
+
+	/**
+	 * \brief Releases the reference, leaving the handle empty.
+	 */
+	void Reset() {
+		if (!m_uuid.empty()) {
+			AssetManager::GetInstance().Release<T>(m_uuid);
+			m_uuid.clear();
+		}
+	}
+
+	std::string const& GetUUID() const { return m_uuid; }
+
+	/**
+	 * \brief Retrieves the asset, loading it if it is not loaded.
+	 */
+	std::shared_ptr<T> Get() const { return AssetManager::GetInstance().Get<T>(m_uuid); }
+
+private:
+	std::string m_uuid;
 };
 
 #endif // !ASSET_MANAGER_HPP
\ No newline at end of file
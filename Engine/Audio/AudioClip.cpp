@@ -22,3 +22,11 @@ bool AudioClip::LoadFromFile(const std::string& filePath) {
     sound = AudioManager::GetInstance().LoadSound(filePath);
     return sound != nullptr;
 }
+
+size_t AudioClip::GetMemorySize() const {
+    unsigned int bytes = 0;
+    if (sound) {
+        sound->getLength(&bytes, FMOD_TIMEUNIT_PCMBYTES);
+    }
+    return bytes;
+}
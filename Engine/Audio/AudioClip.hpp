@@ -29,6 +29,7 @@ public:
     ~AudioClip() override;
 
     bool LoadFromFile(const std::string& filePath) override;
+    size_t GetMemorySize() const override;  // The decoded samples
 };
 
 
@@ -12,6 +12,8 @@
  *********************************************************************/
 #pragma once
 
+#include "../Utility/ReflectionMacros.hpp"
+
 struct Animation {
 
 	Animation();
@@ -37,6 +39,17 @@ struct Animation {
 	
 	bool playOnce;
 	bool isLooping;
+
+	REFLECTABLE(Animation,
+		FIELD(spritesPerRow),
+		FIELD(spritesPerCol),
+		FIELD(numFrames),
+		FIELD(startFrame),
+		FIELD(endFrame),
+		FIELD(timePerFrame),
+		FIELD(isLooping),
+		FIELD(playOnce)
+	)
 };
 
 inline Animation::Animation()
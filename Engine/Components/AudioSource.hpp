@@ -15,12 +15,19 @@
 #define	AUDIO_SOURCE_HPP
 
 #include <string>
+#include "../Utility/ReflectionMacros.hpp"
 
 struct AudioSource {
 	std::string audioClipUUID = "";
 
 	bool isPlaying = false;
 	bool isLooping = false;
+
+	REFLECTABLE(AudioSource,
+		FIELD(audioClipUUID),
+		FIELD(isPlaying),
+		FIELD(isLooping)
+	)
 };
 
 
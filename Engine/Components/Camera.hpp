@@ -13,8 +13,10 @@
  *********************************************************************/
 #pragma once
 
+#include <glm/glm.hpp>
 #include "Vec3.hpp"
 #include "Mat4.hpp"
+#include "../Utility/ReflectionMacros.hpp"
 
 struct Camera {
 
@@ -37,6 +39,18 @@ struct Camera {
 	float vignetteStrength{ 0.8f };
 	float vignetteSoftness{ 0.9f };
 	Vec2 vignetteCenter{ 0.5f, 0.34f };
+
+	REFLECTABLE(Camera,
+		FIELD(zoom),
+		FIELD(width),
+		FIELD(height),
+		FIELD(isMainCamera),
+		FIELD(isActive),
+		FIELD(bloomIntensity),
+		FIELD(vignetteStrength),
+		FIELD(vignetteSoftness),
+		FIELD(vignetteCenter)
+	)
 };
 
 inline Camera::Camera(bool isMainCamera)
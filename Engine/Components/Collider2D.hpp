@@ -18,6 +18,7 @@
 #include <vector>
 #include <cassert>
 #include "../Physics/Collision.hpp"
+#include "../Utility/ReflectionMacros.hpp"
 
 /**
  * \enum ColliderType
@@ -44,10 +45,6 @@ struct Collider2D {
 	Vec2 offset;
 	bool isUpdated = false;
 
-	size_t idInGrid = static_cast<size_t>(-1);
-	std::pair<size_t, size_t> rowsOccupied, colsOccupied;
-	bool inGrid = false;
-
 	std::vector<Collision> collisions;
 	std::vector<Collision> staticCollisions;
 
@@ -90,6 +87,13 @@ struct AABBCollider2D : Collider2D {
 		min{ _min }, max{ _max }, sizeX{ max.x - min.x }, sizeY{ max.y - min.y }, Collider2D(_bounciness, _isTrigger) {}
 
 	virtual ~AABBCollider2D() = default;
+
+	REFLECTABLE(AABBCollider2D,
+		FIELD(bounciness),
+		FIELD(min),
+		FIELD(max),
+		FIELD(isTrigger)
+	)
 };
 
 #endif
\ No newline at end of file
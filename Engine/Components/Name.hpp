@@ -15,6 +15,7 @@
 #define NAME_HPP
 
 #include <string>
+#include "../Utility/ReflectionMacros.hpp"
 
 struct Name {
 	std::string name{"Unnamed Entity"};
@@ -22,6 +23,12 @@ struct Name {
 
 	// Hidden Vars
 	std::string prefabPath;
+
+	REFLECTABLE(Name,
+		FIELD(name),
+		FIELD(prefabID),
+		FIELD(prefabPath)
+	)
 };
 
 #endif // !NAME_HPP
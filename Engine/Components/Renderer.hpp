@@ -17,6 +17,7 @@
 #include <vector>
 #include "Vec.hpp"
 #include "../Layers/SortingLayer.hpp"
+#include "../Utility/ReflectionMacros.hpp"
 
 /*********************************************************************
 * \struct	Renderer
@@ -61,6 +62,13 @@ struct Renderer {
 
 	void SetMeshID(size_t id) { currentMeshID = id; }
 	void SetMeshDebugID(size_t id) { currentMeshDebugID = id; }
+
+	REFLECTABLE(Renderer,
+		FIELD(mesh),
+		FIELD_KEY(isAnimated, "isAnimated", Reflection::FIELD_OPTIONAL),
+		FIELD_KEY(sortingLayer, "sortingLayer", Reflection::FIELD_OPTIONAL),
+		FIELD_KEY(uuid, "textureFile", Reflection::FIELD_NONE)
+	)
 };
 
 inline Renderer::Renderer(size_t meshID, size_t meshDebugID, std::string uuid, size_t animationID, bool isAnimated, SortingLayer sortingLayer)
@@ -15,6 +15,7 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #define RIGIDBODY2D_HPP
 
 #include "../Physics/ForcesManager.hpp"
+#include "../Utility/ReflectionMacros.hpp"
 
  /**
   * \struct Rigidbody2D
@@ -66,7 +67,25 @@ struct Rigidbody2D {
 	inline Rigidbody2D(const Rigidbody2D& other) : position{ other.position }, velocity{ other.velocity }, mass{ other.mass }, inverseMass{ other.inverseMass }, drag{ other.drag },
 		gravityScale{ other.gravityScale }, isStatic{ other.isStatic }, isKinematic{ other.isKinematic }, isGrounded{ other.isGrounded }, forcesManager{} {}
 
+	/**
+	 * \brief Copies every member of another Rigidbody2D, including its forces, unlike the copy constructor.
+	 *
+	 * \param other Other Rigidbody2D to copy from.
+	 */
+	Rigidbody2D& operator=(const Rigidbody2D& other) = default;
+
 	~Rigidbody2D() = default;
+
+	REFLECTABLE(Rigidbody2D,
+		FIELD(mass),
+		FIELD(drag),
+		FIELD_KEY(gravityScale, "gravity", Reflection::FIELD_NONE),
+		FIELD_KEY(isStatic, "static", Reflection::FIELD_NONE),
+		FIELD_KEY(isKinematic, "kinematic", Reflection::FIELD_NONE),
+		FIELD_KEY(isGrounded, "grounded", Reflection::FIELD_NONE),
+		FIELD_KEY(position, "pos", Reflection::FIELD_NONE),
+		FIELD_KEY(velocity, "vel", Reflection::FIELD_NONE)
+	)
 };
 
 #endif
\ No newline at end of file
@@ -16,6 +16,7 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include <string>
 #include <unordered_map>
 #include <variant>
+#include "../Utility/ReflectionMacros.hpp"
 
 struct ScriptComponent
 {
@@ -25,6 +26,10 @@ struct ScriptComponent
 
 	ScriptComponent() = default;
 	ScriptComponent(const ScriptComponent&) = default;
+
+	REFLECTABLE(ScriptComponent,
+		FIELD(className)
+	)
 };
 
 #endif // !SCRIPT_COMP
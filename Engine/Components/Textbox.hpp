@@ -16,6 +16,8 @@
 #include <string>
 #include <vector>
 #include "Math.hpp"
+#include "../Graphics/MeshHandle.hpp"
+#include "../Utility/ReflectionMacros.hpp"
 
   /*********************************************************************
   * \struct	Textbox
@@ -43,11 +45,18 @@ struct Textbox {
 	Vec3 color;
 	bool centerAligned;
 
-	std::vector<size_t> meshIDs;
+	std::vector<MeshHandle> meshHandles;	// One mesh per character, spare ones are hidden
+
+	REFLECTABLE(Textbox,
+		FIELD(color),
+		FIELD(text),
+		FIELD(fontUUID),
+		FIELD(centerAligned)
+	)
 };
 
 inline Textbox::Textbox(std::string text, std::string fontUUID, Vec3 color, bool centerAligned)
-	: text(text), meshIDs(), color(color), fontUUID(fontUUID), centerAligned(centerAligned)
+	: text(text), meshHandles(), color(color), fontUUID(fontUUID), centerAligned(centerAligned)
 {
-	meshIDs.reserve(text.size());
+	meshHandles.reserve(text.size());
 }
\ No newline at end of file
@@ -15,6 +15,7 @@
 
 #include <vector>
 #include "Math.hpp"
+#include "../ECS/Entity.hpp"
 #include "../Utility/ReflectionMacros.hpp"
 
 //struct Mat4;
@@ -42,7 +43,7 @@ struct Transform {
 	uint32_t parentUUID = 0;
 
 	//Transform* parent = nullptr;
-	uint32_t parent = MAX_ENTITIES;
+	uint32_t parent = NO_ENTITY;
 	std::vector<uint32_t> children = {};
 
 	Vec3 position;
@@ -60,6 +61,8 @@ struct Transform {
 	bool updated;
 
 	REFLECTABLE(Transform,
+		FIELD(uuid),
+		FIELD(parentUUID),
 		FIELD(position),
 		FIELD(scale),
 		FIELD(rotation),
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "Math.hpp"
+#include "../Utility/ReflectionMacros.hpp"
 
   /*********************************************************************
   * \struct	UI
@@ -47,6 +48,13 @@ struct UI {
 
 	// Flag to indicate if the UI element needs to be updated
 	bool isUpdated;
+
+	REFLECTABLE(UI,
+		FIELD(position),
+		FIELD(scale),
+		FIELD(size),
+		FIELD(rotation)
+	)
 };
 
 inline UI::UI(Vec3 position, Vec2 size, Vec2 scale, float rotation)
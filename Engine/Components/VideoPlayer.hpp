@@ -17,6 +17,7 @@
 #include <string>
 
 #include "../Video/VideoClip.hpp"
+#include "../Utility/ReflectionMacros.hpp"
 
 struct VideoPlayer {
 	std::string videoClipUUID = "";
@@ -30,6 +31,13 @@ struct VideoPlayer {
 
 	size_t currentFrame = 0;
 	size_t meshID;
+
+	REFLECTABLE(VideoPlayer,
+		FIELD(videoClipUUID),
+		FIELD(isPlaying),
+		FIELD(playOnAwake),
+		FIELD(isLooping)
+	)
 };
 
 #endif // !VIDEO_PLAYER_HPP
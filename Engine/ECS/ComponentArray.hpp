@@ -17,7 +17,9 @@
 
 #include "Entity.hpp"
 
-#include <unordered_map>
+#include <vector>
+#include <array>
+#include <memory>
 #include <assert.h>
 #include <optional>
 #include <functional>
@@ -49,9 +51,16 @@ public:
  * \class ComponentArray
  * \brief Manages the storage and retrieval of components for entities.
  *
- * The ComponentArray class stores components of a specific type for all entities that have that component.
- * It provides methods for adding, removing, and accessing components, and manages the mappings between
- * entities and component array indices.
+ * Components are kept in a paged sparse set. The dense side stores the components and their
+ * owning entities packed together, so iteration only touches live components. The sparse side
+ * maps an entity's slot index to its dense index and is allocated in pages on demand, so memory
+ * follows the highest slot in use rather than a compile-time maximum. The dense side keeps the
+ * full entity handle, so a stale handle whose slot has been reused does not find the new
+ * owner's component.
+ *
+ * Dense components are also stored in fixed-size pages. Inserting a component never moves
+ * existing ones, so references returned by GetData stay valid until that component (or the
+ * last one, which is swapped into its slot) is removed.
  *
  * \tparam T The type of the component stored in the array.
  */
@@ -65,49 +74,84 @@ public:
      * \param component The component instance to be added.
      */
     inline void InsertData(Entity entity, T component) {
-        //assert(entityToIndexMap.find(entity) == entityToIndexMap.end() && "Component added to same entity more than once.");
-        if (entityToIndexMap.find(entity) != entityToIndexMap.end()) {
+        if (HasData(entity)) {
             Logger::Instance().Log(Logger::Level::ERR,
                 "Attempting to add component to the same entity more than once!");
             return;
         }
 
-        size_t newIndex = size;
-        entityToIndexMap[entity] = newIndex;
-        indexToEntityMap[newIndex] = entity;
-        componentArray[newIndex] = component;
-        ++size;
+        uint32_t newIndex = static_cast<uint32_t>(denseEntities.size());
+        if ((newIndex & DENSE_PAGE_MASK) == 0) {
+            densePages.emplace_back();
+            densePages.back().reserve(DENSE_PAGE_SIZE);
+        }
+
+        densePages.back().push_back(std::move(component));
+        denseEntities.push_back(entity);
+        Sparse(entity) = newIndex;
+    }
+
+    /**
+     * \brief Inserts a copy of the same component for each of the given entities.
+     *
+     * Entities that already own this component are skipped, as InsertData does.
+     *
+     * \param entities The entities for which the component is added.
+     * \param count The number of entities.
+     * \param component The component every entity gets a copy of.
+     */
+    inline void InsertCopies(Entity const* entities, size_t count, T const& component) {
+        denseEntities.reserve(denseEntities.size() + count);
+        for (size_t i = 0; i < count; ++i) {
+            Entity entity = entities[i];
+            if (HasData(entity)) {
+                Logger::Instance().Log(Logger::Level::ERR,
+                    "Attempting to add component to the same entity more than once!");
+                continue;
+            }
+
+            uint32_t newIndex = static_cast<uint32_t>(denseEntities.size());
+            if ((newIndex & DENSE_PAGE_MASK) == 0) {
+                densePages.emplace_back();
+                densePages.back().reserve(DENSE_PAGE_SIZE);
+            }
+
+            densePages.back().push_back(component);
+            denseEntities.push_back(entity);
+            Sparse(entity) = newIndex;
+        }
     }
 
     /**
      * \brief Removes the component for the specified entity.
      *
+     * The last component is moved into the freed slot to keep the dense arrays packed.
+     *
      * \param entity The entity for which the component is removed.
      */
     inline void RemoveData(Entity entity) {
-        //assert(entityToIndexMap.find(entity) != entityToIndexMap.end() && "Removing non-existent component.");
-        //if (entityToIndexMap.find(entity) != entityToIndexMap.end()) {
-        //    Logger::Instance().Log(Logger::Level::ERR, "Removing non-existent component from the entity!");
-        //    return;
-        //}
-        if (entityToIndexMap.find(entity) == entityToIndexMap.end()) {
+        if (!HasData(entity)) {
             Logger::Instance().Log(Logger::Level::ERR,
                 "Attempting to remove non-existent component of the entity!");
-            return; // Skip adding the component
+            return;
         }
 
-        size_t indexOfRemovedEntity = entityToIndexMap[entity];
-        size_t indexOfLastElement = size - 1;
-        componentArray[indexOfRemovedEntity] = componentArray[indexOfLastElement];
+        uint32_t indexOfRemovedEntity = Sparse(entity);
+        uint32_t indexOfLastElement = static_cast<uint32_t>(denseEntities.size()) - 1;
 
-        Entity entityOfLastElement = indexToEntityMap[indexOfLastElement];
-        entityToIndexMap[entityOfLastElement] = indexOfRemovedEntity;
-        indexToEntityMap[indexOfRemovedEntity] = entityOfLastElement;
-
-        entityToIndexMap.erase(entity);
-        indexToEntityMap.erase(indexOfLastElement);
+        if (indexOfRemovedEntity != indexOfLastElement) {
+            Entity entityOfLastElement = denseEntities[indexOfLastElement];
+            DenseAt(indexOfRemovedEntity) = std::move(DenseAt(indexOfLastElement));
+            denseEntities[indexOfRemovedEntity] = entityOfLastElement;
+            Sparse(entityOfLastElement) = indexOfRemovedEntity;
+        }
 
-        --size;
+        densePages.back().pop_back();
+        if (densePages.back().empty()) {
+            densePages.pop_back();
+        }
+        denseEntities.pop_back();
+        Sparse(entity) = INVALID_INDEX;
     }
 
     /**
@@ -117,44 +161,130 @@ public:
      * \return A reference to the component.
      */
     inline T& GetData(Entity entity) {
-        assert(entityToIndexMap.find(entity) != entityToIndexMap.end() && "Retrieving non-existent component.");
-        //if (entityToIndexMap.find(entity) != entityToIndexMap.end()) {
-        //    return componentArray[entityToIndexMap[entity]];
-        //}
+        assert(HasData(entity) && "Retrieving non-existent component.");
 
-        return componentArray[entityToIndexMap[entity]];
+        Entity index = EntityIndex(entity);
+        return DenseAt((*sparsePages[index >> SPARSE_PAGE_SHIFT])[index & SPARSE_PAGE_MASK]);
     }
 
     inline std::optional<std::reference_wrapper<T>> TryGetData(Entity entity) {
-        if (entityToIndexMap.find(entity) != entityToIndexMap.end()) {
-            return componentArray[entityToIndexMap[entity]];
+        if (HasData(entity)) {
+            return DenseAt(Sparse(entity));
         }
         return std::nullopt;
     }
 
+    /**
+     * \brief Checks whether the specified entity owns a component in this array.
+     *
+     * \param entity The entity to check.
+     * \return True if the entity has this component, false otherwise.
+     */
+    inline bool HasData(Entity entity) const {
+        Entity index = EntityIndex(entity);
+        size_t page = index >> SPARSE_PAGE_SHIFT;
+        if (page >= sparsePages.size() || !sparsePages[page]) {
+            return false;
+        }
+        uint32_t denseIndex = (*sparsePages[page])[index & SPARSE_PAGE_MASK];
+        return denseIndex < denseEntities.size() && denseEntities[denseIndex] == entity;
+    }
+
+    /**
+     * \brief Retrieves the number of components currently stored.
+     */
+    inline size_t Size() const {
+        return denseEntities.size();
+    }
+
+    /**
+     * \brief Retrieves the packed list of entities owning this component, in storage order.
+     */
+    inline const std::vector<Entity>& GetEntities() const {
+        return denseEntities;
+    }
+
+    /**
+     * \brief Retrieves the component stored at a dense index.
+     *
+     * \param index Dense index in [0, Size()).
+     * \return A reference to the component.
+     */
+    inline T& GetDataAt(size_t index) {
+        assert(index < denseEntities.size() && "Dense index out of range.");
+        return DenseAt(static_cast<uint32_t>(index));
+    }
+
+    /**
+     * \brief Invokes func(entity, component) for every live component in storage order.
+     *
+     * Components must not be added or removed from this array while iterating.
+     */
+    template<typename Func>
+    inline void ForEach(Func&& func) {
+        size_t index = 0;
+        for (auto& page : densePages) {
+            for (auto& component : page) {
+                func(denseEntities[index++], component);
+            }
+        }
+    }
+
     /**
      * \brief Handles the destruction of an entity by removing its component.
      *
      * \param entity The entity that was destroyed.
      */
     inline void EntityDestroyed(Entity entity) override {
-        if (entityToIndexMap.find(entity) != entityToIndexMap.end())
+        if (HasData(entity))
             RemoveData(entity);
     }
 
     inline void AllEntitiesDestroyed() override {
-        entityToIndexMap.clear();
-        indexToEntityMap.clear();
-        std::fill(componentArray.begin(), componentArray.end(), T{});
-        size = 0;
+        densePages.clear();
+        denseEntities.clear();
+        sparsePages.clear();
     }
 
 private:
-    std::array<T, MAX_ENTITIES> componentArray; /**< Array storing the components for all entities. */
-    std::unordered_map<Entity, size_t> entityToIndexMap; /**< Maps entities to indices in the component array. */
-    std::unordered_map<size_t, Entity> indexToEntityMap; /**< Maps indices in the component array back to entities. */
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;   /**< Sparse value for entities without this component. */
+
+    static constexpr uint32_t SPARSE_PAGE_SHIFT = 10;        /**< 1024 entities per sparse page. */
+    static constexpr uint32_t SPARSE_PAGE_SIZE = 1u << SPARSE_PAGE_SHIFT;
+    static constexpr uint32_t SPARSE_PAGE_MASK = SPARSE_PAGE_SIZE - 1;
+
+    static constexpr uint32_t DENSE_PAGE_SHIFT = 8;          /**< 256 components per dense page. */
+    static constexpr uint32_t DENSE_PAGE_SIZE = 1u << DENSE_PAGE_SHIFT;
+    static constexpr uint32_t DENSE_PAGE_MASK = DENSE_PAGE_SIZE - 1;
+
+    using SparsePage = std::array<uint32_t, SPARSE_PAGE_SIZE>;
+
+    /**
+     * \brief Retrieves the sparse slot of an entity, allocating its page if needed.
+     */
+    inline uint32_t& Sparse(Entity entity) {
+        Entity index = EntityIndex(entity);
+        size_t page = index >> SPARSE_PAGE_SHIFT;
+        if (page >= sparsePages.size()) {
+            sparsePages.resize(page + 1);
+        }
+        if (!sparsePages[page]) {
+            sparsePages[page] = std::make_unique<SparsePage>();
+            sparsePages[page]->fill(INVALID_INDEX);
+        }
+        return (*sparsePages[page])[index & SPARSE_PAGE_MASK];
+    }
+
+    /**
+     * \brief Retrieves the component stored at a dense index.
+     */
+    inline T& DenseAt(uint32_t index) {
+        return densePages[index >> DENSE_PAGE_SHIFT][index & DENSE_PAGE_MASK];
+    }
 
-    size_t size; /**< The current number of components stored in the array. */
+    std::vector<std::vector<T>> densePages;                 /**< Packed components, split into pages that never reallocate. */
+    std::vector<Entity> denseEntities;                      /**< Owning entity of each packed component. */
+    std::vector<std::unique_ptr<SparsePage>> sparsePages;   /**< Maps slot indices to dense indices, allocated per page. */
 };
 
 #endif // COMPONENT_ARRAY_HPP
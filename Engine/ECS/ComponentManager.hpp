@@ -18,26 +18,40 @@
 #include <memory>
 #include <optional>
 #include <assert.h>
-#include <string>
+#include <array>
 #include <functional>
 
 #include "Component.hpp"
 #include "ComponentArray.hpp"
 
-namespace {
-	template <typename T>
-	std::string GetReadableTypeName() {
-		const char* rawName = typeid(T).name();
-		std::string typeName = rawName;
-
-		if (typeName.find("struct ") == 0) {
-			typeName = typeName.substr(7);
-		} else if (typeName.find("class ") == 0) {
-			typeName = typeName.substr(6);
-		}
-		return typeName;
+/**
+ * \class ComponentTypeID
+ * \brief Assigns each component type a unique integer ID the first time it is requested.
+ *
+ * The ID is held in a function-local static per template instantiation, so after the first
+ * call looking up a type's ID is a single load with no hashing or string building.
+ */
+class ComponentTypeID {
+public:
+	/**
+	 * \brief Retrieves the ID of the given component type.
+	 *
+	 * \tparam T The type of the component.
+	 * \return The ID assigned to T.
+	 */
+	template<typename T>
+	static ComponentType Get() {
+		static const ComponentType id = Next();
+		return id;
+	}
+
+private:
+	static ComponentType Next() {
+		static ComponentType counter{};
+		assert(counter < MAX_COMPONENTS && "Too many component types.");
+		return counter++;
 	}
-}
+};
 
 /**
  * \class ComponentManager
@@ -56,18 +70,12 @@ public:
 	 */
 	template<typename T>
 	void RegisterComponent() {
-		std::string typeName = GetReadableTypeName<T>();
-
-		assert(componentTypes.find(typeName) == componentTypes.end() && "Registering component type more than once.");
+		ComponentType type = ComponentTypeID::Get<T>();
 
-		// Add this component type to the component type map
-		componentTypes.insert({ typeName, nextComponentType });
+		assert(!componentArrays[type] && "Registering component type more than once.");
 
-		// Create a ComponentArray pointer and add it to the component arrays map
-		componentArrays.insert({ typeName, std::make_shared<ComponentArray<T>>() });
-
-		// Increment the value so that the next component registered will be different
-		++nextComponentType;
+		// Create a ComponentArray and store it in the slot of this component type
+		componentArrays[type] = std::make_shared<ComponentArray<T>>();
 	}
 
 	/**
@@ -78,12 +86,12 @@ public:
 	 */
 	template<typename T>
 	ComponentType GetComponentType() {
-		std::string typeName = GetReadableTypeName<T>();
+		ComponentType type = ComponentTypeID::Get<T>();
 
-		assert(componentTypes.find(typeName) != componentTypes.end() && "Component not registered before use.");
+		assert(componentArrays[type] && "Component not registered before use.");
 
 		// Return this component's type - used for creating signatures
-		return componentTypes[typeName];
+		return type;
 	}
 
 	/**
@@ -99,6 +107,19 @@ public:
 		GetComponentArray<T>()->InsertData(entity, component);
 	}
 
+	/**
+	 * \brief Adds a copy of the same component to each of the given entities.
+	 *
+	 * \tparam T The type of the component.
+	 * \param entities The entities to which the component is added.
+	 * \param count The number of entities.
+	 * \param component The component every entity gets a copy of.
+	 */
+	template<typename T>
+	void AddComponents(Entity const* entities, size_t count, T const& component) {
+		GetComponentArray<T>()->InsertCopies(entities, count, component);
+	}
+
 	/**
 	 * \brief Removes a component from an entity.
 	 *
@@ -130,6 +151,11 @@ public:
 		return GetComponentArray<T>()->TryGetData(entity);
 	}
 
+	template <typename T>
+	bool HasComponent(Entity entity) {
+		return GetComponentArray<T>()->HasData(entity);
+	}
+
 	/**
 	 * \brief Notifies the manager that an entity has been destroyed, removing all of its components.
 	 *
@@ -138,39 +164,38 @@ public:
 	void EntityDestroyed(Entity entity) {
 		// Notify each component array that an entity has been destroyed
 		// If it has a component for that entity, it will remove it
-		for (auto const& pair : componentArrays) {
-			auto const& component = pair.second;
-
-			component->EntityDestroyed(entity);
+		for (auto const& component : componentArrays) {
+			if (component) {
+				component->EntityDestroyed(entity);
+			}
 		}
 	}
 
 	void AllEntitiesDestroyed() {
-		for (auto const& pair : componentArrays) {
-			auto const& component = pair.second;
-			component->AllEntitiesDestroyed();
+		for (auto const& component : componentArrays) {
+			if (component) {
+				component->AllEntitiesDestroyed();
+			}
 		}
 	}
 
-private:
-	std::unordered_map<std::string, ComponentType> componentTypes{}; /**< Maps component type names to ComponentType IDs. */
-	std::unordered_map<std::string, std::shared_ptr<IComponentArray>> componentArrays{}; /**< Maps component type names to their corresponding component arrays. */
-	ComponentType nextComponentType{}; /**< The next available component type ID to assign. */
-
 	/**
 	 * \brief Retrieves the component array for a specific component type.
 	 *
 	 * \tparam T The type of the component array.
-	 * \return A shared pointer to the ComponentArray for the specified component type.
+	 * \return A pointer to the ComponentArray for the specified component type.
 	 */
 	template<typename T>
-	std::shared_ptr<ComponentArray<T>> GetComponentArray() {
-		std::string typeName = GetReadableTypeName<T>();
+	ComponentArray<T>* GetComponentArray() {
+		ComponentType type = ComponentTypeID::Get<T>();
 
-		assert(componentTypes.find(typeName) != componentTypes.end() && "Component not registered before use.");
+		assert(componentArrays[type] && "Component not registered before use.");
 
-		return std::static_pointer_cast<ComponentArray<T>>(componentArrays[typeName]);
+		return static_cast<ComponentArray<T>*>(componentArrays[type].get());
 	}
+
+private:
+	std::array<std::shared_ptr<IComponentArray>, MAX_COMPONENTS> componentArrays{}; /**< Component arrays indexed by ComponentType ID. */
 };
 
 #endif // !COMPONENT_MANAGER_H
\ No newline at end of file
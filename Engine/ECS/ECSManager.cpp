@@ -63,6 +63,12 @@ void ECSManager::Initialize() {
 		Signature signature;
 		signature.set(GetComponentType<Transform>());
 		SetSystemSignature<TransformSystem>(signature);
+
+		SystemAccess access;
+		access.writes = MakeSignature<Transform, Rigidbody2D, AABBCollider2D, Renderer>();
+		access.mainThread = false;
+		access.exclusive = false;
+		SetSystemAccess<TransformSystem>(access);
 	}
 
 	renderSystem = RegisterSystem<RenderSystem>();
@@ -70,6 +76,13 @@ void ECSManager::Initialize() {
 		Signature signature;
 		signature.set(GetComponentType<Renderer>());
 		SetSystemSignature<RenderSystem>(signature);
+
+		SystemAccess access;
+		access.reads = MakeSignature<UI>();
+		access.writes = MakeSignature<Renderer, Transform>();
+		access.Use(SharedResource::GRAPHICS);
+		access.exclusive = false;
+		SetSystemAccess<RenderSystem>(access);
 	}
 
 	physicsSystem = RegisterSystem<PhysicsSystem>();
@@ -78,6 +91,13 @@ void ECSManager::Initialize() {
 		signature.set(GetComponentType<AABBCollider2D>());
 		signature.set(GetComponentType<Rigidbody2D>());
 		SetSystemSignature<PhysicsSystem>(signature);
+
+		// Collision callbacks are queued and sent to the scripts after the step, see DispatchCollisionEvents.
+		SystemAccess access;
+		access.writes = MakeSignature<Rigidbody2D, AABBCollider2D, Transform>();
+		access.mainThread = false;
+		access.exclusive = false;
+		SetSystemAccess<PhysicsSystem>(access);
 	}
 
 	animationSystem = RegisterSystem<AnimationSystem>();
@@ -86,6 +106,13 @@ void ECSManager::Initialize() {
 		signature.set(GetComponentType<Renderer>());
 		signature.set(GetComponentType<Animation>());
 		SetSystemSignature<AnimationSystem>(signature);
+
+		SystemAccess access;
+		access.writes = MakeSignature<Renderer, Animation>();
+		access.Use(SharedResource::GRAPHICS);
+		access.mainThread = false;
+		access.exclusive = false;
+		SetSystemAccess<AnimationSystem>(access);
 	}
 
 	uiSystem = RegisterSystem<UISystem>();
@@ -93,6 +120,13 @@ void ECSManager::Initialize() {
 		Signature signature;
 		signature.set(GetComponentType<UI>());
 		SetSystemSignature<UISystem>(signature);
+
+		SystemAccess access;
+		access.reads = MakeSignature<UI, Transform, Textbox>();
+		access.writes = MakeSignature<Renderer>();
+		access.Use(SharedResource::GRAPHICS);
+		access.exclusive = false;
+		SetSystemAccess<UISystem>(access);
 	}
 
 	audioSystem = RegisterSystem<AudioSystem>();
@@ -100,6 +134,12 @@ void ECSManager::Initialize() {
 		Signature signature;
 		signature.set(GetComponentType<AudioSource>());
 		SetSystemSignature<AudioSystem>(signature);
+
+		SystemAccess access;
+		access.writes = MakeSignature<AudioSource>();
+		access.Use(SharedResource::AUDIO);
+		access.exclusive = false;
+		SetSystemAccess<AudioSystem>(access);
 	}
 
 	cameraSystem = RegisterSystem<CameraSystem>();
@@ -108,12 +148,26 @@ void ECSManager::Initialize() {
 		signature.set(GetComponentType<Camera>());
 		signature.set(GetComponentType<Transform>());
 		SetSystemSignature<CameraSystem>(signature);
+
+		SystemAccess access;
+		access.reads = MakeSignature<Transform>();
+		access.writes = MakeSignature<Camera>();
+		access.Use(SharedResource::GRAPHICS);
+		access.mainThread = false;
+		access.exclusive = false;
+		SetSystemAccess<CameraSystem>(access);
 	}
 	videoPlayerSystem = RegisterSystem<VideoPlayerSystem>();
 	{
 		Signature signature;
 		signature.set(GetComponentType<VideoPlayer>());
 		SetSystemSignature<VideoPlayerSystem>(signature);
+
+		SystemAccess access;
+		access.writes = MakeSignature<VideoPlayer>();
+		access.Use(SharedResource::GRAPHICS);
+		access.exclusive = false;
+		SetSystemAccess<VideoPlayerSystem>(access);
 	}
 	
 	stateMachineSystem = RegisterSystem<StateMachineSystem>();
@@ -121,11 +175,20 @@ void ECSManager::Initialize() {
 		Signature signature;
 		signature.set(GetComponentType<StateMachineComponent>());
 		SetSystemSignature<StateMachineSystem>(signature);
+
+		// States poll ImGui for input, so they stay on the main thread.
+		SystemAccess access;
+		access.writes = MakeSignature<StateMachineComponent>();
+		access.exclusive = false;
+		SetSystemAccess<StateMachineSystem>(access);
 	}
 }
 
 Entity ECSManager::CreateEntity() {
 	Entity entt = m_entityManager->CreateEntity();
+	if (entt == NO_ENTITY) {
+		return NO_ENTITY;
+	}
 
 	//std::cout << "Entity ID Created: " << entt << std::endl;
 
@@ -139,9 +202,43 @@ Entity ECSManager::CreateEntity() {
 void ECSManager::DestroyEntity(Entity entity) {
 	//std::cout << "Entity ID Destroyed: " << entity << std::endl;
 
+	if (!IsValid(entity)) {
+		Logger::Instance().Log(Logger::Level::WARN, "[ECSManager] DestroyEntity: Invalid entity ", entity);
+		return;
+	}
+
+	// Systems are told first, so their destroy hooks can still read the entity's components
+	m_systemManager->EntityDestroyed(entity);
 	m_entityManager->DestroyEntity(entity);
 	m_componentManager->EntityDestroyed(entity);
-	m_systemManager->EntityDestroyed(entity);
+}
+
+void ECSManager::SetActive(Entity entity, bool active)
+{
+	if (!IsValid(entity)) {
+		Logger::Instance().Log(Logger::Level::WARN, "[ECSManager] SetActive: Invalid entity ", entity);
+		return;
+	}
+
+	if (m_entityManager->GetActive(entity) == active) return;
+
+	m_entityManager->SetActive(entity, active);
+	m_systemManager->EntityActiveChanged(entity, m_entityManager->GetSignature(entity), active);
+}
+
+Query& ECSManager::GetQuery(Signature include, Signature exclude, bool activeOnly)
+{
+	std::lock_guard<std::mutex> lock(m_queryMutex);
+
+	if (Query* query = m_systemManager->FindQuery(include, exclude, activeOnly)) {
+		return *query;
+	}
+
+	Query& query = m_systemManager->AddQuery(include, exclude, activeOnly);
+	for (Entity entity : m_entityManager->GetLivingEntities()) {
+		query.Refresh(entity, m_entityManager->GetSignature(entity), m_entityManager->GetActive(entity));
+	}
+	return query;
 }
 
 void ECSManager::ClearEntities()
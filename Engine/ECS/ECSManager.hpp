@@ -17,10 +17,12 @@
 #define ECS_MANAGER_HPP
 
 #include <memory>
+#include <mutex>
 
 #include "EntityManager.hpp"
 #include "ComponentManager.hpp"
 #include "SystemManager.hpp"
+#include "View.hpp"
 
 #include "../Graphics/RenderSystem.hpp"
 #include "../Physics/PhysicsSystem.hpp"
@@ -73,6 +75,18 @@ public:
 	 */
 	void ClearEntities();
 
+	/**
+	 * \brief Checks whether a handle refers to a living entity.
+	 *
+	 * Handles become invalid once their entity is destroyed, even if the slot is reused.
+	 *
+	 * \param entity The handle to check.
+	 * \return True if the entity is alive.
+	 */
+	bool IsValid(Entity entity) const {
+		return m_entityManager->IsValid(entity);
+	}
+
 	/**
 	 * \brief Registers a new component type with the ECS.
 	 *
@@ -92,13 +106,45 @@ public:
 	 */
 	template<typename T>
 	void AddComponent(Entity entity, T component) {
+		if (!IsValid(entity)) {
+			Logger::Instance().Log(Logger::Level::ERR, "[ECSManager] AddComponent: Invalid entity ", entity);
+			return;
+		}
+
 		m_componentManager->AddComponent<T>(entity, component);
 
+		ComponentType type = m_componentManager->GetComponentType<T>();
 		auto signature = m_entityManager->GetSignature(entity);
-		signature.set(m_componentManager->GetComponentType<T>(), true);
+		signature.set(type, true);
 		m_entityManager->SetSignature(entity, signature);
 
-		m_systemManager->EntitySignatureChanged(entity, signature);
+		m_systemManager->EntitySignatureChanged(entity, signature, type, m_entityManager->GetActive(entity));
+	}
+
+	/**
+	 * \brief Adds a copy of the same component to each of the given entities.
+	 *
+	 * The components are inserted into the array together, then the signature and views of each
+	 * entity are updated as AddComponent does.
+	 *
+	 * \tparam T The type of the component.
+	 * \param entities The entities to which the component is added, which must all be alive.
+	 * \param count The number of entities.
+	 * \param component The component every entity gets a copy of.
+	 */
+	template<typename T>
+	void AddComponents(Entity const* entities, size_t count, T const& component) {
+		m_componentManager->AddComponents<T>(entities, count, component);
+
+		ComponentType type = m_componentManager->GetComponentType<T>();
+		for (size_t i = 0; i < count; ++i) {
+			Entity entity = entities[i];
+			auto signature = m_entityManager->GetSignature(entity);
+			signature.set(type, true);
+			m_entityManager->SetSignature(entity, signature);
+
+			m_systemManager->EntitySignatureChanged(entity, signature, type, m_entityManager->GetActive(entity));
+		}
 	}
 
 	/**
@@ -109,13 +155,19 @@ public:
 	 */
 	template<typename T>
 	void RemoveComponent(Entity entity) {
+		if (!IsValid(entity)) {
+			Logger::Instance().Log(Logger::Level::ERR, "[ECSManager] RemoveComponent: Invalid entity ", entity);
+			return;
+		}
+
 		m_componentManager->RemoveComponent<T>(entity);
 
+		ComponentType type = m_componentManager->GetComponentType<T>();
 		auto signature = m_entityManager->GetSignature(entity);
-		signature.set(m_componentManager->GetComponentType<T>(), false);
+		signature.set(type, false);
 		m_entityManager->SetSignature(entity, signature);
 
-		m_systemManager->EntitySignatureChanged(entity, signature);
+		m_systemManager->EntitySignatureChanged(entity, signature, type, m_entityManager->GetActive(entity));
 	}
 
 	/**
@@ -127,9 +179,16 @@ public:
 	 */
 	template<typename T>
 	T& GetComponent(Entity entity) {
+		assert(IsValid(entity) && "Retrieving component of invalid entity.");
 		return m_componentManager->GetComponent<T>(entity);
 	}
 
+	/**
+	 * \brief Retrieves a component if the entity is alive and has it.
+	 *
+	 * Stale handles are rejected by the component array itself, which compares the full
+	 * handle against the stored owner of the slot.
+	 */
 	template <typename T>
 	std::optional<std::reference_wrapper<T>> TryGetComponent(Entity entity) {
 		return m_componentManager->TryGetComponent<T>(entity);
@@ -137,12 +196,7 @@ public:
 
 	template <typename T>
 	bool HasComponent(Entity entity) {
-		if (m_componentManager->TryGetComponent<T>(entity)) {
-			return true;
-		}
-		else {
-			return false;
-		}
+		return m_componentManager->HasComponent<T>(entity);
 	}
 
 	template<typename T>
@@ -150,6 +204,44 @@ public:
 		return m_componentManager->GetComponentType<T>();
 	}
 
+	/**
+	 * \brief Builds a signature with the bits of the given component types set.
+	 *
+	 * \tparam Ts The component types.
+	 * \return The signature.
+	 */
+	template<typename... Ts>
+	Signature MakeSignature() {
+		Signature signature;
+		(signature.set(m_componentManager->GetComponentType<Ts>()), ...);
+		return signature;
+	}
+
+	/**
+	 * \brief Retrieves a view over every entity that has all of the given components.
+	 *
+	 * The backing query is created and populated on first use, then kept up to date as
+	 * components are added or removed and entities are activated or deactivated.
+	 *
+	 * \tparam Ts The component types the entities must have.
+	 * \param filter Additional filtering, such as skipping inactive entities.
+	 * \param exclude Components the entities must not have.
+	 * \return The view.
+	 */
+	template<typename... Ts>
+	View<Ts...> GetView(ViewFilter filter = ViewFilter::NONE, Signature exclude = {}) {
+		return View<Ts...>(GetQuery(MakeSignature<Ts...>(), exclude, filter == ViewFilter::ACTIVE_ONLY),
+			m_componentManager->GetComponentArray<Ts>()...);
+	}
+
+	/**
+	 * \brief Sets the active state of an entity and updates the active-only views.
+	 *
+	 * \param entity The entity.
+	 * \param active The new active state.
+	 */
+	void SetActive(Entity entity, bool active);
+
 	/**
 	 * \brief Registers a system with the ECS.
 	 *
@@ -172,6 +264,19 @@ public:
 		m_systemManager->SetSignature<T>(signature);
 	}
 
+	/**
+	 * \brief Declares the components and shared resources a system reads and writes.
+	 *
+	 * Systems without a declaration are treated as exclusive and main-thread only.
+	 *
+	 * \tparam T The type of the system.
+	 * \param access The access used by the SystemScheduler.
+	 */
+	template<typename T>
+	void SetSystemAccess(SystemAccess const& access) {
+		m_systemManager->SetAccess<T>(access);
+	}
+
 	EntityManager& GetEntityManager() {
 		return *m_entityManager;
 	}
@@ -196,9 +301,15 @@ private:
 	};
 	~ECSManager();
 
+	/**
+	 * \brief Finds or creates the query with the given filter, populating new queries from the living entities.
+	 */
+	Query& GetQuery(Signature include, Signature exclude, bool activeOnly);
+
 	std::unique_ptr<EntityManager> m_entityManager;			/**< The manager responsible for creating and destroying entities. */
 	std::unique_ptr<ComponentManager> m_componentManager;	/**< The manager responsible for registering and managing components. */
 	std::unique_ptr<SystemManager> m_systemManager;			/**< The manager responsible for registering and managing systems. */
+	std::mutex m_queryMutex;								/**< Guards query creation, since views may be requested from worker threads. */
 };
 
 #endif // !ECS_MANAGER_HPP
\ No newline at end of file
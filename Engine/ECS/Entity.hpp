@@ -16,9 +16,57 @@
 
 #include <stdint.h>
 
-#define NO_ENTITY INT_MAX
-
+/**
+ * \typedef Entity
+ * \brief A 32-bit entity handle.
+ *
+ * The low ENTITY_INDEX_BITS hold the slot index used to address per-entity storage, and the
+ * remaining high bits hold the generation of that slot. Destroying an entity bumps its slot's
+ * generation, so handles kept after destruction no longer compare equal to the slot's new owner.
+ */
 using Entity = uint32_t;
-const Entity MAX_ENTITIES = 2000;
+
+constexpr uint32_t ENTITY_INDEX_BITS = 20;
+constexpr uint32_t ENTITY_GENERATION_BITS = 32 - ENTITY_INDEX_BITS;
+constexpr Entity ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1;
+constexpr Entity ENTITY_GENERATION_MASK = (1u << ENTITY_GENERATION_BITS) - 1;
+
+/**
+ * \brief Handle that never refers to a living entity (matches UInt32.MaxValue on the C# side).
+ *
+ * Its index is ENTITY_INDEX_MASK, which the EntityManager never hands out.
+ */
+constexpr Entity NO_ENTITY = UINT32_MAX;
+
+/**
+ * \brief The maximum number of entities that can be alive at once.
+ */
+constexpr Entity MAX_ENTITIES = ENTITY_INDEX_MASK;
+
+/**
+ * \brief The number of entity slots the EntityManager grows by when it runs out.
+ */
+constexpr Entity ENTITY_CHUNK_SIZE = 1024;
+
+/**
+ * \brief Extracts the slot index of an entity handle.
+ */
+constexpr Entity EntityIndex(Entity entity) {
+	return entity & ENTITY_INDEX_MASK;
+}
+
+/**
+ * \brief Extracts the generation of an entity handle.
+ */
+constexpr Entity EntityGeneration(Entity entity) {
+	return entity >> ENTITY_INDEX_BITS;
+}
+
+/**
+ * \brief Packs a slot index and generation into an entity handle.
+ */
+constexpr Entity MakeEntity(Entity index, Entity generation) {
+	return ((generation & ENTITY_GENERATION_MASK) << ENTITY_INDEX_BITS) | (index & ENTITY_INDEX_MASK);
+}
 
 #endif // !ENTITY_HPP
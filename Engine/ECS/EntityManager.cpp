@@ -12,56 +12,96 @@
  *              Institute of Technology is prohibited.
  *********************************************************************/
 #include "EntityManager.hpp"
+#include <algorithm>
 #include <cassert>
 
+#include "Logger.hpp"
+
 EntityManager::EntityManager() {
-	for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
-		m_availableEntities.push(entity);
-	}
-	for (uint32_t entity = 0; entity < MAX_ENTITIES; entity++) {
-		entityLayers[entity] = NO_LAYER;
-	}
+	Grow();
 }
 
 EntityManager::~EntityManager() {
 }
 
 Entity EntityManager::CreateEntity() {
-	assert(m_livingEntityCount < MAX_ENTITIES);
+	if (m_availableEntities.empty()) {
+		Grow();
+	}
+	// Grow adds nothing once every index up to MAX_ENTITIES is in use
+	if (m_availableEntities.empty()) {
+		Logger::Instance().Log(Logger::Level::ERR, "[EntityManager] CreateEntity: All ", MAX_ENTITIES, " entities are in use");
+		return NO_ENTITY;
+	}
 
-	Entity id = m_availableEntities.front();
+	Entity index = m_availableEntities.front();
 	m_availableEntities.pop();
 	++m_livingEntityCount;
 
-	m_activeEntities[id] = true;
+	m_aliveEntities[index] = true;
+	m_activeEntities[index] = true;
 
-	return id;
+	return MakeEntity(index, m_generations[index]);
 }
 
 void EntityManager::DestroyEntity(Entity entity) {
-	assert(entity < MAX_ENTITIES && "Entity out of range.");
+	assert(IsValid(entity) && "Destroying invalid entity.");
+
+	Entity index = EntityIndex(entity);
+	m_signatures[index].reset();
+	entityLayers[index] = NO_LAYER;
 
-	m_signatures[entity].reset();
+	m_aliveEntities[index] = false;
+	m_activeEntities[index] = false;
+	m_generations[index] = (m_generations[index] + 1) & ENTITY_GENERATION_MASK;
 
-	m_availableEntities.push(entity);
+	m_availableEntities.push(index);
 	--m_livingEntityCount;
+}
 
-	m_activeEntities[entity] = false;
+bool EntityManager::IsValid(Entity entity) const {
+	Entity index = EntityIndex(entity);
+	return index < m_generations.size() && m_aliveEntities[index]
+		&& m_generations[index] == EntityGeneration(entity);
+}
+
+Entity EntityManager::GetEntity(Entity index) const {
+	if (index >= m_generations.size() || !m_aliveEntities[index]) {
+		return NO_ENTITY;
+	}
+	return MakeEntity(index, m_generations[index]);
+}
+
+std::vector<Entity> EntityManager::GetLivingEntities() const {
+	std::vector<Entity> entities;
+	entities.reserve(m_livingEntityCount);
+
+	Entity capacity = static_cast<Entity>(m_generations.size());
+	for (Entity index = 0; index < capacity && entities.size() < m_livingEntityCount; ++index) {
+		if (m_aliveEntities[index]) {
+			entities.push_back(MakeEntity(index, m_generations[index]));
+		}
+	}
+	return entities;
+}
+
+uint32_t EntityManager::GetCapacity() const {
+	return static_cast<uint32_t>(m_generations.size());
 }
 
 Signature EntityManager::GetSignature(Entity entity) {
-	assert(entity < MAX_ENTITIES && "Entity out of range.");
+	assert(IsValid(entity) && "Invalid entity.");
 
 	// Get this entity's signature from the array
-	return m_signatures[entity];
+	return m_signatures[EntityIndex(entity)];
 
 }
 
 void EntityManager::SetSignature(Entity entity, Signature signature) {
-	assert(entity < MAX_ENTITIES && "Entity out of range.");
+	assert(IsValid(entity) && "Invalid entity.");
 
 	// Put this entity's signature into the array
-	m_signatures[entity] = signature;
+	m_signatures[EntityIndex(entity)] = signature;
 }
 
 uint32_t EntityManager::GetEntities() const {
@@ -72,14 +112,22 @@ void EntityManager::DestroyAllEntities() {
 	for (auto& signature : m_signatures) {
 		signature.reset();
 	}
+	std::fill(entityLayers.begin(), entityLayers.end(), NO_LAYER);
 
-	m_activeEntities.reset();
+	std::fill(m_activeEntities.begin(), m_activeEntities.end(), false);
+	std::fill(m_aliveEntities.begin(), m_aliveEntities.end(), false);
+
+	// Bump every slot so that all handles from before the clear become stale, while
+	// keeping generations uniform so handles still order by slot index.
+	for (auto& generation : m_generations) {
+		generation = (generation + 1) & ENTITY_GENERATION_MASK;
+	}
 
 	while (!m_availableEntities.empty()) {
 		m_availableEntities.pop();
 	}
-	for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
-		m_availableEntities.push(entity);
+	for (Entity index = 0; index < m_generations.size(); ++index) {
+		m_availableEntities.push(index);
 	}
 
 	m_livingEntityCount = 0;
@@ -87,20 +135,37 @@ void EntityManager::DestroyAllEntities() {
 
 void EntityManager::SetLayer(Entity entity, const Layer layer)
 {
-	entityLayers[entity] = layer;
+	if (IsValid(entity)) {
+		entityLayers[EntityIndex(entity)] = layer;
+	}
 }
 
 Layer EntityManager::GetLayer(Entity entity) const
 {
-	return entityLayers[entity];
+	return IsValid(entity) ? entityLayers[EntityIndex(entity)] : NO_LAYER;
 }
 
 void EntityManager::SetActive(Entity entity, bool active) {
-	assert(entity < MAX_ENTITIES && "Entity out of range.");
-	m_activeEntities[entity] = active;
+	if (IsValid(entity)) {
+		m_activeEntities[EntityIndex(entity)] = active;
+	}
 }
 
 bool EntityManager::GetActive(Entity entity) {
-	assert(entity < MAX_ENTITIES && "Entity out of range.");
-	return m_activeEntities[entity];
+	return IsValid(entity) && m_activeEntities[EntityIndex(entity)];
+}
+
+void EntityManager::Grow() {
+	Entity oldCapacity = static_cast<Entity>(m_generations.size());
+	Entity newCapacity = std::min<Entity>(oldCapacity + ENTITY_CHUNK_SIZE, MAX_ENTITIES);
+
+	entityLayers.resize(newCapacity, NO_LAYER);
+	m_activeEntities.resize(newCapacity, false);
+	m_aliveEntities.resize(newCapacity, false);
+	m_generations.resize(newCapacity, 0);
+	m_signatures.resize(newCapacity);
+
+	for (Entity index = oldCapacity; index < newCapacity; ++index) {
+		m_availableEntities.push(index);
+	}
 }
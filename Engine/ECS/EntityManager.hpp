@@ -14,7 +14,7 @@
 #ifndef ENTITY_MANAGER_HPP
 #define ENTITY_MANAGER_HPP
 
-#include <array>
+#include <vector>
 #include <queue>
 
 #include "Entity.hpp"
@@ -43,22 +43,55 @@ public:
 	/**
 	 * \brief Creates a new entity and assigns a unique ID.
 	 *
-	 * Entities are reused from a pool of available IDs to minimize fragmentation.
+	 * Slots are reused from a pool of available indices to minimize fragmentation. When the
+	 * pool is empty, storage grows by ENTITY_CHUNK_SIZE slots.
 	 *
-	 * \return The ID of the newly created entity.
+	 * \return The handle of the newly created entity.
 	 */
 	Entity CreateEntity();
 
 	/**
 	 * \brief Destroys an existing entity and recycles its ID.
 	 *
-	 * The destroyed entity is removed from active management and its ID is
-	 * added back to the pool of available entities.
+	 * The destroyed entity is removed from active management, the generation of its
+	 * slot is bumped so existing handles become stale, and the slot is added back to
+	 * the pool of available entities.
 	 *
 	 * \param entity The ID of the entity to destroy.
 	 */
 	void DestroyEntity(Entity entity);
 
+	/**
+	 * \brief Checks whether a handle refers to a living entity.
+	 *
+	 * \param entity The handle to check.
+	 * \return True if the handle's slot is alive and its generation matches.
+	 */
+	bool IsValid(Entity entity) const;
+
+	/**
+	 * \brief Retrieves the handle of the living entity occupying a slot.
+	 *
+	 * \param index The slot index.
+	 * \return The handle of the entity, or NO_ENTITY if the slot is free.
+	 */
+	Entity GetEntity(Entity index) const;
+
+	/**
+	 * \brief Retrieves the handles of all living entities, in slot order.
+	 *
+	 * The returned list is a snapshot, so entities may be created or destroyed while
+	 * iterating over it. Destroyed entries then simply fail IsValid.
+	 *
+	 * \return The handles of all living entities.
+	 */
+	std::vector<Entity> GetLivingEntities() const;
+
+	/**
+	 * \brief Retrieves the number of entity slots currently allocated.
+	 */
+	uint32_t GetCapacity() const;
+
 	/**
 	 * \brief Retrieves the signature associated with an entity.
 	 *
@@ -88,6 +121,9 @@ public:
 
 	/**
 	 * \brief Destroys all entities managed by the EntityManager.
+	 *
+	 * Every slot's generation is bumped, so handles from before the clear become stale
+	 * and new entities are handed out from slot 0 again.
 	 */
 	void DestroyAllEntities();
 
@@ -113,6 +149,7 @@ public:
 	 * \brief Sets the active state of an entity.
 	 *
 	 * An active entity is considered alive and will be processed by the ECS system.
+	 * Use ECSManager::SetActive instead so that active-only views are kept in sync.
 	 *
 	 * \param entity The ID of the entity.
 	 * \param active The active state to set for the entity.
@@ -128,13 +165,20 @@ public:
 	bool GetActive(Entity entity);
 
 private:
+	/**
+	 * \brief Adds ENTITY_CHUNK_SIZE slots to every per-entity array and the available pool.
+	 */
+	void Grow();
+
 	static constexpr Layer NO_LAYER = MAX_LAYERS; ///< Default value indicating no layer assigned.
-	std::array<Layer, MAX_ENTITIES> entityLayers; ///< Stores the layer of each entity.
+	std::vector<Layer> entityLayers; ///< Stores the layer of each entity.
 
-	std::queue<Entity> m_availableEntities{}; ///< Pool of available entity IDs.
-	std::bitset<MAX_ENTITIES> m_activeEntities; ///< Tracks active entities.
+	std::queue<Entity> m_availableEntities{}; ///< Pool of available slot indices.
+	std::vector<bool> m_activeEntities; ///< Tracks active entities.
+	std::vector<bool> m_aliveEntities; ///< Tracks which slots are occupied.
+	std::vector<Entity> m_generations; ///< Current generation of each slot.
 
-	std::array<Signature, MAX_ENTITIES> m_signatures{}; ///< Signatures for all entities.
+	std::vector<Signature> m_signatures{}; ///< Signatures for all entities.
 
 	uint32_t m_livingEntityCount{}; ///< Total count of currently active entities.
 };
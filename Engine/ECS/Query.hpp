@@ -0,0 +1,303 @@
+/*********************************************************************
+ * \file		Query.hpp
+ * \brief		Cached list of entities matching a component signature
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		1 September 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef QUERY_HPP
+#define QUERY_HPP
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <utility>
+
+#include "Entity.hpp"
+#include "Signature.hpp"
+
+/**
+ * \class QueryObserver
+ * \brief Receives the entities a query gains and loses, once the changes are applied.
+ *
+ * Lets a system keep its own per-entity state in step with its query instead of rebuilding it
+ * every update. Changes deferred by a lock are reported when the last lock is released.
+ */
+class QueryObserver {
+public:
+	virtual ~QueryObserver() = default;
+
+	virtual void OnEntityInserted(Entity entity) = 0;
+	virtual void OnEntityErased(Entity entity) = 0;
+	virtual void OnEntitiesCleared() = 0;
+};
+
+/**
+ * \class Query
+ * \brief Incrementally maintained, contiguous list of entities matching a filter.
+ *
+ * An entity matches when its signature contains every bit of the include signature, none of the
+ * bits of the exclude signature and, for active-only queries, the entity is active. Entities are
+ * kept in a flat vector, with a paged map from an entity's slot index to its place in the vector
+ * as in ComponentArray, so inserting, erasing and finding an entity is constant time. An erase
+ * swaps the last entity into the erased one's place, so the order is that of insertion only
+ * until the first erase.
+ *
+ * While a query is locked (see ScopedLock), inserts and erases are deferred until the last lock
+ * is released, so the list can be iterated safely while scripts or systems create and destroy
+ * entities. Entities erased while locked are flagged, and reported by IsPendingErase so iteration
+ * can skip them.
+ *
+ * A query is not synchronized. Entities are only created, destroyed and changed by exclusive
+ * systems or between updates (see SystemAccess), so a query is locked, unlocked and changed on one
+ * thread at a time. Jobs a system starts while it holds the lock may read the query, including
+ * IsPendingErase, but must not lock or change it.
+ */
+class Query {
+public:
+	/**
+	 * \class ScopedLock
+	 * \brief Defers structural changes to a query for the lifetime of the lock.
+	 */
+	class ScopedLock {
+	public:
+		explicit ScopedLock(Query& query) : m_query(query) { m_query.Lock(); }
+		~ScopedLock() { m_query.Unlock(); }
+
+		ScopedLock(const ScopedLock&) = delete;
+		ScopedLock& operator=(const ScopedLock&) = delete;
+
+	private:
+		Query& m_query;
+	};
+
+	Query() = default;
+
+	/**
+	 * \brief Constructs a query with the given filter.
+	 *
+	 * \param include Components an entity must have.
+	 * \param exclude Components an entity must not have.
+	 * \param activeOnly Whether inactive entities are filtered out.
+	 */
+	Query(Signature include, Signature exclude, bool activeOnly)
+		: m_include(include), m_exclude(exclude), m_activeOnly(activeOnly) {}
+
+	// Systems and views hold references to their query.
+	Query(const Query&) = delete;
+	Query& operator=(const Query&) = delete;
+
+	/**
+	 * \brief Sets the filter of the query. Existing entities are not re-evaluated.
+	 */
+	void SetFilter(Signature include, Signature exclude = {}, bool activeOnly = false) {
+		m_include = include;
+		m_exclude = exclude;
+		m_activeOnly = activeOnly;
+	}
+
+	/**
+	 * \brief Sets the observer notified of inserts and erases, reporting the entities already
+	 *        in the query as inserted. Pass nullptr to stop observing.
+	 */
+	void SetObserver(QueryObserver* observer) {
+		m_observer = observer;
+		if (m_observer) {
+			for (Entity entity : m_entities) {
+				m_observer->OnEntityInserted(entity);
+			}
+		}
+	}
+
+	Signature GetInclude() const { return m_include; }
+	Signature GetExclude() const { return m_exclude; }
+	bool IsActiveOnly() const { return m_activeOnly; }
+
+	/**
+	 * \brief Checks whether an entity with the given state passes the filter.
+	 */
+	bool Matches(Signature signature, bool active) const {
+		return (signature & m_include) == m_include
+			&& (signature & m_exclude).none()
+			&& (active || !m_activeOnly);
+	}
+
+	/**
+	 * \brief Re-evaluates an entity against the filter, inserting or erasing it as needed.
+	 */
+	void Refresh(Entity entity, Signature signature, bool active) {
+		if (Matches(signature, active)) {
+			Insert(entity);
+		}
+		else {
+			Erase(entity);
+		}
+	}
+
+	/**
+	 * \brief Adds an entity to the query if it is not already present.
+	 */
+	void Insert(Entity entity) {
+		uint32_t slot = Find(entity);
+		if (m_lockCount > 0) {
+			m_pending.emplace_back(entity, true);
+			if (slot != INVALID_SLOT) {
+				m_pendingErase[slot] = 0;
+			}
+			return;
+		}
+
+		if (slot == INVALID_SLOT) {
+			Slot(entity) = static_cast<uint32_t>(m_entities.size());
+			m_entities.push_back(entity);
+			m_pendingErase.push_back(0);
+			if (m_observer) m_observer->OnEntityInserted(entity);
+		}
+	}
+
+	/**
+	 * \brief Removes an entity from the query if it is present.
+	 */
+	void Erase(Entity entity) {
+		uint32_t slot = Find(entity);
+		if (m_lockCount > 0) {
+			m_pending.emplace_back(entity, false);
+			if (slot != INVALID_SLOT) {
+				m_pendingErase[slot] = 1;
+			}
+			return;
+		}
+
+		if (slot == INVALID_SLOT) {
+			return;
+		}
+
+		uint32_t last = static_cast<uint32_t>(m_entities.size()) - 1;
+		if (slot != last) {
+			m_entities[slot] = m_entities[last];
+			m_pendingErase[slot] = m_pendingErase[last];
+			Slot(m_entities[slot]) = slot;
+		}
+		m_entities.pop_back();
+		m_pendingErase.pop_back();
+		Slot(entity) = INVALID_SLOT;
+		if (m_observer) m_observer->OnEntityErased(entity);
+	}
+
+	/**
+	 * \brief Removes every entity from the query, including deferred changes.
+	 */
+	void Clear() {
+		m_entities.clear();
+		m_pendingErase.clear();
+		m_slotPages.clear();
+		m_pending.clear();
+		if (m_observer) m_observer->OnEntitiesCleared();
+	}
+
+	/**
+	 * \brief Checks whether an entity is currently in the query.
+	 */
+	bool Contains(Entity entity) const {
+		return Find(entity) != INVALID_SLOT;
+	}
+
+	/**
+	 * \brief Checks whether an entity in the query was erased while the query is locked.
+	 */
+	bool IsPendingErase(Entity entity) const {
+		uint32_t slot = Find(entity);
+		return slot != INVALID_SLOT && m_pendingErase[slot];
+	}
+
+	const std::vector<Entity>& GetEntities() const { return m_entities; }
+	size_t size() const { return m_entities.size(); }
+	bool empty() const { return m_entities.empty(); }
+	std::vector<Entity>::const_iterator begin() const { return m_entities.begin(); }
+	std::vector<Entity>::const_iterator end() const { return m_entities.end(); }
+
+	/**
+	 * \brief Starts deferring structural changes. Locks nest.
+	 */
+	void Lock() {
+		++m_lockCount;
+	}
+
+	/**
+	 * \brief Releases a lock, applying deferred changes once the last lock is released.
+	 */
+	void Unlock() {
+		if (--m_lockCount > 0 || m_pending.empty()) {
+			return;
+		}
+
+		std::vector<std::pair<Entity, bool>> pending;
+		pending.swap(m_pending);
+		for (auto const& [entity, insert] : pending) {
+			if (insert) {
+				Insert(entity);
+			}
+			else {
+				Erase(entity);
+			}
+		}
+	}
+
+private:
+	static constexpr uint32_t INVALID_SLOT = UINT32_MAX;		/**< Slot value for entities not in the query. */
+
+	static constexpr uint32_t SLOT_PAGE_SHIFT = 10;				/**< 1024 entities per slot page. */
+	static constexpr uint32_t SLOT_PAGE_SIZE = 1u << SLOT_PAGE_SHIFT;
+	static constexpr uint32_t SLOT_PAGE_MASK = SLOT_PAGE_SIZE - 1;
+
+	using SlotPage = std::array<uint32_t, SLOT_PAGE_SIZE>;
+
+	/**
+	 * \brief Finds an entity's place in the entity list, or INVALID_SLOT if it is not in the query.
+	 */
+	uint32_t Find(Entity entity) const {
+		Entity index = EntityIndex(entity);
+		size_t page = index >> SLOT_PAGE_SHIFT;
+		if (page >= m_slotPages.size() || !m_slotPages[page]) {
+			return INVALID_SLOT;
+		}
+		uint32_t slot = (*m_slotPages[page])[index & SLOT_PAGE_MASK];
+		return slot < m_entities.size() && m_entities[slot] == entity ? slot : INVALID_SLOT;
+	}
+
+	/**
+	 * \brief Retrieves the slot entry of an entity, allocating its page if needed.
+	 */
+	uint32_t& Slot(Entity entity) {
+		Entity index = EntityIndex(entity);
+		size_t page = index >> SLOT_PAGE_SHIFT;
+		if (page >= m_slotPages.size()) {
+			m_slotPages.resize(page + 1);
+		}
+		if (!m_slotPages[page]) {
+			m_slotPages[page] = std::make_unique<SlotPage>();
+			m_slotPages[page]->fill(INVALID_SLOT);
+		}
+		return (*m_slotPages[page])[index & SLOT_PAGE_MASK];
+	}
+
+	Signature m_include{};								/**< Components an entity must have. */
+	Signature m_exclude{};								/**< Components an entity must not have. */
+	bool m_activeOnly = false;							/**< Whether inactive entities are filtered out. */
+
+	std::vector<Entity> m_entities{};					/**< Matching entities, packed. */
+	std::vector<uint8_t> m_pendingErase{};				/**< Per entity in m_entities, whether it was erased while locked. */
+	std::vector<std::unique_ptr<SlotPage>> m_slotPages{};	/**< Maps slot indices to places in m_entities, allocated per page. */
+	std::vector<std::pair<Entity, bool>> m_pending{};	/**< Changes deferred while locked (true = insert). */
+	QueryObserver* m_observer = nullptr;				/**< Notified of applied inserts and erases, if set. */
+	int m_lockCount = 0;								/**< Number of active locks. */
+};
+
+#endif // !QUERY_HPP
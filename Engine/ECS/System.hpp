@@ -16,8 +16,55 @@
 #ifndef SYSTEM_H
 #define	SYSTEM_H
 
+#include <bitset>
+
 #include "Entity.hpp"
-#include <set>
+#include "Signature.hpp"
+#include "Query.hpp"
+
+/**
+ * \enum SharedResource
+ * \brief Engine state outside the ECS that systems may touch.
+ */
+enum class SharedResource {
+	GRAPHICS,	/**< GraphicsManager meshes, batches and cameras. */
+	AUDIO,		/**< AudioManager channels. */
+	SCRIPTING,	/**< The scripting runtime. */
+	COUNT
+};
+
+/**
+ * \struct SystemAccess
+ * \brief Declares which components and shared resources a system reads and writes.
+ *
+ * Used by the SystemScheduler to decide which systems may run at the same time. The default is
+ * exclusive, main-thread access, which is always safe. A system that creates or destroys entities,
+ * adds or removes components, or calls into scripts must stay exclusive.
+ */
+struct SystemAccess {
+	using Resources = std::bitset<static_cast<size_t>(SharedResource::COUNT)>;
+
+	Signature reads{};			/**< Components the system only reads. */
+	Signature writes{};			/**< Components the system modifies. */
+	Resources resources{};		/**< Shared resources the system uses. */
+	bool mainThread = true;		/**< Must run on the main thread (OpenGL, FMOD). */
+	bool exclusive = true;		/**< Conflicts with every other system. */
+
+	SystemAccess& Use(SharedResource resource) {
+		resources.set(static_cast<size_t>(resource));
+		return *this;
+	}
+
+	/**
+	 * \brief Checks whether two systems must not run at the same time.
+	 */
+	bool ConflictsWith(SystemAccess const& other) const {
+		return exclusive || other.exclusive
+			|| (writes & (other.reads | other.writes)).any()
+			|| (other.writes & reads).any()
+			|| (resources & other.resources).any();
+	}
+};
 
 /**
  * \class System
@@ -25,10 +72,24 @@
  *
  * The System class stores a set of entities that this system operates on. Each system is responsible
  * for processing entities that match certain component signatures.
+ *
+ * The entities are held in a Query kept up to date by the SystemManager. Hold a
+ * Query::ScopedLock (or use a View) when the loop body may create or destroy entities.
  */
 class System {
 public:
-    std::set<Entity> m_entities; /**< A set of entities that this system processes. */
+    virtual ~System() = default;
+
+    /**
+     * \brief Called for every system when an entity is destroyed, while its components still exist.
+     *
+     * Systems that hold resources outside the ECS for an entity's components release them here.
+     * Not called when all entities are cleared at once; scene-wide resources are freed on exit.
+     */
+    virtual void OnEntityDestroyed(Entity) {}
+
+    Query m_entities; /**< The entities that this system processes. */
+    SystemAccess m_access; /**< What the system touches during its update, used for scheduling. */
 
 };
 
@@ -16,14 +16,21 @@
 #define SYSTEM_MANAGER_HPP
 
 #include <memory>
+#include <array>
+#include <vector>
 #include <unordered_map>
 
 #include "Signature.hpp"
 #include "System.hpp"
+#include "Query.hpp"
 
 /**
  * \class SystemManager
  * \brief Manages the registration, signatures, and entity associations of all systems in the ECS framework.
+ *
+ * Every system's entity list, as well as every view created through the ECSManager, is a Query.
+ * Queries are indexed by the component types they include or exclude, so a signature change only
+ * re-evaluates the queries that care about the component that was added or removed.
  */
 class SystemManager {
 public:
@@ -63,23 +70,72 @@ public:
 		assert(systems.find(typeName) != systems.end() && "System used before registered.");
 
 		// Set the signature for this system
-		signatures.insert({ typeName, signature });
+		Query& query = systems[typeName]->m_entities;
+		query.SetFilter(signature);
+		IndexQuery(query);
+	}
+
+	/**
+	 * \brief Declares what a registered system touches during its update.
+	 *
+	 * \tparam T The type of the system.
+	 * \param access The components and shared resources the system reads and writes.
+	 */
+	template<typename T>
+	void SetAccess(SystemAccess const& access) {
+		const char* typeName = typeid(T).name();
+
+		assert(systems.find(typeName) != systems.end() && "System used before registered.");
+
+		systems[typeName]->m_access = access;
+	}
+
+	/**
+	 * \brief Finds the query with the given filter, if one has been created.
+	 *
+	 * System queries are shared with views that use the same filter.
+	 *
+	 * \return The query, or nullptr if there is none.
+	 */
+	Query* FindQuery(Signature include, Signature exclude, bool activeOnly) {
+		for (Query* query : allQueries) {
+			if (query->GetInclude() == include && query->GetExclude() == exclude && query->IsActiveOnly() == activeOnly) {
+				return query;
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	 * \brief Creates and indexes a query with the given filter.
+	 *
+	 * The query starts empty; the caller is responsible for populating it with existing entities.
+	 *
+	 * \return The new query.
+	 */
+	Query& AddQuery(Signature include, Signature exclude, bool activeOnly) {
+		viewQueries.push_back(std::make_unique<Query>(include, exclude, activeOnly));
+		IndexQuery(*viewQueries.back());
+		return *viewQueries.back();
 	}
 
 	/**
 	 * \brief Handles the destruction of an entity.
 	 *
-	 * Removes the entity from all system-managed entity sets.
+	 * Lets every system release what it holds for the entity, then removes the entity from all
+	 * system-managed entity sets. Must be called before the entity's components are removed.
 	 *
-	 * \param entity The entity that was destroyed.
+	 * \param entity The entity being destroyed.
 	 */
 	void EntityDestroyed(Entity entity) {
-		// Erase a destroyed entity from all system lists
-		// mEntities is a set so no check needed
-		for (auto const& pair : systems) {
-			auto const& system = pair.second;
+		for (auto const& [typeName, system] : systems) {
+			system->OnEntityDestroyed(entity);
+		}
 
-			system->m_entities.erase(entity);
+		// Erase a destroyed entity from all query lists
+		// Queries ignore entities they do not contain so no check needed
+		for (Query* query : allQueries) {
+			query->Erase(entity);
 		}
 	}
 
@@ -89,36 +145,37 @@ public:
 	 * Used to handle scenarios where all entities are destroyed at once.
 	 */
 	void AllEntitiesDestroyed() {
-		for (auto const& pair : systems) {
-			auto const& system = pair.second;
-
-			system->m_entities.clear();
+		for (Query* query : allQueries) {
+			query->Clear();
 		}
 	}
 
 	/**
 	 * \brief Updates systems when an entity's signature changes.
 	 *
-	 * Notifies all systems of an entity's signature change and adjusts their entity sets accordingly.
+	 * Only the queries that include or exclude the changed component are re-evaluated.
 	 *
 	 * \param entity The entity whose signature changed.
 	 * \param entitySignature The new signature of the entity.
+	 * \param changedType The component type that was added or removed.
+	 * \param active Whether the entity is active.
 	 */
-	void EntitySignatureChanged(Entity entity, Signature entitySignature) {
-		// Notify each system that an entity's signature changed
-		for (auto const& pair : systems) {
-			auto const& type = pair.first;
-			auto const& system = pair.second;
-			auto const& systemSignature = signatures[type];
-
-			// Entity signature matches system signature - insert into set
-			if ((entitySignature & systemSignature) == systemSignature) {
-				system->m_entities.insert(entity);
-			}
-			// Entity signature does not match system signature - erase from set
-			else {
-				system->m_entities.erase(entity);
-			}
+	void EntitySignatureChanged(Entity entity, Signature entitySignature, ComponentType changedType, bool active) {
+		for (Query* query : queriesByComponent[changedType]) {
+			query->Refresh(entity, entitySignature, active);
+		}
+	}
+
+	/**
+	 * \brief Updates the active-only queries when an entity is activated or deactivated.
+	 *
+	 * \param entity The entity whose active state changed.
+	 * \param entitySignature The signature of the entity.
+	 * \param active The new active state of the entity.
+	 */
+	void EntityActiveChanged(Entity entity, Signature entitySignature, bool active) {
+		for (Query* query : activeOnlyQueries) {
+			query->Refresh(entity, entitySignature, active);
 		}
 	}
 
@@ -128,11 +185,22 @@ public:
 
 private:
 	/**
-	 * \brief Map from system type name to its signature.
-	 *
-	 * Signatures define the component requirements for each system.
+	 * \brief Registers a query in the lookup tables used to route entity changes.
 	 */
-	std::unordered_map<const char*, Signature> signatures{};
+	void IndexQuery(Query& query) {
+		allQueries.push_back(&query);
+
+		Signature relevant = query.GetInclude() | query.GetExclude();
+		for (ComponentType type = 0; type < MAX_COMPONENTS; ++type) {
+			if (relevant.test(type)) {
+				queriesByComponent[type].push_back(&query);
+			}
+		}
+
+		if (query.IsActiveOnly()) {
+			activeOnlyQueries.push_back(&query);
+		}
+	}
 
 	/**
 	 * \brief Map from system type name to the system instance.
@@ -140,6 +208,11 @@ private:
 	 * Stores all registered systems, allowing them to be managed collectively.
 	 */
 	std::unordered_map<const char*, std::shared_ptr<System>> systems{};
+
+	std::vector<std::unique_ptr<Query>> viewQueries{};							/**< Queries created for views. */
+	std::vector<Query*> allQueries{};											/**< Every system and view query. */
+	std::array<std::vector<Query*>, MAX_COMPONENTS> queriesByComponent{};		/**< Queries that include or exclude each component type. */
+	std::vector<Query*> activeOnlyQueries{};									/**< Queries that filter on the active state. */
 };
 
 #endif // !SYSTEM_MANAGER_H
\ No newline at end of file
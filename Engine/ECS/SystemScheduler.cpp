@@ -0,0 +1,127 @@
+/*********************************************************************
+ * \file		SystemScheduler.cpp
+ * \brief		Runs systems in parallel based on the components
+ *				and shared resources they declare they access
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		1 September 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include "SystemScheduler.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+
+#include "../Utility/JobSystem.hpp"
+#include "../Utility/Profiler.hpp"
+
+void SystemScheduler::Add(std::string name, SystemAccess const& access, std::function<void()> run) {
+	m_tasks.push_back({ std::move(name), access, std::move(run) });
+}
+
+void SystemScheduler::BuildGraph() {
+	// Edges only point from earlier tasks to later ones, so the order of addition is always a
+	// valid topological order of the graph.
+	for (size_t later = 1; later < m_tasks.size(); ++later) {
+		for (size_t earlier = 0; earlier < later; ++earlier) {
+			if (m_tasks[earlier].access.ConflictsWith(m_tasks[later].access)) {
+				m_tasks[earlier].dependents.push_back(later);
+				++m_tasks[later].numDependencies;
+			}
+		}
+	}
+}
+
+void SystemScheduler::Run() {
+	PROFILE_SCOPE("SystemScheduler::Run");
+	JobSystem& jobSystem = JobSystem::GetInstance();
+
+	if (jobSystem.IsSingleThreaded()) {
+		for (auto& task : m_tasks) {
+			task.run();
+		}
+		m_tasks.clear();
+		return;
+	}
+
+	BuildGraph();
+
+	// Ready tasks are taken lowest index first so main-thread tasks keep a stable order.
+	std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> ready;
+	for (size_t i = 0; i < m_tasks.size(); ++i) {
+		if (m_tasks[i].numDependencies == 0) {
+			ready.push(i);
+		}
+	}
+
+	std::mutex finishedMutex;
+	std::condition_variable finishedCondition;
+	std::vector<size_t> finished;
+	std::vector<size_t> finishedLocal;
+	JobCounter counter;
+	size_t numCompleted = 0;
+
+	auto complete = [&](size_t index) {
+		for (size_t dependent : m_tasks[index].dependents) {
+			if (--m_tasks[dependent].numDependencies == 0) {
+				ready.push(dependent);
+			}
+		}
+		++numCompleted;
+	};
+
+	std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> readyOnMainThread;
+	while (numCompleted < m_tasks.size()) {
+		// Hand every ready worker task to the pool before running anything on this thread.
+		while (!ready.empty()) {
+			size_t index = ready.top();
+			ready.pop();
+
+			if (m_tasks[index].access.mainThread) {
+				readyOnMainThread.push(index);
+				continue;
+			}
+
+			jobSystem.Submit([this, index, &finishedMutex, &finishedCondition, &finished] {
+				m_tasks[index].run();
+				{
+					std::lock_guard<std::mutex> lock(finishedMutex);
+					finished.push_back(index);
+				}
+				finishedCondition.notify_one();
+			}, counter);
+		}
+
+		if (!readyOnMainThread.empty()) {
+			size_t index = readyOnMainThread.top();
+			readyOnMainThread.pop();
+			m_tasks[index].run();
+			complete(index);
+		}
+		else {
+			std::unique_lock<std::mutex> lock(finishedMutex);
+			finishedCondition.wait(lock, [&finished] { return !finished.empty(); });
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(finishedMutex);
+			finishedLocal.swap(finished);
+		}
+		for (size_t index : finishedLocal) {
+			complete(index);
+		}
+		finishedLocal.clear();
+	}
+
+	// Every task has reported back; make sure the jobs themselves have fully returned.
+	jobSystem.Wait(counter);
+	m_tasks.clear();
+}
@@ -0,0 +1,83 @@
+/*********************************************************************
+ * \file		SystemScheduler.hpp
+ * \brief		Runs systems in parallel based on the components
+ *				and shared resources they declare they access
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		1 September 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef SYSTEM_SCHEDULER_HPP
+#define SYSTEM_SCHEDULER_HPP
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "System.hpp"
+
+/**
+ * \class SystemScheduler
+ * \brief Builds a dependency graph from the systems added for a frame and runs it on the job system.
+ *
+ * Systems are added in the order they would run sequentially. A system depends on every earlier
+ * system whose access conflicts with its own, so any two systems that touch the same data keep
+ * their original order, while systems that do not conflict may run at the same time. Main-thread
+ * systems always run on the thread that calls Run; the rest are handed to the worker pool.
+ *
+ * When the job system is single-threaded, systems simply run in the order they were added.
+ */
+class SystemScheduler {
+public:
+	/**
+	 * \brief Adds a system to the current frame.
+	 *
+	 * \param name Name used in log messages.
+	 * \param access The components and resources the system touches.
+	 * \param run Runs the system's update.
+	 */
+	void Add(std::string name, SystemAccess const& access, std::function<void()> run);
+
+	/**
+	 * \brief Adds a system to the current frame using the access it declared.
+	 */
+	void Add(std::string name, System const& system, std::function<void()> run) {
+		Add(std::move(name), system.m_access, std::move(run));
+	}
+
+	/**
+	 * \brief Runs every added system, respecting their dependencies, then clears the frame.
+	 */
+	void Run();
+
+	/**
+	 * \brief Removes all added systems without running them.
+	 */
+	void Clear() { m_tasks.clear(); }
+
+	size_t Size() const { return m_tasks.size(); }
+
+private:
+	struct Task {
+		std::string name;					/**< Name used in log messages. */
+		SystemAccess access;				/**< Declared access of the system. */
+		std::function<void()> run;			/**< The system's update. */
+		std::vector<size_t> dependents{};	/**< Tasks that must wait for this one. */
+		size_t numDependencies = 0;			/**< Number of tasks this one waits for. */
+	};
+
+	/**
+	 * \brief Fills in the dependency edges between the added tasks.
+	 */
+	void BuildGraph();
+
+	std::vector<Task> m_tasks{};	/**< Systems added for the current frame, in sequential order. */
+};
+
+#endif // !SYSTEM_SCHEDULER_HPP
@@ -0,0 +1,84 @@
+/*********************************************************************
+ * \file		View.hpp
+ * \brief		Typed iteration over the entities of a query
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		1 September 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef VIEW_HPP
+#define VIEW_HPP
+
+#include <tuple>
+
+#include "Query.hpp"
+#include "ComponentArray.hpp"
+
+/**
+ * \enum ViewFilter
+ * \brief Additional filters applied on top of the component signature of a view.
+ */
+enum class ViewFilter {
+	NONE,			/**< All entities with the components. */
+	ACTIVE_ONLY		/**< Only entities that are active. */
+};
+
+/**
+ * \class View
+ * \brief Iterates the entities of a cached query and hands out their components directly.
+ *
+ * Views are cheap handles obtained from ECSManager::GetView. The component arrays are resolved
+ * once when the view is created, so iteration does no type lookups. Entities may be created,
+ * destroyed or have components changed while iterating; those changes are applied to the query
+ * after the outermost ForEach returns, and entities erased in the meantime are skipped.
+ *
+ * \tparam Ts The component types every entity in the view has.
+ */
+template<typename... Ts>
+class View {
+public:
+	View(Query& query, ComponentArray<Ts>*... arrays)
+		: m_query(query), m_arrays(arrays...) {}
+
+	/**
+	 * \brief Invokes func(entity, Ts&...) for every entity in the view.
+	 */
+	template<typename Func>
+	void ForEach(Func&& func) {
+		Query::ScopedLock lock(m_query);
+		for (Entity entity : m_query) {
+			if (m_query.IsPendingErase(entity)) {
+				continue;
+			}
+			func(entity, std::get<ComponentArray<Ts>*>(m_arrays)->GetData(entity)...);
+		}
+	}
+
+	/**
+	 * \brief Retrieves the components of an entity in the view.
+	 */
+	std::tuple<Ts&...> Get(Entity entity) {
+		return std::tuple<Ts&...>(std::get<ComponentArray<Ts>*>(m_arrays)->GetData(entity)...);
+	}
+
+	bool Contains(Entity entity) const { return m_query.Contains(entity); }
+	size_t Size() const { return m_query.size(); }
+	bool Empty() const { return m_query.empty(); }
+
+	/**
+	 * \brief Retrieves the underlying list of entities, in query order.
+	 */
+	const std::vector<Entity>& GetEntities() const { return m_query.GetEntities(); }
+
+private:
+	Query& m_query;									/**< The query backing this view. */
+	std::tuple<ComponentArray<Ts>*...> m_arrays;	/**< Component arrays resolved at creation. */
+};
+
+#endif // !VIEW_HPP
@@ -0,0 +1,263 @@
+/*********************************************************************
+ * \file		AtlasPacker.cpp
+ * \brief		Defines the MaxRects packer that places images into
+ *				the fixed-size pages of a texture atlas.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include "AtlasPacker.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace {
+	bool Contains(AtlasPacker::Rect const& outer, AtlasPacker::Rect const& inner) {
+		return inner.x >= outer.x && inner.y >= outer.y &&
+			inner.x + inner.width <= outer.x + outer.width &&
+			inner.y + inner.height <= outer.y + outer.height;
+	}
+
+	bool Overlaps(AtlasPacker::Rect const& a, AtlasPacker::Rect const& b) {
+		return a.x < b.x + b.width && b.x < a.x + a.width &&
+			a.y < b.y + b.height && b.y < a.y + a.height;
+	}
+}
+
+AtlasPacker::AtlasPacker(int pageWidth, int pageHeight, int padding, int maxPages)
+	: pageWidth(pageWidth), pageHeight(pageHeight), padding(padding), maxPages(maxPages) {
+}
+
+bool AtlasPacker::Insert(int width, int height, Placement& placement) {
+	placement = Placement{};
+	int paddedWidth = width + 2 * padding;
+	int paddedHeight = height + 2 * padding;
+	if (width <= 0 || height <= 0 || paddedWidth > pageWidth || paddedHeight > pageHeight) {
+		return false;
+	}
+
+	// Best short side fit over every open page, so gaps left in earlier pages are filled first
+	int bestPage = -1;
+	int bestShortSide = std::numeric_limits<int>::max();
+	int bestLongSide = std::numeric_limits<int>::max();
+	Rect bestRect;
+	for (size_t i = 0; i < pages.size(); ++i) {
+		Rect rect;
+		int shortSide, longSide;
+		if (FindPosition(pages[i], paddedWidth, paddedHeight, rect, shortSide, longSide) &&
+			(shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide))) {
+			bestPage = static_cast<int>(i);
+			bestShortSide = shortSide;
+			bestLongSide = longSide;
+			bestRect = rect;
+		}
+	}
+
+	if (bestPage < 0) {
+		if (GetPageCount() >= maxPages) {
+			return false;
+		}
+		OpenPage();
+		bestPage = GetPageCount() - 1;
+		bestRect = Rect{ 0, 0, paddedWidth, paddedHeight };
+	}
+
+	Place(pages[bestPage], bestRect);
+	placement.page = bestPage;
+	placement.rect = Rect{ bestRect.x + padding, bestRect.y + padding, width, height };
+	return true;
+}
+
+bool AtlasPacker::Reserve(Placement const& placement) {
+	if (placement.page < 0 || placement.page >= maxPages) {
+		return false;
+	}
+	while (GetPageCount() <= placement.page) {
+		OpenPage();
+	}
+
+	Rect padded{
+		placement.rect.x - padding, placement.rect.y - padding,
+		placement.rect.width + 2 * padding, placement.rect.height + 2 * padding
+	};
+
+	// Any empty rectangle lies inside at least one of the maximal free rectangles
+	Page& page = pages[placement.page];
+	bool isFree = std::any_of(page.freeRects.begin(), page.freeRects.end(),
+		[&padded](Rect const& free) { return Contains(free, padded); });
+	if (!isFree) {
+		return false;
+	}
+
+	Place(page, padded);
+	return true;
+}
+
+std::vector<AtlasPacker::Placement> AtlasPacker::Pack(std::vector<std::pair<int, int>> const& sizes) {
+	std::vector<size_t> order(sizes.size());
+	std::iota(order.begin(), order.end(), size_t{ 0 });
+	// Longest side first, then largest area, places the hardest images while the pages are still empty
+	std::stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) {
+		int sideA = std::max(sizes[a].first, sizes[a].second);
+		int sideB = std::max(sizes[b].first, sizes[b].second);
+		if (sideA != sideB) return sideA > sideB;
+		return static_cast<int64_t>(sizes[a].first) * sizes[a].second > static_cast<int64_t>(sizes[b].first) * sizes[b].second;
+	});
+
+	std::vector<Placement> placements(sizes.size());
+	for (size_t index : order) {
+		Insert(sizes[index].first, sizes[index].second, placements[index]);
+	}
+	return placements;
+}
+
+void AtlasPacker::Reset() {
+	pages.clear();
+}
+
+void AtlasPacker::ClearPage(int page) {
+	if (page < 0 || page >= GetPageCount()) {
+		return;
+	}
+
+	pages[page].freeRects.assign(1, Rect{ 0, 0, pageWidth, pageHeight });
+	pages[page].usedArea = 0;
+}
+
+double AtlasPacker::GetOccupancy() const {
+	if (pages.empty()) {
+		return 0.0;
+	}
+
+	int64_t usedArea = 0;
+	for (Page const& page : pages) {
+		usedArea += page.usedArea;
+	}
+	return static_cast<double>(usedArea) / (static_cast<double>(pageWidth) * pageHeight * pages.size());
+}
+
+AtlasPacker::Rect AtlasPacker::Trim(unsigned char const* pixels, int width, int height, int channels) {
+	if (channels != 4) {
+		return Rect{ 0, 0, width, height };
+	}
+
+	int minX = width, minY = height, maxX = -1, maxY = -1;
+	for (int y = 0; y < height; ++y) {
+		unsigned char const* row = pixels + static_cast<size_t>(y) * width * channels;
+		for (int x = 0; x < width; ++x) {
+			if (row[x * channels + 3] != 0) {
+				minX = std::min(minX, x);
+				maxX = std::max(maxX, x);
+				minY = std::min(minY, y);
+				maxY = std::max(maxY, y);
+			}
+		}
+	}
+
+	if (maxX < 0) {
+		return Rect{};
+	}
+	return Rect{ minX, minY, maxX - minX + 1, maxY - minY + 1 };
+}
+
+void AtlasPacker::OpenPage() {
+	Page page;
+	page.freeRects.push_back(Rect{ 0, 0, pageWidth, pageHeight });
+	pages.push_back(std::move(page));
+}
+
+bool AtlasPacker::FindPosition(Page const& page, int width, int height, Rect& result, int& shortSide, int& longSide) const {
+	bool found = false;
+	shortSide = std::numeric_limits<int>::max();
+	longSide = std::numeric_limits<int>::max();
+	for (Rect const& free : page.freeRects) {
+		if (free.width < width || free.height < height) {
+			continue;
+		}
+
+		int leftoverX = free.width - width;
+		int leftoverY = free.height - height;
+		int freeShortSide = std::min(leftoverX, leftoverY);
+		int freeLongSide = std::max(leftoverX, leftoverY);
+		if (freeShortSide < shortSide || (freeShortSide == shortSide && freeLongSide < longSide)) {
+			result = Rect{ free.x, free.y, width, height };
+			shortSide = freeShortSide;
+			longSide = freeLongSide;
+			found = true;
+		}
+	}
+	return found;
+}
+
+void AtlasPacker::Place(Page& page, Rect const& used) {
+	std::vector<Rect> split;
+	for (size_t i = 0; i < page.freeRects.size();) {
+		if (SplitFreeRect(page.freeRects[i], used, split)) {
+			page.freeRects[i] = page.freeRects.back();
+			page.freeRects.pop_back();
+		}
+		else {
+			++i;
+		}
+	}
+	page.freeRects.insert(page.freeRects.end(), split.begin(), split.end());
+	PruneFreeRects(page.freeRects);
+	page.usedArea += static_cast<int64_t>(used.width) * used.height;
+}
+
+bool AtlasPacker::SplitFreeRect(Rect const& free, Rect const& used, std::vector<Rect>& split) {
+	if (!Overlaps(free, used)) {
+		return false;
+	}
+
+	// Keep the parts of the free rectangle on each side of the used one. They overlap at the corners.
+	if (used.x > free.x) {
+		split.push_back(Rect{ free.x, free.y, used.x - free.x, free.height });
+	}
+	if (used.x + used.width < free.x + free.width) {
+		int x = used.x + used.width;
+		split.push_back(Rect{ x, free.y, free.x + free.width - x, free.height });
+	}
+	if (used.y > free.y) {
+		split.push_back(Rect{ free.x, free.y, free.width, used.y - free.y });
+	}
+	if (used.y + used.height < free.y + free.height) {
+		int y = used.y + used.height;
+		split.push_back(Rect{ free.x, y, free.width, free.y + free.height - y });
+	}
+	return true;
+}
+
+void AtlasPacker::PruneFreeRects(std::vector<Rect>& freeRects) {
+	// Drop free rectangles that lie inside another one, they can never give a better fit
+	for (size_t i = 0; i < freeRects.size();) {
+		bool contained = false;
+		for (size_t j = i + 1; j < freeRects.size();) {
+			if (Contains(freeRects[i], freeRects[j])) {
+				freeRects.erase(freeRects.begin() + j);
+			}
+			else if (Contains(freeRects[j], freeRects[i])) {
+				contained = true;
+				break;
+			}
+			else {
+				++j;
+			}
+		}
+
+		if (contained) {
+			freeRects.erase(freeRects.begin() + i);
+		}
+		else {
+			++i;
+		}
+	}
+}
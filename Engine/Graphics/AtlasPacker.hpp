@@ -0,0 +1,137 @@
+/*********************************************************************
+ * \file		AtlasPacker.hpp
+ * \brief		Declares the MaxRects packer that places images into
+ *				the fixed-size pages of a texture atlas.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef ATLAS_PACKER_HPP
+#define ATLAS_PACKER_HPP
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * \class AtlasPacker
+ * \brief Packs rectangles into pages of a fixed size with the MaxRects algorithm.
+ *
+ * Each page keeps the list of maximal free rectangles. A rectangle goes to the free rectangle
+ * it fits most tightly along its shorter side (best short side fit), and the free rectangles it
+ * overlaps are split around it. Every rectangle is surrounded by a border of padding pixels so
+ * the texture can extrude its edges into it, which keeps filtering from reading its neighbours.
+ *
+ * The packer only does the bookkeeping, so the same code packs offline (Pack, which sorts the
+ * images first for a denser layout) and online (Insert, one image at a time as textures load).
+ */
+class AtlasPacker {
+public:
+	/**
+	 * \struct Rect
+	 * \brief Rectangle in pixels, with its origin at the bottom left of the page.
+	 */
+	struct Rect {
+		int x = 0, y = 0, width = 0, height = 0;
+	};
+
+	/**
+	 * \struct Placement
+	 * \brief Where an image was placed. The rect excludes the padding around it.
+	 */
+	struct Placement {
+		int page = -1;	// -1 if the image could not be placed
+		Rect rect;
+	};
+
+	/**
+	 * \brief Constructs an empty packer.
+	 *
+	 * \param pageWidth Width of every page in pixels.
+	 * \param pageHeight Height of every page in pixels.
+	 * \param padding Pixels kept free around each image, on every side.
+	 * \param maxPages Pages the packer may open before Insert fails.
+	 */
+	AtlasPacker(int pageWidth, int pageHeight, int padding, int maxPages);
+
+	/**
+	 * \brief Places one image, opening a new page if none of the open pages has room.
+	 *
+	 * \return False if the image is larger than a page or every page is full.
+	 */
+	bool Insert(int width, int height, Placement& placement);
+
+	/**
+	 * \brief Marks a rectangle of a page as used, for layouts cooked offline.
+	 *
+	 * \param placement Where the image was placed, without the padding.
+	 * \return False if the rectangle does not lie entirely in free space.
+	 */
+	bool Reserve(Placement const& placement);
+
+	/**
+	 * \brief Places a set of images, largest first.
+	 *
+	 * \param sizes Width and height of each image.
+	 * \return The placement of each image, in the order of sizes.
+	 */
+	std::vector<Placement> Pack(std::vector<std::pair<int, int>> const& sizes);
+
+	/**
+	 * \brief Removes every image and page.
+	 */
+	void Reset();
+
+	/**
+	 * \brief Removes every image from one page, which stays open for the images placed next.
+	 */
+	void ClearPage(int page);
+
+	int GetPageCount() const { return static_cast<int>(pages.size()); }
+	int GetPageWidth() const { return pageWidth; }
+	int GetPageHeight() const { return pageHeight; }
+	int GetPadding() const { return padding; }
+
+	/**
+	 * \brief Returns the fraction of the open pages covered by images, padding included.
+	 */
+	double GetOccupancy() const;
+
+	/**
+	 * \brief Finds the smallest rectangle holding every pixel whose alpha is not zero.
+	 *
+	 * \param pixels Image data, rows from the bottom up.
+	 * \param channels Bytes per pixel. Images without an alpha channel are never trimmed.
+	 * \return The trimmed rectangle, or an empty one if the image is fully transparent.
+	 */
+	static Rect Trim(unsigned char const* pixels, int width, int height, int channels);
+
+private:
+	/**
+	 * \struct Page
+	 * \brief Free space of a single page.
+	 */
+	struct Page {
+		std::vector<Rect> freeRects;	// Maximal free rectangles, which may overlap each other.
+		int64_t usedArea = 0;
+	};
+
+	void OpenPage();
+	bool FindPosition(Page const& page, int width, int height, Rect& result, int& shortSide, int& longSide) const;
+	void Place(Page& page, Rect const& used);
+	static bool SplitFreeRect(Rect const& free, Rect const& used, std::vector<Rect>& split);
+	static void PruneFreeRects(std::vector<Rect>& freeRects);
+
+	int pageWidth, pageHeight;
+	int padding;
+	int maxPages;
+	std::vector<Page> pages;
+};
+
+#endif // ATLAS_PACKER_HPP
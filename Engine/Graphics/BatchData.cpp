@@ -16,8 +16,13 @@
 #include "BatchData.hpp"
 #include "EngineCamera.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 BatchData::BatchData(size_t id, GLuint renderMode, GLuint polygonMode) :
-	id(id), renderMode(renderMode), polygonMode(polygonMode), vao(0), vbo(0), ebo(0), vertices(), indices(), isSorted(false), isUpdated(false)
+	id(id), renderMode(renderMode), polygonMode(polygonMode), vao(0), vbo(0), ebo(0), vertices(), indices(), meshFirstIndex(), isSorted(false), isUpdated(false),
+	sortKeys(), nextSortSequence(0), removedMeshes(0), meshSlots(), dirtyMeshes(), movedMeshes(), dirtyRanges(), verticesNeedFullUpload(false), indicesNeedUpload(false), vboCapacity(0), eboCapacity(0),
+	useInstancing(false), instances(), instanceVAO(0), instanceVBO(0), quadVBO(0), quadEBO(0), instanceCapacity(0), drawCounts(), drawOffsets()
 {
 	vertices.reserve(BATCH_SIZE);
 	indices.reserve(BATCH_SIZE);
@@ -32,50 +37,96 @@ void BatchData::Init()
     // Generate and bind VBO
     glGenBuffers(1, &vbo);
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(PackedVertex), vertices.data(), GL_DYNAMIC_DRAW);
+    vboCapacity = vertices.size();
 
     // Generate and bind EBO
     glGenBuffers(1, &ebo);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_DYNAMIC_DRAW);
+    eboCapacity = indices.size();
 
-    // Define the vertex attributes layout
-    // Position attribute (location = 0)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+    // Define the vertex attributes layout (see PackedVertex)
+    // Position x and y attribute (location = 0)
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, x));
     glEnableVertexAttribArray(0);
 
-    // Color attribute (location = 1)
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+    // Color attribute, RGBA8 normalized (location = 1)
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, color));
     glEnableVertexAttribArray(1);
 
-    // Normal attribute (location = 2)
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+    // Position z attribute, half float (location = 2)
+    glVertexAttribPointer(2, 1, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, depth));
     glEnableVertexAttribArray(2);
 
-    // Texture coordinate attribute (location = 3)
-    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
+    // Texture coordinate attribute, 16-bit normalized (location = 3)
+    glVertexAttribPointer(3, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, texCoord));
     glEnableVertexAttribArray(3);
 
-    // Texture Unit ID attribute (location = 4)
-    glVertexAttribIPointer(4, 1, GL_INT, sizeof(Vertex), (void*)offsetof(Vertex, texArray));
+    // Visibility, texture array ID and texture layer ID attribute (location = 4)
+    glVertexAttribIPointer(4, 1, GL_UNSIGNED_SHORT, sizeof(PackedVertex), (void*)offsetof(PackedVertex, texture));
     glEnableVertexAttribArray(4);
 
-    // Texture Layer attribute (location = 5)
-    glVertexAttribIPointer(5, 1, GL_INT, sizeof(Vertex), (void*)offsetof(Vertex, texLayer));
-    glEnableVertexAttribArray(5);
+    // Unbind
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+}
+
+void BatchData::InitInstancing()
+{
+    glGenVertexArrays(1, &instanceVAO);
+    glBindVertexArray(instanceVAO);
 
-    // Visibility attribute (location = 6)
-    glVertexAttribIPointer(6, 1, GL_INT, sizeof(Vertex), (void*)offsetof(Vertex, visible));
-    glEnableVertexAttribArray(6);
+    // Unit quad shared by every instance
+    glGenBuffers(1, &quadVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(SpriteInstance::UNIT_CORNERS), SpriteInstance::UNIT_CORNERS, GL_STATIC_DRAW);
+
+    glGenBuffers(1, &quadEBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(SpriteInstance::QUAD_INDICES), SpriteInstance::QUAD_INDICES, GL_STATIC_DRAW);
+
+    // Corner of the unit quad (location = 0)
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // Define the instance attributes layout (see SpriteInstance). Each advances once per instance.
+    glGenBuffers(1, &instanceVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_DYNAMIC_DRAW);
+    instanceCapacity = 0;
+
+    // Center, x axis and y axis (location = 1, 2, 3)
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)offsetof(SpriteInstance, center));
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)offsetof(SpriteInstance, axisX));
+    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)offsetof(SpriteInstance, axisY));
+
+    // Position z attribute, half float (location = 4)
+    glVertexAttribPointer(4, 1, GL_HALF_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)offsetof(SpriteInstance, depth));
+
+    // Visibility, texture array ID and texture layer ID attribute (location = 5)
+    glVertexAttribIPointer(5, 1, GL_UNSIGNED_SHORT, sizeof(SpriteInstance), (void*)offsetof(SpriteInstance, texture));
+
+    // Color attribute, RGBA8 normalized (location = 6)
+    glVertexAttribPointer(6, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SpriteInstance), (void*)offsetof(SpriteInstance, color));
+
+    // Texture coordinate rectangle, 16-bit normalized (location = 7)
+    glVertexAttribPointer(7, 4, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(SpriteInstance), (void*)offsetof(SpriteInstance, uvRect));
+
+    for (GLuint location = 1; location <= 7; ++location) {
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
 
     // Unbind
     glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
 }
 
-void BatchData::RenderToBuffer(Shader& shader, FrameBuffer& framebuffer, glm::mat4 view, glm::mat4 projection)
+void BatchData::RenderToBuffer(Shader& shader, FrameBuffer& framebuffer, std::vector<DrawRange> const* ranges)
 {
     // Use the shader
     shader.Use();
@@ -85,35 +136,18 @@ void BatchData::RenderToBuffer(Shader& shader, FrameBuffer& framebuffer, glm::ma
     // Set the viewport to the framebuffer size
     glViewport(0, 0, framebuffer.width, framebuffer.height);
 
-    // Updates the VBO with the batch vertices
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    // Uploads any changes made since the last draw. Batches drawn more than once a frame only upload the first time.
+    UpdateBuffers();
 
-    // Texture binding
-    auto& textureArray = Texture::GetTextureArray();
-    for (unsigned int i = 0; i < textureArray.size(); ++i) {
-        // Bind the texture using the unit
-        textureArray[i].Bind(i);
-
-        // Get uniform location only once
-        GLint loc = glGetUniformLocation(shader.id_gl, ("textureArrays[" + std::to_string(i) + "]").c_str());
-        if (loc != -1) {
-            glUniform1i(loc, i);  // Set the uniform to the current texture unit
-        }
-        else {
-            break;
+    // Texture binding. The samplers already point at units 0 to N-1 (see Shader::CacheUniforms)
+    if (shader.Uniform("textureArrays") != -1) {
+        auto& textureArray = Texture::GetTextureArray();
+        for (unsigned int i = 0; i < textureArray.size(); ++i) {
+            textureArray[i].Bind(i);
         }
     }
 
-    GLint viewLoc = glGetUniformLocation(shader.id_gl, "view");
-    if (viewLoc != -1) {
-        glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-    }
-    GLint projLoc = glGetUniformLocation(shader.id_gl, "projection");
-    if (projLoc != -1) {
-        glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
-    }
+    // The view and projection matrices come from the Camera uniform block bound by GraphicsManager
 
     if (renderMode == GL_LINES) {
         glLineWidth(2.0f);
@@ -122,11 +156,22 @@ void BatchData::RenderToBuffer(Shader& shader, FrameBuffer& framebuffer, glm::ma
     // Set the polygon mode
     glPolygonMode(GL_FRONT_AND_BACK, polygonMode);
 
-    // Bind the batch VAO
-    glBindVertexArray(vao);
+    if (ranges) {
+        DrawRanges(*ranges);
+    }
+    else if (useInstancing) {
+        // Draw the unit quad once per instance
+        glBindVertexArray(instanceVAO);
+        glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(std::size(SpriteInstance::QUAD_INDICES)),
+            GL_UNSIGNED_INT, 0, static_cast<GLsizei>(instances.size()));
+    }
+    else {
+        // Bind the batch VAO
+        glBindVertexArray(vao);
 
-    // Draw all elements in the batch
-    glDrawElements(renderMode, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
+        // Draw all elements in the batch
+        glDrawElements(renderMode, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
+    }
 
     // Unbind
     glBindVertexArray(0);
@@ -135,26 +180,220 @@ void BatchData::RenderToBuffer(Shader& shader, FrameBuffer& framebuffer, glm::ma
     framebuffer.Unbind();
 }
 
+void BatchData::DrawRanges(std::vector<DrawRange> const& ranges)
+{
+    if (useInstancing) {
+        // Each run is its own instanced draw, starting at the run's first instance
+        glBindVertexArray(instanceVAO);
+        for (DrawRange const& range : ranges) {
+            size_t first = std::min(range.first, instances.size());
+            size_t count = std::min(range.count, instances.size() - first);
+            if (count == 0) continue;
+            glDrawElementsInstancedBaseInstance(GL_TRIANGLES, static_cast<GLsizei>(std::size(SpriteInstance::QUAD_INDICES)),
+                GL_UNSIGNED_INT, 0, static_cast<GLsizei>(count), static_cast<GLuint>(first));
+        }
+        return;
+    }
+
+    // Turn the runs of meshes into runs of indices, drawn together with a single call
+    drawCounts.clear();
+    drawOffsets.clear();
+    if (meshFirstIndex.empty()) return;
+    size_t meshCount = meshFirstIndex.size() - 1;
+    for (DrawRange const& range : ranges) {
+        size_t first = std::min(range.first, meshCount);
+        size_t last = first + std::min(range.count, meshCount - first);
+        size_t firstIndex = meshFirstIndex[first];
+        size_t indexCount = meshFirstIndex[last] - firstIndex;
+        if (indexCount == 0) continue;
+        drawCounts.push_back(static_cast<GLsizei>(indexCount));
+        drawOffsets.push_back(reinterpret_cast<void const*>(firstIndex * sizeof(unsigned int)));
+    }
+
+    glBindVertexArray(vao);
+    if (!drawCounts.empty()) {
+        glMultiDrawElements(renderMode, drawCounts.data(), GL_UNSIGNED_INT, drawOffsets.data(), static_cast<GLsizei>(drawCounts.size()));
+    }
+}
+
 void BatchData::Exit() 
 {
 	glDeleteVertexArrays(1, &vao);
 	glDeleteBuffers(1, &vbo);
 	glDeleteBuffers(1, &ebo);
+
+	if (instanceVAO != 0) {
+		glDeleteVertexArrays(1, &instanceVAO);
+		glDeleteBuffers(1, &instanceVBO);
+		glDeleteBuffers(1, &quadVBO);
+		glDeleteBuffers(1, &quadEBO);
+		instanceVAO = instanceVBO = quadVBO = quadEBO = 0;
+		instanceCapacity = 0;
+	}
 }
 
 void BatchData::UpdateBuffers()
 {
-	glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-    
+    if (!verticesNeedFullUpload && !indicesNeedUpload && dirtyRanges.empty()) {
+        return;
+    }
+
+    if (useInstancing) {
+        // Instanced batches draw the shared unit quad, so only the instances are uploaded
+        if (instanceVAO == 0) InitInstancing();
+        UploadElements(instanceVBO, instances, instanceCapacity);
+    }
+    else {
+        UploadElements(vbo, vertices, vboCapacity);
+
+        if (indicesNeedUpload) {
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+            if (indices.size() > eboCapacity) {
+                eboCapacity = std::max(indices.size(), eboCapacity * 2);
+            }
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, eboCapacity * sizeof(unsigned int), nullptr, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indices.size() * sizeof(unsigned int), indices.data());
+            s_uploadedBytes += indices.size() * sizeof(unsigned int);
+        }
+    }
+
+    verticesNeedFullUpload = false;
+    indicesNeedUpload = false;
+    dirtyRanges.clear();
+
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
+template <typename Element>
+void BatchData::UploadElements(GLuint buffer, std::vector<Element> const& elements, size_t& capacity)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    if (verticesNeedFullUpload) {
+        if (elements.size() > capacity) {
+            // Grow geometrically so batches that keep gaining meshes are not reallocated every frame.
+            capacity = std::max(elements.size(), capacity * 2);
+        }
+        // Orphan the old storage so the driver does not wait for draws still reading it.
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(Element), nullptr, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, elements.size() * sizeof(Element), elements.data());
+        s_uploadedBytes += elements.size() * sizeof(Element);
+    }
+    else if (!dirtyRanges.empty()) {
+        // Upload each run of changed elements, joining runs separated by small gaps to save calls.
+        std::sort(dirtyRanges.begin(), dirtyRanges.end());
+        size_t first = dirtyRanges.front().first;
+        size_t last = dirtyRanges.front().second;
+        auto upload = [&elements](size_t begin, size_t end) {
+            end = std::min(end, elements.size());
+            if (begin >= end) return;
+            glBufferSubData(GL_ARRAY_BUFFER, begin * sizeof(Element), (end - begin) * sizeof(Element), elements.data() + begin);
+            s_uploadedBytes += (end - begin) * sizeof(Element);
+        };
+        for (auto const& [begin, end] : dirtyRanges) {
+            if (begin > last + DIRTY_MERGE_GAP) {
+                upload(first, last);
+                first = begin;
+            }
+            last = std::max(last, end);
+        }
+        upload(first, last);
+    }
+}
+
 bool BatchData::IsEmpty()
 {
-    return vertices.empty();
+    return useInstancing ? instances.empty() : vertices.empty();
+}
+
+void BatchData::MarkAllDirty()
+{
+    verticesNeedFullUpload = true;
+    indicesNeedUpload = true;
+    dirtyRanges.clear();
+    dirtyMeshes.clear();
+    movedMeshes.clear();
+}
+
+void BatchData::AddDirtyRange(size_t firstVertex, size_t count)
+{
+    if (verticesNeedFullUpload || count == 0) return;
+    dirtyRanges.emplace_back(firstVertex, firstVertex + count);
+}
+
+void BatchData::MarkMeshDirty(size_t meshID)
+{
+    // A pending rebuild copies every mesh anyway.
+    if (!isUpdated) return;
+
+    if (meshSlots.find(meshID) == meshSlots.end()) {
+        isUpdated = false;
+        return;
+    }
+    dirtyMeshes.push_back(meshID);
 }
 
+bool BatchData::PatchMesh(size_t meshID, Mesh const& mesh, std::vector<Vertex>& clipped)
+{
+    // If the vertex count changed, the indices and the following slots move too
+    auto slot = meshSlots.find(meshID);
+    if (slot == meshSlots.end() || slot->second.vertexCount != mesh.vertices.size()) {
+        return false;
+    }
+
+    size_t first = slot->second.firstVertex;
+    if (useInstancing) {
+        if (!BuildInstance(mesh, clipped, instances[first])) {
+            return false;
+        }
+        AddDirtyRange(first, 1);
+        return true;
+    }
+
+    std::vector<Vertex> const& drawn = mesh.GetDrawnVertices(clipped);
+    for (size_t i = 0; i < drawn.size(); ++i) {
+        vertices[first + i] = PackedVertex(drawn[i], mesh.texRect);
+    }
+    AddDirtyRange(first, drawn.size());
+    return true;
+}
+
+void BatchData::MarkMeshMoved(size_t meshID)
+{
+    if (!useInstancing || meshSlots.find(meshID) == meshSlots.end()) {
+        MarkMeshDirty(meshID);
+        return;
+    }
+    // A pending rebuild places every instance anyway.
+    if (!isUpdated) return;
+    movedMeshes.push_back(meshID);
+}
+
+bool BatchData::PatchTransform(size_t meshID, Mesh const& mesh)
+{
+    auto slot = meshSlots.find(meshID);
+    Vec3 corners[SpriteInstance::CORNER_COUNT];
+    if (!useInstancing || slot == meshSlots.end() || slot->second.vertexCount != mesh.vertices.size() ||
+        !mesh.GetDrawnModelCorners(corners)) {
+        return false;
+    }
+
+    size_t first = slot->second.firstVertex;
+    instances[first].SetTransform(corners, mesh.modelToWorld);
+    AddDirtyRange(first, 1);
+    return true;
+}
+
+bool BatchData::BuildInstance(Mesh const& mesh, std::vector<Vertex>& clipped, SpriteInstance& instance)
+{
+    // Stale positions still form the quad of an earlier transform, so they are good enough to check its shape
+    if (!SpriteInstance::FromQuad(mesh.GetDrawnVertices(clipped), mesh.indices, instance, mesh.texRect)) {
+        return false;
+    }
+    if (mesh.arePositionsStale) {
+        Vec3 corners[SpriteInstance::CORNER_COUNT];
+        if (!mesh.GetDrawnModelCorners(corners)) return false;
+        instance.SetTransform(corners, mesh.modelToWorld);
+    }
+    return true;
+}
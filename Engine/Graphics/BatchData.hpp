@@ -16,6 +16,7 @@
 #pragma once
 
 #include <vector>
+#include <unordered_map>
 #include <glad/glad.h>
 
 #include "../Application.hpp"
@@ -24,6 +25,7 @@
 #include "Shader.hpp"
 #include "FrameBuffer.hpp"
 #include "Mesh.hpp"
+#include "SpriteInstance.hpp"
 
 // for glm::mat4
 #include <glm/glm.hpp>
@@ -61,13 +63,25 @@ public:
 	 */
 	void Init();
 
+	/*!
+	 * \brief A run of consecutive meshes in draw order, by position in meshIDs.
+	 */
+	struct DrawRange {
+		size_t first;					//!< Position of the first mesh in the run.
+		size_t count;					//!< Number of meshes in the run.
+	};
+
 	/*!
 	 * \brief Renders the batched data to a framebuffer
 	 *
+	 * World batches use the camera currently bound to the Camera uniform
+	 * block, see GraphicsManager::BindCamera.
+	 *
 	 * \param shader The shader to use for rendering the batched data.
-	 * \param textures The textures to bind for the rendering.
+	 * \param framebuffer The framebuffer to render to.
+	 * \param ranges The meshes to draw, in draw order. Every mesh is drawn if null.
 	 */
-	void RenderToBuffer(Shader& shader, FrameBuffer& framebuffer, glm::mat4 view = glm::mat4(1.f), glm::mat4 projection = glm::mat4(1.f));
+	void RenderToBuffer(Shader& shader, FrameBuffer& framebuffer, std::vector<DrawRange> const* ranges = nullptr);
 
 	/*!
 	 * \brief Cleans up resources used by the batch data.
@@ -78,15 +92,104 @@ public:
 	void Exit();
 
 	/*!
-	 * \brief Updates the OpenGL buffers with the current vertex data.
+	 * \brief Uploads the pending changes to the OpenGL buffers.
 	 *
-	 * This function uploads the current vertex data and indices to the
-	 * GPU, ensuring that rendering uses the latest data.
+	 * After a full rebuild the whole vertex and index data is uploaded.
+	 * Otherwise only the dirty vertex ranges are uploaded with glBufferSubData.
+	 * Does nothing if the buffers are already up to date.
+	 *
+	 * The buffers are not persistently mapped rings (glBufferStorage, which the
+	 * 4.6 context does provide). A ring keeps a separate copy of the batch per
+	 * frame in flight. Each copy would then need every change made since it was
+	 * last written, or the whole batch every frame, while here a frame with no
+	 * changes uploads nothing. Ring storage is also immutable, so a batch that
+	 * outgrows it would need a new ring and new fences anyway.
 	 */
 	void UpdateBuffers();
 
+	/*!
+	 * \brief Checks whether the batch has nothing to draw.
+	 */
 	bool IsEmpty();
 
+	/*!
+	 * \brief Marks the whole batch for upload. Called after the vertices and indices are rebuilt.
+	 */
+	void MarkAllDirty();
+
+	/*!
+	 * \brief Marks a range of vertices, or of instances in an instanced batch, for upload.
+	 *
+	 * \param firstVertex Index of the first changed vertex or instance in the batch.
+	 * \param count Number of changed vertices or instances.
+	 */
+	void AddDirtyRange(size_t firstVertex, size_t count);
+
+	/*!
+	 * \brief Records that a mesh in the batch has changed.
+	 *
+	 * The mesh is copied into the batch by GraphicsManager::PatchBatch. If the
+	 * mesh has no slot in the batch, the whole batch is rebuilt instead.
+	 *
+	 * \param meshID The mesh that changed.
+	 */
+	void MarkMeshDirty(size_t meshID);
+
+	/*!
+	 * \brief Copies a changed mesh into its slot and marks the slot for upload.
+	 *
+	 * \param meshID The mesh that changed.
+	 * \param mesh The mesh's current data.
+	 * \param clipped Scratch space for the mesh's clipped vertices, reused between meshes.
+	 * \return False if the mesh no longer fits its slot, because it has no slot, its vertex
+	 *         count changed or, in an instanced batch, it is no longer a plain sprite. The batch
+	 *         must then be rebuilt.
+	 */
+	bool PatchMesh(size_t meshID, Mesh const& mesh, std::vector<Vertex>& clipped);
+
+	/*!
+	 * \brief Records that only the transform of a mesh in the batch has changed.
+	 *
+	 * In an instanced batch the mesh's instance is moved by PatchTransform. Otherwise, or if
+	 * the mesh has no slot, it is handled like MarkMeshDirty.
+	 *
+	 * \param meshID The mesh that moved.
+	 */
+	void MarkMeshMoved(size_t meshID);
+
+	/*!
+	 * \brief Moves a mesh's instance to the mesh's modelToWorld and marks it for upload.
+	 *
+	 * \param meshID The mesh that moved.
+	 * \param mesh The mesh's current data.
+	 * \return False if the batch is not instanced or the mesh no longer fits its slot. The batch
+	 *         must then be rebuilt.
+	 */
+	bool PatchTransform(size_t meshID, Mesh const& mesh);
+
+	/*!
+	 * \brief Converts a sprite mesh into an instance.
+	 *
+	 * The placement is taken from the mesh's modelToWorld when its positions are stale, so
+	 * sprites drawn as instances never need their vertices transformed.
+	 *
+	 * \param mesh The mesh to convert.
+	 * \param clipped Scratch space for the mesh's clipped vertices, reused between meshes.
+	 * \param instance Set to the instance when the conversion succeeds.
+	 * \return False if the mesh cannot be drawn as an instance, see SpriteInstance::FromQuad.
+	 */
+	static bool BuildInstance(Mesh const& mesh, std::vector<Vertex>& clipped, SpriteInstance& instance);
+
+	/*!
+	 * \brief Returns the number of bytes uploaded by all batches since the last ResetUploadStats call.
+	 */
+	static size_t GetUploadedBytes() { return s_uploadedBytes; }
+
+	/*!
+	 * \brief Resets the upload counter. Called once per frame by the render system.
+	 */
+	static void ResetUploadStats() { s_uploadedBytes = 0; }
+
 public:
 	size_t id; 							//!< The unique identifier for the batch. (Index within the batch list)
 	GLuint renderMode; 					//!< The rendering mode for the batch (e.g., GL_TRIANGLES).
@@ -96,14 +199,73 @@ public:
 	GLuint vbo;							//!< The vertex buffer object for the batch.
 	GLuint ebo;							//!< The element buffer object for the batch.
 
-	std::vector<size_t> meshIDs;		//!< The meshes to be batched, stored with their IDs.
+	static constexpr size_t REMOVED_MESH = static_cast<size_t>(-1);	//!< Marks a removed mesh in meshIDs until the batch is compacted.
+
+	std::vector<size_t> meshIDs;		//!< The meshes to be batched, stored with their IDs in draw order.
+	size_t removedMeshes;				//!< Number of REMOVED_MESH entries in meshIDs.
+	std::vector<uint64_t> sortKeys;		//!< Sort key of each mesh in meshIDs from the last sort, see BatchSort.
+	uint64_t nextSortSequence;			//!< Insertion order given to the next mesh added to the batch.
 
-	std::vector<Vertex> vertices;		//!< The combined vertices for the batch.
+	std::vector<PackedVertex> vertices;	//!< The combined vertices for the batch, packed for upload.
 	std::vector<unsigned int> indices;	//!< The combined indices for the batch.
+	std::vector<size_t> meshFirstIndex;	//!< Index of each mesh's first index in indices, followed by the index count. Not used when instancing.
+
+	bool useInstancing;					//!< Draws instances over a unit quad instead of vertices. Chosen by GraphicsManager::UpdateBatch.
+	std::vector<SpriteInstance> instances;	//!< One instance per mesh in draw order, used instead of vertices and indices when instancing.
 
 	bool isSorted;						//!< Flag to indicate if the batch data is sorted.
 	bool isUpdated;						//!< Flag to indicate if the batch data has been updated.
 
+	/*!
+	 * \brief Where a mesh's vertices are stored in the batch's vertex array.
+	 */
+	struct MeshSlot {
+		size_t firstVertex;				//!< Index of the mesh's first vertex, or of its instance in an instanced batch.
+		size_t vertexCount;				//!< Number of vertices the mesh had when the batch was rebuilt.
+	};
+
+	std::unordered_map<size_t, MeshSlot> meshSlots;	//!< Slot of each mesh in vertices or instances. Rebuilt by GraphicsManager::UpdateBatch.
+	std::vector<size_t> dirtyMeshes;	//!< Meshes changed since the last patch.
+	std::vector<size_t> movedMeshes;	//!< Meshes of an instanced batch whose transform alone changed since the last patch.
+
 private:
+	/*!
+	 * \brief Creates the unit quad and the instance buffer, the first time the batch is drawn instanced.
+	 */
+	void InitInstancing();
+
+	/*!
+	 * \brief Uploads the whole array or its dirty ranges to a buffer, growing the buffer if needed.
+	 *
+	 * \param buffer The buffer object to upload to.
+	 * \param elements The vertices or instances of the batch.
+	 * \param capacity Number of elements the buffer can hold. Updated when the buffer grows.
+	 */
+	template <typename Element>
+	void UploadElements(GLuint buffer, std::vector<Element> const& elements, size_t& capacity);
+
 	static const size_t BATCH_SIZE = 65536; // !< The size to reserve for the batch data.
+	static const size_t DIRTY_MERGE_GAP = 64; // !< Dirty ranges closer than this many vertices are uploaded together.
+
+	/*!
+	 * \brief Draws some of the meshes of the batch, one draw for instances or a multi-draw for vertices.
+	 */
+	void DrawRanges(std::vector<DrawRange> const& ranges);
+
+	std::vector<GLsizei> drawCounts;	//!< Index count of each run drawn by DrawRanges, reused between draws.
+	std::vector<void const*> drawOffsets;	//!< Byte offset into the EBO of each run drawn by DrawRanges.
+
+	std::vector<std::pair<size_t, size_t>> dirtyRanges;	//!< Vertex ranges [first, last) waiting for upload.
+	bool verticesNeedFullUpload;		//!< The whole vertex buffer needs to be uploaded.
+	bool indicesNeedUpload;				//!< The index buffer needs to be uploaded.
+	size_t vboCapacity;					//!< Number of vertices the VBO can hold.
+	size_t eboCapacity;					//!< Number of indices the EBO can hold.
+
+	GLuint instanceVAO;					//!< The vertex array object for instanced drawing. 0 until the batch is first drawn instanced.
+	GLuint instanceVBO;					//!< The instance buffer object.
+	GLuint quadVBO;						//!< The corners of the unit quad shared by every instance.
+	GLuint quadEBO;						//!< The indices of the unit quad.
+	size_t instanceCapacity;			//!< Number of instances the instance buffer can hold.
+
+	static inline size_t s_uploadedBytes = 0;	//!< Bytes uploaded by all batches since the last reset.
 };
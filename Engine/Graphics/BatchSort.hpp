@@ -0,0 +1,202 @@
+/*********************************************************************
+ * \file		BatchSort.hpp
+ * \brief		Sort keys and the radix sort used to order the meshes
+ *				in a batch by depth
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef BATCH_SORT_HPP
+#define BATCH_SORT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * \namespace BatchSort
+ * \brief Orders the meshes of a batch by a 64-bit key.
+ *
+ * From the most to the least significant bits a key holds the sorting layer,
+ * the depth, the texture array and the order the mesh was added to the batch.
+ * The insertion order makes every key unique, so the result does not depend on
+ * the order the meshes were in before sorting.
+ */
+namespace BatchSort {
+	constexpr int SEQUENCE_BITS = 20;
+	constexpr int TEXTURE_BITS = 6;
+	constexpr int DEPTH_BITS = 32;
+	constexpr int LAYER_BITS = 6;
+	static_assert(SEQUENCE_BITS + TEXTURE_BITS + DEPTH_BITS + LAYER_BITS == 64);
+
+	constexpr uint64_t SEQUENCE_MASK = (uint64_t{ 1 } << SEQUENCE_BITS) - 1;
+	constexpr uint64_t TEXTURE_MASK = (uint64_t{ 1 } << TEXTURE_BITS) - 1;
+	constexpr uint64_t LAYER_MASK = (uint64_t{ 1 } << LAYER_BITS) - 1;
+
+	// Below this fraction of changed keys, the changed keys are merged into the
+	// ones that did not change instead of sorting everything again.
+	constexpr size_t INCREMENTAL_DIVISOR = 8;
+
+	/**
+	 * \struct Entry
+	 * \brief A key and the mesh it belongs to.
+	 */
+	struct Entry {
+		uint64_t key;
+		size_t id;
+	};
+
+	/**
+	 * \struct Scratch
+	 * \brief Buffers reused between sorts so sorting does not allocate every frame.
+	 */
+	struct Scratch {
+		std::vector<uint64_t> keys;
+		std::vector<Entry> entries;
+		std::vector<Entry> moved;
+		std::vector<Entry> buffer;
+	};
+
+	/**
+	 * \brief Maps a float to an unsigned integer with the same ordering.
+	 */
+	inline uint32_t DepthBits(float depth) {
+		uint32_t bits;
+		std::memcpy(&bits, &depth, sizeof(bits));
+		// Negative floats order backwards, so flip all their bits. Positive floats only need the sign bit set.
+		return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+	}
+
+	/**
+	 * \brief Builds the sort key of a mesh.
+	 *
+	 * \param layer The sorting layer (batch) of the mesh.
+	 * \param depth The z value of the mesh.
+	 * \param texArray The texture array of the mesh, or -1 if it has no texture.
+	 * \param sequence The order the mesh was added to its batch.
+	 */
+	inline uint64_t MakeKey(size_t layer, float depth, int texArray, uint64_t sequence) {
+		uint64_t texture = static_cast<uint64_t>(std::clamp(texArray + 1, 0, static_cast<int>(TEXTURE_MASK)));
+		return ((static_cast<uint64_t>(layer) & LAYER_MASK) << (DEPTH_BITS + TEXTURE_BITS + SEQUENCE_BITS))
+			| (static_cast<uint64_t>(DepthBits(depth)) << (TEXTURE_BITS + SEQUENCE_BITS))
+			| (texture << SEQUENCE_BITS)
+			| (sequence & SEQUENCE_MASK);
+	}
+
+	/**
+	 * \brief Returns the insertion order stored in a key.
+	 */
+	inline uint64_t Sequence(uint64_t key) {
+		return key & SEQUENCE_MASK;
+	}
+
+	/**
+	 * \brief Stable LSD radix sort of entries by key, one byte per pass.
+	 *
+	 * Passes over bytes that are the same in every key (e.g. the sorting layer
+	 * within one batch) are skipped.
+	 *
+	 * \param entries The entries to sort.
+	 * \param buffer Scratch space, resized as needed.
+	 */
+	inline void RadixSort(std::vector<Entry>& entries, std::vector<Entry>& buffer) {
+		const size_t count = entries.size();
+		if (count < 2) {
+			return;
+		}
+
+		std::array<std::array<size_t, 256>, 8> histograms{};
+		for (Entry const& entry : entries) {
+			for (size_t pass = 0; pass < 8; ++pass) {
+				++histograms[pass][(entry.key >> (pass * 8)) & 0xFF];
+			}
+		}
+
+		buffer.resize(count);
+		for (size_t pass = 0; pass < 8; ++pass) {
+			auto& histogram = histograms[pass];
+			uint8_t firstByte = static_cast<uint8_t>((entries[0].key >> (pass * 8)) & 0xFF);
+			if (histogram[firstByte] == count) {
+				continue;
+			}
+
+			size_t offset = 0;
+			for (size_t& bucket : histogram) {
+				size_t bucketCount = bucket;
+				bucket = offset;
+				offset += bucketCount;
+			}
+			for (Entry const& entry : entries) {
+				buffer[histogram[(entry.key >> (pass * 8)) & 0xFF]++] = entry;
+			}
+			entries.swap(buffer);
+		}
+	}
+
+	/**
+	 * \brief Reorders ids and their keys by the updated keys.
+	 *
+	 * keys must be the keys from the last sort, in the same order as ids, so
+	 * the keys that did not change are already in order. If only a few keys
+	 * changed, those are sorted on their own and merged back in. Otherwise
+	 * everything is radix sorted.
+	 *
+	 * \param keys The keys from the last sort, replaced by the sorted updated keys.
+	 * \param ids The ids to reorder, in the same order as keys.
+	 * \param updatedKeys The current key of each id, in the same order as ids.
+	 * \param scratch Buffers reused between sorts.
+	 * \return True if the order of ids changed.
+	 */
+	inline bool Sort(std::vector<uint64_t>& keys, std::vector<size_t>& ids, std::vector<uint64_t> const& updatedKeys, Scratch& scratch) {
+		const size_t count = ids.size();
+		keys.resize(count);
+
+		// Most frames nothing moved far enough to change the order
+		if (std::is_sorted(updatedKeys.begin(), updatedKeys.end())) {
+			keys = updatedKeys;
+			return false;
+		}
+
+		scratch.entries.clear();
+		scratch.moved.clear();
+		for (size_t i = 0; i < count; ++i) {
+			if (updatedKeys[i] == keys[i]) {
+				scratch.entries.push_back({ updatedKeys[i], ids[i] });
+			}
+			else {
+				scratch.moved.push_back({ updatedKeys[i], ids[i] });
+			}
+		}
+
+		auto byKey = [](Entry const& lhs, Entry const& rhs) { return lhs.key < rhs.key; };
+		if (scratch.moved.size() * INCREMENTAL_DIVISOR <= count) {
+			std::sort(scratch.moved.begin(), scratch.moved.end(), byKey);
+			scratch.buffer.resize(count);
+			std::merge(scratch.entries.begin(), scratch.entries.end(), scratch.moved.begin(), scratch.moved.end(), scratch.buffer.begin(), byKey);
+			scratch.entries.swap(scratch.buffer);
+		}
+		else {
+			scratch.entries.insert(scratch.entries.end(), scratch.moved.begin(), scratch.moved.end());
+			RadixSort(scratch.entries, scratch.buffer);
+		}
+
+		bool reordered = false;
+		for (size_t i = 0; i < count; ++i) {
+			reordered = reordered || ids[i] != scratch.entries[i].id;
+			keys[i] = scratch.entries[i].key;
+			ids[i] = scratch.entries[i].id;
+		}
+		return reordered;
+	}
+}
+
+#endif // BATCH_SORT_HPP
@@ -137,6 +137,11 @@ bool Font::LoadFromFile(const std::string& path)
     return true;
 }
 
+size_t Font::GetMemorySize() const
+{
+    return static_cast<size_t>(maxGlyphWidth) * maxGlyphHeight * characters.size();
+}
+
 size_t Font::FindEmptyTextureArray()
 {
     texArrayIndex = static_cast<size_t>(-1);
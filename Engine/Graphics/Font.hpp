@@ -32,6 +32,16 @@ public:
 	*/
 	bool LoadFromFile(const std::string& path) override;
 
+	/*
+	* \brief Memory the glyphs hold in the font's texture array, one byte a pixel
+	*/
+	size_t GetMemorySize() const override;
+
+	/*
+	* \brief The font's texture array is not freed when the font is destroyed, so it is never evicted
+	*/
+	bool IsEvictableAlone() const override { return false; }
+
 	/*
 	* \brief Find an empty texture array for the font to use
 	* 
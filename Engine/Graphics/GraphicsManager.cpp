@@ -25,12 +25,41 @@
 #include "../AssetManager.hpp"
 #include "Logger.hpp"
 #include "Math.hpp"
+#include "TextureLoader.hpp"
 #include "../ECS/ECSManager.hpp"
 #include "../Components/Collider2D.hpp"
 #include "../Components/Camera.hpp"
 #include "../Utility/EngineState.hpp"
 #include "../Layers/SortingLayer.hpp"
 #include "../Layers/SortingLayerManager.hpp"
+#include "../Utility/Profiler.hpp"
+
+#include <cstring>
+#include <limits>
+
+namespace {
+    // Binding points, these must match layout(binding = N) of the blocks in the shaders
+    constexpr GLuint CAMERA_BLOCK_BINDING = 0;
+    constexpr GLuint FRAME_BLOCK_BINDING = 1;
+
+    // std140 layout of the Camera block
+    struct CameraBlock {
+        glm::mat4 view;
+        glm::mat4 projection;
+    };
+
+    // std140 layout of the FrameData block
+    struct FrameBlock {
+        float time;
+        float bloomIntensity;
+        float vignetteStrength;
+        float vignetteSoftness;
+        glm::vec2 vignetteCenter;
+        float glitchIntensity;
+        float padding;
+    };
+    static_assert(sizeof(FrameBlock) == 32, "FrameBlock must match the std140 layout of FrameData");
+}
 
 extern EngineState engineState;
 
@@ -41,8 +70,8 @@ GraphicsManager& GraphicsManager::GetInstance()
 }
 
 GraphicsManager::GraphicsManager() : 
-    shaders(), batches(), meshes(), frameBuffers(), debugMode(false), camera(), 
-	readFramebuffer(0), drawFramebuffer(0), internalFormat(GL_RGBA8)
+    shaders(), batches(), meshes(), frameBuffers(), debugMode(false), pixelPicking(false), spriteInstancing(false), viewCulling(true), cullMargin(0.1f), drawRanges(), hasDrawRanges(), camera(), 
+	readFramebuffer(0), drawFramebuffer(0), uniformBuffer(0), cameraSlotStride(0), uniformStaging(), internalFormat(GL_RGBA8)
 {
     //textures.reserve(2048);
 
@@ -87,6 +116,10 @@ GraphicsManager::GraphicsManager() :
     LoadShader("Shaders/YCrCbRGB");
 	// Object picking in UI (ID 13)
     LoadShader("Shaders/objectpicking_ui");
+	// Instanced sprites (ID 14)
+    LoadShader("Shaders/sprite_instanced");
+	// Object picking of instanced sprites (ID 15)
+    LoadShader("Shaders/objectpicking_instanced");
 
 	for (size_t i = 0; i < FrameBufferIndex::MAX_FRAMEBUFFERS; ++i) {
         frameBuffers.emplace_back();
@@ -127,6 +160,8 @@ GraphicsManager::~GraphicsManager()
     // Delete the framebuffers used by CopyTextureLayer()
     if (readFramebuffer != 0) glDeleteFramebuffers(1, &readFramebuffer);
     if (drawFramebuffer != 0) glDeleteFramebuffers(1, &drawFramebuffer);
+
+    if (uniformBuffer != 0) glDeleteBuffers(1, &uniformBuffer);
 }
 
 void GraphicsManager::Init() 
@@ -168,43 +203,96 @@ void GraphicsManager::Init()
     // Initialization of framebuffers used by CopyTextureLayer()
     if (readFramebuffer == 0) glGenFramebuffers(1, &readFramebuffer);
     if (drawFramebuffer == 0) glGenFramebuffers(1, &drawFramebuffer);
+
+    // Uniform buffer shared by every shader program, see UpdateFrameUniforms()
+    if (uniformBuffer == 0) {
+        GLint alignment = 256;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        cameraSlotStride = (sizeof(CameraBlock) + alignment - 1) / alignment * alignment;
+        uniformStaging.assign(cameraSlotStride * CameraSlot::MAX_CAMERA_SLOTS + sizeof(FrameBlock), 0);
+
+        glGenBuffers(1, &uniformBuffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, uniformBuffer);
+        glBufferData(GL_UNIFORM_BUFFER, uniformStaging.size(), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+}
+
+void GraphicsManager::UpdateFrameUniforms(Camera const& camComponent)
+{
+    CameraBlock cameras[CameraSlot::MAX_CAMERA_SLOTS];
+    cameras[CameraSlot::CAMERA_GAME] = { GetViewMatrixGame(), GetProjectionMatrixGame() };
+    cameras[CameraSlot::CAMERA_ENGINE] = { GetViewMatrixEngine(), GetProjectionMatrixEngine() };
+    for (size_t slot = 0; slot < CameraSlot::MAX_CAMERA_SLOTS; ++slot) {
+        std::memcpy(uniformStaging.data() + slot * cameraSlotStride, &cameras[slot], sizeof(CameraBlock));
+    }
+
+    FrameBlock frame{};
+    frame.time = static_cast<float>(glfwGetTime());
+    frame.bloomIntensity = camComponent.bloomIntensity;
+    frame.vignetteStrength = camComponent.vignetteStrength;
+    frame.vignetteSoftness = camComponent.vignetteSoftness;
+    frame.vignetteCenter = glm::vec2(camComponent.vignetteCenter.x, camComponent.vignetteCenter.y);
+    frame.glitchIntensity = 0.2f;
+    std::memcpy(uniformStaging.data() + cameraSlotStride * CameraSlot::MAX_CAMERA_SLOTS, &frame, sizeof(FrameBlock));
+
+    glBindBuffer(GL_UNIFORM_BUFFER, uniformBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, uniformStaging.size(), uniformStaging.data());
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glBindBufferRange(GL_UNIFORM_BUFFER, FRAME_BLOCK_BINDING, uniformBuffer,
+        cameraSlotStride * CameraSlot::MAX_CAMERA_SLOTS, sizeof(FrameBlock));
+}
+
+void GraphicsManager::BindCamera(CameraSlot slot)
+{
+    glBindBufferRange(GL_UNIFORM_BUFFER, CAMERA_BLOCK_BINDING, uniformBuffer, slot * cameraSlotStride, sizeof(CameraBlock));
 }
 
 void GraphicsManager::Render()
 {
+    PROFILE_SCOPE("GraphicsManager::Render");
     glClearColor(1.f, 1.f, 1.f, 1.f);
     // Clear the color buffer (and depth buffer if needed)
 
     auto [width, height] = Application::GetWindowSize();
     glViewport(0, 0, width, height);
 
-    // Bind the framebuffer
-    glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::GAME].fbo);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    // Batches are rendered to the binded framebuffer
-    // Render from first sorting layer batch to last.
-    for (size_t k = BatchIndex::FIRST_SRTG_LAYER; k < BatchIndex::LAST_SRTG_LAYER + 1; ++k) {
-        if (batches[k].IsEmpty()) continue;
-        batches[k].RenderToBuffer(shaders[ShaderIndex::SHDR_DEFAULT],
-            frameBuffers[FrameBufferIndex::GAME], 
-            GetViewMatrixGame(), GetProjectionMatrixGame());
+    Camera camComponent{};
+    if (ECSManager::GetInstance().TryGetComponent<Camera>(activeCamera) != std::nullopt)
+        camComponent = ECSManager::GetInstance().GetComponent<Camera>(activeCamera);
+    UpdateFrameUniforms(camComponent);
+
+    {
+        PROFILE_SCOPE("Game Pass");
+        // Bind the framebuffer
+        glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::GAME].fbo);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        BindCamera(CameraSlot::CAMERA_GAME);
+        // Batches are rendered to the binded framebuffer
+        // Render from first sorting layer batch to last.
+        for (size_t k = BatchIndex::FIRST_SRTG_LAYER; k < BatchIndex::LAST_SRTG_LAYER + 1; ++k) {
+            if (batches[k].IsEmpty()) continue;
+            batches[k].RenderToBuffer(GetBatchShader(batches[k], ShaderIndex::SHDR_DEFAULT),
+                frameBuffers[FrameBufferIndex::GAME], GetDrawRanges(CameraSlot::CAMERA_GAME, k));
+        }
     }
 
 	// Note: this entire scope should NOT be called when application is lauched in installer mode
 	// This is to avoid the engine view from being rendered unnecessarily
 #ifndef INSTALLER
     {
+        PROFILE_SCOPE("Engine View Pass");
         glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::ENGINE].fbo);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        BindCamera(CameraSlot::CAMERA_ENGINE);
         for (size_t k = BatchIndex::FIRST_SRTG_LAYER; k < BatchIndex::LAST_SRTG_LAYER + 1; ++k) {
-            batches[k].RenderToBuffer(shaders[ShaderIndex::SHDR_DEFAULT],
-                frameBuffers[FrameBufferIndex::ENGINE],
-                GetViewMatrixEngine(), GetProjectionMatrixEngine());
+            batches[k].RenderToBuffer(GetBatchShader(batches[k], ShaderIndex::SHDR_DEFAULT),
+                frameBuffers[FrameBufferIndex::ENGINE], GetDrawRanges(CameraSlot::CAMERA_ENGINE, k));
         }
         if (debugMode) {
             batches[BatchIndex::DEBUG_BATCH].RenderToBuffer(shaders[ShaderIndex::SHDR_DEFAULT],
-                frameBuffers[FrameBufferIndex::ENGINE],
-                GetViewMatrixEngine(), GetProjectionMatrixEngine());
+                frameBuffers[FrameBufferIndex::ENGINE]);
         }
         // Render UI to engine view framebuffer
         glDisable(GL_DEPTH_TEST);
@@ -215,23 +303,24 @@ void GraphicsManager::Render()
     }
 #endif
     
-    // Render UI
-    // Note: I did not add view / projection matrices for UI rendering as it is not needed
-    // UI will render based on screen coordinates and should not be affected by camera position
-    glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::UI].fbo);
-    glClearColor(0.f, 0.f, 0.f, 0.f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    glDisable(GL_DEPTH_TEST);
-    batches[BatchIndex::UI_VIDEO_TEXTURE_BATCH].RenderToBuffer(shaders[ShaderIndex::SHDR_VIDEOPLAYER], frameBuffers[FrameBufferIndex::UI]);
-    batches[BatchIndex::UI_TEXTURE_BATCH].RenderToBuffer(shaders[ShaderIndex::SHDR_TEXTURE_UI], frameBuffers[FrameBufferIndex::UI]);
-    batches[BatchIndex::UI_TEXT_BATCH].RenderToBuffer(shaders[ShaderIndex::SHDR_FONT], frameBuffers[FrameBufferIndex::UI]);
-    glClearColor(1.f, 1.f, 1.f, 1.f);
+    {
+        PROFILE_SCOPE("UI Pass");
+        // Render UI
+        // Note: I did not add view / projection matrices for UI rendering as it is not needed
+        // UI will render based on screen coordinates and should not be affected by camera position
+        glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::UI].fbo);
+        glClearColor(0.f, 0.f, 0.f, 0.f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glDisable(GL_DEPTH_TEST);
+        batches[BatchIndex::UI_VIDEO_TEXTURE_BATCH].RenderToBuffer(shaders[ShaderIndex::SHDR_VIDEOPLAYER], frameBuffers[FrameBufferIndex::UI]);
+        batches[BatchIndex::UI_TEXTURE_BATCH].RenderToBuffer(shaders[ShaderIndex::SHDR_TEXTURE_UI], frameBuffers[FrameBufferIndex::UI]);
+        batches[BatchIndex::UI_TEXT_BATCH].RenderToBuffer(shaders[ShaderIndex::SHDR_FONT], frameBuffers[FrameBufferIndex::UI]);
+        glClearColor(1.f, 1.f, 1.f, 1.f);
+    }
 
-    Camera camComponent{};
-    if (ECSManager::GetInstance().TryGetComponent<Camera>(activeCamera) != std::nullopt)
-        camComponent = ECSManager::GetInstance().GetComponent<Camera>(activeCamera);
     // Bind bright pass framebuffer
     {
+        PROFILE_SCOPE("Bright Pass");
         glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::BRIGHT].fbo);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -242,9 +331,8 @@ void GraphicsManager::Render()
         textureArray[arrayIndex].Bind(static_cast<int>(arrayIndex));
 
 
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_BRIGHT].id_gl, "screenTexture"), static_cast<GLint>(arrayIndex));
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_BRIGHT].id_gl, "layerIndex"), static_cast<GLint>(layerIndex));
-        glUniform1f(glGetUniformLocation(shaders[ShaderIndex::SHDR_BRIGHT].id_gl, "vignetteStrength"), 1.0f);
+        glUniform1i(shaders[ShaderIndex::SHDR_BRIGHT].Uniform("screenTexture"), static_cast<GLint>(arrayIndex));
+        glUniform1i(shaders[ShaderIndex::SHDR_BRIGHT].Uniform("layerIndex"), static_cast<GLint>(layerIndex));
 
         glBindVertexArray(frameBuffers[FrameBufferIndex::BRIGHT].quadVAO);
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
@@ -254,6 +342,7 @@ void GraphicsManager::Render()
 
     // Hori blur pass
     {
+        PROFILE_SCOPE("Horizontal Blur Pass");
         glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::HORIBLUR].fbo);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -264,8 +353,8 @@ void GraphicsManager::Render()
         textureArray[arrayIndex].Bind(static_cast<int>(arrayIndex));
 
 
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_HORIBLUR].id_gl, "screenTexture"), static_cast<GLint>(arrayIndex));
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_HORIBLUR].id_gl, "layerIndex"), static_cast<GLint>(layerIndex));
+        glUniform1i(shaders[ShaderIndex::SHDR_HORIBLUR].Uniform("screenTexture"), static_cast<GLint>(arrayIndex));
+        glUniform1i(shaders[ShaderIndex::SHDR_HORIBLUR].Uniform("layerIndex"), static_cast<GLint>(layerIndex));
 
         glBindVertexArray(frameBuffers[FrameBufferIndex::HORIBLUR].quadVAO);
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
@@ -275,6 +364,7 @@ void GraphicsManager::Render()
 
     // Verti blur pass
     {
+        PROFILE_SCOPE("Vertical Blur Pass");
         glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::VERTBLUR].fbo);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -285,8 +375,8 @@ void GraphicsManager::Render()
         textureArray[arrayIndex].Bind(static_cast<int>(arrayIndex));
 
 
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_VERTBLUR].id_gl, "screenTexture"), static_cast<GLint>(arrayIndex));
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_VERTBLUR].id_gl, "layerIndex"), static_cast<GLint>(layerIndex));
+        glUniform1i(shaders[ShaderIndex::SHDR_VERTBLUR].Uniform("screenTexture"), static_cast<GLint>(arrayIndex));
+        glUniform1i(shaders[ShaderIndex::SHDR_VERTBLUR].Uniform("layerIndex"), static_cast<GLint>(layerIndex));
 
         glBindVertexArray(frameBuffers[FrameBufferIndex::VERTBLUR].quadVAO);
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
@@ -296,6 +386,7 @@ void GraphicsManager::Render()
 
     // combine
     {
+        PROFILE_SCOPE("Combine Pass");
         glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::COMBINE].fbo);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -308,12 +399,11 @@ void GraphicsManager::Render()
         size_t BlayerIndex = frameBuffers[FrameBufferIndex::VERTBLUR].frameTexture->texLayerIndex;
         textureArray[BarrayIndex].Bind(static_cast<int>(BarrayIndex));
 
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_COMBINE].id_gl, "screenTexture"), static_cast<GLint>(OGarrayIndex));
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_COMBINE].id_gl, "screenLayerIndex"), static_cast<GLint>(OGlayerIndex));
+        glUniform1i(shaders[ShaderIndex::SHDR_COMBINE].Uniform("screenTexture"), static_cast<GLint>(OGarrayIndex));
+        glUniform1i(shaders[ShaderIndex::SHDR_COMBINE].Uniform("screenLayerIndex"), static_cast<GLint>(OGlayerIndex));
 
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_COMBINE].id_gl, "blurTexture"), static_cast<GLint>(BarrayIndex));
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_COMBINE].id_gl, "blurLayerIndex"), static_cast<GLint>(BlayerIndex));
-        glUniform1f(glGetUniformLocation(shaders[ShaderIndex::SHDR_COMBINE].id_gl, "bloomIntensity"), static_cast<GLfloat>(camComponent.bloomIntensity));
+        glUniform1i(shaders[ShaderIndex::SHDR_COMBINE].Uniform("blurTexture"), static_cast<GLint>(BarrayIndex));
+        glUniform1i(shaders[ShaderIndex::SHDR_COMBINE].Uniform("blurLayerIndex"), static_cast<GLint>(BlayerIndex));
 
         glBindVertexArray(frameBuffers[FrameBufferIndex::COMBINE].quadVAO);
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
@@ -323,6 +413,7 @@ void GraphicsManager::Render()
 
     // vignette
     {
+        PROFILE_SCOPE("Vignette Pass");
         glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::VIGNETTE].fbo);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -332,13 +423,8 @@ void GraphicsManager::Render()
         size_t layerIndex = frameBuffers[FrameBufferIndex::COMBINE].frameTexture->texLayerIndex;
         textureArray[arrayIndex].Bind(static_cast<int>(arrayIndex));
 
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_VIGNETTE].id_gl, "screenTexture"), static_cast<GLint>(arrayIndex));
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_VIGNETTE].id_gl, "layerIndex"), static_cast<GLint>(layerIndex));
-
-        glUniform1f(glGetUniformLocation(shaders[ShaderIndex::SHDR_VIGNETTE].id_gl, "vignetteStrength"), static_cast<GLfloat>(camComponent.vignetteStrength));
-        glUniform1f(glGetUniformLocation(shaders[ShaderIndex::SHDR_VIGNETTE].id_gl, "vignetteSoftness"), static_cast<GLfloat>(camComponent.vignetteSoftness));
-        glUniform2f(glGetUniformLocation(shaders[ShaderIndex::SHDR_VIGNETTE].id_gl, "vignetteCenter"),
-            static_cast<GLfloat>(camComponent.vignetteCenter.x), static_cast<GLfloat>(camComponent.vignetteCenter.y));
+        glUniform1i(shaders[ShaderIndex::SHDR_VIGNETTE].Uniform("screenTexture"), static_cast<GLint>(arrayIndex));
+        glUniform1i(shaders[ShaderIndex::SHDR_VIGNETTE].Uniform("layerIndex"), static_cast<GLint>(layerIndex));
 
         glBindVertexArray(frameBuffers[FrameBufferIndex::VIGNETTE].quadVAO);
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
@@ -348,6 +434,7 @@ void GraphicsManager::Render()
 
     // glitch
     {
+        PROFILE_SCOPE("Glitch Pass");
         glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::GLITCH].fbo);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -357,10 +444,8 @@ void GraphicsManager::Render()
         size_t layerIndex = frameBuffers[FrameBufferIndex::VIGNETTE].frameTexture->texLayerIndex;
         textureArray[arrayIndex].Bind(static_cast<int>(arrayIndex));
 
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_GLITCH].id_gl, "screenTexture"), static_cast<GLint>(arrayIndex));
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_GLITCH].id_gl, "layerIndex"), static_cast<GLint>(layerIndex));
-        glUniform1f(glGetUniformLocation(shaders[ShaderIndex::SHDR_GLITCH].id_gl, "glitchIntensity"), 0.2f);
-        glUniform1f(glGetUniformLocation(shaders[ShaderIndex::SHDR_GLITCH].id_gl, "time"), static_cast<GLfloat>(glfwGetTime()));
+        glUniform1i(shaders[ShaderIndex::SHDR_GLITCH].Uniform("screenTexture"), static_cast<GLint>(arrayIndex));
+        glUniform1i(shaders[ShaderIndex::SHDR_GLITCH].Uniform("layerIndex"), static_cast<GLint>(layerIndex));
 
         glBindVertexArray(frameBuffers[FrameBufferIndex::GLITCH].quadVAO);
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
@@ -370,6 +455,7 @@ void GraphicsManager::Render()
 
     // Game + UI
     {
+        PROFILE_SCOPE("Final Pass");
         glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::GAME_FINAL].fbo);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -382,11 +468,11 @@ void GraphicsManager::Render()
         size_t uLayerIndex = frameBuffers[FrameBufferIndex::UI].frameTexture->texLayerIndex;
         textureArray[uArrayIndex].Bind(static_cast<int>(uArrayIndex));
 
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_FINAL].id_gl, "gameTexture"), static_cast<GLint>(gArrayIndex));
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_FINAL].id_gl, "gameLayerIndex"), static_cast<GLint>(gLayerIndex));
+        glUniform1i(shaders[ShaderIndex::SHDR_FINAL].Uniform("gameTexture"), static_cast<GLint>(gArrayIndex));
+        glUniform1i(shaders[ShaderIndex::SHDR_FINAL].Uniform("gameLayerIndex"), static_cast<GLint>(gLayerIndex));
 
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_FINAL].id_gl, "uiTexture"), static_cast<GLint>(uArrayIndex));
-        glUniform1i(glGetUniformLocation(shaders[ShaderIndex::SHDR_FINAL].id_gl, "uiLayerIndex"), static_cast<GLint>(uLayerIndex));
+        glUniform1i(shaders[ShaderIndex::SHDR_FINAL].Uniform("uiTexture"), static_cast<GLint>(uArrayIndex));
+        glUniform1i(shaders[ShaderIndex::SHDR_FINAL].Uniform("uiLayerIndex"), static_cast<GLint>(uLayerIndex));
 
         glBindVertexArray(frameBuffers[FrameBufferIndex::GAME_FINAL].quadVAO);
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
@@ -394,43 +480,52 @@ void GraphicsManager::Render()
     }
     // Game + UI
     
+    // Picking is answered by the RenderSystem's picking index, so these passes only run for pixel exact picking
+    if (pixelPicking) {
+        PROFILE_SCOPE("Object Picking Pass");
 #ifndef INSTALLER
-    // Render to the object picking framebuffer (engine)
-    glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::OBJ_PICKING_ENGINE].fbo);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    // Render from first sorting layer batch to last.
-    for (size_t k = BatchIndex::FIRST_SRTG_LAYER; k < BatchIndex::LAST_SRTG_LAYER + 1; ++k) {
-        batches[k].RenderToBuffer(shaders[ShaderIndex::SHDR_OBJ_PICKING_WORLD],
-            frameBuffers[FrameBufferIndex::OBJ_PICKING_ENGINE],
-            GetViewMatrixEngine(), GetProjectionMatrixEngine());
-    }
+        // Render to the object picking framebuffer (engine)
+        glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::OBJ_PICKING_ENGINE].fbo);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        BindCamera(CameraSlot::CAMERA_ENGINE);
+        // Render from first sorting layer batch to last.
+        for (size_t k = BatchIndex::FIRST_SRTG_LAYER; k < BatchIndex::LAST_SRTG_LAYER + 1; ++k) {
+            batches[k].RenderToBuffer(GetBatchShader(batches[k], ShaderIndex::SHDR_OBJ_PICKING_WORLD),
+                frameBuffers[FrameBufferIndex::OBJ_PICKING_ENGINE], GetDrawRanges(CameraSlot::CAMERA_ENGINE, k));
+        }
 
-    glDisable(GL_DEPTH_TEST);
-    batches[BatchIndex::UI_TEXTURE_BATCH].RenderToBuffer(shaders[ShaderIndex::SHDR_OBJ_PICKING_UI],
-        frameBuffers[FrameBufferIndex::OBJ_PICKING_ENGINE]);
+        glDisable(GL_DEPTH_TEST);
+        batches[BatchIndex::UI_TEXTURE_BATCH].RenderToBuffer(shaders[ShaderIndex::SHDR_OBJ_PICKING_UI],
+            frameBuffers[FrameBufferIndex::OBJ_PICKING_ENGINE]);
 
 #endif
 
-    // Render to the object picking framebuffer (game)
-    glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::OBJ_PICKING_GAME].fbo);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    // Render from first sorting layer batch to last.
-    for (size_t k = BatchIndex::FIRST_SRTG_LAYER; k < BatchIndex::LAST_SRTG_LAYER + 1; ++k) {
-        batches[k].RenderToBuffer(shaders[ShaderIndex::SHDR_OBJ_PICKING_WORLD],
-            frameBuffers[FrameBufferIndex::OBJ_PICKING_GAME],
-            GetViewMatrixGame(), GetProjectionMatrixGame());
-    }
+        // Render to the object picking framebuffer (game)
+        glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::OBJ_PICKING_GAME].fbo);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        BindCamera(CameraSlot::CAMERA_GAME);
+        // Render from first sorting layer batch to last.
+        for (size_t k = BatchIndex::FIRST_SRTG_LAYER; k < BatchIndex::LAST_SRTG_LAYER + 1; ++k) {
+            batches[k].RenderToBuffer(GetBatchShader(batches[k], ShaderIndex::SHDR_OBJ_PICKING_WORLD),
+                frameBuffers[FrameBufferIndex::OBJ_PICKING_GAME], GetDrawRanges(CameraSlot::CAMERA_GAME, k));
+        }
+
+        // Render the UI to the object picking framebuffers
+        glDisable(GL_DEPTH_TEST);
+        batches[BatchIndex::UI_TEXTURE_BATCH].RenderToBuffer(shaders[ShaderIndex::SHDR_OBJ_PICKING_UI],
+            frameBuffers[FrameBufferIndex::OBJ_PICKING_GAME]);
 
-	// Render the UI to the object picking framebuffers
-    glDisable(GL_DEPTH_TEST);
-    batches[BatchIndex::UI_TEXTURE_BATCH].RenderToBuffer(shaders[ShaderIndex::SHDR_OBJ_PICKING_UI],
-        frameBuffers[FrameBufferIndex::OBJ_PICKING_GAME]);
+        glDisable(GL_DEPTH_TEST);
+        glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::OBJ_PICKING_UI].fbo);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        batches[BatchIndex::UI_TEXTURE_BATCH].RenderToBuffer(shaders[ShaderIndex::SHDR_OBJ_PICKING_UI],
+            frameBuffers[FrameBufferIndex::OBJ_PICKING_UI]);
+    }
 
-    glDisable(GL_DEPTH_TEST);
-    glBindFramebuffer(GL_FRAMEBUFFER, frameBuffers[FrameBufferIndex::OBJ_PICKING_UI].fbo);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    batches[BatchIndex::UI_TEXTURE_BATCH].RenderToBuffer(shaders[ShaderIndex::SHDR_OBJ_PICKING_UI],
-        frameBuffers[FrameBufferIndex::OBJ_PICKING_UI]);
+    // The draw ranges only hold for the batches as they were this frame
+    for (bool& culled : hasDrawRanges) {
+        culled = false;
+    }
 
     // Unbind the framebuffer
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -460,6 +555,9 @@ void GraphicsManager::Exit()
  //   FreeTextureArrays();
 
     batches.clear();
+
+    // The batches are recreated empty on the next Init, so no mesh is drawn anymore
+    meshes.Clear();
 }
 
 void GraphicsManager::LoadBatch(GLuint renderMode, GLuint polygonMode)
@@ -485,12 +583,12 @@ size_t GraphicsManager::LoadMesh(std::vector<Vertex> const& vertices, std::vecto
     for (const auto& vertex : vertices) modelSpacePostions.push_back(vertex.position);
 
     // Create a new mesh with the vertices and indices
-    meshes.emplace_back(vertices, indices, modelSpacePostions, batchID);
+    size_t meshID = meshes.Create(vertices, indices, modelSpacePostions, batchID);
 
     // Add the mesh ID to the batch
-    AddToBatch(batchID, meshes.back().id);
+    AddToBatch(batchID, meshID);
     
-    return meshes.back().id;
+    return meshID;
 }
 
 size_t GraphicsManager::LoadMeshCollision(size_t meshID)
@@ -499,12 +597,13 @@ size_t GraphicsManager::LoadMeshCollision(size_t meshID)
     BatchIndex batchID = DEBUG_BATCH;
 
     // Ensure there is mesh data to create a collision box
-    if (meshID >= meshes.size() || meshes[meshID].vertices.empty()) {
+    if (!meshes.IsAlive(meshID) || meshes[meshID].vertices.empty()) {
         std::cout << "ERROR: Invalid mesh for creating collision box" << std::endl;
         return static_cast<size_t>(-1);
     }
 
     // 2D Collision box mesh (ignore z-axis)
+    meshes[meshID].UpdatePositions();
     Vec2 min = Vec2(meshes[meshID].vertices[0].position.x, meshes[meshID].vertices[0].position.y);
     Vec2 max = Vec2(meshes[meshID].vertices[0].position.x, meshes[meshID].vertices[0].position.y);
 
@@ -535,12 +634,12 @@ size_t GraphicsManager::LoadMeshCollision(size_t meshID)
     };
 
     // Create a new mesh with the vertices and indices
-    meshes.emplace_back(vertices, indices, modelSpacePostions, batchID);
+    size_t collisionID = meshes.Create(vertices, indices, modelSpacePostions, batchID);
 
     // Add the mesh ID to the batch
-    AddToBatch(batchID, meshes.back().id);
+    AddToBatch(batchID, collisionID);
 
-    return meshes.back().id;
+    return collisionID;
 }
 
 void GraphicsManager::RefreshMeshCollision(size_t meshID, size_t meshDebugID, Entity entity)
@@ -580,6 +679,7 @@ size_t GraphicsManager::LoadQuadMesh(size_t batchID, std::vector<Vertex> const&
         0, 1, 2, 2, 3, 0
     };
     std::vector<Vec3> modelSpacePostions;
+    size_t meshID;
     if (vertices.size() != 4) {
         std::vector<Vertex> vertices_t = {
             Vertex({-0.25f,  0.25f, 0.0f}, {1.0f, 0.0f, 0.0f, 1.0f}, {}, {0.0f, 1.0f}), // Top left
@@ -590,16 +690,16 @@ size_t GraphicsManager::LoadQuadMesh(size_t batchID, std::vector<Vertex> const&
         // Save the model space positions
         for (const auto& vertex : vertices_t) modelSpacePostions.push_back(vertex.position);
 
-        meshes.emplace_back(vertices_t, indices, modelSpacePostions, batchID);
-        AddToBatch(static_cast<BatchIndex>(batchID), meshes.back().id);
+        meshID = meshes.Create(vertices_t, indices, modelSpacePostions, batchID);
+        AddToBatch(static_cast<BatchIndex>(batchID), meshID);
     }
     else {
         for (const auto& vertex : vertices) modelSpacePostions.push_back(vertex.position);
 
-        meshes.emplace_back(vertices, indices, modelSpacePostions, batchID);
-        AddToBatch(static_cast<BatchIndex>(batchID), meshes.back().id);
+        meshID = meshes.Create(vertices, indices, modelSpacePostions, batchID);
+        AddToBatch(static_cast<BatchIndex>(batchID), meshID);
     }
-    return meshes.back().id;
+    return meshID;
 }
 
 size_t GraphicsManager::LoadTriangleMesh(size_t batchID, std::vector<Vertex> const& vertices)
@@ -613,6 +713,7 @@ size_t GraphicsManager::LoadTriangleMesh(size_t batchID, std::vector<Vertex> con
         0, 1, 2
     };
     std::vector<Vec3> modelSpacePostions;
+    size_t meshID;
     if (vertices.size() != 3) {
         std::vector<Vertex> vertices_t = {
             Vertex({ 0.25f,  0.25f, 0.5f}, {1.0f, 0.0f, 0.0f, 1.0f}),
@@ -622,17 +723,17 @@ size_t GraphicsManager::LoadTriangleMesh(size_t batchID, std::vector<Vertex> con
         // Save the model space positions
         for (const auto& vertex : vertices_t) modelSpacePostions.push_back(vertex.position);
 
-        meshes.emplace_back(vertices_t, indices, modelSpacePostions, batchID);
-        AddToBatch(static_cast<BatchIndex>(batchID), meshes.back().id);
+        meshID = meshes.Create(vertices_t, indices, modelSpacePostions, batchID);
+        AddToBatch(static_cast<BatchIndex>(batchID), meshID);
     }
     else {
         for (const auto& vertex : vertices) modelSpacePostions.push_back(vertex.position);
 
-        meshes.emplace_back(vertices, indices, modelSpacePostions, batchID);
-        AddToBatch(static_cast<BatchIndex>(batchID), meshes.back().id);
+        meshID = meshes.Create(vertices, indices, modelSpacePostions, batchID);
+        AddToBatch(static_cast<BatchIndex>(batchID), meshID);
     }
 
-    return meshes.back().id;
+    return meshID;
 }
 
 size_t GraphicsManager::LoadLineMesh(size_t batchID, std::vector<Vertex> const& vertices)
@@ -646,6 +747,7 @@ size_t GraphicsManager::LoadLineMesh(size_t batchID, std::vector<Vertex> const&
         0, 1
     };
     std::vector<Vec3> modelSpacePostions;
+    size_t meshID;
     if (vertices.size() != 2) {
         std::vector<Vertex> vertices_t = {
             Vertex({ 0.5f, 0.0f, 0.5f}, {1.0f, 0.0f, 0.0f, 1.0f}, {}, {}),
@@ -654,17 +756,17 @@ size_t GraphicsManager::LoadLineMesh(size_t batchID, std::vector<Vertex> const&
         // Save the model space positions
         for (const auto& vertex : vertices_t) modelSpacePostions.push_back(vertex.position);
 
-        meshes.emplace_back(vertices_t, indices, modelSpacePostions, batchID);
-        AddToBatch(static_cast<BatchIndex>(batchID), meshes.back().id);
+        meshID = meshes.Create(vertices_t, indices, modelSpacePostions, batchID);
+        AddToBatch(static_cast<BatchIndex>(batchID), meshID);
     }
     else {
         for (const auto& vertex : vertices) modelSpacePostions.push_back(vertex.position);
 
-        meshes.emplace_back(vertices, indices, modelSpacePostions, batchID);
-        AddToBatch(static_cast<BatchIndex>(batchID), meshes.back().id);
+        meshID = meshes.Create(vertices, indices, modelSpacePostions, batchID);
+        AddToBatch(static_cast<BatchIndex>(batchID), meshID);
     }
 
-    return meshes.back().id;
+    return meshID;
 }
 
 size_t GraphicsManager::LoadSphereMesh(size_t batchID, std::vector<Vertex> const& vertices)
@@ -679,6 +781,7 @@ size_t GraphicsManager::LoadSphereMesh(size_t batchID, std::vector<Vertex> const
 
     std::vector<unsigned int> indices;
     std::vector<Vec3> modelSpacePostions;
+    size_t meshID;
     for (int i = 1; i <= segments; ++i) {
         indices.push_back(0);
         indices.push_back(i);
@@ -698,17 +801,17 @@ size_t GraphicsManager::LoadSphereMesh(size_t batchID, std::vector<Vertex> const
         // Save the model space positions
         for (const auto& vertex : vertices_t) modelSpacePostions.push_back(vertex.position);
 
-        meshes.emplace_back(vertices_t, indices, modelSpacePostions, batchID);
-        AddToBatch(static_cast<BatchIndex>(batchID), meshes.back().id);
+        meshID = meshes.Create(vertices_t, indices, modelSpacePostions, batchID);
+        AddToBatch(static_cast<BatchIndex>(batchID), meshID);
     }
     else {
         for (const auto& vertex : vertices) modelSpacePostions.push_back(vertex.position);
 
-        meshes.emplace_back(vertices, indices, modelSpacePostions, batchID);
-        AddToBatch(static_cast<BatchIndex>(batchID), meshes.back().id);
+        meshID = meshes.Create(vertices, indices, modelSpacePostions, batchID);
+        AddToBatch(static_cast<BatchIndex>(batchID), meshID);
     }
 
-    return meshes.back().id;
+    return meshID;
 }
 
 size_t GraphicsManager::LoadTextCharacterMesh(size_t batchID, std::vector<Vertex> const& vertices)
@@ -722,6 +825,7 @@ size_t GraphicsManager::LoadTextCharacterMesh(size_t batchID, std::vector<Vertex
 		0, 1, 2, 2, 3, 0
 	};
     std::vector<Vec3> modelSpacePostions;
+    size_t meshID;
     if (vertices.size() != 4) {
         std::vector<Vertex> vertices_t = {
             Vertex({-0.1f,  0.1f, 0.8f}, {1.0f, 0.0f, 0.0f, 1.0f}, {}, {0.0f, 1.0f}),
@@ -733,17 +837,17 @@ size_t GraphicsManager::LoadTextCharacterMesh(size_t batchID, std::vector<Vertex
         // Save the model space positions
         for (const auto& vertex : vertices_t) modelSpacePostions.push_back(vertex.position);
 
-        meshes.emplace_back(vertices_t, indices, modelSpacePostions, batchID);
-        AddToBatch(static_cast<BatchIndex>(batchID), meshes.back().id);
+        meshID = meshes.Create(vertices_t, indices, modelSpacePostions, batchID);
+        AddToBatch(static_cast<BatchIndex>(batchID), meshID);
 	}
     else {
         for (const auto& vertex : vertices) modelSpacePostions.push_back(vertex.position);
 
-        meshes.emplace_back(vertices, indices, modelSpacePostions, batchID);
-        AddToBatch(static_cast<BatchIndex>(batchID), meshes.back().id);
+        meshID = meshes.Create(vertices, indices, modelSpacePostions, batchID);
+        AddToBatch(static_cast<BatchIndex>(batchID), meshID);
 	}
 
-	return meshes.back().id;
+	return meshID;
 }
 
 size_t GraphicsManager::LoadShader(std::string const& path)
@@ -771,12 +875,12 @@ void GraphicsManager::RenderToScreen(size_t shaderIndex, size_t frameBuffIndex)
     //glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(frameBuffers[frameBuffIndex].frameTexture->id));
     //glBindTexture(GL_TEXTURE_2D, frameBuffers[frameBuffIndex].frameTexture->id_gl);
 
-    GLint loc = glGetUniformLocation(shaders[shaderIndex].id_gl, "screenTexture");
+    GLint loc = shaders[shaderIndex].Uniform("screenTexture");
     if (loc != -1) {
         glUniform1i(loc, static_cast<GLint>(arrayIndex));  // Send to the shader
 	}
 
-    GLint loc2 = glGetUniformLocation(shaders[shaderIndex].id_gl, "layerIndex");
+    GLint loc2 = shaders[shaderIndex].Uniform("layerIndex");
     if (loc2 != -1) {
 		glUniform1i(loc2, static_cast<GLint>(layerIndex));  // Send to the shader
 	}
@@ -804,6 +908,10 @@ void GraphicsManager::FreeTextureArrays()
         }
         textureArrays[i] = TextureArray();
 	}
+    Texture::ResetAtlas();
+
+    // Pending textures pointed into the freed arrays
+    TextureLoader::GetInstance().Clear();
 }
 
 //size_t GraphicsManager::GetTextureID(Vertex& vertex) 
@@ -966,13 +1074,16 @@ GLuint GraphicsManager::GetTextureArrayIDGL(const std::string& uuid) const
 int GraphicsManager::GetTextureWidth(const std::string& uuid) const
 {
     auto& textureArrays = Texture::GetTextureArray();
-	return textureArrays[AssetManager::GetInstance().Get<Texture>(uuid)->texArrayIndex].width;
+    auto texture = AssetManager::GetInstance().Get<Texture>(uuid);
+    // An atlas page holds many images, so its size is not the texture's
+    return texture->inAtlas ? texture->width : textureArrays[texture->texArrayIndex].width;
 }
 
 int GraphicsManager::GetTextureHeight(const std::string& uuid) const
 {
     auto& textureArrays = Texture::GetTextureArray();
-    return textureArrays[AssetManager::GetInstance().Get<Texture>(uuid)->texArrayIndex].height;
+    auto texture = AssetManager::GetInstance().Get<Texture>(uuid);
+    return texture->inAtlas ? texture->height : textureArrays[texture->texArrayIndex].height;
 }
 
 GLuint GraphicsManager::GetShaderIDGL(size_t index) const
@@ -1051,18 +1162,22 @@ void GraphicsManager::LoadAllTextures(const std::string& assetsFolder) {
 bool GraphicsManager::AddToBatch(BatchIndex batchID, size_t meshID)
 {
     if (batchID >= batches.size() ||
-        meshID >= meshes.size()) {
+        !meshes.IsAlive(meshID)) {
         Logger::Instance().Log(Logger::Level::ERR, "[RenderSystem] AddToBatch: Invalid batch or mesh ID");
         return false;
     }
 
     BatchData& batch = batches[batchID];
-    if (std::find(batch.meshIDs.begin(), batch.meshIDs.end(), meshID) != batch.meshIDs.end()) {
+    Mesh& mesh = meshes[meshID];
+    if (mesh.batchID == batchID && mesh.batchPosition != Mesh::NO_BATCH_POSITION) {
         Logger::Instance().Log(Logger::Level::WARN, "[RenderSystem] AddToBatch: Mesh already in batch");
         return false;
     }
+    mesh.batchPosition = batch.meshIDs.size();
     batch.meshIDs.push_back(meshID);
-    meshes[meshID].batchID = batchID;
+    // Only the insertion order is known until the batch is sorted
+    batch.sortKeys.push_back(batch.nextSortSequence++ & BatchSort::SEQUENCE_MASK);
+    mesh.batchID = batchID;
     batch.isSorted = false;   // Adding a mesh requires the batch to be sorted again
     batch.isUpdated = false;  // Adding a mesh requires the batch to be updated again
 
@@ -1076,70 +1191,211 @@ bool GraphicsManager::AddToBatch(BatchIndex batchID, size_t meshID)
 bool GraphicsManager::RemoveFromBatch(BatchIndex batchID, size_t meshID)
 {
     if (batchID >= batches.size() ||
-        meshID >= meshes.size()) {
+        !meshes.IsAlive(meshID)) {
         Logger::Instance().Log(Logger::Level::ERR, "[RenderSystem] RemoveFromBatch: Invalid batch or mesh ID");
         return false;
     }
     BatchData& batch = batches[batchID];
+    Mesh& mesh = meshes[meshID];
+    if (mesh.batchID != batchID || mesh.batchPosition >= batch.meshIDs.size()) {
+        return false;
+    }
 
-    auto it = std::find(batch.meshIDs.begin(), batch.meshIDs.end(), meshID);
-    if (it != batch.meshIDs.end()) {
-        batch.meshIDs.erase(it);
-        batch.isUpdated = false;  // Removing a mesh requires the batch to be updated again
+    // Leave a hole instead of erasing, so removing many meshes in a frame stays linear.
+    // The holes are closed by CompactBatch before the batch is next sorted or rebuilt.
+    batch.meshIDs[mesh.batchPosition] = BatchData::REMOVED_MESH;
+    ++batch.removedMeshes;
+    batch.isSorted = false;   // Sorting closes the hole
+    batch.isUpdated = false;  // Removing a mesh requires the batch to be updated again
+
+    mesh.batchID = NO_BATCH;
+    mesh.batchPosition = Mesh::NO_BATCH_POSITION;
+    // Note: Calling RemoveFromBatch tells the graphic manager that the mesh is no longer in the batch,
+    // but the mesh information still exists until ReleaseMesh is called.
+    return true;
+}
 
-        meshes[meshID].batchID = NO_BATCH;
-        // Note: Calling RemoveFromBatch tells the graphic manager that the mesh is no longer in the batch,
-        // but the mesh information still exists in the meshes vector.
-        return true;
+void GraphicsManager::ReleaseMesh(size_t meshID)
+{
+    if (!meshes.IsAlive(meshID)) return;
+
+    size_t batchID = meshes[meshID].batchID;
+    if (batchID < batches.size()) {
+        RemoveFromBatch(static_cast<BatchIndex>(batchID), meshID);
     }
-	return false;
+    meshes.Release(meshID);
+}
+
+void GraphicsManager::CompactBatch(BatchData& batch)
+{
+    if (batch.removedMeshes == 0) return;
+
+    size_t kept = 0;
+    for (size_t i = 0; i < batch.meshIDs.size(); ++i) {
+        if (batch.meshIDs[i] == BatchData::REMOVED_MESH) continue;
+        batch.meshIDs[kept] = batch.meshIDs[i];
+        batch.sortKeys[kept] = batch.sortKeys[i];
+        meshes[batch.meshIDs[kept]].batchPosition = kept;
+        ++kept;
+    }
+    batch.meshIDs.resize(kept);
+    batch.sortKeys.resize(kept);
+    batch.removedMeshes = 0;
 }
 
 void GraphicsManager::SortBatch(BatchData& batch)
 {
     //if (batch.sorted) Logger::Instance().Log(Logger::Level::INFO, "[GraphicsManager] SortBatch: Called on a sorted batch");
     //std::cout << "Sorting batch" << std::endl;
-    std::sort(batch.meshIDs.begin(), batch.meshIDs.end(), [&](size_t a, size_t b) {
+    PROFILE_SCOPE("GraphicsManager::SortBatch");
+    CompactBatch(batch);
+
+    // Refresh the keys from the meshes' current depth and texture, keeping each mesh's insertion order
+    auto& updatedKeys = sortScratch.keys;
+    updatedKeys.resize(batch.meshIDs.size());
+    for (size_t i = 0; i < batch.meshIDs.size(); ++i) {
         // This assumes that all the vertices of a mesh have the same z value
-        return meshes[a].vertices[0].position.z < meshes[b].vertices[0].position.z;
+        Mesh const& mesh = meshes[batch.meshIDs[i]];
+        updatedKeys[i] = BatchSort::MakeKey(batch.id, mesh.GetDepth(), mesh.vertices[0].texArray, BatchSort::Sequence(batch.sortKeys[i]));
+    }
+    bool reordered = BatchSort::Sort(batch.sortKeys, batch.meshIDs, updatedKeys, sortScratch);
+    if (reordered) {
+        for (size_t i = 0; i < batch.meshIDs.size(); ++i) {
+            meshes[batch.meshIDs[i]].batchPosition = i;
         }
-    );
+    }
+
+    // Renumber the insertion order before it runs out of bits. Numbering in draw order keeps the current order.
+    if (batch.nextSortSequence > BatchSort::SEQUENCE_MASK) {
+        for (size_t i = 0; i < batch.sortKeys.size(); ++i) {
+            batch.sortKeys[i] = (batch.sortKeys[i] & ~BatchSort::SEQUENCE_MASK) | i;
+        }
+        batch.nextSortSequence = batch.sortKeys.size();
+    }
 
     batch.isSorted = true;
-    UpdateBatch(batch); // You will need to update the batch after sorting
+    // Only a new draw order or added and removed meshes need the batch to be rebuilt. Meshes that
+    // moved without changing the order are patched in place like any other vertex change.
+    if (reordered || !batch.isUpdated || batch.meshSlots.size() != batch.meshIDs.size()) UpdateBatch(batch);
 }
 
 void GraphicsManager::UpdateBatch(BatchData& batch)
 {
     //if (batch.updated) Logger::Instance().Log(Logger::Level::INFO, "[GraphicsManager] RefreshBatch: Called on an updated batch");
+    CompactBatch(batch);
 
     batch.vertices.clear();
     batch.indices.clear();
+    batch.meshFirstIndex.clear();
+    batch.meshSlots.clear();
+
+    // Sorting layer batches made only of sprites are drawn as one instance per sprite
+    batch.useInstancing = spriteInstancing && batch.id <= BatchIndex::LAST_SRTG_LAYER && BuildInstances(batch);
+    if (!batch.useInstancing) {
+        batch.instances.clear();
+        batch.meshSlots.clear();
+
+        std::vector<Vertex> clipped;
+        for (auto& meshID : batch.meshIDs) {
+            auto& mesh = meshes[meshID];
+            mesh.UpdatePositions();
+            unsigned int vertexOffset = static_cast<unsigned int>(batch.vertices.size());
+            batch.meshSlots[meshID] = { vertexOffset, mesh.vertices.size() };
+            for (const auto& vertex : mesh.GetDrawnVertices(clipped)) {
+                batch.vertices.emplace_back(vertex, mesh.texRect);
+            }
 
-    for (auto& meshID : batch.meshIDs) {
-		auto& mesh = meshes[meshID];
-        unsigned int vertexOffset = static_cast<unsigned int>(batch.vertices.size());
-        batch.vertices.insert(batch.vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
-
-        for (const auto& index : mesh.indices) {
-			batch.indices.push_back(index + vertexOffset);
-		}
-	}
+            batch.meshFirstIndex.push_back(batch.indices.size());
+            for (const auto& index : mesh.indices) {
+                batch.indices.push_back(index + vertexOffset);
+            }
+        }
+        batch.meshFirstIndex.push_back(batch.indices.size());
+    }
     batch.isUpdated = true;
 
     // This updates the batch's VAO, VBO, and EBO
+    batch.MarkAllDirty();
+    batch.UpdateBuffers();
+}
+
+bool GraphicsManager::BuildInstances(BatchData& batch)
+{
+    batch.instances.clear();
+    batch.meshSlots.clear();
+    if (batch.renderMode != GL_TRIANGLES || batch.polygonMode != GL_FILL) return false;
+
+    batch.instances.reserve(batch.meshIDs.size());
+    std::vector<Vertex> clipped;
+    for (size_t meshID : batch.meshIDs) {
+        auto& mesh = meshes[meshID];
+        SpriteInstance instance;
+        if (!BatchData::BuildInstance(mesh, clipped, instance)) return false;
+
+        batch.meshSlots[meshID] = { batch.instances.size(), mesh.vertices.size() };
+        batch.instances.push_back(instance);
+    }
+    return true;
+}
+
+Shader& GraphicsManager::GetBatchShader(BatchData const& batch, ShaderIndex shaderIndex)
+{
+    if (!batch.useInstancing) return shaders[shaderIndex];
+    return shaders[shaderIndex == ShaderIndex::SHDR_OBJ_PICKING_WORLD ?
+        ShaderIndex::SHDR_OBJ_PICKING_INSTANCED : ShaderIndex::SHDR_SPRITE_INSTANCED];
+}
+
+std::vector<BatchData::DrawRange> const* GraphicsManager::GetDrawRanges(CameraSlot slot, size_t batchID) const
+{
+    if (!viewCulling || !hasDrawRanges[slot] || batchID > BatchIndex::LAST_SRTG_LAYER) return nullptr;
+    return &drawRanges[slot][batchID];
+}
+
+void GraphicsManager::PatchBatch(BatchData& batch)
+{
+    if (batch.dirtyMeshes.empty() && batch.movedMeshes.empty()) return;
+
+    // A mesh is often flagged more than once a frame (e.g. color and texture changes)
+    std::sort(batch.dirtyMeshes.begin(), batch.dirtyMeshes.end());
+    batch.dirtyMeshes.erase(std::unique(batch.dirtyMeshes.begin(), batch.dirtyMeshes.end()), batch.dirtyMeshes.end());
+
+    std::vector<Vertex> clipped;
+    for (size_t meshID : batch.dirtyMeshes) {
+        // Vertices are only left untransformed for instances, which are placed from the transform
+        if (!batch.useInstancing) meshes[meshID].UpdatePositions();
+
+        // A mesh whose vertex count changed, or that is no longer a plain sprite in an instanced batch, rebuilds the batch
+        if (!batch.PatchMesh(meshID, meshes[meshID], clipped)) {
+            UpdateBatch(batch);
+            return;
+        }
+    }
+
+    // Moved meshes that also changed were placed by PatchMesh
+    for (size_t meshID : batch.movedMeshes) {
+        if (std::binary_search(batch.dirtyMeshes.begin(), batch.dirtyMeshes.end(), meshID)) continue;
+        if (!batch.PatchTransform(meshID, meshes[meshID])) {
+            UpdateBatch(batch);
+            return;
+        }
+    }
+    batch.dirtyMeshes.clear();
+    batch.movedMeshes.clear();
+
     batch.UpdateBuffers();
 }
 
-void GraphicsManager::SetTextureToMesh(size_t meshID, int texArrayIndex, int texLayerIndex)
+void GraphicsManager::SetTextureToMesh(size_t meshID, int texArrayIndex, int texLayerIndex, Vec4 const& texRect, Vec4 const& contentRect)
 {
     size_t batchID = meshes[meshID].batchID;
     if (batchID >= batches.size()) {
 		Logger::Instance().Log(Logger::Level::ERR, "[GraphicsManager] SetTexture: Invalid batch ID");
 		return;
 	}
-    batches[batchID].isUpdated = false;
+    batches[batchID].MarkMeshDirty(meshID);
 
+    meshes[meshID].texRect = texRect;
+    meshes[meshID].contentRect = contentRect;
     for (auto& vertex : meshes[meshID].vertices) {
         vertex.texArray = texArrayIndex;
         vertex.texLayer = texLayerIndex;
@@ -1153,7 +1409,7 @@ void GraphicsManager::SetColorToMesh(size_t meshID, Vec4 color)
         Logger::Instance().Log(Logger::Level::ERR, "[GraphicsManager] SetTexture: Invalid batch ID");
         return;
     }
-    batches[batchID].isUpdated = false;
+    batches[batchID].MarkMeshDirty(meshID);
 
     for (auto& vertex : meshes[meshID].vertices) {
         vertex.color = color;
@@ -1167,7 +1423,7 @@ void GraphicsManager::SetVisibilityToMesh(size_t meshID, bool visibility)
         Logger::Instance().Log(Logger::Level::ERR, "[GraphicsManager] SetTexture: Invalid batch ID");
         return;
     }
-    batches[batchID].isUpdated = false;
+    batches[batchID].MarkMeshDirty(meshID);
 
     for (auto& vertex : meshes[meshID].vertices) {
         vertex.visible = static_cast<int>(visibility);
@@ -1185,7 +1441,7 @@ void GraphicsManager::SetBatchUpdateFlag(BatchIndex batchID, bool flag)
 
 void GraphicsManager::SetBatchUpdateFlag(size_t meshID, bool flag)
 {
-    if (meshID >= meshes.size()) {
+    if (!meshes.IsAlive(meshID)) {
         Logger::Instance().Log(Logger::Level::ERR, "[GraphicsManager] ToggleBatchUpdate: Invalid mesh ID");
         return;
     }
@@ -1194,9 +1450,34 @@ void GraphicsManager::SetBatchUpdateFlag(size_t meshID, bool flag)
         Logger::Instance().Log(Logger::Level::ERR, "[GraphicsManager] ToggleBatchSort: Invalid batch ID");
         return;
     }
+    // Only the mesh changed, so it can be patched into the batch instead of rebuilding everything
+    if (!flag) {
+        batches[batchID].MarkMeshDirty(meshID);
+        return;
+    }
     batches[batchID].isUpdated = flag;
 }
 
+void GraphicsManager::SetMeshMovedFlag(size_t meshID)
+{
+    if (!meshes.IsAlive(meshID)) {
+        Logger::Instance().Log(Logger::Level::ERR, "[GraphicsManager] SetMeshMovedFlag: Invalid mesh ID");
+        return;
+    }
+    size_t batchID = meshes[meshID].batchID;
+    if (batchID >= batches.size()) {
+        Logger::Instance().Log(Logger::Level::ERR, "[GraphicsManager] SetMeshMovedFlag: Invalid batch ID");
+        return;
+    }
+    batches[batchID].MarkMeshMoved(meshID);
+}
+
+bool GraphicsManager::IsDrawnInstanced(size_t meshID) const
+{
+    size_t batchID = meshes[meshID].batchID;
+    return batchID < batches.size() && batches[batchID].useInstancing;
+}
+
 void GraphicsManager::SetBatchSortFlag(BatchIndex batchID, bool flag)
 {
     if (batchID >= batches.size()) {
@@ -1208,7 +1489,7 @@ void GraphicsManager::SetBatchSortFlag(BatchIndex batchID, bool flag)
 
 void GraphicsManager::SetBatchSortFlag(size_t meshID, bool flag)
 {
-    if (meshID >= meshes.size()) {
+    if (!meshes.IsAlive(meshID)) {
         Logger::Instance().Log(Logger::Level::ERR, "[GraphicsManager] ToggleBatchSort: Invalid mesh ID");
         return;
     }
@@ -1242,6 +1523,28 @@ glm::mat4 GraphicsManager::GetProjectionMatrixEngine()
     return camera.GetProjectionMatrix();
 }
 
+void GraphicsManager::GetViewBounds(CameraSlot slot, Vec2& min, Vec2& max)
+{
+    glm::mat4 viewProjection = slot == CameraSlot::CAMERA_ENGINE ?
+        GetProjectionMatrixEngine() * GetViewMatrixEngine() : GetProjectionMatrixGame() * GetViewMatrixGame();
+    glm::mat4 inverse = glm::inverse(viewProjection);
+
+    // The corners of the screen in world space, which covers zoom, rotation and the camera's size
+    glm::vec2 lower(std::numeric_limits<float>::max()), upper(std::numeric_limits<float>::lowest());
+    for (float x : { -1.f, 1.f }) {
+        for (float y : { -1.f, 1.f }) {
+            glm::vec4 corner = inverse * glm::vec4(x, y, 0.f, 1.f);
+            glm::vec2 world = glm::vec2(corner) / corner.w;
+            lower = glm::min(lower, world);
+            upper = glm::max(upper, world);
+        }
+    }
+
+    glm::vec2 margin = (upper - lower) * std::max(cullMargin, 0.f);
+    min = Vec2(lower.x - margin.x, lower.y - margin.y);
+    max = Vec2(upper.x + margin.x, upper.y + margin.y);
+}
+
 void GraphicsManager::SetInternalFormat(std::string _internalFormat)
 {
     if (_internalFormat == "High" || _internalFormat == "GL_RGBA8") {
@@ -28,8 +28,10 @@
 #include "Vertex.hpp"
 #include "Shader.hpp"
 #include "Mesh.hpp"
+#include "MeshPool.hpp"
 #include "Texture.hpp"
 #include "BatchData.hpp"
+#include "BatchSort.hpp"
 //#include "Animation.hpp"
 #include "Font.hpp"
 #include "EngineCamera.hpp"
@@ -37,6 +39,9 @@
 #include "../ECS/Entity.hpp"
 #include "../Layers/SortingLayer.hpp"
 
+// Forward declaration
+struct Camera;
+
  /*!*****************************************************************************
  \class GraphicsManager
  \brief
@@ -72,6 +77,8 @@ public:
 		SHDR_FINAL,
 		SHDR_VIDEOPLAYER,
 		SHDR_OBJ_PICKING_UI,
+		SHDR_SPRITE_INSTANCED,
+		SHDR_OBJ_PICKING_INSTANCED,
 
 		SHDR_MAX // This represents the total number of shaders, not an actual shader
 	};
@@ -116,6 +123,18 @@ public:
 		MAX_FRAMEBUFFERS // This represents the total number of framebuffers, not an actual framebuffer
 	};
 
+	/*!
+	* \enum CameraSlot
+	 * \brief Cameras whose matrices are stored in the Camera uniform block.
+	 */
+	enum CameraSlot : size_t
+	{
+		CAMERA_GAME = 0,
+		CAMERA_ENGINE,
+
+		MAX_CAMERA_SLOTS // This represents the total number of camera slots, not an actual slot
+	};
+
 	/*!
 	 * \brief Retrieves the singleton instance of the `GraphicsManager`.
 	 *
@@ -428,6 +447,16 @@ public:
 	*/
 	bool RemoveFromBatch(BatchIndex batchID, size_t meshID);
 
+	/*!
+	* \brief Removes a mesh from its batch and frees its slot for reuse.
+	*
+	* The mesh ID may be handed out again by the next mesh created, so holders
+	* of the ID must forget it.
+	*
+	* \param meshID The ID of the mesh to release.
+	*/
+	void ReleaseMesh(size_t meshID);
+
 	/*!
 	* \brief Sorts the specified batch.
 	* 
@@ -442,11 +471,22 @@ public:
 	*/
 	void UpdateBatch(BatchData& batch);
 
+	/*!
+	* \brief Copies the meshes that changed since the last patch into the batch and uploads only their vertices.
+	*
+	* Meshes that only moved in an instanced batch have just their instance placed again.
+	* Falls back to UpdateBatch if a mesh is not in the batch or its vertex count changed.
+	*
+	* \param batch The batch to patch.
+	*/
+	void PatchBatch(BatchData& batch);
+
 	/*!
 	* \brief Sets the batch update flag.
 	* 
 	* The batch update flag is used to determine if batch needs to be updated.
-	* Overloaded to accept meshID or batchID.
+	* Overloaded to accept meshID or batchID. Clearing the flag for a mesh
+	* only marks that mesh to be patched into its batch.
 	* 
 	* \param meshID Sets the update flag of the batch containing the mesh.
 	* \param flag The flag to set.
@@ -464,6 +504,23 @@ public:
 	*/
 	void SetBatchUpdateFlag(BatchIndex batchID, bool flag = false);
 
+	/*!
+	* \brief Marks a mesh whose transform alone changed, after Mesh::SetModelToWorld.
+	*
+	* In an instanced batch only the mesh's instance is moved. Otherwise the mesh is
+	* patched into its batch like SetBatchUpdateFlag does.
+	*
+	* \param meshID The mesh that moved.
+	*/
+	void SetMeshMovedFlag(size_t meshID);
+
+	/*!
+	* \brief Checks whether a mesh's batch is drawn as instances, so its vertices need not be transformed.
+	*
+	* \param meshID The mesh to check. Must be alive.
+	*/
+	bool IsDrawnInstanced(size_t meshID) const;
+
 	/*!
 	* \brief Sets the batch sort flag.
 	*
@@ -494,8 +551,11 @@ public:
 	 * rendering to apply the specified texture.
 	 *
 	 * \param textureID The ID of the texture to apply to the mesh.
+	 * \param texRect Region of the layer holding the image, see Texture::texRect. The whole layer by default.
+	 * \param contentRect Part of the image the texture stores, see Texture::contentRect. The whole image by default.
 	 */
-	void SetTextureToMesh(size_t meshID, int texArrayIndex, int texLayerIndex);
+	void SetTextureToMesh(size_t meshID, int texArrayIndex, int texLayerIndex, Vec4 const& texRect = Vec4(0.f, 0.f, 1.f, 1.f),
+		Vec4 const& contentRect = Vec4(0.f, 0.f, 1.f, 1.f));
 
 	/*!
 	 * \brief Sets the color for the mesh.
@@ -556,10 +616,68 @@ public:
 	void SetInternalFormat(std::string internalFormat);
 
 	GLenum GetInternalFormat() const;
+
+	/*!
+	* \brief Computes the world space rectangle a camera sees, grown by cullMargin on every side.
+	*
+	* \param slot The camera to use.
+	* \param min Receives the bottom left corner of the rectangle.
+	* \param max Receives the top right corner of the rectangle.
+	*/
+	void GetViewBounds(CameraSlot slot, Vec2& min, Vec2& max);
+
+private:
+	/*!
+	* \brief Uploads the Camera and FrameData uniform blocks for this frame.
+	*
+	* Every camera slot and the post-processing parameters are written with a
+	* single upload. Passes then only switch which camera slot is bound.
+	*
+	* \param camComponent The active game camera, for the post-processing parameters.
+	*/
+	void UpdateFrameUniforms(Camera const& camComponent);
+
+	/*!
+	* \brief Binds a camera slot to the Camera uniform block used by the world shaders.
+	*
+	* \param slot The camera to render with.
+	*/
+	void BindCamera(CameraSlot slot);
+
+	/*!
+	* \brief Returns the shader to draw a world batch with, swapping in the instanced version for instanced batches.
+	*
+	* \param batch The batch to draw.
+	* \param shaderIndex SHDR_DEFAULT or SHDR_OBJ_PICKING_WORLD.
+	*/
+	Shader& GetBatchShader(BatchData const& batch, ShaderIndex shaderIndex);
+
+	/*!
+	* \brief Returns the meshes of a batch to draw through a camera this frame, or null to draw every mesh.
+	*
+	* \param slot The camera the batch is drawn with.
+	* \param batchID The batch to draw. Only sorting layer batches are culled.
+	*/
+	std::vector<BatchData::DrawRange> const* GetDrawRanges(CameraSlot slot, size_t batchID) const;
+
+	/*!
+	* \brief Rebuilds a batch's instances and mesh slots from its meshes.
+	*
+	* \param batch The batch to rebuild.
+	* \return False if a mesh in the batch cannot be drawn as an instance.
+	*/
+	bool BuildInstances(BatchData& batch);
+
+	/*!
+	* \brief Closes the holes left in a batch by RemoveFromBatch and updates the meshes' batch positions.
+	*
+	* \param batch The batch to compact.
+	*/
+	void CompactBatch(BatchData& batch);
 	
 public:
 	std::vector<Shader> shaders;						// Shaders used for rendering
-	std::vector<Mesh> meshes;							// Meshes used for rendering
+	MeshPool meshes;									// Meshes used for rendering, indexed by mesh ID
 
 	std::vector<GLuint> tempTextures;					// Temporary textures used for IMGUI
 
@@ -570,6 +688,14 @@ public:
 	std::vector<FrameBuffer> frameBuffers;				// Framebuffers for rendering
 
 	bool debugMode;										// Debug mode flag
+	bool pixelPicking;									// Draws the object picking framebuffers for pixel exact picking
+	bool spriteInstancing;								// Draws sorting layer batches made only of sprites as instances
+
+	// View culling
+	bool viewCulling;									// Draws only the sorting layer meshes inside the camera views, see RenderSystem::CullBatches
+	float cullMargin;									// Fraction of the view size added on every side of the culling rectangle, so scrolling does not pop sprites in
+	std::vector<BatchData::DrawRange> drawRanges[CameraSlot::MAX_CAMERA_SLOTS][BatchIndex::LAST_SRTG_LAYER + 1]; // Meshes of each sorting layer batch to draw through each camera
+	bool hasDrawRanges[CameraSlot::MAX_CAMERA_SLOTS];	// Set when drawRanges was filled for this frame, cleared by Render
 
 	// Camera
 	EngineCamera camera;								// Camera used for rendering
@@ -580,6 +706,13 @@ private:
 	GLuint readFramebuffer;
 	GLuint drawFramebuffer;
 
+	// Uniform buffer holding the Camera blocks of every camera slot followed by the FrameData block
+	GLuint uniformBuffer;
+	size_t cameraSlotStride;							// Offset between camera slots, padded to the buffer offset alignment
+	std::vector<unsigned char> uniformStaging;			// CPU copy of the uniform buffer, uploaded once per frame
+
+	BatchSort::Scratch sortScratch;						// Buffers reused by SortBatch
+
 	// Internal format for texture views
 	GLenum internalFormat;
 };
\ No newline at end of file
@@ -17,6 +17,10 @@
 #include "Mesh.hpp"
 #include "TextureArray.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
 Mesh::Mesh(
 	std::vector<Vertex> const& vertices, 
 	std::vector<unsigned int> const& indices, 
@@ -24,10 +28,11 @@ Mesh::Mesh(
 	size_t batchID = static_cast<size_t>(-1))
 	: id(static_cast<size_t>(-1)), 
 	vertices(vertices), indices(indices), modelSpacePosition(modelSpacePosition), 
-	batchID(batchID)
+	batchID(batchID), batchPosition(NO_BATCH_POSITION), texRect(0.f, 0.f, 1.f, 1.f), contentRect(0.f, 0.f, 1.f, 1.f)
 {
-	static size_t idCounter = 0;
-	this->id = idCounter++;
+	// The id is the mesh's slot, assigned by MeshPool::Create
+	modelToWorld.SetToIdentity();
+	arePositionsStale = false;
 	cumulativeScale = Vec2(1.0f, 1.0f);
 	cumulativeRotation = 0.0f;
 }
@@ -37,6 +42,99 @@ Mesh::~Mesh()
 
 }
 
+namespace {
+	/*
+	 * Moves the corners of a quad whose texture coordinates reach outside contentRect back inside
+	 * it, along with their coordinates. Returns false if the quad is left as it is.
+	 */
+	bool ClipQuad(Vec3 (&positions)[4], Vec2 (&texCoords)[4], Vec4 const& contentRect)
+	{
+		float minU = contentRect.x, maxU = contentRect.x + contentRect.z;
+		float minV = contentRect.y, maxV = contentRect.y + contentRect.w;
+		bool inside = std::all_of(std::begin(texCoords), std::end(texCoords), [=](Vec2 const& texCoord) {
+			return texCoord.x >= minU && texCoord.x <= maxU && texCoord.y >= minV && texCoord.y <= maxV;
+		});
+		if (inside) return false;
+
+		// The quad maps texture coordinates to positions affinely, position = origin + u * alongU + v * alongV
+		Vec3 edge1 = positions[1] - positions[0];
+		Vec3 edge2 = positions[2] - positions[0];
+		float du1 = texCoords[1].x - texCoords[0].x, dv1 = texCoords[1].y - texCoords[0].y;
+		float du2 = texCoords[2].x - texCoords[0].x, dv2 = texCoords[2].y - texCoords[0].y;
+		float determinant = du1 * dv2 - du2 * dv1;
+		if (std::abs(determinant) < 1e-8f) return false;
+
+		Vec3 alongU = (edge1 * dv2 - edge2 * dv1) / determinant;
+		Vec3 alongV = (edge2 * du1 - edge1 * du2) / determinant;
+
+		for (size_t i = 0; i < 4; ++i) {
+			float u = std::clamp(texCoords[i].x, minU, maxU);
+			float v = std::clamp(texCoords[i].y, minV, maxV);
+			positions[i] += alongU * (u - texCoords[i].x) + alongV * (v - texCoords[i].y);
+			texCoords[i] = Vec2(u, v);
+		}
+		return true;
+	}
+}
+
+std::vector<Vertex> const& Mesh::GetDrawnVertices(std::vector<Vertex>& clipped) const
+{
+	if (vertices.size() != 4) return vertices;
+
+	Vec3 positions[4];
+	Vec2 texCoords[4];
+	for (size_t i = 0; i < 4; ++i) {
+		positions[i] = vertices[i].position;
+		texCoords[i] = vertices[i].texCoord;
+	}
+	if (!ClipQuad(positions, texCoords, contentRect)) return vertices;
+
+	clipped = vertices;
+	for (size_t i = 0; i < 4; ++i) {
+		clipped[i].position = positions[i];
+		clipped[i].texCoord = texCoords[i];
+	}
+	return clipped;
+}
+
+bool Mesh::GetDrawnModelCorners(Vec3 (&corners)[4]) const
+{
+	if (vertices.size() != 4 || modelSpacePosition.size() != 4) return false;
+
+	Vec2 texCoords[4];
+	for (size_t i = 0; i < 4; ++i) {
+		corners[i] = modelSpacePosition[i];
+		texCoords[i] = vertices[i].texCoord;
+	}
+	ClipQuad(corners, texCoords, contentRect);
+	return true;
+}
+
+void Mesh::SetModelToWorld(Mat4 const& modelToWorldMtx)
+{
+	modelToWorld = modelToWorldMtx;
+	arePositionsStale = true;
+}
+
+void Mesh::UpdatePositions()
+{
+	if (!arePositionsStale) return;
+	arePositionsStale = false;
+	if (vertices.size() != modelSpacePosition.size()) return;
+
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		vertices[i].position = modelToWorld * modelSpacePosition[i];
+	}
+}
+
+float Mesh::GetDepth() const
+{
+	if (arePositionsStale && !modelSpacePosition.empty()) {
+		return (modelToWorld * modelSpacePosition[0]).z;
+	}
+	return vertices.empty() ? 0.f : vertices[0].position.z;
+}
+
 //void Mesh::SetTexture(int texArrayIndex, int texLayerIndex)
 //{
 //	for (auto& vertex : vertices) {
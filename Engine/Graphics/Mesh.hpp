@@ -20,6 +20,7 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include "Math.hpp"
 #include "Vertex.hpp"
 #include "Shader.hpp"
 #include "Texture.hpp"
@@ -36,6 +37,7 @@
 class Mesh 
 {
 public:
+	static constexpr size_t NO_BATCH_POSITION = static_cast<size_t>(-1);
 
 	// Never call this constructor
 	Mesh() = delete;
@@ -62,6 +64,57 @@ public:
 	 * Cleans up resources used by the mesh.
 	 */
 	~Mesh();
+
+	Mesh(Mesh const&) = default;
+	Mesh(Mesh&&) noexcept = default;
+	Mesh& operator=(Mesh const&) = default;
+	Mesh& operator=(Mesh&&) noexcept = default;
+
+	/*!
+	 * \brief Gets the vertices to draw, clipped to the part of the image the texture stores.
+	 *
+	 * Atlas images are stored without their transparent borders. A quad whose texture
+	 * coordinates reach into a border is cut back to contentRect, moving its corners along
+	 * with their coordinates, so it covers only what was stored. Other meshes, and quads
+	 * whose texture is entirely stored, are drawn as they are.
+	 *
+	 * \param clipped Receives the clipped vertices when the quad has to be clipped.
+	 * \return The mesh's vertices, or clipped.
+	 */
+	std::vector<Vertex> const& GetDrawnVertices(std::vector<Vertex>& clipped) const;
+
+	/*!
+	 * \brief Gets the model space corners of a quad, clipped the same way as GetDrawnVertices.
+	 *
+	 * The clip is affine, so transforming these corners by modelToWorld gives the drawn
+	 * world corners without transforming the vertices.
+	 *
+	 * \param corners Receives the corners, in vertex order.
+	 * \return False if the mesh is not a quad with a model space position for every vertex.
+	 */
+	bool GetDrawnModelCorners(Vec3 (&corners)[4]) const;
+
+	/*!
+	 * \brief Stores the model to world transform without transforming the vertices.
+	 *
+	 * Used for sprites drawn as instances, which are built from the transform. The vertex
+	 * positions are left stale until UpdatePositions is called.
+	 */
+	void SetModelToWorld(Mat4 const& modelToWorldMtx);
+
+	/*!
+	 * \brief Transforms the model space positions into the vertices if they are stale.
+	 *
+	 * Must be called before the vertex positions of a mesh given SetModelToWorld are read.
+	 */
+	void UpdatePositions();
+
+	/*!
+	 * \brief Gets the world depth of the mesh, from the transform if the positions are stale.
+	 *
+	 * Assumes every vertex of the mesh has the same z.
+	 */
+	float GetDepth() const;
 	
 	/*!
 	 * \brief Sets the texture for the mesh.
@@ -94,7 +147,7 @@ public:
 	//void SetVisibility(bool visibility);
 
 public:
-	size_t id;												//!< The unique identifier for the mesh.
+	size_t id;												//!< The slot of the mesh in the MeshPool, which is its ID.
 	
 	std::vector<Vec3> modelSpacePosition;					//!< The collection of model space positions for the mesh.
 
@@ -103,6 +156,13 @@ public:
 	std::vector<unsigned int> indices;						//!< The collection of indices for the mesh.
 
 	size_t batchID;											//!< The ID of the batch to which the mesh belongs.
+	size_t batchPosition;									//!< Index of the mesh in its batch's meshIDs, or NO_BATCH_POSITION.
+
+	Vec4 texRect;											//!< Region of the texture layer holding the mesh's image, see Texture::texRect.
+	Vec4 contentRect;										//!< Part of the image the texture stores, see Texture::contentRect.
+
+	Mat4 modelToWorld;										//!< Transform given by the last SetModelToWorld.
+	bool arePositionsStale;									//!< The vertex positions are older than modelToWorld, see UpdatePositions.
 
 	Vec2 cumulativeScale;									//!< The cumulative scale of the mesh.
 	float cumulativeRotation;
@@ -0,0 +1,35 @@
+/*********************************************************************
+ * \file		MeshHandle.hpp
+ * \brief		Generation-checked reference to a mesh in the MeshPool
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef MESH_HANDLE_HPP
+#define MESH_HANDLE_HPP
+
+#include <cstdint>
+
+/**
+ * \struct MeshHandle
+ * \brief Refers to a mesh slot and the generation of the mesh that was in it.
+ *
+ * Mesh IDs are slot indices and are reused once a mesh is released. Holders
+ * that may outlive their mesh keep a handle instead, which stops resolving as
+ * soon as the mesh is released.
+ */
+struct MeshHandle {
+	static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+	uint32_t index = INVALID_INDEX;
+	uint32_t generation = 0;
+};
+
+#endif // MESH_HANDLE_HPP
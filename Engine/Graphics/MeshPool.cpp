@@ -0,0 +1,99 @@
+/*********************************************************************
+ * \file		MeshPool.cpp
+ * \brief		Slot allocator for the meshes owned by the
+ *				GraphicsManager, with generation-checked handles
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include "MeshPool.hpp"
+
+#include <algorithm>
+
+size_t MeshPool::Create(std::vector<Vertex> const& vertices, std::vector<unsigned int> const& indices,
+	std::vector<Vec3> const& modelSpacePosition, size_t batchID) {
+	size_t meshID;
+	if (!m_freeSlots.empty()) {
+		meshID = m_freeSlots.back();
+		m_freeSlots.pop_back();
+		m_meshes[meshID] = Mesh(vertices, indices, modelSpacePosition, batchID);
+	}
+	else {
+		meshID = m_meshes.size();
+		m_meshes.emplace_back(vertices, indices, modelSpacePosition, batchID);
+		m_alive.push_back(false);
+		if (m_generations.size() < m_meshes.size()) {
+			m_generations.push_back(0);
+		}
+	}
+
+	m_meshes[meshID].id = meshID;
+	m_alive[meshID] = true;
+	++m_liveCount;
+	return meshID;
+}
+
+bool MeshPool::Release(size_t meshID) {
+	if (!IsAlive(meshID)) {
+		return false;
+	}
+
+	// Free the vertex storage now rather than when the slot is reused
+	Mesh& mesh = m_meshes[meshID];
+	std::vector<Vertex>().swap(mesh.vertices);
+	std::vector<unsigned int>().swap(mesh.indices);
+	std::vector<Vec3>().swap(mesh.modelSpacePosition);
+	mesh.batchID = static_cast<size_t>(-1);
+	mesh.batchPosition = Mesh::NO_BATCH_POSITION;
+
+	m_alive[meshID] = false;
+	++m_generations[meshID];
+	m_freeSlots.push_back(meshID);
+	--m_liveCount;
+	return true;
+}
+
+void MeshPool::Clear() {
+	for (size_t meshID = 0; meshID < m_meshes.size(); ++meshID) {
+		Release(meshID);
+	}
+	Compact();
+}
+
+size_t MeshPool::Compact() {
+	size_t trimmed = 0;
+	while (!m_meshes.empty() && !m_alive.back()) {
+		m_meshes.pop_back();
+		m_alive.pop_back();
+		++trimmed;
+	}
+	if (trimmed == 0) {
+		return 0;
+	}
+
+	size_t slots = m_meshes.size();
+	m_freeSlots.erase(std::remove_if(m_freeSlots.begin(), m_freeSlots.end(),
+		[slots](size_t meshID) { return meshID >= slots; }), m_freeSlots.end());
+
+	// Only give memory back once the pool has shrunk a lot, so a scene that is reloaded does not reallocate
+	if (m_meshes.capacity() > 2 * slots) {
+		m_meshes.shrink_to_fit();
+		m_alive.shrink_to_fit();
+		m_freeSlots.shrink_to_fit();
+	}
+	return trimmed;
+}
+
+MeshHandle MeshPool::GetHandle(size_t meshID) const {
+	if (!IsAlive(meshID)) {
+		return {};
+	}
+	return { static_cast<uint32_t>(meshID), m_generations[meshID] };
+}
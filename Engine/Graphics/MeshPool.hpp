@@ -0,0 +1,114 @@
+/*********************************************************************
+ * \file		MeshPool.hpp
+ * \brief		Slot allocator for the meshes owned by the
+ *				GraphicsManager, with generation-checked handles
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef MESH_POOL_HPP
+#define MESH_POOL_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "Mesh.hpp"
+#include "MeshHandle.hpp"
+
+/**
+ * \class MeshPool
+ * \brief Stores meshes in reusable slots.
+ *
+ * Released slots go on a free list and are handed out again by Create, so the
+ * number of slots follows the number of live meshes instead of the number ever
+ * created. A slot's ID never changes while its mesh is alive, so IDs held by
+ * renderers and batches stay valid. Compact only trims released slots from the
+ * end of the pool.
+ */
+class MeshPool {
+public:
+	/**
+	 * \brief Creates a mesh in a free slot, or in a new slot if there is none.
+	 *
+	 * \return The ID of the mesh, which is its slot index.
+	 */
+	size_t Create(std::vector<Vertex> const& vertices, std::vector<unsigned int> const& indices,
+		std::vector<Vec3> const& modelSpacePosition, size_t batchID);
+
+	/**
+	 * \brief Frees the slot of a mesh so it can be reused.
+	 *
+	 * The caller must remove the mesh from its batch first. Handles to the mesh
+	 * stop resolving.
+	 *
+	 * \return False if the mesh was not alive.
+	 */
+	bool Release(size_t meshID);
+
+	/**
+	 * \brief Releases every mesh and trims all the slots.
+	 */
+	void Clear();
+
+	/**
+	 * \brief Trims released slots from the end of the pool and returns unused memory.
+	 *
+	 * \return The number of slots trimmed.
+	 */
+	size_t Compact();
+
+	/**
+	 * \brief Checks whether a mesh ID refers to a live mesh.
+	 */
+	bool IsAlive(size_t meshID) const {
+		return meshID < m_meshes.size() && m_alive[meshID];
+	}
+
+	/**
+	 * \brief Returns a handle to a live mesh, or an invalid handle.
+	 */
+	MeshHandle GetHandle(size_t meshID) const;
+
+	/**
+	 * \brief Checks whether a handle still refers to the mesh it was created for.
+	 */
+	bool IsValid(MeshHandle handle) const {
+		return IsAlive(handle.index) && m_generations[handle.index] == handle.generation;
+	}
+
+	/**
+	 * \brief Returns the mesh of a handle, or nullptr if it was released.
+	 */
+	Mesh* Get(MeshHandle handle) {
+		return IsValid(handle) ? &m_meshes[handle.index] : nullptr;
+	}
+
+	Mesh& operator[](size_t meshID) { return m_meshes[meshID]; }
+	Mesh const& operator[](size_t meshID) const { return m_meshes[meshID]; }
+	Mesh& back() { return m_meshes.back(); }
+
+	/**
+	 * \brief Returns the number of slots, live or released. Every valid mesh ID is below it.
+	 */
+	size_t size() const { return m_meshes.size(); }
+	bool empty() const { return m_meshes.empty(); }
+
+	size_t GetLiveCount() const { return m_liveCount; }
+	size_t GetDeadCount() const { return m_meshes.size() - m_liveCount; }
+
+private:
+	std::vector<Mesh> m_meshes;				//!< Meshes by slot. Released slots keep an empty mesh.
+	std::vector<uint32_t> m_generations;	//!< Generation of each slot, kept for trimmed slots so old handles stay stale.
+	std::vector<bool> m_alive;				//!< Whether each slot holds a live mesh.
+	std::vector<size_t> m_freeSlots;		//!< Released slots, reused last in first out.
+	size_t m_liveCount = 0;
+};
+
+#endif // MESH_POOL_HPP
@@ -0,0 +1,283 @@
+/*********************************************************************
+ * \file		PickingIndex.cpp
+ * \brief		Defines the CPU spatial index used for object picking
+ *				of sprites and UI elements.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include "PickingIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	// Twice the signed area of the triangle abc. Positive when abc is counter-clockwise.
+	float Cross(Vec2 const& a, Vec2 const& b, Vec2 const& c) {
+		return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+	}
+
+	// Points on an edge count as inside, whichever way the triangle is wound.
+	bool TriangleContains(Vec2 const& a, Vec2 const& b, Vec2 const& c, Vec2 const& point) {
+		float ab = Cross(a, b, point);
+		float bc = Cross(b, c, point);
+		float ca = Cross(c, a, point);
+		return (ab >= 0.f && bc >= 0.f && ca >= 0.f) || (ab <= 0.f && bc <= 0.f && ca <= 0.f);
+	}
+}
+
+PickingIndex::Bounds PickingIndex::Bounds::FromVertices(std::vector<Vertex> const& vertices) {
+	return FromPositions(vertices.size(), [&](size_t i) { return vertices[i].position; });
+}
+
+PickingIndex::Bounds PickingIndex::Bounds::FromTransform(std::vector<Vec3> const& modelSpacePosition, Mat4 const& modelToWorld) {
+	return FromPositions(modelSpacePosition.size(), [&](size_t i) { return modelToWorld * modelSpacePosition[i]; });
+}
+
+template <typename PositionOf>
+PickingIndex::Bounds PickingIndex::Bounds::FromPositions(size_t count, PositionOf positionOf) {
+	Bounds bounds;
+	if (count == 0) {
+		return bounds;
+	}
+
+	bounds.isQuad = count == 4;
+	for (size_t i = 0; i < count; ++i) {
+		Vec3 position = positionOf(i);
+		if (i == 0) {
+			bounds.min = Vec2(position.x, position.y);
+			bounds.max = bounds.min;
+		}
+		bounds.min.x = std::min(bounds.min.x, position.x);
+		bounds.min.y = std::min(bounds.min.y, position.y);
+		bounds.max.x = std::max(bounds.max.x, position.x);
+		bounds.max.y = std::max(bounds.max.y, position.y);
+		if (bounds.isQuad) {
+			bounds.corners[i] = Vec2(position.x, position.y);
+		}
+	}
+	return bounds;
+}
+
+bool PickingIndex::Bounds::Contains(Vec2 const& point) const {
+	if (point.x < min.x || point.x > max.x || point.y < min.y || point.y > max.y) {
+		return false;
+	}
+	if (!isQuad) {
+		return true;
+	}
+
+	// Quads are drawn as the triangles (0, 1, 2) and (2, 3, 0), see GraphicsManager::LoadQuadMesh
+	return TriangleContains(corners[0], corners[1], corners[2], point) ||
+		TriangleContains(corners[2], corners[3], corners[0], point);
+}
+
+PickingIndex::PickingIndex(float worldCellSize, float screenCellSize)
+	: invCellSize{ 1.f / worldCellSize, 1.f / screenCellSize } {
+}
+
+void PickingIndex::InsertOrUpdate(Entity entity, Space space, Bounds const& bounds, uint64_t order) {
+	CellRange range = GetCellRange(space, bounds.min, bounds.max);
+
+	auto it = proxies.find(entity);
+	if (it == proxies.end()) {
+		proxies.emplace(entity, Proxy{ bounds, order, range, space, true });
+		AddToCells(entity, space, range);
+		return;
+	}
+
+	Proxy& proxy = it->second;
+	proxy.bounds = bounds;
+	proxy.order = order;
+	proxy.touched = true;
+	// Most sprites stay within the same cells from one frame to the next.
+	if (proxy.space == space && proxy.range == range) {
+		return;
+	}
+
+	RemoveFromCells(entity, proxy.space, proxy.range);
+	AddToCells(entity, space, range);
+	proxy.space = space;
+	proxy.range = range;
+}
+
+bool PickingIndex::Touch(Entity entity, uint64_t order) {
+	auto it = proxies.find(entity);
+	if (it == proxies.end()) {
+		return false;
+	}
+	it->second.order = order;
+	it->second.touched = true;
+	return true;
+}
+
+void PickingIndex::Remove(Entity entity) {
+	auto it = proxies.find(entity);
+	if (it == proxies.end()) {
+		return;
+	}
+	RemoveFromCells(entity, it->second.space, it->second.range);
+	proxies.erase(it);
+}
+
+void PickingIndex::RemoveStale() {
+	for (auto it = proxies.begin(); it != proxies.end();) {
+		if (!it->second.touched) {
+			RemoveFromCells(it->first, it->second.space, it->second.range);
+			it = proxies.erase(it);
+		}
+		else {
+			it->second.touched = false;
+			++it;
+		}
+	}
+}
+
+void PickingIndex::Clear() {
+	for (CellMap& spaceCells : cells) {
+		spaceCells.clear();
+	}
+	proxies.clear();
+}
+
+Entity PickingIndex::PickPoint(Space space, Vec2 const& point) const {
+	CellRange range = GetCellRange(space, point, point);
+	auto cellIt = cells[space].find(GetCellKey(range.minX, range.minY));
+	if (cellIt == cells[space].end()) {
+		return NO_ENTITY;
+	}
+
+	Entity picked = NO_ENTITY;
+	uint64_t pickedOrder = 0;
+	for (Entity entity : cellIt->second) {
+		Proxy const& proxy = proxies.at(entity);
+		// Meshes with the same order are drawn in no fixed order, so break ties on the handle to stay deterministic
+		bool above = picked == NO_ENTITY || proxy.order > pickedOrder || (proxy.order == pickedOrder && entity > picked);
+		if (above && proxy.bounds.Contains(point)) {
+			picked = entity;
+			pickedOrder = proxy.order;
+		}
+	}
+	return picked;
+}
+
+void PickingIndex::PickRect(Space space, Vec2 const& min, Vec2 const& max, std::vector<Entity>& entities) const {
+	std::vector<std::pair<uint64_t, Entity>> hits;
+	CollectOverlaps(space, min, max, hits);
+
+	std::sort(hits.begin(), hits.end(), [](auto const& a, auto const& b) { return a > b; });
+	for (auto const& hit : hits) {
+		entities.push_back(hit.second);
+	}
+}
+
+void PickingIndex::QueryOrders(Space space, Vec2 const& min, Vec2 const& max, std::vector<uint64_t>& orders) const {
+	std::vector<std::pair<uint64_t, Entity>> hits;
+	CollectOverlaps(space, min, max, hits);
+
+	orders.reserve(orders.size() + hits.size());
+	for (auto const& hit : hits) {
+		orders.push_back(hit.first);
+	}
+}
+
+void PickingIndex::CollectOverlaps(Space space, Vec2 const& min, Vec2 const& max, std::vector<std::pair<uint64_t, Entity>>& hits) const {
+	Vec2 queryMin(std::min(min.x, max.x), std::min(min.y, max.y));
+	Vec2 queryMax(std::max(min.x, max.x), std::max(min.y, max.y));
+	CellRange query = GetCellRange(space, queryMin, queryMax);
+
+	auto collectCell = [&](int x, int y, std::vector<Entity> const& entries) {
+		for (Entity entity : entries) {
+			Proxy const& proxy = proxies.at(entity);
+			// An entity can span several of the queried cells. Only report it from the lowest one.
+			if (x != std::max(proxy.range.minX, query.minX) || y != std::max(proxy.range.minY, query.minY)) {
+				continue;
+			}
+			if (proxy.bounds.max.x < queryMin.x || proxy.bounds.min.x > queryMax.x ||
+				proxy.bounds.max.y < queryMin.y || proxy.bounds.min.y > queryMax.y) {
+				continue;
+			}
+			hits.emplace_back(proxy.order, entity);
+		}
+	};
+
+	// A rectangle covering more cells than are occupied, such as a zoomed out camera, walks the occupied cells instead
+	double queriedCells = (static_cast<double>(query.maxX) - query.minX + 1.0) * (static_cast<double>(query.maxY) - query.minY + 1.0);
+	if (queriedCells > static_cast<double>(cells[space].size())) {
+		for (auto const& [key, entries] : cells[space]) {
+			int x = static_cast<int>(static_cast<uint32_t>(key >> 32));
+			int y = static_cast<int>(static_cast<uint32_t>(key));
+			if (x >= query.minX && x <= query.maxX && y >= query.minY && y <= query.maxY) {
+				collectCell(x, y, entries);
+			}
+		}
+		return;
+	}
+
+	for (int x = query.minX; x <= query.maxX; ++x) {
+		for (int y = query.minY; y <= query.maxY; ++y) {
+			auto cellIt = cells[space].find(GetCellKey(x, y));
+			if (cellIt != cells[space].end()) {
+				collectCell(x, y, cellIt->second);
+			}
+		}
+	}
+}
+
+PickingIndex::CellRange PickingIndex::GetCellRange(Space space, Vec2 const& min, Vec2 const& max) const {
+	return CellRange{
+		ToCell(min.x * invCellSize[space]),
+		ToCell(min.y * invCellSize[space]),
+		ToCell(max.x * invCellSize[space]),
+		ToCell(max.y * invCellSize[space])
+	};
+}
+
+int PickingIndex::ToCell(float coordinate) {
+	// NaN fails both comparisons and ends up in cell 0.
+	float cell = std::floor(coordinate);
+	if (cell > static_cast<float>(MAX_CELL_COORD)) return MAX_CELL_COORD;
+	if (cell < static_cast<float>(-MAX_CELL_COORD)) return -MAX_CELL_COORD;
+	return cell == cell ? static_cast<int>(cell) : 0;
+}
+
+uint64_t PickingIndex::GetCellKey(int x, int y) {
+	return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+void PickingIndex::AddToCells(Entity entity, Space space, CellRange const& range) {
+	for (int x = range.minX; x <= range.maxX; ++x) {
+		for (int y = range.minY; y <= range.maxY; ++y) {
+			cells[space][GetCellKey(x, y)].push_back(entity);
+		}
+	}
+}
+
+void PickingIndex::RemoveFromCells(Entity entity, Space space, CellRange const& range) {
+	for (int x = range.minX; x <= range.maxX; ++x) {
+		for (int y = range.minY; y <= range.maxY; ++y) {
+			auto cellIt = cells[space].find(GetCellKey(x, y));
+			if (cellIt == cells[space].end()) {
+				continue;
+			}
+
+			std::vector<Entity>& entries = cellIt->second;
+			auto it = std::find(entries.begin(), entries.end(), entity);
+			if (it != entries.end()) {
+				*it = entries.back();
+				entries.pop_back();
+			}
+
+			if (entries.empty()) {
+				cells[space].erase(cellIt);
+			}
+		}
+	}
+}
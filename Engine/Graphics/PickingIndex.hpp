@@ -0,0 +1,201 @@
+/*********************************************************************
+ * \file		PickingIndex.hpp
+ * \brief		Declares the CPU spatial index used for object picking
+ *				of sprites and UI elements.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef PICKING_INDEX_HPP
+#define PICKING_INDEX_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Math.hpp"
+#include "Vec2.hpp"
+#include "Vertex.hpp"
+#include "../ECS/Entity.hpp"
+
+/**
+ * \class PickingIndex
+ * \brief Hashed uniform grids of the bounds of pickable meshes, answering point and rectangle queries.
+ *
+ * World objects are stored in world space and UI elements in normalized device coordinates, each in
+ * its own grid. Every entry carries a draw order, so a point query returns the entity drawn on top,
+ * the same one the object picking framebuffers would have shown. Entries are updated incrementally
+ * like the SpatialHashGrid: an entity that stays within the same cells costs a single lookup.
+ */
+class PickingIndex {
+public:
+	/**
+	 * \enum Space
+	 * \brief Coordinate space an entry is stored in.
+	 */
+	enum Space : uint8_t {
+		SPACE_WORLD = 0,	// Sorting layer batches, in world units
+		SPACE_SCREEN,		// UI batch, in normalized device coordinates
+
+		MAX_SPACES // This represents the total number of spaces, not an actual space
+	};
+
+	/**
+	 * \struct Bounds
+	 * \brief Bounding box of a mesh, with its corners kept for quads so rotated sprites are picked exactly.
+	 */
+	struct Bounds {
+		Vec2 min;
+		Vec2 max;
+		Vec2 corners[4];	// Corners in winding order, only set when isQuad is true.
+		bool isQuad = false;
+
+		/**
+		 * \brief Computes the bounds of a mesh from its vertices.
+		 */
+		static Bounds FromVertices(std::vector<Vertex> const& vertices);
+
+		/**
+		 * \brief Computes the bounds of a mesh from its model space positions and transform, for meshes
+		 *        whose vertices were not transformed, see Mesh::SetModelToWorld.
+		 */
+		static Bounds FromTransform(std::vector<Vec3> const& modelSpacePosition, Mat4 const& modelToWorld);
+
+		/**
+		 * \brief Checks whether a point is inside the quad, or inside the box for other meshes.
+		 */
+		bool Contains(Vec2 const& point) const;
+
+	private:
+		template <typename PositionOf>
+		static Bounds FromPositions(size_t count, PositionOf positionOf);
+	};
+
+	/**
+	 * \brief Constructs an empty index.
+	 *
+	 * \param worldCellSize Width and height of each world space cell in world units.
+	 * \param screenCellSize Width and height of each screen space cell in normalized device coordinates.
+	 */
+	explicit PickingIndex(float worldCellSize = 256.f, float screenCellSize = 0.25f);
+
+	/**
+	 * \brief Packs a batch and a position in that batch into a draw order. Higher orders are drawn on top.
+	 */
+	static uint64_t MakeOrder(size_t batchID, size_t batchPosition) {
+		return (static_cast<uint64_t>(batchID) << 32) | static_cast<uint32_t>(batchPosition);
+	}
+
+	/**
+	 * \brief Inserts an entity, or moves it if it is already in the index.
+	 *
+	 * \param entity The entity to insert.
+	 * \param space The space its bounds are in.
+	 * \param bounds Bounds of the entity's mesh.
+	 * \param order Draw order of the entity's mesh, see MakeOrder.
+	 */
+	void InsertOrUpdate(Entity entity, Space space, Bounds const& bounds, uint64_t order);
+
+	/**
+	 * \brief Keeps an entity in the index with the bounds it already has, updating only its draw order.
+	 *
+	 * Lets meshes that did not move skip computing their bounds.
+	 *
+	 * \return False if the entity is not in the index, in which case it must be inserted.
+	 */
+	bool Touch(Entity entity, uint64_t order);
+
+	/**
+	 * \brief Removes an entity from the index. Does nothing if it is not in the index.
+	 */
+	void Remove(Entity entity);
+
+	/**
+	 * \brief Removes every entity that has not been inserted or updated since the last call.
+	 *
+	 * Drops destroyed entities and hidden meshes without the caller tracking them.
+	 */
+	void RemoveStale();
+
+	/**
+	 * \brief Removes every entity from the index.
+	 */
+	void Clear();
+
+	/**
+	 * \brief Returns the topmost entity whose mesh contains a point, or NO_ENTITY.
+	 */
+	Entity PickPoint(Space space, Vec2 const& point) const;
+
+	/**
+	 * \brief Collects every entity whose bounding box overlaps a rectangle, topmost first.
+	 *
+	 * \param entities Output list. Entities are appended, so several spaces can be queried into one list.
+	 */
+	void PickRect(Space space, Vec2 const& min, Vec2 const& max, std::vector<Entity>& entities) const;
+
+	/**
+	 * \brief Collects the draw order of every entry whose bounding box overlaps a rectangle, in no particular order.
+	 *
+	 * Used to cull the sorting layer batches to the camera views, see RenderSystem::CullBatches.
+	 *
+	 * \param orders Output list. Orders are appended.
+	 */
+	void QueryOrders(Space space, Vec2 const& min, Vec2 const& max, std::vector<uint64_t>& orders) const;
+
+	size_t GetNumEntities() const { return proxies.size(); }
+
+private:
+	/**
+	 * \struct CellRange
+	 * \brief Inclusive range of cells covered by a bounding box.
+	 */
+	struct CellRange {
+		int minX, minY, maxX, maxY;
+
+		bool operator==(CellRange const& other) const {
+			return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+		}
+	};
+
+	/**
+	 * \struct Proxy
+	 * \brief Index entry of a single entity.
+	 */
+	struct Proxy {
+		Bounds bounds;
+		uint64_t order;
+		CellRange range;
+		Space space;
+		bool touched; // Set by InsertOrUpdate, cleared by RemoveStale.
+	};
+
+	using CellMap = std::unordered_map<uint64_t, std::vector<Entity>>;
+
+	/**
+	 * \brief Appends the order and entity of every entry whose bounding box overlaps a rectangle, each entry once.
+	 */
+	void CollectOverlaps(Space space, Vec2 const& min, Vec2 const& max, std::vector<std::pair<uint64_t, Entity>>& hits) const;
+
+	CellRange GetCellRange(Space space, Vec2 const& min, Vec2 const& max) const;
+	static int ToCell(float coordinate);
+	static uint64_t GetCellKey(int x, int y);
+	void AddToCells(Entity entity, Space space, CellRange const& range);
+	void RemoveFromCells(Entity entity, Space space, CellRange const& range);
+
+	float invCellSize[MAX_SPACES];					// 1 / cell size of each space, to turn positions into cell coordinates.
+	CellMap cells[MAX_SPACES];						// Entities overlapping each occupied cell, per space.
+	std::unordered_map<Entity, Proxy> proxies;		// Bounds, order and cell range of each entity in the index.
+
+	static constexpr int MAX_CELL_COORD = 1 << 20;	// Cell coordinates are clamped so stray positions cannot overflow.
+};
+
+#endif // PICKING_INDEX_HPP
@@ -18,10 +18,12 @@
  *********************************************************************/
 #include "RenderSystem.hpp"
 #include <string>
+#include <algorithm>
 
 #include "Math.hpp"
 //#include "Animation.hpp"
 #include "GraphicsManager.hpp"
+#include "TextureLoader.hpp"
 #include "../Application.hpp"
 #include "../ECS/ECSManager.hpp"
 
@@ -37,6 +39,8 @@
 
 #include "../AssetManager.hpp"
 #include "../Scene/SceneManager.hpp"
+#include "../Utility/JobSystem.hpp"
+#include "../Utility/Profiler.hpp"
 
 RenderSystem::RenderSystem()
 {
@@ -86,24 +90,27 @@ void RenderSystem::Init() {
         size_t updateInterval = 50; // Update loading bar every 20 entities.
         float incrementPerUpdate = (float)updateInterval / (float)entitiesToLoad * sm.incrementPerSystemLoaded; // How much to increase the loading bar size by each update.
         float currentPercent = (float)(sm.numSystemsLoaded) * sm.incrementPerSystemLoaded;
+
+        // Queue every texture the scene uses first, so the workers decode them while the meshes are added
+        for (auto const& entity : m_entities) {
+            auto& renderer = ECSManager::GetInstance().GetComponent<Renderer>(entity);
+            if (!renderer.isInitialized) {
+                TextureLoader::GetInstance().Request(renderer.uuid, TextureLoader::PRIORITY_SCENE);
+            }
+        }
+
         for (auto const& entity : m_entities) {
             auto& renderer = ECSManager::GetInstance().GetComponent<Renderer>(entity);
             if (!renderer.isInitialized) {
-                renderer.isInitialized = true;
-                std::pair<size_t, size_t> mesh = AddMesh(renderer.mesh, static_cast<size_t>(renderer.sortingLayer));
-                renderer.currentMeshID = mesh.first;
-                renderer.currentMeshDebugID = mesh.second;
-                SetTextureToMesh(mesh.first, renderer.uuid);
+                InitRenderer(entity, renderer);
 
                 // If there is a loading screen for the current scene,
                 // Set all the entities to invisible first so that only the loading screen is visible when loading.
                 if (sm.useLoadingScreen ||
                     (!sm.useLoadingScreen && !ECSManager::GetInstance().GetEntityManager().GetActive(entity)))
                 {
-                    SetVisibility(mesh.first, false);
+                    SetVisibility(renderer.currentMeshID, false);
                 }
-
-                SetColorToEntity(entity, EncodeColor(entity));
             }
 
             // Update the loading screen.
@@ -113,6 +120,9 @@ void RenderSystem::Init() {
             }
         }
 
+        // The scene starts with all its textures, the placeholders are only for textures requested later
+        TextureLoader::GetInstance().Flush(TextureLoader::PRIORITY_SCENE);
+
         for (auto& batch : GraphicsManager::GetInstance().batches) {
             // On init, sort the batches
             GraphicsManager::GetInstance().SortBatch(batch);
@@ -122,14 +132,9 @@ void RenderSystem::Init() {
         for (auto const& entity : sm.loadingScreenEntities) {
             auto& renderer = ECSManager::GetInstance().GetComponent<Renderer>(entity);
             if (!renderer.isInitialized) {
-                renderer.isInitialized = true;
-                std::pair<size_t, size_t> mesh = AddMesh(renderer.mesh, static_cast<size_t>(renderer.sortingLayer));
-                renderer.currentMeshID = mesh.first;
-                renderer.currentMeshDebugID = mesh.second;
-                SetTextureToMesh(mesh.first, renderer.uuid);
+                InitRenderer(entity, renderer);
                 if (!ECSManager::GetInstance().GetEntityManager().GetActive(entity))
-                    SetVisibility(mesh.first, false);
-                SetColorToEntity(entity, EncodeColor(entity));
+                    SetVisibility(renderer.currentMeshID, false);
             }
         }
 
@@ -148,21 +153,39 @@ void RenderSystem::UpdateEntitiesVisibility() {
 
 void RenderSystem::Update()
 {
+    PROFILE_SCOPE("RenderSystem::Update");
     // References for easy readability
     auto& graphicsManager = GraphicsManager::GetInstance();
     auto& ecsManager = ECSManager::GetInstance();
 
     SceneManager& sm = SceneManager::GetInstance();
-    std::set<Entity> entities = m_entities;
-    // If scene manager is still loading the current scene
+
+    // Upload the textures decoded since the last frame, before the batches are packed
+    TextureLoader::GetInstance().Update();
+
+    // Gather the renderers to update this frame
+    m_updateList.clear();
     if (sm.isLoading) {
-        entities = sm.loadingScreenEntities;
+        // If scene manager is still loading the current scene, only update the loading screen
+        for (auto const& entity : sm.loadingScreenEntities) {
+            auto renderer = ecsManager.TryGetComponent<Renderer>(entity);
+            if (renderer.has_value()) m_updateList.push_back({ entity, &renderer->get(), false });
+        }
+    }
+    else {
+        ecsManager.GetView<Renderer>().ForEach([this](Entity entity, Renderer& renderer) {
+            m_updateList.push_back({ entity, &renderer, false });
+        });
     }
 
-    for (auto const& entity : entities) {
+    // Transform the mesh vertices of world objects into world space.
+    // Each renderer owns its mesh, so the chunks can be processed in parallel.
+    JobSystem::GetInstance().ParallelFor(m_updateList.size(), VERTEX_UPDATE_CHUNK_SIZE, [&](size_t begin, size_t end) {
+        for (size_t index = begin; index < end; ++index) {
+            auto& [entity, rendererPtr, meshUpdated, meshMoved, pickable, hasBounds, bounds] = m_updateList[index];
+            Renderer& renderer = *rendererPtr;
+            if (!renderer.isInitialized) continue;
 
-        auto& renderer = ecsManager.GetComponent<Renderer>(entity);
-        if (renderer.isInitialized) {
             auto transform0pt = ecsManager.TryGetComponent<Transform>(entity);
             auto ui0pt = ecsManager.TryGetComponent<UI>(entity);
 
@@ -171,46 +194,85 @@ void RenderSystem::Update()
             if (transform0pt.has_value() && !ui0pt.has_value()) {
                 auto& transform = transform0pt->get(); // Reference to improve readability
                 if (renderer.isDirty || renderer.isAnimated) { // Only update the mesh if the transform component has been updated
-                    if (graphicsManager.meshes[renderer.currentMeshID].vertices.size() == graphicsManager.meshes[renderer.currentMeshID].modelSpacePosition.size()) {
-                        for (size_t i = 0; i < graphicsManager.meshes[renderer.currentMeshID].vertices.size(); ++i) {
-                            graphicsManager.meshes[renderer.currentMeshID].vertices[i].position =
-                                transform.modelToWorldMtx * graphicsManager.meshes[renderer.currentMeshID].modelSpacePosition[i];
-                        }
-                        graphicsManager.SetBatchUpdateFlag(renderer.currentMeshID, false);
+                    auto& mesh = graphicsManager.meshes[renderer.currentMeshID];
+                    if (mesh.vertices.size() == mesh.modelSpacePosition.size()) {
+                        // Instances are placed from the transform itself, so their vertices are only transformed when read
+                        mesh.SetModelToWorld(transform.modelToWorldMtx);
+                        meshMoved = graphicsManager.IsDrawnInstanced(renderer.currentMeshID);
+                        if (!meshMoved) mesh.UpdatePositions();
                         transform.updated = false; // Reset the updated flag
                     }
-                    graphicsManager.SetBatchUpdateFlag(renderer.currentMeshID, false);
                     renderer.isDirty = false;
-                    //transform.updated = false; // Reset the updated flag
+                    meshUpdated = !meshMoved;
                 }
             }
 
-            if (graphicsManager.debugMode) {
-                graphicsManager.RefreshMeshCollision(renderer.currentMeshID, renderer.currentMeshDebugID, entity);
+            // Picking bounds are taken after the transform so they match what is drawn this frame.
+            // Instances that did not move keep the bounds already in the picking index.
+            pickable = IsPickable(renderer.currentMeshID);
+            if (pickable) {
+                Mesh const& mesh = graphicsManager.meshes[renderer.currentMeshID];
+                if (!mesh.arePositionsStale) {
+                    bounds = PickingIndex::Bounds::FromVertices(mesh.vertices);
+                    hasBounds = true;
+                }
+                else if (meshMoved) {
+                    bounds = PickingIndex::Bounds::FromTransform(mesh.modelSpacePosition, mesh.modelToWorld);
+                    hasBounds = true;
+                }
             }
+        }
+    });
 
-            // If the renderer's sorting layer was changed
-            if (renderer.sortingLayerChanged) {
-                renderer.sortingLayerChanged = false;
-                // Move the renderer's mesh from the previous sorting layer batch to the current sorting layer batch.
-                graphicsManager.RemoveFromBatch(static_cast<GraphicsManager::BatchIndex>(renderer.prevSortingLayer), renderer.currentMeshID);
-                graphicsManager.AddToBatch(static_cast<GraphicsManager::BatchIndex>(renderer.sortingLayer), renderer.currentMeshID);
-            }
+    // Batch bookkeeping touches shared state, so it stays on this thread
+    for (auto const& update : m_updateList) {
+        Entity entity = update.entity;
+        Renderer& renderer = *update.renderer;
+        if (!renderer.isInitialized) continue;
+
+        if (update.meshUpdated) {
+            graphicsManager.SetBatchUpdateFlag(renderer.currentMeshID, false);
+        }
+        else if (update.meshMoved) {
+            graphicsManager.SetMeshMovedFlag(renderer.currentMeshID);
+        }
+
+        if (graphicsManager.debugMode) {
+            graphicsManager.RefreshMeshCollision(renderer.currentMeshID, renderer.currentMeshDebugID, entity);
+        }
+
+        // If the renderer's sorting layer was changed
+        if (renderer.sortingLayerChanged) {
+            renderer.sortingLayerChanged = false;
+            // Move the renderer's mesh from the previous sorting layer batch to the current sorting layer batch.
+            graphicsManager.RemoveFromBatch(static_cast<GraphicsManager::BatchIndex>(renderer.prevSortingLayer), renderer.currentMeshID);
+            graphicsManager.AddToBatch(static_cast<GraphicsManager::BatchIndex>(renderer.sortingLayer), renderer.currentMeshID);
         }
     }
 
-    // Sort the batches if they are not sorted
-    for (auto& batch : graphicsManager.batches) {
-        
+    // Meshes are released along with their entity in OnEntityDestroyed, so this only trims the pool
+    if (!sm.isLoading && ++m_framesSinceMeshCheck >= MESH_CHECK_INTERVAL) {
+        m_framesSinceMeshCheck = 0;
+#ifndef NDEBUG
+        CheckUnownedMeshes();
+#endif
+        graphicsManager.meshes.Compact();
+    }
+    PROFILE_COUNTER("Meshes Live", static_cast<double>(graphicsManager.meshes.GetLiveCount()));
+    PROFILE_COUNTER("Meshes Dead", static_cast<double>(graphicsManager.meshes.GetDeadCount()));
 
+    // Sort the batches if they are not sorted, otherwise rebuild or patch only what changed
+    BatchData::ResetUploadStats();
+    for (auto& batch : graphicsManager.batches) {
         if (!batch.isSorted) graphicsManager.SortBatch(batch);
         if (!batch.isUpdated) graphicsManager.UpdateBatch(batch);
-
-        if (batch.id == GraphicsManager::BatchIndex::UI_TEXT_BATCH) {
-            std::cout << "";
-            batch.UpdateBuffers();
-        }
+        else graphicsManager.PatchBatch(batch);
     }
+    PROFILE_COUNTER("Batch Upload Bytes", static_cast<double>(BatchData::GetUploadedBytes()));
+
+    // After sorting, so the draw order of each entry is current
+    UpdatePickingIndex();
+    CullBatches();
 
     graphicsManager.Render();
 } 
@@ -220,10 +282,198 @@ void RenderSystem::Exit() {
 		batch.isSorted = false;
         batch.isUpdated = false;
 	}
+    m_pickingIndex.Clear();
+    m_meshesAwaitingTexture.clear();
+    m_awaitedTexture.clear();
     GraphicsManager::GetInstance().Exit();
     isGMInitialized = false;
 }
 
+void RenderSystem::InitRenderer(Entity entity, Renderer& renderer)
+{
+    renderer.isInitialized = true;
+    std::pair<size_t, size_t> mesh = AddMesh(renderer.mesh, static_cast<size_t>(renderer.sortingLayer));
+    renderer.currentMeshID = mesh.first;
+    renderer.currentMeshDebugID = mesh.second;
+    SetTextureToMesh(mesh.first, renderer.uuid);
+    SetColorToEntity(entity, EncodeColor(entity));
+}
+
+void RenderSystem::OnEntityDestroyed(Entity entity)
+{
+    auto& ecsManager = ECSManager::GetInstance();
+    if (auto renderer = ecsManager.TryGetComponent<Renderer>(entity)) {
+        ReleaseMeshes(renderer->get());
+    }
+
+    if (auto textbox = ecsManager.TryGetComponent<Textbox>(entity)) {
+        auto& graphicsManager = GraphicsManager::GetInstance();
+        for (MeshHandle handle : textbox->get().meshHandles) {
+            if (graphicsManager.meshes.IsValid(handle)) graphicsManager.ReleaseMesh(handle.index);
+        }
+        textbox->get().meshHandles.clear();
+    }
+}
+
+void RenderSystem::ReleaseMeshes(Renderer& renderer)
+{
+    // Renderers that were never initialized have not been given meshes of their own
+    if (!renderer.isInitialized) return;
+
+    auto& graphicsManager = GraphicsManager::GetInstance();
+    graphicsManager.ReleaseMesh(renderer.currentMeshID);
+    graphicsManager.ReleaseMesh(renderer.currentMeshDebugID);
+    m_awaitedTexture.erase(renderer.currentMeshID);
+    renderer.isInitialized = false;
+}
+
+void RenderSystem::CheckUnownedMeshes()
+{
+    PROFILE_SCOPE("RenderSystem::CheckUnownedMeshes");
+    auto& graphicsManager = GraphicsManager::GetInstance();
+    auto& ecsManager = ECSManager::GetInstance();
+
+    m_meshInUse.assign(graphicsManager.meshes.size(), false);
+    auto markInUse = [this](size_t meshID) {
+        if (meshID < m_meshInUse.size()) m_meshInUse[meshID] = true;
+    };
+
+    // Only initialized renderers own their meshes, the same rule ReleaseMeshes follows
+    ecsManager.GetView<Renderer>().ForEach([&markInUse](Entity, Renderer& renderer) {
+        if (!renderer.isInitialized) return;
+        markInUse(renderer.currentMeshID);
+        markInUse(renderer.currentMeshDebugID);
+    });
+    ecsManager.GetView<Textbox>().ForEach([&markInUse, &graphicsManager](Entity, Textbox& textbox) {
+        for (MeshHandle handle : textbox.meshHandles) {
+            if (graphicsManager.meshes.IsValid(handle)) markInUse(handle.index);
+        }
+    });
+
+    size_t released = 0;
+    for (size_t meshID = 0; meshID < m_meshInUse.size(); ++meshID) {
+        if (!m_meshInUse[meshID] && graphicsManager.meshes.IsAlive(meshID)) {
+            graphicsManager.ReleaseMesh(meshID);
+            ++released;
+        }
+    }
+
+    if (released > 0) {
+        Logger::Instance().Log(Logger::Level::WARN, "[RenderSystem] CheckUnownedMeshes: ", released,
+            " meshes had no renderer or textbox and were released, ", graphicsManager.meshes.GetLiveCount(), " live");
+    }
+}
+
+bool RenderSystem::IsPickable(size_t meshID) const
+{
+    auto& graphicsManager = GraphicsManager::GetInstance();
+    if (!graphicsManager.meshes.IsAlive(meshID)) return false;
+
+    // Only the batches the object picking passes drew can be picked
+    Mesh const& mesh = graphicsManager.meshes[meshID];
+    bool pickedBatch = mesh.batchID <= GraphicsManager::BatchIndex::LAST_SRTG_LAYER ||
+        mesh.batchID == GraphicsManager::BatchIndex::UI_TEXTURE_BATCH;
+    return pickedBatch && !mesh.vertices.empty() && mesh.vertices[0].visible;
+}
+
+void RenderSystem::UpdatePickingIndex()
+{
+    PROFILE_SCOPE("RenderSystem::UpdatePickingIndex");
+    auto& graphicsManager = GraphicsManager::GetInstance();
+
+    for (auto const& update : m_updateList) {
+        if (!update.renderer->isInitialized || !update.pickable) continue;
+
+        Mesh const& mesh = graphicsManager.meshes[update.renderer->currentMeshID];
+        PickingIndex::Space space = mesh.batchID == GraphicsManager::BatchIndex::UI_TEXTURE_BATCH ?
+            PickingIndex::SPACE_SCREEN : PickingIndex::SPACE_WORLD;
+        uint64_t order = PickingIndex::MakeOrder(mesh.batchID, mesh.batchPosition);
+        if (update.hasBounds) {
+            m_pickingIndex.InsertOrUpdate(update.entity, space, update.bounds, order);
+        }
+        else if (!m_pickingIndex.Touch(update.entity, order)) {
+            m_pickingIndex.InsertOrUpdate(update.entity, space,
+                PickingIndex::Bounds::FromTransform(mesh.modelSpacePosition, mesh.modelToWorld), order);
+        }
+    }
+    // Entities that were destroyed, hidden or not updated this frame can no longer be picked
+    m_pickingIndex.RemoveStale();
+}
+
+void RenderSystem::CullBatches()
+{
+    PROFILE_SCOPE("RenderSystem::CullBatches");
+    auto& graphicsManager = GraphicsManager::GetInstance();
+    if (!graphicsManager.viewCulling || graphicsManager.batches.size() < CULLED_BATCHES) return;
+
+    size_t total = 0;
+    for (size_t k = 0; k < CULLED_BATCHES; ++k) {
+        m_cullStates[k].assign(graphicsManager.batches[k].meshIDs.size(), CULL_NEVER);
+        total += m_cullStates[k].size();
+    }
+    for (auto const& update : m_updateList) {
+        size_t meshID = update.renderer->currentMeshID;
+        if (!update.renderer->isInitialized || !graphicsManager.meshes.IsAlive(meshID)) continue;
+
+        Mesh const& mesh = graphicsManager.meshes[meshID];
+        if (mesh.batchID >= CULLED_BATCHES || mesh.batchPosition >= m_cullStates[mesh.batchID].size()) continue;
+        // Every visible sprite is pickable, so the meshes left out of the index are the hidden ones
+        m_cullStates[mesh.batchID][mesh.batchPosition] = update.pickable ? CULL_OUTSIDE_VIEW : CULL_ALWAYS;
+    }
+
+    auto cullView = [&](GraphicsManager::CameraSlot slot) {
+        Vec2 viewMin, viewMax;
+        graphicsManager.GetViewBounds(slot, viewMin, viewMax);
+        m_visibleOrders.clear();
+        m_pickingIndex.QueryOrders(PickingIndex::SPACE_WORLD, viewMin, viewMax, m_visibleOrders);
+
+        for (size_t k = 0; k < CULLED_BATCHES; ++k) {
+            m_inView[k].assign(m_cullStates[k].size(), 0);
+        }
+        for (uint64_t order : m_visibleOrders) {
+            size_t batchID = static_cast<size_t>(order >> 32);
+            size_t batchPosition = static_cast<size_t>(order & 0xFFFFFFFFu);
+            if (batchID < CULLED_BATCHES && batchPosition < m_inView[batchID].size()) {
+                m_inView[batchID][batchPosition] = 1;
+            }
+        }
+
+        size_t drawn = 0;
+        for (size_t k = 0; k < CULLED_BATCHES; ++k) {
+            drawn += BuildDrawRanges(m_cullStates[k], m_inView[k], graphicsManager.drawRanges[slot][k]);
+        }
+        graphicsManager.hasDrawRanges[slot] = true;
+        return drawn;
+    };
+
+    size_t drawn = cullView(GraphicsManager::CameraSlot::CAMERA_GAME);
+    PROFILE_COUNTER("Sprites Drawn", static_cast<double>(drawn));
+    PROFILE_COUNTER("Sprites Culled", static_cast<double>(total - drawn));
+#ifndef INSTALLER
+    cullView(GraphicsManager::CameraSlot::CAMERA_ENGINE);
+#endif
+}
+
+size_t RenderSystem::BuildDrawRanges(std::vector<uint8_t> const& cullStates, std::vector<uint8_t> const& inView, std::vector<BatchData::DrawRange>& ranges)
+{
+    ranges.clear();
+    size_t drawn = 0;
+    for (size_t position = 0; position < cullStates.size(); ++position) {
+        bool draw = cullStates[position] == CULL_NEVER || (cullStates[position] == CULL_OUTSIDE_VIEW && inView[position]);
+        if (!draw) continue;
+
+        // Neighbouring meshes in draw order join the same run
+        if (!ranges.empty() && ranges.back().first + ranges.back().count == position) {
+            ++ranges.back().count;
+        }
+        else {
+            ranges.push_back({ position, 1 });
+        }
+        ++drawn;
+    }
+    return drawn;
+}
+
 std::pair<size_t, size_t> RenderSystem::AddMesh(MeshType mtype, std::string const& path, std::vector<Vertex> const& vertices)
 {
     // This function returns the ID of the main mesh and the ID of the collision box mesh respectively
@@ -333,35 +583,74 @@ void RenderSystem::SetTextureToMesh(size_t meshID, std::string texID)
     //    static_cast<int>(GraphicsManager::GetInstance().textures[texID].texLayerIndex)
     //);
 
-    if (meshID >= GraphicsManager::GetInstance().meshes.size()) {
+    auto& graphicsManager = GraphicsManager::GetInstance();
+    if (!graphicsManager.meshes.IsAlive(meshID)) {
         //Logger::Instance().Log(Logger::Level::ERR, "[RenderSystem] SetTextureToMesh: Invalid mesh or texture ID");
         return;
     }
 
-	int texArrayIndex = AssetManager::GetInstance().Get<Texture>(texID) == nullptr ?
-		-1 : static_cast<int>(AssetManager::GetInstance().Get<Texture>(texID)->texArrayIndex);
+    std::shared_ptr<Texture> texture = TextureLoader::GetInstance().Request(texID);
+    m_awaitedTexture.erase(meshID);
+    if (texture == nullptr || texture->isLoaded) {
+        ApplyTexture(meshID, texture.get());
+        return;
+    }
 
-	int texLayerIndex = AssetManager::GetInstance().Get<Texture>(texID) == nullptr ?
-		-1 : static_cast<int>(AssetManager::GetInstance().Get<Texture>(texID)->texLayerIndex);
+    // Swapping textures keeps showing the old one until the new one is uploaded, a mesh without one shows the placeholder
+    Mesh const& mesh = graphicsManager.meshes[meshID];
+    if (mesh.vertices.empty() || mesh.vertices[0].texArray < 0) {
+        ApplyTexture(meshID, texture.get());
+    }
 
-    GraphicsManager::GetInstance().SetTextureToMesh(
-        meshID, 
-        texArrayIndex,
-        texLayerIndex
-    );
+    auto& awaiting = m_meshesAwaitingTexture[texID];
+    if (awaiting.empty()) {
+        TextureLoader::GetInstance().Request(texID, TextureLoader::PRIORITY_NORMAL,
+            [this](std::string const& uuid, std::shared_ptr<Texture> const& loaded) { OnTextureLoaded(uuid, loaded); });
+    }
+    awaiting.push_back(graphicsManager.meshes.GetHandle(meshID));
+    m_awaitedTexture[meshID] = texID;
 }
 
 void RenderSystem::SetTextureToEntity(Entity entity, std::string texID)
 {
-    if (AssetManager::GetInstance().Get<Texture>(texID) == nullptr) return;
+    if (TextureLoader::GetInstance().Request(texID) == nullptr) return;
     auto& renderer = ECSManager::GetInstance().GetComponent<Renderer>(entity);
     SetTextureToMesh(renderer.currentMeshID, texID);
     renderer.uuid = texID;
 }
 
+void RenderSystem::ApplyTexture(size_t meshID, Texture const* texture)
+{
+    // Texture coordinates stay in the image's own [0, 1] range, packing clips them to what was stored and maps them into its atlas region
+    GraphicsManager::GetInstance().SetTextureToMesh(
+        meshID,
+        texture == nullptr ? -1 : static_cast<int>(texture->texArrayIndex),
+        texture == nullptr ? -1 : static_cast<int>(texture->texLayerIndex),
+        texture == nullptr ? Vec4(0.f, 0.f, 1.f, 1.f) : texture->texRect,
+        texture == nullptr ? Vec4(0.f, 0.f, 1.f, 1.f) : texture->contentRect
+    );
+}
+
+void RenderSystem::OnTextureLoaded(std::string const& uuid, std::shared_ptr<Texture> const& texture)
+{
+    auto awaiting = m_meshesAwaitingTexture.find(uuid);
+    if (awaiting == m_meshesAwaitingTexture.end()) return;
+
+    // Meshes released since, or given another texture since, are left alone
+    auto& meshes = GraphicsManager::GetInstance().meshes;
+    for (MeshHandle const& handle : awaiting->second) {
+        auto awaited = m_awaitedTexture.find(handle.index);
+        if (!meshes.IsValid(handle) || awaited == m_awaitedTexture.end() || awaited->second != uuid) continue;
+
+        ApplyTexture(handle.index, texture.get());
+        m_awaitedTexture.erase(awaited);
+    }
+    m_meshesAwaitingTexture.erase(awaiting);
+}
+
 void RenderSystem::SetColorToMesh(size_t const& meshID, Vec4 color) 
 {
-    if (meshID >= GraphicsManager::GetInstance().meshes.size()) return;
+    if (!GraphicsManager::GetInstance().meshes.IsAlive(meshID)) return;
     GraphicsManager::GetInstance().SetColorToMesh(meshID, color);
 }
 
@@ -378,7 +667,7 @@ void RenderSystem::SetDebugMode(bool val)
 
 void RenderSystem::SetVisibility(size_t const& meshID, bool val)
 {
-	if (meshID >= GraphicsManager::GetInstance().meshes.size()) {
+	if (!GraphicsManager::GetInstance().meshes.IsAlive(meshID)) {
 		std::cout << "Invalid mesh ID" << std::endl;
 		return;
 	}
@@ -416,6 +705,9 @@ void RenderSystem::LoadFont(std::string const& path)
 
 Vec4 RenderSystem::EncodeColor(Entity entity) 
 {
+    // Only the slot index fits in 24 bits; DecodeColor resolves it back to the live handle.
+    entity = EntityIndex(entity);
+
     unsigned char r = static_cast<unsigned char>((entity & 0xFF0000) >> 16);
     unsigned char g = static_cast<unsigned char>((entity & 0x00FF00) >> 8);
     unsigned char b = static_cast<unsigned char>(entity & 0x0000FF);
@@ -429,23 +721,112 @@ Entity RenderSystem::DecodeColor(Vec4 color)
 	unsigned char g = static_cast<unsigned char>(color.g * 255);
 	unsigned char b = static_cast<unsigned char>(color.b * 255);
 
-	return (r << 16) | (g << 8) | b;
+	return ECSManager::GetInstance().GetEntityManager().GetEntity((r << 16) | (g << 8) | b);
 }
 
 Entity RenderSystem::GetClickedEntity(int fbo) 
+{
+    int mouseX = static_cast<int>(InputManager::GetInstance().GetMouseX());
+    int mouseY = static_cast<int>(InputManager::GetInstance().GetMouseY());
+
+    return GetEntityAt(fbo, mouseX, mouseY);
+}
+
+Entity RenderSystem::GetEntityAt(int fbo, int mouseX, int mouseY)
 {
     auto& graphicsManager = GraphicsManager::GetInstance();
 
-	if (fbo >= graphicsManager.frameBuffers.size()) {
-		return static_cast<Entity>(-1);
+	if (fbo < 0 || static_cast<size_t>(fbo) >= graphicsManager.frameBuffers.size()) {
+		return NO_ENTITY;
 	}
 
-    int mouseX = static_cast<int>(InputManager::GetInstance().GetMouseX());
-    int mouseY = static_cast<int>(InputManager::GetInstance().GetMouseY());
+    // Read back the object picking framebuffer when pixel exact picking is on, or for framebuffers the index does not cover
+    if (graphicsManager.pixelPicking || !IsPickingFrameBuffer(fbo)) {
+        Vec4 pixelColor = graphicsManager.GetPixelColor(
+            graphicsManager.frameBuffers[fbo], mouseX, mouseY);
+        return DecodeColor(pixelColor);
+    }
 
-	// Note: Currently picks from engine's OBJ_PICKING_ENGINE frame buffer
-    Vec4 pixelColor = graphicsManager.GetPixelColor(
-        graphicsManager.frameBuffers[fbo], mouseX, mouseY);
+    // UI is drawn over the world in every picking framebuffer
+    Vec2 screenPoint = WindowToScreen(mouseX, mouseY);
+    Entity picked = m_pickingIndex.PickPoint(PickingIndex::SPACE_SCREEN, screenPoint);
+    if (picked != NO_ENTITY || fbo == GraphicsManager::FrameBufferIndex::OBJ_PICKING_UI) {
+        return picked;
+    }
+
+    return m_pickingIndex.PickPoint(PickingIndex::SPACE_WORLD, ScreenToWorld(fbo, screenPoint));
+}
+
+void RenderSystem::GetEntitiesInRect(int fbo, int x0, int y0, int x1, int y1, std::vector<Entity>& entities)
+{
+    entities.clear();
+    if (!IsPickingFrameBuffer(fbo)) return;
+
+    Vec2 screenMin = WindowToScreen(x0, y0);
+    Vec2 screenMax = WindowToScreen(x1, y1);
+    m_pickingIndex.PickRect(PickingIndex::SPACE_SCREEN, screenMin, screenMax, entities);
+    if (fbo == GraphicsManager::FrameBufferIndex::OBJ_PICKING_UI) return;
+
+    // Cover the whole rectangle even if the camera is rotated
+    Vec2 corners[4] = {
+        ScreenToWorld(fbo, screenMin),
+        ScreenToWorld(fbo, Vec2(screenMax.x, screenMin.y)),
+        ScreenToWorld(fbo, screenMax),
+        ScreenToWorld(fbo, Vec2(screenMin.x, screenMax.y))
+    };
+    Vec2 worldMin = corners[0], worldMax = corners[0];
+    for (Vec2 const& corner : corners) {
+        worldMin = Vec2(std::min(worldMin.x, corner.x), std::min(worldMin.y, corner.y));
+        worldMax = Vec2(std::max(worldMax.x, corner.x), std::max(worldMax.y, corner.y));
+    }
+    m_pickingIndex.PickRect(PickingIndex::SPACE_WORLD, worldMin, worldMax, entities);
+}
+
+void RenderSystem::SetPixelPicking(bool val)
+{
+    GraphicsManager::GetInstance().pixelPicking = val;
+}
+
+void RenderSystem::SetSpriteInstancing(bool val)
+{
+    auto& graphicsManager = GraphicsManager::GetInstance();
+    if (graphicsManager.spriteInstancing == val) return;
+
+    graphicsManager.spriteInstancing = val;
+    for (auto& batch : graphicsManager.batches) {
+        batch.isUpdated = false;
+    }
+}
+
+void RenderSystem::SetViewCulling(bool val)
+{
+    GraphicsManager::GetInstance().viewCulling = val;
+}
+
+bool RenderSystem::IsPickingFrameBuffer(int fbo)
+{
+    return fbo == GraphicsManager::FrameBufferIndex::OBJ_PICKING_ENGINE ||
+        fbo == GraphicsManager::FrameBufferIndex::OBJ_PICKING_GAME ||
+        fbo == GraphicsManager::FrameBufferIndex::OBJ_PICKING_UI;
+}
+
+Vec2 RenderSystem::WindowToScreen(int mouseX, int mouseY)
+{
+    // Same mapping as GetPixelColor, ending in normalized device coordinates instead of framebuffer pixels
+    auto [appWidth, appHeight] = Application::GetWindowSize();
+    float x = static_cast<float>(mouseX) / static_cast<float>(appWidth);
+    float y = static_cast<float>(appHeight - mouseY) / static_cast<float>(appHeight);
+    return Vec2(x * 2.f - 1.f, y * 2.f - 1.f);
+}
+
+Vec2 RenderSystem::ScreenToWorld(int fbo, Vec2 const& screenPoint)
+{
+    auto& graphicsManager = GraphicsManager::GetInstance();
+    glm::mat4 viewProjection = fbo == GraphicsManager::FrameBufferIndex::OBJ_PICKING_ENGINE ?
+        graphicsManager.GetProjectionMatrixEngine() * graphicsManager.GetViewMatrixEngine() :
+        graphicsManager.GetProjectionMatrixGame() * graphicsManager.GetViewMatrixGame();
 
-    return DecodeColor(pixelColor);
+    glm::vec4 world = glm::inverse(viewProjection) * glm::vec4(screenPoint.x, screenPoint.y, 0.f, 1.f);
+    if (world.w != 0.f) world /= world.w;
+    return Vec2(world.x, world.y);
 }
@@ -28,8 +28,10 @@
 #include "../ECS/System.hpp"
 
 #include "GraphicsManager.hpp"
+#include "PickingIndex.hpp"
 
 class Mesh;
+class Texture;
 struct Vec2;
 struct Vertex;
 struct Mat4;
@@ -94,6 +96,18 @@ public:
 	 * Cleans up resources and prepares for shutdown.
 	 */
 	void Exit();
+	/*!
+	 * \brief Gives a renderer already added to the entity meshes of its own, textured and coloured for picking.
+	 */
+	void InitRenderer(Entity entity, Renderer& renderer);
+	/*!
+	 * \brief Releases the meshes of the entity's renderer and textbox.
+	 */
+	void OnEntityDestroyed(Entity entity) override;
+	/*!
+	 * \brief Releases the meshes a renderer owns, for a renderer removed from an entity that stays alive.
+	 */
+	void ReleaseMeshes(Renderer& renderer);
 
 	// Mesh management
 	/*!
@@ -248,8 +262,150 @@ public:
 	* \param fbo The framebuffer object to read from. (See FrameBufferIndex for options)
 	*/
 	Entity GetClickedEntity(int fbo = 1);
+
+	/*!
+	* \brief Retrieves the topmost entity at a position in the window.
+	*
+	* The object picking framebuffers are answered from the picking index, unless
+	* pixel picking is on. Other framebuffers are read back directly.
+	*
+	* \param fbo The object picking framebuffer to pick from. (See FrameBufferIndex for options)
+	* \param mouseX The x-coordinate in the window, in pixels.
+	* \param mouseY The y-coordinate in the window, in pixels, from the top.
+	* \return The entity at the position, or NO_ENTITY.
+	*/
+	Entity GetEntityAt(int fbo, int mouseX, int mouseY);
+
+	/*!
+	* \brief Retrieves every entity whose bounds overlap a rectangle in the window, for marquee selection.
+	*
+	* \param fbo The object picking framebuffer to pick from. (See FrameBufferIndex for options)
+	* \param x0, y0 One corner of the rectangle in the window, in pixels.
+	* \param x1, y1 The opposite corner of the rectangle in the window, in pixels.
+	* \param entities Output list, topmost first with UI before the world. Cleared before use.
+	*/
+	void GetEntitiesInRect(int fbo, int x0, int y0, int x1, int y1, std::vector<Entity>& entities);
+
+	/*!
+	* \brief Enables or disables pixel exact picking through the object picking framebuffers.
+	*
+	* The framebuffers are only drawn while it is enabled.
+	*
+	* \param val True to read picks back from the framebuffers; false to use the picking index.
+	*/
+	void SetPixelPicking(bool val);
+
+	/*!
+	* \brief Enables or disables drawing sprite batches as instances.
+	*
+	* Every batch is rebuilt in the new layout on the next update.
+	*
+	* \param val True to draw sorting layer batches made only of sprites as instances; false to always draw vertices.
+	*/
+	void SetSpriteInstancing(bool val);
+
+	/*!
+	* \brief Enables or disables view culling of the sorting layer batches.
+	*
+	* \param val True to draw only the sprites inside the camera views; false to draw every sprite.
+	*/
+	void SetViewCulling(bool val);
 	
 private:
 	bool paused = false; // Tracks if the system is paused
 	bool isGMInitialized = false; // Tracks if the Graphics Manager has been initialized.
+
+	// Renderer processed in the current frame's update
+	struct RendererUpdate {
+		Entity entity;
+		Renderer* renderer;
+		bool meshUpdated; // Set when the mesh vertices were rewritten and the batch needs refreshing
+		bool meshMoved = false; // Set when only the mesh's transform was stored, for an instanced sprite
+		bool pickable = false; // Set when the mesh is visible in a batch the picking passes draw
+		bool hasBounds = false; // Set when bounds was computed, unset for instances that did not move
+		PickingIndex::Bounds bounds{}; // Bounds of the mesh this frame, only set when hasBounds
+	};
+	std::vector<RendererUpdate> m_updateList; // Reused every frame to avoid reallocating
+	static constexpr size_t VERTEX_UPDATE_CHUNK_SIZE = 256; // Renderers per vertex transform job
+
+	/*!
+	* \brief Debug check that every live mesh is owned by a renderer or textbox. Meshes that are
+	*        not were missed when their owner went away; they are reported and released.
+	*/
+	void CheckUnownedMeshes();
+
+	/*!
+	* \brief Checks whether a mesh is visible in one of the batches the object picking passes draw.
+	*/
+	bool IsPickable(size_t meshID) const;
+
+	/*!
+	* \brief Moves the renderers gathered this frame into the picking index and drops the ones that were not.
+	*/
+	void UpdatePickingIndex();
+
+	/*!
+	* \brief Fills the GraphicsManager's draw ranges with the sorting layer meshes inside each camera view.
+	*
+	* The picking index doubles as the bounds index: it already holds the world space bounds of every
+	* visible sprite, taken from this frame's transforms, with the draw order of its mesh. Meshes no
+	* renderer updated this frame are always drawn, and hidden meshes never are.
+	*/
+	void CullBatches();
+
+	/*!
+	* \brief Turns the meshes to draw in a batch into runs of consecutive meshes.
+	*
+	* \return Number of meshes to draw.
+	*/
+	static size_t BuildDrawRanges(std::vector<uint8_t> const& cullStates, std::vector<uint8_t> const& inView, std::vector<BatchData::DrawRange>& ranges);
+
+	/*!
+	* \brief Checks whether a framebuffer is one of the object picking framebuffers.
+	*/
+	static bool IsPickingFrameBuffer(int fbo);
+
+	/*!
+	* \brief Converts a position in the window to normalized device coordinates.
+	*/
+	static Vec2 WindowToScreen(int mouseX, int mouseY);
+
+	/*!
+	* \brief Converts normalized device coordinates to world space through the camera of a picking framebuffer.
+	*/
+	static Vec2 ScreenToWorld(int fbo, Vec2 const& screenPoint);
+
+	PickingIndex m_pickingIndex; // Bounds of every pickable sprite and UI element
+
+	/*!
+	* \enum CullState
+	* \brief How CullBatches treats a mesh in a sorting layer batch.
+	*/
+	enum CullState : uint8_t {
+		CULL_NEVER = 0,		// Not in the picking index, so its bounds are unknown
+		CULL_OUTSIDE_VIEW,	// Drawn only if its bounds overlap the view
+		CULL_ALWAYS			// Hidden, draws nothing
+	};
+
+	static constexpr size_t CULLED_BATCHES = GraphicsManager::BatchIndex::LAST_SRTG_LAYER + 1;
+	std::vector<uint8_t> m_cullStates[CULLED_BATCHES]; // CullState of each mesh in draw order, reused every frame
+	std::vector<uint8_t> m_inView[CULLED_BATCHES]; // Set for the meshes overlapping the view being culled
+	std::vector<uint64_t> m_visibleOrders; // Draw orders returned by the picking index
+
+	/*!
+	* \brief Points a mesh at a texture's layer and region, or leaves it untextured if there is no texture.
+	*/
+	static void ApplyTexture(size_t meshID, Texture const* texture);
+
+	/*!
+	* \brief Gives the meshes still waiting for a texture the texture TextureLoader just uploaded.
+	*/
+	void OnTextureLoaded(std::string const& uuid, std::shared_ptr<Texture> const& texture);
+
+	std::unordered_map<std::string, std::vector<MeshHandle>> m_meshesAwaitingTexture; // Meshes showing the placeholder or their old texture, by texture
+	std::unordered_map<size_t, std::string> m_awaitedTexture; // Texture each waiting mesh was last given
+
+	std::vector<bool> m_meshInUse; // Reused by CheckUnownedMeshes
+	size_t m_framesSinceMeshCheck = 0;
+	static constexpr size_t MESH_CHECK_INTERVAL = 300; // Frames between trimming the mesh pool and, in debug builds, checking it
 };
\ No newline at end of file
@@ -121,9 +121,61 @@ bool Shader::LoadFromFile(const std::string& path)
     glDeleteShader(vertex);
     glDeleteShader(fragment);
 
+    // 5. Look up the uniform locations once instead of every frame
+    CacheUniforms();
+
     return true;
 }
 
+void Shader::CacheUniforms()
+{
+    uniforms.clear();
+
+    GLint count = 0;
+    glGetProgramiv(id_gl, GL_ACTIVE_UNIFORMS, &count);
+
+    GLint maxLength = 0;
+    glGetProgramiv(id_gl, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::string name(static_cast<size_t>(maxLength), '\0');
+
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(id_gl, static_cast<GLuint>(i), maxLength, &length, &size, &type, name.data());
+        std::string uniformName = name.substr(0, static_cast<size_t>(length));
+
+        // Members of uniform blocks have no location
+        GLint location = glGetUniformLocation(id_gl, uniformName.c_str());
+        if (location == -1) continue;
+
+        // Arrays are reported as "name[0]", register the base name and every element
+        if (uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0) {
+            std::string baseName = uniformName.substr(0, uniformName.size() - 3);
+            uniforms[baseName] = location;
+            for (GLint element = 0; element < size; ++element) {
+                std::string elementName = baseName + "[" + std::to_string(element) + "]";
+                uniforms[elementName] = glGetUniformLocation(id_gl, elementName.c_str());
+            }
+            continue;
+        }
+        uniforms[uniformName] = location;
+    }
+
+    // Texture array i is always bound to texture unit i
+    for (GLint unit = 0; ; ++unit) {
+        GLint location = Uniform("textureArrays[" + std::to_string(unit) + "]");
+        if (location == -1) break;
+        glProgramUniform1i(id_gl, location, unit);
+    }
+}
+
+GLint Shader::Uniform(std::string_view name) const
+{
+    auto it = uniforms.find(name);
+    return it == uniforms.end() ? -1 : it->second;
+}
+
 void Shader::Use()
 {
 	glUseProgram(id_gl);
@@ -17,10 +17,15 @@
  *********************************************************************/
 #pragma once
 
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
 #include "../Asset.hpp"
 
  // Forward declaration
  typedef unsigned int GLuint;
+ typedef int GLint;
 
  /*!*****************************************************************************
  \class Shader
@@ -61,8 +66,37 @@ public:
 	 * \brief Delete the shader program.
 	 */
     void DeleteProgram();
+
+    /*!
+     * \brief Get the location of a uniform in the program.
+     *
+     * Locations are looked up once when the program is linked, so this
+     * does not call into the driver.
+     *
+     * \param name The name of the uniform, e.g. "layerIndex" or "textureArrays[3]".
+     * \return The location of the uniform, or -1 if the program does not use it.
+     */
+    GLint Uniform(std::string_view name) const;
+
+private:
+    /*!
+     * \brief Cache the locations of all active uniforms after linking.
+     *
+     * Also points the textureArrays sampler array at texture units 0 to N-1,
+     * which never change, so batches only need to bind the textures.
+     */
+    void CacheUniforms();
+
+    // Allows looking up uniforms by string_view without constructing a string
+    struct UniformNameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+    };
 	
 public:
     GLuint id_gl; //!< The ID of the shader program in OpenGL.
     size_t id;
+
+private:
+    std::unordered_map<std::string, GLint, UniformNameHash, std::equal_to<>> uniforms; //!< Uniform locations by name.
 };
\ No newline at end of file
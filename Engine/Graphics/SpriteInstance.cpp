@@ -0,0 +1,118 @@
+/*********************************************************************
+ * \file		SpriteInstance.cpp
+ * \brief		The per-sprite record drawn by instanced batches, and
+ *				its conversion from a quad mesh
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include "SpriteInstance.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+namespace {
+	constexpr size_t TOP_LEFT = 0, TOP_RIGHT = 1, BOTTOM_RIGHT = 2, BOTTOM_LEFT = 3;
+
+	// Relative tolerance for the corners forming a parallelogram. Positions are
+	// floats in world units, so exact equality fails after rotation.
+	constexpr float PARALLELOGRAM_TOLERANCE = 1e-4f;
+}
+
+bool SpriteInstance::FromQuad(std::vector<Vertex> const& vertices, std::vector<unsigned int> const& indices, SpriteInstance& instance,
+	Vec4 const& texRect)
+{
+	if (vertices.size() != CORNER_COUNT || indices.size() != std::size(QUAD_INDICES) ||
+		!std::equal(indices.begin(), indices.end(), std::begin(QUAD_INDICES))) {
+		return false;
+	}
+
+	// Depth, color and texture are per instance, so they must be the same at every corner
+	PackedVertex packed[CORNER_COUNT];
+	for (size_t i = 0; i < CORNER_COUNT; ++i) {
+		packed[i] = PackedVertex(vertices[i], texRect);
+	}
+	for (size_t i = 1; i < CORNER_COUNT; ++i) {
+		if (packed[i].depth != packed[0].depth || packed[i].texture != packed[0].texture ||
+			std::memcmp(packed[i].color, packed[0].color, sizeof(packed[0].color)) != 0) {
+			return false;
+		}
+	}
+
+	// The texture coordinates must be a rectangle spanned by the bottom-left and top-right corners
+	PackedVertex const& bottomLeft = packed[BOTTOM_LEFT];
+	PackedVertex const& topRight = packed[TOP_RIGHT];
+	if (packed[TOP_LEFT].texCoord[0] != bottomLeft.texCoord[0] || packed[TOP_LEFT].texCoord[1] != topRight.texCoord[1] ||
+		packed[BOTTOM_RIGHT].texCoord[0] != topRight.texCoord[0] || packed[BOTTOM_RIGHT].texCoord[1] != bottomLeft.texCoord[1]) {
+		return false;
+	}
+
+	// Any affine transform of the unit quad keeps opposite corners' midpoints together
+	Vec3 const& tl = vertices[TOP_LEFT].position;
+	Vec3 const& tr = vertices[TOP_RIGHT].position;
+	Vec3 const& br = vertices[BOTTOM_RIGHT].position;
+	Vec3 const& bl = vertices[BOTTOM_LEFT].position;
+	float axisXx = tr.x - tl.x, axisXy = tr.y - tl.y;
+	float axisYx = tl.x - bl.x, axisYy = tl.y - bl.y;
+	float extent = std::abs(axisXx) + std::abs(axisXy) + std::abs(axisYx) + std::abs(axisYy);
+	float tolerance = PARALLELOGRAM_TOLERANCE * std::max(extent, 1.f);
+	if (std::abs((tl.x + br.x) - (tr.x + bl.x)) > tolerance || std::abs((tl.y + br.y) - (tr.y + bl.y)) > tolerance) {
+		return false;
+	}
+
+	instance.center[0] = (tl.x + br.x) * 0.5f;
+	instance.center[1] = (tl.y + br.y) * 0.5f;
+	instance.axisX[0] = axisXx;
+	instance.axisX[1] = axisXy;
+	instance.axisY[0] = axisYx;
+	instance.axisY[1] = axisYy;
+	instance.depth = packed[0].depth;
+	instance.texture = packed[0].texture;
+	std::memcpy(instance.color, packed[0].color, sizeof(instance.color));
+	instance.uvRect[0] = bottomLeft.texCoord[0];
+	instance.uvRect[1] = bottomLeft.texCoord[1];
+	instance.uvRect[2] = topRight.texCoord[0];
+	instance.uvRect[3] = topRight.texCoord[1];
+	return true;
+}
+
+void SpriteInstance::SetTransform(Vec3 const (&modelCorners)[CORNER_COUNT], Mat4 const& modelToWorld)
+{
+	// The fourth corner follows from the other three, and the center is the middle of either diagonal
+	Vec3 tl = modelToWorld * modelCorners[TOP_LEFT];
+	Vec3 tr = modelToWorld * modelCorners[TOP_RIGHT];
+	Vec3 bl = modelToWorld * modelCorners[BOTTOM_LEFT];
+
+	center[0] = (tr.x + bl.x) * 0.5f;
+	center[1] = (tr.y + bl.y) * 0.5f;
+	axisX[0] = tr.x - tl.x;
+	axisX[1] = tr.y - tl.y;
+	axisY[0] = tl.x - bl.x;
+	axisY[1] = tl.y - bl.y;
+	depth = static_cast<uint16_t>(glm::packHalf1x16(tl.z));
+}
+
+Vec2 SpriteInstance::GetCornerPosition(size_t corner) const
+{
+	float const* unit = UNIT_CORNERS[corner];
+	return Vec2(
+		center[0] + unit[0] * axisX[0] + unit[1] * axisY[0],
+		center[1] + unit[0] * axisX[1] + unit[1] * axisY[1]);
+}
+
+Vec2 SpriteInstance::GetCornerTexCoord(size_t corner) const
+{
+	float const* unit = UNIT_CORNERS[corner];
+	float u0 = uvRect[0] / 65535.f, v0 = uvRect[1] / 65535.f;
+	float u1 = uvRect[2] / 65535.f, v1 = uvRect[3] / 65535.f;
+	return Vec2(u0 + (unit[0] + 0.5f) * (u1 - u0), v0 + (unit[1] + 0.5f) * (v1 - v0));
+}
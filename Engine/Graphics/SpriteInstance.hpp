@@ -0,0 +1,108 @@
+/*********************************************************************
+ * \file		SpriteInstance.hpp
+ * \brief		The per-sprite record drawn by instanced batches, and
+ *				its conversion from a quad mesh
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef SPRITE_INSTANCE_HPP
+#define SPRITE_INSTANCE_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "Math.hpp"
+#include "Vertex.hpp"
+
+/**
+ * \struct SpriteInstance
+ * \brief One sprite in an instanced batch, drawn over a shared unit quad.
+ *
+ * The unit quad has its corners at (+-0.5, +-0.5). The sprite_instanced vertex
+ * shader places corner c at center + c.x * axisX + c.y * axisY, and maps its
+ * texture coordinates from the bottom-left to the top-right of uvRect. Depth,
+ * color and texture are packed the same way as in PackedVertex.
+ *
+ * Instances are stored in the batch's draw order, so the sort key stays on the
+ * CPU in BatchData::sortKeys.
+ */
+struct SpriteInstance
+{
+	float center[2];		// World position of the middle of the quad
+	float axisX[2];			// Offset from the left edge to the right edge
+	float axisY[2];			// Offset from the bottom edge to the top edge
+	uint16_t depth;			// Position z as a half float
+	uint16_t texture;		// Visibility, texture array ID and texture layer ID
+	uint8_t color[4];		// Color in RGBA8 format
+	uint16_t uvRect[4];		// Texture coordinates of the bottom-left and top-right corners, normalized to [0, 1]
+
+	static constexpr size_t CORNER_COUNT = 4;
+	static constexpr unsigned int QUAD_INDICES[6] = { 0, 1, 2, 2, 3, 0 };	// Same triangles as GraphicsManager::LoadQuadMesh
+	static constexpr float UNIT_CORNERS[CORNER_COUNT][2] = {
+		{ -0.5f,  0.5f },	// Top left
+		{  0.5f,  0.5f },	// Top right
+		{  0.5f, -0.5f },	// Bottom right
+		{ -0.5f, -0.5f }	// Bottom left
+	};
+
+	/*!*****************************************************************************
+	\brief
+		Converts a quad mesh into an instance.
+
+		The quad must be drawn with QUAD_INDICES, its corners must form a
+		parallelogram, its texture coordinates must be an axis-aligned rectangle,
+		and all four vertices must share the same depth, color and texture. Those
+		are the sprites made by GraphicsManager::LoadQuadMesh.
+	\param vertices
+		The world space vertices of the mesh, in UNIT_CORNERS order.
+	\param indices
+		The indices of the mesh.
+	\param instance
+		Set to the instance when the conversion succeeds.
+	\param texRect
+		Region of the texture layer holding the mesh's image, see Mesh::texRect.
+	\return
+		False if the mesh cannot be drawn as an instance.
+	*******************************************************************************/
+	static bool FromQuad(std::vector<Vertex> const& vertices, std::vector<unsigned int> const& indices, SpriteInstance& instance,
+		Vec4 const& texRect = Vec4(0.f, 0.f, 1.f, 1.f));
+
+	/*!*****************************************************************************
+	\brief
+		Places the instance from a model to world transform, leaving its texture,
+		color and texture coordinates as they are.
+
+		Transforms three corners instead of every vertex of the mesh, which is what
+		lets instanced sprites skip the per-vertex transform. The model space
+		corners must be a parallelogram, as every quad FromQuad accepts is.
+	\param modelCorners
+		The model space corners of the quad, in UNIT_CORNERS order.
+	\param modelToWorld
+		The transform of the quad into world space.
+	*******************************************************************************/
+	void SetTransform(Vec3 const (&modelCorners)[CORNER_COUNT], Mat4 const& modelToWorld);
+
+	/*!*****************************************************************************
+	\brief
+		Returns the world position of a corner, as computed by the vertex shader.
+	*******************************************************************************/
+	Vec2 GetCornerPosition(size_t corner) const;
+
+	/*!*****************************************************************************
+	\brief
+		Returns the normalized texture coordinates of a corner, as computed by the vertex shader.
+	*******************************************************************************/
+	Vec2 GetCornerTexCoord(size_t corner) const;
+};
+
+static_assert(sizeof(SpriteInstance) == 40, "SpriteInstance must match the instance attribute layout in BatchData::InitInstancing");
+
+#endif // SPRITE_INSTANCE_HPP
@@ -19,17 +19,33 @@
 #include "Texture.hpp"
 #include <glad/glad.h>
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <rapidjson/document.h>
+
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
 #include "../Application.hpp"
 #include "Logger.hpp"
+#include "Vertex.hpp"
 
 // Initialize all texture identifiers to 0
 std::array<TextureArray, 32> Texture::textureArrays = {};
 
+bool Texture::useAtlas = true;
+AtlasPacker Texture::atlasPacker(ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, ATLAS_PADDING, ATLAS_MAX_PAGES);
+std::vector<size_t> Texture::atlasArrays;
+std::vector<int> Texture::atlasPageTextures(ATLAS_MAX_PAGES, 0);
+uint32_t Texture::currentAtlasGeneration = 0;
+std::unordered_map<std::string, Texture::CookedPlacement> Texture::cookedPlacements;
+std::string Texture::atlasLayoutFolder;
+
 Texture::Texture() :
-    type(type), id(0), texArrayIndex(0), texLayerIndex(0)
+    type(type), id(0), texArrayIndex(0), texLayerIndex(0),
+    width(0), height(0), texRect(0.f, 0.f, 1.f, 1.f), contentRect(0.f, 0.f, 1.f, 1.f), inAtlas(false), atlasPage(-1), isLoaded(false), atlasGeneration(0)
 {
     static size_t idCounter = 0;
     id = idCounter++;
@@ -37,6 +53,26 @@ Texture::Texture() :
 
 Texture::~Texture() 
 {
+    ReleaseAtlasPage();
+}
+
+size_t Texture::GetMemorySize() const
+{
+    // The atlas page is counted once for every image on it, see GetPage
+    if (!isLoaded || inAtlas) return 0;
+
+    // Only the content of trimmed images is stored
+    size_t storedWidth = static_cast<size_t>(width * contentRect.z + 0.5f);
+    size_t storedHeight = static_cast<size_t>(height * contentRect.w + 0.5f);
+    return storedWidth * storedHeight * 4;
+}
+
+int Texture::GetPage(size_t& pageSize) const
+{
+    if (!isLoaded || !HoldsAtlasPage()) return NO_PAGE;
+
+    pageSize = static_cast<size_t>(ATLAS_PAGE_SIZE) * ATLAS_PAGE_SIZE * 4;
+    return atlasPage;
 }
 
 bool Texture::LoadFromFile(const std::string& filePath)
@@ -46,18 +82,87 @@ bool Texture::LoadFromFile(const std::string& filePath)
 	// Early exit if the file path is empty
 	if (path == "") return false;
 
-    int width, height, nrChannels;
-    stbi_set_flip_vertically_on_load(true); // Flip the image if needed
-    unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &nrChannels, 0);
-
-	if (!data) {
+    DecodedImage image;
+    if (!DecodeImage(filePath, image)) {
 		Logger::Instance().Log(Logger::Level::ERR, "[Texture] LoadFromFile: Failed to load texture from file: " + filePath);
-        stbi_image_free(data);
 		return false;
 	}
 
+    return Upload(image);
+}
+
+bool Texture::DecodeImage(const std::string& filePath, DecodedImage& image)
+{
+    int widthImage, heightImage, nrChannels;
+    stbi_set_flip_vertically_on_load_thread(true); // Flip the image if needed, only for the calling thread
+    unsigned char* data = stbi_load(filePath.c_str(), &widthImage, &heightImage, &nrChannels, 0);
+    if (!data) {
+        return false;
+    }
+
+    // Images that may go into the atlas get their edges extruded here rather than on the GL thread
+    int padding = 0;
+    if (useAtlas && widthImage + 2 * ATLAS_PADDING <= ATLAS_PAGE_SIZE && heightImage + 2 * ATLAS_PADDING <= ATLAS_PAGE_SIZE) {
+        padding = ATLAS_PADDING;
+    }
+
+    image.width = widthImage;
+    image.height = heightImage;
+    image.content = AtlasPacker::Rect{ 0, 0, widthImage, heightImage };
+    image.channels = nrChannels;
+    image.padding = padding;
+
+    // Transparent borders of atlas images are not stored, quads drawing them are clipped to what is left
+    if (padding > 0) {
+        image.content = AtlasPacker::Trim(data, widthImage, heightImage, nrChannels);
+        if (image.content.width == 0) {
+            image.content = AtlasPacker::Rect{ 0, 0, 1, 1 }; // Fully transparent, keep one pixel of it
+        }
+    }
+    AtlasPacker::Rect const& content = image.content;
+
+    int paddedWidth = content.width + 2 * padding;
+    int paddedHeight = content.height + 2 * padding;
+    image.pixels.resize(static_cast<size_t>(paddedWidth) * paddedHeight * nrChannels);
+    if (padding == 0) {
+        std::copy_n(data, image.pixels.size(), image.pixels.data());
+    }
+    else {
+        // Extrude the edges into the padding so sampling at the border of the content never reads a neighbour
+        for (int y = 0; y < paddedHeight; ++y) {
+            int srcY = content.y + std::clamp(y - padding, 0, content.height - 1);
+            for (int x = 0; x < paddedWidth; ++x) {
+                int srcX = content.x + std::clamp(x - padding, 0, content.width - 1);
+                std::copy_n(data + (static_cast<size_t>(srcY) * widthImage + srcX) * nrChannels, nrChannels,
+                    image.pixels.data() + (static_cast<size_t>(y) * paddedWidth + x) * nrChannels);
+            }
+        }
+    }
+
+    stbi_image_free(data);
+    return true;
+}
+
+bool Texture::Upload(DecodedImage const& image)
+{
+    width = image.width;
+    height = image.height;
+    inAtlas = false;
+    ReleaseAtlasPage();
+
+    // Images that fit in a page share the atlas, the rest keep an array of their exact size
+    if (image.padding > 0 && LoadIntoAtlas(image)) {
+        isLoaded = true;
+        return true;
+    }
+
+    // A trimmed image that did not fit in the atlas gets an array of its content's size
+    int storedWidth = image.content.width;
+    int storedHeight = image.content.height;
+    SetStoredRegion(image, 0, 0, storedWidth, storedHeight);
+
     // This sets texArrayIndex to the index of the texture array to use
-    SetTextureArrayToUse(width, height);
+    SetTextureArrayToUse(storedWidth, storedHeight);
 
     if (texArrayIndex == 5) {
 		//std::cout << "testing" << std::endl;
@@ -65,8 +170,7 @@ bool Texture::LoadFromFile(const std::string& filePath)
 
     // Error checking
     if (!(texArrayIndex >= 0 && texArrayIndex < textureArrays.size())) {
-		Logger::Instance().Log(Logger::Level::ERR, "[Texture] LoadFromFile: No valid texture array index");
-        stbi_image_free(data);
+		Logger::Instance().Log(Logger::Level::ERR, "[Texture] Upload: No valid texture array index");
         return false; 
     }
 
@@ -84,7 +188,7 @@ bool Texture::LoadFromFile(const std::string& filePath)
         glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
         glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-        glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, internalFormat, width, height, textureArrays[texArrayIndex].allocatedLayers);
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, internalFormat, storedWidth, storedHeight, textureArrays[texArrayIndex].allocatedLayers);
 	}
     else if (textureArrays[texArrayIndex].currentLayers > textureArrays[texArrayIndex].allocatedLayers) {
 		GLuint newID;
@@ -97,14 +201,14 @@ bool Texture::LoadFromFile(const std::string& filePath)
         glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
         textureArrays[texArrayIndex].allocatedLayers *= 2;
-        glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, internalFormat, width, height, textureArrays[texArrayIndex].allocatedLayers);
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, internalFormat, storedWidth, storedHeight, textureArrays[texArrayIndex].allocatedLayers);
 
         // Copy the old texture data to the new texture
         /*
         glCopyImageSubData(textureArrays[texArrayIndex].id_gl, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0,
             			newID, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, width, height, textureArrays[texArrayIndex].currentLayers - 1);
         */
-        CopyAllTextureLayers(textureArrays[texArrayIndex].id_gl, newID, width, height, textureArrays[texArrayIndex].currentLayers - 1);
+        CopyAllTextureLayers(textureArrays[texArrayIndex].id_gl, newID, storedWidth, storedHeight, textureArrays[texArrayIndex].currentLayers - 1);
 
         // Delete the old texture
         glDeleteTextures(1, &textureArrays[texArrayIndex].id_gl);
@@ -117,24 +221,28 @@ bool Texture::LoadFromFile(const std::string& filePath)
         glBindTexture(GL_TEXTURE_2D_ARRAY, textureArrays[texArrayIndex].id_gl);
     }
 	
-    // Load the texture data into the texture array
-    if (data) {
-        GLenum format = (nrChannels == 4) ? GL_RGBA : GL_RGB;
-
-        // Load texture data into OpenGL
-        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(texLayerIndex), width, height, 1, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
-
-        stbi_image_free(data);
-        return true;
-    }
-
-    stbi_image_free(data);
-    return false;
+    // Load the texture data into the texture array, skipping the padding if the image was meant for the atlas
+    GLenum format = (image.channels == 4) ? GL_RGBA : GL_RGB;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Rows of RGB images are not always 4-byte aligned
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, storedWidth + 2 * image.padding);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, image.padding);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, image.padding);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(texLayerIndex), storedWidth, storedHeight, 1, format, GL_UNSIGNED_BYTE, image.pixels.data());
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // The arrays have a single level, so there are no mipmaps to generate
+    isLoaded = true;
+    return true;
 }
 
 bool Texture::Load(int width, int height)
 {
+    this->width = width;
+    this->height = height;
+
     // This sets texArrayIndex to the index of the texture array to use
 	SetTextureArrayToUse(width, height);
 
@@ -190,6 +298,7 @@ bool Texture::Load(int width, int height)
 		glBindTexture(GL_TEXTURE_2D_ARRAY, textureArrays[texArrayIndex].id_gl);
 	}
 
+    isLoaded = true;
 	return true;
 }
 
@@ -222,7 +331,8 @@ size_t Texture::SetTextureArrayToUse(int widthImage, int heightImage)
         // Reassigns the texture array if it finds an array with the same width and height
 		if (textureArrays[i].width == widthImage 
             && textureArrays[i].height == heightImage
-            && textureArrays[i].id_gl != 0)
+            && textureArrays[i].id_gl != 0
+            && !textureArrays[i].isAtlas)
 		{
             texArrayIndex = i;
             newArrayFlag = false;
@@ -236,6 +346,9 @@ size_t Texture::SetTextureArrayToUse(int widthImage, int heightImage)
 
     if (texArrayIndex < 32) {
         texLayerIndex = static_cast<size_t>(textureArrays[texArrayIndex].currentLayers++);
+        if (texLayerIndex >= static_cast<size_t>(PackedVertex::MAX_TEXTURE_LAYERS)) {
+            Logger::Instance().Log(Logger::Level::WARN, "[Texture] SetTextureArrayToUse: Layer ", texLayerIndex, " cannot be referenced by batched vertices and will render untextured");
+        }
     }
     else {
         Logger::Instance().Log(Logger::Level::ERR, "[Texture] SetTextureArrayToUse: There are no available texture units");
@@ -281,4 +394,245 @@ void Texture::CopyAllTextureLayers(GLuint srcTex, GLuint destTex, int width, int
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
     glDeleteFramebuffers(1, &readFramebuffer);
     glDeleteFramebuffers(1, &drawFramebuffer);
-}
\ No newline at end of file
+}
+bool Texture::LoadIntoAtlas(DecodedImage const& image)
+{
+    AtlasPacker::Rect const& content = image.content;
+
+    // Images listed in the cooked layout already have their place reserved
+    AtlasPacker::Placement placement;
+    auto cooked = cookedPlacements.find(GetAtlasKey(path));
+    if (cooked != cookedPlacements.end()
+        && cooked->second.placement.rect.width == content.width
+        && cooked->second.placement.rect.height == content.height
+        && cooked->second.trimX == content.x
+        && cooked->second.trimY == content.y) {
+        placement = cooked->second.placement;
+    }
+    else if (!atlasPacker.Insert(content.width, content.height, placement)) {
+        // It fits in a page, so every page is taken
+        Logger::Instance().Log(Logger::Level::ERR, "[Texture] LoadIntoAtlas: All ", atlasPacker.GetPageCount(),
+            " atlas pages are full, " + path + " gets a texture array of its own");
+        return false;
+    }
+
+    size_t arrayIndex = GetAtlasArray(placement.page);
+    if (arrayIndex >= textureArrays.size()) {
+        return false;
+    }
+
+    texArrayIndex = arrayIndex;
+    texLayerIndex = static_cast<size_t>(placement.page % ATLAS_PAGES_PER_ARRAY);
+    SetStoredRegion(image, placement.rect.x, placement.rect.y, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE);
+    inAtlas = true;
+    atlasPage = placement.page;
+    atlasGeneration = currentAtlasGeneration;
+    ++atlasPageTextures[atlasPage];
+
+    // The edges were extruded into the padding when the image was decoded
+    int padding = image.padding;
+    GLenum format = (image.channels == 4) ? GL_RGBA : GL_RGB;
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureArrays[texArrayIndex].id_gl);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Rows of RGB images are not always 4-byte aligned
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, placement.rect.x - padding, placement.rect.y - padding, static_cast<GLint>(texLayerIndex),
+        content.width + 2 * padding, content.height + 2 * padding, 1, format, GL_UNSIGNED_BYTE, image.pixels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    return true;
+}
+
+void Texture::SetStoredRegion(DecodedImage const& image, int x, int y, int layerWidth, int layerHeight)
+{
+    // The whole image maps around its content, so clipped quads only ever sample what was stored
+    AtlasPacker::Rect const& content = image.content;
+    texRect = Vec4(
+        static_cast<float>(x - content.x) / layerWidth,
+        static_cast<float>(y - content.y) / layerHeight,
+        static_cast<float>(image.width) / layerWidth,
+        static_cast<float>(image.height) / layerHeight);
+    contentRect = Vec4(
+        static_cast<float>(content.x) / image.width,
+        static_cast<float>(content.y) / image.height,
+        static_cast<float>(content.width) / image.width,
+        static_cast<float>(content.height) / image.height);
+}
+
+size_t Texture::GetAtlasArray(int page)
+{
+    size_t group = static_cast<size_t>(page / ATLAS_PAGES_PER_ARRAY);
+    int layers = page % ATLAS_PAGES_PER_ARRAY + 1;
+    if (group >= atlasArrays.size()) {
+        atlasArrays.resize(group + 1, static_cast<size_t>(-1));
+    }
+
+    size_t arrayIndex = atlasArrays[group];
+    if (arrayIndex < textureArrays.size() && layers <= textureArrays[arrayIndex].allocatedLayers) {
+        // Pages up to currentLayers are copied when the array grows
+        textureArrays[arrayIndex].currentLayers = std::max(textureArrays[arrayIndex].currentLayers, layers);
+        return arrayIndex;
+    }
+
+    if (arrayIndex >= textureArrays.size()) {
+        // Take a free texture array, the same way fonts do
+        for (size_t i = 0; i < textureArrays.size(); ++i) {
+            if (textureArrays[i].id_gl == 0 && textureArrays[i].width == 0 && textureArrays[i].height == 0) {
+                arrayIndex = i;
+                break;
+            }
+        }
+        if (arrayIndex >= textureArrays.size()) {
+            Logger::Instance().Log(Logger::Level::ERR, "[Texture] GetAtlasArray: There are no available texture units");
+            return arrayIndex;
+        }
+
+        TextureArray& textureArray = textureArrays[arrayIndex];
+        textureArray.width = ATLAS_PAGE_SIZE;
+        textureArray.height = ATLAS_PAGE_SIZE;
+        textureArray.allocatedLayers = 0;
+        textureArray.currentLayers = 0;
+        textureArray.isAtlas = true;
+        atlasArrays[group] = arrayIndex;
+    }
+
+    // Double the pages like exact-size arrays do, or jump to the page asked for
+    TextureArray& textureArray = textureArrays[arrayIndex];
+    int allocatedLayers = std::min(ATLAS_PAGES_PER_ARRAY, std::max(layers, textureArray.allocatedLayers * 2));
+
+    GLuint newID;
+    glGenTextures(1, &newID);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, newID);
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, Application::GetInstance().GetInternalFormat(), ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, allocatedLayers);
+
+    // Copy the pages already filled, then drop the old array
+    if (textureArray.id_gl != 0) {
+        CopyAllTextureLayers(textureArray.id_gl, newID, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, textureArray.currentLayers);
+        glDeleteTextures(1, &textureArray.id_gl);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, newID);
+    }
+
+    textureArray.id_gl = newID;
+    textureArray.allocatedLayers = allocatedLayers;
+    textureArray.currentLayers = std::max(textureArray.currentLayers, layers);
+    return arrayIndex;
+}
+
+std::string Texture::GetAtlasKey(const std::string& filePath)
+{
+    if (atlasLayoutFolder.empty()) return filePath;
+    return std::filesystem::path(filePath).lexically_normal().lexically_relative(atlasLayoutFolder).generic_string();
+}
+
+bool Texture::LoadAtlasLayout(const std::string& layoutPath)
+{
+    std::ifstream file(layoutPath);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    rapidjson::Document document;
+    document.Parse(buffer.str().c_str());
+    if (document.HasParseError() || !document.IsObject() || !document.HasMember("Textures") || !document["Textures"].IsArray()) {
+        Logger::Instance().Log(Logger::Level::ERR, "[Texture] LoadAtlasLayout: Invalid atlas layout: " + layoutPath);
+        return false;
+    }
+
+    if (!document.HasMember("Page Size") || !document["Page Size"].IsInt() || document["Page Size"].GetInt() != ATLAS_PAGE_SIZE ||
+        !document.HasMember("Padding") || !document["Padding"].IsInt() || document["Padding"].GetInt() != ATLAS_PADDING ||
+        !document.HasMember("Trimmed") || !document["Trimmed"].IsBool() || !document["Trimmed"].GetBool()) {
+        Logger::Instance().Log(Logger::Level::WARN, "[Texture] LoadAtlasLayout: " + layoutPath + " was cooked with other page or trim settings, recook it");
+        return false;
+    }
+
+    atlasLayoutFolder = std::filesystem::path(layoutPath).parent_path().lexically_normal().generic_string();
+    cookedPlacements.clear();
+    for (auto const& entry : document["Textures"].GetArray()) {
+        if (!entry.IsObject() || !entry.HasMember("Path") || !entry["Path"].IsString()) continue;
+
+        CookedPlacement cooked;
+        AtlasPacker::Placement& placement = cooked.placement;
+        placement.page = entry.HasMember("Page") && entry["Page"].IsInt() ? entry["Page"].GetInt() : -1;
+        placement.rect.x = entry.HasMember("X") && entry["X"].IsInt() ? entry["X"].GetInt() : 0;
+        placement.rect.y = entry.HasMember("Y") && entry["Y"].IsInt() ? entry["Y"].GetInt() : 0;
+        placement.rect.width = entry.HasMember("Width") && entry["Width"].IsInt() ? entry["Width"].GetInt() : 0;
+        placement.rect.height = entry.HasMember("Height") && entry["Height"].IsInt() ? entry["Height"].GetInt() : 0;
+        cooked.trimX = entry.HasMember("Trim X") && entry["Trim X"].IsInt() ? entry["Trim X"].GetInt() : 0;
+        cooked.trimY = entry.HasMember("Trim Y") && entry["Trim Y"].IsInt() ? entry["Trim Y"].GetInt() : 0;
+        cookedPlacements[entry["Path"].GetString()] = cooked;
+    }
+
+    ResetAtlas();
+    Logger::Instance().Log(Logger::Level::INFO, "[Texture] LoadAtlasLayout: ", cookedPlacements.size(), " images placed by " + layoutPath);
+    return true;
+}
+
+void Texture::ResetAtlas()
+{
+    atlasPacker.Reset();
+    atlasArrays.clear();
+
+    // Images still alive were in the arrays being freed, so they no longer hold their pages
+    atlasPageTextures.assign(ATLAS_MAX_PAGES, 0);
+    ++currentAtlasGeneration;
+
+    // Reserve the cooked places first, so images loaded online only take the space left around them
+    ReserveCookedPlacements();
+}
+
+void Texture::ReserveCookedPlacements(int page)
+{
+    for (auto it = cookedPlacements.begin(); it != cookedPlacements.end();) {
+        if (page >= 0 && it->second.placement.page != page) {
+            ++it;
+        }
+        else if (it->second.placement.page >= ATLAS_MAX_PAGES) {
+            Logger::Instance().Log(Logger::Level::ERR, "[Texture] ReserveCookedPlacements: ", it->first, " was cooked into page ", it->second.placement.page,
+                " but the atlas only has ", ATLAS_MAX_PAGES, ", recook it");
+            it = cookedPlacements.erase(it);
+        }
+        else if (!atlasPacker.Reserve(it->second.placement)) {
+            Logger::Instance().Log(Logger::Level::WARN, "[Texture] ReserveCookedPlacements: Overlapping atlas placement dropped: " + it->first);
+            it = cookedPlacements.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+bool Texture::HoldsAtlasPage() const
+{
+    return atlasPage >= 0 && atlasGeneration == currentAtlasGeneration;
+}
+
+void Texture::ReleaseAtlasPage()
+{
+    if (HoldsAtlasPage() && --atlasPageTextures[atlasPage] == 0) {
+        // The last image on the page is gone, so the images loaded next may take its space
+        atlasPacker.ClearPage(atlasPage);
+        ReserveCookedPlacements(atlasPage);
+    }
+    atlasPage = -1;
+}
+
+void Texture::ReleaseEmptyAtlasArrays()
+{
+    for (size_t group = 0; group < atlasArrays.size(); ++group) {
+        size_t arrayIndex = atlasArrays[group];
+        if (arrayIndex >= textureArrays.size()) continue;
+
+        auto firstPage = atlasPageTextures.begin() + group * ATLAS_PAGES_PER_ARRAY;
+        if (std::any_of(firstPage, firstPage + ATLAS_PAGES_PER_ARRAY, [](int images) { return images > 0; })) continue;
+
+        glDeleteTextures(1, &textureArrays[arrayIndex].id_gl);
+        textureArrays[arrayIndex] = TextureArray();
+        atlasArrays[group] = static_cast<size_t>(-1);
+    }
+}
@@ -19,9 +19,14 @@
 
 #include <string>
 #include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 #include "../Asset.hpp"
+#include "AtlasPacker.hpp"
 #include "TextureArray.hpp"
+#include "Vec.hpp"
 
 // Forward declaration
 typedef unsigned int GLuint;
@@ -63,6 +68,71 @@ public:
    *******************************************************************************/
 	bool LoadFromFile(const std::string&) override;
 
+	/*!*****************************************************************************
+	\brief
+		Memory the image holds in its texture array, as 4 bytes a pixel. Images
+		in the atlas hold none of their own, the page they are on is counted
+		once for all of them instead.
+	\return
+		The size in bytes, or 0 while it is still loading.
+	*******************************************************************************/
+	size_t GetMemorySize() const override;
+
+	/*!*****************************************************************************
+	\brief
+		Atlas page the image is on, so the AssetManager evicts the images of a
+		page together once none of them is referenced.
+	\param pageSize
+		Set to the bytes of a page.
+	\return
+		The page, or NO_PAGE if the image is not in the atlas or is still loading.
+	*******************************************************************************/
+	int GetPage(size_t& pageSize) const override;
+
+	/*!*****************************************************************************
+	\brief
+		Images outside the atlas hold layers of arrays shared by their size, which
+		are only freed with every array, so they are never evicted on their own.
+	*******************************************************************************/
+	bool IsEvictableAlone() const override { return false; }
+
+	/*!*****************************************************************************
+	\struct DecodedImage
+	\brief
+		Pixels of an image decoded on any thread, waiting to be uploaded on the
+		GL thread. Images bound for the atlas are trimmed to their content, the
+		smallest rectangle holding every pixel that is not fully transparent, and
+		only that rectangle is kept, with its edges extruded into a border of
+		padding pixels around it.
+	*******************************************************************************/
+	struct DecodedImage {
+		std::vector<unsigned char> pixels;
+		int width = 0, height = 0;	// Size of the whole image
+		AtlasPacker::Rect content;	// Part of the image held in pixels, without the padding
+		int channels = 0;
+		int padding = 0;
+	};
+
+	/*!*****************************************************************************
+	\brief
+		Decodes an image file. Makes no OpenGL calls, so it is safe on worker threads.
+	\param filePath
+		The file path to the texture image.
+	\param image
+		Receives the pixels. Its buffer is reused if it is large enough.
+	\return
+		Returns true if the image was decoded; otherwise, false.
+	*******************************************************************************/
+	static bool DecodeImage(const std::string& filePath, DecodedImage& image);
+
+	/*!*****************************************************************************
+	\brief
+		Uploads a decoded image into the atlas or a texture array. GL thread only.
+	\return
+		Returns true if the texture was uploaded; otherwise, false.
+	*******************************************************************************/
+	bool Upload(DecodedImage const& image);
+
 	/*!*****************************************************************************
    \brief
 	   Loads blank texture data given the width and height.
@@ -116,7 +186,7 @@ public:
 	* \param numLayers
 	*	The number of layers to copy
 	* ******************************************************************************/
-	void CopyAllTextureLayers(GLuint srcTex, GLuint destTex, int width, int height, int numLayers);
+	static void CopyAllTextureLayers(GLuint srcTex, GLuint destTex, int width, int height, int numLayers);
 
 	/*!*****************************************************************************
 	* \brief
@@ -126,7 +196,87 @@ public:
 	* ******************************************************************************/
 	static std::array<TextureArray, 32>& GetTextureArray();
 
+	/*!*****************************************************************************
+	* \brief
+	*	Loads an atlas layout cooked by kigen_atlas_cook. The images it lists are
+	*	placed where the layout says when they load, and the rest of the pages are
+	*	filled as other images load.
+	*
+	* \param layoutPath
+	*	Path of the layout file. Image paths in it are relative to its folder.
+	* \return
+	*	False if the file cannot be read or was cooked with other page or trim settings
+	* ******************************************************************************/
+	static bool LoadAtlasLayout(const std::string& layoutPath);
+
+	/*!*****************************************************************************
+	* \brief
+	*	Empties the atlas pages, keeping the placements of the cooked layout.
+	*	Called when the texture arrays are freed.
+	* ******************************************************************************/
+	static void ResetAtlas();
+
+	/*!*****************************************************************************
+	* \brief
+	*	Deletes the texture arrays of the atlas whose pages no longer hold any
+	*	image, after evicted images emptied them. The arrays are created again
+	*	when images are placed on their pages. GL thread only.
+	* ******************************************************************************/
+	static void ReleaseEmptyAtlasArrays();
+
+private:
+	/*!*****************************************************************************
+	* \brief
+	*	Places the image in an atlas page and uploads it with its edges extruded
+	*	into the padding around it
+	* \return
+	*	False if the image does not fit in the atlas, so it goes to an exact-size array
+	* ******************************************************************************/
+	bool LoadIntoAtlas(DecodedImage const& image);
+
+	/*!*****************************************************************************
+	* \brief
+	*	Returns the index of the texture array holding an atlas page. Arrays are
+	*	created with the pages in use and double, copying their pages, when a
+	*	later page is needed, so a small atlas never allocates a full array
+	* ******************************************************************************/
+	static size_t GetAtlasArray(int page);
+
+	/*!*****************************************************************************
+	* \brief
+	*	Drops the image from the count of its atlas page. The page is emptied for
+	*	the images loaded next once the last image on it is gone
+	* ******************************************************************************/
+	void ReleaseAtlasPage();
+
+	bool HoldsAtlasPage() const;
+
+	/*!*****************************************************************************
+	* \brief
+	*	Reserves the places the cooked layout gives images on a page, or on every
+	*	page if page is -1, dropping the placements that cannot be reserved
+	* ******************************************************************************/
+	static void ReserveCookedPlacements(int page = -1);
+
+	/*!*****************************************************************************
+	* \brief
+	*	Sets texRect and contentRect for an image whose content was stored at x
+	*	and y in a layer of the size given
+	* ******************************************************************************/
+	void SetStoredRegion(DecodedImage const& image, int x, int y, int layerWidth, int layerHeight);
+
+	static std::string GetAtlasKey(const std::string& filePath);
+
 public:
+	static constexpr int ATLAS_PAGE_SIZE = 2048;		// Width and height of every atlas page
+	static constexpr int ATLAS_PADDING = 2;				// Pixels extruded around each image in a page
+	static constexpr int ATLAS_PAGES_PER_ARRAY = 64;	// Most pages one texture array grows to
+	static constexpr int ATLAS_MAX_ARRAYS = 4;			// Texture arrays the atlas may use, out of the 32
+	static constexpr int ATLAS_MAX_PAGES = ATLAS_PAGES_PER_ARRAY * ATLAS_MAX_ARRAYS;
+
+	// Packs images that fit in a page into shared atlas pages instead of arrays of their exact size
+	static bool useAtlas;
+
 	// Stores the OpenGL Texture Array ID
 	// TextureArray is a simple class that only stores the id_gl of the texture array and its dimensions
 	static std::array<TextureArray, 32> textureArrays;
@@ -137,9 +287,37 @@ public:
 	size_t texArrayIndex;
 	size_t texLayerIndex;
 
+	int width, height;		// Size of the image in pixels
+	Vec4 texRect;			// Region of the layer the whole image maps to: offset in x and y, size in z and w, normalized
+	Vec4 contentRect;		// Part of the image stored in that region, normalized to the image. Quads are clipped to it
+	bool inAtlas;			// True if the image shares an atlas page with others
+	int atlasPage;			// Page of the atlas the image is counted on, -1 if none
+	bool isLoaded;			// False while the image is still loading, the fields above then show a placeholder
+
 	std::string type;
 	std::string name;
 	std::string path;
+
+private:
+	uint32_t atlasGeneration;	// Atlas the page was counted in, pages of an atlas since reset are no longer held
+
+	static AtlasPacker atlasPacker;
+	static std::vector<size_t> atlasArrays;										// Texture array of each group of ATLAS_PAGES_PER_ARRAY pages
+	static std::vector<int> atlasPageTextures;									// Images loaded on each atlas page
+	static uint32_t currentAtlasGeneration;										// Counts the times the atlas was reset
+	/*!*****************************************************************************
+	\struct CookedPlacement
+	\brief
+		Where the cooked layout put an image's content, and where that content
+		starts in the image.
+	*******************************************************************************/
+	struct CookedPlacement {
+		AtlasPacker::Placement placement;
+		int trimX = 0, trimY = 0;
+	};
+
+	static std::unordered_map<std::string, CookedPlacement> cookedPlacements;	// Placements from the cooked layout, by path relative to it
+	static std::string atlasLayoutFolder;
 };
 
 inline std::array<TextureArray, 32>& Texture::GetTextureArray()
@@ -21,7 +21,7 @@
 #include <glad/glad.h>
 
 TextureArray::TextureArray(GLuint id_gl, int width, int height, int initialAllocatedLayers) :
-	id_gl(id_gl), width(width), height(height), currentLayers(0), allocatedLayers(initialAllocatedLayers)
+	id_gl(id_gl), width(width), height(height), currentLayers(0), allocatedLayers(initialAllocatedLayers), isAtlas(false)
 {
 }
 
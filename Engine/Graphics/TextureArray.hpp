@@ -54,4 +54,5 @@ public:
 	int currentLayers;
 	int allocatedLayers;
 	int width, height;
+	bool isAtlas;	// Set for atlas pages, which hold images of any size
 };
@@ -0,0 +1,322 @@
+/*********************************************************************
+ * \file		TextureLoader.cpp
+ * \brief		Defines the loader that decodes textures on the job
+ *				system's workers and uploads them on the GL thread
+ *				under a per-frame time budget.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include "TextureLoader.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include "../AssetManager.hpp"
+#include "../Utility/MetadataHandler.hpp"
+#include "../Utility/Profiler.hpp"
+#include "Logger.hpp"
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	double MillisecondsSince(Clock::time_point start) {
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+}
+
+TextureLoader& TextureLoader::GetInstance() {
+	static TextureLoader instance;
+	return instance;
+}
+
+std::shared_ptr<Texture> TextureLoader::Request(std::string const& uuid, Priority priority, Callback callback) {
+	if (uuid.empty()) {
+		return nullptr;
+	}
+
+	auto pending = m_requests.find(uuid);
+	if (pending != m_requests.end()) {
+		Boost(uuid, priority);
+		if (callback) {
+			pending->second->callbacks.push_back(std::move(callback));
+		}
+		return pending->second->texture;
+	}
+
+	// Loaded earlier, or loaded synchronously through the AssetManager
+	auto& assetManager = AssetManager::GetInstance();
+	std::shared_ptr<Texture> texture = assetManager.Find<Texture>(uuid);
+	std::string path;
+	if (!texture && !m_failed.count(uuid)) {
+		path = MetadataHandler::RetrieveFilePathFromUUID(uuid);
+		if (path.empty()) {
+			m_failed.insert(uuid);
+		}
+	}
+	if (path.empty()) {
+		if (callback) {
+			callback(uuid, texture);
+		}
+		return texture;
+	}
+
+	auto request = std::make_shared<LoadRequest>();
+	request->uuid = uuid;
+	request->path = path;
+	request->priority = priority;
+	request->generation = m_generation;
+	if (callback) {
+		request->callbacks.push_back(std::move(callback));
+	}
+
+	// In the AssetManager straight away, so nothing else loads the file while it decodes
+	request->texture = assetManager.CreateTexture<Texture>(uuid);
+	request->texture->path = path;
+	ShowPlaceholder(*request->texture);
+
+	m_requests.emplace(uuid, request);
+	m_waiting[priority].push_back(request);
+	return request->texture;
+}
+
+void TextureLoader::Boost(std::string const& uuid, Priority priority) {
+	auto pending = m_requests.find(uuid);
+	if (pending == m_requests.end() || pending->second->priority >= priority) {
+		return;
+	}
+
+	// The entry in the lower queue stays behind and is skipped once its priority no longer matches
+	LoadRequest& request = *pending->second;
+	request.priority = priority;
+	if (!request.isDecoding) {
+		m_waiting[priority].push_back(pending->second);
+	}
+}
+
+void TextureLoader::Update() {
+	PROFILE_SCOPE("TextureLoader::Update");
+	if (m_requests.empty() && m_inFlight == 0) {
+		return;
+	}
+
+	Collect(false);
+	UploadReady(PRIORITY_BACKGROUND, m_uploadBudgetMs);
+	Dispatch(PRIORITY_BACKGROUND, GetMaxInFlight());
+}
+
+void TextureLoader::Flush(Priority minPriority) {
+	PROFILE_SCOPE("TextureLoader::Flush");
+
+	// Twice as many jobs as workers, so they have the next image queued while this thread uploads
+	size_t maxInFlight = 2 * GetMaxInFlight();
+	for (;;) {
+		Collect(false);
+		size_t completed = UploadReady(minPriority, -1.0);
+		if (!HasPending(minPriority)) {
+			break;
+		}
+
+		Dispatch(minPriority, maxInFlight);
+		if (completed == 0) {
+			Collect(true);
+		}
+	}
+}
+
+void TextureLoader::Clear() {
+	++m_generation;
+	for (auto& waiting : m_waiting) {
+		waiting.clear();
+	}
+	for (auto const& request : m_ready) {
+		m_staging.Release(std::move(request->image.pixels));
+	}
+	m_ready.clear();
+	m_requests.clear();
+	m_failed.clear();
+
+	// The placeholder lived in the texture arrays being freed
+	m_placeholder = nullptr;
+}
+
+std::shared_ptr<Texture> TextureLoader::GetPlaceholder() {
+	if (m_placeholder && m_placeholder->isLoaded) {
+		return m_placeholder;
+	}
+
+	// A small grey checkerboard, with its edges extruded like any other image bound for the atlas
+	Texture::DecodedImage image;
+	image.width = PLACEHOLDER_SIZE;
+	image.height = PLACEHOLDER_SIZE;
+	image.channels = 4;
+	image.padding = Texture::useAtlas ? Texture::ATLAS_PADDING : 0;
+	int paddedSize = PLACEHOLDER_SIZE + 2 * image.padding;
+	image.pixels.resize(static_cast<size_t>(paddedSize) * paddedSize * image.channels);
+	for (int y = 0; y < paddedSize; ++y) {
+		int srcY = std::clamp(y - image.padding, 0, PLACEHOLDER_SIZE - 1);
+		for (int x = 0; x < paddedSize; ++x) {
+			int srcX = std::clamp(x - image.padding, 0, PLACEHOLDER_SIZE - 1);
+			bool isLight = ((srcX / PLACEHOLDER_CHECKER) + (srcY / PLACEHOLDER_CHECKER)) % 2 == 0;
+			unsigned char* pixel = image.pixels.data() + (static_cast<size_t>(y) * paddedSize + x) * image.channels;
+			pixel[0] = pixel[1] = pixel[2] = isLight ? 160 : 96;
+			pixel[3] = 255;
+		}
+	}
+
+	m_placeholder = std::make_shared<Texture>();
+	if (!m_placeholder->Upload(image)) {
+		Logger::Instance().Log(Logger::Level::ERR, "[TextureLoader] GetPlaceholder: Failed to upload the placeholder texture");
+	}
+	return m_placeholder;
+}
+
+void TextureLoader::Dispatch(Priority minPriority, size_t maxInFlight) {
+	auto& jobSystem = JobSystem::GetInstance();
+	for (int priority = MAX_PRIORITIES - 1; priority >= minPriority && m_inFlight < maxInFlight; --priority) {
+		auto& waiting = m_waiting[priority];
+		while (!waiting.empty() && m_inFlight < maxInFlight) {
+			std::shared_ptr<LoadRequest> request = std::move(waiting.front());
+			waiting.pop_front();
+			if (request->isDecoding || request->priority != priority || request->generation != m_generation) {
+				continue;
+			}
+
+			request->isDecoding = true;
+			++m_inFlight;
+			jobSystem.SubmitBackground([this, request]() {
+				PROFILE_SCOPE("TextureLoader::Decode");
+				request->image.pixels = m_staging.Acquire();
+				request->decoded = Texture::DecodeImage(request->path, request->image);
+
+				std::lock_guard<std::mutex> lock(m_decodedMutex);
+				m_decoded.push_back(request);
+				m_decodedCondition.notify_one();
+			}, m_decodeCounter);
+		}
+	}
+}
+
+void TextureLoader::Collect(bool wait) {
+	std::vector<std::shared_ptr<LoadRequest>> decoded;
+	{
+		std::unique_lock<std::mutex> lock(m_decodedMutex);
+		if (wait && m_inFlight > 0) {
+			m_decodedCondition.wait(lock, [this]() { return !m_decoded.empty(); });
+		}
+		decoded.swap(m_decoded);
+	}
+
+	m_inFlight -= decoded.size();
+	for (auto& request : decoded) {
+		if (request->generation != m_generation) {
+			m_staging.Release(std::move(request->image.pixels));
+			continue;
+		}
+		m_ready.push_back(std::move(request));
+	}
+}
+
+size_t TextureLoader::UploadReady(Priority minPriority, double budgetMs) {
+	if (m_ready.empty()) {
+		return 0;
+	}
+	std::stable_sort(m_ready.begin(), m_ready.end(),
+		[](std::shared_ptr<LoadRequest> const& a, std::shared_ptr<LoadRequest> const& b) { return a->priority > b->priority; });
+
+	Clock::time_point start = Clock::now();
+	size_t completed = 0;
+	while (!m_ready.empty() && m_ready.front()->priority >= minPriority) {
+		if (budgetMs >= 0.0 && completed > 0 && MillisecondsSince(start) >= budgetMs) {
+			break;
+		}
+
+		std::shared_ptr<LoadRequest> request = std::move(m_ready.front());
+		m_ready.pop_front();
+		Complete(request);
+		++completed;
+	}
+	return completed;
+}
+
+void TextureLoader::Complete(std::shared_ptr<LoadRequest> const& request) {
+	PROFILE_SCOPE("TextureLoader::Upload");
+	bool isUploaded = request->decoded && request->texture->Upload(request->image);
+	m_staging.Release(std::move(request->image.pixels));
+
+	std::shared_ptr<Texture> texture = request->texture;
+	if (!isUploaded) {
+		Logger::Instance().Log(Logger::Level::ERR, "[TextureLoader] Complete: Failed to load texture from file: " + request->path);
+		auto& assetManager = AssetManager::GetInstance();
+		if (assetManager.Find<Texture>(request->uuid) == texture) {
+			assetManager.Unload<Texture>(request->uuid);
+		}
+		m_failed.insert(request->uuid);
+		texture = nullptr;
+	}
+
+	auto pending = m_requests.find(request->uuid);
+	if (pending != m_requests.end() && pending->second == request) {
+		m_requests.erase(pending);
+	}
+
+	std::vector<Callback> callbacks = std::move(request->callbacks);
+	for (auto const& callback : callbacks) {
+		callback(request->uuid, texture);
+	}
+}
+
+bool TextureLoader::HasPending(Priority minPriority) const {
+	return std::any_of(m_requests.begin(), m_requests.end(),
+		[minPriority](auto const& pending) { return pending.second->priority >= minPriority; });
+}
+
+void TextureLoader::ShowPlaceholder(Texture& texture) {
+	std::shared_ptr<Texture> placeholder = GetPlaceholder();
+	texture.texArrayIndex = placeholder->texArrayIndex;
+	texture.texLayerIndex = placeholder->texLayerIndex;
+	texture.texRect = placeholder->texRect;
+	texture.contentRect = placeholder->contentRect;
+	texture.width = placeholder->width;
+	texture.height = placeholder->height;
+	texture.inAtlas = placeholder->inAtlas;
+	texture.isLoaded = false;
+}
+
+size_t TextureLoader::GetMaxInFlight() const {
+	auto const& jobSystem = JobSystem::GetInstance();
+	return jobSystem.IsSingleThreaded() ? 1 : std::max<size_t>(jobSystem.GetNumWorkers(), 1);
+}
+
+std::vector<unsigned char> TextureLoader::StagingPool::Acquire() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_buffers.empty()) {
+		return {};
+	}
+
+	// Hand out the largest buffer, it is the most likely to hold the image without growing
+	auto largest = std::max_element(m_buffers.begin(), m_buffers.end(),
+		[](auto const& a, auto const& b) { return a.capacity() < b.capacity(); });
+	std::iter_swap(largest, m_buffers.end() - 1);
+	std::vector<unsigned char> buffer = std::move(m_buffers.back());
+	m_buffers.pop_back();
+	m_pooledBytes -= buffer.capacity();
+	return buffer;
+}
+
+void TextureLoader::StagingPool::Release(std::vector<unsigned char>&& buffer) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (buffer.capacity() == 0 || m_pooledBytes + buffer.capacity() > MAX_POOLED_BYTES) {
+		return;
+	}
+	buffer.clear();
+	m_pooledBytes += buffer.capacity();
+	m_buffers.push_back(std::move(buffer));
+}
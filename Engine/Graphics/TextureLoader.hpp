@@ -0,0 +1,220 @@
+/*********************************************************************
+ * \file		TextureLoader.hpp
+ * \brief		Declares the loader that decodes textures on the job
+ *				system's workers and uploads them on the GL thread
+ *				under a per-frame time budget.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef TEXTURE_LOADER_HPP
+#define TEXTURE_LOADER_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Texture.hpp"
+#include "../Utility/JobSystem.hpp"
+
+/**
+ * \class TextureLoader
+ * \brief Loads textures in the background, showing a placeholder until each one is ready.
+ *
+ * Loading is split in two stages. Decoding the image file is the expensive part and makes no
+ * OpenGL calls, so it runs as a background job on the job system's workers, into a staging buffer
+ * taken from a pool. The main thread never decodes while it waits for a frame's jobs. Uploading
+ * has to happen on the GL thread, so Update uploads the decoded images there and stops once the
+ * frame's time budget is spent.
+ *
+ * A requested texture is in the AssetManager straight away and shows the placeholder until it
+ * is uploaded, so anything asking for it in the meantime gets the placeholder rather than
+ * loading the file a second time. Requests are decoded highest priority first. Requesting a
+ * pending texture again at a higher priority boosts it.
+ *
+ * Everything but the decode jobs runs on the main thread.
+ */
+class TextureLoader {
+public:
+	/**
+	 * \enum Priority
+	 * \brief Order in which pending textures are decoded, lowest first.
+	 */
+	enum Priority {
+		PRIORITY_BACKGROUND = 0,	// Prefetched, not needed yet
+		PRIORITY_NORMAL,			// Needed, but may show the placeholder for a few frames
+		PRIORITY_SCENE,				// Referenced by the scene being loaded
+		MAX_PRIORITIES
+	};
+
+	/**
+	 * \brief Called on the main thread once a texture is uploaded, with nullptr if it failed to load.
+	 */
+	using Callback = std::function<void(std::string const& uuid, std::shared_ptr<Texture> const& texture)>;
+
+	static TextureLoader& GetInstance();
+
+	/**
+	 * \brief Starts loading a texture unless it is already loaded or loading.
+	 *
+	 * \param uuid UUID of the image asset.
+	 * \param priority Raises the priority of the texture if it is already pending.
+	 * \param callback Called when the texture is uploaded. If it is already loaded, it is called
+	 *                 before Request returns.
+	 * \return The texture, which shows the placeholder while it is pending, or nullptr if the
+	 *         UUID does not name an image or the image failed to load.
+	 */
+	std::shared_ptr<Texture> Request(std::string const& uuid, Priority priority = PRIORITY_NORMAL, Callback callback = nullptr);
+
+	/**
+	 * \brief Raises the priority of a pending texture. Does nothing if it is not pending.
+	 */
+	void Boost(std::string const& uuid, Priority priority);
+
+	bool IsPending(std::string const& uuid) const { return m_requests.count(uuid) != 0; }
+	size_t GetPendingCount() const { return m_requests.size(); }
+
+	/**
+	 * \brief Queues decode jobs and uploads the decoded textures until the time budget is spent.
+	 *
+	 * Called once per frame on the GL thread. At least one texture is uploaded per call, so
+	 * loading always progresses however small the budget.
+	 */
+	void Update();
+
+	/**
+	 * \brief Blocks until every texture at or above a priority is uploaded.
+	 *
+	 * Used while a scene loads, when the loading screen is showing anyway. Decoding still runs
+	 * on the workers while the calling thread uploads.
+	 */
+	void Flush(Priority minPriority = PRIORITY_BACKGROUND);
+
+	/**
+	 * \brief Drops every pending request without calling their callbacks.
+	 *
+	 * Called when the texture arrays are freed. Decode jobs already running finish, and their
+	 * results are thrown away.
+	 */
+	void Clear();
+
+	/**
+	 * \brief Returns the texture shown while a texture loads, creating it if needed.
+	 */
+	std::shared_ptr<Texture> GetPlaceholder();
+
+	/**
+	 * \brief Sets how long Update may spend uploading each frame, in milliseconds.
+	 */
+	void SetUploadBudget(double milliseconds) { m_uploadBudgetMs = milliseconds; }
+	double GetUploadBudget() const { return m_uploadBudgetMs; }
+
+	static constexpr double DEFAULT_UPLOAD_BUDGET_MS = 2.0;
+
+private:
+	/**
+	 * \struct LoadRequest
+	 * \brief A texture being loaded.
+	 *
+	 * Only the decode job touches image and decoded, and it hands the request back through
+	 * m_decoded before the main thread reads them.
+	 */
+	struct LoadRequest {
+		std::string uuid;
+		std::string path;
+		std::shared_ptr<Texture> texture;
+		std::vector<Callback> callbacks;
+		Priority priority = PRIORITY_NORMAL;
+		bool isDecoding = false;		// Set once a decode job was submitted
+		uint64_t generation = 0;		// Clear count when requested, stale requests are dropped
+		Texture::DecodedImage image;	// Written by the decode job
+		bool decoded = false;			// Written by the decode job
+	};
+
+	/**
+	 * \class StagingPool
+	 * \brief Reuses the buffers images are decoded into, up to a total size.
+	 *
+	 * Buffers keep their capacity when they come back, so after a few loads decoding rarely
+	 * allocates. Acquire is called from the decode jobs, so the pool is locked.
+	 */
+	class StagingPool {
+	public:
+		std::vector<unsigned char> Acquire();
+		void Release(std::vector<unsigned char>&& buffer);
+
+		static constexpr size_t MAX_POOLED_BYTES = 64u * 1024u * 1024u;
+
+	private:
+		std::mutex m_mutex{};
+		std::vector<std::vector<unsigned char>> m_buffers{};
+		size_t m_pooledBytes = 0;
+	};
+
+	TextureLoader() = default;
+	TextureLoader(const TextureLoader&) = delete;
+	TextureLoader& operator=(const TextureLoader&) = delete;
+
+	/**
+	 * \brief Submits decode jobs for the highest priority waiting requests, keeping at most maxInFlight running.
+	 */
+	void Dispatch(Priority minPriority, size_t maxInFlight);
+
+	/**
+	 * \brief Moves the requests the decode jobs finished into m_ready, optionally waiting for one.
+	 */
+	void Collect(bool wait);
+
+	/**
+	 * \brief Uploads ready requests at or above a priority, highest first, until the budget is spent.
+	 *
+	 * \param budgetMs Milliseconds to spend. A negative budget uploads every ready request.
+	 * \return Number of requests completed.
+	 */
+	size_t UploadReady(Priority minPriority, double budgetMs);
+
+	/**
+	 * \brief Uploads one request, or records its failure, and calls its callbacks.
+	 */
+	void Complete(std::shared_ptr<LoadRequest> const& request);
+
+	bool HasPending(Priority minPriority) const;
+	void ShowPlaceholder(Texture& texture);
+	size_t GetMaxInFlight() const;
+
+	std::unordered_map<std::string, std::shared_ptr<LoadRequest>> m_requests{};	// Pending requests by UUID
+	std::deque<std::shared_ptr<LoadRequest>> m_waiting[MAX_PRIORITIES]{};		// Requests waiting for a decode job, by priority
+	std::deque<std::shared_ptr<LoadRequest>> m_ready{};							// Decoded requests waiting for an upload
+	std::unordered_set<std::string> m_failed{};									// UUIDs that failed to load, not retried until Clear
+
+	std::mutex m_decodedMutex{};					// Guards m_decoded
+	std::condition_variable m_decodedCondition{};	// Signalled when a decode job finishes
+	std::vector<std::shared_ptr<LoadRequest>> m_decoded{};	// Filled by the decode jobs
+
+	JobCounter m_decodeCounter{};
+	size_t m_inFlight = 0;			// Decode jobs submitted and not collected yet
+	uint64_t m_generation = 0;
+	StagingPool m_staging{};
+
+	std::shared_ptr<Texture> m_placeholder{};
+	double m_uploadBudgetMs = DEFAULT_UPLOAD_BUDGET_MS;
+
+	static constexpr int PLACEHOLDER_SIZE = 8;
+	static constexpr int PLACEHOLDER_CHECKER = 4;	// Pixels per checker square
+};
+
+#endif // TEXTURE_LOADER_HPP
@@ -21,8 +21,10 @@
 #include "../Components/Renderer.hpp"
 #include "Timer.hpp"
 #include <string>
+#include <algorithm>
 #include "../Scene/SceneManager.hpp"
 #include "../AssetManager.hpp"
+#include "../Utility/Profiler.hpp"
 
 
 UISystem::UISystem()
@@ -89,6 +91,7 @@ void UISystem::Init()
 //static float frameSplit = 0.f;
 void UISystem::Update(double)
 {
+    PROFILE_SCOPE("UISystem::Update");
     //frameSplit += dt;
     //std::cout << frameSplit << std::endl;
     // References for easy readability
@@ -96,15 +99,9 @@ void UISystem::Update(double)
     auto& ecsManager = ECSManager::GetInstance();
 
     SceneManager& sm = SceneManager::GetInstance();
-    std::set<Entity> entities = m_entities;
-    // If scene manager is still loading the current scene
-    if (sm.isLoading) {
-        entities = sm.loadingScreenEntities;
-    }
 
-    for (auto const& entity : entities) {
-        auto& ui = ecsManager.GetComponent<UI>(entity);
-        if (ui.isUpdated) continue;
+    auto updateEntity = [&](Entity entity, UI& ui) {
+        if (ui.isUpdated) return;
 
         auto renderer0pt = ecsManager.TryGetComponent<Renderer>(entity);
         auto textbox0pt = ecsManager.TryGetComponent<Textbox>(entity);
@@ -134,6 +131,17 @@ void UISystem::Update(double)
             graphicsManager.SetBatchSortFlag(renderer.currentMeshID, false);
         }
         ui.isUpdated = true;
+    };
+
+    // If scene manager is still loading the current scene, only update the loading screen
+    if (sm.isLoading) {
+        for (auto const& entity : sm.loadingScreenEntities) {
+            auto ui = ecsManager.TryGetComponent<UI>(entity);
+            if (ui.has_value()) updateEntity(entity, ui->get());
+        }
+    }
+    else {
+        ecsManager.GetView<UI>().ForEach(updateEntity);
     }
 
     // temp
@@ -165,10 +173,13 @@ void UISystem::SetTextbox(Entity entity)
     auto& ui = ui0pt->get();
     auto& graphicsManager = GraphicsManager::GetInstance();
 
+    // Forget meshes that were released, e.g. when the scene was unloaded
+    std::erase_if(textbox.meshHandles, [&graphicsManager](MeshHandle handle) { return !graphicsManager.meshes.IsValid(handle); });
+
     if (textbox.text.empty()) {
         // If the textbox is empty, hide all its meshes
-        for (size_t i = 0; i < textbox.meshIDs.size(); ++i) {
-            graphicsManager.SetVisibilityToMesh(textbox.meshIDs[i], false);
+        for (size_t i = 0; i < textbox.meshHandles.size(); ++i) {
+            graphicsManager.SetVisibilityToMesh(textbox.meshHandles[i].index, false);
         }
         return;
     }
@@ -202,7 +213,7 @@ void UISystem::SetTextbox(Entity entity)
 	float totalWidth = 0.f;
 
     size_t freeMeshIndex = 0;
-    std::vector<size_t> newMeshIDs;
+    std::vector<MeshHandle> newMeshHandles;
     for (c = text.begin(); c != text.end(); ++c) {
         if (*c < 0 || *c > 127) continue;
         FontCharacter& ch = font->characters[*c];
@@ -221,15 +232,15 @@ void UISystem::SetTextbox(Entity entity)
         //size_t meshID = graphicsManager.LoadTextCharacterMesh();
 
         size_t meshID;
-        // If the textbox already has assigned meshIDs, reuse them
-        if (freeMeshIndex < textbox.meshIDs.size()) {
-			meshID = textbox.meshIDs[freeMeshIndex++];
+        // If the textbox already has assigned meshes, reuse them
+        if (freeMeshIndex < textbox.meshHandles.size()) {
+			meshID = textbox.meshHandles[freeMeshIndex++].index;
             graphicsManager.SetVisibilityToMesh(meshID, true);
 		}
         // Otherwise, create a new mesh
 		else {
 			meshID = graphicsManager.LoadTextCharacterMesh();
-            newMeshIDs.push_back(meshID);
+            newMeshHandles.push_back(graphicsManager.meshes.GetHandle(meshID));
 		}
 
         SetCharacterToMesh(meshID, fontUUID, *c);
@@ -258,25 +269,31 @@ void UISystem::SetTextbox(Entity entity)
 		totalWidth += increment;
     }	
 
-	// If there are more meshIDs than needed, hide the excess
-    for (size_t i = freeMeshIndex; i < textbox.meshIDs.size(); ++i) {
-        graphicsManager.SetVisibilityToMesh(textbox.meshIDs[i], false);
-		//graphicsManager.RemoveFromBatch(GraphicsManager::BatchIndex::UI_TEXT_BATCH, textbox.meshIDs[i]);
+	// If there are more meshes than needed, hide a few spares for text that changes length often
+	// and give the rest back, so a textbox that once held a long string does not keep its meshes
+    size_t keptMeshes = std::min(textbox.meshHandles.size(), freeMeshIndex + SPARE_TEXT_MESHES);
+    for (size_t i = freeMeshIndex; i < keptMeshes; ++i) {
+        graphicsManager.SetVisibilityToMesh(textbox.meshHandles[i].index, false);
 	}
-    // If there are new meshIDs created, add them to the textbox's meshIDs
-    if (!newMeshIDs.empty()) {
-        textbox.meshIDs.insert(textbox.meshIDs.end(), newMeshIDs.begin(), newMeshIDs.end());
+    for (size_t i = keptMeshes; i < textbox.meshHandles.size(); ++i) {
+        graphicsManager.ReleaseMesh(textbox.meshHandles[i].index);
+    }
+    textbox.meshHandles.resize(keptMeshes);
+
+    // If there are new meshes created, add them to the textbox's meshes
+    if (!newMeshHandles.empty()) {
+        textbox.meshHandles.insert(textbox.meshHandles.end(), newMeshHandles.begin(), newMeshHandles.end());
 		graphicsManager.SetBatchUpdateFlag(GraphicsManager::BatchIndex::UI_TEXT_BATCH, true);
     }
 
 	if (textbox.centerAligned) {
 		totalWidth = (2.0f * totalWidth) / screenWidth; // Convert to NDC
 		// Center the text
-		for (size_t i = 0; i < textbox.meshIDs.size(); ++i) {
-			graphicsManager.meshes[textbox.meshIDs[i]].vertices[0].position.x -= totalWidth / 2.f;
-			graphicsManager.meshes[textbox.meshIDs[i]].vertices[1].position.x -= totalWidth / 2.f;
-			graphicsManager.meshes[textbox.meshIDs[i]].vertices[2].position.x -= totalWidth / 2.f;
-			graphicsManager.meshes[textbox.meshIDs[i]].vertices[3].position.x -= totalWidth / 2.f;
+		for (MeshHandle handle : textbox.meshHandles) {
+			graphicsManager.meshes[handle.index].vertices[0].position.x -= totalWidth / 2.f;
+			graphicsManager.meshes[handle.index].vertices[1].position.x -= totalWidth / 2.f;
+			graphicsManager.meshes[handle.index].vertices[2].position.x -= totalWidth / 2.f;
+			graphicsManager.meshes[handle.index].vertices[3].position.x -= totalWidth / 2.f;
 		}
 	}
 }
@@ -284,7 +301,7 @@ void UISystem::SetTextbox(Entity entity)
 void UISystem::SetCharacterToMesh(size_t meshID, std::string fontUUID, char character)
 {
     auto& graphicsManager = GraphicsManager::GetInstance();
-    if (meshID >= graphicsManager.meshes.size()) return;
+    if (!graphicsManager.meshes.IsAlive(meshID)) return;
 
 	auto font = AssetManager::GetInstance().Get<Font>(fontUUID);
 
@@ -380,8 +397,9 @@ void UISystem::SetVisibility(Entity entity, bool visible)
     auto textbox = ECSManager::GetInstance().TryGetComponent<Textbox>(entity);
 
     if (textbox.has_value()) {
-        for (auto const& meshID : textbox->get().meshIDs) {
-            GraphicsManager::GetInstance().SetVisibilityToMesh(meshID, visible);
+        for (MeshHandle handle : textbox->get().meshHandles) {
+            if (!GraphicsManager::GetInstance().meshes.IsValid(handle)) continue;
+            GraphicsManager::GetInstance().SetVisibilityToMesh(handle.index, visible);
 		}
 	}
     else if (renderer.has_value()) {
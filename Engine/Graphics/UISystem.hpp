@@ -149,4 +149,7 @@ public:
 	* \return The NDC position
 	*/
 	Vec3 NormalisedScreenToNDC(Vec3 screenPos);
+
+private:
+	static constexpr size_t SPARE_TEXT_MESHES = 8; // Hidden meshes a textbox keeps when its text gets shorter
 };
\ No newline at end of file
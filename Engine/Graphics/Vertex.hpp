@@ -16,6 +16,10 @@ prior written consent of DigiPen Institute of Technology is prohibited.
  *********************************************************************/
 #pragma once
 
+#include <cstdint>
+#include <algorithm>
+#include <glm/gtc/packing.hpp>
+
 #include "Vec.hpp"
 
  /*!*****************************************************************************
@@ -139,4 +143,73 @@ inline Vertex::Vertex(
 	texArray(texArrayID),
 	texLayer(texLayerID),
 	visible(visible)
-{}
\ No newline at end of file
+{}
+
+ /*!*****************************************************************************
+ \struct PackedVertex
+ \brief
+	 The 20-byte vertex layout that batches upload to the GPU.
+
+	 Meshes are edited as `Vertex` and converted when they are copied into a
+	 batch. The normal is dropped, the depth is stored as a half float, the
+	 color as RGBA8 and the texture coordinates as 16-bit normalized values.
+	 The texture array, texture layer and visibility share one 16-bit word.
+
+ *******************************************************************************/
+struct PackedVertex
+{
+	static constexpr uint16_t VISIBLE_BIT = 0x8000;		// Set if the vertex is visible
+	static constexpr uint16_t ARRAY_SHIFT = 10;			// Texture array ID is stored in bits 10-14
+	static constexpr uint16_t ARRAY_MASK = 0x1F;
+	static constexpr uint16_t LAYER_MASK = 0x3FF;		// Texture layer ID is stored in bits 0-9
+	static constexpr uint16_t NO_TEXTURE = LAYER_MASK;	// Layer value used when the vertex has no texture
+	static constexpr int MAX_TEXTURE_LAYERS = NO_TEXTURE;	// Layers that can be referenced by a packed vertex
+
+	float x, y;				// Position in 2D space
+	uint16_t depth;			// Position z as a half float
+	uint16_t texture;		// Visibility, texture array ID and texture layer ID
+	uint8_t color[4];		// Color in RGBA8 format
+	uint16_t texCoord[2];	// Texture coordinates normalized to [0, 1]
+
+	PackedVertex() = default;
+
+	/*!*****************************************************************************
+	\brief
+		Packs a vertex into the compact layout.
+	\param vertex
+		The vertex to pack.
+	\param texRect
+		Region of the texture layer holding the mesh's image, see Texture::texRect.
+		The vertex's texture coordinates are mapped into it.
+	*******************************************************************************/
+	explicit PackedVertex(Vertex const& vertex, Vec4 const& texRect = Vec4(0.f, 0.f, 1.f, 1.f));
+};
+
+static_assert(sizeof(PackedVertex) == 20, "PackedVertex must match the attribute layout in BatchData::Init");
+
+inline PackedVertex::PackedVertex(Vertex const& vertex, Vec4 const& texRect) :
+	x(vertex.position.x),
+	y(vertex.position.y),
+	depth(static_cast<uint16_t>(glm::packHalf1x16(vertex.position.z)))
+{
+	auto toUnorm8 = [](float value) {
+		return static_cast<uint8_t>(std::clamp(value, 0.f, 1.f) * 255.f + 0.5f);
+	};
+	auto toUnorm16 = [](float value) {
+		return static_cast<uint16_t>(std::clamp(value, 0.f, 1.f) * 65535.f + 0.5f);
+	};
+
+	color[0] = toUnorm8(vertex.color.r);
+	color[1] = toUnorm8(vertex.color.g);
+	color[2] = toUnorm8(vertex.color.b);
+	color[3] = toUnorm8(vertex.color.a);
+	// Clamped before the mapping so an image in an atlas never samples its neighbours
+	texCoord[0] = toUnorm16(texRect.x + std::clamp(vertex.texCoord.x, 0.f, 1.f) * texRect.z);
+	texCoord[1] = toUnorm16(texRect.y + std::clamp(vertex.texCoord.y, 0.f, 1.f) * texRect.w);
+
+	bool textured = vertex.texArray >= 0 && vertex.texLayer >= 0 && vertex.texLayer < MAX_TEXTURE_LAYERS;
+	texture = static_cast<uint16_t>(
+		(vertex.visible ? VISIBLE_BIT : 0)
+		| ((textured ? static_cast<uint16_t>(vertex.texArray) & ARRAY_MASK : 0) << ARRAY_SHIFT)
+		| (textured ? static_cast<uint16_t>(vertex.texLayer) : NO_TEXTURE));
+}
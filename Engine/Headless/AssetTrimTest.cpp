@@ -0,0 +1,134 @@
+/*********************************************************************
+ * \file		AssetTrimTest.cpp
+ * \brief		Checks that AssetManager::Trim evicts assets sharing
+ *				pages a page at a time, least recently used first,
+ *				keeps every page holding a referenced asset, and that
+ *				an emptied atlas page takes images again.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../AssetManager.hpp"
+#include "../Graphics/AtlasPacker.hpp"
+
+namespace {
+	int failures = 0;
+
+	void Check(bool condition, std::string const& what) {
+		if (!condition) {
+			std::printf("FAILED: %s\n", what.c_str());
+			++failures;
+		}
+	}
+
+	constexpr size_t PAGE_SIZE = 100;
+
+	/**
+	 * \brief An image on an atlas page, or one with storage of its own that it does not free.
+	 */
+	struct PagedAsset : IAsset {
+		int page = NO_PAGE;
+		size_t size = 0;
+
+		bool LoadFromFile(const std::string&) override { return false; }
+		size_t GetMemorySize() const override { return size; }
+		int GetPage(size_t& pageSize) const override {
+			pageSize = PAGE_SIZE;
+			return page;
+		}
+		bool IsEvictableAlone() const override { return false; }
+	};
+
+	void Add(std::string const& uuid, int page, size_t size = 0) {
+		auto asset = AssetManager::GetInstance().CreateTexture<PagedAsset>(uuid);
+		asset->page = page;
+		asset->size = size;
+	}
+
+	bool IsLoaded(std::string const& uuid) {
+		return AssetManager::GetInstance().Find<PagedAsset>(uuid) != nullptr;
+	}
+
+	void CheckLoaded(std::vector<std::string> const& loaded, std::vector<std::string> const& evicted, std::string const& when) {
+		for (std::string const& uuid : loaded) {
+			Check(IsLoaded(uuid), uuid + " was evicted " + when);
+		}
+		for (std::string const& uuid : evicted) {
+			Check(!IsLoaded(uuid), uuid + " was kept " + when);
+		}
+	}
+
+	void CheckPages() {
+		auto& assetManager = AssetManager::GetInstance();
+
+		// Four pages of two images, used in order, and storage the store cannot free
+		for (int page = 0; page < 4; ++page) {
+			Add("page" + std::to_string(page) + "a", page);
+			Add("page" + std::to_string(page) + "b", page);
+		}
+		Add("own", IAsset::NO_PAGE, 30);
+
+		AssetResidency residency = assetManager.GetResidency<PagedAsset>();
+		Check(residency.pages == 4, "4 pages in use were reported as " + std::to_string(residency.pages));
+		Check(residency.bytes == 4 * PAGE_SIZE + 30, "pages were not counted once each: " + std::to_string(residency.bytes) + " bytes");
+
+		// Page 0 is used last and page 1 is referenced, so pages 2 and 3 go first
+		assetManager.Find<PagedAsset>("page0a");
+		assetManager.Retain<PagedAsset>("page1b");
+		assetManager.SetBudget<PagedAsset>(2 * PAGE_SIZE + 30);
+		size_t evicted = assetManager.Trim<PagedAsset>();
+		Check(evicted == 4, "evicting two pages evicted " + std::to_string(evicted) + " images");
+		CheckLoaded({ "page0a", "page0b", "page1a", "page1b", "own" }, { "page2a", "page2b", "page3a", "page3b" }, "by the first trim");
+
+		residency = assetManager.GetResidency<PagedAsset>();
+		Check(residency.pages == 2 && residency.bytes == 2 * PAGE_SIZE + 30, "the pages left were not reported");
+
+		// A page with a referenced image is kept over budget, with the unreferenced image on it
+		assetManager.SetBudget<PagedAsset>(0);
+		assetManager.Trim<PagedAsset>();
+		CheckLoaded({ "page1a", "page1b", "own" }, { "page0a", "page0b" }, "by trimming to nothing");
+
+		assetManager.Release<PagedAsset>("page1b");
+		assetManager.Trim<PagedAsset>();
+		CheckLoaded({ "own" }, { "page1a", "page1b" }, "once the page was released");
+		Check(assetManager.GetResidency<PagedAsset>().unloads == 8, "every image evicted was not counted as unloaded");
+	}
+
+	void CheckClearPage() {
+		AtlasPacker packer(64, 64, 2, 2);
+		AtlasPacker::Placement first, second, third;
+		Check(packer.Insert(60, 60, first) && first.page == 0, "the first image did not open page 0");
+		Check(packer.Insert(60, 60, second) && second.page == 1, "the second image did not open page 1");
+		Check(!packer.Insert(60, 60, third), "an image was placed in a full atlas");
+
+		packer.ClearPage(0);
+		Check(packer.GetPageCount() == 2, "clearing a page closed it");
+		Check(packer.Insert(60, 60, third) && third.page == 0 && third.rect.x == first.rect.x && third.rect.y == first.rect.y,
+			"an image did not take the place left on the cleared page");
+
+		// The cooked layout reserves its places again on a cleared page
+		packer.ClearPage(1);
+		Check(packer.Reserve(second), "a cleared page did not take its cooked placement back");
+		Check(!packer.Reserve(second), "a placement was reserved twice");
+	}
+}
+
+int main() {
+	CheckPages();
+	CheckClearPage();
+
+	std::printf("%d failures\n", failures);
+	return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,303 @@
+/*********************************************************************
+ * \file		AtlasCook.cpp
+ * \brief		Packs the images under an asset folder, trimmed of their
+ *				transparent borders, into atlas pages offline, writes
+ *				the layout Texture::LoadAtlasLayout reads, and compares
+ *				it with exact-size texture arrays.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include "../Graphics/AtlasPacker.hpp"
+#include "../Graphics/Texture.hpp"
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	constexpr int BYTES_PER_TEXEL = 4;
+	constexpr int INITIAL_ARRAY_LAYERS = 8;	// TextureArray's initialAllocatedLayers
+
+	/**
+	 * \struct CookOptions
+	 * \brief Command line options of the atlas cooker.
+	 */
+	struct CookOptions {
+		std::string assets = "../Assets";
+		std::string output;		// Defaults to TextureAtlas.layout in the asset folder
+		bool dryRun = false;	// Report only, do not write the layout
+	};
+
+	/**
+	 * \struct Image
+	 * \brief An image found under the asset folder.
+	 */
+	struct Image {
+		std::string path;		// Relative to the asset folder
+		int width = 0, height = 0;
+		AtlasPacker::Rect trimmed;	// Part of the image Texture::DecodeImage keeps for the atlas
+	};
+
+	void PrintUsage() {
+		std::printf(
+			"Usage: kigen_atlas_cook [--assets DIR] [--output FILE] [--dry-run]\n"
+			"  --assets DIR   Folder searched for .png images (default ../Assets)\n"
+			"  --output FILE  Layout to write (default DIR/TextureAtlas.layout)\n"
+			"  --dry-run      Print the report without writing the layout\n");
+	}
+
+	bool ParseOptions(int argc, char* argv[], CookOptions& options) {
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			bool hasValue = i + 1 < argc;
+
+			if (arg == "--assets" && hasValue) {
+				options.assets = argv[++i];
+			}
+			else if (arg == "--output" && hasValue) {
+				options.output = argv[++i];
+			}
+			else if (arg == "--dry-run") {
+				options.dryRun = true;
+			}
+			else {
+				return false;
+			}
+		}
+		if (options.output.empty()) {
+			options.output = (std::filesystem::path(options.assets) / "TextureAtlas.layout").string();
+		}
+		return true;
+	}
+
+	std::vector<Image> FindImages(CookOptions const& options) {
+		std::vector<Image> images;
+		for (auto const& entry : std::filesystem::recursive_directory_iterator(options.assets)) {
+			std::string extension = entry.path().extension().string();
+			std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			if (!entry.is_regular_file() || extension != ".png") {
+				continue;
+			}
+
+			Image image;
+			image.path = entry.path().lexically_relative(options.assets).generic_string();
+			std::string filePath = entry.path().string();
+			int channels = 0;
+			// Same orientation and trim as Texture::DecodeImage
+			stbi_set_flip_vertically_on_load(true);
+			unsigned char* data = stbi_load(filePath.c_str(), &image.width, &image.height, &channels, 0);
+			if (!data) {
+				std::printf("Skipped unreadable image %s\n", filePath.c_str());
+				continue;
+			}
+			image.trimmed = AtlasPacker::Trim(data, image.width, image.height, channels);
+			if (image.trimmed.width == 0) {
+				image.trimmed = AtlasPacker::Rect{ 0, 0, 1, 1 };
+			}
+			stbi_image_free(data);
+			images.push_back(image);
+		}
+
+		// Directory order differs between platforms, so sort to keep the layout stable
+		std::sort(images.begin(), images.end(), [](Image const& a, Image const& b) { return a.path < b.path; });
+		return images;
+	}
+
+	bool FitsInPage(int width, int height) {
+		int padded = 2 * Texture::ATLAS_PADDING;
+		return width > 0 && height > 0 && width + padded <= Texture::ATLAS_PAGE_SIZE && height + padded <= Texture::ATLAS_PAGE_SIZE;
+	}
+
+	double ToMegabytes(double bytes) {
+		return bytes / (1024.0 * 1024.0);
+	}
+
+	/**
+	 * \brief Texture arrays Texture::SetTextureArrayToUse would create, and what they cost.
+	 */
+	template<typename Filter>
+	void ReportExactArrays(std::vector<Image> const& images, char const* label, Filter filter) {
+		std::map<std::pair<int, int>, int> layersBySize;
+		for (Image const& image : images) {
+			if (filter(image)) {
+				++layersBySize[{ image.width, image.height }];
+			}
+		}
+
+		double bytes = 0.0;
+		int growthBlits = 0;
+		for (auto const& [size, layers] : layersBySize) {
+			// Arrays start with 8 layers and double, blitting every layer, whenever they run out
+			int allocated = INITIAL_ARRAY_LAYERS;
+			while (layers > allocated) {
+				growthBlits += allocated;
+				allocated *= 2;
+			}
+			bytes += static_cast<double>(size.first) * size.second * BYTES_PER_TEXEL * allocated;
+		}
+		std::printf("%-28s %8zu arrays %10.1f MB %8d layers blitted while growing\n",
+			label, layersBySize.size(), ToMegabytes(bytes), growthBlits);
+	}
+
+	bool WriteLayout(std::string const& path, std::vector<Image> const& images, std::vector<AtlasPacker::Placement> const& placements) {
+		rapidjson::StringBuffer buffer;
+		rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+		writer.StartObject();
+		writer.Key("Page Size");
+		writer.Int(Texture::ATLAS_PAGE_SIZE);
+		writer.Key("Padding");
+		writer.Int(Texture::ATLAS_PADDING);
+		writer.Key("Trimmed");
+		writer.Bool(true);
+		writer.Key("Textures");
+		writer.StartArray();
+		for (size_t i = 0; i < images.size(); ++i) {
+			if (placements[i].page < 0) {
+				continue;
+			}
+			writer.StartObject();
+			writer.Key("Path");
+			writer.String(images[i].path.c_str());
+			writer.Key("Page");
+			writer.Int(placements[i].page);
+			writer.Key("X");
+			writer.Int(placements[i].rect.x);
+			writer.Key("Y");
+			writer.Int(placements[i].rect.y);
+			writer.Key("Width");
+			writer.Int(placements[i].rect.width);
+			writer.Key("Height");
+			writer.Int(placements[i].rect.height);
+			writer.Key("Trim X");
+			writer.Int(images[i].trimmed.x);
+			writer.Key("Trim Y");
+			writer.Int(images[i].trimmed.y);
+			writer.EndObject();
+		}
+		writer.EndArray();
+		writer.EndObject();
+
+		std::ofstream file(path);
+		if (!file.is_open()) {
+			return false;
+		}
+		file << buffer.GetString() << '\n';
+		return true;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	CookOptions options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+	if (!std::filesystem::is_directory(options.assets)) {
+		std::printf("Asset folder %s does not exist\n", options.assets.c_str());
+		return EXIT_FAILURE;
+	}
+
+	std::vector<Image> images = FindImages(options);
+	std::vector<std::pair<int, int>> sizes;
+	std::vector<std::pair<int, int>> untrimmedSizes;
+	std::vector<size_t> eligible;
+	for (size_t i = 0; i < images.size(); ++i) {
+		if (FitsInPage(images[i].width, images[i].height)) {
+			sizes.emplace_back(images[i].trimmed.width, images[i].trimmed.height);
+			untrimmedSizes.emplace_back(images[i].width, images[i].height);
+			eligible.push_back(i);
+		}
+	}
+
+	const int maxPages = 1 << 16;	// Offline the page count is the result, checked against the budget below
+	AtlasPacker cooked(Texture::ATLAS_PAGE_SIZE, Texture::ATLAS_PAGE_SIZE, Texture::ATLAS_PADDING, maxPages);
+	Clock::time_point start = Clock::now();
+	std::vector<AtlasPacker::Placement> packed = cooked.Pack(sizes);
+	double cookMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+	// Online insertion in load order, as Texture::LoadFromFile does without a cooked layout
+	AtlasPacker online(Texture::ATLAS_PAGE_SIZE, Texture::ATLAS_PAGE_SIZE, Texture::ATLAS_PADDING, maxPages);
+	start = Clock::now();
+	for (auto const& size : sizes) {
+		AtlasPacker::Placement placement;
+		online.Insert(size.first, size.second, placement);
+	}
+	double onlineUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / std::max<size_t>(sizes.size(), 1);
+
+	AtlasPacker untrimmed(Texture::ATLAS_PAGE_SIZE, Texture::ATLAS_PAGE_SIZE, Texture::ATLAS_PADDING, maxPages);
+	untrimmed.Pack(untrimmedSizes);
+
+	std::printf("Images: %zu under %s, %zu fit in a %d x %d page\n\n",
+		images.size(), options.assets.c_str(), eligible.size(), Texture::ATLAS_PAGE_SIZE, Texture::ATLAS_PAGE_SIZE);
+
+	auto fits = [](Image const& image) { return FitsInPage(image.width, image.height); };
+	ReportExactArrays(images, "Exact-size arrays", [](Image const&) { return true; });
+	ReportExactArrays(images, "  for images fitting a page", fits);
+	ReportExactArrays(images, "  for oversized images", [&fits](Image const& image) { return !fits(image); });
+
+	double pageBytes = static_cast<double>(Texture::ATLAS_PAGE_SIZE) * Texture::ATLAS_PAGE_SIZE * BYTES_PER_TEXEL;
+	auto reportAtlas = [pageBytes](char const* label, AtlasPacker const& packer) {
+		// Each array doubles its pages, up to ATLAS_PAGES_PER_ARRAY, as Texture::GetAtlasArray grows it
+		int pages = packer.GetPageCount();
+		int arrays = 0;
+		int allocatedPages = 0;
+		for (int first = 0; first < pages; first += Texture::ATLAS_PAGES_PER_ARRAY, ++arrays) {
+			int used = std::min(pages - first, Texture::ATLAS_PAGES_PER_ARRAY);
+			int allocated = 1;
+			while (allocated < used) {
+				allocated *= 2;
+			}
+			allocatedPages += std::min(allocated, Texture::ATLAS_PAGES_PER_ARRAY);
+		}
+		std::printf("%-28s %8d arrays %10.1f MB %8d pages, %.1f%% occupied\n", label, arrays,
+			ToMegabytes(pageBytes * allocatedPages), pages, packer.GetOccupancy() * 100.0);
+	};
+	reportAtlas("Atlas, cooked", cooked);
+	reportAtlas("Atlas, inserted online", online);
+	reportAtlas("  untrimmed, cooked", untrimmed);
+	std::printf("\nCooking took %.1f ms, inserting online %.1f us per image\n", cookMs, onlineUs);
+
+	if (cooked.GetPageCount() > Texture::ATLAS_MAX_PAGES) {
+		std::printf("\nThe atlas needs %d pages but only has %d (Texture::ATLAS_MAX_PAGES)\n", cooked.GetPageCount(), Texture::ATLAS_MAX_PAGES);
+		return EXIT_FAILURE;
+	}
+
+	if (options.dryRun) {
+		return EXIT_SUCCESS;
+	}
+
+	std::vector<Image> placedImages;
+	std::vector<AtlasPacker::Placement> placements;
+	for (size_t i = 0; i < eligible.size(); ++i) {
+		placedImages.push_back(images[eligible[i]]);
+		placements.push_back(packed[i]);
+	}
+	if (!WriteLayout(options.output, placedImages, placements)) {
+		std::printf("Failed to write %s\n", options.output.c_str());
+		return EXIT_FAILURE;
+	}
+	std::printf("Wrote %s\n", options.output.c_str());
+	return EXIT_SUCCESS;
+}
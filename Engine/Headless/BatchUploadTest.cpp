@@ -0,0 +1,291 @@
+/*********************************************************************
+ * \file		BatchUploadTest.cpp
+ * \brief		Patches one mesh of a batch against a null OpenGL and
+ *				checks that only that mesh's vertices, or its instance,
+ *				are uploaded and counted by BatchData::GetUploadedBytes,
+ *				including a sprite moved only by its transform.
+ *
+ * \author		t.yongchin, 2301359
+ * \email		t.yongchin@digipen.edu
+ * \date		5 November 2024
+ *
+ * Copyright(C) 2024 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Math.hpp"
+#include "../Graphics/BatchData.hpp"
+#include "../Graphics/FrameBuffer.hpp"
+#include "../Graphics/Mesh.hpp"
+#include "../Graphics/Shader.hpp"
+#include "../Graphics/SpriteInstance.hpp"
+#include "../Graphics/Texture.hpp"
+#include "../Graphics/TextureArray.hpp"
+
+/*********************************************************************
+ * OpenGL
+ *
+ * Buffer names are handed out and the bytes passed to glBufferSubData
+ * are counted. The draw calls are never made by the test and are left
+ * null, so a test that reaches one fails loudly.
+ *********************************************************************/
+
+namespace {
+	GLuint nextName = 0;
+	size_t subDataBytes = 0;	// Bytes passed to glBufferSubData since the last reset
+
+	void APIENTRY NullGenNames(GLsizei n, GLuint* names) {
+		for (GLsizei i = 0; i < n; ++i) {
+			names[i] = ++nextName;
+		}
+	}
+}
+
+PFNGLGENBUFFERSPROC glad_glGenBuffers = NullGenNames;
+PFNGLGENVERTEXARRAYSPROC glad_glGenVertexArrays = NullGenNames;
+PFNGLBUFFERSUBDATAPROC glad_glBufferSubData = [](GLenum, GLintptr, GLsizeiptr size, const void*) { subDataBytes += static_cast<size_t>(size); };
+PFNGLBUFFERDATAPROC glad_glBufferData = [](GLenum, GLsizeiptr, const void*, GLenum) {};
+PFNGLBINDBUFFERPROC glad_glBindBuffer = [](GLenum, GLuint) {};
+PFNGLBINDVERTEXARRAYPROC glad_glBindVertexArray = [](GLuint) {};
+PFNGLDELETEBUFFERSPROC glad_glDeleteBuffers = [](GLsizei, const GLuint*) {};
+PFNGLDELETEVERTEXARRAYSPROC glad_glDeleteVertexArrays = [](GLsizei, const GLuint*) {};
+PFNGLENABLEVERTEXATTRIBARRAYPROC glad_glEnableVertexAttribArray = [](GLuint) {};
+PFNGLVERTEXATTRIBDIVISORPROC glad_glVertexAttribDivisor = [](GLuint, GLuint) {};
+PFNGLVERTEXATTRIBIPOINTERPROC glad_glVertexAttribIPointer = [](GLuint, GLint, GLenum, GLsizei, const void*) {};
+PFNGLVERTEXATTRIBPOINTERPROC glad_glVertexAttribPointer = [](GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) {};
+PFNGLDRAWELEMENTSPROC glad_glDrawElements = nullptr;
+PFNGLDRAWELEMENTSINSTANCEDPROC glad_glDrawElementsInstanced = nullptr;
+PFNGLDRAWELEMENTSINSTANCEDBASEINSTANCEPROC glad_glDrawElementsInstancedBaseInstance = nullptr;
+PFNGLMULTIDRAWELEMENTSPROC glad_glMultiDrawElements = nullptr;
+PFNGLLINEWIDTHPROC glad_glLineWidth = nullptr;
+PFNGLPOLYGONMODEPROC glad_glPolygonMode = nullptr;
+PFNGLVIEWPORTPROC glad_glViewport = nullptr;
+
+/*********************************************************************
+ * Shaders, framebuffers and textures
+ *
+ * Only drawing uses them, which the test never does.
+ *********************************************************************/
+
+void Shader::Use() {}
+GLint Shader::Uniform(std::string_view) const { return -1; }
+void FrameBuffer::Bind() {}
+void FrameBuffer::Unbind() {}
+
+TextureArray::TextureArray(GLuint id_gl, int width, int height, int initialAllocatedLayers) :
+	id_gl(id_gl), currentLayers(0), allocatedLayers(initialAllocatedLayers), width(width), height(height), isAtlas(false) {}
+void TextureArray::Bind(int) {}
+
+std::array<TextureArray, 32> Texture::textureArrays;
+
+namespace {
+	int failures = 0;
+
+	void Check(bool condition, std::string const& what) {
+		if (!condition) {
+			std::printf("FAILED: %s\n", what.c_str());
+			++failures;
+		}
+	}
+
+	constexpr size_t MESH_COUNT = 8;
+	constexpr size_t PATCHED_MESH = 5;
+
+	/**
+	 * \brief A quad from GraphicsManager::LoadQuadMesh, moved along x so every mesh differs.
+	 */
+	Mesh MakeQuad(float x, Vec4 const& color) {
+		std::vector<Vertex> vertices = {
+			Vertex(Vec3(x - 0.5f,  0.5f, 0.f), color, Vec3(), Vec2(0.f, 1.f)), // Top left
+			Vertex(Vec3(x + 0.5f,  0.5f, 0.f), color, Vec3(), Vec2(1.f, 1.f)), // Top right
+			Vertex(Vec3(x + 0.5f, -0.5f, 0.f), color, Vec3(), Vec2(1.f, 0.f)), // Bottom right
+			Vertex(Vec3(x - 0.5f, -0.5f, 0.f), color, Vec3(), Vec2(0.f, 0.f))  // Bottom left
+		};
+		std::vector<unsigned int> indices(std::begin(SpriteInstance::QUAD_INDICES), std::end(SpriteInstance::QUAD_INDICES));
+		std::vector<Vec3> modelSpace;
+		for (Vertex const& vertex : vertices) {
+			modelSpace.push_back(vertex.position);
+		}
+		return Mesh(vertices, indices, modelSpace, 0);
+	}
+
+	/**
+	 * \brief Fills a batch with the meshes the way GraphicsManager::UpdateBatch does, and uploads it.
+	 */
+	void Rebuild(BatchData& batch, std::vector<Mesh> const& meshes, bool useInstancing) {
+		batch.meshIDs.clear();
+		batch.vertices.clear();
+		batch.indices.clear();
+		batch.instances.clear();
+		batch.meshSlots.clear();
+		batch.useInstancing = useInstancing;
+
+		std::vector<Vertex> clipped;
+		for (size_t meshID = 0; meshID < meshes.size(); ++meshID) {
+			Mesh const& mesh = meshes[meshID];
+			std::vector<Vertex> const& drawn = mesh.GetDrawnVertices(clipped);
+			batch.meshIDs.push_back(meshID);
+			if (useInstancing) {
+				SpriteInstance instance;
+				SpriteInstance::FromQuad(drawn, mesh.indices, instance, mesh.texRect);
+				batch.meshSlots[meshID] = { batch.instances.size(), mesh.vertices.size() };
+				batch.instances.push_back(instance);
+				continue;
+			}
+
+			unsigned int vertexOffset = static_cast<unsigned int>(batch.vertices.size());
+			batch.meshSlots[meshID] = { vertexOffset, mesh.vertices.size() };
+			for (Vertex const& vertex : drawn) {
+				batch.vertices.emplace_back(vertex, mesh.texRect);
+			}
+			for (unsigned int index : mesh.indices) {
+				batch.indices.push_back(index + vertexOffset);
+			}
+		}
+		batch.isUpdated = true;
+		batch.MarkAllDirty();
+		batch.UpdateBuffers();
+	}
+
+	/**
+	 * \brief Recolors one mesh, patches it in and checks only its slot is uploaded.
+	 */
+	void CheckPatch(bool useInstancing) {
+		std::string mode = useInstancing ? "instanced" : "vertex";
+		std::vector<Mesh> meshes;
+		for (size_t i = 0; i < MESH_COUNT; ++i) {
+			meshes.push_back(MakeQuad(static_cast<float>(i), Vec4(1.f, 1.f, 1.f, 1.f)));
+		}
+
+		BatchData batch(0, GL_TRIANGLES, GL_FILL);
+		batch.Init();
+		Rebuild(batch, meshes, useInstancing);
+
+		// Nothing changed, nothing is uploaded
+		BatchData::ResetUploadStats();
+		subDataBytes = 0;
+		batch.UpdateBuffers();
+		Check(BatchData::GetUploadedBytes() == 0, mode + " batch with no changes uploaded " + std::to_string(BatchData::GetUploadedBytes()) + " bytes");
+
+		std::vector<PackedVertex> verticesBefore = batch.vertices;
+		std::vector<SpriteInstance> instancesBefore = batch.instances;
+
+		for (Vertex& vertex : meshes[PATCHED_MESH].vertices) {
+			vertex.color = Vec4(1.f, 0.f, 0.f, 1.f);
+		}
+		batch.MarkMeshDirty(PATCHED_MESH);
+		std::vector<Vertex> clipped;
+		Check(batch.PatchMesh(PATCHED_MESH, meshes[PATCHED_MESH], clipped), mode + " batch could not patch a recolored quad");
+		batch.UpdateBuffers();
+
+		size_t expected = useInstancing ? sizeof(SpriteInstance) : SpriteInstance::CORNER_COUNT * sizeof(PackedVertex);
+		Check(BatchData::GetUploadedBytes() == expected, mode + " batch counted " + std::to_string(BatchData::GetUploadedBytes())
+			+ " bytes for one patched mesh, expected " + std::to_string(expected));
+		Check(subDataBytes == BatchData::GetUploadedBytes(), mode + " batch counted " + std::to_string(BatchData::GetUploadedBytes())
+			+ " bytes but passed " + std::to_string(subDataBytes) + " to glBufferSubData");
+
+		// Only the patched slot changed
+		size_t changed = 0, changedOutsideSlot = 0;
+		if (useInstancing) {
+			for (size_t i = 0; i < batch.instances.size(); ++i) {
+				bool isChanged = std::memcmp(&batch.instances[i], &instancesBefore[i], sizeof(SpriteInstance)) != 0;
+				changed += isChanged;
+				changedOutsideSlot += isChanged && i != PATCHED_MESH;
+			}
+		}
+		else {
+			size_t first = batch.meshSlots[PATCHED_MESH].firstVertex;
+			for (size_t i = 0; i < batch.vertices.size(); ++i) {
+				bool isChanged = std::memcmp(&batch.vertices[i], &verticesBefore[i], sizeof(PackedVertex)) != 0;
+				changed += isChanged;
+				changedOutsideSlot += isChanged && (i < first || i >= first + SpriteInstance::CORNER_COUNT);
+			}
+		}
+		Check(changed > 0, mode + " batch did not change when a mesh was patched");
+		Check(changedOutsideSlot == 0, mode + " batch changed " + std::to_string(changedOutsideSlot) + " elements outside the patched slot");
+
+		// A mesh that gained a vertex no longer fits its slot
+		meshes[PATCHED_MESH].vertices.push_back(meshes[PATCHED_MESH].vertices.back());
+		Check(!batch.PatchMesh(PATCHED_MESH, meshes[PATCHED_MESH], clipped), mode + " batch patched a mesh whose vertex count changed");
+
+		batch.Exit();
+	}
+
+	/**
+	 * \brief Moves one sprite by its transform alone and checks only its instance is placed and uploaded.
+	 */
+	void CheckMove() {
+		std::vector<Mesh> meshes;
+		for (size_t i = 0; i < MESH_COUNT; ++i) {
+			meshes.push_back(MakeQuad(static_cast<float>(i), Vec4(1.f, 1.f, 1.f, 1.f)));
+		}
+
+		BatchData batch(0, GL_TRIANGLES, GL_FILL);
+		batch.Init();
+		Rebuild(batch, meshes, true);
+		std::vector<SpriteInstance> instancesBefore = batch.instances;
+
+		Mesh& moved = meshes[PATCHED_MESH];
+		moved.SetModelToWorld(Mat4::BuildTranslation(3.f, 4.f, 0.25f) * Mat4::BuildZRotation(30.f) * Mat4::BuildScaling(2.f, -1.f, 1.f));
+		batch.MarkMeshMoved(PATCHED_MESH);
+		Check(batch.movedMeshes.size() == 1 && batch.dirtyMeshes.empty(), "moving a sprite of an instanced batch did not mark it as moved");
+
+		BatchData::ResetUploadStats();
+		subDataBytes = 0;
+		Check(batch.PatchTransform(PATCHED_MESH, moved), "instanced batch could not place a moved sprite from its transform");
+		batch.UpdateBuffers();
+		Check(BatchData::GetUploadedBytes() == sizeof(SpriteInstance), "instanced batch counted " + std::to_string(BatchData::GetUploadedBytes())
+			+ " bytes for one moved sprite, expected " + std::to_string(sizeof(SpriteInstance)));
+		Check(subDataBytes == BatchData::GetUploadedBytes(), "instanced batch counted " + std::to_string(BatchData::GetUploadedBytes())
+			+ " bytes but passed " + std::to_string(subDataBytes) + " to glBufferSubData");
+		Check(moved.arePositionsStale, "placing a sprite from its transform transformed its vertices");
+
+		// The instance is where the transformed vertices would have put it
+		Mesh transformed = moved;
+		transformed.UpdatePositions();
+		SpriteInstance expected;
+		Check(SpriteInstance::FromQuad(transformed.vertices, transformed.indices, expected, transformed.texRect), "the moved sprite is no longer a plain sprite");
+		SpriteInstance const& placed = batch.instances[batch.meshSlots[PATCHED_MESH].firstVertex];
+		bool matches = placed.depth == expected.depth && placed.texture == expected.texture;
+		for (size_t corner = 0; corner < SpriteInstance::CORNER_COUNT; ++corner) {
+			Vec2 difference = placed.GetCornerPosition(corner) - expected.GetCornerPosition(corner);
+			matches = matches && std::abs(difference.x) < 1e-4f && std::abs(difference.y) < 1e-4f;
+		}
+		Check(matches, "instance placed from the transform differs from the one built from the transformed vertices");
+
+		size_t changedOutsideSlot = 0;
+		for (size_t i = 0; i < batch.instances.size(); ++i) {
+			changedOutsideSlot += i != PATCHED_MESH && std::memcmp(&batch.instances[i], &instancesBefore[i], sizeof(SpriteInstance)) != 0;
+		}
+		Check(changedOutsideSlot == 0, "instanced batch changed " + std::to_string(changedOutsideSlot) + " instances besides the moved one");
+
+		// A vertex batch has no instances to place, so a moved mesh is patched like any other change
+		BatchData vertexBatch(1, GL_TRIANGLES, GL_FILL);
+		vertexBatch.Init();
+		Rebuild(vertexBatch, meshes, false);
+		vertexBatch.MarkMeshMoved(PATCHED_MESH);
+		Check(vertexBatch.movedMeshes.empty() && vertexBatch.dirtyMeshes.size() == 1, "moving a mesh of a vertex batch did not mark it as changed");
+		Check(!vertexBatch.PatchTransform(PATCHED_MESH, moved), "vertex batch placed a mesh from its transform");
+
+		batch.Exit();
+		vertexBatch.Exit();
+	}
+}
+
+int main() {
+	CheckPatch(false);
+	CheckPatch(true);
+	CheckMove();
+
+	std::printf("%zu meshes, mesh %zu patched, %d failures\n", MESH_COUNT, PATCHED_MESH, failures);
+	return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
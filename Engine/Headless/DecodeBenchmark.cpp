@@ -0,0 +1,198 @@
+/*********************************************************************
+ * \file		DecodeBenchmark.cpp
+ * \brief		Decodes the images under an asset folder on one thread
+ *				and then on the job system with more and more workers,
+ *				the way TextureLoader decodes them.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include "../Utility/JobSystem.hpp"
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * \struct BenchmarkOptions
+	 * \brief Command line options of the decode benchmark.
+	 */
+	struct BenchmarkOptions {
+		std::string assets = "../Assets";
+		size_t limit = 200;		// Images decoded per run, the largest first
+		int maxWorkers = -1;	// Defaults to one fewer than the hardware threads, as JobSystem does
+	};
+
+	/**
+	 * \struct DecodeRun
+	 * \brief Totals of one pass over the images.
+	 */
+	struct DecodeRun {
+		double ms = 0.0;
+		size_t bytes = 0;		// Decoded pixel bytes
+		size_t failed = 0;
+	};
+
+	void PrintUsage() {
+		std::printf(
+			"Usage: kigen_decode_benchmark [--assets DIR] [--limit N] [--max-workers N]\n"
+			"  --assets DIR       Folder searched for .png images (default ../Assets)\n"
+			"  --limit N          Images decoded per run, largest files first (default 200)\n"
+			"  --max-workers N    Most job system workers to try (default hardware threads - 1)\n");
+	}
+
+	bool ParseOptions(int argc, char* argv[], BenchmarkOptions& options) {
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			bool hasValue = i + 1 < argc;
+
+			if (arg == "--assets" && hasValue) {
+				options.assets = argv[++i];
+			}
+			else if (arg == "--limit" && hasValue) {
+				options.limit = static_cast<size_t>(std::max(std::atoi(argv[++i]), 1));
+			}
+			else if (arg == "--max-workers" && hasValue) {
+				options.maxWorkers = std::max(std::atoi(argv[++i]), 0);
+			}
+			else {
+				return false;
+			}
+		}
+		if (options.maxWorkers < 0) {
+			unsigned hardwareThreads = std::thread::hardware_concurrency();
+			options.maxWorkers = hardwareThreads > 1 ? static_cast<int>(hardwareThreads) - 1 : 0;
+		}
+		return true;
+	}
+
+	std::vector<std::string> FindImages(BenchmarkOptions const& options) {
+		std::vector<std::pair<uintmax_t, std::string>> found;
+		for (auto const& entry : std::filesystem::recursive_directory_iterator(options.assets)) {
+			std::string extension = entry.path().extension().string();
+			std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			if (entry.is_regular_file() && extension == ".png") {
+				found.emplace_back(entry.file_size(), entry.path().string());
+			}
+		}
+
+		// Largest first, so a limited run still covers the images that dominate loading
+		std::sort(found.begin(), found.end(), [](auto const& a, auto const& b) {
+			return a.first != b.first ? a.first > b.first : a.second < b.second;
+		});
+		std::vector<std::string> paths;
+		for (size_t i = 0; i < found.size() && i < options.limit; ++i) {
+			paths.push_back(found[i].second);
+		}
+		return paths;
+	}
+
+	/**
+	 * \brief Decodes one image the way Texture::DecodeImage does, without the atlas padding.
+	 */
+	size_t Decode(std::string const& path) {
+		int width, height, channels;
+		stbi_set_flip_vertically_on_load_thread(true);
+		unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+		if (!data) {
+			return 0;
+		}
+		stbi_image_free(data);
+		return static_cast<size_t>(width) * height * channels;
+	}
+
+	DecodeRun DecodeSerially(std::vector<std::string> const& paths) {
+		DecodeRun run;
+		Clock::time_point start = Clock::now();
+		for (std::string const& path : paths) {
+			size_t bytes = Decode(path);
+			run.bytes += bytes;
+			run.failed += bytes == 0;
+		}
+		run.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		return run;
+	}
+
+	DecodeRun DecodeWithJobs(std::vector<std::string> const& paths, int workers) {
+		JobSystem& jobSystem = JobSystem::GetInstance();
+		jobSystem.Initialize(workers);
+
+		std::atomic<size_t> bytes{ 0 }, failed{ 0 };
+		JobCounter counter;
+		Clock::time_point start = Clock::now();
+		for (std::string const& path : paths) {
+			jobSystem.Submit([&path, &bytes, &failed]() {
+				size_t decoded = Decode(path);
+				bytes += decoded;
+				failed += decoded == 0;
+			}, counter);
+		}
+		jobSystem.Wait(counter);
+
+		DecodeRun run;
+		run.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		run.bytes = bytes;
+		run.failed = failed;
+		jobSystem.Shutdown();
+		return run;
+	}
+
+	void PrintRun(char const* label, int workers, DecodeRun const& run, double serialMs) {
+		double seconds = std::max(run.ms, 1e-3) / 1000.0;
+		std::printf("%-10s %7d %10.1f %12.1f %9.2fx\n", label, workers, run.ms,
+			static_cast<double>(run.bytes) / (1024.0 * 1024.0) / seconds, serialMs / std::max(run.ms, 1e-3));
+	}
+}
+
+int main(int argc, char* argv[]) {
+	BenchmarkOptions options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+	if (!std::filesystem::is_directory(options.assets)) {
+		std::printf("Asset folder %s does not exist\n", options.assets.c_str());
+		return EXIT_FAILURE;
+	}
+
+	std::vector<std::string> paths = FindImages(options);
+	if (paths.empty()) {
+		std::printf("No images under %s\n", options.assets.c_str());
+		return EXIT_FAILURE;
+	}
+
+	// Warm the file cache so every run measures decoding rather than the disk
+	DecodeSerially(paths);
+
+	DecodeRun serial = DecodeSerially(paths);
+	std::printf("Images: %zu under %s, %.1f MB decoded, %zu failed, %u hardware threads\n\n",
+		paths.size(), options.assets.c_str(), static_cast<double>(serial.bytes) / (1024.0 * 1024.0), serial.failed,
+		std::thread::hardware_concurrency());
+	std::printf("%-10s %7s %10s %12s %10s\n", "", "Workers", "Time (ms)", "MB/s", "Speedup");
+	PrintRun("Serial", 0, serial, serial.ms);
+
+	// The submitting thread helps while it waits, so n workers decode on n + 1 threads
+	for (int workers = 1; workers <= options.maxWorkers; ++workers) {
+		PrintRun("Jobs", workers, DecodeWithJobs(paths, workers), serial.ms);
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,380 @@
+/*********************************************************************
+ * \file		HeadlessMain.cpp
+ * \brief		Loads a scene and steps the CPU-side systems for a
+ *				fixed number of ticks without a window, GPU, audio
+ *				device or script runtime, then reports per-system
+ *				timings, how long each system ran alongside others,
+ *				and the assets the scene references.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		20 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "../ECS/ECSManager.hpp"
+#include "../ECS/SystemScheduler.hpp"
+#include "../AssetManager.hpp"
+#include "../Components/Renderer.hpp"
+#include "../Graphics/GraphicsManager.hpp"
+#include "../Scene/SceneAssets.hpp"
+#include "../Utility/JobSystem.hpp"
+#include "../Utility/Profiler.hpp"
+#include "../Utility/Serializer.hpp"
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * \struct RunOptions
+	 * \brief Command line options of the headless runner.
+	 */
+	struct RunOptions {
+		std::string scenePath = "../Assets/Scenes/NANO_Level1.scene";
+		std::vector<std::string> soakScenes;	// Extra scenes cycled through with scenePath by the soak test
+		int soakCycles = 0;
+		int ticks = 600;
+		double fixedDt = 1.0 / 60.0;
+		int workerThreads = -1;
+		std::string tracePath;
+	};
+
+	/**
+	 * \struct SystemTiming
+	 * \brief Accumulated update times of one system.
+	 */
+	struct SystemTiming {
+		const char* name;
+		double total = 0.0;
+		double max = 0.0;
+		double overlap = 0.0;	// Time spent running while another system was running.
+
+		void Add(double seconds) {
+			total += seconds;
+			max = std::max(max, seconds);
+		}
+	};
+
+	/**
+	 * \struct SystemSpan
+	 * \brief When a system ran during the current tick.
+	 */
+	struct SystemSpan {
+		Clock::time_point start;
+		Clock::time_point end;
+		bool ran = false;
+	};
+
+	/**
+	 * \brief Adds to each system's overlap the part of its span during which any other system ran.
+	 */
+	void AddOverlaps(std::vector<SystemSpan> const& spans, std::vector<SystemTiming>& timings) {
+		std::vector<std::pair<Clock::time_point, Clock::time_point>> shared;
+		for (size_t i = 0; i < spans.size(); ++i) {
+			if (!spans[i].ran) continue;
+
+			shared.clear();
+			for (size_t j = 0; j < spans.size(); ++j) {
+				if (j == i || !spans[j].ran) continue;
+				Clock::time_point start = std::max(spans[i].start, spans[j].start);
+				Clock::time_point end = std::min(spans[i].end, spans[j].end);
+				if (start < end) shared.emplace_back(start, end);
+			}
+
+			// Merge the shared ranges so time shared with several systems is only counted once.
+			std::sort(shared.begin(), shared.end());
+			Clock::duration overlap{};
+			Clock::time_point covered = spans[i].start;
+			for (auto const& [start, end] : shared) {
+				Clock::time_point from = std::max(start, covered);
+				if (from < end) {
+					overlap += end - from;
+					covered = end;
+				}
+			}
+			timings[i].overlap += std::chrono::duration<double>(overlap).count();
+		}
+	}
+
+	double SecondsSince(Clock::time_point start) {
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	void PrintUsage() {
+		std::printf(
+			"Usage: kigen_headless [scene...] [--ticks N] [--dt SECONDS] [--threads N] [--trace FILE] [--soak N]\n"
+			"  scene        Scene file to load (default ../Assets/Scenes/NANO_Level1.scene)\n"
+			"               Further scenes are only loaded by the soak test\n"
+			"  --ticks N    Number of fixed ticks to simulate (default 600)\n"
+			"  --dt S       Length of a tick in seconds (default 1/60)\n"
+			"  --threads N  Worker threads, 0 to run everything on the main thread (default: one per core)\n"
+			"  --trace F    Write a Chrome trace of every tick to F\n"
+			"  --soak N     Afterwards, unload and load the scenes N times, check the mesh count stays flat\n"
+			"               and report the assets each load keeps from the one before\n");
+	}
+
+	bool ParseOptions(int argc, char* argv[], RunOptions& options) {
+		bool scenePathSet = false;
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			bool hasValue = i + 1 < argc;
+
+			if (arg == "--ticks" && hasValue) {
+				options.ticks = std::atoi(argv[++i]);
+			}
+			else if (arg == "--dt" && hasValue) {
+				options.fixedDt = std::atof(argv[++i]);
+			}
+			else if (arg == "--threads" && hasValue) {
+				options.workerThreads = std::atoi(argv[++i]);
+			}
+			else if (arg == "--trace" && hasValue) {
+				options.tracePath = argv[++i];
+			}
+			else if (arg == "--soak" && hasValue) {
+				options.soakCycles = std::atoi(argv[++i]);
+			}
+			else if (arg == "--help" || arg == "-h" || arg.rfind("--", 0) == 0) {
+				return false;
+			}
+			else if (!scenePathSet) {
+				options.scenePath = arg;
+				scenePathSet = true;
+			}
+			else {
+				options.soakScenes.push_back(arg);
+			}
+		}
+		return options.ticks > 0 && options.fixedDt > 0.0 && options.soakCycles >= 0;
+	}
+
+	/**
+	 * \brief Reports the assets of each type referenced and loaded. Nothing is loaded without the
+	 *        backends, but the references the scenes hold are counted the same.
+	 */
+	void PrintResidency() {
+		constexpr double MEGABYTE = 1024.0 * 1024.0;
+		std::printf("%-10s %9s %11s %6s %9s %7s %8s\n", "Assets", "Loaded", "Referenced", "Pages", "MB", "Loads", "Unloads");
+		for (AssetResidency const& residency : AssetManager::GetInstance().GetResidency()) {
+			std::printf("%-10s %9zu %11zu %6zu %9.1f %7llu %8llu\n", residency.type, residency.resident, residency.referenced,
+				residency.pages, residency.bytes / MEGABYTE, static_cast<unsigned long long>(residency.loads), static_cast<unsigned long long>(residency.unloads));
+		}
+	}
+
+	/**
+	 * \brief Unloads and loads the scenes over and over, the way switching levels does, and
+	 *        reports the mesh pool and the assets kept from the scene before after each load.
+	 *
+	 * Part of each scene is then destroyed entity by entity, as gameplay does, and the meshes
+	 * left alive must match the renderers left.
+	 *
+	 * \return False if the pool grew after the first pass over the scenes, or meshes outlived their entities.
+	 */
+	bool RunSoak(RunOptions const& options, SceneAssets& sceneAssets) {
+		constexpr int SOAK_TICKS = 30;
+
+		auto& ecs = ECSManager::GetInstance();
+		MeshPool const& meshes = GraphicsManager::GetInstance().meshes;
+
+		std::vector<std::string> scenes{ options.scenePath };
+		scenes.insert(scenes.end(), options.soakScenes.begin(), options.soakScenes.end());
+
+		std::printf("\nSoak: %d loads over %zu scene(s), %d ticks each\n", options.soakCycles, scenes.size(), SOAK_TICKS);
+		std::printf("%-6s %-32s %9s %9s %9s %9s %7s %7s %9s\n", "Load", "Scene", "Entities", "Live", "Dead", "Slots", "Kept", "Added", "Released");
+
+		size_t firstPassSlots = 0;
+		size_t laterSlots = 0;
+		bool meshesOutlivedEntities = false;
+		for (int cycle = 0; cycle < options.soakCycles; ++cycle) {
+			std::string const& scenePath = scenes[cycle % scenes.size()];
+
+			// Same teardown as SceneManager::LoadScene
+			ecs.physicsSystem->Exit();
+			ecs.renderSystem->Exit();
+			ecs.ClearEntities();
+
+			Serializer::GetInstance().DeserializeScene(scenePath);
+			ecs.transformSystem->Init();
+			ecs.renderSystem->Init();
+			ecs.physicsSystem->Init();
+			ecs.animationSystem->Init();
+			ecs.stateMachineSystem->Init();
+			ecs.cameraSystem->Init();
+			SceneAssets::Transition transition = sceneAssets.Acquire();
+
+			for (int tick = 0; tick < SOAK_TICKS; ++tick) {
+				ecs.physicsSystem->Update(options.fixedDt);
+				ecs.physicsSystem->DispatchCollisionEvents();
+				ecs.transformSystem->Update(options.fixedDt);
+				ecs.animationSystem->Update(options.fixedDt);
+			}
+
+			// Every fourth entity is destroyed; their meshes must go with them
+			std::vector<Entity> living = ecs.GetEntityManager().GetLivingEntities();
+			for (size_t i = 0; i < living.size(); i += 4) {
+				ecs.DestroyEntity(living[i]);
+			}
+			size_t renderers = 0;
+			ecs.GetView<Renderer>().ForEach([&renderers](Entity, Renderer& renderer) { renderers += renderer.isInitialized; });
+			if (meshes.GetLiveCount() != renderers) {
+				std::printf("%zu live meshes for %zu renderers after destroying entities\n", meshes.GetLiveCount(), renderers);
+				meshesOutlivedEntities = true;
+			}
+
+			size_t& slots = static_cast<size_t>(cycle) < scenes.size() ? firstPassSlots : laterSlots;
+			slots = std::max(slots, meshes.size());
+			std::printf("%-6d %-32s %9zu %9zu %9zu %9zu %7zu %7zu %9zu\n", cycle + 1, std::filesystem::path(scenePath).filename().string().c_str(),
+				ecs.GetEntityManager().GetLivingEntities().size(), meshes.GetLiveCount(), meshes.GetDeadCount(), meshes.size(),
+				transition.kept, transition.added, transition.released);
+		}
+
+		if (laterSlots > firstPassSlots) {
+			std::printf("Mesh slots grew from %zu to %zu after the first pass\n", firstPassSlots, laterSlots);
+			return false;
+		}
+		std::printf("Mesh slots stayed at or below %zu\n", firstPassSlots);
+		return !meshesOutlivedEntities;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	RunOptions options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+
+	for (std::string const& scenePath : options.soakScenes) {
+		if (!std::filesystem::exists(scenePath)) {
+			std::fprintf(stderr, "Scene not found: %s\n", scenePath.c_str());
+			return EXIT_FAILURE;
+		}
+	}
+	if (!std::filesystem::exists(options.scenePath)) {
+		std::fprintf(stderr, "Scene not found: %s\n", options.scenePath.c_str());
+		return EXIT_FAILURE;
+	}
+
+	PROFILE_THREAD("Main");
+	JobSystem::GetInstance().Initialize(options.workerThreads);
+
+	auto& ecs = ECSManager::GetInstance();
+	ecs.Initialize();
+
+	Clock::time_point loadStart = Clock::now();
+	Serializer::GetInstance().DeserializeScene(options.scenePath);
+	double loadTime = SecondsSince(loadStart);
+
+	Clock::time_point initStart = Clock::now();
+	ecs.transformSystem->Init();
+	ecs.renderSystem->Init();
+	ecs.physicsSystem->Init();
+	ecs.animationSystem->Init();
+	ecs.stateMachineSystem->Init();
+	ecs.cameraSystem->Init();
+	ecs.audioSystem->Init();
+	// VideoPlayerSystem::Init is skipped: it reads each clip's texture layers, which are never loaded without a GPU.
+	double initTime = SecondsSince(initStart);
+
+	SceneAssets sceneAssets;
+	sceneAssets.Acquire();
+
+	// Same order as MainScene::Update, minus the systems that need a GPU or scripts. Audio and
+	// VideoPlayer run against the null backends, so the time Physics shares with them can be seen.
+	enum { VIDEO_PLAYER, PHYSICS, AUDIO, CAMERA, STATE_MACHINE, TRANSFORM, ANIMATION };
+	std::vector<SystemTiming> timings{ { "VideoPlayer" }, { "Physics" }, { "Audio" }, { "Camera" }, { "StateMachine" }, { "Transform" }, { "Animation" } };
+	std::vector<SystemSpan> spans(timings.size());
+	std::vector<double> tickTimes;
+	tickTimes.reserve(options.ticks);
+
+	// Each task only writes its own timing and span entries, so they are safe to record from worker threads.
+	auto timed = [&timings, &spans](int index, auto&& update) {
+		return [&timings, &spans, index, update]() {
+			Clock::time_point start = Clock::now();
+			update();
+			Clock::time_point end = Clock::now();
+			timings[index].Add(std::chrono::duration<double>(end - start).count());
+			spans[index] = { start, end, true };
+		};
+	};
+
+	if (!options.tracePath.empty()) {
+		Profiler::GetInstance().StartCapture(options.tracePath);
+	}
+
+	SystemScheduler scheduler;
+	const double dt = options.fixedDt;
+	for (int tick = 0; tick < options.ticks; ++tick) {
+		Clock::time_point tickStart = Clock::now();
+
+		scheduler.Add("VideoPlayer", *ecs.videoPlayerSystem, timed(VIDEO_PLAYER, [&] { ecs.videoPlayerSystem->Update(dt); }));
+		scheduler.Add("Physics", *ecs.physicsSystem, timed(PHYSICS, [&] { ecs.physicsSystem->Update(dt); }));
+		scheduler.Add("Audio", *ecs.audioSystem, timed(AUDIO, [&] { ecs.audioSystem->Update(dt); }));
+		scheduler.Run();
+		ecs.physicsSystem->DispatchCollisionEvents();
+
+		scheduler.Add("Camera", *ecs.cameraSystem, timed(CAMERA, [&] { ecs.cameraSystem->Update(); }));
+		scheduler.Add("StateMachine", *ecs.stateMachineSystem, timed(STATE_MACHINE, [&] { ecs.stateMachineSystem->Update(dt); }));
+		scheduler.Add("Transform", *ecs.transformSystem, timed(TRANSFORM, [&] { ecs.transformSystem->Update(dt); }));
+		scheduler.Add("Animation", *ecs.animationSystem, timed(ANIMATION, [&] { ecs.animationSystem->Update(dt); }));
+		scheduler.Run();
+
+		tickTimes.push_back(SecondsSince(tickStart));
+		AddOverlaps(spans, timings);
+		spans.assign(spans.size(), SystemSpan{});
+		PROFILE_FRAME();
+	}
+
+	if (!options.tracePath.empty() && !Profiler::GetInstance().StopCapture()) {
+		std::fprintf(stderr, "Failed to write trace: %s\n", options.tracePath.c_str());
+	}
+
+	double totalTime = 0.0;
+	for (double t : tickTimes) totalTime += t;
+	std::vector<double> sortedTicks = tickTimes;
+	std::sort(sortedTicks.begin(), sortedTicks.end());
+	auto percentile = [&sortedTicks](double p) {
+		return sortedTicks[std::min(sortedTicks.size() - 1, static_cast<size_t>(p * sortedTicks.size()))];
+	};
+
+	std::printf("Scene:    %s\n", options.scenePath.c_str());
+	std::printf("Entities: %u\n", static_cast<unsigned>(ecs.GetEntityManager().GetLivingEntities().size()));
+	std::printf("Workers:  %zu\n", JobSystem::GetInstance().GetNumWorkers());
+	std::printf("Load:     %.3f ms\n", loadTime * 1000.0);
+	std::printf("Init:     %.3f ms\n", initTime * 1000.0);
+	std::printf("Ticks:    %d x %.4f s\n\n", options.ticks, dt);
+
+	std::printf("%-14s %12s %12s %12s %8s %13s\n", "System", "Total (ms)", "Avg (ms)", "Max (ms)", "Share", "Overlap (ms)");
+	for (SystemTiming const& timing : timings) {
+		std::printf("%-14s %12.3f %12.4f %12.4f %7.1f%% %13.3f\n",
+			timing.name, timing.total * 1000.0, timing.total * 1000.0 / options.ticks, timing.max * 1000.0,
+			totalTime > 0.0 ? timing.total / totalTime * 100.0 : 0.0, timing.overlap * 1000.0);
+	}
+	std::printf("%-14s %12.3f %12.4f %12.4f\n\n", "Tick", totalTime * 1000.0, totalTime * 1000.0 / options.ticks, sortedTicks.back() * 1000.0);
+	std::printf("Tick p50 %.4f ms, p95 %.4f ms, p99 %.4f ms\n\n", percentile(0.50) * 1000.0, percentile(0.95) * 1000.0, percentile(0.99) * 1000.0);
+	PrintResidency();
+
+	bool soakPassed = options.soakCycles == 0 || RunSoak(options, sceneAssets);
+	if (options.soakCycles > 0) {
+		std::printf("\n");
+		PrintResidency();
+	}
+	sceneAssets.Release();
+
+	ecs.physicsSystem->Exit();
+	ecs.renderSystem->Exit();
+	JobSystem::GetInstance().Shutdown();
+	return soakPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
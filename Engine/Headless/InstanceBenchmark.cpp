@@ -0,0 +1,216 @@
+/*********************************************************************
+ * \file		InstanceBenchmark.cpp
+ * \brief		Compares what moving sprites costs with transformed and
+ *				packed vertices and with instances placed from the
+ *				transform. SpriteInstanceTest checks the results match.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Math.hpp"
+#include "../Graphics/SpriteInstance.hpp"
+#include "../Graphics/Vertex.hpp"
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * \struct BenchmarkOptions
+	 * \brief Command line options of the instance benchmark.
+	 */
+	struct BenchmarkOptions {
+		int frames = 200;
+		double movedPercent = 10.0;	// Sprites whose transform changes each frame.
+	};
+
+	/**
+	 * \struct BenchSprite
+	 * \brief A sprite made the way RenderSystem makes one: a quad from LoadQuadMesh moved by a transform.
+	 */
+	struct BenchSprite {
+		Vec3 modelSpacePosition[SpriteInstance::CORNER_COUNT];
+		std::vector<Vertex> vertices;
+		Mat4 modelToWorld;
+		float x, y, z, rotation, scaleX, scaleY;
+	};
+
+	/**
+	 * \struct PathTimes
+	 * \brief Average time and bytes per frame of each path.
+	 */
+	struct PathTimes {
+		double vertexUs = 0.0;
+		double instanceUs = 0.0;
+		size_t vertexBytes = 0;
+		size_t instanceBytes = 0;
+	};
+
+	const std::vector<unsigned int> QUAD_INDICES(std::begin(SpriteInstance::QUAD_INDICES), std::end(SpriteInstance::QUAD_INDICES));
+
+	void PrintUsage() {
+		std::printf(
+			"Usage: kigen_instance_benchmark [--frames N] [--moved PERCENT]\n"
+			"  --frames N       Frames simulated per sprite count (default 200)\n"
+			"  --moved PERCENT  Sprites moved each frame (default 10)\n");
+	}
+
+	bool ParseOptions(int argc, char* argv[], BenchmarkOptions& options) {
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			bool hasValue = i + 1 < argc;
+
+			if (arg == "--frames" && hasValue) {
+				options.frames = std::atoi(argv[++i]);
+			}
+			else if (arg == "--moved" && hasValue) {
+				options.movedPercent = std::atof(argv[++i]);
+			}
+			else {
+				return false;
+			}
+		}
+		return options.frames > 0 && options.movedPercent >= 0.0 && options.movedPercent <= 100.0;
+	}
+
+	// Same composition as TransformSystem.
+	void UpdateTransform(BenchSprite& sprite) {
+		sprite.modelToWorld = Mat4::BuildTranslation(sprite.x, sprite.y, sprite.z)
+			* Mat4::BuildZRotation(sprite.rotation)
+			* Mat4::BuildScaling(sprite.scaleX, sprite.scaleY, 1.f);
+	}
+
+	// Same as the vertex transform in RenderSystem::Update, which sprites drawn as instances skip.
+	void TransformVertices(BenchSprite& sprite) {
+		for (size_t i = 0; i < SpriteInstance::CORNER_COUNT; ++i) {
+			sprite.vertices[i].position = sprite.modelToWorld * sprite.modelSpacePosition[i];
+		}
+	}
+
+	std::vector<BenchSprite> MakeSprites(size_t count, std::mt19937& rng) {
+		std::uniform_real_distribution<float> position(-5000.f, 5000.f);
+		std::uniform_real_distribution<float> depth(-10.f, 10.f);
+		std::uniform_real_distribution<float> angle(-180.f, 180.f);
+		std::uniform_real_distribution<float> scale(-400.f, 400.f);	// Negative scales flip the sprite
+		std::uniform_real_distribution<float> unit(0.f, 1.f);
+		std::uniform_int_distribution<int> frame(0, 7);
+		std::uniform_int_distribution<int> texture(-1, 7);
+
+		std::vector<BenchSprite> sprites(count);
+		for (BenchSprite& sprite : sprites) {
+			// Quad from GraphicsManager::LoadQuadMesh, showing one frame of an 8 frame sprite sheet
+			float u0 = frame(rng) / 8.f, u1 = u0 + 1.f / 8.f;
+			Vec4 color(unit(rng), unit(rng), unit(rng), 1.f);
+			int texArray = texture(rng);
+			int texLayer = texArray < 0 ? -1 : frame(rng);
+			sprite.vertices = {
+				Vertex(Vec3(-0.25f,  0.25f, 0.f), color, Vec3(), Vec2(u0, 1.f), texArray, texLayer), // Top left
+				Vertex(Vec3( 0.25f,  0.25f, 0.f), color, Vec3(), Vec2(u1, 1.f), texArray, texLayer), // Top right
+				Vertex(Vec3( 0.25f, -0.25f, 0.f), color, Vec3(), Vec2(u1, 0.f), texArray, texLayer), // Bottom right
+				Vertex(Vec3(-0.25f, -0.25f, 0.f), color, Vec3(), Vec2(u0, 0.f), texArray, texLayer)  // Bottom left
+			};
+			for (size_t i = 0; i < SpriteInstance::CORNER_COUNT; ++i) sprite.modelSpacePosition[i] = sprite.vertices[i].position;
+
+			sprite.x = position(rng);
+			sprite.y = position(rng);
+			sprite.z = depth(rng);
+			sprite.rotation = angle(rng);
+			sprite.scaleX = scale(rng);
+			sprite.scaleY = scale(rng);
+			UpdateTransform(sprite);
+			TransformVertices(sprite);
+		}
+		return sprites;
+	}
+
+	PathTimes Run(size_t count, BenchmarkOptions const& options) {
+		const unsigned seed = 2301345;
+		size_t moved = std::max<size_t>(1, static_cast<size_t>(count * options.movedPercent / 100.0));
+		PathTimes times;
+
+		std::mt19937 rng(seed);
+		std::vector<BenchSprite> sprites = MakeSprites(count, rng);
+		std::uniform_int_distribution<size_t> pick(0, count - 1);
+		std::uniform_real_distribution<float> nudge(-5.f, 5.f);
+
+		// The batch contents each path keeps for upload, as in GraphicsManager::UpdateBatch
+		std::vector<PackedVertex> vertices(count * SpriteInstance::CORNER_COUNT);
+		std::vector<SpriteInstance> instances(count);
+		for (size_t i = 0; i < count; ++i) {
+			SpriteInstance::FromQuad(sprites[i].vertices, QUAD_INDICES, instances[i]);
+		}
+
+		Clock::duration vertexTotal{}, instanceTotal{};
+		std::vector<size_t> movedSprites(moved);
+		for (int frame = 0; frame < options.frames; ++frame) {
+			for (size_t& index : movedSprites) {
+				index = pick(rng);
+				BenchSprite& sprite = sprites[index];
+				sprite.x += nudge(rng);
+				sprite.y += nudge(rng);
+				sprite.rotation += nudge(rng);
+				UpdateTransform(sprite);
+			}
+
+			// Vertex path: RenderSystem transforms the four vertices of every moved sprite and
+			// GraphicsManager::PatchBatch repacks them
+			Clock::time_point start = Clock::now();
+			for (size_t index : movedSprites) {
+				TransformVertices(sprites[index]);
+				for (size_t corner = 0; corner < SpriteInstance::CORNER_COUNT; ++corner) {
+					vertices[index * SpriteInstance::CORNER_COUNT + corner] = PackedVertex(sprites[index].vertices[corner]);
+				}
+			}
+			vertexTotal += Clock::now() - start;
+			times.vertexBytes += moved * SpriteInstance::CORNER_COUNT * sizeof(PackedVertex);
+
+			// Instanced path: GraphicsManager::PatchBatch places the instance of every moved sprite from its transform
+			start = Clock::now();
+			for (size_t index : movedSprites) {
+				instances[index].SetTransform(sprites[index].modelSpacePosition, sprites[index].modelToWorld);
+			}
+			instanceTotal += Clock::now() - start;
+			times.instanceBytes += moved * sizeof(SpriteInstance);
+		}
+
+		times.vertexUs = std::chrono::duration<double, std::micro>(vertexTotal).count() / options.frames;
+		times.instanceUs = std::chrono::duration<double, std::micro>(instanceTotal).count() / options.frames;
+		times.vertexBytes /= options.frames;
+		times.instanceBytes /= options.frames;
+		return times;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	BenchmarkOptions options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+
+	std::printf("Frames per sprite count: %d, %.2f%% of sprites moved per frame\n", options.frames, options.movedPercent);
+	std::printf("Bytes per moved sprite: %zu packed vertices, %zu instance\n\n",
+		SpriteInstance::CORNER_COUNT * sizeof(PackedVertex), sizeof(SpriteInstance));
+	std::printf("%-8s %12s %12s %14s %14s\n", "Sprites", "Vertex us", "Instance us", "Vertex bytes", "Instance bytes");
+
+	for (size_t count : { size_t{ 1000 }, size_t{ 10000 }, size_t{ 50000 } }) {
+		PathTimes times = Run(count, options);
+		std::printf("%-8zu %12.1f %12.1f %14zu %14zu\n", count, times.vertexUs, times.instanceUs, times.vertexBytes, times.instanceBytes);
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,137 @@
+/*********************************************************************
+ * \file		LogBenchmark.cpp
+ * \brief		Measures Logger throughput and the time a Log call
+ *				takes on the calling thread.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		20 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Logger.hpp"
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * \struct BenchmarkOptions
+	 * \brief Command line options of the logger benchmark.
+	 */
+	struct BenchmarkOptions {
+		int producers = 4;
+		int messages = 100000;	// Per producer.
+		int pauseUs = 0;		// Pause between messages, to model steady logging instead of a burst.
+	};
+
+	void PrintUsage() {
+		std::printf(
+			"Usage: kigen_log_benchmark [--producers N] [--messages N] [--pause US]\n"
+			"  --producers N  Threads logging at the same time (default 4)\n"
+			"  --messages N   Messages logged by each thread (default 100000)\n"
+			"  --pause US     Microseconds each thread waits between messages (default 0)\n");
+	}
+
+	bool ParseOptions(int argc, char* argv[], BenchmarkOptions& options) {
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			bool hasValue = i + 1 < argc;
+
+			if (arg == "--producers" && hasValue) {
+				options.producers = std::atoi(argv[++i]);
+			}
+			else if (arg == "--messages" && hasValue) {
+				options.messages = std::atoi(argv[++i]);
+			}
+			else if (arg == "--pause" && hasValue) {
+				options.pauseUs = std::atoi(argv[++i]);
+			}
+			else {
+				return false;
+			}
+		}
+		return options.producers > 0 && options.messages > 0 && options.pauseUs >= 0;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	BenchmarkOptions options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+
+	// The logger writes to ../Logs/log.txt, so run from a scratch directory to keep the benchmark out of the real log.
+	std::filesystem::path root = std::filesystem::temp_directory_path() / "kigen_log_benchmark";
+	std::filesystem::path logFile = root / "Logs" / "log.txt";
+	std::filesystem::create_directories(root / "run");
+	std::filesystem::remove(logFile);
+	std::filesystem::current_path(root / "run");
+
+	Logger& logger = Logger::Instance();
+
+	std::vector<std::vector<float>> latencies(options.producers);
+	std::vector<std::thread> producers;
+
+	Clock::time_point start = Clock::now();
+	for (int producer = 0; producer < options.producers; ++producer) {
+		producers.emplace_back([&options, &logger, &samples = latencies[producer], producer] {
+			samples.reserve(options.messages);
+			for (int i = 0; i < options.messages; ++i) {
+				Clock::time_point callStart = Clock::now();
+				logger.Log(Logger::Level::ERR, "[Benchmark] Producer ", producer, " message ", i, ": entity ", i % 4096, " value ", i * 0.5f);
+				samples.push_back(std::chrono::duration<float, std::micro>(Clock::now() - callStart).count());
+
+				if (options.pauseUs > 0) {
+					std::this_thread::sleep_for(std::chrono::microseconds(options.pauseUs));
+				}
+			}
+		});
+	}
+	for (auto& thread : producers) {
+		thread.join();
+	}
+	double produceTime = std::chrono::duration<double>(Clock::now() - start).count();
+
+	logger.Flush();
+	double totalTime = std::chrono::duration<double>(Clock::now() - start).count();
+
+	std::vector<float> allSamples;
+	for (auto const& samples : latencies) {
+		allSamples.insert(allSamples.end(), samples.begin(), samples.end());
+	}
+	std::sort(allSamples.begin(), allSamples.end());
+	auto percentile = [&allSamples](double p) {
+		return allSamples[std::min(allSamples.size() - 1, static_cast<size_t>(p * allSamples.size()))];
+	};
+
+	size_t written = 0;
+	std::ifstream log(logFile);
+	for (std::string line; std::getline(log, line);) {
+		if (line.find("[Benchmark]") != std::string::npos) ++written;
+	}
+
+	size_t logged = static_cast<size_t>(options.producers) * options.messages;
+	std::printf("Producers: %d x %d messages\n", options.producers, options.messages);
+	std::printf("Produced:  %.0f messages/s (%.3f s)\n", logged / produceTime, produceTime);
+	std::printf("Written:   %zu of %zu (%.1f%% dropped), %.0f messages/s including flush (%.3f s)\n",
+		written, logged, 100.0 * (logged - written) / logged, written / totalTime, totalTime);
+	std::printf("Log call:  p50 %.2f us, p99 %.2f us, p99.9 %.2f us, max %.2f us\n",
+		percentile(0.50), percentile(0.99), percentile(0.999), allSamples.back());
+	std::printf("Log file:  %s\n", logFile.string().c_str());
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,184 @@
+/*********************************************************************
+ * \file		LookupBenchmark.cpp
+ * \brief		Compares fetching components through arrays looked up
+ *				by their typeid name in an unordered_map, as
+ *				ComponentManager used to, against the arrays indexed
+ *				by ComponentTypeID.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+
+#include "../ECS/ComponentManager.hpp"
+#include "../Components/Name.hpp"
+#include "../Components/Rigidbody2D.hpp"
+#include "../Components/Transform.hpp"
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * \struct BenchmarkOptions
+	 * \brief Command line options of the lookup benchmark.
+	 */
+	struct BenchmarkOptions {
+		int entities = 10000;
+		int passes = 200;
+	};
+
+	void PrintUsage() {
+		std::printf(
+			"Usage: kigen_lookup_benchmark [--entities N] [--passes N]\n"
+			"  --entities N   Entities with each component (default 10000)\n"
+			"  --passes N     Passes over every entity per method (default 200)\n");
+	}
+
+	bool ParseOptions(int argc, char* argv[], BenchmarkOptions& options) {
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			bool hasValue = i + 1 < argc;
+
+			if (arg == "--entities" && hasValue) {
+				options.entities = std::atoi(argv[++i]);
+			}
+			else if (arg == "--passes" && hasValue) {
+				options.passes = std::atoi(argv[++i]);
+			}
+			else {
+				return false;
+			}
+		}
+		return options.entities > 0 && options.passes > 0;
+	}
+
+	/**
+	 * \class TypeNameLookup
+	 * \brief The component arrays keyed by the readable typeid name of their type, looked up the
+	 *        way ComponentManager::GetComponentArray did before the component type IDs.
+	 */
+	class TypeNameLookup {
+	public:
+		template<typename T>
+		void RegisterComponent() {
+			componentArrays.insert({ GetReadableTypeName<T>(), std::make_shared<ComponentArray<T>>() });
+		}
+
+		template<typename T>
+		T& GetComponent(Entity entity) {
+			return GetComponentArray<T>()->GetData(entity);
+		}
+
+		template<typename T>
+		void AddComponent(Entity entity, T component) {
+			GetComponentArray<T>()->InsertData(entity, component);
+		}
+
+	private:
+		template <typename T>
+		static std::string GetReadableTypeName() {
+			std::string typeName = typeid(T).name();
+			if (typeName.find("struct ") == 0) {
+				typeName = typeName.substr(7);
+			}
+			else if (typeName.find("class ") == 0) {
+				typeName = typeName.substr(6);
+			}
+			return typeName;
+		}
+
+		template<typename T>
+		std::shared_ptr<ComponentArray<T>> GetComponentArray() {
+			std::string typeName = GetReadableTypeName<T>();
+			return std::static_pointer_cast<ComponentArray<T>>(componentArrays[typeName]);
+		}
+
+		std::unordered_map<std::string, std::shared_ptr<IComponentArray>> componentArrays;
+	};
+
+	/**
+	 * \brief Adds the same components to the same entities in either manager.
+	 */
+	template<typename Manager>
+	void Populate(Manager& manager, int entities) {
+		manager.template RegisterComponent<Transform>();
+		manager.template RegisterComponent<Rigidbody2D>();
+		manager.template RegisterComponent<Name>();
+		for (int i = 0; i < entities; ++i) {
+			Entity entity = static_cast<Entity>(i);
+			Transform transform;
+			transform.position = Vec3(static_cast<float>(i), 0.f, 0.f);
+			manager.AddComponent(entity, transform);
+			Rigidbody2D rigidbody;
+			rigidbody.mass = 1.f + static_cast<float>(i % 7);
+			manager.AddComponent(entity, rigidbody);
+			manager.AddComponent(entity, Name{});
+		}
+	}
+
+	/**
+	 * \brief Touches three components of every entity each pass, as a system reading a few
+	 *        components per entity does.
+	 *
+	 * \return Time taken in milliseconds. The sum read from the components is written to checksum.
+	 */
+	template<typename Manager>
+	double Run(Manager& manager, BenchmarkOptions const& options, double& checksum) {
+		checksum = 0.0;
+		Clock::time_point start = Clock::now();
+		for (int pass = 0; pass < options.passes; ++pass) {
+			for (int i = 0; i < options.entities; ++i) {
+				Entity entity = static_cast<Entity>(i);
+				Transform& transform = manager.template GetComponent<Transform>(entity);
+				Rigidbody2D& rigidbody = manager.template GetComponent<Rigidbody2D>(entity);
+				Name& name = manager.template GetComponent<Name>(entity);
+				checksum += transform.position.x * rigidbody.mass + static_cast<double>(name.name.size());
+			}
+		}
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+}
+
+int main(int argc, char* argv[]) {
+	BenchmarkOptions options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+
+	TypeNameLookup byName;
+	Populate(byName, options.entities);
+	ComponentManager byID;
+	Populate(byID, options.entities);
+
+	double nameChecksum = 0.0;
+	double idChecksum = 0.0;
+	double nameMs = Run(byName, options, nameChecksum);
+	double idMs = Run(byID, options, idChecksum);
+
+	long long fetches = 3LL * options.entities * options.passes;
+	std::printf("%d entities, %d passes, %lld component fetches per method\n\n", options.entities, options.passes, fetches);
+	std::printf("%-22s %11s %11s\n", "Lookup", "Total ms", "ns/fetch");
+	std::printf("%-22s %11.3f %11.2f\n", "typeid name map", nameMs, nameMs * 1e6 / fetches);
+	std::printf("%-22s %11.3f %11.2f\n", "ComponentTypeID", idMs, idMs * 1e6 / fetches);
+	std::printf("Speedup %.1fx\n", nameMs / idMs);
+
+	if (nameChecksum != idChecksum) {
+		std::printf("\nThe lookups read different components\n");
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,184 @@
+/*********************************************************************
+ * \file		NullBackend.cpp
+ * \brief		Null graphics, input, scripting and editor backends
+ *				linked into the headless runner in place of the
+ *				OpenGL, GLFW, Mono and ImGui implementations.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		20 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+// The headless target compiles the CPU-side engine sources unchanged. This file provides the
+// definitions they reference from the modules that are left out of the build. Only what the
+// simulation touches is defined here; anything else fails at link time rather than silently
+// doing nothing.
+
+#include <unordered_map>
+
+#include "../Audio/AudioManager.hpp"
+#include "../ECS/ECSManager.hpp"
+#include "../Graphics/GraphicsManager.hpp"
+#include "../Graphics/RenderSystem.hpp"
+#include "../Graphics/UISystem.hpp"
+#include "../Tools/EditorPanel.hpp"
+#include "../Tools/Scripting/ScriptEngine.hpp"
+#include "../Video/VideoClip.hpp"
+#include "../Components/Renderer.hpp"
+
+/*********************************************************************
+ * Graphics
+ *
+ * GraphicsManager only keeps the CPU copies of the meshes, which the
+ * animation, transform and physics systems read and write. No GPU
+ * resources are ever created.
+ *********************************************************************/
+
+GraphicsManager& GraphicsManager::GetInstance() {
+	static GraphicsManager graphicsManager;
+	return graphicsManager;
+}
+
+GraphicsManager::GraphicsManager() :
+	shaders(), meshes(), batches(), frameBuffers(), debugMode(false), pixelPicking(false), spriteInstancing(false), viewCulling(true), cullMargin(0.1f), drawRanges(), hasDrawRanges(), camera(), activeCamera(0),
+	readFramebuffer(0), drawFramebuffer(0), uniformBuffer(0), cameraSlotStride(0), uniformStaging(), internalFormat(GL_RGBA8) {
+}
+
+GraphicsManager::~GraphicsManager() {
+}
+
+void GraphicsManager::SetBatchUpdateFlag(size_t, bool) {
+}
+
+void GraphicsManager::SetTextureToMesh(size_t, int, int, Vec4 const&, Vec4 const&) {
+}
+
+void Texture::ReleaseEmptyAtlasArrays() {
+}
+
+Shader::~Shader() {
+}
+
+bool Shader::LoadFromFile(const std::string&) {
+	return false;
+}
+
+FrameBuffer::~FrameBuffer() {
+}
+
+RenderSystem::RenderSystem() {
+}
+
+RenderSystem::~RenderSystem() {
+}
+
+void RenderSystem::Init() {
+	for (Entity entity : m_entities) {
+		auto& renderer = ECSManager::GetInstance().GetComponent<Renderer>(entity);
+		if (!renderer.isInitialized) InitRenderer(entity, renderer);
+	}
+}
+
+void RenderSystem::InitRenderer(Entity, Renderer& renderer) {
+	// Give the renderer a quad mesh so animation can write its texture coordinates.
+	std::vector<unsigned int> const indices{ 0, 1, 2, 2, 3, 0 };
+	std::vector<Vertex> vertices{
+		Vertex({ -0.25f,  0.25f, 0.0f }, { 1.0f, 1.0f, 1.0f, 1.0f }, {}, { 0.0f, 1.0f }), // Top left
+		Vertex({  0.25f,  0.25f, 0.0f }, { 1.0f, 1.0f, 1.0f, 1.0f }, {}, { 1.0f, 1.0f }), // Top right
+		Vertex({  0.25f, -0.25f, 0.0f }, { 1.0f, 1.0f, 1.0f, 1.0f }, {}, { 1.0f, 0.0f }), // Bottom right
+		Vertex({ -0.25f, -0.25f, 0.0f }, { 1.0f, 1.0f, 1.0f, 1.0f }, {}, { 0.0f, 0.0f })  // Bottom left
+	};
+	std::vector<Vec3> modelSpacePositions;
+	for (auto const& vertex : vertices) modelSpacePositions.push_back(vertex.position);
+
+	renderer.isInitialized = true;
+	renderer.currentMeshID = GraphicsManager::GetInstance().meshes.Create(vertices, indices, modelSpacePositions, static_cast<size_t>(-1));
+	renderer.currentMeshDebugID = static_cast<size_t>(-1);
+}
+
+void RenderSystem::Exit() {
+	GraphicsManager::GetInstance().meshes.Clear();
+}
+
+void RenderSystem::OnEntityDestroyed(Entity entity) {
+	if (auto renderer = ECSManager::GetInstance().TryGetComponent<Renderer>(entity)) {
+		ReleaseMeshes(renderer->get());
+	}
+}
+
+void RenderSystem::ReleaseMeshes(Renderer& renderer) {
+	// The meshes are not in any batch here, so they go straight back to the pool.
+	if (!renderer.isInitialized) return;
+
+	auto& meshes = GraphicsManager::GetInstance().meshes;
+	if (meshes.IsAlive(renderer.currentMeshID)) meshes.Release(renderer.currentMeshID);
+	renderer.isInitialized = false;
+}
+
+UISystem::UISystem() {
+}
+
+UISystem::~UISystem() {
+}
+
+bool VideoClip::LoadFromFile(const std::string&) {
+	return false;
+}
+
+size_t VideoClip::GetMemorySize() const {
+	return 0;
+}
+
+/*********************************************************************
+ * Audio
+ *
+ * No clip is ever playing.
+ *********************************************************************/
+
+AudioManager& AudioManager::GetInstance() {
+	static AudioManager audioManager;
+	return audioManager;
+}
+
+void AudioManager::Update() {
+}
+
+void AudioManager::PlayClip(Entity, const std::string&, const Vec3&, float, bool, bool) {
+}
+
+bool AudioManager::ClipIsPlaying(Entity, const std::string&) {
+	return false;
+}
+
+FMODWrapper::~FMODWrapper() {
+}
+
+/*********************************************************************
+ * Scripting
+ *
+ * Scripts are not run, so collision callbacks have no listeners. Script
+ * fields are still stored so scenes keep their values when loaded.
+ *********************************************************************/
+
+ScriptFieldMap& ScriptEngine::GetScriptFieldMap(Entity entity) {
+	static std::unordered_map<Entity, ScriptFieldMap> scriptFields;
+	return scriptFields[entity];
+}
+
+void ScriptEngine::OnEntityCollisionEnter(Entity, CollisionCS) {}
+void ScriptEngine::OnEntityCollisionStay(Entity, CollisionCS) {}
+void ScriptEngine::OnEntityCollisionExit(Entity, CollisionCS) {}
+void ScriptEngine::OnEntityTriggerEnter(Entity, ColliderCS) {}
+void ScriptEngine::OnEntityTriggerStay(Entity, ColliderCS) {}
+void ScriptEngine::OnEntityTriggerExit(Entity, ColliderCS) {}
+
+/*********************************************************************
+ * Editor
+ *********************************************************************/
+
+std::list<Gui::Entity> EditorPanel::sceneEntities;
@@ -0,0 +1,214 @@
+/*********************************************************************
+ * \file		PhysicsBenchmark.cpp
+ * \brief		Steps the PhysicsSystem over a field of falling
+ *				bodies and checks the positions it reaches against
+ *				a plain per-body integration of the same forces.
+ *
+ * \author		Wong Woon Li, woonli.wong, 2301308
+ * \email		woonli.wong@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../ECS/ECSManager.hpp"
+#include "../Components/Transform.hpp"
+#include "../Utility/JobSystem.hpp"
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * \struct BenchmarkOptions
+	 * \brief Command line options of the physics benchmark.
+	 */
+	struct BenchmarkOptions {
+		int bodies = 4096;
+		int steps = 600;
+		int workerThreads = -1;
+	};
+
+	void PrintUsage() {
+		std::printf(
+			"Usage: kigen_physics_benchmark [--bodies N] [--steps N] [--threads N]\n"
+			"  --bodies N    Rigidbodies to simulate (default 4096)\n"
+			"  --steps N     Fixed steps of 1/60 s to run (default 600)\n"
+			"  --threads N   Worker threads, 0 to run everything on the main thread (default: one per core)\n");
+	}
+
+	bool ParseOptions(int argc, char* argv[], BenchmarkOptions& options) {
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			bool hasValue = i + 1 < argc;
+
+			if (arg == "--bodies" && hasValue) {
+				options.bodies = std::atoi(argv[++i]);
+			}
+			else if (arg == "--steps" && hasValue) {
+				options.steps = std::atoi(argv[++i]);
+			}
+			else if (arg == "--threads" && hasValue) {
+				options.workerThreads = std::atoi(argv[++i]);
+			}
+			else {
+				return false;
+			}
+		}
+		return options.bodies > 0 && options.steps > 0;
+	}
+
+	constexpr float GRAVITY = 900.f;		// PhysicsSystem's base gravity.
+	constexpr float BODY_SIZE = 16.f;
+	constexpr float COLUMN_SPACING = 64.f;	// Every body falls in its own column, so no two bodies ever touch.
+	constexpr float PUSH_DURATION = 0.5f;
+	constexpr float PUSH_MAGNITUDE = 400.f;
+
+	/**
+	 * \struct ReferenceBody
+	 * \brief One body integrated on its own, the way the PhysicsSystem did before the body store.
+	 */
+	struct ReferenceBody {
+		float x = 0.f, y = 0.f;
+		float vx = 0.f, vy = 0.f;
+		float mass = 1.f, drag = 1.f, gravityScale = 1.f;
+		bool isStatic = false;
+		bool pushed = false;		// Has an upward force over time, as scripts add for jumps.
+		float pushLifetime = 0.f;
+
+		void Step(float dt) {
+			if (isStatic) {
+				return;
+			}
+
+			float fx = 0.f;
+			float fy = 0.f;
+			if (pushed) {
+				fy += PUSH_MAGNITUDE;
+				pushLifetime += dt;
+				pushed = pushLifetime < PUSH_DURATION;
+			}
+			fy -= gravityScale * GRAVITY * mass;
+
+			// Drag is computed from the velocity the body would have after the other forces.
+			float v1x = vx + fx / mass * dt;
+			float v1y = vy + fy / mass * dt;
+			fx -= 0.5f * drag * v1x;
+			fy -= 0.5f * drag * v1y;
+
+			vx += fx / mass * dt;
+			vy += fy / mass * dt;
+			x += vx * dt;
+			y += vy * dt;
+		}
+	};
+
+	/**
+	 * \brief Creates the bodies in the ECS and their references. Every eighth body is static and
+	 *        every fourth one is pushed, so both the batched and the per-force paths are timed.
+	 */
+	std::vector<Entity> CreateBodies(int count, std::vector<ReferenceBody>& references) {
+		auto& ecs = ECSManager::GetInstance();
+		PhysicsSystem& physics = *ecs.physicsSystem;
+
+		std::vector<Entity> entities;
+		entities.reserve(count);
+		references.resize(count);
+		for (int i = 0; i < count; ++i) {
+			ReferenceBody& body = references[i];
+			body.x = static_cast<float>(i) * COLUMN_SPACING;
+			body.y = static_cast<float>(i % 13) * BODY_SIZE;
+			body.mass = 1.f + static_cast<float>(i % 5);
+			body.drag = 0.5f + static_cast<float>(i % 3) * 0.25f;
+			body.gravityScale = (i % 7 == 0) ? 0.5f : 1.f;
+			body.isStatic = i % 8 == 7;
+			body.pushed = !body.isStatic && i % 4 == 1;
+
+			Entity entity = ecs.CreateEntity();
+			Transform transform;
+			transform.position = Vec3(body.x, body.y, 0.f);
+			ecs.AddComponent(entity, transform);
+			physics.AddRigidbodyComponent(entity, Vec2{ body.x, body.y }, Vec2{}, body.mass, body.drag, body.gravityScale, body.isStatic);
+			Vec2 half{ BODY_SIZE / 2.f, BODY_SIZE / 2.f };
+			physics.AddAABBColliderComponent(entity, 0.f, Vec2{ body.x, body.y } - half, Vec2{ body.x, body.y } + half);
+			if (body.pushed) {
+				physics.AddForceOverTime(ecs.GetComponent<Rigidbody2D>(entity), Vec2{ 0.f, 1.f }, PUSH_MAGNITUDE, PUSH_DURATION);
+			}
+			entities.push_back(entity);
+		}
+		return entities;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	BenchmarkOptions options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+
+	JobSystem::GetInstance().Initialize(options.workerThreads);
+	auto& ecs = ECSManager::GetInstance();
+	ecs.Initialize();
+
+	std::vector<ReferenceBody> references;
+	std::vector<Entity> entities = CreateBodies(options.bodies, references);
+
+	const double fixedDt = 1.0 / 60.0;
+	std::vector<double> stepTimes;
+	stepTimes.reserve(options.steps);
+	for (int step = 0; step < options.steps; ++step) {
+		Clock::time_point start = Clock::now();
+		ecs.physicsSystem->Update(fixedDt);
+		stepTimes.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+		for (ReferenceBody& body : references) {
+			body.Step(static_cast<float>(fixedDt));
+		}
+	}
+
+	// Float sums are ordered differently in the batched integration, so allow a small relative error.
+	float maxError = 0.f;
+	int mismatches = 0;
+	for (size_t i = 0; i < entities.size(); ++i) {
+		Rigidbody2D const& rb = ecs.GetComponent<Rigidbody2D>(entities[i]);
+		ReferenceBody const& body = references[i];
+		float error = std::max(std::fabs(rb.position.x - body.x), std::fabs(rb.position.y - body.y));
+		float scale = std::max(1.f, std::max(std::fabs(body.x), std::fabs(body.y)));
+		maxError = std::max(maxError, error / scale);
+		mismatches += error > scale * 1e-3f;
+	}
+
+	std::vector<double> sorted = stepTimes;
+	std::sort(sorted.begin(), sorted.end());
+	double total = 0.0;
+	for (double time : stepTimes) {
+		total += time;
+	}
+	double perStep = total / options.steps;
+
+	std::printf("%d bodies, %d steps, %zu workers\n\n", options.bodies, options.steps, JobSystem::GetInstance().GetNumWorkers());
+	std::printf("%-22s %11s %11s %11s %11s\n", "PhysicsSystem::Update", "Total ms", "ms/step", "p95 ms", "ns/body");
+	std::printf("%-22s %11.3f %11.4f %11.4f %11.2f\n", "", total, perStep, sorted[sorted.size() * 95 / 100], perStep * 1e6 / options.bodies);
+	std::printf("Largest relative position error against the reference %.2e\n", maxError);
+
+	ecs.physicsSystem->Exit();
+	ecs.ClearEntities();
+	JobSystem::GetInstance().Shutdown();
+
+	if (mismatches > 0) {
+		std::printf("\n%d bodies ended away from the reference\n", mismatches);
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,188 @@
+/*********************************************************************
+ * \file		PrefabBenchmark.cpp
+ * \brief		Compares creating copies of each prefab by parsing its
+ *				file for every copy against cloning them together from
+ *				the template PrefabManager caches, and checks both
+ *				create the same entity.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../ECS/ECSManager.hpp"
+#include "../Tools/PrefabManager.hpp"
+#include "../Utility/MetadataHandler.hpp"
+#include "../Utility/Serializer.hpp"
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * \struct BenchmarkOptions
+	 * \brief Command line options of the prefab benchmark.
+	 */
+	struct BenchmarkOptions {
+		std::vector<std::string> prefabs;	// Defaults to every prefab under ../Assets
+		int copies = 32;
+	};
+
+	void PrintUsage() {
+		std::printf(
+			"Usage: kigen_prefab_benchmark [prefab...] [--copies N]\n"
+			"  prefab       Prefab to instantiate (default every .prefab under ../Assets)\n"
+			"  --copies N   Copies of each prefab created per method (default 32)\n");
+	}
+
+	bool ParseOptions(int argc, char* argv[], BenchmarkOptions& options) {
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			bool hasValue = i + 1 < argc;
+
+			if (arg == "--copies" && hasValue) {
+				options.copies = std::atoi(argv[++i]);
+			}
+			else if (!arg.empty() && arg[0] != '-') {
+				options.prefabs.push_back(arg);
+			}
+			else {
+				return false;
+			}
+		}
+
+		if (options.prefabs.empty() && std::filesystem::is_directory("../Assets")) {
+			for (auto const& entry : std::filesystem::recursive_directory_iterator("../Assets")) {
+				if (entry.is_regular_file() && entry.path().extension() == ".prefab") {
+					options.prefabs.push_back(entry.path().generic_string());
+				}
+			}
+			std::sort(options.prefabs.begin(), options.prefabs.end());
+		}
+		return options.copies > 0;
+	}
+
+	void UnloadScene() {
+		auto& ecs = ECSManager::GetInstance();
+		ecs.physicsSystem->Exit();
+		ecs.renderSystem->Exit();
+		ecs.ClearEntities();
+		PrefabManager::GetInstance().prefabsMap.clear();
+	}
+
+	std::string SavePrefab(std::string const& path, Entity entity) {
+		Serializer::GetInstance().SerializePrefab(path, entity);
+		std::ifstream ifs(path);
+		std::string saved((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+		ifs.close();
+		std::filesystem::remove(path);
+		return saved;
+	}
+
+	/**
+	 * \struct PrefabTimes
+	 * \brief Time taken to create every copy of a prefab by each method.
+	 */
+	struct PrefabTimes {
+		double parsedMs = 0.0;
+		double cachedMs = 0.0;
+		bool matched = false;
+	};
+
+	bool RunPrefab(std::string const& prefabPath, BenchmarkOptions const& options, PrefabTimes& times) {
+		std::string prefabID = MetadataHandler::ParseUUIDFromMeta(prefabPath + ".meta");
+		if (prefabID.empty()) {
+			return false;
+		}
+		auto& prefabs = PrefabManager::GetInstance();
+		size_t copies = static_cast<size_t>(options.copies);
+
+		// Read and parse the file for every copy, as every copy used to be
+		UnloadScene();
+		std::vector<Entity> parsed;
+		Clock::time_point start = Clock::now();
+		for (size_t i = 0; i < copies; ++i) {
+			prefabs.ClearPrefabTemplates();
+			parsed.push_back(Serializer::GetInstance().DeserializePrefab(prefabPath));
+		}
+		times.parsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+		std::filesystem::path temporary = std::filesystem::temp_directory_path();
+		std::string fromParsed = SavePrefab((temporary / "kigen_prefab_parsed.prefab").string(), parsed.front());
+
+		// Parsed once, then every copy cloned from the template together
+		UnloadScene();
+		if (!prefabs.GetPrefabTemplate(prefabPath)) {
+			return false;
+		}
+		start = Clock::now();
+		std::vector<uint32_t> cached = prefabs.InstantiatePrefab(prefabID, copies);
+		times.cachedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+		times.matched = cached.size() == copies
+			&& SavePrefab((temporary / "kigen_prefab_cached.prefab").string(), cached.back()) == fromParsed;
+		UnloadScene();
+		return true;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	BenchmarkOptions options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+	if (options.prefabs.empty()) {
+		std::printf("No prefabs to instantiate\n");
+		return EXIT_FAILURE;
+	}
+
+	ECSManager::GetInstance().Initialize();
+
+	std::printf("Copies per prefab: %d\n\n", options.copies);
+	std::printf("%-32s %11s %11s %8s %8s\n", "Prefab", "Parsed ms", "Cached ms", "Speedup", "Matched");
+
+	bool matched = true;
+	PrefabTimes totals;
+	for (std::string const& prefabPath : options.prefabs) {
+		// Without a meta file a prefab has no UUID to be instantiated by
+		if (!MetadataHandler::MetaFileExists(prefabPath)) {
+			std::printf("%-32s skipped, no meta file\n", std::filesystem::path(prefabPath).filename().string().c_str());
+			continue;
+		}
+
+		PrefabTimes times;
+		if (!RunPrefab(prefabPath, options, times)) {
+			std::printf("%-32s cannot be loaded\n", std::filesystem::path(prefabPath).filename().string().c_str());
+			matched = false;
+			continue;
+		}
+		std::printf("%-32s %11.3f %11.3f %7.1fx %8s\n", std::filesystem::path(prefabPath).filename().string().c_str(),
+			times.parsedMs, times.cachedMs, times.parsedMs / times.cachedMs, times.matched ? "yes" : "NO");
+
+		totals.parsedMs += times.parsedMs;
+		totals.cachedMs += times.cachedMs;
+		matched = matched && times.matched;
+	}
+	std::printf("%-32s %11.3f %11.3f %7.1fx\n", "Total", totals.parsedMs, totals.cachedMs, totals.parsedMs / totals.cachedMs);
+
+	if (!matched) {
+		std::printf("\nA prefab cloned from its template is not the same as one parsed from its file\n");
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
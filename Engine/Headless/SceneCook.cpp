@@ -0,0 +1,242 @@
+/*********************************************************************
+ * \file		SceneCook.cpp
+ * \brief		Cooks JSON scenes into the binary scenes the player
+ *				loads, compares how long each takes to load, and
+ *				checks both, and the background scene loader, load
+ *				into the same scene.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../ECS/ECSManager.hpp"
+#include "../Components/Name.hpp"
+#include "../Scene/SceneLoader.hpp"
+#include "../Tools/EditorPanel.hpp"
+#include "../Utility/CookedScene.hpp"
+#include "../Utility/Serializer.hpp"
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	constexpr int LOAD_REPEATS = 5;	// Loads timed per format, the fastest is reported
+
+	/**
+	 * \struct CookOptions
+	 * \brief Command line options of the scene cooker.
+	 */
+	struct CookOptions {
+		std::vector<std::string> scenes;	// Defaults to every scene under ../Assets/Scenes
+		bool verify = false;				// Check the cooked scene loads into the same scene as the JSON
+	};
+
+	void PrintUsage() {
+		std::printf(
+			"Usage: kigen_scene_cook [scene...] [--verify]\n"
+			"  scene      Scene to cook beside itself (default every .scene under ../Assets/Scenes)\n"
+			"  --verify   Load each scene from JSON, from the cooked file and through the background loader\n"
+			"             from JSON, save each, and compare them\n");
+	}
+
+	bool ParseOptions(int argc, char* argv[], CookOptions& options) {
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			if (arg == "--verify") {
+				options.verify = true;
+			}
+			else if (!arg.empty() && arg[0] != '-') {
+				options.scenes.push_back(arg);
+			}
+			else {
+				return false;
+			}
+		}
+
+		if (options.scenes.empty() && std::filesystem::is_directory("../Assets/Scenes")) {
+			for (auto const& entry : std::filesystem::directory_iterator("../Assets/Scenes")) {
+				if (entry.is_regular_file() && entry.path().extension() == ".scene") {
+					options.scenes.push_back(entry.path().generic_string());
+				}
+			}
+			std::sort(options.scenes.begin(), options.scenes.end());
+		}
+		return true;
+	}
+
+	/**
+	 * \brief Clears the scene the same way SceneManager::LoadScene does before loading the next.
+	 */
+	void UnloadScene() {
+		auto& ecs = ECSManager::GetInstance();
+		ecs.physicsSystem->Exit();
+		ecs.renderSystem->Exit();
+		ecs.ClearEntities();
+	}
+
+	template<typename Load>
+	double TimeLoad(Load load) {
+		double best = 0.0;
+		for (int i = 0; i < LOAD_REPEATS; ++i) {
+			UnloadScene();
+			Clock::time_point start = Clock::now();
+			load();
+			double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+			best = i == 0 ? ms : std::min(best, ms);
+		}
+		UnloadScene();
+		return best;
+	}
+
+	/**
+	 * \brief Saves the loaded scene as the editor does, listing the entities in the order they were created.
+	 */
+	std::string SaveLoadedScene(std::string const& path) {
+		auto& ecs = ECSManager::GetInstance();
+		EditorPanel::sceneEntities.clear();
+		for (Entity entity : ecs.GetEntityManager().GetLivingEntities()) {
+			auto name = ecs.TryGetComponent<Name>(entity);
+			Gui::Entity listed;
+			listed.name = name.has_value() ? name->get().name : "";
+			listed.id = entity;
+			EditorPanel::sceneEntities.push_back(listed);
+		}
+		Serializer::GetInstance().SerializeScene(path);
+		EditorPanel::sceneEntities.clear();
+
+		std::ifstream ifs(path);
+		return std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+	}
+
+	/**
+	 * \brief Loads a scene through the background loader, committing as little as it can each call
+	 *        as the loading screen's frames do.
+	 * \return The number of calls it took, or 0 if the scene failed to load.
+	 */
+	int LoadStaged(std::string const& scenePath) {
+		SceneLoader loader;
+		loader.Start(scenePath);
+		int frames = 0;
+		SceneLoader::Stage stage = SceneLoader::STAGE_STAGING;
+		while (stage == SceneLoader::STAGE_STAGING || stage == SceneLoader::STAGE_COMMITTING) {
+			stage = loader.Update(0.0);
+			++frames;
+		}
+		if (stage != SceneLoader::STAGE_DONE) {
+			std::printf("  %s\n", loader.GetError().c_str());
+			return 0;
+		}
+		return frames;
+	}
+
+	/**
+	 * \brief Checks a scene saved after a load is the same as the one saved after loading from JSON.
+	 */
+	bool Matches(std::string const& fromJson, std::string const& fromJsonPath, std::string const& loaded, std::string const& loadedPath) {
+		if (fromJson != loaded) {
+			auto mismatch = std::mismatch(fromJson.begin(), fromJson.end(), loaded.begin(), loaded.end());
+			std::printf("  Mismatch at byte %zu, saved to %s and %s\n",
+				static_cast<size_t>(mismatch.first - fromJson.begin()), fromJsonPath.c_str(), loadedPath.c_str());
+			return false;
+		}
+		std::filesystem::remove(loadedPath);
+		return true;
+	}
+
+	/**
+	 * \brief Loads a scene from its JSON, from its cooked file and through the background loader
+	 *        and checks each saves to the same JSON.
+	 */
+	bool Verify(std::string const& scenePath, std::string const& cookedPath) {
+		std::filesystem::path temporary = std::filesystem::temp_directory_path();
+		std::string fromJsonPath = (temporary / "kigen_scene_cook_json.scene").string();
+		std::string fromCookedPath = (temporary / "kigen_scene_cook_cooked.scene").string();
+		std::string fromStagedPath = (temporary / "kigen_scene_cook_staged.scene").string();
+
+		UnloadScene();
+		Serializer::GetInstance().DeserializeScene(scenePath);
+		std::string fromJson = SaveLoadedScene(fromJsonPath);
+
+		UnloadScene();
+		bool isLoaded = Serializer::GetInstance().DeserializeCookedScene(cookedPath);
+		std::string fromCooked = SaveLoadedScene(fromCookedPath);
+
+		// Staged from the JSON, the way the loader stages a scene that has no cooked file
+		UnloadScene();
+		bool isStaged = LoadStaged(scenePath) > 0;
+		std::string fromStaged = SaveLoadedScene(fromStagedPath);
+		UnloadScene();
+
+		bool matches = isLoaded && Matches(fromJson, fromJsonPath, fromCooked, fromCookedPath);
+		matches = isStaged && Matches(fromJson, fromJsonPath, fromStaged, fromStagedPath) && matches;
+		if (matches) {
+			std::filesystem::remove(fromJsonPath);
+		}
+		return matches;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	CookOptions options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+	if (options.scenes.empty()) {
+		std::printf("No scenes to cook\n");
+		return EXIT_FAILURE;
+	}
+
+	ECSManager::GetInstance().Initialize();
+
+	bool isSuccessful = true;
+	std::printf("%-28s %9s %9s %8s %11s %11s %8s\n", "Scene", "JSON KB", "Cooked KB", "Entities", "JSON ms", "Cooked ms", "Verified");
+	for (std::string const& scenePath : options.scenes) {
+		std::string cookedPath = CookedScene::GetCookedPath(scenePath);
+		std::string error;
+		if (!CookedScene::Cook(scenePath, cookedPath, error)) {
+			std::printf("%s\n", error.c_str());
+			isSuccessful = false;
+			continue;
+		}
+
+		CookedScene cooked;
+		if (!cooked.Open(cookedPath, error)) {
+			std::printf("%s\n", error.c_str());
+			isSuccessful = false;
+			continue;
+		}
+		uint32_t entityCount = cooked.GetEntityCount();
+		cooked.Close();
+
+		double jsonMs = TimeLoad([&scenePath]() { Serializer::GetInstance().DeserializeScene(scenePath); });
+		double cookedMs = TimeLoad([&cookedPath]() { Serializer::GetInstance().DeserializeCookedScene(cookedPath); });
+
+		char const* verified = "-";
+		if (options.verify) {
+			bool matches = Verify(scenePath, cookedPath);
+			verified = matches ? "yes" : "NO";
+			isSuccessful = isSuccessful && matches;
+		}
+
+		std::printf("%-28s %9.1f %9.1f %8u %11.2f %11.2f %8s\n", std::filesystem::path(scenePath).filename().string().c_str(),
+			static_cast<double>(std::filesystem::file_size(scenePath)) / 1024.0,
+			static_cast<double>(std::filesystem::file_size(cookedPath)) / 1024.0,
+			entityCount, jsonMs, cookedMs, verified);
+	}
+	return isSuccessful ? EXIT_SUCCESS : EXIT_FAILURE;
+}
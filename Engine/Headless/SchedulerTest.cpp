@@ -0,0 +1,271 @@
+/*********************************************************************
+ * \file		SchedulerTest.cpp
+ * \brief		Runs synthetic systems with overlapping and disjoint
+ *				access through the SystemScheduler, checks that the
+ *				conflicting ones keep their order and that N workers
+ *				compute the same results as the main thread alone.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../ECS/SystemScheduler.hpp"
+#include "../Utility/JobSystem.hpp"
+
+namespace {
+	/**
+	 * \struct TestOptions
+	 * \brief Command line options of the scheduler test.
+	 */
+	struct TestOptions {
+		int frames = 50;
+		int workerThreads = 4;
+	};
+
+	void PrintUsage() {
+		std::printf(
+			"Usage: kigen_scheduler_test [--frames N] [--threads N]\n"
+			"  --frames N    Frames of the synthetic systems to run in each mode (default 50)\n"
+			"  --threads N   Worker threads compared against the main thread alone (default 4)\n");
+	}
+
+	bool ParseOptions(int argc, char* argv[], TestOptions& options) {
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			bool hasValue = i + 1 < argc;
+
+			if (arg == "--frames" && hasValue) {
+				options.frames = std::atoi(argv[++i]);
+			}
+			else if (arg == "--threads" && hasValue) {
+				options.workerThreads = std::atoi(argv[++i]);
+			}
+			else {
+				return false;
+			}
+		}
+		return options.frames > 0 && options.workerThreads > 0;
+	}
+
+	int failures = 0;
+
+	void Check(bool condition, std::string const& what) {
+		if (!condition) {
+			std::printf("FAILED: %s\n", what.c_str());
+			++failures;
+		}
+	}
+
+	// Stand-ins for component types; only their bits in the signatures matter to the scheduler.
+	enum { COMPONENT_A, COMPONENT_B, COMPONENT_C, COMPONENT_D };
+	constexpr size_t COLUMN_SIZE = 4096;
+
+	Signature Components(std::initializer_list<int> components) {
+		Signature signature;
+		for (int component : components) {
+			signature.set(component);
+		}
+		return signature;
+	}
+
+	SystemAccess Access(std::initializer_list<int> reads, std::initializer_list<int> writes, bool mainThread = false) {
+		SystemAccess access;
+		access.reads = Components(reads);
+		access.writes = Components(writes);
+		access.mainThread = mainThread;
+		access.exclusive = false;
+		return access;
+	}
+
+	/**
+	 * \brief Checks ConflictsWith on pairs that must and must not be ordered.
+	 */
+	void CheckConflicts() {
+		Check(!Access({ COMPONENT_A }, {}).ConflictsWith(Access({ COMPONENT_A }, {})), "two readers of A conflict");
+		Check(!Access({}, { COMPONENT_A }).ConflictsWith(Access({}, { COMPONENT_B })), "writers of A and B conflict");
+		Check(!Access({}, { COMPONENT_A }, true).ConflictsWith(Access({}, { COMPONENT_B }, true)), "main-thread systems on A and B conflict");
+		Check(Access({}, { COMPONENT_A }).ConflictsWith(Access({}, { COMPONENT_A })), "two writers of A do not conflict");
+		Check(Access({}, { COMPONENT_A }).ConflictsWith(Access({ COMPONENT_A }, {})), "a writer then a reader of A do not conflict");
+		Check(Access({ COMPONENT_A }, {}).ConflictsWith(Access({}, { COMPONENT_A })), "a reader then a writer of A do not conflict");
+
+		SystemAccess audio = Access({}, { COMPONENT_A });
+		audio.Use(SharedResource::AUDIO);
+		SystemAccess alsoAudio = Access({}, { COMPONENT_B });
+		alsoAudio.Use(SharedResource::AUDIO);
+		Check(audio.ConflictsWith(alsoAudio), "two users of the audio resource do not conflict");
+
+		Check(SystemAccess{}.ConflictsWith(Access({}, {})), "an exclusive system does not conflict with an empty one");
+		Check(Access({}, {}).ConflictsWith(SystemAccess{}), "an empty system does not conflict with an exclusive one");
+	}
+
+	/**
+	 * \struct World
+	 * \brief The columns the synthetic systems read and write.
+	 */
+	struct World {
+		std::vector<uint64_t> a = std::vector<uint64_t>(COLUMN_SIZE);
+		std::vector<uint64_t> b = std::vector<uint64_t>(COLUMN_SIZE);
+		std::vector<uint64_t> c = std::vector<uint64_t>(COLUMN_SIZE);
+		std::vector<uint64_t> d = std::vector<uint64_t>(COLUMN_SIZE);
+		uint64_t summary = 0;
+		uint64_t checksum = 0;
+	};
+
+	uint64_t Mix(uint64_t value) {
+		value ^= value >> 33;
+		value *= 0xff51afd7ed558ccdULL;
+		value ^= value >> 33;
+		return value;
+	}
+
+	uint64_t Checksum(std::vector<uint64_t> const& column) {
+		uint64_t sum = 0;
+		for (uint64_t value : column) {
+			sum = Mix(sum ^ value);
+		}
+		return sum;
+	}
+
+	/**
+	 * \struct SyntheticSystem
+	 * \brief A system's access, its update, and when it ran in the current frame.
+	 */
+	struct SyntheticSystem {
+		const char* name;
+		SystemAccess access;
+		std::function<void(World&, uint64_t)> update;
+		uint64_t begin = 0;
+		uint64_t end = 0;
+		std::thread::id thread{};
+	};
+
+	/**
+	 * \brief Systems added in sequential order. Each one's result depends on the order it runs in
+	 *        relative to the systems it conflicts with, so a broken edge changes the checksums.
+	 */
+	std::vector<SyntheticSystem> MakeSystems() {
+		std::vector<SyntheticSystem> systems;
+
+		systems.push_back({ "SeedA", Access({}, { COMPONENT_A }), [](World& world, uint64_t frame) {
+			for (size_t i = 0; i < COLUMN_SIZE; ++i) world.a[i] = Mix(world.a[i] + i + frame);
+		} });
+		systems.push_back({ "SeedB", Access({}, { COMPONENT_B }), [](World& world, uint64_t frame) {
+			for (size_t i = 0; i < COLUMN_SIZE; ++i) world.b[i] = Mix(world.b[i] ^ (i * frame));
+		} });
+		// Splits its work across the pool from inside a task, as the PhysicsSystem does.
+		systems.push_back({ "MixC", Access({ COMPONENT_A, COMPONENT_B }, { COMPONENT_C }), [](World& world, uint64_t) {
+			JobSystem::GetInstance().ParallelFor(COLUMN_SIZE, 256, [&world](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i) world.c[i] = Mix(world.a[i] * 31 + world.b[i]);
+			});
+		} });
+		systems.push_back({ "ScaleA", Access({}, { COMPONENT_A }), [](World& world, uint64_t) {
+			for (size_t i = 0; i < COLUMN_SIZE; ++i) world.a[i] = world.a[i] * 3 + 1;
+		} });
+
+		SystemAccess playD = Access({}, { COMPONENT_D }, true);
+		playD.Use(SharedResource::AUDIO);
+		systems.push_back({ "PlayD", playD, [](World& world, uint64_t frame) {
+			for (size_t i = 0; i < COLUMN_SIZE; ++i) world.d[i] += frame;
+		} });
+		SystemAccess summarizeC = Access({ COMPONENT_C }, {});
+		summarizeC.Use(SharedResource::AUDIO);
+		systems.push_back({ "SummarizeC", summarizeC, [](World& world, uint64_t) {
+			world.summary = Mix(world.summary ^ Checksum(world.c));
+		} });
+
+		systems.push_back({ "Exclusive", SystemAccess{}, [](World& world, uint64_t) {
+			world.checksum = Mix(Checksum(world.a) ^ Checksum(world.b) ^ Checksum(world.c) ^ Checksum(world.d) ^ world.summary);
+		} });
+		systems.push_back({ "FoldD", Access({ COMPONENT_D }, { COMPONENT_B }), [](World& world, uint64_t) {
+			for (size_t i = 0; i < COLUMN_SIZE; ++i) world.b[i] ^= world.d[i];
+		} });
+		return systems;
+	}
+
+	/**
+	 * \brief Runs the systems for the frames given, checking the order they ran in each frame.
+	 *
+	 * \return The world's checksum after every frame.
+	 */
+	std::vector<uint64_t> Run(int frames) {
+		World world;
+		std::vector<SyntheticSystem> systems = MakeSystems();
+		std::atomic<uint64_t> clock{ 0 };
+		std::thread::id mainThread = std::this_thread::get_id();
+		SystemScheduler scheduler;
+
+		std::vector<uint64_t> checksums;
+		for (int frame = 0; frame < frames; ++frame) {
+			// Each task only writes its own entry, so they are safe to record from any thread.
+			for (SyntheticSystem& system : systems) {
+				scheduler.Add(system.name, system.access, [&system, &world, &clock, frame] {
+					system.begin = clock.fetch_add(1);
+					system.thread = std::this_thread::get_id();
+					system.update(world, static_cast<uint64_t>(frame) + 1);
+					system.end = clock.fetch_add(1);
+				});
+			}
+			scheduler.Run();
+			checksums.push_back(world.checksum);
+
+			for (size_t later = 0; later < systems.size(); ++later) {
+				SyntheticSystem const& system = systems[later];
+				if (system.access.mainThread) {
+					Check(system.thread == mainThread, std::string(system.name) + " ran off the main thread");
+				}
+				for (size_t earlier = 0; earlier < later; ++earlier) {
+					if (systems[earlier].access.ConflictsWith(system.access)) {
+						Check(systems[earlier].end < system.begin,
+							std::string(system.name) + " started before " + systems[earlier].name + " finished");
+					}
+				}
+			}
+		}
+		return checksums;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	TestOptions options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+
+	CheckConflicts();
+
+	JobSystem& jobSystem = JobSystem::GetInstance();
+	jobSystem.Initialize(0);
+	std::vector<uint64_t> sequential = Run(options.frames);
+	jobSystem.Shutdown();
+
+	jobSystem.Initialize(options.workerThreads);
+	std::vector<uint64_t> parallel = Run(options.frames);
+	size_t numWorkers = jobSystem.GetNumWorkers();
+	jobSystem.Shutdown();
+
+	int mismatches = 0;
+	for (int frame = 0; frame < options.frames; ++frame) {
+		mismatches += sequential[frame] != parallel[frame];
+	}
+	Check(mismatches == 0, std::to_string(mismatches) + " frames with " + std::to_string(numWorkers) + " workers differ from the main thread alone");
+
+	std::printf("%d frames, 0 workers against %zu workers, %d failures\n", options.frames, numWorkers, failures);
+	return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,330 @@
+/*********************************************************************
+ * \file		SerializerBenchmark.cpp
+ * \brief		Compares deserializing each component of a scene with
+ *				the hand-written rapidjson code the serializer used to
+ *				have against walking its REFLECTABLE field table, in
+ *				JSON and in binary, and checks all three agree.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "../Components/Animation.hpp"
+#include "../Components/AudioSource.hpp"
+#include "../Components/Camera.hpp"
+#include "../Components/Collider2D.hpp"
+#include "../Components/Name.hpp"
+#include "../Components/Renderer.hpp"
+#include "../Components/Rigidbody2D.hpp"
+#include "../Components/Textbox.hpp"
+#include "../Components/Transform.hpp"
+#include "../Components/UI.hpp"
+#include "../Components/VideoPlayer.hpp"
+#include "../Utility/JSONParser.hpp"
+#include "../Utility/Reflection.hpp"
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+	using Values = std::vector<rapidjson::Value const*>;
+
+	/**
+	 * \struct BenchmarkOptions
+	 * \brief Command line options of the serializer benchmark.
+	 */
+	struct BenchmarkOptions {
+		std::vector<std::string> scenes{ "../Assets/Scenes/NANO_Level1.scene", "../Assets/Scenes/NANO_Level2.scene" };
+		int repeats = 200;
+	};
+
+	void PrintUsage() {
+		std::printf(
+			"Usage: kigen_serializer_benchmark [scene...] [--repeats N]\n"
+			"  scene        Scene whose components are deserialized (default the NANO levels)\n"
+			"  --repeats N  Times every component of a scene is deserialized per method (default 200)\n");
+	}
+
+	bool ParseOptions(int argc, char* argv[], BenchmarkOptions& options) {
+		std::vector<std::string> scenes;
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			bool hasValue = i + 1 < argc;
+
+			if (arg == "--repeats" && hasValue) {
+				options.repeats = std::atoi(argv[++i]);
+			}
+			else if (!arg.empty() && arg[0] != '-') {
+				scenes.push_back(arg);
+			}
+			else {
+				return false;
+			}
+		}
+		if (!scenes.empty()) {
+			options.scenes = scenes;
+		}
+		return options.repeats > 0;
+	}
+
+	// The per-component code Serializer had before REFLECTABLE, without what it did besides reading
+	// fields, such as giving a transform a UUID, so the result can be compared with the field table's.
+
+	void HandWrittenName(Name& name, rapidjson::Value const& value) {
+		name.name = JSONDeserializer::JSONToString(value, "name");
+		name.prefabID = JSONDeserializer::JSONToString(value, "prefabID");
+		name.prefabPath = JSONDeserializer::JSONToString(value, "prefabPath");
+	}
+
+	void HandWrittenTransform(Transform& transform, rapidjson::Value const& value) {
+		transform.uuid = JSONDeserializer::JSONtoUInt32(value, "uuid");
+		transform.parentUUID = JSONDeserializer::JSONtoUInt32(value, "parentUUID");
+		transform.position = JSONDeserializer::JSONToVec3(value, "position");
+		transform.scale = JSONDeserializer::JSONToVec3(value, "scale");
+		transform.rotation = JSONDeserializer::JSONToVec3(value, "rotation");
+		transform.localPosition = JSONDeserializer::JSONToVec3(value, "localPosition");
+		transform.localScale = JSONDeserializer::JSONToVec3(value, "localScale");
+		transform.localRotation = JSONDeserializer::JSONToVec3(value, "localRotation");
+	}
+
+	void HandWrittenRenderer(Renderer& renderer, rapidjson::Value const& value) {
+		renderer.mesh = value["mesh"].GetInt();
+		if (value.HasMember("isAnimated"))
+			renderer.isAnimated = value["isAnimated"].GetBool();
+		renderer.uuid = JSONDeserializer::JSONToString(value, "textureFile");
+		if (value.HasMember("sortingLayer"))
+			renderer.sortingLayer = static_cast<SortingLayer>(value["sortingLayer"].GetInt());
+	}
+
+	void HandWrittenAABBCollider2D(AABBCollider2D& collider, rapidjson::Value const& value) {
+		collider.bounciness = value["bounciness"].GetFloat();
+		collider.min = JSONDeserializer::JSONToVec2(value, "min");
+		collider.max = JSONDeserializer::JSONToVec2(value, "max");
+		collider.isTrigger = value["isTrigger"].GetBool();
+	}
+
+	void HandWrittenRigidbody2D(Rigidbody2D& rigidbody, rapidjson::Value const& value) {
+		rigidbody.position = JSONDeserializer::JSONToVec2(value, "pos");
+		rigidbody.velocity = JSONDeserializer::JSONToVec2(value, "vel");
+		rigidbody.mass = JSONDeserializer::JSONToFloat(value, "mass");
+		rigidbody.drag = JSONDeserializer::JSONToFloat(value, "drag");
+		rigidbody.gravityScale = JSONDeserializer::JSONToFloat(value, "gravity");
+		rigidbody.isStatic = JSONDeserializer::JSONToBool(value, "static");
+		rigidbody.isKinematic = JSONDeserializer::JSONToBool(value, "kinematic");
+		rigidbody.isGrounded = JSONDeserializer::JSONToBool(value, "grounded");
+	}
+
+	void HandWrittenAnimation(Animation& animation, rapidjson::Value const& value) {
+		animation.spritesPerRow = value["spritesPerRow"].GetUint();
+		animation.spritesPerCol = value["spritesPerCol"].GetUint();
+		animation.numFrames = value["numFrames"].GetUint();
+		animation.startFrame = value["startFrame"].GetUint();
+		animation.endFrame = value["endFrame"].GetUint();
+		animation.timePerFrame = value["timePerFrame"].GetDouble();
+		animation.isLooping = value["isLooping"].GetBool();
+		animation.playOnce = JSONDeserializer::JSONToBool(value, "playOnce");
+	}
+
+	void HandWrittenAudioSource(AudioSource& audioSource, rapidjson::Value const& value) {
+		audioSource.audioClipUUID = value["audioClipUUID"].GetString();
+		audioSource.isPlaying = value["isPlaying"].GetBool();
+		audioSource.isLooping = value["isLooping"].GetBool();
+	}
+
+	void HandWrittenUI(UI& ui, rapidjson::Value const& value) {
+		ui.position = JSONDeserializer::JSONToVec3(value, "position");
+		ui.scale = JSONDeserializer::JSONToVec2(value, "scale");
+		ui.size = JSONDeserializer::JSONToVec2(value, "size");
+		ui.rotation = JSONDeserializer::JSONToFloat(value, "rotation");
+	}
+
+	void HandWrittenVideoPlayer(VideoPlayer& vp, rapidjson::Value const& value) {
+		vp.videoClipUUID = value["videoClipUUID"].GetString();
+		vp.isPlaying = value["isPlaying"].GetBool();
+		vp.playOnAwake = value["playOnAwake"].GetBool();
+		vp.isLooping = value["isLooping"].GetBool();
+	}
+
+	void HandWrittenTextbox(Textbox& tb, rapidjson::Value const& value) {
+		tb.color = JSONDeserializer::JSONToVec3(value, "color");
+		tb.text = JSONDeserializer::JSONToString(value, "text");
+		tb.fontUUID = JSONDeserializer::JSONToString(value, "fontUUID");
+		tb.centerAligned = JSONDeserializer::JSONToBool(value, "centerAligned");
+	}
+
+	void HandWrittenCamera(Camera& cam, rapidjson::Value const& value) {
+		cam.zoom = JSONDeserializer::JSONToFloat(value, "zoom");
+		cam.width = JSONDeserializer::JSONToFloat(value, "width");
+		cam.height = JSONDeserializer::JSONToFloat(value, "height");
+		cam.isMainCamera = JSONDeserializer::JSONToBool(value, "isMainCamera");
+		cam.isActive = JSONDeserializer::JSONToBool(value, "isActive");
+		cam.bloomIntensity = JSONDeserializer::JSONToFloat(value, "bloomIntensity");
+		cam.vignetteStrength = JSONDeserializer::JSONToFloat(value, "vignetteStrength");
+		cam.vignetteSoftness = JSONDeserializer::JSONToFloat(value, "vignetteSoftness");
+		cam.vignetteCenter = JSONDeserializer::JSONToVec2(value, "vignetteCenter");
+	}
+
+	/**
+	 * \struct SceneTotals
+	 * \brief Time spent on every component of a scene by each method, in microseconds per pass.
+	 */
+	struct SceneTotals {
+		double handWrittenUs = 0.0;
+		double reflectedUs = 0.0;
+		double binaryUs = 0.0;
+		bool matched = true;
+	};
+
+	template<typename Read>
+	double TimePasses(int repeats, Read read) {
+		Clock::time_point start = Clock::now();
+		for (int i = 0; i < repeats; ++i) {
+			read();
+		}
+		return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / repeats;
+	}
+
+	/**
+	 * \brief Deserializes every instance of one component in a scene with each method, and prints a row.
+	 */
+	template<typename Component>
+	void RunComponent(void (*handWritten)(Component&, rapidjson::Value const&), Values const& values,
+		BenchmarkOptions const& options, SceneTotals& totals) {
+		if (values.empty()) {
+			return;
+		}
+
+		size_t count = values.size();
+		size_t stride = Component::Fields().GetBinarySize();
+		std::vector<Component> byHand(count), byTable(count), byBinary(count);
+
+		// Binary is written once from the hand-written result, as a cook step would
+		for (size_t i = 0; i < count; ++i) {
+			handWritten(byHand[i], *values[i]);
+		}
+		Reflection::StringTable strings;
+		std::vector<unsigned char> blob(count * stride);
+		for (size_t i = 0; i < count; ++i) {
+			Reflection::WriteBinary(byHand[i], blob.data() + i * stride, strings);
+		}
+
+		double handWrittenUs = TimePasses(options.repeats, [&]() {
+			for (size_t i = 0; i < count; ++i) handWritten(byHand[i], *values[i]);
+		});
+		double reflectedUs = TimePasses(options.repeats, [&]() {
+			for (size_t i = 0; i < count; ++i) Reflection::ReadJSON(byTable[i], *values[i]);
+		});
+		double binaryUs = TimePasses(options.repeats, [&]() {
+			for (size_t i = 0; i < count; ++i) Reflection::ReadBinary(byBinary[i], blob.data() + i * stride, strings);
+		});
+
+		// Every saved field, strings compared by interned index, must be the same whichever way it was read
+		bool matched = true;
+		std::vector<unsigned char> table(stride), binary(stride);
+		for (size_t i = 0; i < count; ++i) {
+			Reflection::WriteBinary(byTable[i], table.data(), strings);
+			Reflection::WriteBinary(byBinary[i], binary.data(), strings);
+			if (std::memcmp(table.data(), blob.data() + i * stride, stride) != 0 || std::memcmp(binary.data(), blob.data() + i * stride, stride) != 0) {
+				matched = false;
+			}
+		}
+
+		std::printf("  %-16s %6zu %14.2f %14.2f %14.2f %8.2fx %8s\n", Component::ComponentName(), count,
+			handWrittenUs, reflectedUs, binaryUs, handWrittenUs / reflectedUs, matched ? "yes" : "NO");
+
+		totals.handWrittenUs += handWrittenUs;
+		totals.reflectedUs += reflectedUs;
+		totals.binaryUs += binaryUs;
+		totals.matched = totals.matched && matched;
+	}
+
+	Values Gather(rapidjson::Value const& entities, char const* key) {
+		Values values;
+		for (rapidjson::SizeType i = 0; i < entities.Size(); ++i) {
+			auto components = entities[i].FindMember("Components");
+			if (components == entities[i].MemberEnd()) {
+				continue;
+			}
+			auto component = components->value.FindMember(key);
+			if (component != components->value.MemberEnd()) {
+				values.push_back(&component->value);
+			}
+		}
+		return values;
+	}
+
+	bool RunScene(std::string const& path, BenchmarkOptions const& options) {
+		std::ifstream ifs(path);
+		if (!ifs.is_open()) {
+			std::printf("%s: cannot open\n\n", path.c_str());
+			return false;
+		}
+		std::string jsonContent((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+		rapidjson::Document document;
+		document.Parse(jsonContent.c_str());
+		if (document.HasParseError() || !document.HasMember("Entities") || !document["Entities"].IsArray()) {
+			std::printf("%s: not a scene\n\n", path.c_str());
+			return false;
+		}
+		rapidjson::Value const& entities = document["Entities"];
+
+		std::printf("%s (%u entities, microseconds per pass)\n", path.c_str(), entities.Size());
+		std::printf("  %-16s %6s %14s %14s %14s %9s %8s\n", "Component", "Count", "Hand-written", "Field table", "Binary", "Speedup", "Matched");
+
+		SceneTotals totals;
+		RunComponent<Name>(HandWrittenName, Gather(entities, "Name"), options, totals);
+		RunComponent<Transform>(HandWrittenTransform, Gather(entities, "Transform"), options, totals);
+		RunComponent<Renderer>(HandWrittenRenderer, Gather(entities, "Renderer"), options, totals);
+		RunComponent<AABBCollider2D>(HandWrittenAABBCollider2D, Gather(entities, "AABBCollider2D"), options, totals);
+		RunComponent<Rigidbody2D>(HandWrittenRigidbody2D, Gather(entities, "Rigidbody2D"), options, totals);
+		RunComponent<Animation>(HandWrittenAnimation, Gather(entities, "Animation"), options, totals);
+		RunComponent<AudioSource>(HandWrittenAudioSource, Gather(entities, "AudioSource"), options, totals);
+		RunComponent<UI>(HandWrittenUI, Gather(entities, "UI"), options, totals);
+		RunComponent<VideoPlayer>(HandWrittenVideoPlayer, Gather(entities, "VideoPlayer"), options, totals);
+		RunComponent<Textbox>(HandWrittenTextbox, Gather(entities, "Textbox"), options, totals);
+		RunComponent<Camera>(HandWrittenCamera, Gather(entities, "Camera"), options, totals);
+
+		std::printf("  %-16s %6s %14.2f %14.2f %14.2f %8.2fx %8s\n\n", "Total", "", totals.handWrittenUs, totals.reflectedUs,
+			totals.binaryUs, totals.handWrittenUs / totals.reflectedUs, totals.matched ? "yes" : "NO");
+		return totals.matched;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	BenchmarkOptions options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+
+	// Script components are left out: their parameters are not fields, so both ways read them with the same code
+	std::printf("Passes per method: %d\n\n", options.repeats);
+
+	bool matched = true;
+	for (std::string const& scene : options.scenes) {
+		matched = RunScene(scene, options) && matched;
+	}
+
+	if (!matched) {
+		std::printf("The field tables read a component differently from the hand-written code\n");
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,201 @@
+/*********************************************************************
+ * \file		SortBenchmark.cpp
+ * \brief		Compares ordering a batch with std::sort on mesh depth
+ *				against the sort keys and radix sort in BatchSort.hpp.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../Graphics/BatchSort.hpp"
+#include "../Graphics/Vertex.hpp"
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * \struct BenchmarkOptions
+	 * \brief Command line options of the sort benchmark.
+	 */
+	struct BenchmarkOptions {
+		int frames = 200;
+		double movedPercent = 1.0;	// Meshes whose depth changes each frame in the nudged scenario.
+	};
+
+	/**
+	 * \struct BenchMesh
+	 * \brief Stands in for Mesh, which keeps its vertices in their own allocation.
+	 */
+	struct BenchMesh {
+		std::vector<Vertex> vertices;
+	};
+
+	/**
+	 * \struct SortTimes
+	 * \brief Average time per frame of each sort, and how often the draw order changed.
+	 */
+	struct SortTimes {
+		double stdSortUs = 0.0;
+		double radixUs = 0.0;
+		int reorderedFrames = 0;
+		bool ordered = true;
+	};
+
+	void PrintUsage() {
+		std::printf(
+			"Usage: kigen_sort_benchmark [--frames N] [--moved PERCENT]\n"
+			"  --frames N       Frames sorted per scenario (default 200)\n"
+			"  --moved PERCENT  Meshes nudged each frame in the nudged scenario (default 1)\n");
+	}
+
+	bool ParseOptions(int argc, char* argv[], BenchmarkOptions& options) {
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			bool hasValue = i + 1 < argc;
+
+			if (arg == "--frames" && hasValue) {
+				options.frames = std::atoi(argv[++i]);
+			}
+			else if (arg == "--moved" && hasValue) {
+				options.movedPercent = std::atof(argv[++i]);
+			}
+			else {
+				return false;
+			}
+		}
+		return options.frames > 0 && options.movedPercent >= 0.0 && options.movedPercent <= 100.0;
+	}
+
+	std::vector<BenchMesh> MakeMeshes(size_t count, std::mt19937& rng) {
+		std::uniform_real_distribution<float> depth(-10.f, 10.f);
+		std::uniform_int_distribution<int> texture(-1, 7);
+
+		std::vector<BenchMesh> meshes(count);
+		for (BenchMesh& mesh : meshes) {
+			float z = depth(rng);
+			int texArray = texture(rng);
+			for (int corner = 0; corner < 4; ++corner) {
+				mesh.vertices.push_back(Vertex{ Vec3(0.f, 0.f, z), Vec4(1.f, 1.f, 1.f, 1.f), Vec3(0.f, 0.f, 0.f), Vec2(0.f, 0.f), texArray, 0, 1 });
+			}
+		}
+		return meshes;
+	}
+
+	// Changes the depth of some meshes, the same way for both sorts when given the same seed.
+	void MoveMeshes(std::vector<BenchMesh>& meshes, std::mt19937& rng, size_t moved, bool shuffle) {
+		std::uniform_int_distribution<size_t> pick(0, meshes.size() - 1);
+		std::uniform_real_distribution<float> nudge(-0.05f, 0.05f);
+		std::uniform_real_distribution<float> depth(-10.f, 10.f);
+
+		for (size_t i = 0; i < moved; ++i) {
+			BenchMesh& mesh = shuffle ? meshes[i] : meshes[pick(rng)];
+			float z = shuffle ? depth(rng) : mesh.vertices[0].position.z + nudge(rng);
+			for (Vertex& vertex : mesh.vertices) {
+				vertex.position.z = z;
+			}
+		}
+	}
+
+	SortTimes Run(size_t count, BenchmarkOptions const& options, bool shuffle) {
+		const unsigned seed = 2301345;
+		size_t moved = shuffle ? count : std::max<size_t>(1, static_cast<size_t>(count * options.movedPercent / 100.0));
+		SortTimes times;
+
+		// std::sort comparing the depth of each mesh, as SortBatch did
+		{
+			std::mt19937 rng(seed);
+			std::vector<BenchMesh> meshes = MakeMeshes(count, rng);
+			std::vector<size_t> ids(count);
+			for (size_t i = 0; i < count; ++i) ids[i] = i;
+
+			Clock::duration total{};
+			for (int frame = 0; frame < options.frames; ++frame) {
+				MoveMeshes(meshes, rng, moved, shuffle);
+
+				Clock::time_point start = Clock::now();
+				std::sort(ids.begin(), ids.end(), [&meshes](size_t a, size_t b) {
+					return meshes[a].vertices[0].position.z < meshes[b].vertices[0].position.z;
+				});
+				total += Clock::now() - start;
+			}
+			times.stdSortUs = std::chrono::duration<double, std::micro>(total).count() / options.frames;
+		}
+
+		// Sort keys, sorted incrementally or with the radix sort
+		{
+			std::mt19937 rng(seed);
+			std::vector<BenchMesh> meshes = MakeMeshes(count, rng);
+			std::vector<size_t> ids(count);
+			std::vector<uint64_t> keys(count);
+			for (size_t i = 0; i < count; ++i) {
+				ids[i] = i;
+				keys[i] = i;
+			}
+			BatchSort::Scratch scratch;
+
+			Clock::duration total{};
+			for (int frame = 0; frame < options.frames; ++frame) {
+				MoveMeshes(meshes, rng, moved, shuffle);
+
+				Clock::time_point start = Clock::now();
+				scratch.keys.resize(count);
+				for (size_t i = 0; i < count; ++i) {
+					Vertex const& vertex = meshes[ids[i]].vertices[0];
+					scratch.keys[i] = BatchSort::MakeKey(0, vertex.position.z, vertex.texArray, BatchSort::Sequence(keys[i]));
+				}
+				times.reorderedFrames += BatchSort::Sort(keys, ids, scratch.keys, scratch) ? 1 : 0;
+				total += Clock::now() - start;
+
+				for (size_t i = 1; i < count; ++i) {
+					if (meshes[ids[i - 1]].vertices[0].position.z > meshes[ids[i]].vertices[0].position.z) {
+						times.ordered = false;
+					}
+				}
+			}
+			times.radixUs = std::chrono::duration<double, std::micro>(total).count() / options.frames;
+		}
+
+		return times;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	BenchmarkOptions options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+
+	std::printf("Frames per scenario: %d, nudged scenario moves %.2f%% of meshes per frame\n\n", options.frames, options.movedPercent);
+	std::printf("%-8s %-9s %14s %14s %8s %10s\n", "Meshes", "Scenario", "std::sort us", "BatchSort us", "Speedup", "Reordered");
+
+	bool ordered = true;
+	for (size_t count : { size_t{ 1000 }, size_t{ 10000 }, size_t{ 50000 } }) {
+		for (bool shuffle : { false, true }) {
+			SortTimes times = Run(count, options, shuffle);
+			ordered = ordered && times.ordered;
+			std::printf("%-8zu %-9s %14.1f %14.1f %7.2fx %6d/%d\n", count, shuffle ? "shuffled" : "nudged",
+				times.stdSortUs, times.radixUs, times.stdSortUs / times.radixUs, times.reorderedFrames, options.frames);
+		}
+	}
+
+	if (!ordered) {
+		std::printf("\nBatchSort produced a draw order that is not sorted by depth\n");
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,186 @@
+/*********************************************************************
+ * \file		SpriteInstanceTest.cpp
+ * \brief		Checks that SpriteInstance reproduces the vertices of
+ *				transformed sprites, whether it is built from the
+ *				vertices or placed from the transform, and that it
+ *				rejects meshes that are not plain sprites.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Math.hpp"
+#include "../Graphics/Mesh.hpp"
+#include "../Graphics/SpriteInstance.hpp"
+#include "../Graphics/Vertex.hpp"
+
+namespace {
+	int failures = 0;
+
+	void Check(bool condition, std::string const& what) {
+		if (!condition) {
+			std::printf("FAILED: %s\n", what.c_str());
+			++failures;
+		}
+	}
+
+	constexpr size_t SPRITE_COUNT = 1000;
+
+	const std::vector<unsigned int> QUAD_INDICES(std::begin(SpriteInstance::QUAD_INDICES), std::end(SpriteInstance::QUAD_INDICES));
+
+	// Compares what the vertex shaders would produce from the packed vertices and from the instance.
+	bool Matches(std::vector<Vertex> const& vertices, SpriteInstance const& instance) {
+		for (size_t corner = 0; corner < SpriteInstance::CORNER_COUNT; ++corner) {
+			PackedVertex packed(vertices[corner]);
+			Vec2 position = instance.GetCornerPosition(corner);
+			Vec2 texCoord = instance.GetCornerTexCoord(corner);
+			float tolerance = 1e-3f * (1.f + std::abs(packed.x) + std::abs(packed.y));
+			if (std::abs(position.x - packed.x) > tolerance || std::abs(position.y - packed.y) > tolerance ||
+				std::abs(texCoord.x - packed.texCoord[0] / 65535.f) > 1e-4f || std::abs(texCoord.y - packed.texCoord[1] / 65535.f) > 1e-4f ||
+				packed.depth != instance.depth || packed.texture != instance.texture) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Meshes that are not plain sprites must stay on the vertex path.
+	void CheckRejectsNonSprites() {
+		Vec4 red(1.f, 0.f, 0.f, 1.f), blue(0.f, 0.f, 1.f, 1.f);
+		std::vector<Vertex> quad = {
+			Vertex(Vec3(-0.5f,  0.5f, 0.f), red, Vec3(), Vec2(0.f, 1.f)),
+			Vertex(Vec3( 0.5f,  0.5f, 0.f), red, Vec3(), Vec2(1.f, 1.f)),
+			Vertex(Vec3( 0.5f, -0.5f, 0.f), red, Vec3(), Vec2(1.f, 0.f)),
+			Vertex(Vec3(-0.5f, -0.5f, 0.f), red, Vec3(), Vec2(0.f, 0.f))
+		};
+		SpriteInstance instance;
+		Check(SpriteInstance::FromQuad(quad, QUAD_INDICES, instance), "a plain sprite was rejected");
+
+		std::vector<Vertex> gradient = quad;
+		gradient[2].color = blue;
+		std::vector<Vertex> skewed = quad;
+		skewed[2].position.x += 0.3f;
+		std::vector<Vertex> rotatedUVs = quad;
+		rotatedUVs[0].texCoord = Vec2(1.f, 1.f);
+		rotatedUVs[1].texCoord = Vec2(1.f, 0.f);
+		rotatedUVs[2].texCoord = Vec2(0.f, 0.f);
+		rotatedUVs[3].texCoord = Vec2(0.f, 1.f);
+		std::vector<Vertex> triangle(quad.begin(), quad.begin() + 3);
+
+		Check(!SpriteInstance::FromQuad(gradient, QUAD_INDICES, instance), "a quad with a color per corner was accepted");
+		Check(!SpriteInstance::FromQuad(skewed, QUAD_INDICES, instance), "a quad that is not a parallelogram was accepted");
+		Check(!SpriteInstance::FromQuad(rotatedUVs, QUAD_INDICES, instance), "a quad with rotated texture coordinates was accepted");
+		Check(!SpriteInstance::FromQuad(triangle, { 0, 1, 2 }, instance), "a triangle was accepted");
+		Check(!SpriteInstance::FromQuad(quad, { 0, 1, 2, 0, 2, 3 }, instance), "a quad with other indices was accepted");
+	}
+
+	/**
+	 * \brief A quad from GraphicsManager::LoadQuadMesh showing one frame of an 8 frame sprite sheet.
+	 *
+	 * Every other sprite has transparent borders trimmed from its atlas image, so it is clipped.
+	 */
+	Mesh MakeSprite(std::mt19937& rng, bool isTrimmed) {
+		std::uniform_real_distribution<float> unit(0.f, 1.f);
+		std::uniform_int_distribution<int> frame(0, 7);
+		std::uniform_int_distribution<int> texture(-1, 7);
+
+		float u0 = frame(rng) / 8.f, u1 = u0 + 1.f / 8.f;
+		Vec4 color(unit(rng), unit(rng), unit(rng), 1.f);
+		int texArray = texture(rng);
+		int texLayer = texArray < 0 ? -1 : frame(rng);
+		std::vector<Vertex> vertices = {
+			Vertex(Vec3(-0.5f,  0.5f, 0.f), color, Vec3(), Vec2(u0, 1.f), texArray, texLayer), // Top left
+			Vertex(Vec3( 0.5f,  0.5f, 0.f), color, Vec3(), Vec2(u1, 1.f), texArray, texLayer), // Top right
+			Vertex(Vec3( 0.5f, -0.5f, 0.f), color, Vec3(), Vec2(u1, 0.f), texArray, texLayer), // Bottom right
+			Vertex(Vec3(-0.5f, -0.5f, 0.f), color, Vec3(), Vec2(u0, 0.f), texArray, texLayer)  // Bottom left
+		};
+		std::vector<Vec3> modelSpace;
+		for (Vertex const& vertex : vertices) {
+			modelSpace.push_back(vertex.position);
+		}
+
+		Mesh mesh(vertices, QUAD_INDICES, modelSpace, 0);
+		if (isTrimmed) {
+			mesh.contentRect = Vec4(0.1f, 0.2f, 0.7f, 0.5f);
+		}
+		return mesh;
+	}
+
+	// Same composition as TransformSystem. Negative scales flip the sprite.
+	Mat4 MakeTransform(std::mt19937& rng) {
+		std::uniform_real_distribution<float> position(-5000.f, 5000.f);
+		std::uniform_real_distribution<float> depth(-10.f, 10.f);
+		std::uniform_real_distribution<float> angle(-180.f, 180.f);
+		std::uniform_real_distribution<float> scale(-400.f, 400.f);
+		return Mat4::BuildTranslation(position(rng), position(rng), depth(rng))
+			* Mat4::BuildZRotation(angle(rng))
+			* Mat4::BuildScaling(scale(rng), scale(rng), 1.f);
+	}
+
+	/**
+	 * \brief Places instances from the transform the way BatchData::BuildInstance does for sprites whose
+	 *        vertices were left untransformed, and compares them with the transformed vertices.
+	 */
+	void CheckTransforms() {
+		const unsigned seed = 2301345;
+		std::mt19937 rng(seed);
+
+		size_t builtMismatches = 0, placedMismatches = 0, depthMismatches = 0, rejected = 0;
+		std::vector<Vertex> clipped, staleClipped;
+		for (size_t i = 0; i < SPRITE_COUNT; ++i) {
+			Mesh stale = MakeSprite(rng, i % 2 == 1);
+			stale.SetModelToWorld(MakeTransform(rng));
+			Mesh transformed = stale;
+			transformed.UpdatePositions();
+
+			// Built from the transformed vertices, as RenderSystem did before instances were placed from the transform
+			std::vector<Vertex> const& drawn = transformed.GetDrawnVertices(clipped);
+			SpriteInstance built;
+			if (!SpriteInstance::FromQuad(drawn, transformed.indices, built, transformed.texRect)) {
+				++rejected;
+				continue;
+			}
+			builtMismatches += !Matches(drawn, built);
+
+			// Placed from the transform, with the vertices left as they were made
+			SpriteInstance placed;
+			Vec3 corners[SpriteInstance::CORNER_COUNT];
+			if (!SpriteInstance::FromQuad(stale.GetDrawnVertices(staleClipped), stale.indices, placed, stale.texRect) ||
+				!stale.GetDrawnModelCorners(corners)) {
+				++rejected;
+				continue;
+			}
+			placed.SetTransform(corners, stale.modelToWorld);
+			placedMismatches += !Matches(drawn, placed);
+
+			depthMismatches += std::abs(stale.GetDepth() - transformed.vertices[0].position.z) > 1e-4f;
+		}
+
+		Check(rejected == 0, std::to_string(rejected) + " transformed sprites could not be drawn as instances");
+		Check(builtMismatches == 0, std::to_string(builtMismatches) + " instances built from vertices did not reproduce them");
+		Check(placedMismatches == 0, std::to_string(placedMismatches) + " instances placed from the transform did not reproduce the transformed vertices");
+		Check(depthMismatches == 0, std::to_string(depthMismatches) + " sprites left untransformed reported the wrong depth");
+	}
+}
+
+int main() {
+	CheckRejectsNonSprites();
+	CheckTransforms();
+
+	std::printf("%zu sprites, %d failures\n", SPRITE_COUNT, failures);
+	return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
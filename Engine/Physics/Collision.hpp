@@ -19,21 +19,17 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "../Components/Rigidbody2D.hpp"
 #include "../ECS/Entity.hpp"
 
-struct AABBCollider2D;
-
 /**
  * \struct ContactPoint
  * \brief Contains information about the point of contact of a collision.
  *
- * Stores the point, normal and penetration of the collision relative to thisCollider
- * and also stores pointers to the colliders involved.
+ * Stores the point, normal and penetration of the collision relative to the collider
+ * of the entity the collision belongs to.
  */
 struct ContactPoint {
 	Vec2 point; // The point of collision in world space.
 	Vec2 normal; // normal of the collision relative to aabb1
 	float penetration; // penetration along the collision normal.
-	std::weak_ptr<AABBCollider2D> thisCollider;
-	std::weak_ptr<AABBCollider2D> otherCollider;
 };
 
 /**
@@ -50,7 +46,6 @@ struct Collision {
 	float noCollisionDuration = 0.f;
 
 	Entity entity; // The other entity hit.
-	std::weak_ptr<AABBCollider2D> collider; // The other collider hit.
 	std::weak_ptr<Rigidbody2D> rigidbody; // The other rigidbody hit.
 	Vec2 impulse;	// The resultant impulse applied to this rigidbody to resolve the collision.
 	Vec2 relativeVelocity; // The relative velocity of the two collided objects.
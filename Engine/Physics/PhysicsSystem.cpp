@@ -26,13 +26,30 @@
 #include "../Components/Renderer.hpp"
 #include "../Tools/Scripting/ScriptEngine.hpp"
 #include "../Components/Name.hpp"
-#include "../Input/InputManager.hpp"
 #include "../Components/Camera.hpp"
+#include "../Utility/JobSystem.hpp"
 #include "../Layers/LayerManager.hpp"
+#include "../Utility/Profiler.hpp"
 
 const float Collision::edgeCollisionThreshold = 5.f;
 const float Collision::noCollisionDurationThreshold = 0.07f;
 
+PhysicsSystem::PhysicsSystem() {
+	m_entities.SetObserver(this);
+}
+
+void PhysicsSystem::OnEntityInserted(Entity entity) {
+	bodyStore.Add(entity);
+}
+
+void PhysicsSystem::OnEntityErased(Entity entity) {
+	bodyStore.Remove(entity);
+}
+
+void PhysicsSystem::OnEntitiesCleared() {
+	bodyStore.Clear();
+}
+
 void PhysicsSystem::Init() {
 	// By default, add drag and gravity force to all Rigidbodies.
 	for (auto const& entity : m_entities) {
@@ -48,51 +65,69 @@ void PhysicsSystem::AddDragAndGravity(Rigidbody2D& rb) {
 	AddAlwaysActiveForce(rb, LinearForceIDs::DRAG_FORCEID, Vec2{}, 0.f);
 }
 
-void PhysicsSystem::Update(double dt) {
-	// Press M to toggle physics step by step mode (for debugging purposes)
-	if (InputManager::GetInstance().GetKeyDown('M')) {
-		ECSManager::GetInstance().physicsSystem->SetStepByStepMode(!ECSManager::GetInstance().physicsSystem->IsStepByStepMode());
-	}
-	// When physics step by step mode is enabled, press N to update Physics for one frame
-	bool physicsUpdate = true;
-	if (ECSManager::GetInstance().physicsSystem->IsStepByStepMode()) {
-		if (!InputManager::GetInstance().GetKeyDown('N')) {
-			physicsUpdate = false;
-		}
-	}
+void PhysicsSystem::Update(double dt, bool physicsUpdate) {
+	PROFILE_SCOPE("PhysicsSystem::Update");
+
+	// Defer changes to the entities until the end of the update. Collision callbacks, which may create or
+	// destroy entities, are queued and only sent by DispatchCollisionEvents.
+	Query::ScopedLock lock(m_entities);
 
 	if (physicsUpdate) {
-		// Loop through all entities.
+		// Refresh the bodies in the store from their components, which scripts may have changed since the last
+		// step, then accumulate forces and integrate. Each body only touches its own components, so chunks run in parallel.
+		const float fixedDt = static_cast<float>(dt);
+		const bool applyForces = fixedDt < 0.2f;
+		JobSystem::GetInstance().ParallelFor(bodyStore.Size(), BODY_UPDATE_CHUNK_SIZE, [this, fixedDt, applyForces](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				Entity entity = bodyStore.entities[i];
+				// Bodies destroyed while the query was locked stay in the store until the lock is released.
+				if (m_entities.IsPendingErase(entity)) {
+					bodyStore.bodies[i] = nullptr;
+					bodyStore.moving[i] = 0;
+					continue;
+				}
+
+				Rigidbody2D& rb = ECSManager::GetInstance().GetComponent<Rigidbody2D>(entity);
+				bodyStore.bodies[i] = &rb;
+				// Update rigidbody & collider position if it is not kinematic and static.
+				bodyStore.moving[i] = !IsRBKinematic(rb) && !IsRBStatic(rb);
+				bodyStore.posX[i] = rb.position.x; bodyStore.posY[i] = rb.position.y;
+				bodyStore.velX[i] = rb.velocity.x; bodyStore.velY[i] = rb.velocity.y;
+				bodyStore.invMass[i] = rb.mass != 0.f ? 1.f / rb.mass : 0.f;
+				if (applyForces && bodyStore.moving[i]) {
+					AccumulateForces(rb, fixedDt, i);
+				}
+				else {
+					bodyStore.forceX[i] = bodyStore.forceY[i] = 0.f;
+					bodyStore.gravityWeight[i] = bodyStore.dragCoef[i] = 0.f;
+				}
+			}
+
+			bodyStore.Integrate(fixedDt, gravity, applyForces, begin, end);
+
+			// Write the results back to the components of the moving bodies.
+			for (size_t i = begin; i < end; ++i) {
+				if (!bodyStore.moving[i]) continue;
+
+				Rigidbody2D& rb = *bodyStore.bodies[i];
+				if (applyForces) {
+					rb.forcesManager.resultantForce = Vec2{ bodyStore.forceX[i] + bodyStore.dragX[i], bodyStore.forceY[i] + bodyStore.dragY[i] };
+				}
+				SetRBVelocity(rb, bodyStore.velX[i], bodyStore.velY[i]);
+				// Also moves the transform and the AABBCollider to the new position.
+				SetRBPosition(bodyStore.entities[i], Vec2{ bodyStore.posX[i], bodyStore.posY[i] });
+			}
+		});
+
 		for (auto it = m_entities.begin(); it != m_entities.end(); ++it) {
-			Rigidbody2D& rb = ECSManager::GetInstance().GetComponent<Rigidbody2D>(*it);
-			AABBCollider2D& aabb = ECSManager::GetInstance().GetComponent<AABBCollider2D>(*it);
-			entityToRBMap.emplace(*it, std::ref(rb));
-			entityToAABBMap.emplace(*it, std::shared_ptr<AABBCollider2D>(&aabb, [](AABBCollider2D*) {}));
+			if (m_entities.IsPendingErase(*it)) continue;
 
+			Rigidbody2D& rb = ECSManager::GetInstance().GetComponent<Rigidbody2D>(*it);
 			if (!IsRBKinematic(rb)) {
 				// Add object to grid if it is not kinematic.
 				if (IsBroadPhaseMode()) {
-					// Insert the object into the Bitset Grid for broadphase collision detection.
-					if (bitsetGrid.InsertToGrid(aabb)) {
-						entityToGridIDMap[*it] = aabb.idInGrid;
-
-						// Update rigidbody & collider position if it is not kinematic and static.
-						if (!IsRBStatic(rb)) {
-							// Update the RB position.
-							UpdateRBPosition(rb, (float)dt, *it);
-							// Update the AABBCollider based on the Rigidbody's position.
-							UpdateAABBCollider(*it);
-						}
-					}
-				}
-				else {
-					// Update rigidbody & collider position if it is not kinematic and static.
-					if (!IsRBStatic(rb)) {
-						// Update the RB position.
-						UpdateRBPosition(rb, (float)dt, *it);
-						// Update the AABBCollider based on the Rigidbody's position.
-						UpdateAABBCollider(*it);
-					}
+					AABBCollider2D& aabb = ECSManager::GetInstance().GetComponent<AABBCollider2D>(*it);
+					spatialGrid.InsertOrUpdate(*it, aabb.min, aabb.max);
 				}
 
 				auto& transform = ECSManager::GetInstance().GetComponent<Transform>(*it);
@@ -100,67 +135,32 @@ void PhysicsSystem::Update(double dt) {
 			}
 		}
 
-		// Make the bitset grid follow the active camera.
-		auto camera = ECSManager::GetInstance().TryGetComponent<Camera>(GraphicsManager::GetInstance().activeCamera);
-		if (camera.has_value()) {
-			GetBitsetGrid().gridPos = Vec2(ECSManager::GetInstance().GetComponent<Transform>(GraphicsManager::GetInstance().activeCamera).position.x, 
-				ECSManager::GetInstance().GetComponent<Transform>(GraphicsManager::GetInstance().activeCamera).position.y);
-		}
-		// Else, just follow the engine camera.
-		else {
-			GetBitsetGrid().gridPos = Vec2(GraphicsManager::GetInstance().camera.position.x, GraphicsManager::GetInstance().camera.position.y);
-		}
+		PROFILE_COUNTER("Physics Bodies", bodyStore.Size());
 
 		// Broad-phase collision detection enabled (optimized).
 		if (IsBroadPhaseMode()) {
-			// Loop through the rows and columns of the grid.
-			for (size_t row = 0; row < bitsetGrid.numRows; ++row) {
-				for (size_t col = 0; col < bitsetGrid.numCols; ++col) {
-					std::vector<Entity> entitiesInCell{};
-					// For this cell, find out which entities are in the cell by doing bitwise AND between the rowsBitArray and colsBitArray.
-					// E.g. if collider with idInGrid 25 is in the current cell, rowsBitArray and colsBitArray's bit at position 25 should be set to 1.
-					std::bitset<BitsetGrid::BITSET_SIZE> cellCollisionBitset = bitsetGrid.rowsBitArray[row] & bitsetGrid.colsBitArray[col];
-
-					// Loop through the colliders to find out which colliders are in the current cell.
-					for (auto it = entityToAABBMap.begin(); it != entityToAABBMap.end(); ++it) {
-						AABBCollider2D& aabb = *(it->second);
-						// Skip the AABB if it is not in the grid.
-						if (!aabb.inGrid) {
-							continue;
-						}
-
-						// Check if the current collider lies in the current cell, and
-						// if the bit at position idInGrid of the collider is set to 1 (means collider is in this cell).
-						if ((row >= aabb.rowsOccupied.first && row <= aabb.rowsOccupied.second && col >= aabb.colsOccupied.first && col <= aabb.colsOccupied.second) &&
-							cellCollisionBitset.test(it->second->idInGrid))
-						{
-							entitiesInCell.push_back(static_cast<Entity>(it->first));
-						}
-					}
-
-					// Loop through the entities in the current cell and perform narrow-phase collision detection and resolution.
-					for (size_t i = 0; i < entitiesInCell.size(); ++i) {
-						for (size_t j = i + 1; j < entitiesInCell.size(); ++j) {
-							Entity entity1 = entitiesInCell[i];
-							Entity entity2 = entitiesInCell[j];
-							
-							// Check the entities' collision matrix to see if they should be able to collide.
-							Layer layer1 = ECSManager::GetInstance().GetEntityManager().GetLayer(entity1);
-							Layer layer2 = ECSManager::GetInstance().GetEntityManager().GetLayer(entity2);
-							if (LayerManager::GetInstance().CanLayersCollide(layer1, layer2)) {
-								std::shared_ptr<AABBCollider2D>& aabb1 = entityToAABBMap[entity1];
-								Rigidbody2D& rb1 = ECSManager::GetInstance().GetComponent<Rigidbody2D>(entity1);
-								std::shared_ptr<AABBCollider2D>& aabb2 = entityToAABBMap[entity2];
-								Rigidbody2D& rb2 = ECSManager::GetInstance().GetComponent<Rigidbody2D>(entity2);
-								DetectAndResolveCollision(entity1, entity2, aabb1, aabb2, rb1, rb2, (float)dt);
-								continue;
-							}
-						}
-					}
+			PROFILE_SCOPE("Physics Collisions");
+			// Drop bodies that were destroyed or became kinematic since the last step.
+			spatialGrid.RemoveStale();
+
+			// Each pair of bodies sharing a cell is reported once; run narrow-phase detection and resolution on them.
+			spatialGrid.GetCandidatePairs(candidatePairs);
+			PROFILE_COUNTER("Physics Candidate Pairs", candidatePairs.size());
+			for (auto const& [entity1, entity2] : candidatePairs) {
+				// Skip bodies destroyed by a collision callback earlier in this step.
+				if (m_entities.IsPendingErase(entity1) || m_entities.IsPendingErase(entity2)) continue;
+
+				// Check the entities' collision matrix to see if they should be able to collide.
+				Layer layer1 = ECSManager::GetInstance().GetEntityManager().GetLayer(entity1);
+				Layer layer2 = ECSManager::GetInstance().GetEntityManager().GetLayer(entity2);
+				if (LayerManager::GetInstance().CanLayersCollide(layer1, layer2)) {
+					AABBCollider2D& aabb1 = ECSManager::GetInstance().GetComponent<AABBCollider2D>(entity1);
+					Rigidbody2D& rb1 = ECSManager::GetInstance().GetComponent<Rigidbody2D>(entity1);
+					AABBCollider2D& aabb2 = ECSManager::GetInstance().GetComponent<AABBCollider2D>(entity2);
+					Rigidbody2D& rb2 = ECSManager::GetInstance().GetComponent<Rigidbody2D>(entity2);
+					DetectAndResolveCollision(entity1, entity2, aabb1, aabb2, rb1, rb2, (float)dt);
 				}
 			}
-
-			ResetBitsetGrid();
 		}
 		else {
 			//Rigidbody2D& rb = ECSManager::GetInstance().GetComponent<Rigidbody2D>(*it);
@@ -168,24 +168,14 @@ void PhysicsSystem::Update(double dt) {
 			// Non-broad-phase collision detection (no optimization).
 			// loop through all entities.
 			for (auto it1 = m_entities.begin(); it1 != m_entities.end(); ++it1) {
-				std::shared_ptr<AABBCollider2D> aabb1 = entityToAABBMap[*it1];
-				//AABBCollider2D& aabb1 = ECSManager::GetInstance().GetComponent<AABBCollider2D>(*it1);
+				AABBCollider2D& aabb1 = ECSManager::GetInstance().GetComponent<AABBCollider2D>(*it1);
 				Rigidbody2D& rb1 = ECSManager::GetInstance().GetComponent<Rigidbody2D>(*it1);
 
-				//if (!IsRBStatic(rb1)) {
-				//	UpdateRBPosition(rb1, (float)fixedDeltaTime, *it1);
-
-				//	//aabb.isUpdated = false;
-				//	// Update the AABBCollider based on the Rigidbody's position.
-				//	UpdateAABBCollider(*it1);
-				//}
-
 				if (IsRBKinematic(rb1)) continue;
 
 				// check for collision between entities.
 				for (auto it2 = std::next(it1, 1); it2 != m_entities.end(); ++it2) {
-					std::shared_ptr<AABBCollider2D> aabb2 = entityToAABBMap[*it2];
-					//AABBCollider2D& aabb2 = ECSManager::GetInstance().GetComponent<AABBCollider2D>(*it2);
+					AABBCollider2D& aabb2 = ECSManager::GetInstance().GetComponent<AABBCollider2D>(*it2);
 					Rigidbody2D& rb2 = ECSManager::GetInstance().GetComponent<Rigidbody2D>(*it2);
 					DetectAndResolveCollision(*it1, *it2, aabb1, aabb2, rb1, rb2, (float)dt);
 				}
@@ -195,17 +185,51 @@ void PhysicsSystem::Update(double dt) {
 		CleanupCollisions((float)dt);
 	}
 
-	for (auto it = m_entities.begin(); it != m_entities.end(); ++it) {
-		// Update the AABBCollider based on the Rigidbody's position.
-		UpdateAABBCollider(*it);
-	}
+	// Each collider only depends on its own rigidbody, so the entities are split across the workers.
+	auto const& entities = m_entities.GetEntities();
+	JobSystem::GetInstance().ParallelFor(entities.size(), COLLIDER_UPDATE_CHUNK_SIZE, [this, &entities](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			if (m_entities.IsPendingErase(entities[i])) continue;
 
-	entityToAABBMap.clear();
-	entityToRBMap.clear();
+			// Update the AABBCollider based on the Rigidbody's position.
+			UpdateAABBCollider(entities[i]);
+		}
+	});
 }
 
 void PhysicsSystem::Exit() {
 	playerEntity = std::nullopt;
+	spatialGrid.Clear();
+	collisionEvents.clear();
+}
+
+void PhysicsSystem::QueueCollisionEvent(CollisionPhase phase, Entity entity, const Collision& collision) {
+	collisionEvents.push_back({ phase, entity, collision.isTrigger, ConvertCollisionToCS(entity, collision) });
+}
+
+void PhysicsSystem::DispatchCollisionEvents() {
+	PROFILE_SCOPE("PhysicsSystem::DispatchCollisionEvents");
+	for (CollisionEvent const& event : collisionEvents) {
+		// A callback sent earlier may have destroyed the entity.
+		if (!ECSManager::GetInstance().IsValid(event.entity)) continue;
+
+		if (!event.isTrigger) {
+			switch (event.phase) {
+			case CollisionPhase::ENTER: ScriptEngine::OnEntityCollisionEnter(event.entity, event.collision); break;
+			case CollisionPhase::STAY: ScriptEngine::OnEntityCollisionStay(event.entity, event.collision); break;
+			case CollisionPhase::EXIT: ScriptEngine::OnEntityCollisionExit(event.entity, event.collision); break;
+			}
+		}
+		else {
+			ColliderCS colliderCS{ event.collision.otherEntity };
+			switch (event.phase) {
+			case CollisionPhase::ENTER: ScriptEngine::OnEntityTriggerEnter(event.entity, colliderCS); break;
+			case CollisionPhase::STAY: ScriptEngine::OnEntityTriggerStay(event.entity, colliderCS); break;
+			case CollisionPhase::EXIT: ScriptEngine::OnEntityTriggerExit(event.entity, colliderCS); break;
+			}
+		}
+	}
+	collisionEvents.clear();
 }
 
 bool PhysicsSystem::IsStepByStepMode() {
@@ -223,12 +247,15 @@ bool PhysicsSystem::IsBroadPhaseMode() {
 
 void PhysicsSystem::SetBroadPhaseMode(bool _bool) {
 	broadPhaseMode = _bool;
+	// The grid is only maintained while broad-phase is on; rebuild it from scratch when it is turned back on.
+	spatialGrid.Clear();
 }
 
 // Add AABBCollider component with automatic size based on mesh size.
 void PhysicsSystem::AddAABBColliderComponent(Entity entity) {
 	// Get the mesh's min and max points.
 	size_t meshID = ECSManager::GetInstance().GetComponent<Renderer>(entity).currentMeshID;
+	GraphicsManager::GetInstance().meshes[meshID].UpdatePositions();
 	Vec2 min = Vec2(GraphicsManager::GetInstance().meshes[meshID].vertices[0].position.x, GraphicsManager::GetInstance().meshes[meshID].vertices[0].position.y);
 	Vec2 max = Vec2(GraphicsManager::GetInstance().meshes[meshID].vertices[0].position.x, GraphicsManager::GetInstance().meshes[meshID].vertices[0].position.y);
 
@@ -299,10 +326,6 @@ void PhysicsSystem::SetAABBColliderPos(Entity entity, const Vec2& pos) {
 	ECSManager::GetInstance().GetComponent<AABBCollider2D>(entity).centerPos = pos;
 }
 
-std::map<Entity, std::shared_ptr<AABBCollider2D>>& PhysicsSystem::GetEntityToAABBMap() {
-	return entityToAABBMap;
-}
-
 std::vector<Collision>& PhysicsSystem::GetCollisions(Entity entity) {
 	return ECSManager::GetInstance().GetComponent<AABBCollider2D>(entity).collisions;
 }
@@ -321,15 +344,8 @@ void PhysicsSystem::AddOrUpdateCollisions(Entity entity, const Collision& collis
 		*it = collision;
 	}
 
-	// Call the OnCollisionStay or OnTriggerStay functions respectively.
-	if (!collision.isTrigger) {
-		CollisionCS collisionCS = ConvertCollisionToCS(entity, collision);
-		ScriptEngine::OnEntityCollisionStay(entity, collisionCS);
-	}
-	else {
-		ColliderCS colliderCS{ collision.entity };
-		ScriptEngine::OnEntityTriggerStay(entity, colliderCS);
-	}
+	// Queue the OnCollisionStay or OnTriggerStay functions respectively.
+	QueueCollisionEvent(CollisionPhase::STAY, entity, collision);
 }
 
 bool PhysicsSystem::IsColliderEnter(Entity entity, const Collision& collision) {
@@ -339,10 +355,13 @@ bool PhysicsSystem::IsColliderEnter(Entity entity, const Collision& collision) {
 
 void PhysicsSystem::CleanupCollisions(float dt) {
 	// Loop through the entities.
-	for (auto& entityAABB : entityToAABBMap) {
-		entityAABB.second->staticCollisions.clear();
+	for (Entity entity : m_entities) {
+		if (m_entities.IsPendingErase(entity)) continue;
+
+		AABBCollider2D& aabb = ECSManager::GetInstance().GetComponent<AABBCollider2D>(entity);
+		aabb.staticCollisions.clear();
 
-		auto& collisions = entityAABB.second->collisions;
+		auto& collisions = aabb.collisions;
 		// Loop through the current entity's collisions vector.
 		for (auto it = collisions.begin(); it != collisions.end();) {
 			// Reset the current collision's noCollisionDuration and resolved bool.
@@ -351,15 +370,8 @@ void PhysicsSystem::CleanupCollisions(float dt) {
 
 			// If the current collision has had no collisions for longer than the threshold duration
 			if (it->noCollisionDuration >= Collision::noCollisionDurationThreshold) {
-				// Call the OnCollisionExit or OnTriggerExit functions respectively.
-				if (!it->isTrigger) {
-					CollisionCS collisionCS = ConvertCollisionToCS(entityAABB.first, *it);
-					ScriptEngine::OnEntityCollisionExit(entityAABB.first, collisionCS);
-				}
-				else {
-					ColliderCS colliderCS{ it->entity };
-					ScriptEngine::OnEntityTriggerExit(entityAABB.first, colliderCS);
-				}
+				// Queue the OnCollisionExit or OnTriggerExit functions respectively.
+				QueueCollisionEvent(CollisionPhase::EXIT, entity, *it);
 
 				it = collisions.erase(it);
 			}
@@ -384,16 +396,16 @@ void PhysicsSystem::CleanupCollisions(float dt) {
 //	}
 //}
 
-bool PhysicsSystem::DetectCollisionEnterAABB_AABB(std::shared_ptr<AABBCollider2D> aabb1, const Vec2& vel1, std::shared_ptr<AABBCollider2D> aabb2, const Vec2& vel2, Collision& col1, Collision& col2, float fixedDt)
+bool PhysicsSystem::DetectCollisionEnterAABB_AABB(const AABBCollider2D& aabb1, const Vec2& vel1, const AABBCollider2D& aabb2, const Vec2& vel2, Collision& col1, Collision& col2, float fixedDt)
 {
 	// Check static collision
 	bool staticCollision = true;
 
 	// If any of these are true, there is no collision.
-	if (aabb1->min.x > aabb2->max.x) staticCollision = false;
-	if (aabb2->min.x > aabb1->max.x) staticCollision = false;
-	if (aabb1->max.y < aabb2->min.y) staticCollision = false;
-	if (aabb2->max.y < aabb1->min.y) staticCollision = false;
+	if (aabb1.min.x > aabb2.max.x) staticCollision = false;
+	if (aabb2.min.x > aabb1.max.x) staticCollision = false;
+	if (aabb1.max.y < aabb2.min.y) staticCollision = false;
+	if (aabb2.max.y < aabb1.min.y) staticCollision = false;
 
 	// Get the relative velocity
 	Vec2 vRel{};
@@ -408,40 +420,40 @@ bool PhysicsSystem::DetectCollisionEnterAABB_AABB(std::shared_ptr<AABBCollider2D
 		// X-axis dynamic collision check
 		if (vRel.x < 0) {
 			// Case 1: object 2 moving away from object 1 (to the left) (no collision)
-			if (aabb1->min.x > aabb2->max.x) {
+			if (aabb1.min.x > aabb2.max.x) {
 				return false;
 			}
 			// Case 4: object 2 moving towards object 1 (to the left)
-			if (aabb1->max.x < aabb2->min.x) {
-				dFirst = aabb1->max.x - aabb2->min.x;
+			if (aabb1.max.x < aabb2.min.x) {
+				dFirst = aabb1.max.x - aabb2.min.x;
 				tFirst = fmax(dFirst / vRel.x, tFirst);
 			}
-			if (aabb1->min.x < aabb2->max.x) {
-				dLast = aabb1->min.x - aabb2->max.x;
+			if (aabb1.min.x < aabb2.max.x) {
+				dLast = aabb1.min.x - aabb2.max.x;
 				tLast = fmin(dLast / vRel.x, tLast);
 			}
 		}
 		else if (vRel.x > 0) {
 			// Case 2: object 2 moving towards object 1 (to the right)
-			if (aabb1->min.x > aabb2->max.x) {
-				dFirst = aabb1->min.x - aabb2->max.x;
+			if (aabb1.min.x > aabb2.max.x) {
+				dFirst = aabb1.min.x - aabb2.max.x;
 				tFirst = fmax(dFirst / vRel.x, tFirst);
 			}
-			if (aabb1->max.x > aabb2->min.x) {
-				dLast = aabb1->max.x - aabb2->min.x;
+			if (aabb1.max.x > aabb2.min.x) {
+				dLast = aabb1.max.x - aabb2.min.x;
 				tLast = fmin(dLast / vRel.x, tLast);
 			}
 			// Case 3: object 2 moving away from object 1 (to the right) (no collision)
-			if (aabb1->max.x < aabb2->min.x) {
+			if (aabb1.max.x < aabb2.min.x) {
 				return false;
 			}
 		}
 		else if (vRel.x == 0) {
 			// Case 5: object 2 is moving perpendicular to object 1 (no collision)
-			if (aabb1->max.x < aabb2->min.x) {
+			if (aabb1.max.x < aabb2.min.x) {
 				return false;
 			}
-			else if (aabb1->min.x > aabb2->max.x) {
+			else if (aabb1.min.x > aabb2.max.x) {
 				return false;
 			}
 		}
@@ -454,40 +466,40 @@ bool PhysicsSystem::DetectCollisionEnterAABB_AABB(std::shared_ptr<AABBCollider2D
 		// Y-axis check
 		if (vRel.y < 0) {
 			// Case 1: object 2 moving away from object 1 (downwards) (no collision)
-			if (aabb1->min.y > aabb2->max.y) {
+			if (aabb1.min.y > aabb2.max.y) {
 				return false;
 			}
 			// Case 4: object 2 moving towards object 1 (downwards)
-			if (aabb1->max.y < aabb2->min.y) {
-				dFirst = aabb1->max.y - aabb2->min.y;
+			if (aabb1.max.y < aabb2.min.y) {
+				dFirst = aabb1.max.y - aabb2.min.y;
 				tFirst = fmax(dFirst / vRel.y, tFirst);
 			}
-			if (aabb1->min.y < aabb2->max.y) {
-				dLast = aabb1->min.y - aabb2->max.y;
+			if (aabb1.min.y < aabb2.max.y) {
+				dLast = aabb1.min.y - aabb2.max.y;
 				tLast = fmin(dLast / vRel.y, tLast);
 			}
 		}
 		else if (vRel.y > 0) {
 			// Case 2: object 2 moving towards object 1 (upwards)
-			if (aabb1->min.y > aabb2->max.y) {
-				dFirst = aabb1->min.y - aabb2->max.y;
+			if (aabb1.min.y > aabb2.max.y) {
+				dFirst = aabb1.min.y - aabb2.max.y;
 				tFirst = fmax(dFirst / vRel.y, tFirst);
 			}
-			if (aabb1->max.y > aabb2->min.y) {
-				dLast = aabb1->max.y - aabb2->min.y;
+			if (aabb1.max.y > aabb2.min.y) {
+				dLast = aabb1.max.y - aabb2.min.y;
 				tLast = fmin(dLast / vRel.y, tLast);
 			}
 			// Case 3: object 2 moving away from object 1 (upwards) (no collision)
-			if (aabb1->max.y < aabb2->min.y) {
+			if (aabb1.max.y < aabb2.min.y) {
 				return false;
 			}
 		}
 		else if (vRel.y == 0) {
 			// Case 5: object 2 is moving perpendicular to object 1 (no collision)
-			if (aabb1->max.y < aabb2->min.y) {
+			if (aabb1.max.y < aabb2.min.y) {
 				return false;
 			}
-			else if (aabb1->min.y > aabb2->max.y) {
+			else if (aabb1.min.y > aabb2.max.y) {
 				return false;
 			}
 		}
@@ -502,7 +514,7 @@ bool PhysicsSystem::DetectCollisionEnterAABB_AABB(std::shared_ptr<AABBCollider2D
 	const int numSides = 4;
 	// sides (and eventually contact point normal) vector is relative to aabb1
 	std::array<Vec2, numSides> sides = { Vec2{-1.f, 0.f}, Vec2{1.0f, 0.f}, Vec2{0.f, -1.f}, Vec2{0.f, 1.f} };
-	std::array<float, numSides> distances = { (aabb2->max.x - aabb1->min.x), (aabb1->max.x - aabb2->min.x), (aabb2->max.y - aabb1->min.y), (aabb1->max.y - aabb2->min.y) };
+	std::array<float, numSides> distances = { (aabb2.max.x - aabb1.min.x), (aabb1.max.x - aabb2.min.x), (aabb2.max.y - aabb1.min.y), (aabb1.max.y - aabb2.min.y) };
 
 	float penetration = std::numeric_limits<float>::max();
 	Vec2 normal{};
@@ -520,12 +532,12 @@ bool PhysicsSystem::DetectCollisionEnterAABB_AABB(std::shared_ptr<AABBCollider2D
 	//float overlapY = std::max(0.0f, std::min(aabb1.max.y, aabb2.max.y) - std::max(aabb1.min.y, aabb2.min.y)); 
 
 	// The contact point will be the midpoint of the overlap.
-	col1.contactPoint.point.x = (std::max(aabb1->min.x, aabb2->min.x) + std::min(aabb1->max.x, aabb2->max.x)) / 2.f;
-	col1.contactPoint.point.y = (std::max(aabb1->min.y, aabb2->min.y) + std::min(aabb1->max.y, aabb2->max.y)) / 2.f;
+	col1.contactPoint.point.x = (std::max(aabb1.min.x, aabb2.min.x) + std::min(aabb1.max.x, aabb2.max.x)) / 2.f;
+	col1.contactPoint.point.y = (std::max(aabb1.min.y, aabb2.min.y) + std::min(aabb1.max.y, aabb2.max.y)) / 2.f;
 	col2.contactPoint.point = col1.contactPoint.point;
 
-	if ((normal.y < 0.f && aabb1->min.y < aabb2->max.y && vel1.y > 0.f) || 
-		(normal.y > 0.f && aabb2->min.y < aabb1->max.y && vel2.y > 0.f))
+	if ((normal.y < 0.f && aabb1.min.y < aabb2.max.y && vel1.y > 0.f) || 
+		(normal.y > 0.f && aabb2.min.y < aabb1.max.y && vel2.y > 0.f))
 	{
 		normal.x = -normal.y;
 		normal.y = 0.f;
@@ -536,15 +548,9 @@ bool PhysicsSystem::DetectCollisionEnterAABB_AABB(std::shared_ptr<AABBCollider2D
 	//	return false;
 
 	col1.contactPoint.penetration = penetration;
-	col1.contactPoint.thisCollider = aabb1;
-	col1.contactPoint.otherCollider = aabb2;
-	col1.collider = col1.contactPoint.otherCollider;
 
 	col2.contactPoint.normal = -normal;
 	col2.contactPoint.penetration = penetration;
-	col2.contactPoint.thisCollider = aabb2;
-	col2.contactPoint.otherCollider = aabb1;
-	col2.collider = col2.contactPoint.otherCollider;
 
 	return true;
 }
@@ -618,13 +624,12 @@ void PhysicsSystem::ResolveCollision(Entity entity, Rigidbody2D& rb, float bounc
 
 	Vec2 impulse{};
 	if (resolve) {
-		if (auto aabb1 = col1.contactPoint.thisCollider.lock()) {
-			if (auto aabb2 = col1.contactPoint.otherCollider.lock()) {
-				if (col1.contactPoint.normal.x != 0.f && (std::min(aabb1->max.y, aabb2->max.y) - col1.contactPoint.point.y) < Collision::edgeCollisionThreshold) {
-					SetRBPosition(entity, GetRBPosition(entity).x, GetRBPosition(entity).y + std::min(aabb1->max.y, aabb2->max.y) - col1.contactPoint.point.y);
-					return;
-				}
-			}
+		// col1 is relative to this entity's collider, and col1.entity is the other entity hit.
+		AABBCollider2D& aabb1 = ECSManager::GetInstance().GetComponent<AABBCollider2D>(entity);
+		AABBCollider2D& aabb2 = ECSManager::GetInstance().GetComponent<AABBCollider2D>(col1.entity);
+		if (col1.contactPoint.normal.x != 0.f && (std::min(aabb1.max.y, aabb2.max.y) - col1.contactPoint.point.y) < Collision::edgeCollisionThreshold) {
+			SetRBPosition(entity, GetRBPosition(entity).x, GetRBPosition(entity).y + std::min(aabb1.max.y, aabb2.max.y) - col1.contactPoint.point.y);
+			return;
 		}
 		// calculate the position correction to prevent clipping.
 		// define the penetration percentage correction per frame.
@@ -674,7 +679,7 @@ void PhysicsSystem::ResolveCollision(Entity entity, Rigidbody2D& rb, float bounc
 	col2.relativeVelocity = -GetRBVelocity(rb);
 }
 
-void PhysicsSystem::DetectAndResolveCollision(Entity entity1, Entity entity2, std::shared_ptr<AABBCollider2D> aabb1, std::shared_ptr<AABBCollider2D> aabb2, Rigidbody2D& rb1, Rigidbody2D& rb2, float dt) {
+void PhysicsSystem::DetectAndResolveCollision(Entity entity1, Entity entity2, AABBCollider2D& aabb1, AABBCollider2D& aabb2, Rigidbody2D& rb1, Rigidbody2D& rb2, float dt) {
 	std::vector<Collision>& collisions1 = GetCollisions(entity1);
 	//std::vector<Collision>& collisions2 = GetCollisions(entity2);
 
@@ -716,25 +721,11 @@ void PhysicsSystem::DetectAndResolveCollision(Entity entity1, Entity entity2, st
 
 		// If the collision between the entities is 'new'
 		if (IsColliderEnter(entity1, col1)) {
-			// Call the OnCollisionEnter or OnTriggerEnter functions respectively.
-			if (!isTrigger) {
-				CollisionCS col1cs = ConvertCollisionToCS(entity1, col1);
-				ScriptEngine::OnEntityCollisionEnter(entity1, col1cs);
-			}
-			else {
-				ColliderCS colliderCS{ col1.entity };
-				ScriptEngine::OnEntityTriggerEnter(entity1, colliderCS);
-			}
+			// Queue the OnCollisionEnter or OnTriggerEnter functions respectively.
+			QueueCollisionEvent(CollisionPhase::ENTER, entity1, col1);
 		}
 		if (IsColliderEnter(entity2, col2)) {
-			if (!isTrigger) {
-				CollisionCS col2cs = ConvertCollisionToCS(entity2, col2);
-				ScriptEngine::OnEntityCollisionEnter(entity2, col2cs);
-			}
-			else {
-				ColliderCS colliderCS{ col2.entity };
-				ScriptEngine::OnEntityTriggerEnter(entity2, colliderCS);
-			}
+			QueueCollisionEvent(CollisionPhase::ENTER, entity2, col2);
 		}
 
 		AddOrUpdateCollisions(entity1, col1);
@@ -743,12 +734,12 @@ void PhysicsSystem::DetectAndResolveCollision(Entity entity1, Entity entity2, st
 		if (collisionResponse) {
 			// Resolve collision between entities.
 			if (aabb1RbResponse && aabb2RbResponse) {
-				ResolveCollision(entity1, rb1, aabb1->bounciness, entity2, rb2, aabb2->bounciness, col1, col2, dt);
+				ResolveCollision(entity1, rb1, aabb1.bounciness, entity2, rb2, aabb2.bounciness, col1, col2, dt);
 			}
 			else if (aabb1RbResponse)
-				ResolveCollision(entity1, rb1, aabb1->bounciness, aabb2->bounciness, col1, col2, dt);
+				ResolveCollision(entity1, rb1, aabb1.bounciness, aabb2.bounciness, col1, col2, dt);
 			else if (aabb2RbResponse) {
-				ResolveCollision(entity2, rb2, aabb2->bounciness, aabb1->bounciness, col2, col1, dt);
+				ResolveCollision(entity2, rb2, aabb2.bounciness, aabb1.bounciness, col2, col1, dt);
 			}
 		}
 	}
@@ -906,18 +897,8 @@ inline ForcesManager& PhysicsSystem::GetRBForcesManager(Rigidbody2D& rb) {
 	return rb.forcesManager;
 }
 
-BitsetGrid& PhysicsSystem::GetBitsetGrid() {
-	return bitsetGrid;
-}
-
-void PhysicsSystem::ResetBitsetGrid() {
-	bitsetGrid.ClearGrid();
-	for (auto it = entityToAABBMap.begin(); it != entityToAABBMap.end(); ++it) {
-		it->second->idInGrid = static_cast<size_t>(-1);
-		it->second->rowsOccupied = std::pair<size_t, size_t>{};
-		it->second->colsOccupied = std::pair<size_t, size_t>{};
-		it->second->inGrid = false;
-	}
+SpatialHashGrid& PhysicsSystem::GetSpatialGrid() {
+	return spatialGrid;
 }
 
 //void PhysicsSystem::RemoveAABBFromMap(Entity entity) {
@@ -928,10 +909,6 @@ void PhysicsSystem::ResetBitsetGrid() {
 //	entityToRBMap.erase(entity);
 //}
 
-std::map<Entity, std::reference_wrapper<Rigidbody2D>>& PhysicsSystem::GetEntityToRBMap() {
-	return entityToRBMap;
-}
-
 // Add a force with an auto-assigned ID and return the ID.
 size_t PhysicsSystem::AddForce(Rigidbody2D& rb, const LinearForce& force) {
 	std::queue<size_t>& freeIDs = GetRBForcesManager(rb).freeIDs;
@@ -1062,60 +1039,50 @@ void PhysicsSystem::UpdateLinearForceLifetime(ForcesManager& forcesManager, size
 	}
 }
 
-void PhysicsSystem::CalculateDragForce(Rigidbody2D& rb, const Vec2& currResultantForce, float fixedDt) {
-	// For drag, calculate the drag force first based on the velocity before drag.
-	Vec2 currAcceleration = currResultantForce / GetRBMass(rb);
-	Vec2 currVelocity = GetRBVelocity(rb) + (currAcceleration * fixedDt);
-	float speed = currVelocity.Length();
-	Vec2 dragDirection = -(currVelocity.Normalized());
-
-	GetRBForcesManager(rb).alwaysActiveForces[LinearForceIDs::DRAG_FORCEID].unitDirection = dragDirection;
-	GetRBForcesManager(rb).alwaysActiveForces[LinearForceIDs::DRAG_FORCEID].magnitude = 0.5f * speed * GetRBDrag(rb);
-}
-
-void PhysicsSystem::ApplyGravityForce(Rigidbody2D& rb) {
-	float gravityForce = GetRBGravityScale(rb) * gravity * GetRBMass(rb);
-	GetRBForcesManager(rb).alwaysActiveForces[LinearForceIDs::GRAVITY_FORCEID].magnitude = gravityForce;
-}
+void PhysicsSystem::AccumulateForces(Rigidbody2D& rb, float fixedDt, size_t body) {
+	ForcesManager& forcesManager = GetRBForcesManager(rb);
+	std::map<size_t, LinearForce>& alwaysActiveForces = forcesManager.alwaysActiveForces;
+	Vec2 force{};
+	bool hasGravity = false;
+	bool hasDrag = false;
 
-void PhysicsSystem::UpdateRBPosition(Rigidbody2D& rb, float fixedDt, Entity entity) {
-	if (fixedDt < 0.2f) {
+	// Most bodies only have the gravity and drag added by AddDragAndGravity; their flags are read off the ends
+	// of the map, as drag has the largest ID and gravity the smallest one in use.
+	if (forcesManager.linearForces.empty() && alwaysActiveForces.size() == 2
+		&& alwaysActiveForces.begin()->first == LinearForceIDs::GRAVITY_FORCEID
+		&& alwaysActiveForces.rbegin()->first == LinearForceIDs::DRAG_FORCEID) {
+		hasGravity = hasDrag = true;
+	}
+	else {
 		// Calculate resultant force of all active forces acting on the Rigidbody.
-		ForcesManager& forcesManager = GetRBForcesManager(rb);
-		forcesManager.resultantForce = 0;
-		std::map<size_t, LinearForce> linearForces = forcesManager.linearForces;
-		for (auto& linearForce : linearForces) {
-			if (linearForce.second.isActive) {
-				forcesManager.resultantForce += (linearForce.second.unitDirection * linearForce.second.magnitude);
-				UpdateLinearForceLifetime(GetRBForcesManager(rb), linearForce.first, fixedDt);
+		std::map<size_t, LinearForce>& linearForces = forcesManager.linearForces;
+		for (auto it = linearForces.begin(); it != linearForces.end();) {
+			// Advance first, as updating the lifetime may erase the current force.
+			auto current = it++;
+			if (current->second.isActive) {
+				force += (current->second.unitDirection * current->second.magnitude);
+				UpdateLinearForceLifetime(forcesManager, current->first, fixedDt);
 			}
 		}
 
-		// Update resultant force after applying all always active forces.
-		std::map<size_t, LinearForce>& alwaysActiveForces = GetRBForcesManager(rb).alwaysActiveForces;
+		// Add the always active forces except gravity and drag, which the body store applies to every body at once.
 		for (auto& alwaysActiveForce : alwaysActiveForces) {
-			if (alwaysActiveForce.first == LinearForceIDs::DRAG_FORCEID)
-				CalculateDragForce(rb, forcesManager.resultantForce, fixedDt);
+			if (alwaysActiveForce.first == LinearForceIDs::DRAG_FORCEID) {
+				hasDrag = true;
+			}
 			else if (alwaysActiveForce.first == LinearForceIDs::GRAVITY_FORCEID) {
-				ApplyGravityForce(rb);
+				hasGravity = true;
+			}
+			else {
+				force += (alwaysActiveForce.second.unitDirection * alwaysActiveForce.second.magnitude);
 			}
-
-			forcesManager.resultantForce += (alwaysActiveForce.second.unitDirection * alwaysActiveForce.second.magnitude);
 		}
-
-		// Apply the resultant force on the Rigidbody's velocity.
-		Vec2 acceleration = forcesManager.resultantForce / GetRBMass(rb);
-		SetRBVelocity(rb, GetRBVelocity(rb) + (acceleration * fixedDt));
-		//if (IsRBGrounded(rb) && GetRBVelocity(rb).y < 0.f && GetRBGravityScale(rb) > 0.f) {
-		//	SetRBVelocity(rb, GetRBVelocity(rb).x, 0);
-		//}
 	}
 
-	rb.oldPosition = GetRBPosition(entity);
-	// update the position of the rigidbody based on its final velocity.
-	SetRBPosition(entity, GetRBPosition(entity) + (GetRBVelocity(rb) * fixedDt));
-	//// Update the collider based on the rigidbody position.
-	//SetAABBColliderPos(entity, GetRBPosition(entity) + ECSManager::GetInstance().GetComponent<AABBCollider2D>(entity).offset);
+	bodyStore.forceX[body] = force.x;
+	bodyStore.forceY[body] = force.y;
+	bodyStore.gravityWeight[body] = hasGravity ? GetRBGravityScale(rb) * GetRBMass(rb) : 0.f;
+	bodyStore.dragCoef[body] = hasDrag ? 0.5f * GetRBDrag(rb) : 0.f;
 }
 
 //void PhysicsSystem::AddContact(Collider2D& thisCollider, Collider2D& otherCollider) {
@@ -16,7 +16,11 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 
 #include <vector>
 #include <functional>
-#include "BitsetGrid.hpp"
+#include <map>
+#include <memory>
+#include <optional>
+#include "SpatialHashGrid.hpp"
+#include "RigidbodyStore.hpp"
 #include "../ECS/System.hpp"
 #include "../Components/Collider2D.hpp"
 #include "../Components/Rigidbody2D.hpp"
@@ -29,13 +33,33 @@ prior written consent of DigiPen Institute of Technology is prohibited.
  * Rigidbody2D and AABBCollider2D. Also responsible for handling the detection and resolution
  * of collisions between entities with such components.
  */
-class PhysicsSystem : public System {
+class PhysicsSystem : public System, public QueryObserver {
 public:
+	/**
+	 * \brief Constructs the Physics system, keeping its body store in step with its entities.
+	 */
+	PhysicsSystem();
+
 	/**
 	 * \brief Initializes the Physics system.
 	 */
 	void Init();
 
+	/**
+	 * \brief Adds a body store slot for an entity that started matching the system.
+	 */
+	void OnEntityInserted(Entity entity) override;
+
+	/**
+	 * \brief Removes the body store slot of an entity that stopped matching the system.
+	 */
+	void OnEntityErased(Entity entity) override;
+
+	/**
+	 * \brief Empties the body store when every entity is destroyed at once.
+	 */
+	void OnEntitiesCleared() override;
+
 	/**
 	 * \brief Adds drag and gravity force as an always active force to the Rigidbody.
 	 *
@@ -47,14 +71,24 @@ public:
 	 * \brief Updates the Physics components of the physics objects in the game.
 	 * 
 	 * \param dt Time between current frame and previous frame.
+	 * \param physicsUpdate False to skip the step, as step by step mode does until N is pressed.
+	 *        Input is read on the main thread and passed in, since Update may run on a worker.
 	 */
-	void Update(double dt);
+	void Update(double dt, bool physicsUpdate = true);
 
 	/**
 	 * \brief Terminates the Physics system.
 	 */
 	void Exit();
 
+	/**
+	 * \brief Sends the collision and trigger callbacks queued by Update to the scripts.
+	 *
+	 * Update does not call into scripts, so it can run on a worker thread alongside other
+	 * systems. Call this on the main thread once the physics step has finished.
+	 */
+	void DispatchCollisionEvents();
+
 	/**
 	 * \brief Return true if step by step mode is enabled and false otherwise.
 	 * \return True if step by step mode is enabled and false otherwise.
@@ -199,12 +233,6 @@ public:
 	 */
 	void CalculateColliderPosOffset(Entity entity);
 
-	/**
-	 * \brief Returns a reference to the Entity-To-AABBCollider map.
-	 * \return Reference to the Entity-To-AABBCollider map.
-	 */
-	std::map<Entity, std::shared_ptr<AABBCollider2D>>& GetEntityToAABBMap();
-
 	/**
 	 * \brief Returns a reference to the entity's collisions vector.
 	 * 
@@ -215,9 +243,9 @@ public:
 
 	/**
 	 * \brief Adds the Collision info to the entity's collisions vector if it is a new
-	 *  collision, or update the existing Collision info otherwise. Also invokes the
-	 *  OnCollisionEnter, OnTriggerEnter, OnCollisionStay or OnTriggerStay functions on
-	 *	any Script component attached to the entity.
+	 *  collision, or update the existing Collision info otherwise. Also queues the
+	 *  OnCollisionStay or OnTriggerStay functions for any Script component attached to
+	 *	the entity.
 	 * 
 	 * \param entity Entity to add or update the collision info.
 	 * \param collision The new Collision info detected by the physics system on the entity.
@@ -235,8 +263,8 @@ public:
 
 	/**
 	 * \brief Resets all entities' collisions vector and checks for any collision exits.
-	 *  If a collision exit is detected, invokes the OnCollisionExit or OnTriggerExit
-	 *  function on any Script component attached to the entity.
+	 *  If a collision exit is detected, queues the OnCollisionExit or OnTriggerExit
+	 *  function for any Script component attached to the entity.
 	 * 
 	 * \param dt Time since the last frame.
 	 */
@@ -256,7 +284,7 @@ public:
 	 * \param dt Time between previous and current frame.
 	 * \return True if collision detected and false otherwise.
 	 */
-	bool DetectCollisionEnterAABB_AABB(std::shared_ptr<AABBCollider2D> aabb1, const Vec2& vel1, std::shared_ptr<AABBCollider2D> aabb2, const Vec2& vel2, Collision& col1, Collision& col2, float dt);
+	bool DetectCollisionEnterAABB_AABB(const AABBCollider2D& aabb1, const Vec2& vel1, const AABBCollider2D& aabb2, const Vec2& vel2, Collision& col1, Collision& col2, float dt);
 
 	/**
 	 * \brief Resolves collision between two physics objects with non-static
@@ -298,7 +326,7 @@ public:
 	 * \param rb2 Reference to the second entity's Rigidbody2D component.
 	 * \param dt Time between previous and current frame.
 	 */
-	void DetectAndResolveCollision(Entity entity1, Entity entity2, std::shared_ptr<AABBCollider2D> aabb1, std::shared_ptr<AABBCollider2D> aabb2, Rigidbody2D& rb1, Rigidbody2D& rb2, float dt);
+	void DetectAndResolveCollision(Entity entity1, Entity entity2, AABBCollider2D& aabb1, AABBCollider2D& aabb2, Rigidbody2D& rb1, Rigidbody2D& rb2, float dt);
 
 	/**
 	 * \brief Helper function to convert the C++ Collision struct into a struct that is
@@ -494,13 +522,6 @@ public:
 	 */
 	inline ForcesManager& GetRBForcesManager(Rigidbody2D& rb);
 
-	/**
-	 * \brief Return a reference to the Entity-To-Rigidbody map.
-	 *
-	 * \return Reference to the Entity-To-Rigidbody map.
-	 */
-	std::map<Entity, std::reference_wrapper<Rigidbody2D>>& GetEntityToRBMap();
-
 	// Functionalities
 	/**
 	 * \brief Add a force with an auto-assigned ID and return the ID.
@@ -613,42 +634,27 @@ public:
 	void UpdateLinearForceLifetime(ForcesManager& forcesManager, size_t forceID, float dt);
 
 	/**
-	 * \brief Calculate the Rigidbody's drag force based on the current resultant force acting
-	 *  on the body.
+	 * \brief Fills in the forces of a body in the body store, updating the lifetimes of timed
+	 *  forces along the way.
 	 *
-	 * \param rb Reference to the Rigidbody.
-	 * \param currResultantForce Current resultant force acting on the body before drag.
-	 * \param dt Time since the last frame.
-	 */
-	void CalculateDragForce(Rigidbody2D& rb, const Vec2& currResultantForce, float dt);
-
-	/**
-	 * \brief Calculates the gravity force acting on the Rigidbody and applies it.
+	 * Gravity and drag are only flagged, through the body's gravityWeight and dragCoef, and
+	 * applied to every body at once by RigidbodyStore::Integrate. A body with no other forces,
+	 * the common case, skips walking its force maps.
 	 *
 	 * \param rb Reference to the Rigidbody.
+	 * \param dt Time since the last frame.
+	 * \param body Index of the body in the body store.
 	 */
-	void ApplyGravityForce(Rigidbody2D& rb);
+	void AccumulateForces(Rigidbody2D& rb, float dt, size_t body);
 
-	/**
-	 * \brief Updates the Rigidbody2D position based on gravity, drag and the final
-	 *	velocity.
-	 * \param rb Reference to the Rigidbody2D to update.
-	 * \param dt Time between previous and current frame.
-	 */
-	void UpdateRBPosition(Rigidbody2D& rb, float dt, Entity entity);
 #pragma endregion
 
 	/**
-	 * \brief Return a reference to the physics system's BitsetGrid.
+	 * \brief Return a reference to the physics system's broad-phase grid.
 	 *
-	 * \return Reference to the physics system's BitsetGrid.
-	 */
-	BitsetGrid& GetBitsetGrid();
-
-	/**
-	 * \brief Reset the bits in the BitsetGrid to 0.
+	 * \return Reference to the physics system's SpatialHashGrid.
 	 */
-	void ResetBitsetGrid();
+	SpatialHashGrid& GetSpatialGrid();
 
 	//void RemoveAABBFromMap(Entity entity);
 
@@ -660,10 +666,34 @@ private:
 	bool broadPhaseMode = true;
 
 	float edgeCollisionThreshold = 2.0f; // Threshold to ignore collision on edges to prevent collision bugs at the expense of collision accuracy.
-	BitsetGrid bitsetGrid{}; // Grid of bitsets used for broad-phase collision detection optimisation.
-	std::map<Entity, std::reference_wrapper<Rigidbody2D>> entityToRBMap; // Maps each entity to a reference to its Rigidbody.
-	std::map<Entity, std::shared_ptr<AABBCollider2D>> entityToAABBMap; // Maps each entity to a shared_ptr to its AABBCollider2D.
-	std::map<Entity, size_t> entityToGridIDMap;
+	SpatialHashGrid spatialGrid{}; // Hashed uniform grid used for broad-phase collision detection optimisation.
+	std::vector<std::pair<Entity, Entity>> candidatePairs; // Pairs sharing a grid cell, reused every step.
+	/**
+	 * \enum CollisionPhase
+	 * \brief Which of the OnCollision or OnTrigger functions a queued event calls.
+	 */
+	enum class CollisionPhase { ENTER, STAY, EXIT };
+
+	/**
+	 * \struct CollisionEvent
+	 * \brief A collision or trigger callback found during a step, sent by DispatchCollisionEvents.
+	 */
+	struct CollisionEvent {
+		CollisionPhase phase;
+		Entity entity;			// The entity whose scripts are called.
+		bool isTrigger;			// Calls the OnTrigger functions instead of the OnCollision ones.
+		CollisionCS collision;	// The collision relative to the entity, as it was when found.
+	};
+
+	/**
+	 * \brief Queues the OnCollision or OnTrigger function of the phase for the entity's scripts.
+	 */
+	void QueueCollisionEvent(CollisionPhase phase, Entity entity, const Collision& collision);
+
+	std::vector<CollisionEvent> collisionEvents; // Callbacks queued by Update, in the order they were found.
+	RigidbodyStore bodyStore; // Packed copy of the bodies, kept in step with m_entities and integrated together each step.
+	static constexpr size_t COLLIDER_UPDATE_CHUNK_SIZE = 512; // Entities per collider update job.
+	static constexpr size_t BODY_UPDATE_CHUNK_SIZE = 256; // Bodies per force accumulation and integration job.
 
 	// TEMP
 	std::optional<Entity> playerEntity = std::nullopt;
@@ -0,0 +1,181 @@
+/*********************************************************************
+ * \file	RigidbodyStore.cpp
+ * \brief	Defines a structure-of-arrays copy of the simulated
+			rigidbodies used for batched integration.
+ *
+ * \author	Wong Woon Li, woonli.wong, 2301308
+ * \email	woonli.wong@digipen.edu
+ * \date	20 October 2024
+
+Copyright(C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include "RigidbodyStore.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define RIGIDBODY_STORE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RIGIDBODY_STORE_SSE2
+#endif
+
+void RigidbodyStore::Clear() {
+	entities.clear();
+	bodies.clear();
+	moving.clear();
+	posX.clear(); posY.clear();
+	velX.clear(); velY.clear();
+	forceX.clear(); forceY.clear();
+	invMass.clear();
+	gravityWeight.clear();
+	dragCoef.clear();
+	dragX.clear(); dragY.clear();
+	indices.clear();
+}
+
+void RigidbodyStore::Add(Entity entity) {
+	if (!indices.emplace(entity, entities.size()).second) {
+		return;
+	}
+
+	entities.push_back(entity);
+	bodies.push_back(nullptr);
+	moving.push_back(0);
+	posX.push_back(0.f); posY.push_back(0.f);
+	velX.push_back(0.f); velY.push_back(0.f);
+	forceX.push_back(0.f); forceY.push_back(0.f);
+	invMass.push_back(0.f);
+	gravityWeight.push_back(0.f);
+	dragCoef.push_back(0.f);
+	dragX.push_back(0.f); dragY.push_back(0.f);
+}
+
+namespace {
+	/**
+	 * \brief Moves the last element into slot i and drops the last element.
+	 */
+	template <typename T>
+	void SwapRemove(std::vector<T>& column, size_t i) {
+		column[i] = column.back();
+		column.pop_back();
+	}
+}
+
+void RigidbodyStore::Remove(Entity entity) {
+	auto it = indices.find(entity);
+	if (it == indices.end()) {
+		return;
+	}
+
+	size_t i = it->second;
+	indices.erase(it);
+	if (i + 1 != entities.size()) {
+		indices[entities.back()] = i;
+	}
+
+	SwapRemove(entities, i);
+	SwapRemove(bodies, i);
+	SwapRemove(moving, i);
+	SwapRemove(posX, i); SwapRemove(posY, i);
+	SwapRemove(velX, i); SwapRemove(velY, i);
+	SwapRemove(forceX, i); SwapRemove(forceY, i);
+	SwapRemove(invMass, i);
+	SwapRemove(gravityWeight, i);
+	SwapRemove(dragCoef, i);
+	SwapRemove(dragX, i); SwapRemove(dragY, i);
+}
+
+void RigidbodyStore::Integrate(float dt, float gravity, bool applyForces, size_t begin, size_t end) {
+	size_t i = begin;
+
+	if (!applyForces) {
+		for (; i < end; ++i) {
+			posX[i] += velX[i] * dt;
+			posY[i] += velY[i] * dt;
+			dragX[i] = dragY[i] = 0.f;
+		}
+		return;
+	}
+
+	// Per body:
+	//   F    -= g * w                    gravity, pulling down
+	//   v1    = v + (F / m) * dt         velocity before drag
+	//   drag  = -0.5 * c * v1            same as -normalize(v1) * (0.5 * |v1| * c)
+	//   v    += ((F + drag) / m) * dt
+	//   p    += v * dt
+#if defined(RIGIDBODY_STORE_AVX2)
+	const __m256 vdt = _mm256_set1_ps(dt);
+	const __m256 vg = _mm256_set1_ps(gravity);
+	for (; i + 8 <= end; i += 8) {
+		__m256 im = _mm256_loadu_ps(&invMass[i]);
+		__m256 c = _mm256_loadu_ps(&dragCoef[i]);
+		__m256 fx = _mm256_loadu_ps(&forceX[i]);
+		__m256 fy = _mm256_sub_ps(_mm256_loadu_ps(&forceY[i]), _mm256_mul_ps(vg, _mm256_loadu_ps(&gravityWeight[i])));
+		__m256 vx = _mm256_loadu_ps(&velX[i]);
+		__m256 vy = _mm256_loadu_ps(&velY[i]);
+
+		__m256 imdt = _mm256_mul_ps(im, vdt);
+		__m256 v1x = _mm256_add_ps(vx, _mm256_mul_ps(fx, imdt));
+		__m256 v1y = _mm256_add_ps(vy, _mm256_mul_ps(fy, imdt));
+		__m256 dx = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_mul_ps(c, v1x));
+		__m256 dy = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_mul_ps(c, v1y));
+
+		vx = _mm256_add_ps(vx, _mm256_mul_ps(_mm256_add_ps(fx, dx), imdt));
+		vy = _mm256_add_ps(vy, _mm256_mul_ps(_mm256_add_ps(fy, dy), imdt));
+
+		_mm256_storeu_ps(&forceY[i], fy);
+		_mm256_storeu_ps(&velX[i], vx);
+		_mm256_storeu_ps(&velY[i], vy);
+		_mm256_storeu_ps(&posX[i], _mm256_add_ps(_mm256_loadu_ps(&posX[i]), _mm256_mul_ps(vx, vdt)));
+		_mm256_storeu_ps(&posY[i], _mm256_add_ps(_mm256_loadu_ps(&posY[i]), _mm256_mul_ps(vy, vdt)));
+		_mm256_storeu_ps(&dragX[i], dx);
+		_mm256_storeu_ps(&dragY[i], dy);
+	}
+#elif defined(RIGIDBODY_STORE_SSE2)
+	const __m128 vdt = _mm_set1_ps(dt);
+	const __m128 vg = _mm_set1_ps(gravity);
+	for (; i + 4 <= end; i += 4) {
+		__m128 im = _mm_loadu_ps(&invMass[i]);
+		__m128 c = _mm_loadu_ps(&dragCoef[i]);
+		__m128 fx = _mm_loadu_ps(&forceX[i]);
+		__m128 fy = _mm_sub_ps(_mm_loadu_ps(&forceY[i]), _mm_mul_ps(vg, _mm_loadu_ps(&gravityWeight[i])));
+		__m128 vx = _mm_loadu_ps(&velX[i]);
+		__m128 vy = _mm_loadu_ps(&velY[i]);
+
+		__m128 imdt = _mm_mul_ps(im, vdt);
+		__m128 v1x = _mm_add_ps(vx, _mm_mul_ps(fx, imdt));
+		__m128 v1y = _mm_add_ps(vy, _mm_mul_ps(fy, imdt));
+		__m128 dx = _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(c, v1x));
+		__m128 dy = _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(c, v1y));
+
+		vx = _mm_add_ps(vx, _mm_mul_ps(_mm_add_ps(fx, dx), imdt));
+		vy = _mm_add_ps(vy, _mm_mul_ps(_mm_add_ps(fy, dy), imdt));
+
+		_mm_storeu_ps(&forceY[i], fy);
+		_mm_storeu_ps(&velX[i], vx);
+		_mm_storeu_ps(&velY[i], vy);
+		_mm_storeu_ps(&posX[i], _mm_add_ps(_mm_loadu_ps(&posX[i]), _mm_mul_ps(vx, vdt)));
+		_mm_storeu_ps(&posY[i], _mm_add_ps(_mm_loadu_ps(&posY[i]), _mm_mul_ps(vy, vdt)));
+		_mm_storeu_ps(&dragX[i], dx);
+		_mm_storeu_ps(&dragY[i], dy);
+	}
+#endif
+
+	// Scalar fallback, and the bodies left over after the vector loop.
+	for (; i < end; ++i) {
+		forceY[i] -= gravity * gravityWeight[i];
+		float imdt = invMass[i] * dt;
+		float v1x = velX[i] + forceX[i] * imdt;
+		float v1y = velY[i] + forceY[i] * imdt;
+		dragX[i] = -dragCoef[i] * v1x;
+		dragY[i] = -dragCoef[i] * v1y;
+
+		velX[i] += (forceX[i] + dragX[i]) * imdt;
+		velY[i] += (forceY[i] + dragY[i]) * imdt;
+		posX[i] += velX[i] * dt;
+		posY[i] += velY[i] * dt;
+	}
+}
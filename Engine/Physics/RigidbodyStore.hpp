@@ -0,0 +1,88 @@
+/*********************************************************************
+ * \file	RigidbodyStore.hpp
+ * \brief	Declares a structure-of-arrays copy of the simulated
+			rigidbodies used for batched integration.
+ *
+ * \author	Wong Woon Li, woonli.wong, 2301308
+ * \email	woonli.wong@digipen.edu
+ * \date	20 October 2024
+
+Copyright(C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef RIGIDBODY_STORE_HPP
+#define RIGIDBODY_STORE_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "../ECS/Entity.hpp"
+#include "../Components/Rigidbody2D.hpp"
+
+/**
+ * \struct RigidbodyStore
+ * \brief Packed arrays of the rigidbody state needed to integrate one physics step.
+ *
+ * The store holds one slot per entity in the PhysicsSystem's query. Slots are added and removed
+ * as the query changes, so the layout persists across steps; only the per-step values are
+ * refreshed from the Rigidbody2D components, since scripts may change them between steps. Each
+ * step accumulates the forces other than gravity and drag into forceX/forceY, integrates all
+ * bodies in one pass and writes the results back. Keeping each quantity in its own contiguous
+ * array lets Integrate process several bodies per instruction.
+ */
+struct RigidbodyStore {
+	std::vector<Entity> entities;		// Owning entity of each body.
+	std::vector<Rigidbody2D*> bodies;	// Component of each body, resolved at the start of every step.
+	std::vector<uint8_t> moving;		// 1 if the body is integrated this step, 0 if it is static, kinematic or being destroyed.
+	std::vector<float> posX, posY;		// Position at the start of the step, then the integrated position.
+	std::vector<float> velX, velY;		// Velocity at the start of the step, then the integrated velocity.
+	std::vector<float> forceX, forceY;	// Resultant force excluding gravity and drag, then including gravity after Integrate.
+	std::vector<float> invMass;			// 1 / mass, or 0 for massless bodies.
+	std::vector<float> gravityWeight;	// Gravity scale * mass, or 0 if the body has no gravity force.
+	std::vector<float> dragCoef;		// Half the drag coefficient, or 0 if the body has no drag force.
+	std::vector<float> dragX, dragY;	// Drag force applied during the step, written by Integrate.
+
+	/**
+	 * \brief Removes every body from the store, keeping the allocated memory.
+	 */
+	void Clear();
+
+	/**
+	 * \brief Adds a slot for the entity's body if it does not have one. Its values are filled in
+	 *        at the start of the next step.
+	 *
+	 * \param entity The entity owning the rigidbody.
+	 */
+	void Add(Entity entity);
+
+	/**
+	 * \brief Removes the entity's body, moving the last body into its slot.
+	 *
+	 * \param entity The entity owning the rigidbody.
+	 */
+	void Remove(Entity entity);
+
+	size_t Size() const { return entities.size(); }
+
+	/**
+	 * \brief Integrates the bodies in [begin, end) over one step using semi-implicit Euler.
+	 *
+	 * When forces are applied, gravity is added to forceY, then drag is computed from the
+	 * velocity the body would have after the other forces, with the drag magnitude
+	 * 0.5 * drag * speed. Uses AVX2 or SSE2 when available, with a scalar loop for the remainder.
+	 *
+	 * \param dt Length of the step.
+	 * \param gravity Gravity acceleration, scaled per body by gravityWeight.
+	 * \param applyForces If false, bodies keep their velocity and only move.
+	 * \param begin Index of the first body.
+	 * \param end One past the index of the last body.
+	 */
+	void Integrate(float dt, float gravity, bool applyForces, size_t begin, size_t end);
+
+private:
+	std::unordered_map<Entity, size_t> indices;	// Slot of each entity's body.
+};
+
+#endif
@@ -0,0 +1,151 @@
+/*********************************************************************
+ * \file	SpatialHashGrid.cpp
+ * \brief	Defines an unbounded, hashed uniform grid used for
+			broad-phase collision detection.
+ *
+ * \author	Wong Woon Li, woonli.wong, 2301308
+ * \email	woonli.wong@digipen.edu
+ * \date	20 October 2024
+
+Copyright(C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include "SpatialHashGrid.hpp"
+
+SpatialHashGrid::SpatialHashGrid(float _cellSize) : cellSize{ _cellSize }, invCellSize{ 1.f / _cellSize } {
+}
+
+void SpatialHashGrid::InsertOrUpdate(Entity entity, const Vec2& min, const Vec2& max) {
+	CellRange range = GetCellRange(min, max);
+
+	auto it = proxies.find(entity);
+	if (it == proxies.end()) {
+		proxies.emplace(entity, Proxy{ range, true });
+		AddToCells(entity, range);
+		return;
+	}
+
+	it->second.touched = true;
+	// Most bodies stay within the same cells from one step to the next.
+	if (it->second.range == range) {
+		return;
+	}
+
+	RemoveFromCells(entity, it->second.range);
+	AddToCells(entity, range);
+	it->second.range = range;
+}
+
+void SpatialHashGrid::Remove(Entity entity) {
+	auto it = proxies.find(entity);
+	if (it == proxies.end()) {
+		return;
+	}
+	RemoveFromCells(entity, it->second.range);
+	proxies.erase(it);
+}
+
+void SpatialHashGrid::RemoveStale() {
+	for (auto it = proxies.begin(); it != proxies.end();) {
+		if (!it->second.touched) {
+			RemoveFromCells(it->first, it->second.range);
+			it = proxies.erase(it);
+		}
+		else {
+			it->second.touched = false;
+			++it;
+		}
+	}
+}
+
+void SpatialHashGrid::Clear() {
+	cells.clear();
+	proxies.clear();
+}
+
+void SpatialHashGrid::GetCandidatePairs(std::vector<std::pair<Entity, Entity>>& pairs) const {
+	pairs.clear();
+
+	for (const auto& [key, entries] : cells) {
+		if (entries.size() < 2) {
+			continue;
+		}
+
+		int cellX = static_cast<int32_t>(key >> 32);
+		int cellY = static_cast<int32_t>(key & 0xFFFFFFFFu);
+
+		for (size_t i = 0; i < entries.size(); ++i) {
+			const CellRange& rangeA = entries[i].range;
+			for (size_t j = i + 1; j < entries.size(); ++j) {
+				const CellRange& rangeB = entries[j].range;
+
+				// Two bodies can share several cells. Only report the pair from the lowest shared
+				// cell, so it is tested once without needing a set of already-reported pairs.
+				if (cellX != std::max(rangeA.minX, rangeB.minX) || cellY != std::max(rangeA.minY, rangeB.minY)) {
+					continue;
+				}
+
+				Entity a = entries[i].entity, b = entries[j].entity;
+				pairs.emplace_back(std::min(a, b), std::max(a, b));
+			}
+		}
+	}
+
+	std::sort(pairs.begin(), pairs.end());
+}
+
+SpatialHashGrid::CellRange SpatialHashGrid::GetCellRange(const Vec2& min, const Vec2& max) const {
+	return CellRange{
+		ToCell(min.x * invCellSize),
+		ToCell(min.y * invCellSize),
+		ToCell(max.x * invCellSize),
+		ToCell(max.y * invCellSize)
+	};
+}
+
+int SpatialHashGrid::ToCell(float coordinate) {
+	// NaN fails both comparisons and ends up in cell 0.
+	float cell = std::floor(coordinate);
+	if (cell > static_cast<float>(MAX_CELL_COORD)) return MAX_CELL_COORD;
+	if (cell < static_cast<float>(-MAX_CELL_COORD)) return -MAX_CELL_COORD;
+	return cell == cell ? static_cast<int>(cell) : 0;
+}
+
+uint64_t SpatialHashGrid::GetCellKey(int x, int y) {
+	return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+void SpatialHashGrid::AddToCells(Entity entity, const CellRange& range) {
+	for (int x = range.minX; x <= range.maxX; ++x) {
+		for (int y = range.minY; y <= range.maxY; ++y) {
+			cells[GetCellKey(x, y)].push_back({ entity, range });
+		}
+	}
+}
+
+void SpatialHashGrid::RemoveFromCells(Entity entity, const CellRange& range) {
+	for (int x = range.minX; x <= range.maxX; ++x) {
+		for (int y = range.minY; y <= range.maxY; ++y) {
+			auto cellIt = cells.find(GetCellKey(x, y));
+			if (cellIt == cells.end()) {
+				continue;
+			}
+
+			std::vector<CellEntry>& entries = cellIt->second;
+			auto it = std::find_if(entries.begin(), entries.end(), [entity](const CellEntry& entry) { return entry.entity == entity; });
+			if (it != entries.end()) {
+				*it = entries.back();
+				entries.pop_back();
+			}
+
+			// Drop empty cells so pair generation only visits occupied ones.
+			if (entries.empty()) {
+				cells.erase(cellIt);
+			}
+		}
+	}
+}
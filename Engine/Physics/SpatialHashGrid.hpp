@@ -0,0 +1,129 @@
+/*********************************************************************
+ * \file	SpatialHashGrid.hpp
+ * \brief	Declares an unbounded, hashed uniform grid used for
+			broad-phase collision detection.
+ *
+ * \author	Wong Woon Li, woonli.wong, 2301308
+ * \email	woonli.wong@digipen.edu
+ * \date	20 October 2024
+
+Copyright(C) 2024 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef SPATIAL_HASH_GRID_HPP
+#define SPATIAL_HASH_GRID_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Vec2.hpp"
+#include "../ECS/Entity.hpp"
+
+/**
+ * \class SpatialHashGrid
+ * \brief A uniform grid of square cells, stored sparsely in a hash map.
+ *
+ * Each cell keeps the list of entities whose bounding box overlaps it. The grid has no bounds, so
+ * bodies anywhere in the world take part in collision detection. Bodies are updated incrementally:
+ * moving within the same range of cells costs a single lookup, and only the cells that were entered
+ * or left are touched when the range changes.
+ */
+class SpatialHashGrid {
+public:
+	/**
+	 * \brief Constructs an empty grid.
+	 *
+	 * \param cellSize Width and height of each cell in world units.
+	 */
+	explicit SpatialHashGrid(float cellSize = 250.f);
+
+	/**
+	 * \brief Inserts an entity, or moves it if it is already in the grid.
+	 *
+	 * \param entity The entity to insert.
+	 * \param min Minimum world position of the entity's bounding box.
+	 * \param max Maximum world position of the entity's bounding box.
+	 */
+	void InsertOrUpdate(Entity entity, const Vec2& min, const Vec2& max);
+
+	/**
+	 * \brief Removes an entity from the grid. Does nothing if it is not in the grid.
+	 */
+	void Remove(Entity entity);
+
+	/**
+	 * \brief Removes every entity that has not been inserted or updated since the last call.
+	 *
+	 * Lets the caller drop destroyed, deactivated or kinematic bodies without tracking them itself.
+	 */
+	void RemoveStale();
+
+	/**
+	 * \brief Removes every entity from the grid.
+	 */
+	void Clear();
+
+	/**
+	 * \brief Collects every pair of entities that share at least one cell.
+	 *
+	 * Each pair is reported exactly once, as (lower handle, higher handle), and the list is sorted
+	 * so resolution order does not depend on hash map iteration order.
+	 *
+	 * \param pairs Output list. Cleared before use.
+	 */
+	void GetCandidatePairs(std::vector<std::pair<Entity, Entity>>& pairs) const;
+
+	float GetCellSize() const { return cellSize; }
+	size_t GetNumEntities() const { return proxies.size(); }
+	size_t GetNumCells() const { return cells.size(); }
+
+private:
+	/**
+	 * \struct CellRange
+	 * \brief Inclusive range of cells covered by a bounding box.
+	 */
+	struct CellRange {
+		int minX, minY, maxX, maxY;
+
+		bool operator==(const CellRange& other) const {
+			return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+		}
+	};
+
+	/**
+	 * \struct CellEntry
+	 * \brief An entity in a cell, with its cell range kept alongside for pair generation.
+	 */
+	struct CellEntry {
+		Entity entity;
+		CellRange range;
+	};
+
+	/**
+	 * \struct Proxy
+	 * \brief Grid entry of a single entity.
+	 */
+	struct Proxy {
+		CellRange range;
+		bool touched; // Set by InsertOrUpdate, cleared by RemoveStale.
+	};
+
+	CellRange GetCellRange(const Vec2& min, const Vec2& max) const;
+	static int ToCell(float coordinate);
+	static uint64_t GetCellKey(int x, int y);
+	void AddToCells(Entity entity, const CellRange& range);
+	void RemoveFromCells(Entity entity, const CellRange& range);
+
+	float cellSize;			// Width and height of each cell.
+	float invCellSize;		// 1 / cellSize, to turn positions into cell coordinates.
+
+	std::unordered_map<uint64_t, std::vector<CellEntry>> cells;	// Entities overlapping each occupied cell.
+	std::unordered_map<Entity, Proxy> proxies;						// Cell range of each entity in the grid.
+
+	static constexpr int MAX_CELL_COORD = 1 << 20;	// Cell coordinates are clamped so stray positions cannot overflow.
+};
+
+#endif
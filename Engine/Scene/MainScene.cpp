@@ -43,6 +43,7 @@
 #include "../Video/VideoClip.hpp"
 #include "../Audio/AudioClip.hpp"
 #include "SceneManager.hpp"
+#include "../Utility/Profiler.hpp"
 
 extern HierachyPanel hp{};
 extern EngineState engineState;
@@ -104,8 +105,8 @@ void MainScene::Initialize()
 
 	//instantiate all entity with script component
 	ScriptEngine::PopulateEntityInstance();
-	auto view = ECSManager::GetInstance().GetEntityManager();
-	for (Entity i{}; i < view.GetEntities(); i++) {
+	auto view = ECSManager::GetInstance().GetEntityManager().GetLivingEntities();
+	for (Entity i : view) {
 		if (ECSManager::GetInstance().HasComponent<ScriptComponent>(i))
 			ScriptEngine::OnCreateEntity(i);
 	}
@@ -118,7 +119,7 @@ void MainScene::Initialize()
 
 #ifdef INSTALLER
 	//auto view = ECSManager::GetInstance().GetEntityManager();
-	for (Entity i{}; i < view.GetEntities(); i++) {
+	for (Entity i : view) {
 		if (ECSManager::GetInstance().HasComponent<ScriptComponent>(i))
 			ScriptEngine::OnStartEntity(i); //initial onStart Run
 	}
@@ -127,14 +128,15 @@ void MainScene::Initialize()
 
 void MainScene::Update(double dt, double fixedDt, int numOfSteps)
 {
+	PROFILE_SCOPE("MainScene::Update");
 	auto& ECSManager = ECSManager::GetInstance();
 	static bool scriptRunning = false;
 	if (engineState == EngineState::PLAYING) {
 		if (scriptRunning) ScriptEngine::OnRuntimeStop();
 #ifndef INSTALLER
 		if (onStart) {
-			auto view = ECSManager.GetEntityManager();
-			for (Entity i{}; i < view.GetEntities(); i++) {
+			auto view = ECSManager.GetEntityManager().GetLivingEntities();
+			for (Entity i : view) {
 				if (ECSManager.HasComponent<ScriptComponent>(i))
 					ScriptEngine::OnStartEntity(i); //initial onStart Run
 			}
@@ -145,16 +147,27 @@ void MainScene::Update(double dt, double fixedDt, int numOfSteps)
 
 #endif // !INSTALLER
 		
+		// Press M to toggle physics step by step mode (for debugging purposes). When it is enabled, press N to
+		// update Physics for one frame. The keys are read here because Physics runs on a worker.
+		if (InputManager::GetInstance().GetKeyDown('M')) {
+			ECSManager.physicsSystem->SetStepByStepMode(!ECSManager.physicsSystem->IsStepByStepMode());
+		}
+		bool physicsUpdate = !ECSManager.physicsSystem->IsStepByStepMode() || InputManager::GetInstance().GetKeyDown('N');
+
+		// Physics runs on a worker alongside Audio and VideoPlayer on this thread. Its collision callbacks are
+		// sent to the scripts after each step, before the next one starts.
+		scheduler.Add("VideoPlayer", *ECSManager.videoPlayerSystem, [&] { ECSManager.videoPlayerSystem->Update(dt); });
 		for (int i = 0; i < numOfSteps; ++i) {
-			ECSManager.physicsSystem->Update(fixedDt);
-			ECSManager.audioSystem->Update(fixedDt);
+			scheduler.Add("Physics", *ECSManager.physicsSystem, [&] { ECSManager.physicsSystem->Update(fixedDt, physicsUpdate); });
+			scheduler.Add("Audio", *ECSManager.audioSystem, [&] { ECSManager.audioSystem->Update(fixedDt); });
+			scheduler.Run();
+			ECSManager.physicsSystem->DispatchCollisionEvents();
 		}
-		
-		ECSManager.videoPlayerSystem->Update(dt);
+		scheduler.Run();
 
 		//Scripting
-		auto view = ECSManager.GetEntityManager();
-		for (Entity i{}; i < view.GetEntities(); i++) {
+		auto view = ECSManager.GetEntityManager().GetLivingEntities();
+		for (Entity i : view) {
 			if (ECSManager.HasComponent<ScriptComponent>(i)) {
 				ScriptEngine::OnUpdateEntity(i, static_cast<float>(dt)); // (using script engine to move)
 			
@@ -170,8 +183,8 @@ void MainScene::Update(double dt, double fixedDt, int numOfSteps)
 		//Scripting
 		if (scriptRunning) {
 			if (onStart) {
-				auto view = ECSManager::GetInstance().GetEntityManager();
-				for (Entity i{}; i < view.GetEntities(); i++) {
+				auto view = ECSManager::GetInstance().GetEntityManager().GetLivingEntities();
+				for (Entity i : view) {
 					if (ECSManager::GetInstance().HasComponent<ScriptComponent>(i))
 						ScriptEngine::OnStartEntity(i); //initial onStart Run
 				}
@@ -185,8 +198,8 @@ void MainScene::Update(double dt, double fixedDt, int numOfSteps)
 			//		ScriptEngine::OnUpdateEntity(i, (float)dt); // (using script engine to move)
 			//	}
 			//}
-			auto view = ECSManager.GetEntityManager();
-			for (Entity i{}; i < view.GetEntities(); i++) {
+			auto view = ECSManager.GetEntityManager().GetLivingEntities();
+			for (Entity i : view) {
 				if (ECSManager.HasComponent<ScriptComponent>(i)) {
 					ScriptEngine::OnUpdateEntity(i, static_cast<float>(dt)); // (using script engine to move)
 
@@ -207,19 +220,20 @@ void MainScene::Update(double dt, double fixedDt, int numOfSteps)
 		}
 #endif
 	}
-	ECSManager.cameraSystem->Update();
-	ECSManager.stateMachineSystem->Update(dt);
+	scheduler.Add("Camera", *ECSManager.cameraSystem, [&] { ECSManager.cameraSystem->Update(); });
+	scheduler.Add("StateMachine", *ECSManager.stateMachineSystem, [&] { ECSManager.stateMachineSystem->Update(dt); });
 
 	//for (int i = 0; i < numOfSteps; ++i) {
 		//ECSManager.transformSystem->Update(fixedDt);
 	//}
-	ECSManager.transformSystem->Update(dt);
-	ECSManager.uiSystem->Update(dt);
-	ECSManager.renderSystem->Update();
+	scheduler.Add("Transform", *ECSManager.transformSystem, [&] { ECSManager.transformSystem->Update(dt); });
+	scheduler.Add("UI", *ECSManager.uiSystem, [&] { ECSManager.uiSystem->Update(dt); });
+	scheduler.Add("Render", *ECSManager.renderSystem, [&] { ECSManager.renderSystem->Update(); });
 
 	//for (int i = 0; i < numOfSteps; ++i) {
-		ECSManager.animationSystem->Update(dt);
+		scheduler.Add("Animation", *ECSManager.animationSystem, [&] { ECSManager.animationSystem->Update(dt); });
 	//}
+	scheduler.Run();
 #ifndef INSTALLER
 	if (InputManager::GetInstance().GetKeyDown('K')) {
 		ECSManager.renderSystem->SetDebugMode(true);
@@ -247,37 +261,8 @@ void MainScene::Exit()
 	ECSManager::GetInstance().animationSystem->Exit();
 	ECSManager::GetInstance().stateMachineSystem->Exit();
 	
-	AssetManager::GetInstance().UnloadAllOfType<Texture>();
-	AssetManager::GetInstance().UnloadAllOfType<VideoClip>();
-	AssetManager::GetInstance().UnloadAllOfType<AudioClip>();
-	AssetManager::GetInstance().UnloadAllOfType<Font>();
-
-	auto& gm = GraphicsManager::GetInstance();
-
-	gm.FreeTextureArrays();
-
-	for (auto& frameBuffer : gm.frameBuffers) {
-		frameBuffer.Exit();
-	}
-
-	gm.frameBuffers.clear();
-
-	for (size_t i = 0; i < GraphicsManager::FrameBufferIndex::MAX_FRAMEBUFFERS; ++i) {
-		gm.frameBuffers.emplace_back();
-		gm.frameBuffers[i].frameTexture = AssetManager::GetInstance().CreateTexture("fbo" + std::to_string(i)).get();
-	}
-
-	// Initialize the framebuffers
-	for (size_t i = 0; i < gm.frameBuffers.size(); ++i) {
-		gm.frameBuffers[i].Init();
-	}
-
-	// Attach the textures to the framebuffers
-	// Note: It is important to reattach the texture after the framebuffer has been initialized
-	// as reallocation of the texture array will cause the previously attached texture to be invalid
-	for (auto& fb : gm.frameBuffers) {
-		fb.Attach();
-	}
+	// Assets stay loaded for the next scene, which evicts those it does not use once it has taken
+	// its own references, see SceneManager::AcquireSceneAssets
 
 	SceneManager::GetInstance().ResetLoadingScreen();
 }
\ No newline at end of file
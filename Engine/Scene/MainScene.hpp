@@ -16,12 +16,16 @@
 #define MAIN_SCENE_HPP
 
 #include "Scene.hpp"
+#include "../ECS/SystemScheduler.hpp"
 
 class MainScene : public IScene {
 public:
 	void Initialize();
 	void Update(double dt, double fixedDt, int numOfSteps);
 	void Exit();
+
+private:
+	SystemScheduler scheduler; // Runs the systems each frame, in parallel where their component access allows
 };
 
 #endif
\ No newline at end of file
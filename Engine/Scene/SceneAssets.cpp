@@ -0,0 +1,89 @@
+/*********************************************************************
+ * \file		SceneAssets.cpp
+ * \brief		Defines the references a scene holds on the assets
+ *				its components use.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include "SceneAssets.hpp"
+
+#include <string>
+#include <unordered_set>
+
+#include "../ECS/ECSManager.hpp"
+#include "../Components/AudioSource.hpp"
+#include "../Components/Renderer.hpp"
+#include "../Components/Textbox.hpp"
+#include "../Components/VideoPlayer.hpp"
+
+namespace {
+	/**
+	 * \brief Replaces the handles with ones on the UUIDs given, counting the UUIDs kept, added and released.
+	 */
+	template <typename T>
+	void Replace(std::vector<AssetHandle<T>>& handles, std::unordered_set<std::string> const& uuids, SceneAssets::Transition& transition) {
+		std::vector<AssetHandle<T>> next;
+		next.reserve(uuids.size());
+		for (std::string const& uuid : uuids) {
+			next.emplace_back(uuid);
+		}
+
+		size_t kept = 0;
+		for (AssetHandle<T> const& handle : handles) {
+			kept += uuids.count(handle.GetUUID());
+		}
+		transition.kept += kept;
+		transition.added += uuids.size() - kept;
+		transition.released += handles.size() - kept;
+
+		// The old handles release their references only after the new ones are taken
+		handles.swap(next);
+	}
+}
+
+SceneAssets::Transition SceneAssets::Acquire() {
+	auto& ecs = ECSManager::GetInstance();
+
+	std::unordered_set<std::string> textures;
+	ecs.GetView<Renderer>().ForEach([&textures](Entity, Renderer& renderer) {
+		if (!renderer.uuid.empty()) textures.insert(renderer.uuid);
+	});
+	std::unordered_set<std::string> fonts;
+	ecs.GetView<Textbox>().ForEach([&fonts](Entity, Textbox& textbox) {
+		if (!textbox.fontUUID.empty()) fonts.insert(textbox.fontUUID);
+	});
+	std::unordered_set<std::string> audioClips;
+	ecs.GetView<AudioSource>().ForEach([&audioClips](Entity, AudioSource& audioSource) {
+		if (!audioSource.audioClipUUID.empty()) audioClips.insert(audioSource.audioClipUUID);
+	});
+	std::unordered_set<std::string> videoClips;
+	ecs.GetView<VideoPlayer>().ForEach([&videoClips](Entity, VideoPlayer& videoPlayer) {
+		if (!videoPlayer.videoClipUUID.empty()) videoClips.insert(videoPlayer.videoClipUUID);
+	});
+
+	Transition transition;
+	Replace(m_textures, textures, transition);
+	Replace(m_fonts, fonts, transition);
+	Replace(m_audioClips, audioClips, transition);
+	Replace(m_videoClips, videoClips, transition);
+	return transition;
+}
+
+void SceneAssets::Release() {
+	m_textures.clear();
+	m_fonts.clear();
+	m_audioClips.clear();
+	m_videoClips.clear();
+}
+
+size_t SceneAssets::GetCount() const {
+	return m_textures.size() + m_fonts.size() + m_audioClips.size() + m_videoClips.size();
+}
@@ -0,0 +1,69 @@
+/*********************************************************************
+ * \file		SceneAssets.hpp
+ * \brief		Declares the references a scene holds on the assets
+ *				its components use, so the assets the next scene
+ *				shares with it stay loaded.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef SCENE_ASSETS_HPP
+#define SCENE_ASSETS_HPP
+
+#include <vector>
+
+#include "../AssetManager.hpp"
+
+/**
+ * \class SceneAssets
+ * \brief The textures, fonts, audio and video clips a scene's components use, each with a
+ *        reference held on it in the AssetManager.
+ *
+ * Acquiring the next scene's assets takes the new references before dropping the old ones, so
+ * the assets both scenes use never lose their last reference and are not evicted in between.
+ */
+class SceneAssets {
+public:
+	/**
+	 * \struct Transition
+	 * \brief How the assets referenced changed from one scene to the next.
+	 */
+	struct Transition {
+		size_t kept = 0;		// Used by both scenes
+		size_t added = 0;		// Only used by the new scene
+		size_t released = 0;	// Only used by the previous scene
+	};
+
+	/**
+	 * \brief Takes references on the assets the components in the ECS use, then releases the
+	 *        references held before.
+	 *
+	 * \return How the assets referenced changed.
+	 */
+	Transition Acquire();
+
+	/**
+	 * \brief Releases every reference held.
+	 */
+	void Release();
+
+	/**
+	 * \brief Number of assets referenced.
+	 */
+	size_t GetCount() const;
+
+private:
+	std::vector<AssetHandle<Texture>> m_textures;
+	std::vector<AssetHandle<Font>> m_fonts;
+	std::vector<AssetHandle<AudioClip>> m_audioClips;
+	std::vector<AssetHandle<VideoClip>> m_videoClips;
+};
+
+#endif // !SCENE_ASSETS_HPP
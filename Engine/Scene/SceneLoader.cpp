@@ -0,0 +1,124 @@
+/*********************************************************************
+ * \file		SceneLoader.cpp
+ * \brief		Defines the loader that reads a scene on a loading
+ *				thread and adds it to the ECS a few entities a frame.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include "SceneLoader.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_set>
+
+#include "../Components/Renderer.hpp"
+
+SceneLoader::~SceneLoader() {
+	Cancel();
+}
+
+void SceneLoader::Start(std::string const& scenePath) {
+	Cancel();
+	m_stage.store(STAGE_STAGING, std::memory_order_release);
+	m_thread = std::thread(&SceneLoader::StageScene, this, scenePath);
+}
+
+void SceneLoader::StageScene(std::string scenePath) {
+	std::string error;
+	bool isStaged = false;
+
+	std::string cookedPath = CookedScene::FindLoadablePath(scenePath);
+	if (!cookedPath.empty()) {
+		// Open reads every byte to check it, which pages the whole file in here rather than on the main thread
+		isStaged = m_scene.Open(cookedPath, error);
+	}
+	if (!isStaged && cookedPath != scenePath) {
+		std::vector<unsigned char> cooked;
+		isStaged = CookedScene::Cook(scenePath, cooked, error, [this](uint32_t cookedCount, uint32_t total) {
+			m_totalEntities.store(total, std::memory_order_relaxed);
+			m_stagedEntities.store(cookedCount, std::memory_order_relaxed);
+		}) && m_scene.Open(std::move(cooked), error);
+	}
+	if (!isStaged) {
+		m_error = error;
+		m_stage.store(STAGE_FAILED, std::memory_order_release);
+		return;
+	}
+
+	std::unordered_set<std::string> listed;
+	CookedScene::Column renderers = m_scene.GetColumn(CookedScene::SECTION_RENDERER);
+	Renderer renderer;
+	for (uint32_t i = 0; i < renderers.count; ++i) {
+		Reflection::ReadBinary(renderer, renderers.GetRow(i), m_scene.GetStrings());
+		if (!renderer.uuid.empty() && listed.insert(renderer.uuid).second) {
+			m_textures.push_back(renderer.uuid);
+		}
+	}
+
+	m_totalEntities.store(m_scene.GetEntityCount(), std::memory_order_relaxed);
+	m_stagedEntities.store(m_scene.GetEntityCount(), std::memory_order_relaxed);
+	m_stage.store(STAGE_COMMITTING, std::memory_order_release);
+}
+
+SceneLoader::Stage SceneLoader::Update(double budgetMs) {
+	if (GetStage() != STAGE_COMMITTING) {
+		return GetStage();
+	}
+
+	// Staging is finished once the stage has moved on, so the thread only has to be reclaimed
+	if (m_thread.joinable()) {
+		m_thread.join();
+	}
+
+	using Clock = std::chrono::steady_clock;
+	Clock::time_point start = Clock::now();
+	bool isCommitted = false;
+	do {
+		isCommitted = Serializer::GetInstance().CommitCookedScene(m_scene, m_cursor, COMMIT_CHUNK);
+	} while (!isCommitted && std::chrono::duration<double, std::milli>(Clock::now() - start).count() < budgetMs);
+
+	if (isCommitted) {
+		m_stage.store(STAGE_DONE, std::memory_order_release);
+	}
+	return GetStage();
+}
+
+void SceneLoader::Cancel() {
+	if (m_thread.joinable()) {
+		m_thread.join();
+	}
+	m_scene.Close();
+	m_textures.clear();
+	m_error.clear();
+	m_cursor = Serializer::CookedSceneCursor{};
+	m_stagedEntities.store(0, std::memory_order_relaxed);
+	m_totalEntities.store(0, std::memory_order_relaxed);
+	m_stage.store(STAGE_IDLE, std::memory_order_release);
+}
+
+float SceneLoader::GetProgress() const {
+	switch (GetStage()) {
+	case STAGE_STAGING: {
+		uint32_t total = m_totalEntities.load(std::memory_order_relaxed);
+		uint32_t staged = std::min(m_stagedEntities.load(std::memory_order_relaxed), total);
+		return total ? STAGING_SHARE * static_cast<float>(staged) / static_cast<float>(total) : 0.f;
+	}
+	case STAGE_COMMITTING: {
+		uint32_t total = m_scene.GetEntityCount();
+		float committed = total ? static_cast<float>(m_cursor.entity) / static_cast<float>(total) : 1.f;
+		return STAGING_SHARE + (1.f - STAGING_SHARE) * committed;
+	}
+	case STAGE_DONE:
+		return 1.f;
+	default:
+		return 0.f;
+	}
+}
@@ -0,0 +1,106 @@
+/*********************************************************************
+ * \file		SceneLoader.hpp
+ * \brief		Declares the loader that reads a scene on a loading
+ *				thread and adds it to the ECS a few entities a frame.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef SCENE_LOADER_HPP
+#define SCENE_LOADER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Utility/CookedScene.hpp"
+#include "../Utility/Serializer.hpp"
+
+/**
+ * \class SceneLoader
+ * \brief Loads a scene in two halves so the frame loop keeps running while it loads.
+ *
+ * Staging runs on a loading thread and touches nothing the frame uses: it maps the scene's
+ * cooked file, or cooks the JSON into memory when there is no up to date one, and checks it.
+ * The staged scene is a complete, checked copy of every component, so committing it only
+ * creates entities and copies records, which Update does on the main thread a chunk at a time
+ * until its budget for the frame is spent.
+ */
+class SceneLoader {
+public:
+	enum Stage {
+		STAGE_IDLE = 0,
+		STAGE_STAGING,		// The loading thread is reading the scene
+		STAGE_COMMITTING,	// Staged, being added to the ECS by Update
+		STAGE_DONE,
+		STAGE_FAILED
+	};
+
+	static constexpr uint32_t COMMIT_CHUNK = 32;	// Entities committed between checks of the budget
+	static constexpr float STAGING_SHARE = 0.5f;	// Part of the progress spent staging
+
+	SceneLoader() = default;
+	~SceneLoader();
+
+	SceneLoader(SceneLoader const&) = delete;
+	SceneLoader& operator=(SceneLoader const&) = delete;
+
+	/**
+	 * \brief Starts staging a scene on the loading thread, dropping the scene loaded before.
+	 */
+	void Start(std::string const& scenePath);
+
+	/**
+	 * \brief Commits the staged scene until the budget is spent. Call once a frame on the main thread.
+	 *
+	 * \param budgetMs Time to spend committing. At least one chunk is committed a call.
+	 * \return The stage after the call.
+	 */
+	Stage Update(double budgetMs);
+
+	/**
+	 * \brief Waits for the loading thread and drops the scene. Entities already committed stay.
+	 */
+	void Cancel();
+
+	Stage GetStage() const { return m_stage.load(std::memory_order_acquire); }
+
+	/**
+	 * \brief How much of the scene is loaded, from 0 to 1.
+	 */
+	float GetProgress() const;
+
+	/**
+	 * \brief Every texture the scene's renderers use, once it is staged. Requesting them while
+	 *        the scene commits decodes them on the job workers alongside.
+	 */
+	std::vector<std::string> const& GetTextures() const { return m_textures; }
+
+	std::string const& GetError() const { return m_error; }
+
+private:
+	void StageScene(std::string scenePath);
+
+	std::thread m_thread{};
+	std::atomic<Stage> m_stage{ STAGE_IDLE };
+	std::atomic<uint32_t> m_stagedEntities{ 0 };	// Entities cooked so far, when staging from JSON
+	std::atomic<uint32_t> m_totalEntities{ 0 };
+
+	// Written by the loading thread before the stage leaves STAGE_STAGING, then only read
+	CookedScene m_scene{};
+	std::vector<std::string> m_textures{};
+	std::string m_error{};
+
+	Serializer::CookedSceneCursor m_cursor{};
+};
+
+#endif // SCENE_LOADER_HPP
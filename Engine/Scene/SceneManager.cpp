@@ -25,11 +25,24 @@
 //Scripts
 #include "../Tools/Scripting/ScriptEngine.hpp"
 #include "../Components/ScriptComponent.hpp"
+#include "../Utility/Profiler.hpp"
+#include "Logger.hpp"
+#include "../Graphics/TextureLoader.hpp"
+#include "../AssetManager.hpp"
+
+#include <algorithm>
 
 extern EngineState engineState;
 extern bool onStart;
 static bool onFirstLoad = true;
 
+// Time spent adding a scene loading in the background to the ECS each frame
+static constexpr double SCENE_COMMIT_BUDGET_MS = 4.0;
+// Parts of the loading bar filled while the scene is added, and while its textures are uploaded.
+// The systems initializing fill the rest.
+static constexpr float LOAD_COMMIT_SHARE = 0.6f;
+static constexpr float LOAD_TEXTURE_SHARE = 0.3f;
+
 SceneManager& SceneManager::GetInstance()
 {
 	static SceneManager inputManager;
@@ -37,9 +50,18 @@ SceneManager& SceneManager::GetInstance()
 }
 
 void SceneManager::LoadScene(const std::string& scenePath) {
+    PROFILE_SCOPE("SceneManager::LoadScene");
 #ifndef INSTALLER
     useLoadingScreen = false;
 #endif
+    // A scene still loading in the background is dropped, along with what of it was already added
+    if (loadStage != LoadStage::NONE) {
+        sceneLoader.Cancel();
+        loadStage = LoadStage::NONE;
+        isLoading = false;
+        ECSManager::GetInstance().ClearEntities();
+    }
+
     // Exit and clean up the current scene first.
     if (currentScene) {
         engineState = EngineState::STOPPED;
@@ -49,6 +71,9 @@ void SceneManager::LoadScene(const std::string& scenePath) {
 #endif
         ECSManager::GetInstance().ClearEntities();
         onFirstLoad = false;
+
+        // Scripts change scenes from inside the scene's update, so it is destroyed on the next one
+        retiredScene = std::move(currentScene);
     }
 
     if (scenePath == "../Assets/Scenes/Main Menu.scene") {
@@ -59,8 +84,8 @@ void SceneManager::LoadScene(const std::string& scenePath) {
         if (!onFirstLoad) {
             // Load in the loading scene.
             Serializer::GetInstance().DeserializeScene("../Assets/Scenes/Loading Screen.scene");
-            auto view = ECSManager::GetInstance().GetEntityManager();
-            for (Entity i{}; i < view.GetEntities(); i++) {
+            auto view = ECSManager::GetInstance().GetEntityManager().GetLivingEntities();
+            for (Entity i : view) {
                 loadingScreenEntities.insert(i);
                 const auto& enttName = ECSManager::GetInstance().TryGetComponent<Name>(i);
                 if (enttName.has_value() && enttName->get().name == "Loading Bar") {
@@ -79,6 +104,15 @@ void SceneManager::LoadScene(const std::string& scenePath) {
             numOfSystemsToLoad = ECSManager::GetInstance().GetNumOfSystems();
             incrementPerSystemLoaded = 1.f / static_cast<float>(numOfSystemsToLoad);
             numSystemsLoaded = 0;
+
+            // Stage the new scene on the loading thread. UpdateScene adds it over the next frames,
+            // so the loading screen keeps rendering while the scene loads.
+            isLoading = true;
+            currentScenePath = scenePath;
+            sceneLoader.Start(scenePath);
+            loadStage = LoadStage::COMMITTING;
+            sceneTexturesRequested = false;
+            return;
         }
 #endif
 
@@ -91,81 +125,8 @@ void SceneManager::LoadScene(const std::string& scenePath) {
 
         if (currentScene) {
             currentScene->Initialize();
-            if (scenePath != "../Assets/Scenes/Main Menu.scene")
-                UpdateLoadingScreen(1.f);
-
-#ifdef INSTALLER
-            if (!onFirstLoad && scenePath != "../Assets/Scenes/Main Menu.scene") {
-                // Transition from loading scene to new scene using a 'glitch-like' effect.
-                float transitionDuration = 0.08f;
-                float currTransitionDur = transitionDuration;
-                UI& fadeUI = ECSManager::GetInstance().GetComponent<UI>(fadeEntt);
-                ECSManager::GetInstance().GetEntityManager().SetActive(fadeEntt, true);
-                ECSManager::GetInstance().uiSystem->SetVisibility(fadeEntt, true);
-                while (currTransitionDur > 0.f) {
-                    fadeUI.isUpdated = false;
-                    UpdateLoadingScreen(1.f);
-                    currTransitionDur -= 0.02f;
-                }
-
-                // move to top right
-                fadeUI.position = Vec3{ 0.3f, 0.5f, 0.f };
-                currTransitionDur = transitionDuration;
-                while (currTransitionDur > 0.f) {
-                    fadeUI.isUpdated = false;
-                    UpdateLoadingScreen(1.f);
-                    currTransitionDur -= 0.02f;
-                }
-
-                // move to bottom
-                fadeUI.position = Vec3{ 0.f };
-                fadeUI.size = Vec2{ 1.f, 0.75f };
-                currTransitionDur = transitionDuration;
-                while (currTransitionDur > 0.f) {
-                    fadeUI.isUpdated = false;
-                    UpdateLoadingScreen(1.f);
-                    currTransitionDur -= 0.02f;
-                }
-
-                // move to top left
-                fadeUI.position = Vec3{ 0.f, 0.3f };
-                fadeUI.size = Vec2{ 0.75f, 0.75f };
-                currTransitionDur = transitionDuration;
-                while (currTransitionDur > 0.f) {
-                    fadeUI.isUpdated = false;
-                    UpdateLoadingScreen(1.f);
-                    currTransitionDur -= 0.02f;
-                }
-
-                // almost full
-                fadeUI.position = Vec3{ 0.03f, 0.f };
-                fadeUI.size = Vec2{ 0.97f, 0.97f };
-                currTransitionDur = transitionDuration;
-                while (currTransitionDur > 0.f) {
-                    fadeUI.isUpdated = false;
-                    UpdateLoadingScreen(1.f);
-                    currTransitionDur -= 0.02f;
-                }
-
-                // full
-                fadeUI.position = Vec3{ 0.f };
-                fadeUI.size = Vec2{ 1.f, 1.f };
-                currTransitionDur = transitionDuration;
-                while (currTransitionDur > 0.f) {
-                    fadeUI.isUpdated = false;
-                    UpdateLoadingScreen(1.f);
-                    currTransitionDur -= 0.02f;
-                }
-
-                for (Entity entity : loadingScreenEntities) {
-                    ECSManager::GetInstance().GetEntityManager().SetActive(entity, false);
-                    ECSManager::GetInstance().uiSystem->SetVisibility(entity, false);
-                }
-
-                engineState = EngineState::PLAYING;
-            }
-#endif
         }
+        AcquireSceneAssets();
 
         isLoading = false;
 
@@ -187,6 +148,7 @@ void SceneManager::LoadScene(const std::string& scenePath) {
         if (currentScene) {
             currentScene->Initialize();
         }
+        AcquireSceneAssets();
 
         isLoading = false;
 
@@ -201,21 +163,174 @@ void SceneManager::LoadScene(const std::string& scenePath) {
 #endif
 }
 
-void SceneManager::UpdateLoadingScreen(float percentDone) {
+void SceneManager::UpdateSceneLoad() {
+    PROFILE_SCOPE("SceneManager::UpdateSceneLoad");
+    switch (loadStage) {
+    case LoadStage::COMMITTING: {
+        SceneLoader::Stage stage = sceneLoader.Update(SCENE_COMMIT_BUDGET_MS);
+        float progress = sceneLoader.GetProgress();
+        if (stage == SceneLoader::STAGE_FAILED) {
+            Logger::Instance().Log(Logger::Level::ERR, "[SceneManager] UpdateSceneLoad: " + sceneLoader.GetError() + ", loading the scene directly");
+            Serializer::GetInstance().DeserializeScene(currentScenePath);
+            stage = SceneLoader::STAGE_DONE;
+        }
+        else if (stage != SceneLoader::STAGE_STAGING && !sceneTexturesRequested) {
+            // Decode the scene's textures on the job workers while the rest of it is added
+            for (std::string const& texture : sceneLoader.GetTextures()) {
+                TextureLoader::GetInstance().Request(texture, TextureLoader::PRIORITY_SCENE);
+            }
+            sceneTextureCount = sceneLoader.GetTextures().size();
+            sceneTexturesRequested = true;
+        }
+
+        if (stage == SceneLoader::STAGE_DONE) {
+            sceneLoader.Cancel();
+            loadStage = LoadStage::TEXTURES;
+        }
+        UpdateLoadingScreen(progress * LOAD_COMMIT_SHARE, false);
+        break;
+    }
+    case LoadStage::TEXTURES: {
+        // Only the scene's textures are requested while it loads, so the scene is ready once none are pending
+        size_t pending = TextureLoader::GetInstance().GetPendingCount();
+        float uploaded = sceneTextureCount ? 1.f - static_cast<float>(std::min(pending, sceneTextureCount)) / static_cast<float>(sceneTextureCount) : 1.f;
+        if (pending == 0) {
+            loadStage = LoadStage::INITIALIZING;
+        }
+        UpdateLoadingScreen(LOAD_COMMIT_SHARE + LOAD_TEXTURE_SHARE * uploaded, false);
+        break;
+    }
+    case LoadStage::INITIALIZING: {
+        loadStage = LoadStage::NONE;
+
+        // The systems report their own progress while initializing, onto the rest of the bar
+        loadingProgressOffset = LOAD_COMMIT_SHARE + LOAD_TEXTURE_SHARE;
+        loadingProgressScale = 1.f - loadingProgressOffset;
+        currentScene = std::make_unique<MainScene>();
+        currentScene->Initialize();
+        loadingProgressOffset = 0.f;
+        loadingProgressScale = 1.f;
+        AcquireSceneAssets();
+
+        FinishLoading();
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void SceneManager::FinishLoading() {
+#ifdef INSTALLER
+    UpdateLoadingScreen(1.f);
+
+    // Transition from loading scene to new scene using a 'glitch-like' effect.
+    float transitionDuration = 0.08f;
+    float currTransitionDur = transitionDuration;
+    UI& fadeUI = ECSManager::GetInstance().GetComponent<UI>(fadeEntt);
+    ECSManager::GetInstance().SetActive(fadeEntt, true);
+    ECSManager::GetInstance().uiSystem->SetVisibility(fadeEntt, true);
+    while (currTransitionDur > 0.f) {
+        fadeUI.isUpdated = false;
+        UpdateLoadingScreen(1.f);
+        currTransitionDur -= 0.02f;
+    }
+
+    // move to top right
+    fadeUI.position = Vec3{ 0.3f, 0.5f, 0.f };
+    currTransitionDur = transitionDuration;
+    while (currTransitionDur > 0.f) {
+        fadeUI.isUpdated = false;
+        UpdateLoadingScreen(1.f);
+        currTransitionDur -= 0.02f;
+    }
+
+    // move to bottom
+    fadeUI.position = Vec3{ 0.f };
+    fadeUI.size = Vec2{ 1.f, 0.75f };
+    currTransitionDur = transitionDuration;
+    while (currTransitionDur > 0.f) {
+        fadeUI.isUpdated = false;
+        UpdateLoadingScreen(1.f);
+        currTransitionDur -= 0.02f;
+    }
+
+    // move to top left
+    fadeUI.position = Vec3{ 0.f, 0.3f };
+    fadeUI.size = Vec2{ 0.75f, 0.75f };
+    currTransitionDur = transitionDuration;
+    while (currTransitionDur > 0.f) {
+        fadeUI.isUpdated = false;
+        UpdateLoadingScreen(1.f);
+        currTransitionDur -= 0.02f;
+    }
+
+    // almost full
+    fadeUI.position = Vec3{ 0.03f, 0.f };
+    fadeUI.size = Vec2{ 0.97f, 0.97f };
+    currTransitionDur = transitionDuration;
+    while (currTransitionDur > 0.f) {
+        fadeUI.isUpdated = false;
+        UpdateLoadingScreen(1.f);
+        currTransitionDur -= 0.02f;
+    }
+
+    // full
+    fadeUI.position = Vec3{ 0.f };
+    fadeUI.size = Vec2{ 1.f, 1.f };
+    currTransitionDur = transitionDuration;
+    while (currTransitionDur > 0.f) {
+        fadeUI.isUpdated = false;
+        UpdateLoadingScreen(1.f);
+        currTransitionDur -= 0.02f;
+    }
+
+    for (Entity entity : loadingScreenEntities) {
+        ECSManager::GetInstance().SetActive(entity, false);
+        ECSManager::GetInstance().uiSystem->SetVisibility(entity, false);
+    }
+
+    engineState = EngineState::PLAYING;
+    isLoading = false;
+
+    // All entities are set to invisible initially so that only the loading screen is visible while
+    // initializing the rest of the entities, so each entity's visibility is set to its correct value now.
+    ECSManager::GetInstance().renderSystem->UpdateEntitiesVisibility();
+#endif
+}
+
+void SceneManager::AcquireSceneAssets() {
+    PROFILE_SCOPE("SceneManager::AcquireSceneAssets");
+    assetTransition = sceneAssets.Acquire();
+
+    // Audio clips free their samples when evicted. Textures are evicted an atlas page at a time,
+    // and the atlas arrays left without images are freed. Fonts and videos keep the texture arrays
+    // they were given until the engine shuts down, so they are never evicted.
+    auto& assetManager = AssetManager::GetInstance();
+    assetManager.Trim<AudioClip>();
+    if (assetManager.Trim<Texture>() > 0) {
+        Texture::ReleaseEmptyAtlasArrays();
+    }
+}
+
+void SceneManager::UpdateLoadingScreen(float percentDone, bool present) {
 #ifdef INSTALLER
     if (useLoadingScreen && !onFirstLoad) {
         UI& loadingBar = ECSManager::GetInstance().GetComponent<UI>(loadingBarEntt);
         float fullBarSize = 0.68f;
-        loadingBar.size.x = percentDone * fullBarSize;
+        loadingBar.size.x = (loadingProgressOffset + percentDone * loadingProgressScale) * fullBarSize;
         loadingBar.isUpdated = false;
 
         // Manually call the UI & render system update to render the loading screen.
         ECSManager::GetInstance().uiSystem->Update(0.0);
         ECSManager::GetInstance().renderSystem->Update();
-        glfwSwapBuffers(Application::GetInstance().GetWindow()->GetWindow());
+        if (present) {
+            glfwSwapBuffers(Application::GetInstance().GetWindow()->GetWindow());
+        }
     }
 #else
     percentDone;
+    present;
 #endif
 }
 
@@ -226,17 +341,29 @@ void SceneManager::ResetLoadingScreen() {
 }
 
 void SceneManager::UpdateScene(double deltaTime, double fixedDT, int numOfSteps) {
+    retiredScene.reset();
+    if (loadStage != LoadStage::NONE) {
+        UpdateSceneLoad();
+        return;
+    }
+
     if (currentScene) {
         currentScene->Update(deltaTime, fixedDT, numOfSteps);
     }
 }
 
 void SceneManager::ExitScene() {
+    sceneLoader.Cancel();
+    loadStage = LoadStage::NONE;
     if (currentScene) {
         Serializer::GetInstance().SerializeScene(currentScenePath);
         currentScene->Exit();
         ScriptEngine::OnRuntimeStop();
         currentScene.reset();
+
+        // Scene changes keep the audio clips loaded, but none may outlive the audio device
+        sceneAssets.Release();
+        AssetManager::GetInstance().UnloadAllOfType<AudioClip>();
     }
 }
 
@@ -281,8 +408,8 @@ void SceneManager::ReloadScene()
 
     //instantiate all entity with script component
     ScriptEngine::PopulateEntityInstance();
-    auto view = ECSManager::GetInstance().GetEntityManager();
-    for (Entity i{}; i < view.GetEntities(); i++) {
+    auto view = ECSManager::GetInstance().GetEntityManager().GetLivingEntities();
+    for (Entity i : view) {
         if (ECSManager::GetInstance().HasComponent<ScriptComponent>(i))
             ScriptEngine::OnCreateEntity(i);
     }
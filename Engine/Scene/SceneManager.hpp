@@ -22,6 +22,8 @@
 #include <atomic>
 #include <set>
 #include "Scene.hpp"
+#include "SceneLoader.hpp"
+#include "SceneAssets.hpp"
 #include "../ECS/Entity.hpp"
 
  /**
@@ -51,7 +53,14 @@ public:
      */
     void LoadScene(const std::string& scenePath);
 
-    void UpdateLoadingScreen(float percentDone);
+    /**
+     * \brief Shows how far the scene has loaded on the loading bar and renders the loading screen.
+     *
+     * \param percentDone How much of the scene is loaded, from 0 to 1.
+     * \param present Swaps the buffers to show the frame. The frame loop swaps them itself while
+     *                a scene loads in the background.
+     */
+    void UpdateLoadingScreen(float percentDone, bool present = true);
 
     void ResetLoadingScreen();
 
@@ -92,6 +101,11 @@ public:
 
     inline std::string& GetCurrentScenePath() { return currentScenePath; }
 
+    /**
+     * \brief How the assets referenced changed when the current scene replaced the one before it.
+     */
+    inline SceneAssets::Transition const& GetAssetTransition() const { return assetTransition; }
+
     // temp for now
     // will move to a loading screen class later
     bool useLoadingScreen = true;
@@ -119,9 +133,45 @@ private:
      */
     ~SceneManager() { ExitScene(); }
 
+    /**
+     * \brief Stages of a scene loading in the background behind the loading screen.
+     */
+    enum class LoadStage {
+        NONE,           // No scene loading in the background
+        COMMITTING,     // The scene loader stages the scene and adds it to the ECS
+        TEXTURES,       // Waiting for the scene's textures to be decoded and uploaded
+        INITIALIZING    // Initializing the systems on the loaded scene
+    };
+
+    /**
+     * \brief Advances the scene loading in the background by one frame and renders the loading screen.
+     */
+    void UpdateSceneLoad();
+
+    /**
+     * \brief Transitions from the loading screen into the loaded scene and starts playing it.
+     */
+    void FinishLoading();
+
+    /**
+     * \brief Takes references on the loaded scene's assets in place of the previous scene's, then
+     *        evicts the assets neither uses down to their budgets.
+     */
+    void AcquireSceneAssets();
+
     std::unique_ptr<IScene> currentScene = nullptr; /*!< Pointer to the currently active scene. */
     std::unique_ptr<IScene> loadingScene = nullptr;
     std::string currentScenePath;                   /*!< Path to the currently loaded scene file. */
+    std::unique_ptr<IScene> retiredScene = nullptr; /*!< Scene replaced during its own update, destroyed on the next. */
+
+    SceneLoader sceneLoader;
+    SceneAssets sceneAssets;                        /*!< References on the assets the current scene uses. */
+    SceneAssets::Transition assetTransition;
+    LoadStage loadStage = LoadStage::NONE;
+    bool sceneTexturesRequested = false;
+    size_t sceneTextureCount{};
+    float loadingProgressOffset = 0.f;              /*!< Maps the progress of the systems initializing onto the loading bar. */
+    float loadingProgressScale = 1.f;
 };
 
 
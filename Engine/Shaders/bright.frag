@@ -16,7 +16,6 @@ in vec2 vTexCoords;       // Texture coordinates from the vertex shader
 
 out vec4 FragColor;       // Final output color
 
-uniform float vignetteStrength;       // Strength of the vignette effect
 uniform sampler2DArray screenTexture;  // The texture array from the framebuffer
 uniform int layerIndex;                // Layer index to sample
 uniform float brightnessThreshold = 0.85;  // Threshold for bright areas
@@ -22,7 +22,14 @@ uniform int screenLayerIndex;
 uniform sampler2DArray blurTexture;
 uniform int blurLayerIndex;
 
-uniform float bloomIntensity; // Intensity of the bloom
+layout(std140, binding = 1) uniform FrameData {
+	float time;
+	float bloomIntensity;
+	float vignetteStrength;
+	float vignetteSoftness;
+	vec2 vignetteCenter;
+	float glitchIntensity;
+};
 
 void main()
 {
@@ -21,8 +21,14 @@ out vec4 FragColor;
 uniform sampler2DArray screenTexture;   // The rendered framebuffer
 uniform int layerIndex;
 
-uniform float time;                // For animating glitch effects
-uniform float glitchIntensity;     // Controls glitch strength (0.0 - 1.0)
+layout(std140, binding = 1) uniform FrameData {
+	float time;
+	float bloomIntensity;
+	float vignetteStrength;
+	float vignetteSoftness;
+	vec2 vignetteCenter;
+	float glitchIntensity;
+};
 
 float rand(vec2 co) {
     return fract(sin(dot(co.xy, vec2(12.9898, 78.233))) * 43758.5453);
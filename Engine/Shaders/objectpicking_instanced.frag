@@ -0,0 +1,27 @@
+/*********************************************************************
+ * \file	objectpicking_instanced.frag
+ * \brief	
+ *      This fragment shader writes the object picking color of each
+ *      instanced sprite.
+ *
+ * \author	Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email	y.ziyangirwen@digipen.edu
+ * \date	22 October 2024
+ * 
+ * Copyright(C) 2024 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ *********************************************************************/
+#version 460 core
+
+in vec4 vColor;        // Color passed from vertex shader
+in vec2 vTexCoords;    // Texture coordinates passed from vertex shader
+flat in int vTexArrayID;    // Texture ID passed from vertex shader (flat, no interpolation)
+flat in int vTexLayerID;        // Texture ID passed from vertex shader (flat, no interpolation)
+
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vColor;
+}
\ No newline at end of file
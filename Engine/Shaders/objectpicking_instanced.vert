@@ -0,0 +1,52 @@
+/*********************************************************************
+ * \file	objectpicking_instanced.vert
+ * \brief	
+ *      This vertex shader places one corner of the shared unit quad for
+ *      each sprite instance when drawing the object picking framebuffers.
+ *
+ * \author	Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email	y.ziyangirwen@digipen.edu
+ * \date	22 October 2024
+ * 
+ * Copyright(C) 2024 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ *********************************************************************/
+#version 460 core
+
+layout(location = 0) in vec2 aCorner;			// Corner of the unit quad, per vertex
+layout(location = 1) in vec2 aCenter;			// Center of the sprite, per instance
+layout(location = 2) in vec2 aAxisX;			// Left to right edge of the sprite, per instance
+layout(location = 3) in vec2 aAxisY;			// Bottom to top edge of the sprite, per instance
+layout(location = 4) in float aPosZ;			// Position z, per instance
+layout(location = 5) in uint aTexture;			// Visibility (bit 15), texture array ID (bits 10-14) and texture layer ID (bits 0-9), per instance
+layout(location = 6) in vec4 aColor;			// Color, per instance
+layout(location = 7) in vec4 aUVRect;			// Texture coordinates of the bottom-left (xy) and top-right (zw) corners, per instance
+
+out vec4 vColor;				// Pass the color to the fragment shader
+out vec2 vTexCoords;			// Pass the texture coordinates to the fragment shader
+flat out int vTexArrayID;		// Use 'flat' to prevent interpolation of texture ID
+flat out int vTexLayerID;		// Use 'flat' to prevent interpolation of texture layer ID
+
+layout(std140, binding = 0) uniform Camera {
+	mat4 view;
+	mat4 projection;
+};
+
+void main()
+{
+	if ((aTexture & 0x8000u) == 0u) {
+		gl_Position = vec4(0.0);
+		return;
+	}
+	vec2 aPosXY = aCenter + aCorner.x * aAxisX + aCorner.y * aAxisY;	// Same as SpriteInstance::GetCornerPosition
+	vec3 aPos = vec3(aPosXY, aPosZ);
+	bool textured = (aTexture & 0x3FFu) != 0x3FFu;	// A layer of 0x3FF marks an untextured sprite
+	int textureArrayID = textured ? int((aTexture >> 10) & 0x1Fu) : -1;
+	int textureLayerID = textured ? int(aTexture & 0x3FFu) : -1;
+    gl_Position =  projection * view * vec4(aPos, 1.0);	// Set the vertex position
+    vTexCoords = mix(aUVRect.xy, aUVRect.zw, aCorner + 0.5);	// Same as SpriteInstance::GetCornerTexCoord
+    vColor = aColor;				// Pass color
+    vTexArrayID = textureArrayID;	// Pass texture unit ID (flat shading, no interpolation)
+	vTexLayerID = textureLayerID;	// Pass texture layer ID (flat shading, no interpolation)
+}
\ No newline at end of file
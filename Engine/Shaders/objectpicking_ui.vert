@@ -16,13 +16,11 @@
  *********************************************************************/
 #version 460 core
 
-layout(location = 0) in vec3 aPos;				// Position
+layout(location = 0) in vec2 aPosXY;			// Position x and y
 layout(location = 1) in vec4 aColor;			// Color
-layout(location = 2) in vec3 aNormal;			// Normal
+layout(location = 2) in float aPosZ;			// Position z
 layout(location = 3) in vec2 aTexCoord;			// Texture coordinates
-layout(location = 4) in int aTextureArrayID;	// Texture Array ID
-layout(location = 5) in int aTextureLayerID;	// Texture Layer ID
-layout(location = 6) in int aVisible;  			// Visibility flag
+layout(location = 4) in uint aTexture;			// Visibility (bit 15), texture array ID (bits 10-14) and texture layer ID (bits 0-9)
 
 out vec4 vColor;				// Pass the color to the fragment shader
 out vec2 vTexCoords;			// Pass the texture coordinates to the fragment shader
@@ -31,13 +29,17 @@ flat out int vTexLayerID;		// Use 'flat' to prevent interpolation of texture lay
 
 void main()
 {
-	if (aVisible == 0) {
+	if ((aTexture & 0x8000u) == 0u) {
 		gl_Position = vec4(0.0);
 		return;
 	}
+	vec3 aPos = vec3(aPosXY, aPosZ);
+	bool textured = (aTexture & 0x3FFu) != 0x3FFu;	// A layer of 0x3FF marks an untextured vertex
+	int textureArrayID = textured ? int((aTexture >> 10) & 0x1Fu) : -1;
+	int textureLayerID = textured ? int(aTexture & 0x3FFu) : -1;
     gl_Position =  vec4(aPos.x, aPos.y, aPos.z, 1.0);	// Set the vertex position
     vColor = aColor;				// Pass color
 	vTexCoords = aTexCoord;
-	vTexArrayID = aTextureArrayID;
-	vTexLayerID = aTextureLayerID;
+	vTexArrayID = textureArrayID;
+	vTexLayerID = textureLayerID;
 }
\ No newline at end of file
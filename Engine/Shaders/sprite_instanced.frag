@@ -0,0 +1,44 @@
+/*********************************************************************
+ * \file	sprite_instanced.frag
+ * \brief	
+ *      This fragment shader samples the sprite's texture layer, or uses its
+ *      color when it is untextured, like default.frag. Used with
+ *      the instanced sprite vertex shader.
+ *
+ * \author	Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email	y.ziyangirwen@digipen.edu
+ * \date	22 October 2024
+ * 
+ * Copyright(C) 2024 DigiPen Institute of Technology.
+ * Reproduction or disclosure of this file or its contents without the
+ * prior written consent of DigiPen Institute of Technology is prohibited.
+ *********************************************************************/
+#version 460 core
+
+in vec4 vColor;        // Color passed from vertex shader
+in vec2 vTexCoords;    // Texture coordinates passed from vertex shader
+flat in int vTexArrayID;    // Texture ID passed from vertex shader (flat, no interpolation)
+flat in int vTexLayerID;        // Texture ID passed from vertex shader (flat, no interpolation)
+
+out vec4 FragColor;
+
+uniform sampler2DArray textureArrays[32];  // Array of texture samplers (up to 32)
+
+void main()
+{
+    // If texture ID is invalid (less than 0), use the vertex color
+    if (vTexArrayID < 0 || vTexLayerID < 0)
+    {
+        FragColor = vColor;
+    }
+    // If texture ID is valid, sample the corresponding texture
+    else
+    {
+        FragColor = texture(textureArrays[vTexArrayID], vec3(vTexCoords, vTexLayerID));
+		
+		// Threshold for transparency, discard if alpha is below the threshold
+	if (FragColor.a == 0) {
+            discard;
+        }
+    }
+}
\ No newline at end of file
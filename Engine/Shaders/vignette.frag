@@ -19,9 +19,14 @@ in vec2 vTexCoords;
 
 out vec4 FragColor;
 
-uniform float vignetteStrength = 0.8;       // Strength of the vignette effect
-uniform float vignetteSoftness = 0.9;
-uniform vec2 vignetteCenter = vec2(0.5, 0.34);
+layout(std140, binding = 1) uniform FrameData {
+	float time;
+	float bloomIntensity;
+	float vignetteStrength;
+	float vignetteSoftness;
+	vec2 vignetteCenter;
+	float glitchIntensity;
+};
 
 uniform sampler2DArray screenTexture;
 uniform int layerIndex;
@@ -25,34 +25,28 @@
 // Components
 #include "../Components/Renderer.hpp"
 #include "../Components/Animation.hpp"
+#include "../Utility/Profiler.hpp"
 
 AnimationSystem::AnimationSystem() { }
 
 AnimationSystem::~AnimationSystem() { }
 
 void AnimationSystem::Init() {
-    for (auto const& entity : m_entities) {
-        auto& animation = ECSManager::GetInstance().GetComponent<Animation>(entity);
-        auto& renderer = ECSManager::GetInstance().GetComponent<Renderer>(entity);
-
-
+    ECSManager::GetInstance().GetView<Renderer, Animation>().ForEach([this](Entity, Renderer& renderer, Animation& animation) {
         AssignTexCoordsToMesh(renderer, animation);
         //animation.spriteWidth = 1.0f / animation.spritesPerRow;
         //animation.spriteHeight = 1.0f / animation.spritesPerCol;
-    }
+    });
 }
 
 void AnimationSystem::Update(double dt) {
+    PROFILE_SCOPE("AnimationSystem::Update");
     //std::cout << dt << std::endl;
-    for (auto const& entity : m_entities) {
-        if (!ECSManager::GetInstance().GetEntityManager().GetActive(entity)) continue;
-
-        auto& renderer = ECSManager::GetInstance().GetComponent<Renderer>(entity);
-        auto& animation = ECSManager::GetInstance().GetComponent<Animation>(entity);
+    ECSManager::GetInstance().GetView<Renderer, Animation>(ViewFilter::ACTIVE_ONLY).ForEach([this, dt](Entity, Renderer& renderer, Animation& animation) {
         if (renderer.isAnimated) {
             UpdateAnimation(renderer, animation, dt);
         }
-    }
+    });
 }
 
 void AnimationSystem::Exit() {
@@ -16,6 +16,7 @@
 #include "../ECS/ECSManager.hpp"
 #include "../Components/AudioSource.hpp"
 #include "../Audio/AudioManager.hpp"
+#include "../Utility/Profiler.hpp"
 
 
 
@@ -24,11 +25,8 @@ void AudioSystem::Init()
 }
 
 void AudioSystem::Update(double) {
-    for (auto entity : m_entities) {
-        if (!ECSManager::GetInstance().GetEntityManager().GetActive(entity)) continue;
-
-        auto& audioSource = ECSManager::GetInstance().GetComponent<AudioSource>(entity);
-
+    PROFILE_SCOPE("AudioSystem::Update");
+    ECSManager::GetInstance().GetView<AudioSource>(ViewFilter::ACTIVE_ONLY).ForEach([](Entity entity, AudioSource& audioSource) {
         // Ensure the entity has a valid sound clip
         if (!audioSource.audioClipUUID.empty() && audioSource.isPlaying) {
             // Check if THIS entity's sound is playing
@@ -40,7 +38,7 @@ void AudioSystem::Update(double) {
                 if (!audioSource.isLooping) audioSource.isPlaying = false;
             }
         }
-    }
+    });
     AudioManager::GetInstance().Update();
 }
 
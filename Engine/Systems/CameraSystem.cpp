@@ -22,6 +22,7 @@
 #include "../Components/Transform.hpp"
 
 #include "../Graphics/GraphicsManager.hpp"
+#include "../Utility/Profiler.hpp"
 
 CameraSystem::CameraSystem() : mainCameraSet(false), mainCameraEntity(static_cast<uint32_t>(-1))
 {
@@ -33,8 +34,7 @@ CameraSystem::~CameraSystem()
 
 void CameraSystem::Init() 
 {
-	for (auto& entity : m_entities) {
-		auto& camera = ECSManager::GetInstance().GetComponent<Camera>(entity);
+	ECSManager::GetInstance().GetView<Camera, Transform>().ForEach([this](Entity entity, Camera& camera, Transform&) {
 		// The main camera is only set once during initialization
 		if (camera.isMainCamera) {
 			mainCameraEntity = entity;
@@ -43,19 +43,19 @@ void CameraSystem::Init()
 		else if (camera.isActive) {
 			SetActiveCamera(entity);
 		}
-	}
+	});
 }
 
 void CameraSystem::Update() 
 {
+	PROFILE_SCOPE("CameraSystem::Update");
 	// Finds and sets the main camera & active camera
 	// If there are multiple entities with the main camera flag set, 
 	// the first one found will be set as the main camera
 	// If there are multiple entities with the active camera flag set,
 	// the last one found will be set as the active camera
 	mainCameraSet = false;
-	for (auto& entity : m_entities) {
-		auto& camera = ECSManager::GetInstance().GetComponent<Camera>(entity);
+	ECSManager::GetInstance().GetView<Camera, Transform>().ForEach([this](Entity entity, Camera& camera, Transform&) {
 		if (camera.isMainCamera) {
 			if (mainCameraSet) {
 				camera.isMainCamera = false;
@@ -68,7 +68,7 @@ void CameraSystem::Update()
 		if (camera.isActive) {
 			SetActiveCamera(entity);
 		}
-	}
+	});
 
 	{
 		// Check for the case where the active camera's isActive is set to false
@@ -12,28 +12,26 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 *********************************************************************/
 #include "StateMachineSystem.hpp"
 #include "../ECS/ECSManager.hpp"
+#include "../Utility/Profiler.hpp"
 
 void StateMachineSystem::Init() {
-    for (auto const& entity : m_entities) {
-        auto& stateMachineComponent = ECSManager::GetInstance().GetComponent<StateMachineComponent>(entity);
+    ECSManager::GetInstance().GetView<StateMachineComponent>().ForEach([](Entity, StateMachineComponent& stateMachineComponent) {
         if (stateMachineComponent.stateMachine) {
             stateMachineComponent.stateMachine->SetInitialState("Idle");
         }
-    }
+    });
 }
 
 
 void StateMachineSystem::Update(double dt) {
+    PROFILE_SCOPE("StateMachineSystem::Update");
     auto& ecsManager = ECSManager::GetInstance();
 
-    for (auto const& entity : m_entities) {
-        if (!ecsManager.GetEntityManager().GetActive(entity)) continue;
-
-        auto& stateMachineComponent = ecsManager.GetComponent<StateMachineComponent>(entity);
+    ecsManager.GetView<StateMachineComponent>(ViewFilter::ACTIVE_ONLY).ForEach([dt](Entity, StateMachineComponent& stateMachineComponent) {
         if (stateMachineComponent.stateMachine) {
             stateMachineComponent.stateMachine->Update(dt);
         }
-    }
+    });
 }
 
 void StateMachineSystem::AddState(Entity entity, std::shared_ptr<State<Entity>> state) {
@@ -21,13 +21,15 @@
 #include "../Components/Transform.hpp"
 #include "../Components/Renderer.hpp"
 #include "../Components/Camera.hpp"
+#include "../Utility/Profiler.hpp"
 
 std::unordered_map<uint32_t, uint32_t> TransformSystem::uuidToTransformMap;
 
 void TransformSystem::Init() 
 {
-	for (auto& entity : m_entities) {
-		auto& transformComponent = ECSManager::GetInstance().GetComponent<Transform>(entity);
+	auto view = ECSManager::GetInstance().GetView<Transform>();
+
+	view.ForEach([](Entity entity, Transform& transformComponent) {
 		if (transformComponent.parentUUID != 0) {
 			auto parentIt = uuidToTransformMap.find(transformComponent.parentUUID);
 			if (parentIt != uuidToTransformMap.end()) {
@@ -37,11 +39,9 @@ void TransformSystem::Init()
 				transformComponent.parentUUID = 0;
 			}
 		}
-	}
-
-	for (auto const& entity : m_entities) {
-		auto& transformComponent = ECSManager::GetInstance().GetComponent<Transform>(entity);
+	});
 
+	view.ForEach([](Entity, Transform& transformComponent) {
 		// Maybe set the initial values of the transform component here
 
 		// Note: Although rotation is saved as a Vec3 in the Transform component, we only use the z value for rotation for now.
@@ -51,18 +51,17 @@ void TransformSystem::Init()
 			* Mat4::BuildScaling(transformComponent.scale.x, transformComponent.scale.y, transformComponent.scale.z);
 
 		transformComponent.updated = true;
-	}
+	});
 }
 
 void TransformSystem::Update(double)
 {
-	for (auto const& entity : m_entities) {
-		auto& transformComponent = ECSManager::GetInstance().GetComponent<Transform>(entity);
-
+	PROFILE_SCOPE("TransformSystem::Update");
+	ECSManager::GetInstance().GetView<Transform>().ForEach([this](Entity entity, Transform& transformComponent) {
 		// Skip over entities that haven't been updated to avoid unnecessary matrix calculations
 		if (transformComponent.updated) {
 			// Note: Although rotation is saved as a Vec3 in the Transform component, we only use the z value for rotation for now.
-			if (transformComponent.parent != MAX_ENTITIES) {
+			if (transformComponent.parent != NO_ENTITY) {
 				auto& parent = ECSManager::GetInstance().GetComponent<Transform>(transformComponent.parent);
 
 				transformComponent.modelToWorldMtx
@@ -130,7 +129,7 @@ void TransformSystem::Update(double)
 			if (collider.has_value())
 				collider->get().isUpdated = false;
 		}
-	}
+	});
 
 	//for (auto const& entity : m_entities) {
 	//	auto collider = ECSManager::GetInstance().TryGetComponent<AABBCollider2D>(entity);
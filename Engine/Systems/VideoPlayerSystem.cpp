@@ -18,27 +18,22 @@
 #include "../Components/Renderer.hpp"
 #include "../Graphics/GraphicsManager.hpp"
 #include "../AssetManager.hpp"
+#include "../Utility/Profiler.hpp"
 
 void VideoPlayerSystem::Init()
 {
-	for (auto const& entity : m_entities) {
-		auto& renderer = ECSManager::GetInstance().GetComponent<Renderer>(entity);
-		auto& videoPlayer = ECSManager::GetInstance().GetComponent<VideoPlayer>(entity);
-
+	ECSManager::GetInstance().GetView<Renderer, VideoPlayer>().ForEach([](Entity, Renderer& renderer, VideoPlayer& videoPlayer) {
 		videoPlayer.meshID = renderer.currentMeshID;
 		if (videoPlayer.videoClipUUID != "")
 			videoPlayer.videoClip = *AssetManager::GetInstance().Get<VideoClip>(videoPlayer.videoClipUUID);
-	}
+	});
 }
 
 //static double timer = 0.0;
 void VideoPlayerSystem::Update(double dt)
 {
-	for (auto& entity : m_entities) {
-		if (!ECSManager::GetInstance().GetEntityManager().GetActive(entity)) continue;
-
-		auto& videoPlayer = ECSManager::GetInstance().GetComponent<VideoPlayer>(entity);
-		
+	PROFILE_SCOPE("VideoPlayerSystem::Update");
+	ECSManager::GetInstance().GetView<VideoPlayer>(ViewFilter::ACTIVE_ONLY).ForEach([dt](Entity, VideoPlayer& videoPlayer) {
 		if (videoPlayer.isPlaying) {
 			videoPlayer.timer += dt;
 
@@ -58,7 +53,7 @@ void VideoPlayerSystem::Update(double dt)
 					static_cast<int>(videoPlayer.videoClip.texLayerStartIndex + videoPlayer.currentFrame));
 			}
 		}
-	}
+	});
 }
 
 void VideoPlayerSystem::Exit()
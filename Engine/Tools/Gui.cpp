@@ -23,6 +23,7 @@
 #include "Panels/AssetBrowserPanel.hpp"
 #include "Panels/LayersPanel.hpp"
 #include "Panels/LoggerPanel.hpp"
+#include "Panels/PerformancePanel.hpp"
 #include "../Utility/EngineState.hpp"
 #include "../Engine/Scene/SceneManager.hpp"
 #include "Scripting/ScriptEngine.hpp"
@@ -38,6 +39,7 @@ ScenePanel sp{};
 LayersPanel lp{};
 AssetBrowserPanel abp{};
 LoggerPanel lgp{};
+PerformancePanel pfp{};
 GameViewPanel gvp{};
 float color{ 1.f }, size{ 1.f };
 ObjectEditorPanel op(&color,&size);
@@ -199,6 +201,7 @@ void Gui::Init(GLFWwindow* window) {
     Workspace::AddPanel(&op);
     Workspace::AddPanel(&lp);
     Workspace::AddPanel(&lgp);
+    Workspace::AddPanel(&pfp);
 #ifndef INSTALLER
     abp.Init();
 #endif
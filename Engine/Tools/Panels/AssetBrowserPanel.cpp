@@ -20,6 +20,7 @@
 #include "../Engine/Utility/MetadataHandler.hpp"
 #include "../Engine/Utility/Serializer.hpp"
 #include "../Engine/ECS/ECSManager.hpp"
+#include "../Engine/Tools/PrefabManager.hpp"
 #include "../Engine/Components/Name.hpp"
 #include "../../AssetManager.hpp"
 
@@ -29,7 +30,19 @@ static float leftPaneWidth = 200.0f;  // Width of folder tree
 static float split_min = 100.0f;   // Minimum size
 static float split_max = 500.0f;   // Maximum size
 
-AssetBrowserPanel::AssetBrowserPanel() : fileTexViewID(0), folderTexViewID(0), prefabTexViewID(0), sceneTexViewID(0) {
+// Images are flipped when they load, so the top of an icon is the far edge of its region in v
+static ImVec2 IconUV0(Vec4 const& texRect) { return { texRect.x, texRect.y + texRect.w }; }
+static ImVec2 IconUV1(Vec4 const& texRect) { return { texRect.x + texRect.z, texRect.y }; }
+
+// Atlas images only store their content, without the transparent border around it
+static Vec4 StoredRect(Texture const& texture) {
+	Vec4 const& texRect = texture.texRect;
+	Vec4 const& contentRect = texture.contentRect;
+	return Vec4(texRect.x + contentRect.x * texRect.z, texRect.y + contentRect.y * texRect.w, contentRect.z * texRect.z, contentRect.w * texRect.w);
+}
+
+AssetBrowserPanel::AssetBrowserPanel() : fileTexViewID(0), folderTexViewID(0), prefabTexViewID(0), sceneTexViewID(0),
+	folderTexRect(0.f, 0.f, 1.f, 1.f), fileTexRect(0.f, 0.f, 1.f, 1.f), prefabTexRect(0.f, 0.f, 1.f, 1.f), sceneTexRect(0.f, 0.f, 1.f, 1.f) {
 	name = "Assets Browser";
 	show = true;
 
@@ -48,6 +61,11 @@ void AssetBrowserPanel::Init() {
 	folderTexViewID = GraphicsManager::GetInstance().CreateTextureView(textureArray[folderTex.texArrayIndex].id_gl, (int)folderTex.texLayerIndex);
 	prefabTexViewID = GraphicsManager::GetInstance().CreateTextureView(textureArray[prefabTex.texArrayIndex].id_gl, (int)prefabTex.texLayerIndex);
 	sceneTexViewID = GraphicsManager::GetInstance().CreateTextureView(textureArray[sceneTex.texArrayIndex].id_gl, (int)sceneTex.texLayerIndex);
+
+	fileTexRect = StoredRect(fileTex);
+	folderTexRect = StoredRect(folderTex);
+	prefabTexRect = StoredRect(prefabTex);
+	sceneTexRect = StoredRect(sceneTex);
 }
 
 void AssetBrowserPanel::DisplayFolderTree(const std::filesystem::path& folderPath)
@@ -93,12 +111,12 @@ void AssetBrowserPanel::DisplayFilesInFolder(const std::filesystem::path& folder
 		ImGui::PushID(filenameString.c_str());
 
 		if (directoryEntry.is_directory()) {
-			ImGui::ImageButton("##btn", (ImTextureID)(intptr_t)folderTexViewID, { thumbnailSize, thumbnailSize }, { 0, 1 }, { 1, 0 });
+			ImGui::ImageButton("##btn", (ImTextureID)(intptr_t)folderTexViewID, { thumbnailSize, thumbnailSize }, IconUV0(folderTexRect), IconUV1(folderTexRect));
 			if (ImGui::IsItemClicked(ImGuiMouseButton_Left)) {
 				selectedAssetPath = path;
 			}
 		} else if (path.extension() == ".prefab") {
-			ImGui::ImageButton("##btn", (ImTextureID)(intptr_t)prefabTexViewID, { thumbnailSize, thumbnailSize }, { 0, 1 }, { 1, 0 });
+			ImGui::ImageButton("##btn", (ImTextureID)(intptr_t)prefabTexViewID, { thumbnailSize, thumbnailSize }, IconUV0(prefabTexRect), IconUV1(prefabTexRect));
 			if (ImGui::IsItemClicked(ImGuiMouseButton_Left)) {
 				selectedAssetPath = path;
 			}
@@ -110,7 +128,7 @@ void AssetBrowserPanel::DisplayFilesInFolder(const std::filesystem::path& folder
 				ImGui::EndDragDropSource();
 			}
 		} else if (path.extension() == ".scene") {
-			ImGui::ImageButton("##btn", (ImTextureID)(intptr_t)sceneTexViewID, { thumbnailSize, thumbnailSize }, { 0, 1 }, { 1, 0 });
+			ImGui::ImageButton("##btn", (ImTextureID)(intptr_t)sceneTexViewID, { thumbnailSize, thumbnailSize }, IconUV0(sceneTexRect), IconUV1(sceneTexRect));
 			if (ImGui::IsItemClicked(ImGuiMouseButton_Left)) {
 				selectedAssetPath = path;
 			}
@@ -140,7 +158,7 @@ void AssetBrowserPanel::DisplayFilesInFolder(const std::filesystem::path& folder
 			ImGui::ImageButton("##btn", (void*)(intptr_t)GraphicsManager::GetInstance().textures[uuid].GetID(), { thumbnailSize, thumbnailSize }, { 0, 1 }, { 1, 0 });
 #endif // !DISPLAY_TEXTURE_ICONS
 
-			ImGui::ImageButton("##btn", (ImTextureID)(intptr_t)fileTexViewID, { thumbnailSize, thumbnailSize }, { 0, 1 }, { 1, 0 });
+			ImGui::ImageButton("##btn", (ImTextureID)(intptr_t)fileTexViewID, { thumbnailSize, thumbnailSize }, IconUV0(fileTexRect), IconUV1(fileTexRect));
 			if (ImGui::IsItemClicked(ImGuiMouseButton_Left)) {
 				selectedAssetPath = path;
 			}
@@ -153,7 +171,7 @@ void AssetBrowserPanel::DisplayFilesInFolder(const std::filesystem::path& folder
 				ImGui::EndDragDropSource();
 			}
 		} else if (!directoryEntry.is_directory() && (path.extension() == ".wav" || path.extension() == ".ogg")) {
-			ImGui::ImageButton("##btn", (ImTextureID)(intptr_t)fileTexViewID, { thumbnailSize, thumbnailSize }, { 0, 1 }, { 1, 0 });
+			ImGui::ImageButton("##btn", (ImTextureID)(intptr_t)fileTexViewID, { thumbnailSize, thumbnailSize }, IconUV0(fileTexRect), IconUV1(fileTexRect));
 			if (ImGui::IsItemClicked(ImGuiMouseButton_Left)) {
 				selectedAssetPath = path;
 			}
@@ -174,7 +192,7 @@ void AssetBrowserPanel::DisplayFilesInFolder(const std::filesystem::path& folder
 		} else if (!directoryEntry.is_directory() && (path.extension() == ".mpg")) {
 			std::string uuid = MetadataHandler::ParseUUIDFromMeta(path.string() + ".meta");
 
-			ImGui::ImageButton("##btn", (ImTextureID)(intptr_t)fileTexViewID, { thumbnailSize, thumbnailSize }, { 0, 1 }, { 1, 0 });
+			ImGui::ImageButton("##btn", (ImTextureID)(intptr_t)fileTexViewID, { thumbnailSize, thumbnailSize }, IconUV0(fileTexRect), IconUV1(fileTexRect));
 			if (ImGui::IsItemClicked(ImGuiMouseButton_Left)) {
 				selectedAssetPath = path;
 			}
@@ -349,6 +367,7 @@ void AssetBrowserPanel::Update()
 			std::string targetPath = currentDirectory.relative_path().string() + "/" + nameC.name + ".prefab";
 			Serializer::GetInstance().SerializePrefab(targetPath, droppedEntt);
 			MetadataHandler::GenerateMetaFile(targetPath);
+			PrefabManager::GetInstance().InvalidatePrefabPaths();
 			nameC.prefabID = MetadataHandler::ParseUUIDFromMeta(targetPath + ".meta");
 			nameC.prefabPath = targetPath;
 			//sceneEntities[droppedEntt].isPrefab = true;
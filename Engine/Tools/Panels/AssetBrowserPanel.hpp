@@ -138,6 +138,12 @@ private:
 	GLuint prefabTexViewID;
 	GLuint sceneTexViewID;
 
+	// Region of each icon's layer holding its image, as the icons can share an atlas page
+	Vec4 folderTexRect;
+	Vec4 fileTexRect;
+	Vec4 prefabTexRect;
+	Vec4 sceneTexRect;
+
 	bool showPopup = false;
 	std::string selectedScenePath;
 
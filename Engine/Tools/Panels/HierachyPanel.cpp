@@ -48,9 +48,8 @@ void HierachyPanel::Refresh() {
 
     auto& ecs = ECSManager::GetInstance();
     auto& entityManager = ecs.GetEntityManager();
-    uint32_t numEntities = entityManager.GetEntities();
 
-    for (uint32_t i = 0; i < numEntities; ++i) {
+    for (Entity i : entityManager.GetLivingEntities()) {
         bool isPrefab = (ecs.GetComponent<Name>(i).prefabID != "") ? true : false;
         sceneEntities.emplace_back(ecs.GetComponent<Name>(i).name, i, isPrefab);
         sceneEntityMap[i] = std::prev(sceneEntities.end());
@@ -311,7 +310,7 @@ void HierachyPanel::RemoveParent(uint32_t currID) {
                 childT.scale = childT.modelToWorldMtx.GetScale();
                 childT.rotation = childT.modelToWorldMtx.GetRotation();
 
-                childT.parent = MAX_ENTITIES;
+                childT.parent = NO_ENTITY;
                 childT.parentUUID = 0;
                 entt->parent = nullptr;
             }
@@ -335,7 +334,7 @@ void HierachyPanel::RemoveParent(uint32_t currID) {
     entity.parent->children.remove(&entity);
 
     entity.parent = nullptr;
-    childT.parent = MAX_ENTITIES;
+    childT.parent = NO_ENTITY;
     childT.parentUUID = 0;
 
     childT.position = childT.modelToWorldMtx.GetTranslation();
@@ -347,6 +346,7 @@ void HierachyPanel::RemoveParent(uint32_t currID) {
 
 void HierachyPanel::CreateEntity() {
     Entity entt = ECSManager::GetInstance().CreateEntity();
+    if (entt == NO_ENTITY) return;
     Gui::Entity guiEntity = { ECSManager::GetInstance().GetComponent<Name>(entt).name, entt };
 
     sceneEntities.push_back(std::move(guiEntity));
@@ -374,6 +374,7 @@ void HierachyPanel::CreateEntity() {
 
 void HierachyPanel::CreateTextboxUIEntity() {
     Entity entt = ECSManager::GetInstance().CreateEntity();
+    if (entt == NO_ENTITY) return;
     Gui::Entity guiEntity = { ECSManager::GetInstance().GetComponent<Name>(entt).name, entt };
     sceneEntities.push_back(std::move(guiEntity));
     sceneEntityMap[entt] = std::prev(sceneEntities.end());
@@ -383,6 +384,7 @@ void HierachyPanel::CreateTextboxUIEntity() {
     ECSManager::GetInstance().renderSystem->SetTextureToMesh(id.first, "");
     ECSManager::GetInstance().renderSystem->SetVisibility(id.first, true);
     ECSManager::GetInstance().AddComponent(entt, Renderer(id.first, id.second, ""));
+    ECSManager::GetInstance().GetComponent<Renderer>(entt).isInitialized = true;
 
     ECSManager::GetInstance().renderSystem->SetColorToEntity(entt, ECSManager::GetInstance().renderSystem->EncodeColor(entt));
     ECSManager::GetInstance().AddComponent(entt, UI());
@@ -398,6 +400,7 @@ void HierachyPanel::CreateTextboxUIEntity() {
 
 void HierachyPanel::CreateQuadUIEntity() {
     Entity entt = ECSManager::GetInstance().CreateEntity();
+    if (entt == NO_ENTITY) return;
     Gui::Entity guiEntity = { ECSManager::GetInstance().GetComponent<Name>(entt).name, entt };
     sceneEntities.push_back(std::move(guiEntity));
     sceneEntityMap[entt] = std::prev(sceneEntities.end());
@@ -408,6 +411,7 @@ void HierachyPanel::CreateQuadUIEntity() {
     ECSManager::GetInstance().renderSystem->SetVisibility(id.first, true);
     ECSManager::GetInstance().AddComponent(entt, Renderer(id.first, id.second, ""));
     ECSManager::GetInstance().GetComponent<Renderer>(entt).mesh = RenderSystem::MeshType::QUAD_UI;
+    ECSManager::GetInstance().GetComponent<Renderer>(entt).isInitialized = true;
 
     ECSManager::GetInstance().AddComponent(entt, UI());
 
@@ -420,6 +424,7 @@ void HierachyPanel::CreateQuadUIEntity() {
 
 void HierachyPanel::CreateVideoUIEntity() {
     Entity entt = ECSManager::GetInstance().CreateEntity();
+    if (entt == NO_ENTITY) return;
     Gui::Entity guiEntity = { ECSManager::GetInstance().GetComponent<Name>(entt).name, entt };
     sceneEntities.push_back(std::move(guiEntity));
     sceneEntityMap[entt] = std::prev(sceneEntities.end());
@@ -430,6 +435,7 @@ void HierachyPanel::CreateVideoUIEntity() {
     ECSManager::GetInstance().renderSystem->SetVisibility(id.first, true);
     ECSManager::GetInstance().AddComponent(entt, Renderer(id.first, id.second, ""));
     ECSManager::GetInstance().GetComponent<Renderer>(entt).mesh = RenderSystem::MeshType::VIDEO_UI;
+    ECSManager::GetInstance().GetComponent<Renderer>(entt).isInitialized = true;
 
     ECSManager::GetInstance().AddComponent(entt, UI());
 
@@ -447,6 +453,7 @@ void HierachyPanel::CreateVideoUIEntity() {
 
 void HierachyPanel::CreateCameraEntity() {
     Entity entt = ECSManager::GetInstance().CreateEntity();
+    if (entt == NO_ENTITY) return;
     Gui::Entity guiEntity = { ECSManager::GetInstance().GetComponent<Name>(entt).name, entt };
     sceneEntities.push_back(std::move(guiEntity));
     sceneEntityMap[entt] = std::prev(sceneEntities.end());
@@ -62,14 +62,13 @@ void LoggerPanel::RenderFilters() {
 }
 
 void LoggerPanel::RenderLogs() {
-    static std::vector<std::string> cachedLogs;
-    cachedLogs.clear();
-
-    auto logs = Logger::Instance().GetSafeLogBuffer(); // Fetch a thread-safe copy of the log buffer
-
-    if (logs.size() != cachedLogs.size()) {
-        cachedLogs = logs; // Only update if new logs are available
+    // Only copy the log buffer when the logger reports new messages
+    uint64_t version = Logger::Instance().GetBufferVersion();
+    if (version != cachedVersion) {
+        cachedLogs = Logger::Instance().GetSafeLogBuffer(); // Fetch a thread-safe copy of the log buffer
+        cachedVersion = version;
     }
+    auto const& logs = cachedLogs;
 
 
     ImGui::BeginChild("LogOutput", ImVec2(0, 0), true, ImGuiWindowFlags_HorizontalScrollbar);
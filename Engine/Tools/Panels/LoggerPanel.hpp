@@ -17,6 +17,7 @@
 #include "../EditorPanel.hpp"
 #include "../Core/Logger.hpp"
 #include <string>
+#include <vector>
 
 class LoggerPanel : public EditorPanel {
 public:
@@ -47,5 +48,8 @@ private:
     std::string searchQuery; // Search bar input
     std::mutex logMutex;                 // Thread safety for local buffer
 
+    std::vector<std::string> cachedLogs; // Copy of the logger's buffer shown in the panel
+    uint64_t cachedVersion = static_cast<uint64_t>(-1); // Logger buffer version of cachedLogs
+
     float loggerOpacity = 1.0f; // Logger window opacity
 };
@@ -69,6 +69,7 @@ void ObjectEditorPanel::DrawAddComponentDropdown() {
 		if (ImGui::MenuItem("Renderer")) {
 			std::pair<size_t, size_t> mesh = ECSManager::GetInstance().renderSystem->AddMesh(3);
 			ECSManager::GetInstance().AddComponent(selectedEntity->id, Renderer(mesh.first, mesh.second, ""));
+			ECSManager::GetInstance().GetComponent<Renderer>(selectedEntity->id).isInitialized = true;
 			ECSManager::GetInstance().renderSystem->SetColorToEntity(selectedEntity->id, ECSManager::GetInstance().renderSystem->EncodeColor(selectedEntity->id));
 
 			for (auto& batch : GraphicsManager::GetInstance().batches) {
@@ -655,7 +656,7 @@ void FieldInternalTypesBehavior(uint32_t* selectedEntity, bool scriptClassExists
 
 void ObjectEditorPanel::SetInactive(std::list<Gui::Entity*>& children, bool isActive) {
 	for (auto& child : children) {
-		ECSManager::GetInstance().GetEntityManager().SetActive(child->id, isActive);
+		ECSManager::GetInstance().SetActive(child->id, isActive);
 		ECSManager::GetInstance().renderSystem->SetVisibility(child->id, isActive);
 		if (child->children.size() > 0) {
 			SetInactive(child->children, isActive);
@@ -670,7 +671,7 @@ void ObjectEditorPanel::DrawComponents() { //need to parse in entity object even
 	auto& layerManager = LayerManager::GetInstance();
 	bool isActive = ecsManager.GetEntityManager().GetActive(selectedEntity->id);
 	if (ImGui::Checkbox("##", &isActive)) {
-		ecsManager.GetEntityManager().SetActive(selectedEntity->id, isActive);
+		ecsManager.SetActive(selectedEntity->id, isActive);
 		ecsManager.renderSystem->SetVisibility(selectedEntity->id, isActive);
 		if (selectedEntity->children.size() > 0) {
 			SetInactive(selectedEntity->children, isActive);
@@ -756,7 +757,7 @@ void ObjectEditorPanel::DrawComponents() { //need to parse in entity object even
 		Vec3 scale = transform.scale;
 		Vec3 rotation = transform.rotation;
 
-		if (transform.parent == MAX_ENTITIES) {
+		if (transform.parent == NO_ENTITY) {
 			if (DrawVec3Control("Position", position)) 
 				ECSManager::GetInstance().transformSystem->SetPosition(selectedEntity->id, position);
 			if (DrawVec3Control("Scale", scale, 1.0f)) 
@@ -808,11 +809,7 @@ void ObjectEditorPanel::DrawComponents() { //need to parse in entity object even
 
 					// Update the renderer component with the new texture UUID
 					renderer.uuid = droppedUUID;
-					GraphicsManager::GetInstance().SetTextureToMesh(
-						renderer.currentMeshID,
-						static_cast<int>(AssetManager::GetInstance().Get<Texture>(renderer.uuid)->texArrayIndex),
-						static_cast<int>(AssetManager::GetInstance().Get<Texture>(renderer.uuid)->texLayerIndex)
-					);
+					ECSManager::GetInstance().renderSystem->SetTextureToMesh(renderer.currentMeshID, renderer.uuid);
 
 					//Logger::Instance().Log(Logger::Level::INFO, "Texture assigned: " + droppedUUID);
 				}
@@ -843,7 +840,7 @@ void ObjectEditorPanel::DrawComponents() { //need to parse in entity object even
 
 			if (ImGui::BeginPopup("Options")) {
 				if (ImGui::MenuItem("Delete Component")) {
-					ecsManager.renderSystem->SetVisibility(renderer.currentMeshID, false);
+					ecsManager.renderSystem->ReleaseMeshes(renderer);
 					ecsManager.RemoveComponent<Renderer>(selectedEntity->id);
 
 					for (auto& batch : GraphicsManager::GetInstance().batches) {
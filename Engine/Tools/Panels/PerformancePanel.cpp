@@ -0,0 +1,243 @@
+/*********************************************************************
+ * \file	    PerformancePanel.cpp
+ * \brief	    Defines a PerformancePanel class for displaying frame
+ *				timings collected by the profiler.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		20 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include "../ImGui/imgui.h"
+
+#include "PerformancePanel.hpp"
+
+#include <algorithm>
+#include <filesystem>
+
+#include "../../Utility/Profiler.hpp"
+#include "../../AssetManager.hpp"
+#include "../../Scene/SceneManager.hpp"
+
+namespace {
+    constexpr const char* CAPTURE_PATH = "../Logs/profile.json";
+}
+
+PerformancePanel::PerformancePanel() {
+    name = "Performance";
+    show = true;
+}
+
+void PerformancePanel::Update() {
+    if (!show) return;
+    ImGui::Begin(name.c_str());
+
+#if KIGEN_PROFILE
+    RenderControls();
+    ImGui::Separator();
+    RenderFrameGraph();
+    ImGui::Separator();
+    RenderZones();
+    RenderCounters();
+#else
+    ImGui::TextDisabled("Profiling is compiled out of this build (KIGEN_PROFILE is 0).");
+#endif
+    RenderAssets();
+
+    ImGui::End();
+}
+
+void PerformancePanel::RenderControls() {
+    Profiler& profiler = Profiler::GetInstance();
+
+    bool enabled = profiler.IsEnabled();
+    if (ImGui::Checkbox("Record", &enabled)) {
+        profiler.SetEnabled(enabled);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset Max")) {
+        profiler.ResetStats();
+    }
+
+    ImGui::SameLine();
+    if (profiler.IsCapturing()) {
+        if (ImGui::Button("Stop Capture")) {
+            profiler.StopCapture();
+        }
+        ImGui::SameLine();
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Capturing...");
+    }
+    else {
+        if (ImGui::Button("Capture Trace")) {
+            std::filesystem::create_directories(std::filesystem::path(CAPTURE_PATH).parent_path());
+            profiler.StartCapture(CAPTURE_PATH, static_cast<uint32_t>(captureFrames));
+        }
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(100.0f);
+        ImGui::InputInt("frames", &captureFrames);
+        captureFrames = std::max(captureFrames, 0);
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("0 captures until stopped. The trace is written to %s and opens in chrome://tracing or ui.perfetto.dev.", CAPTURE_PATH);
+        }
+    }
+
+    uint64_t dropped = profiler.GetDroppedEvents();
+    if (dropped > 0) {
+        ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.2f, 1.0f), "%llu events dropped", static_cast<unsigned long long>(dropped));
+    }
+}
+
+void PerformancePanel::RenderFrameGraph() {
+    Profiler& profiler = Profiler::GetInstance();
+    std::vector<float> history = profiler.GetFrameHistory();
+
+    double frameMs = profiler.GetLastFrameMs();
+    ImGui::Text("FPS: %.1f  Frame: %.2f ms", frameMs > 0.0 ? 1000.0 / frameMs : 0.0, frameMs);
+
+    if (!history.empty()) {
+        float maxMs = *std::max_element(history.begin(), history.end());
+        ImGui::PlotLines("##FrameTimes", history.data(), static_cast<int>(history.size()), 0,
+            nullptr, 0.0f, std::max(maxMs, 1000.0f / 60.0f) * 1.1f, ImVec2(-1.0f, 60.0f));
+    }
+}
+
+void PerformancePanel::RenderZones() {
+    Profiler& profiler = Profiler::GetInstance();
+    auto const& nodes = profiler.GetNodes();
+
+    ImGuiTableFlags flags = ImGuiTableFlags_BordersV | ImGuiTableFlags_BordersOuterH | ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg;
+    if (!ImGui::BeginTable("Zones", 5, flags)) return;
+
+    ImGui::TableSetupColumn("Zone", ImGuiTableColumnFlags_NoHide);
+    ImGui::TableSetupColumn("ms", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+    ImGui::TableSetupColumn("avg ms", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+    ImGui::TableSetupColumn("max ms", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+    ImGui::TableSetupColumn("calls", ImGuiTableColumnFlags_WidthFixed, 50.0f);
+    ImGui::TableHeadersRow();
+
+    for (size_t thread = 0; thread < profiler.GetThreadRoots().size(); ++thread) {
+        uint32_t root = profiler.GetThreadRoots()[thread];
+        if (nodes[root].children.empty()) continue;
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::PushID(static_cast<int>(root));
+        bool open = ImGui::TreeNodeEx("##Thread", ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_SpanFullWidth, "%s", profiler.GetThreadName(static_cast<uint32_t>(thread)).c_str());
+        ImGui::PopID();
+        if (open) {
+            for (uint32_t child : nodes[root].children) {
+                RenderNode(child);
+            }
+            ImGui::TreePop();
+        }
+    }
+
+    ImGui::EndTable();
+}
+
+void PerformancePanel::RenderNode(uint32_t node) {
+    auto const& nodes = Profiler::GetInstance().GetNodes();
+    Profiler::Node const& zone = nodes[node];
+
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+
+    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanFullWidth;
+    if (zone.children.empty()) {
+        flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+    }
+    else if (nodes[zone.parent].parent == Profiler::INVALID_NODE) {
+        flags |= ImGuiTreeNodeFlags_DefaultOpen;
+    }
+
+    ImGui::PushID(static_cast<int>(node));
+    bool open = ImGui::TreeNodeEx("##Zone", flags, "%s", zone.name);
+    ImGui::PopID();
+
+    ImGui::TableNextColumn();
+    ImGui::Text("%.3f", zone.frameMs);
+    ImGui::TableNextColumn();
+    ImGui::Text("%.3f", zone.avgMs);
+    ImGui::TableNextColumn();
+    ImGui::Text("%.3f", zone.maxMs);
+    ImGui::TableNextColumn();
+    ImGui::Text("%u", zone.frameCalls);
+
+    if (open && !zone.children.empty()) {
+        for (uint32_t child : zone.children) {
+            RenderNode(child);
+        }
+        ImGui::TreePop();
+    }
+}
+
+void PerformancePanel::RenderCounters() {
+    auto const& counters = Profiler::GetInstance().GetCounters();
+    if (counters.empty()) return;
+
+    if (ImGui::CollapsingHeader("Counters", ImGuiTreeNodeFlags_DefaultOpen)) {
+        for (auto const& counter : counters) {
+            ImGui::Text("%s: %.0f", counter.name, counter.value);
+        }
+    }
+}
+
+void PerformancePanel::RenderAssets() {
+    if (!ImGui::CollapsingHeader("Assets", ImGuiTreeNodeFlags_DefaultOpen)) return;
+
+    SceneAssets::Transition const& transition = SceneManager::GetInstance().GetAssetTransition();
+    ImGui::Text("Last scene change: %zu kept, %zu added, %zu released", transition.kept, transition.added, transition.released);
+
+    ImGuiTableFlags flags = ImGuiTableFlags_BordersV | ImGuiTableFlags_BordersOuterH | ImGuiTableFlags_RowBg;
+    if (!ImGui::BeginTable("Residency", 8, flags)) return;
+
+    ImGui::TableSetupColumn("Type");
+    ImGui::TableSetupColumn("loaded", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+    ImGui::TableSetupColumn("referenced", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+    ImGui::TableSetupColumn("pages", ImGuiTableColumnFlags_WidthFixed, 50.0f);
+    ImGui::TableSetupColumn("MB", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+    ImGui::TableSetupColumn("budget MB", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+    ImGui::TableSetupColumn("loads", ImGuiTableColumnFlags_WidthFixed, 50.0f);
+    ImGui::TableSetupColumn("unloads", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+    ImGui::TableHeadersRow();
+
+    constexpr double MEGABYTE = 1024.0 * 1024.0;
+    for (AssetResidency const& residency : AssetManager::GetInstance().GetResidency()) {
+        bool isOverBudget = residency.bytes > residency.budget;
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(residency.type);
+        ImGui::TableNextColumn();
+        ImGui::Text("%zu", residency.resident);
+        ImGui::TableNextColumn();
+        ImGui::Text("%zu", residency.referenced);
+        ImGui::TableNextColumn();
+        ImGui::Text("%zu", residency.pages);
+        ImGui::TableNextColumn();
+        if (isOverBudget) {
+            ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%.1f", residency.bytes / MEGABYTE);
+        }
+        else {
+            ImGui::Text("%.1f", residency.bytes / MEGABYTE);
+        }
+        ImGui::TableNextColumn();
+        if (residency.budget == std::numeric_limits<size_t>::max()) {
+            ImGui::TextUnformatted("-");
+        }
+        else {
+            ImGui::Text("%.1f", residency.budget / MEGABYTE);
+        }
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", static_cast<unsigned long long>(residency.loads));
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", static_cast<unsigned long long>(residency.unloads));
+    }
+
+    ImGui::EndTable();
+}
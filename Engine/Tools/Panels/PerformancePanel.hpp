@@ -0,0 +1,49 @@
+/*********************************************************************
+ * \file	    PerformancePanel.hpp
+ * \brief	    Defines a PerformancePanel class for displaying frame
+ *				timings collected by the profiler.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		20 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#pragma once
+
+#include "../EditorPanel.hpp"
+
+#include <cstdint>
+
+class PerformancePanel : public EditorPanel {
+public:
+    /**
+     * @brief Constructs a `PerformancePanel` instance.
+     *
+     * Sets up the default name and visibility state of the performance panel.
+     */
+    PerformancePanel();
+
+    /**
+     * @brief Updates the performance panel.
+     *
+     * Shows the frame time graph, the profiled zones of every thread as a
+     * tree, the latest counter values, the memory the loaded assets hold,
+     * and controls to pause the profiler and capture a Chrome trace.
+     */
+    void Update() override;
+
+private:
+    void RenderControls();              // Pause, reset and capture buttons
+    void RenderFrameGraph();            // Frame time history
+    void RenderZones();                 // Call tree of every thread
+    void RenderNode(uint32_t node);     // One row of the call tree and its children
+    void RenderCounters();              // Latest counter values
+    void RenderAssets();                // Memory held by the loaded assets of each type
+
+    int captureFrames = 120;            // Number of frames recorded by the capture button
+};
@@ -15,7 +15,6 @@
 #include "ScenePanel.hpp"
 
 #include <iostream>
-#include "../ProcessTime.hpp"
 #include "../../Utility/EngineConfig.hpp"
 #include "../Engine/ECS/ECSManager.hpp"
 #include "../ImGui/ImGuizmo/ImGuizmo.h"
@@ -69,22 +68,15 @@ void ScenePanel::Update()
 	if (ImGui::IsKeyPressed(ImGuiKey_8)) textureUUID = "fbo9"; // ENGINE
 	if (ImGui::IsKeyPressed(ImGuiKey_9)) textureUUID = "fbo12"; // OBJ_PICKING_UI
 	if (ImGui::IsKeyPressed(ImGuiKey_0)) textureUUID = "fbo11"; // GAME_FINAL
+	// The object picking framebuffers are only drawn for pixel picking, so draw them while one is viewed
+	if (ImGui::IsKeyPressed(ImGuiKey_7) || ImGui::IsKeyPressed(ImGuiKey_8) || ImGui::IsKeyPressed(ImGuiKey_9) || ImGui::IsKeyPressed(ImGuiKey_0)) {
+		ECSManager::GetInstance().renderSystem->SetPixelPicking(textureUUID == "fbo12");
+	}
 	
 
 	// Display the rendered scene
 	//ImGui::Text("Rendered Scene");
 
-	// Display time statistics
-	//ImGui::Text("FPS: %.2f", ProcessTime::fps);
-	//ImGui::SameLine();
-	//ImGui::Text("Physics: %.2f%%", ProcessTime::percentMap[ProcessTime::PHYSICS]);
-	//ImGui::SameLine();
-	//ImGui::Text("Graphics: %.2f%%", ProcessTime::percentMap[ProcessTime::GRAPHICS]);
-	//ImGui::SameLine();
-	//ImGui::Text("Audio: %.2f%%", ProcessTime::percentMap[ProcessTime::AUDIO]);
-	//ImGui::SameLine();
-	//ImGui::Text("Misc: %.2f%%", ProcessTime::percentMap[ProcessTime::MISC]);
-
 	auto& camera = GraphicsManager::GetInstance().camera;
 
 	ImVec2 panelPos = ImGui::GetCursorScreenPos();
@@ -129,10 +121,8 @@ void ScenePanel::Update()
 				if (ImGui::IsMouseReleased(ImGuiMouseButton_Left)) {
 					int x = static_cast<int>(spMouseX * Application::GetWindowSize().first);
 					int y = static_cast<int>(spMouseY * Application::GetWindowSize().second);
-					Vec4 colour = GraphicsManager::GetInstance().GetPixelColor(
-						GraphicsManager::GetInstance().frameBuffers[GraphicsManager::FrameBufferIndex::OBJ_PICKING_ENGINE], x, y);
-
-					uint32_t clickedEntity = ECSManager::GetInstance().renderSystem->DecodeColor(colour);
+					uint32_t clickedEntity = ECSManager::GetInstance().renderSystem->GetEntityAt(
+						GraphicsManager::FrameBufferIndex::OBJ_PICKING_ENGINE, x, y);
 					//std::cout << "Clicked on entity: " << clickedEntity << std::endl;
 					if (sceneEntityMap.find(clickedEntity) != sceneEntityMap.end()) {
 						selectedEntity = &*sceneEntityMap.find(clickedEntity)->second;
@@ -200,44 +190,45 @@ void ScenePanel::Update()
 		if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("PREFAB")) {
 			std::string prefabPath(static_cast<const char*>(payload->Data), payload->DataSize);
 			Entity entt = Serializer::GetInstance().DeserializePrefab(prefabPath);
+			if (entt != NO_ENTITY) {
+				//auto& camera = GraphicsManager::GetInstance().camera;
+				ImVec2 currentMousePos = ImGui::GetMousePos();
+				ImVec2 relativeMousePos = ImVec2(currentMousePos.x - panelPos.x, currentMousePos.y - panelPos.y);
 
-			//auto& camera = GraphicsManager::GetInstance().camera;
-			ImVec2 currentMousePos = ImGui::GetMousePos();
-			ImVec2 relativeMousePos = ImVec2(currentMousePos.x - panelPos.x, currentMousePos.y - panelPos.y);
+				float ndcX = (relativeMousePos.x / panelSize.x) * 2.0f - 1.0f;
 
-			float ndcX = (relativeMousePos.x / panelSize.x) * 2.0f - 1.0f;
+				float invertedY = panelSize.y - relativeMousePos.y;
+				float ndcY = (invertedY / panelSize.y) * 2.0f - 1.0f;
 
-			float invertedY = panelSize.y - relativeMousePos.y;
-			float ndcY = (invertedY / panelSize.y) * 2.0f - 1.0f;
+				float worldX = ndcX * (camera.screenWidth / 2.0f) / camera.zoom + camera.position.x;
+				float worldY = ndcY * (camera.screenHeight / 2.0f) / camera.zoom + camera.position.y;
 
-			float worldX = ndcX * (camera.screenWidth / 2.0f) / camera.zoom + camera.position.x;
-			float worldY = ndcY * (camera.screenHeight / 2.0f) / camera.zoom + camera.position.y;
+				auto& n = ECSManager::GetInstance().GetComponent<Name>(entt);
+				PrefabManager::GetInstance().prefabsMap[n.prefabID].push_back(entt);
 
-			auto& n = ECSManager::GetInstance().GetComponent<Name>(entt);
-			PrefabManager::GetInstance().prefabsMap[n.prefabID].push_back(entt);
+				auto& t = ECSManager::GetInstance().GetComponent<Transform>(entt);
+				t.position = Vec3(worldX, worldY, 0.f);
 
-			auto& t = ECSManager::GetInstance().GetComponent<Transform>(entt);
-			t.position = Vec3(worldX, worldY, 0.f);
+				auto& r = ECSManager::GetInstance().GetComponent<Renderer>(entt);
+				std::pair<size_t, size_t> mesh = ECSManager::GetInstance().renderSystem->AddMesh(r.mesh);
+				r.currentMeshID = mesh.first;
+				r.currentMeshDebugID = mesh.second;
+				ECSManager::GetInstance().renderSystem->SetTextureToMesh(mesh.first, r.uuid);
+				ECSManager::GetInstance().renderSystem->SetVisibility(mesh.first, true);
+				r.isInitialized = true;
 
-			auto& r = ECSManager::GetInstance().GetComponent<Renderer>(entt);
-			std::pair<size_t, size_t> mesh = ECSManager::GetInstance().renderSystem->AddMesh(r.mesh);
-			r.currentMeshID = mesh.first;
-			r.currentMeshDebugID = mesh.second;
-			ECSManager::GetInstance().renderSystem->SetTextureToMesh(mesh.first, r.uuid);
-			ECSManager::GetInstance().renderSystem->SetVisibility(mesh.first, true);
-			r.isInitialized = true;
+				ECSManager::GetInstance().renderSystem->SetColorToEntity(entt, ECSManager::GetInstance().renderSystem->EncodeColor(entt));
 
-			ECSManager::GetInstance().renderSystem->SetColorToEntity(entt, ECSManager::GetInstance().renderSystem->EncodeColor(entt));
+				for (size_t i = 0; i < GraphicsManager::BatchIndex::MAX_BATCHES; ++i) {
+					GraphicsManager::GetInstance().SetBatchUpdateFlag(
+						static_cast<GraphicsManager::BatchIndex>(i)
+					);
+				}
 
-			for (size_t i = 0; i < GraphicsManager::BatchIndex::MAX_BATCHES; ++i) {
-				GraphicsManager::GetInstance().SetBatchUpdateFlag(
-					static_cast<GraphicsManager::BatchIndex>(i)
-				);
+				sceneEntities.emplace_back(Gui::Entity{ n.name, entt, true });
+				sceneEntityMap[entt] = std::prev(sceneEntities.end());
+				sceneTransformUUID[ECSManager::GetInstance().GetComponent<Transform>(entt).uuid] = &sceneEntities.back();
 			}
-
-			sceneEntities.emplace_back(Gui::Entity{ n.name, entt, true });
-			sceneEntityMap[entt] = std::prev(sceneEntities.end());
-			sceneTransformUUID[ECSManager::GetInstance().GetComponent<Transform>(entt).uuid] = &sceneEntities.back();
 		}
 		ImGui::EndDragDropTarget();
 	}
@@ -250,7 +241,7 @@ void ScenePanel::Update()
 
 		// If the entity has a parent, convert local to world before manipulation
 		Mat4 worldMatrix;
-		if (transform.parent != MAX_ENTITIES) {
+		if (transform.parent != NO_ENTITY) {
 			// Convert local transform into matrix
 			ImGuizmo::RecomposeMatrixFromComponents(
 				&transform.localPosition.x,
@@ -288,7 +279,7 @@ void ScenePanel::Update()
 			Mat4 newWorldMatrix = Mat4(worldMatrixGuizmo);
 			Mat4 newLocalMatrix;
 
-			if (transform.parent != MAX_ENTITIES) {
+			if (transform.parent != NO_ENTITY) {
 				Mat4 parentInverse = ECSManager::GetInstance().GetComponent<Transform>(transform.parent).modelToWorldMtx.Inverse();
 				newLocalMatrix = parentInverse * newWorldMatrix;
 
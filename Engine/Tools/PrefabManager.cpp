@@ -22,6 +22,10 @@
 #include "../Engine/Components/ScriptComponent.hpp"
 #include "../Engine/Components/Animation.hpp"
 #include "../Engine/Components/AudioSource.hpp"
+#include "../Tools/Scripting/ScriptEngine.hpp"
+#include "../Utility/MetadataHandler.hpp"
+#include "../Utility/Serializer.hpp"
+#include "Logger.hpp"
 
 PrefabManager& PrefabManager::GetInstance()
 {
@@ -81,7 +85,14 @@ void PrefabManager::UpdatePrefab(const std::string& prefabID, const uint32_t& en
         // Renderer
         if (hasRenderer) {
             if (!ecs.HasComponent<Renderer>(entt)) {
-                ecs.AddComponent(entt, *sourceRenderer);
+                // The copy gets meshes of its own, so destroying either entity leaves the other's alone
+                Renderer renderer = *sourceRenderer;
+                bool initialized = renderer.isInitialized;
+                renderer.isInitialized = false;
+                ecs.AddComponent(entt, renderer);
+                if (initialized) {
+                    ecs.renderSystem->InitRenderer(entt, ecs.GetComponent<Renderer>(entt));
+                }
             } else {
                 auto& r = ecs.GetComponent<Renderer>(entt);
 
@@ -150,3 +161,94 @@ void PrefabManager::UnlinkPrefab(const std::string& prefabID, const uint32_t& en
 		}
 	}
 }
+
+const PrefabTemplate* PrefabManager::GetPrefabTemplate(const std::string& prefabPath) {
+	std::error_code error;
+	auto modified = std::filesystem::last_write_time(prefabPath, error);
+	if (error) {
+		Logger::Instance().Log(Logger::Level::ERR, "[PrefabManager] GetPrefabTemplate: Cannot read ", prefabPath);
+		prefabTemplates.erase(prefabPath);
+		return nullptr;
+	}
+
+	auto it = prefabTemplates.find(prefabPath);
+	if (it != prefabTemplates.end() && it->second.modified == modified) {
+		return &it->second;
+	}
+
+	PrefabTemplate prefab;
+	prefab.modified = modified;
+	if (!Serializer::GetInstance().BuildPrefabTemplate(prefabPath, prefab)) {
+		prefabTemplates.erase(prefabPath);
+		return nullptr;
+	}
+	if (!prefab.prefabID.empty()) {
+		prefabPaths[prefab.prefabID] = prefabPath;
+	}
+	return &(prefabTemplates[prefabPath] = std::move(prefab));
+}
+
+std::vector<uint32_t> PrefabManager::InstantiatePrefab(const std::string& prefabID, size_t count, const Transform* transforms) {
+	std::vector<uint32_t> entities;
+	std::string prefabPath = FindPrefabPath(prefabID);
+	const PrefabTemplate* prefab = prefabPath.empty() ? nullptr : GetPrefabTemplate(prefabPath);
+	if (!prefab) {
+		Logger::Instance().Log(Logger::Level::ERR, "[PrefabManager] InstantiatePrefab: Unknown prefab ", prefabID);
+		return entities;
+	}
+
+	auto& ecs = ECSManager::GetInstance();
+	entities.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		Entity entity = ecs.CreateEntity();
+		if (entity == NO_ENTITY) {
+			Logger::Instance().Log(Logger::Level::ERR, "[PrefabManager] InstantiatePrefab: Created ", i, " of ", count, " copies of ", prefabID);
+			break;
+		}
+		entities.push_back(entity);
+	}
+	Serializer::GetInstance().InstantiatePrefabTemplate(*prefab, entities.data(), entities.size(), transforms);
+
+	auto& prefabVec = prefabsMap[prefabID];
+	prefabVec.insert(prefabVec.end(), entities.begin(), entities.end());
+	return entities;
+}
+
+void PrefabManager::ClearPrefabTemplates() {
+	prefabTemplates.clear();
+}
+
+void PrefabManager::InvalidatePrefabPaths() {
+	prefabPaths.clear();
+	arePrefabPathsScanned = false;
+}
+
+std::string PrefabManager::FindPrefabPath(const std::string& prefabID) {
+	auto it = prefabPaths.find(prefabID);
+	if (it != prefabPaths.end()) {
+		if (std::filesystem::exists(it->second)) {
+			return it->second;
+		}
+		// The prefab was moved or deleted, so every path found before may be out of date
+		InvalidatePrefabPaths();
+	}
+	if (arePrefabPathsScanned) {
+		return std::string();
+	}
+
+	// Prefabs are not in MetadataHandler's UUID map, so their meta files are read here
+	std::error_code error;
+	for (auto const& entry : std::filesystem::recursive_directory_iterator("../Assets", error)) {
+		if (entry.is_regular_file() && entry.path().extension() == ".prefab") {
+			std::string path = entry.path().generic_string();
+			std::string uuid = MetadataHandler::ParseUUIDFromMeta(path + ".meta");
+			if (!uuid.empty()) {
+				prefabPaths[uuid] = path;
+			}
+		}
+	}
+	arePrefabPathsScanned = true;
+
+	it = prefabPaths.find(prefabID);
+	return it != prefabPaths.end() ? it->second : std::string();
+}
@@ -15,10 +15,34 @@
 #ifndef PREFAB_MANAGER
 #define PREFAB_MANAGER
 
+#include <filesystem>
 #include <unordered_map>
 #include <vector>
 #include <string>
 
+#include "../Utility/Reflection.hpp"
+
+struct Transform;
+struct ScriptFieldInstance;
+
+/**
+ * \struct PrefabTemplate
+ * \brief A prefab file parsed once, kept as the rows its instances are cloned from.
+ *
+ * Built by Serializer::BuildPrefabTemplate. Each component of the prefab is kept in the binary
+ * form of its field table, with its strings interned in the template's own string table.
+ */
+struct PrefabTemplate {
+	std::string path;
+	std::string prefabID;
+	std::filesystem::file_time_type modified{};		// Of the file when it was parsed, a newer file is parsed again
+
+	uint32_t components = 0;						// Bit per entry of the serializer's component table
+	std::vector<unsigned char> rows;				// The components of those bits, one after another
+	Reflection::StringTable strings;
+	std::vector<ScriptFieldInstance> scriptFields;	// Parameters of the script component, if there is one
+};
+
 class PrefabManager {
 public:
 	/**
@@ -50,7 +74,51 @@ public:
 	 */
 	void UnlinkPrefab(const std::string& prefabID, const uint32_t& entity);
 
+	/**
+	 * \brief Retrieves the parsed template of a prefab file, parsing it if it is not cached or was modified since.
+	 *
+	 * \param prefabPath The path of the prefab file.
+	 * \return The template, or nullptr if the file cannot be read. Valid until the next call for the same path.
+	 */
+	const PrefabTemplate* GetPrefabTemplate(const std::string& prefabPath);
+
+	/**
+	 * \brief Creates copies of a prefab, cloning the components of its cached template into the ECS together.
+	 *
+	 * Each copy is linked to the prefab in prefabsMap. As with Serializer::DeserializePrefab, meshes
+	 * are left for the render system to create.
+	 *
+	 * \param prefabID The UUID of the prefab, from the meta file beside it.
+	 * \param count The number of copies.
+	 * \param transforms Position, scale and rotation of each copy, or nullptr to keep the prefab's.
+	 * \return The new entities, empty if the prefab cannot be found.
+	 */
+	std::vector<uint32_t> InstantiatePrefab(const std::string& prefabID, size_t count, const Transform* transforms = nullptr);
+
+	/**
+	 * \brief Drops every cached template, so each prefab is parsed again the next time it is used.
+	 */
+	void ClearPrefabTemplates();
+
+	/**
+	 * \brief Forgets where every prefab is, so the assets are scanned again the next time a prefab is looked up.
+	 *
+	 * Called when a prefab file is created, since its UUID is not known until the assets are scanned.
+	 */
+	void InvalidatePrefabPaths();
+
 	std::unordered_map<std::string, std::vector<uint32_t>> prefabsMap;
+
+private:
+	/**
+	 * \brief Finds the file of a prefab from its UUID. The assets are scanned once, then again only
+	 *        after InvalidatePrefabPaths or when a prefab found before has since been moved or deleted.
+	 */
+	std::string FindPrefabPath(const std::string& prefabID);
+
+	std::unordered_map<std::string, PrefabTemplate> prefabTemplates;	// By path
+	std::unordered_map<std::string, std::string> prefabPaths;			// UUID to path
+	bool arePrefabPathsScanned = false;									// An unknown UUID is not scanned for again until this is cleared
 };
 
 
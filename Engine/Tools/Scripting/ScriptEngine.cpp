@@ -18,6 +18,7 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "../../Application.hpp"
 
 #include "../../Components/ScriptComponent.hpp"
+#include "../../Utility/Profiler.hpp"
 
 
 #include "mono/include/mono/jit/jit.h"
@@ -359,8 +360,8 @@ void ScriptEngine::ReloadAssembly() {
 
 	//reinstantiate all entity with script component
 	ScriptEngine::PopulateEntityInstance();
-	auto view = ECSManager::GetInstance().GetEntityManager();
-	for (Entity i{}; i < view.GetEntities(); i++) {
+	auto view = ECSManager::GetInstance().GetEntityManager().GetLivingEntities();
+	for (Entity i : view) {
 		if (ECSManager::GetInstance().HasComponent<ScriptComponent>(i))
 			ScriptEngine::OnCreateEntity(i);
 	}
@@ -466,10 +467,11 @@ MonoImage* ScriptEngine::GetCoreAssemblyImage()
 
 MonoObject* ScriptEngine::GetManagedInstance(Entity id)
 {
-	if (s_Data->EntityInstances.find(id) == s_Data->EntityInstances.end())
+	auto it = s_Data->EntityInstances.find(id);
+	if (it == s_Data->EntityInstances.end())
 		return nullptr;
 
-	return s_Data->EntityInstances.at(id)->GetManagedObject();
+	return it->second->GetManagedObject();
 }
 
 void ScriptEngine::OnRuntimeStart(ECSManager* scene,
@@ -518,8 +520,9 @@ bool ScriptEngine::EntityClassExists(const std::string& fullClassName)
 
 void ScriptEngine::PopulateEntityInstance()
 {
-	auto view = ECSManager::GetInstance().GetEntityManager();
-	for (Entity i{}; i < view.GetEntities(); i++) {
+	PROFILE_SCOPE("ScriptEngine::PopulateEntityInstance");
+	auto view = ECSManager::GetInstance().GetEntityManager().GetLivingEntities();
+	for (Entity i : view) {
 		if (ECSManager::GetInstance().HasComponent<ScriptComponent>(i)) {
 			auto& sc = s_Data->SceneContext->GetComponent<ScriptComponent>(i); //should be const
 
@@ -547,7 +550,7 @@ void ScriptEngine::PopulateEntityInstance()
 
 void ScriptEngine::OnCreateEntity(Entity entity)
 {
-
+	PROFILE_SCOPE("ScriptEngine::OnCreateEntity");
 	auto& sc = s_Data->SceneContext->GetComponent<ScriptComponent>(entity); //should be const
 		
 	if (ScriptEngine::EntityClassExists(sc.className))
@@ -577,74 +580,81 @@ void ScriptEngine::OnCreateEntity(Entity entity)
 }
 
 void ScriptEngine::OnStartEntity(Entity entity) {
-	if (s_Data->EntityInstances.find(entity) != s_Data->EntityInstances.end())
+	PROFILE_SCOPE("ScriptEngine::OnStartEntity");
+	auto it = s_Data->EntityInstances.find(entity);
+	if (it != s_Data->EntityInstances.end())
 	{
-		std::shared_ptr<ScriptInstance> instance = s_Data->EntityInstances[entity];
-		instance->InvokeOnCreate();
+		it->second->InvokeOnCreate();
 	}
 }
 
 void ScriptEngine::OnUpdateEntity(Entity entity, float dt)
 {
-
-	if (s_Data->EntityInstances.find(entity) != s_Data->EntityInstances.end())
+	PROFILE_SCOPE("ScriptEngine::OnUpdateEntity");
+	auto it = s_Data->EntityInstances.find(entity);
+	if (it != s_Data->EntityInstances.end())
 	{
-		std::shared_ptr<ScriptInstance> instance = s_Data->EntityInstances[entity];
-		instance->InvokeOnUpdate(dt);
+		it->second->InvokeOnUpdate(dt);
 	}
 }
 
 void ScriptEngine::OnEntityCollisionEnter(Entity entity, CollisionCS collision)
 {
-	if (s_Data->EntityInstances.find(entity) != s_Data->EntityInstances.end())
+	PROFILE_SCOPE("ScriptEngine::OnEntityCollisionEnter");
+	auto it = s_Data->EntityInstances.find(entity);
+	if (it != s_Data->EntityInstances.end())
 	{
-		std::shared_ptr<ScriptInstance> instance = s_Data->EntityInstances[entity];
-		instance->InvokeOnCollisionEnter(collision);
+		it->second->InvokeOnCollisionEnter(collision);
 	}
 }
 
 void ScriptEngine::OnEntityCollisionStay(Entity entity, CollisionCS collision)
 {
-	if (s_Data->EntityInstances.find(entity) != s_Data->EntityInstances.end())
+	PROFILE_SCOPE("ScriptEngine::OnEntityCollisionStay");
+	auto it = s_Data->EntityInstances.find(entity);
+	if (it != s_Data->EntityInstances.end())
 	{
-		std::shared_ptr<ScriptInstance> instance = s_Data->EntityInstances[entity];
-		instance->InvokeOnCollisionStay(collision);
+		it->second->InvokeOnCollisionStay(collision);
 	}
 }
 
 void ScriptEngine::OnEntityCollisionExit(Entity entity, CollisionCS collision)
 {
-	if (s_Data->EntityInstances.find(entity) != s_Data->EntityInstances.end())
+	PROFILE_SCOPE("ScriptEngine::OnEntityCollisionExit");
+	auto it = s_Data->EntityInstances.find(entity);
+	if (it != s_Data->EntityInstances.end())
 	{
-		std::shared_ptr<ScriptInstance> instance = s_Data->EntityInstances[entity];
-		instance->InvokeOnCollisionExit(collision);
+		it->second->InvokeOnCollisionExit(collision);
 	}
 }
 
 void ScriptEngine::OnEntityTriggerEnter(Entity entity, ColliderCS collider)
 {
-	if (s_Data->EntityInstances.find(entity) != s_Data->EntityInstances.end())
+	PROFILE_SCOPE("ScriptEngine::OnEntityTriggerEnter");
+	auto it = s_Data->EntityInstances.find(entity);
+	if (it != s_Data->EntityInstances.end())
 	{
-		std::shared_ptr<ScriptInstance> instance = s_Data->EntityInstances[entity];
-		instance->InvokeOnTriggerEnter(collider);
+		it->second->InvokeOnTriggerEnter(collider);
 	}
 }
 
 void ScriptEngine::OnEntityTriggerStay(Entity entity, ColliderCS collider)
 {
-	if (s_Data->EntityInstances.find(entity) != s_Data->EntityInstances.end())
+	PROFILE_SCOPE("ScriptEngine::OnEntityTriggerStay");
+	auto it = s_Data->EntityInstances.find(entity);
+	if (it != s_Data->EntityInstances.end())
 	{
-		std::shared_ptr<ScriptInstance> instance = s_Data->EntityInstances[entity];
-		instance->InvokeOnTriggerStay(collider);
+		it->second->InvokeOnTriggerStay(collider);
 	}
 }
 
 void ScriptEngine::OnEntityTriggerExit(Entity entity, ColliderCS collider)
 {
-	if (s_Data->EntityInstances.find(entity) != s_Data->EntityInstances.end())
+	PROFILE_SCOPE("ScriptEngine::OnEntityTriggerExit");
+	auto it = s_Data->EntityInstances.find(entity);
+	if (it != s_Data->EntityInstances.end())
 	{
-		std::shared_ptr<ScriptInstance> instance = s_Data->EntityInstances[entity];
-		instance->InvokeOnTriggerExit(collider);
+		it->second->InvokeOnTriggerExit(collider);
 	}
 }
 
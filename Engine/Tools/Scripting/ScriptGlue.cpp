@@ -140,7 +140,7 @@ static bool Entity_GetActive(Entity id) {
  * @param b The new active state. Pass `true` to activate the entity or `false` to deactivate it.
  */
 static void Entity_SetActive(Entity id, bool b) {
-	ECSManager::GetInstance().GetEntityManager().SetActive(id,b);
+	ECSManager::GetInstance().SetActive(id,b);
 	ECSManager::GetInstance().renderSystem->SetVisibility(id, b);
 }
 
@@ -184,8 +184,8 @@ static uint32_t Entity_FindEntityByName(MonoString* name)
 
 	mono_free(nameCStr);
 	// find out the names of entities
-	auto view = ECSManager::GetInstance().GetEntityManager();
-	for (Entity i{}; i < view.GetEntities(); i++) {
+	auto view = ECSManager::GetInstance().GetEntityManager().GetLivingEntities();
+	for (Entity i : view) {
 		const auto& enttName = ECSManager::GetInstance().TryGetComponent<Name>(i);
 		if (enttName.has_value() && enttName->get().name == cname) {
 			return i;
@@ -198,8 +198,8 @@ static uint32_t Entity_FindEntityByName(MonoString* name)
 static uint32_t Entity_FindEntityByID(uint32_t transformID)
 {
 	// find out the uuid of the transform component of the Entity
-	auto view = ECSManager::GetInstance().GetEntityManager();
-	for (Entity i{}; i < view.GetEntities(); i++) {
+	auto view = ECSManager::GetInstance().GetEntityManager().GetLivingEntities();
+	for (Entity i : view) {
 		const auto& entTrans = ECSManager::GetInstance().TryGetComponent<Transform>(i);
 		if (entTrans.has_value() && entTrans->get().uuid == transformID) {
 			return i;
@@ -1393,8 +1393,8 @@ static void RegisterComponent(ComponentGroup<Component...>)
 uint32_t ScriptGlue::FindEntityID(uint32_t transformID)
 {
 	// find out the uuid of the transform component of the Entity
-	auto view = ECSManager::GetInstance().GetEntityManager();
-	for (Entity i{}; i < view.GetEntities(); i++) {
+	auto view = ECSManager::GetInstance().GetEntityManager().GetLivingEntities();
+	for (Entity i : view) {
 		const auto& entTrans = ECSManager::GetInstance().TryGetComponent<Transform>(i);
 		if (entTrans.has_value() && entTrans->get().uuid == transformID) {
 			return i;
@@ -0,0 +1,648 @@
+/*********************************************************************
+ * \file		CookedScene.cpp
+ * \brief		Defines the binary form scenes are cooked into from
+ *				their JSON, and the reader that validates a cooked
+ *				scene and reads it in place from a mapped file.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include "CookedScene.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "JSONParser.hpp"
+#include "../Components/Name.hpp"
+#include "../Components/Transform.hpp"
+#include "../Components/Renderer.hpp"
+#include "../Components/Collider2D.hpp"
+#include "../Components/Rigidbody2D.hpp"
+#include "../Components/Animation.hpp"
+#include "../Components/AudioSource.hpp"
+#include "../Components/ScriptComponent.hpp"
+#include "../Components/UI.hpp"
+#include "../Components/Textbox.hpp"
+#include "../Components/VideoPlayer.hpp"
+#include "../Components/Camera.hpp"
+#include "../Tools/Scripting/ScriptEngine.hpp"
+
+namespace {
+	static_assert(sizeof(CookedScene::FileHeader) == 40);
+	static_assert(sizeof(CookedScene::SectionEntry) == 24);
+	static_assert(sizeof(CookedScene::EntityRecord) == 8);
+	static_assert(sizeof(CookedScene::ScriptFieldRecord) == 16);
+	static_assert(CookedScene::MAX_SECTIONS <= 32, "Component bits must fit EntityRecord::components");
+
+	/**
+	 * \struct ComponentSection
+	 * \brief A component cooked into a section, under its key in the "Components" object of an entity.
+	 */
+	struct ComponentSection {
+		CookedScene::SectionID section;
+		char const* key;
+		Reflection::FieldTable const& (*fields)();
+		void (*cook)(rapidjson::Value const& value, unsigned char* row, Reflection::StringTable& strings);
+	};
+
+	template<typename T>
+	void CookComponent(rapidjson::Value const& value, unsigned char* row, Reflection::StringTable& strings) {
+		T component;
+		Reflection::ReadJSON(component, value);
+		Reflection::WriteBinary(component, row, strings);
+	}
+
+	// In section order. Script parameters are cooked into their own section beside the script component.
+	const ComponentSection COMPONENT_SECTIONS[] = {
+		{ CookedScene::SECTION_NAME, "Name", Name::Fields, CookComponent<Name> },
+		{ CookedScene::SECTION_TRANSFORM, "Transform", Transform::Fields, CookComponent<Transform> },
+		{ CookedScene::SECTION_RENDERER, "Renderer", Renderer::Fields, CookComponent<Renderer> },
+		{ CookedScene::SECTION_AABB_COLLIDER, "AABBCollider2D", AABBCollider2D::Fields, CookComponent<AABBCollider2D> },
+		{ CookedScene::SECTION_RIGIDBODY, "Rigidbody2D", Rigidbody2D::Fields, CookComponent<Rigidbody2D> },
+		{ CookedScene::SECTION_ANIMATION, "Animation", Animation::Fields, CookComponent<Animation> },
+		{ CookedScene::SECTION_AUDIO_SOURCE, "AudioSource", AudioSource::Fields, CookComponent<AudioSource> },
+		{ CookedScene::SECTION_SCRIPT, "ScriptComponent", ScriptComponent::Fields, CookComponent<ScriptComponent> },
+		{ CookedScene::SECTION_UI, "UI", UI::Fields, CookComponent<UI> },
+		{ CookedScene::SECTION_VIDEO_PLAYER, "VideoPlayer", VideoPlayer::Fields, CookComponent<VideoPlayer> },
+		{ CookedScene::SECTION_TEXTBOX, "Textbox", Textbox::Fields, CookComponent<Textbox> },
+		{ CookedScene::SECTION_CAMERA, "Camera", Camera::Fields, CookComponent<Camera> }
+	};
+
+	bool HasEntityColumn(uint32_t section) {
+		return section >= CookedScene::SECTION_NAME && section < CookedScene::SECTION_COLLISION_MATRIX;
+	}
+
+	/**
+	 * \brief Bytes of each row of a section, 0 for the sections that are not rows.
+	 */
+	size_t GetRowSize(uint32_t section) {
+		if (section == CookedScene::SECTION_ENTITIES) return sizeof(CookedScene::EntityRecord);
+		if (section == CookedScene::SECTION_SCRIPT_FIELDS) return sizeof(CookedScene::ScriptFieldRecord);
+		if (section == CookedScene::SECTION_COLLISION_MATRIX) return 1;
+		Reflection::FieldTable const* fields = CookedScene::GetFields(section);
+		return fields ? fields->GetBinarySize() : 0;
+	}
+
+	uint64_t AlignUp(uint64_t value) {
+		return (value + 7u) & ~uint64_t{ 7u };
+	}
+
+	/**
+	 * \brief The string table as it is written: the offset of every string and the end of the last, then the characters.
+	 */
+	std::vector<unsigned char> WriteStrings(Reflection::StringTable const& strings) {
+		std::vector<uint32_t> offsets{ 0 };
+		std::string chars;
+		for (uint32_t i = 0; i < strings.GetCount(); ++i) {
+			chars += strings.Get(i);
+			offsets.push_back(static_cast<uint32_t>(chars.size()));
+		}
+		std::vector<unsigned char> bytes(offsets.size() * sizeof(uint32_t) + chars.size());
+		std::memcpy(bytes.data(), offsets.data(), offsets.size() * sizeof(uint32_t));
+		std::memcpy(bytes.data() + offsets.size() * sizeof(uint32_t), chars.data(), chars.size());
+		return bytes;
+	}
+
+	/**
+	 * \struct SectionBuilder
+	 * \brief A section of the scene being cooked: the entity column, if it has one, and the rows.
+	 */
+	struct SectionBuilder {
+		std::vector<uint32_t> entities;
+		std::vector<unsigned char> rows;
+		uint32_t count = 0;
+
+		unsigned char* AddRow(uint32_t entity, size_t size) {
+			entities.push_back(entity);
+			return AddRow(size);
+		}
+
+		unsigned char* AddRow(size_t size) {
+			size_t offset = rows.size();
+			rows.resize(offset + size);
+			++count;
+			return rows.data() + offset;
+		}
+
+		template<typename Record>
+		void Add(Record const& record) {
+			std::memcpy(AddRow(sizeof(Record)), &record, sizeof(Record));
+		}
+
+		template<typename Record>
+		void Add(uint32_t entity, Record const& record) {
+			std::memcpy(AddRow(entity, sizeof(Record)), &record, sizeof(Record));
+		}
+
+		std::vector<unsigned char> Write() const {
+			if (entities.empty()) {
+				return rows;
+			}
+			std::vector<unsigned char> bytes(CookedScene::GetRowsOffset(count) + rows.size(), 0);
+			std::memcpy(bytes.data(), entities.data(), entities.size() * sizeof(uint32_t));
+			std::memcpy(bytes.data() + CookedScene::GetRowsOffset(count), rows.data(), rows.size());
+			return bytes;
+		}
+	};
+
+	/**
+	 * \brief Returns a field the JSON loader reads without checking, throwing if it is missing or of the wrong type.
+	 */
+	rapidjson::Value const& Require(rapidjson::Value const& value, char const* field, bool (rapidjson::Value::*isType)() const, char const* type) {
+		if (!value.IsObject() || !value.HasMember(field)) {
+			throw std::runtime_error(std::string("missing field ") + field);
+		}
+		rapidjson::Value const& member = value[field];
+		if (!(member.*isType)()) {
+			throw std::runtime_error(std::string("field ") + field + " is not " + type);
+		}
+		return member;
+	}
+
+	template<typename T>
+	uint64_t ToBits(T value) {
+		static_assert(sizeof(T) <= sizeof(uint64_t));
+		uint64_t bits = 0;
+		std::memcpy(&bits, &value, sizeof(T));
+		return bits;
+	}
+
+	/**
+	 * \brief Cooks a script's fields as DeserializeScriptComponent reads them, in the order it stores them.
+	 */
+	void CookScriptFields(rapidjson::Value const& value, uint32_t index, Reflection::StringTable& strings, SectionBuilder& fields) {
+		if (!value.HasMember("parameters") || !value["parameters"].IsObject()) {
+			return;
+		}
+
+		for (auto it = value["parameters"].MemberBegin(); it != value["parameters"].MemberEnd(); ++it) {
+			rapidjson::Value const& parameter = it->value;
+			if (!parameter.IsObject() || !parameter.HasMember("type") || !parameter.HasMember("value")) {
+				continue;
+			}
+
+			CookedScene::ScriptFieldRecord field{};
+			field.name = strings.Intern(it->name.GetString());
+
+			ScriptFieldType type = Utils::ScriptFieldTypeFromString(Require(parameter, "type", &rapidjson::Value::IsString, "a string").GetString());
+			switch (type) {
+			case ScriptFieldType::Float:
+				field.value = ToBits(Require(parameter, "value", &rapidjson::Value::IsNumber, "a number").GetFloat());
+				break;
+			case ScriptFieldType::Double:
+				field.value = ToBits(Require(parameter, "value", &rapidjson::Value::IsNumber, "a number").GetDouble());
+				break;
+			case ScriptFieldType::Bool:
+				field.value = ToBits(Require(parameter, "value", &rapidjson::Value::IsBool, "a bool").GetBool());
+				break;
+			case ScriptFieldType::Short:
+				field.value = ToBits<int64_t>(Require(parameter, "value", &rapidjson::Value::IsInt, "an int").GetInt());
+				break;
+			case ScriptFieldType::Int:
+				field.value = ToBits(Require(parameter, "value", &rapidjson::Value::IsInt, "an int").GetInt());
+				break;
+			case ScriptFieldType::Long:
+				field.value = ToBits(Require(parameter, "value", &rapidjson::Value::IsInt64, "an int").GetInt64());
+				break;
+			case ScriptFieldType::UShort:
+				field.value = ToBits(static_cast<uint16_t>(Require(parameter, "value", &rapidjson::Value::IsUint, "an unsigned int").GetUint()));
+				break;
+			case ScriptFieldType::UInt:
+			case ScriptFieldType::Entity:
+				field.value = ToBits(Require(parameter, "value", &rapidjson::Value::IsUint, "an unsigned int").GetUint());
+				break;
+			case ScriptFieldType::ULong:
+				field.value = ToBits(Require(parameter, "value", &rapidjson::Value::IsUint64, "an unsigned int").GetUint64());
+				break;
+			default:
+				// The JSON loader stores a default field for types it does not read
+				type = ScriptFieldType::None;
+				break;
+			}
+
+			field.type = static_cast<uint32_t>(type);
+			fields.Add(index, field);
+		}
+	}
+
+	/**
+	 * \brief Cooks one entity of the JSON, reading each component with the field table the JSON loader reads it with.
+	 */
+	void CookEntity(rapidjson::Value const& entityData, uint32_t index, Reflection::StringTable& strings, SectionBuilder (&sections)[CookedScene::MAX_SECTIONS]) {
+		if (!entityData.IsObject()) {
+			throw std::runtime_error("entity is not an object");
+		}
+		CookedScene::EntityRecord entity{};
+		entity.isActive = JSONDeserializer::JSONToBool(entityData, "Active");
+		if (entityData.HasMember("Layer")) {
+			entity.hasLayer = 1;
+			entity.layer = static_cast<uint8_t>(Require(entityData, "Layer", &rapidjson::Value::IsInt, "an int").GetInt());
+		}
+
+		auto components = entityData.FindMember("Components");
+		if (components != entityData.MemberEnd() && components->value.IsObject()) {
+			for (ComponentSection const& component : COMPONENT_SECTIONS) {
+				auto member = components->value.FindMember(component.key);
+				if (member == components->value.MemberEnd()) {
+					continue;
+				}
+				if (!member->value.IsObject()) {
+					throw std::runtime_error(std::string(component.key) + " is not an object");
+				}
+				try {
+					component.cook(member->value, sections[component.section].AddRow(index, component.fields().GetBinarySize()), strings);
+				}
+				catch (std::exception const& exception) {
+					throw std::runtime_error(std::string(component.key) + ": " + exception.what());
+				}
+				if (component.section == CookedScene::SECTION_SCRIPT) {
+					CookScriptFields(member->value, index, strings, sections[CookedScene::SECTION_SCRIPT_FIELDS]);
+				}
+				entity.components |= 1u << component.section;
+			}
+		}
+		sections[CookedScene::SECTION_ENTITIES].Add(entity);
+	}
+
+	/**
+	 * \brief Cooks the collision matrix. Entries missing from the JSON read as false, as they do in the JSON loader.
+	 */
+	void CookCollisionMatrix(rapidjson::Value const& matrix, SectionBuilder& section) {
+		std::vector<uint8_t> entries;
+		for (auto it = matrix.MemberBegin(); it != matrix.MemberEnd(); ++it) {
+			char const* name = it->name.GetString();
+			char* end = nullptr;
+			unsigned long index = std::strtoul(name, &end, 10);
+			if (end == name || *end != '\0' || index >= (1u << 16)) {
+				continue;
+			}
+			if (entries.size() <= index) {
+				entries.resize(index + 1, 0);
+			}
+			entries[index] = JSONDeserializer::JSONToBool(matrix, name);
+		}
+		for (uint8_t entry : entries) {
+			section.Add(entry);
+		}
+	}
+}
+
+bool CookedScene::Cook(std::string const& scenePath, std::string const& cookedPath, std::string& error) {
+	std::vector<unsigned char> file;
+	if (!Cook(scenePath, file, error)) {
+		return false;
+	}
+
+	// Written beside the target and renamed over it, so a failed cook never leaves half a scene behind
+	std::string temporaryPath = cookedPath + ".tmp";
+	{
+		std::ofstream ofs(temporaryPath, std::ios::binary | std::ios::trunc);
+		ofs.write(reinterpret_cast<char const*>(file.data()), static_cast<std::streamsize>(file.size()));
+		if (!ofs) {
+			error = "Cannot write " + temporaryPath;
+			return false;
+		}
+	}
+	std::error_code errorCode;
+	std::filesystem::rename(temporaryPath, cookedPath, errorCode);
+	if (errorCode) {
+		std::filesystem::remove(temporaryPath, errorCode);
+		error = "Cannot write " + cookedPath;
+		return false;
+	}
+	return true;
+}
+
+bool CookedScene::Cook(std::string const& scenePath, std::vector<unsigned char>& file, std::string& error, Progress const& progress) {
+	std::ifstream ifs(scenePath);
+	if (!ifs.is_open()) {
+		error = "Cannot open " + scenePath;
+		return false;
+	}
+	std::string jsonContent((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+	rapidjson::Document document;
+	document.Parse(jsonContent.c_str());
+	if (document.HasParseError() || !document.IsObject() || !document.HasMember("Entities") || !document["Entities"].IsArray()) {
+		error = scenePath + " is not a scene";
+		return false;
+	}
+
+	Reflection::StringTable strings;
+	SectionBuilder sections[MAX_SECTIONS];
+	rapidjson::Value const& entities = document["Entities"];
+	for (rapidjson::SizeType i = 0; i < entities.Size(); ++i) {
+		try {
+			CookEntity(entities[i], i, strings, sections);
+		}
+		catch (std::exception const& exception) {
+			error = "Entity " + std::to_string(i) + " of " + scenePath + ": " + exception.what();
+			return false;
+		}
+		if (progress) {
+			progress(i + 1, entities.Size());
+		}
+	}
+
+	bool hasCollisionMatrix = document.HasMember("Collision Matrix") && document["Collision Matrix"].IsObject();
+	if (hasCollisionMatrix) {
+		try {
+			CookCollisionMatrix(document["Collision Matrix"], sections[SECTION_COLLISION_MATRIX]);
+		}
+		catch (std::exception const& exception) {
+			error = "Collision matrix of " + scenePath + ": " + exception.what();
+			return false;
+		}
+	}
+
+	// Every section but the empty component sections, in section order
+	std::vector<std::pair<SectionEntry, std::vector<unsigned char>>> written;
+	written.push_back({ SectionEntry{ SECTION_STRINGS, static_cast<uint32_t>(strings.GetCount()), 0, 0 }, WriteStrings(strings) });
+	for (uint32_t section = SECTION_ENTITIES; section < MAX_SECTIONS; ++section) {
+		bool isRequired = section == SECTION_ENTITIES || (section == SECTION_COLLISION_MATRIX && hasCollisionMatrix);
+		if (sections[section].count > 0 || isRequired) {
+			written.push_back({ SectionEntry{ section, sections[section].count, 0, 0 }, sections[section].Write() });
+		}
+	}
+
+	uint64_t offset = AlignUp(sizeof(FileHeader) + written.size() * sizeof(SectionEntry));
+	for (auto& [entry, bytes] : written) {
+		entry.offset = offset;
+		entry.size = bytes.size();
+		offset = AlignUp(offset + bytes.size());
+	}
+
+	file.assign(offset, 0);
+	FileHeader header{};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.fileSize = file.size();
+	header.layout = GetLayoutHash();
+	header.entityCount = entities.Size();
+	header.sectionCount = static_cast<uint32_t>(written.size());
+	for (size_t i = 0; i < written.size(); ++i) {
+		std::memcpy(file.data() + sizeof(FileHeader) + i * sizeof(SectionEntry), &written[i].first, sizeof(SectionEntry));
+		if (!written[i].second.empty()) {
+			std::memcpy(file.data() + written[i].first.offset, written[i].second.data(), written[i].second.size());
+		}
+	}
+	header.checksum = Checksum(file.data() + sizeof(FileHeader), file.size() - sizeof(FileHeader));
+	std::memcpy(file.data(), &header, sizeof(FileHeader));
+	return true;
+}
+
+bool CookedScene::IsCookedPath(std::string const& path) {
+	return std::filesystem::path(path).extension() == EXTENSION;
+}
+
+std::string CookedScene::GetCookedPath(std::string const& scenePath) {
+	return std::filesystem::path(scenePath).replace_extension(EXTENSION).string();
+}
+
+bool CookedScene::IsUpToDate(std::string const& scenePath, std::string const& cookedPath) {
+	std::error_code errorCode;
+	auto cookedTime = std::filesystem::last_write_time(cookedPath, errorCode);
+	if (errorCode) {
+		return false;
+	}
+	auto sceneTime = std::filesystem::last_write_time(scenePath, errorCode);
+	return errorCode || cookedTime >= sceneTime;
+}
+
+std::string CookedScene::FindLoadablePath(std::string const& scenePath) {
+	if (IsCookedPath(scenePath)) {
+		return scenePath;
+	}
+#ifdef INSTALLER
+	// The player ships scenes cooked beside their JSON
+	std::string cookedPath = GetCookedPath(scenePath);
+	if (IsUpToDate(scenePath, cookedPath)) {
+		return cookedPath;
+	}
+#endif
+	return std::string();
+}
+
+bool CookedScene::Open(std::string const& cookedPath, std::string& error) {
+	Close();
+	if (!m_file.Open(cookedPath)) {
+		error = "Cannot map " + cookedPath;
+		return false;
+	}
+	m_data = m_file.GetData();
+	m_size = m_file.GetSize();
+	if (!Validate(error)) {
+		error = cookedPath + ": " + error;
+		Close();
+		return false;
+	}
+	return true;
+}
+
+bool CookedScene::Open(std::vector<unsigned char>&& cooked, std::string& error) {
+	Close();
+	m_memory = std::move(cooked);
+	m_data = m_memory.data();
+	m_size = m_memory.size();
+	if (!Validate(error)) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void CookedScene::Close() {
+	m_file.Close();
+	m_memory.clear();
+	m_data = nullptr;
+	m_size = 0;
+	std::fill(std::begin(m_sections), std::end(m_sections), nullptr);
+	m_entities = nullptr;
+	m_entityCount = 0;
+	m_strings.Clear();
+}
+
+CookedScene::Column CookedScene::GetColumn(SectionID section) const {
+	Column column;
+	SectionEntry const* entry = HasEntityColumn(section) ? m_sections[section] : nullptr;
+	if (entry) {
+		unsigned char const* data = m_data + entry->offset;
+		column.entities = reinterpret_cast<uint32_t const*>(data);
+		column.rows = data + GetRowsOffset(entry->count);
+		column.stride = GetRowSize(section);
+		column.count = entry->count;
+	}
+	return column;
+}
+
+uint8_t const* CookedScene::GetCollisionMatrix(uint32_t& count) const {
+	SectionEntry const* section = m_sections[SECTION_COLLISION_MATRIX];
+	count = section ? section->count : 0;
+	return section ? m_data + section->offset : nullptr;
+}
+
+Reflection::FieldTable const* CookedScene::GetFields(uint32_t section) {
+	for (ComponentSection const& component : COMPONENT_SECTIONS) {
+		if (component.section == section) {
+			return &component.fields();
+		}
+	}
+	return nullptr;
+}
+
+uint64_t CookedScene::GetLayoutHash() {
+	static uint64_t const hash = [] {
+		// Every field in the order WriteBinary writes it: the plain values by offset, then the strings
+		std::string layout;
+		for (ComponentSection const& component : COMPONENT_SECTIONS) {
+			std::vector<Reflection::FieldDescriptor> fields = component.fields().GetFields();
+			auto strings = std::stable_partition(fields.begin(), fields.end(),
+				[](Reflection::FieldDescriptor const& field) { return field.type != Reflection::FieldType::STRING; });
+			std::sort(fields.begin(), strings,
+				[](Reflection::FieldDescriptor const& a, Reflection::FieldDescriptor const& b) { return a.offset < b.offset; });
+
+			layout += std::to_string(component.section) + component.key + '{';
+			for (Reflection::FieldDescriptor const& field : fields) {
+				layout += std::string(field.name) + ':' + std::to_string(static_cast<int>(field.type)) + ':' + std::to_string(field.size) + ';';
+			}
+			layout += '}';
+		}
+		return Checksum(reinterpret_cast<unsigned char const*>(layout.data()), layout.size());
+	}();
+	return hash;
+}
+
+uint64_t CookedScene::Checksum(unsigned char const* data, size_t size) {
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for (size_t i = 0; i < size; ++i) {
+		hash = (hash ^ data[i]) * 0x100000001b3ull;
+	}
+	return hash;
+}
+
+bool CookedScene::Validate(std::string& error) {
+	unsigned char const* data = m_data;
+	size_t size = m_size;
+
+	FileHeader header{};
+	if (!data || size < sizeof(FileHeader)) {
+		error = "file is too small";
+		return false;
+	}
+	std::memcpy(&header, data, sizeof(FileHeader));
+	if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+		error = "not a cooked scene";
+		return false;
+	}
+	if (header.version != VERSION) {
+		error = "cooked with version " + std::to_string(header.version) + ", expected " + std::to_string(VERSION);
+		return false;
+	}
+	if (header.layout != GetLayoutHash()) {
+		error = "cooked before the component fields changed";
+		return false;
+	}
+	if (header.fileSize != size || header.sectionCount > MAX_SECTIONS ||
+		sizeof(FileHeader) + static_cast<uint64_t>(header.sectionCount) * sizeof(SectionEntry) > size) {
+		error = "file is truncated";
+		return false;
+	}
+	if (header.checksum != Checksum(data + sizeof(FileHeader), size - sizeof(FileHeader))) {
+		error = "checksum does not match";
+		return false;
+	}
+
+	auto const* entries = reinterpret_cast<SectionEntry const*>(data + sizeof(FileHeader));
+	for (uint32_t i = 0; i < header.sectionCount; ++i) {
+		SectionEntry const& entry = entries[i];
+		if (entry.id >= MAX_SECTIONS || m_sections[entry.id] || entry.offset % 8 != 0 ||
+			entry.offset > size || entry.size > size - entry.offset) {
+			error = "section " + std::to_string(i) + " is out of bounds or repeated";
+			return false;
+		}
+		uint64_t expected = static_cast<uint64_t>(entry.count) * GetRowSize(entry.id);
+		if (HasEntityColumn(entry.id)) {
+			expected += GetRowsOffset(entry.count);
+		}
+		if (entry.id != SECTION_STRINGS && entry.size != expected) {
+			error = "section " + std::to_string(entry.id) + " has the wrong size";
+			return false;
+		}
+		m_sections[entry.id] = &entry;
+	}
+
+	SectionEntry const* strings = m_sections[SECTION_STRINGS];
+	SectionEntry const* entities = m_sections[SECTION_ENTITIES];
+	if (!strings || !entities || entities->count != header.entityCount) {
+		error = "string table or entities are missing";
+		return false;
+	}
+
+	// String table: the offsets of every string and the end of the last, then the characters
+	if (strings->size < (static_cast<uint64_t>(strings->count) + 1) * sizeof(uint32_t)) {
+		error = "string table is truncated";
+		return false;
+	}
+	auto const* stringOffsets = reinterpret_cast<uint32_t const*>(data + strings->offset);
+	auto const* stringChars = reinterpret_cast<char const*>(stringOffsets + strings->count + 1);
+	uint64_t charCount = strings->size - (static_cast<uint64_t>(strings->count) + 1) * sizeof(uint32_t);
+	for (uint32_t i = 0; i < strings->count; ++i) {
+		if (stringOffsets[i] > stringOffsets[i + 1] || stringOffsets[i + 1] > charCount) {
+			error = "string table is corrupt";
+			return false;
+		}
+		// Rows refer to strings by their index, so every string must be new to keep its own
+		if (m_strings.Intern(std::string_view(stringChars + stringOffsets[i], stringOffsets[i + 1] - stringOffsets[i])) != i) {
+			error = "string table repeats a string";
+			return false;
+		}
+	}
+
+	m_entities = reinterpret_cast<EntityRecord const*>(data + entities->offset);
+	m_entityCount = entities->count;
+
+	// Each component column must list exactly the entities whose bit is set, in order
+	for (ComponentSection const& component : COMPONENT_SECTIONS) {
+		Column column = GetColumn(component.section);
+		uint32_t next = 0;
+		for (uint32_t entity = 0; entity < m_entityCount; ++entity) {
+			if (!(m_entities[entity].components & (1u << component.section))) {
+				continue;
+			}
+			if (next >= column.count || column.entities[next] != entity) {
+				error = "section " + std::to_string(component.section) + " does not match the entities";
+				return false;
+			}
+			++next;
+		}
+		if (next != column.count) {
+			error = "section " + std::to_string(component.section) + " does not match the entities";
+			return false;
+		}
+	}
+
+	// Script fields follow their scripts, so they are read front to back alongside the entities
+	Column fields = GetColumn(SECTION_SCRIPT_FIELDS);
+	for (uint32_t i = 0; i < fields.count; ++i) {
+		uint32_t entity = fields.entities[i];
+		if (entity >= m_entityCount || !(m_entities[entity].components & (1u << SECTION_SCRIPT)) || (i > 0 && entity < fields.entities[i - 1])) {
+			error = "script fields do not match the scripts";
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,228 @@
+/*********************************************************************
+ * \file		CookedScene.hpp
+ * \brief		Declares the binary form scenes are cooked into from
+ *				their JSON, and the reader that validates a cooked
+ *				scene and reads it in place from a mapped file.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef COOKED_SCENE_HPP
+#define COOKED_SCENE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "MappedFile.hpp"
+#include "Reflection.hpp"
+
+/**
+ * \class CookedScene
+ * \brief A scene cooked from its JSON into columns that load without parsing.
+ *
+ * The file is a header, a table of sections and the sections, each starting on an 8 byte
+ * boundary. Strings are stored once, in the string table, and referred to by index. The entity
+ * section holds one record per entity of the JSON, in order, with a bit set for every component
+ * the entity has. Each component section holds the index of every entity with the component,
+ * increasing, followed by one row per entity in the binary form of the component's field table.
+ * That index column is the entity remap: the loader creates one entity per entity record and
+ * looks components up by file index.
+ *
+ * JSON stays the format scenes are authored and saved in. Cook reads each component with the
+ * same field table the JSON loader uses, so a cooked scene loads into the same state. The header
+ * records a hash of those tables, so a scene cooked before a component's fields changed is
+ * cooked again instead of misread. Open checks the whole file before anything is read from it,
+ * so a scene that opens always loads completely.
+ */
+class CookedScene {
+public:
+	static constexpr char MAGIC[4] = { 'K', 'S', 'C', 'N' };
+	static constexpr uint32_t VERSION = 2;
+	static constexpr char const* EXTENSION = ".scenebin";
+
+	/**
+	 * \enum SectionID
+	 * \brief Sections of a cooked scene. A component's bit in EntityRecord::components is 1 << its section.
+	 */
+	enum SectionID : uint32_t {
+		SECTION_STRINGS = 0,
+		SECTION_ENTITIES,
+		SECTION_NAME,
+		SECTION_TRANSFORM,
+		SECTION_RENDERER,
+		SECTION_AABB_COLLIDER,
+		SECTION_RIGIDBODY,
+		SECTION_ANIMATION,
+		SECTION_AUDIO_SOURCE,
+		SECTION_SCRIPT,
+		SECTION_SCRIPT_FIELDS,		// Fields of every script, with the entity of each
+		SECTION_UI,
+		SECTION_VIDEO_PLAYER,
+		SECTION_TEXTBOX,
+		SECTION_CAMERA,
+		SECTION_COLLISION_MATRIX,	// One byte per entry, absent when the JSON had no matrix
+		MAX_SECTIONS
+	};
+
+	struct FileHeader {
+		char magic[4];
+		uint32_t version;
+		uint64_t checksum;			// FNV-1a of every byte after the header
+		uint64_t fileSize;
+		uint64_t layout;			// GetLayoutHash when the scene was cooked
+		uint32_t entityCount;
+		uint32_t sectionCount;
+	};
+
+	struct SectionEntry {
+		uint32_t id;
+		uint32_t count;				// Rows, or strings in the string table
+		uint64_t offset;			// From the start of the file
+		uint64_t size;				// In bytes
+	};
+
+	struct EntityRecord {
+		uint32_t components;		// Bit per component section
+		uint8_t isActive;
+		uint8_t hasLayer;
+		uint8_t layer;
+		uint8_t padding;
+	};
+
+	/**
+	 * \struct ScriptFieldRecord
+	 * \brief A script parameter. Scripts have no field table, so their parameters keep a record of their own.
+	 */
+	struct ScriptFieldRecord {
+		uint32_t name;
+		uint32_t type;				// ScriptFieldType, None for fields the JSON loader leaves default
+		uint64_t value;				// The bytes ScriptFieldInstance::SetValue stores, zero extended
+	};
+
+	/**
+	 * \struct Column
+	 * \brief A section read in place: the entity each row belongs to, and the rows.
+	 */
+	struct Column {
+		uint32_t const* entities = nullptr;	// Index into the entity section, never decreasing
+		unsigned char const* rows = nullptr;
+		size_t stride = 0;
+		uint32_t count = 0;
+
+		unsigned char const* GetRow(uint32_t index) const { return rows + index * stride; }
+	};
+
+	/**
+	 * \brief Called while cooking with the number of entities cooked so far and the total.
+	 */
+	using Progress = std::function<void(uint32_t cooked, uint32_t total)>;
+
+	/**
+	 * \brief Cooks a JSON scene into a binary one.
+	 *
+	 * \param error Set to what went wrong when cooking fails, such as a field of a type the
+	 *              JSON loader cannot read.
+	 * \return False if the scene could not be read or cooked, or the cooked file written.
+	 */
+	static bool Cook(std::string const& scenePath, std::string const& cookedPath, std::string& error);
+
+	/**
+	 * \brief Cooks a JSON scene into memory, for a scene that has no cooked file to load.
+	 *
+	 * Touches nothing but its arguments, so it may run on any thread.
+	 */
+	static bool Cook(std::string const& scenePath, std::vector<unsigned char>& cooked, std::string& error, Progress const& progress = nullptr);
+
+	static bool IsCookedPath(std::string const& path);
+
+	/**
+	 * \brief Path a scene is cooked to: the scene's path with the cooked extension.
+	 */
+	static std::string GetCookedPath(std::string const& scenePath);
+
+	/**
+	 * \brief Checks a cooked scene exists and is not older than the JSON it was cooked from.
+	 */
+	static bool IsUpToDate(std::string const& scenePath, std::string const& cookedPath);
+
+	/**
+	 * \brief Cooked file a scene loads from: the path itself if it is cooked, or in the player an
+	 *        up to date cooked file beside the JSON.
+	 * \return The cooked path, or an empty one if the scene loads from its JSON.
+	 */
+	static std::string FindLoadablePath(std::string const& scenePath);
+
+	/**
+	 * \brief Maps a cooked scene and checks every part of it before anything is read.
+	 * \param error Set to what is wrong with the file when it fails to open.
+	 */
+	bool Open(std::string const& cookedPath, std::string& error);
+
+	/**
+	 * \brief Takes a scene cooked into memory and checks it as Open does.
+	 */
+	bool Open(std::vector<unsigned char>&& cooked, std::string& error);
+	void Close();
+
+	uint32_t GetEntityCount() const { return m_entityCount; }
+	EntityRecord const* GetEntities() const { return m_entities; }
+
+	/**
+	 * \brief The rows of a component or the script field section, empty if no entity has any.
+	 *
+	 * A component row is read with Reflection::ReadBinary and GetStrings. Rows are not aligned.
+	 */
+	Column GetColumn(SectionID section) const;
+
+	/**
+	 * \brief Entries of the collision matrix, or nullptr if the JSON had none.
+	 */
+	uint8_t const* GetCollisionMatrix(uint32_t& count) const;
+
+	/**
+	 * \brief The strings the rows refer to, read from the string table when the scene was opened.
+	 */
+	Reflection::StringTable const& GetStrings() const { return m_strings; }
+
+	/**
+	 * \brief Field table the rows of a component section are written with, or nullptr for other sections.
+	 */
+	static Reflection::FieldTable const* GetFields(uint32_t section);
+
+	/**
+	 * \brief Hash of every component section's field table, which decides how its rows are laid out.
+	 */
+	static uint64_t GetLayoutHash();
+
+	/**
+	 * \brief Offset of the rows after the entity column of a section.
+	 */
+	static constexpr uint64_t GetRowsOffset(uint32_t count) {
+		return (static_cast<uint64_t>(count) * sizeof(uint32_t) + 7u) & ~uint64_t{ 7u };
+	}
+
+	static uint64_t Checksum(unsigned char const* data, size_t size);
+
+private:
+	bool Validate(std::string& error);
+
+	MappedFile m_file{};
+	std::vector<unsigned char> m_memory{};		// Holds a scene cooked into memory instead of a mapped file
+	unsigned char const* m_data = nullptr;
+	size_t m_size = 0;
+	SectionEntry const* m_sections[MAX_SECTIONS]{};
+	EntityRecord const* m_entities = nullptr;
+	uint32_t m_entityCount = 0;
+	Reflection::StringTable m_strings{};
+};
+
+#endif // COOKED_SCENE_HPP
@@ -23,6 +23,16 @@ struct EngineConfig {
 	std::string sceneName;
 	bool isFullscreen;
 	std::string graphicsQuality;
+	int workerThreads = -1; // Job system workers; -1 picks from the hardware, 0 runs everything on the main thread
+	bool spriteInstancing = false; // Draws sprite batches as instances over a unit quad, see GraphicsManager::spriteInstancing
+	bool textureAtlas = true; // Packs images into shared atlas pages, see Texture::useAtlas
+	double textureUploadBudget = 2.0; // Milliseconds per frame spent uploading loaded textures, see TextureLoader::SetUploadBudget
+	bool viewCulling = true; // Draws only the sprites inside the camera views, see GraphicsManager::viewCulling
+	float cullMargin = 0.1f; // Fraction of the view size kept around it when culling, see GraphicsManager::cullMargin
+	double textureBudget = 512.0; // Megabytes of textures kept loaded between scenes, each atlas page counted once, see AssetManager::SetBudget
+	double fontBudget = 128.0; // Megabytes of fonts the performance panel flags, fonts are never evicted
+	double videoBudget = 256.0; // Megabytes of video clips the performance panel flags, videos are never evicted
+	double audioBudget = 128.0; // Megabytes of audio clips kept loaded between scenes
 };
 
 #endif // !ENGINE_SETTINGS_HPP
@@ -0,0 +1,170 @@
+/*********************************************************************
+ * \file		JobSystem.cpp
+ * \brief		Worker thread pool used to run systems and entity
+ *				ranges in parallel
+ *
+ * \author		y.ziyangirwen, 2301345 (y.ziyangirwen@digipen.edu)
+ * \date		1 September 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include "JobSystem.hpp"
+
+#include <algorithm>
+
+#include "Logger.hpp"
+#include "Profiler.hpp"
+
+JobSystem& JobSystem::GetInstance() {
+	static JobSystem instance;
+	return instance;
+}
+
+JobSystem::~JobSystem() {
+	Shutdown();
+}
+
+void JobSystem::Initialize(int numWorkers) {
+	if (!m_workers.empty()) {
+		Logger::Instance().Log(Logger::Level::WARN, "[JobSystem] Initialize: Already initialized.");
+		return;
+	}
+
+	if (numWorkers < 0) {
+		unsigned hardwareThreads = std::thread::hardware_concurrency();
+		numWorkers = hardwareThreads > 1 ? static_cast<int>(hardwareThreads) - 1 : 0;
+	}
+
+	m_stopping = false;
+	m_workers.reserve(numWorkers);
+	for (int i = 0; i < numWorkers; ++i) {
+		m_workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+	}
+
+	Logger::Instance().Log(Logger::Level::INFO, "[JobSystem] Started ", numWorkers, " worker threads.");
+}
+
+void JobSystem::Shutdown() {
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_stopping = true;
+	}
+	m_queueCondition.notify_all();
+
+	for (auto& worker : m_workers) {
+		worker.join();
+	}
+	m_workers.clear();
+}
+
+void JobSystem::Submit(Job job, JobCounter& counter) {
+	counter.m_pending.fetch_add(1, std::memory_order_relaxed);
+
+	if (IsSingleThreaded()) {
+		QueuedJob queued{ std::move(job), &counter };
+		Run(queued);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_queue.push_back({ std::move(job), &counter });
+	}
+	m_queueCondition.notify_one();
+}
+
+void JobSystem::SubmitBackground(Job job, JobCounter& counter) {
+	counter.m_pending.fetch_add(1, std::memory_order_relaxed);
+
+	if (IsSingleThreaded()) {
+		QueuedJob queued{ std::move(job), &counter };
+		Run(queued);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_backgroundQueue.push_back({ std::move(job), &counter });
+	}
+	m_queueCondition.notify_one();
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+	while (!counter.IsDone()) {
+		if (TryRunOne()) {
+			continue;
+		}
+
+		// Nothing left to help with; sleep until one of the workers finishes a job.
+		std::unique_lock<std::mutex> lock(m_queueMutex);
+		m_doneCondition.wait(lock, [this, &counter] { return counter.IsDone() || !m_queue.empty(); });
+	}
+}
+
+void JobSystem::ParallelFor(size_t count, size_t chunkSize, std::function<void(size_t, size_t)> const& func) {
+	if (count == 0) {
+		return;
+	}
+	chunkSize = std::max<size_t>(chunkSize, 1);
+
+	if (IsSingleThreaded() || count <= chunkSize) {
+		func(0, count);
+		return;
+	}
+
+	JobCounter counter;
+	for (size_t begin = 0; begin < count; begin += chunkSize) {
+		size_t end = std::min(begin + chunkSize, count);
+		Submit([&func, begin, end] { func(begin, end); }, counter);
+	}
+	Wait(counter);
+}
+
+void JobSystem::WorkerLoop(int index) {
+	PROFILE_THREAD("Worker " + std::to_string(index));
+
+	while (true) {
+		QueuedJob queued;
+		{
+			std::unique_lock<std::mutex> lock(m_queueMutex);
+			m_queueCondition.wait(lock, [this] { return m_stopping || !m_queue.empty() || !m_backgroundQueue.empty(); });
+
+			// Frame work first; background jobs only take workers that would otherwise sleep.
+			std::deque<QueuedJob>& queue = !m_queue.empty() ? m_queue : m_backgroundQueue;
+			if (queue.empty()) {
+				return;
+			}
+			queued = std::move(queue.front());
+			queue.pop_front();
+		}
+		Run(queued);
+	}
+}
+
+bool JobSystem::TryRunOne() {
+	// Only the shared queue; background jobs are left to the workers.
+	QueuedJob queued;
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		if (m_queue.empty()) {
+			return false;
+		}
+		queued = std::move(m_queue.front());
+		m_queue.pop_front();
+	}
+	Run(queued);
+	return true;
+}
+
+void JobSystem::Run(QueuedJob& queued) {
+	queued.job();
+	queued.counter->m_pending.fetch_sub(1, std::memory_order_acq_rel);
+
+	// Take the lock so a waiter cannot miss the notification between its check and its wait.
+	{ std::lock_guard<std::mutex> lock(m_queueMutex); }
+	m_doneCondition.notify_all();
+}
@@ -0,0 +1,134 @@
+/*********************************************************************
+ * \file		JobSystem.hpp
+ * \brief		Worker thread pool used to run systems and entity
+ *				ranges in parallel
+ *
+ * \author		y.ziyangirwen, 2301345 (y.ziyangirwen@digipen.edu)
+ * \date		1 September 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \class JobCounter
+ * \brief Tracks a group of submitted jobs so the submitter can wait for all of them.
+ */
+class JobCounter {
+public:
+	bool IsDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+private:
+	friend class JobSystem;
+	std::atomic<int> m_pending{ 0 };	/**< Number of jobs that have not finished yet. */
+};
+
+/**
+ * \class JobSystem
+ * \brief Fixed pool of worker threads fed from a shared queue and a background queue.
+ *
+ * Workers take jobs from the shared queue first and from the background queue only when the
+ * shared queue is empty. A thread blocked in Wait only helps with the shared queue, so long
+ * background jobs such as texture decodes never run on a thread that is waiting for a frame's work.
+ *
+ * In single-threaded mode (or before Initialize is called) every job runs immediately on the
+ * submitting thread, in submission order. This gives a deterministic fallback for debugging.
+ *
+ * Jobs must not touch OpenGL, FMOD or the scripting runtime; those stay on the main thread.
+ */
+class JobSystem {
+public:
+	using Job = std::function<void()>;
+
+	static JobSystem& GetInstance();
+
+	/**
+	 * \brief Starts the worker threads.
+	 *
+	 * \param numWorkers Number of worker threads. A negative value uses one fewer than the number
+	 *                   of hardware threads; zero runs everything on the calling thread.
+	 */
+	void Initialize(int numWorkers = -1);
+
+	/**
+	 * \brief Finishes queued jobs and joins the worker threads.
+	 */
+	void Shutdown();
+
+	/**
+	 * \brief Queues a job. The counter is decremented when the job finishes.
+	 */
+	void Submit(Job job, JobCounter& counter);
+
+	/**
+	 * \brief Queues a job that only workers run, once the shared queue is empty.
+	 *
+	 * For work the submitter does not wait on, such as decoding assets in the background. Waiting
+	 * on the counter is allowed, but the waiting thread will not run the job itself.
+	 */
+	void SubmitBackground(Job job, JobCounter& counter);
+
+	/**
+	 * \brief Blocks until every job tracked by the counter has finished.
+	 *
+	 * The waiting thread runs queued jobs instead of sleeping, so it is safe to wait from a job.
+	 */
+	void Wait(JobCounter& counter);
+
+	/**
+	 * \brief Splits [0, count) into chunks and runs func(begin, end) on each, then waits.
+	 *
+	 * \param count Number of items.
+	 * \param chunkSize Items per chunk. Small ranges run inline on the calling thread.
+	 * \param func Invoked once per chunk. Chunks may run concurrently.
+	 */
+	void ParallelFor(size_t count, size_t chunkSize, std::function<void(size_t, size_t)> const& func);
+
+	/**
+	 * \brief Forces every job to run on the submitting thread, in submission order.
+	 */
+	void SetSingleThreaded(bool singleThreaded) { m_singleThreaded = singleThreaded; }
+	bool IsSingleThreaded() const { return m_singleThreaded || m_workers.empty(); }
+
+	size_t GetNumWorkers() const { return m_workers.size(); }
+
+private:
+	JobSystem() = default;
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	struct QueuedJob {
+		Job job;
+		JobCounter* counter;
+	};
+
+	void WorkerLoop(int index);
+	bool TryRunOne();
+	void Run(QueuedJob& queued);
+
+	std::vector<std::thread> m_workers{};		/**< Worker threads. */
+	std::deque<QueuedJob> m_queue{};			/**< Jobs waiting for a worker or a waiting thread. */
+	std::deque<QueuedJob> m_backgroundQueue{};	/**< Jobs waiting for a worker with nothing else to do. */
+	std::mutex m_queueMutex{};					/**< Guards both queues and m_stopping. */
+	std::condition_variable m_queueCondition{};	/**< Signalled when jobs are queued or on shutdown. */
+	std::condition_variable m_doneCondition{};	/**< Signalled when a job finishes. */
+	bool m_stopping = false;					/**< Set when the workers should exit. */
+	bool m_singleThreaded = false;				/**< Deterministic fallback mode. */
+};
+
+#endif // !JOB_SYSTEM_HPP
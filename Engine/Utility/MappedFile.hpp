@@ -0,0 +1,57 @@
+/*********************************************************************
+ * \file		MappedFile.hpp
+ * \brief		Declares a read-only view of a whole file mapped into
+ *				memory.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+/**
+ * \class MappedFile
+ * \brief Maps a file read-only, so its bytes are read in place rather than copied into a buffer.
+ *
+ * The operating system pages the file in as it is touched. The view starts on a page boundary,
+ * so anything stored at an aligned offset in the file can be read through a pointer directly.
+ */
+class MappedFile {
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(MappedFile const&) = delete;
+	MappedFile& operator=(MappedFile const&) = delete;
+
+	/**
+	 * \brief Maps a file, closing the file mapped before.
+	 * \return False if the file could not be opened or mapped, or is empty.
+	 */
+	bool Open(std::string const& path);
+	void Close();
+
+	bool IsOpen() const { return m_data != nullptr; }
+	unsigned char const* GetData() const { return m_data; }
+	size_t GetSize() const { return m_size; }
+
+private:
+	unsigned char const* m_data = nullptr;
+	size_t m_size = 0;
+#ifdef _WIN32
+	void* m_file = nullptr;		// HANDLE of the file
+	void* m_mapping = nullptr;	// HANDLE of the file mapping
+#endif
+};
+
+#endif // MAPPED_FILE_HPP
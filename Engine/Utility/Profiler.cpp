@@ -0,0 +1,329 @@
+/*********************************************************************
+ * \file		Profiler.cpp
+ * \brief		Scoped CPU zones, counters and frame markers, with an
+ *				aggregated call tree for the editor and Chrome trace
+ *				export
+ *
+ * \author		y.ziyangirwen, 2301345 (y.ziyangirwen@digipen.edu)
+ * \date		1 September 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+
+#include "Logger.hpp"
+
+namespace {
+	constexpr double NS_TO_MS = 1.0 / 1'000'000.0;
+	constexpr double AVERAGE_WEIGHT = 0.1;	// Weight of the latest frame in the smoothed averages.
+}
+
+Profiler& Profiler::GetInstance() {
+	static Profiler instance;
+	return instance;
+}
+
+void Profiler::ThreadBuffer::Push(ProfileEvent const& event) {
+	uint64_t writeIndex = head.load(std::memory_order_relaxed);
+	if (writeIndex - tail.load(std::memory_order_acquire) >= CAPACITY) {
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	events[writeIndex & (CAPACITY - 1)] = event;
+	head.store(writeIndex + 1, std::memory_order_release);
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer() {
+	// Buffers live until the profiler is destroyed, so the cached pointer stays valid after the thread exits.
+	thread_local ThreadBuffer* buffer = nullptr;
+	if (!buffer) {
+		std::lock_guard<std::mutex> lock(m_buffersMutex);
+		m_buffers.push_back(std::make_unique<ThreadBuffer>());
+		buffer = m_buffers.back().get();
+		buffer->index = static_cast<uint32_t>(m_buffers.size() - 1);
+		buffer->name = "Thread " + std::to_string(buffer->index);
+	}
+	return *buffer;
+}
+
+void Profiler::SetThreadName(std::string name) {
+	ThreadBuffer& buffer = GetThreadBuffer();
+	std::lock_guard<std::mutex> lock(buffer.nameMutex);
+	buffer.name = std::move(name);
+}
+
+void Profiler::RecordZone(const char* name, uint64_t start, uint64_t end, uint32_t depth) {
+	GetThreadBuffer().Push({ name, start, end, 0.0, depth, ProfileEvent::Type::ZONE });
+}
+
+void Profiler::RecordCounter(const char* name, double value) {
+	if (!IsEnabled()) {
+		return;
+	}
+	uint64_t now = Now();
+	GetThreadBuffer().Push({ name, now, now, value, 0, ProfileEvent::Type::COUNTER });
+}
+
+void Profiler::Drain(ThreadBuffer& buffer) {
+	uint64_t readIndex = buffer.tail.load(std::memory_order_relaxed);
+	uint64_t writeIndex = buffer.head.load(std::memory_order_acquire);
+
+	m_drained.clear();
+	for (; readIndex != writeIndex; ++readIndex) {
+		m_drained.push_back(buffer.events[readIndex & (ThreadBuffer::CAPACITY - 1)]);
+	}
+	buffer.tail.store(readIndex, std::memory_order_release);
+}
+
+uint32_t Profiler::GetChild(uint32_t parent, const char* name) {
+	for (uint32_t child : m_nodes[parent].children) {
+		if (m_nodes[child].name == name || std::strcmp(m_nodes[child].name, name) == 0) {
+			return child;
+		}
+	}
+
+	uint32_t child = static_cast<uint32_t>(m_nodes.size());
+	m_nodes.push_back({ name, parent, {} });
+	m_nodes[parent].children.push_back(child);
+	return child;
+}
+
+void Profiler::AddZonesToTree(uint32_t threadIndex, std::vector<ProfileEvent>& zones) {
+	while (m_threadRoots.size() <= threadIndex) {
+		m_threadRoots.push_back(static_cast<uint32_t>(m_nodes.size()));
+		m_nodes.push_back({ nullptr, INVALID_NODE, {} });
+	}
+
+	// Zones are recorded when they end, so children come before their parents. Sorting by start
+	// time, outermost first, puts every zone after the zone that encloses it.
+	std::sort(zones.begin(), zones.end(), [](ProfileEvent const& lhs, ProfileEvent const& rhs) {
+		return lhs.start != rhs.start ? lhs.start < rhs.start : lhs.depth < rhs.depth;
+	});
+
+	// Node of the innermost open zone at each depth. Zones whose parent was recorded in an earlier
+	// frame, or was dropped, are attached to the deepest ancestor that is known.
+	std::vector<uint32_t> stack{ m_threadRoots[threadIndex] };
+	std::vector<uint64_t> stackEnd{ UINT64_MAX };
+	for (ProfileEvent const& zone : zones) {
+		while (stack.size() > 1 && (stack.size() > zone.depth + 1 || zone.start >= stackEnd.back())) {
+			stack.pop_back();
+			stackEnd.pop_back();
+		}
+
+		uint32_t node = GetChild(stack.back(), zone.name);
+		m_nodes[node].frameMs += static_cast<double>(zone.end - zone.start) * NS_TO_MS;
+		++m_nodes[node].frameCalls;
+
+		stack.push_back(node);
+		stackEnd.push_back(zone.end);
+	}
+}
+
+void Profiler::FrameMark() {
+	uint64_t now = Now();
+	if (m_lastFrameMark != 0) {
+		m_lastFrameMs = static_cast<double>(now - m_lastFrameMark) * NS_TO_MS;
+		m_frameHistory[m_frameHistoryNext] = static_cast<float>(m_lastFrameMs);
+		m_frameHistoryNext = (m_frameHistoryNext + 1) % FRAME_HISTORY;
+		m_frameHistoryCount = std::min(m_frameHistoryCount + 1, FRAME_HISTORY);
+	}
+	m_lastFrameMark = now;
+
+	for (Node& node : m_nodes) {
+		node.frameMs = 0.0;
+		node.frameCalls = 0;
+	}
+
+	std::vector<ThreadBuffer*> buffers;
+	{
+		std::lock_guard<std::mutex> lock(m_buffersMutex);
+		for (auto& buffer : m_buffers) {
+			buffers.push_back(buffer.get());
+		}
+	}
+
+	std::vector<ProfileEvent> zones;
+	for (ThreadBuffer* buffer : buffers) {
+		Drain(*buffer);
+
+		zones.clear();
+		for (ProfileEvent const& event : m_drained) {
+			if (event.type == ProfileEvent::Type::ZONE) {
+				zones.push_back(event);
+				continue;
+			}
+
+			auto counter = std::find_if(m_counters.begin(), m_counters.end(),
+				[&event](Counter const& c) { return std::strcmp(c.name, event.name) == 0; });
+			if (counter == m_counters.end()) {
+				m_counters.push_back({ event.name, event.value });
+			}
+			else {
+				counter->value = event.value;
+			}
+		}
+		AddZonesToTree(buffer->index, zones);
+
+		if (m_capturing) {
+			for (ProfileEvent const& event : m_drained) {
+				if (m_captured.size() >= MAX_CAPTURED_EVENTS) {
+					break;
+				}
+				m_captured.emplace_back(buffer->index, event);
+			}
+		}
+	}
+
+	for (Node& node : m_nodes) {
+		node.avgMs += (node.frameMs - node.avgMs) * AVERAGE_WEIGHT;
+		node.maxMs = std::max(node.maxMs, node.frameMs);
+	}
+
+	if (m_capturing) {
+		m_captured.emplace_back(0, ProfileEvent{ "Frame", now, now, 0.0, 0, ProfileEvent::Type::FRAME });
+		if (m_captureFramesLeft > 0 && --m_captureFramesLeft == 0) {
+			StopCapture();
+		}
+	}
+}
+
+void Profiler::StartCapture(std::string path, uint32_t frames) {
+	m_captured.clear();
+	m_capturePath = std::move(path);
+	m_captureFramesLeft = frames;
+	m_capturing = true;
+}
+
+bool Profiler::StopCapture() {
+	if (!m_capturing) {
+		return false;
+	}
+	m_capturing = false;
+
+	bool written = WriteChromeTrace();
+	m_captured.clear();
+	m_captured.shrink_to_fit();
+	return written;
+}
+
+void Profiler::ResetStats() {
+	for (Node& node : m_nodes) {
+		node.avgMs = node.frameMs;
+		node.maxMs = node.frameMs;
+	}
+	m_frameHistoryNext = 0;
+	m_frameHistoryCount = 0;
+}
+
+std::vector<float> Profiler::GetFrameHistory() const {
+	std::vector<float> history;
+	history.reserve(m_frameHistoryCount);
+	size_t first = (m_frameHistoryNext + FRAME_HISTORY - m_frameHistoryCount) % FRAME_HISTORY;
+	for (size_t i = 0; i < m_frameHistoryCount; ++i) {
+		history.push_back(m_frameHistory[(first + i) % FRAME_HISTORY]);
+	}
+	return history;
+}
+
+std::string Profiler::GetThreadName(uint32_t threadIndex) const {
+	std::lock_guard<std::mutex> lock(m_buffersMutex);
+	if (threadIndex >= m_buffers.size()) {
+		return {};
+	}
+	std::lock_guard<std::mutex> nameLock(m_buffers[threadIndex]->nameMutex);
+	return m_buffers[threadIndex]->name;
+}
+
+uint64_t Profiler::GetDroppedEvents() const {
+	uint64_t dropped = 0;
+	std::lock_guard<std::mutex> lock(m_buffersMutex);
+	for (auto const& buffer : m_buffers) {
+		dropped += buffer->dropped.load(std::memory_order_relaxed);
+	}
+	return dropped;
+}
+
+bool Profiler::WriteChromeTrace() const {
+	rapidjson::StringBuffer stringBuffer;
+	rapidjson::Writer<rapidjson::StringBuffer> writer(stringBuffer);
+
+	// Chrome trace timestamps are in microseconds.
+	auto writeTime = [&writer](const char* key, uint64_t ns) {
+		writer.Key(key);
+		writer.Double(static_cast<double>(ns) / 1000.0);
+	};
+
+	writer.StartObject();
+	writer.Key("displayTimeUnit");
+	writer.String("ms");
+	writer.Key("traceEvents");
+	writer.StartArray();
+
+	{
+		std::lock_guard<std::mutex> lock(m_buffersMutex);
+		for (auto const& buffer : m_buffers) {
+			std::lock_guard<std::mutex> nameLock(buffer->nameMutex);
+			writer.StartObject();
+			writer.Key("name"); writer.String("thread_name");
+			writer.Key("ph"); writer.String("M");
+			writer.Key("pid"); writer.Uint(0);
+			writer.Key("tid"); writer.Uint(buffer->index);
+			writer.Key("args");
+			writer.StartObject();
+			writer.Key("name"); writer.String(buffer->name.c_str());
+			writer.EndObject();
+			writer.EndObject();
+		}
+	}
+
+	for (auto const& [threadIndex, event] : m_captured) {
+		writer.StartObject();
+		writer.Key("name"); writer.String(event.name);
+		writer.Key("pid"); writer.Uint(0);
+		writer.Key("tid"); writer.Uint(threadIndex);
+		writeTime("ts", event.start);
+
+		switch (event.type) {
+		case ProfileEvent::Type::ZONE:
+			writer.Key("ph"); writer.String("X");
+			writeTime("dur", event.end - event.start);
+			break;
+		case ProfileEvent::Type::COUNTER:
+			writer.Key("ph"); writer.String("C");
+			writer.Key("args");
+			writer.StartObject();
+			writer.Key("value"); writer.Double(event.value);
+			writer.EndObject();
+			break;
+		case ProfileEvent::Type::FRAME:
+			writer.Key("ph"); writer.String("i");
+			writer.Key("s"); writer.String("g");
+			break;
+		}
+		writer.EndObject();
+	}
+
+	writer.EndArray();
+	writer.EndObject();
+
+	std::ofstream file(m_capturePath);
+	if (!file.is_open()) {
+		Logger::Instance().Log(Logger::Level::ERR, "[Profiler] WriteChromeTrace: Failed to open ", m_capturePath);
+		return false;
+	}
+	file << stringBuffer.GetString();
+
+	Logger::Instance().Log(Logger::Level::INFO, "[Profiler] Wrote ", m_captured.size(), " events to ", m_capturePath);
+	return true;
+}
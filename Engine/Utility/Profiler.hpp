@@ -0,0 +1,270 @@
+/*********************************************************************
+ * \file		Profiler.hpp
+ * \brief		Scoped CPU zones, counters and frame markers, with an
+ *				aggregated call tree for the editor and Chrome trace
+ *				export
+ *
+ * \author		y.ziyangirwen, 2301345 (y.ziyangirwen@digipen.edu)
+ * \date		1 September 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Zones are compiled in unless KIGEN_PROFILE is defined to 0. The installer build leaves them out.
+#ifndef KIGEN_PROFILE
+#ifdef INSTALLER
+#define KIGEN_PROFILE 0
+#else
+#define KIGEN_PROFILE 1
+#endif
+#endif
+
+/**
+ * \struct ProfileEvent
+ * \brief A finished zone or a counter sample, as stored in the per-thread buffers.
+ */
+struct ProfileEvent {
+	enum class Type : uint8_t {
+		ZONE,
+		COUNTER,
+		FRAME
+	};
+
+	const char* name;	// Static string naming the zone or counter.
+	uint64_t start;		// Nanoseconds since the profiler started.
+	uint64_t end;		// End of the zone. Same as start for counters and frames.
+	double value;		// Counter value.
+	uint32_t depth;		// Number of zones open on the thread when this zone began.
+	Type type;
+};
+
+/**
+ * \class Profiler
+ * \brief Collects timing events from every thread and turns them into per-frame statistics.
+ *
+ * Each thread records into its own ring buffer, which only that thread writes to, so recording
+ * never takes a lock. Once per frame, FrameMark drains every buffer on the main thread, folds the
+ * zones into a call tree per thread and, while a capture is running, keeps the raw events so they
+ * can be written out as a Chrome trace (open it in chrome://tracing or ui.perfetto.dev).
+ *
+ * A buffer is created the first time a thread records and is kept for the lifetime of the
+ * program, so zones are meant for the main thread and the job system workers rather than for
+ * short-lived threads.
+ *
+ * Zone and counter names must be string literals, or otherwise outlive the profiler.
+ * FrameMark, the call tree and the capture functions must only be used from the main thread.
+ */
+class Profiler {
+public:
+	/**
+	 * \struct Node
+	 * \brief One entry of the aggregated call tree. Roots are threads; their children are top-level zones.
+	 */
+	struct Node {
+		const char* name;
+		uint32_t parent;
+		std::vector<uint32_t> children;
+
+		double frameMs = 0.0;	// Time spent in the zone during the last frame.
+		double avgMs = 0.0;		// Smoothed time per frame.
+		double maxMs = 0.0;		// Highest time per frame since the last reset.
+		uint32_t frameCalls = 0;	// Number of times the zone ran during the last frame.
+	};
+
+	/**
+	 * \struct Counter
+	 * \brief Latest value of a counter.
+	 */
+	struct Counter {
+		const char* name;
+		double value;
+	};
+
+	static constexpr uint32_t INVALID_NODE = static_cast<uint32_t>(-1);
+	static constexpr size_t FRAME_HISTORY = 240;	// Number of frame times kept for the frame graph.
+
+	static Profiler& GetInstance();
+
+	/**
+	 * \brief Returns the time since the profiler started, in nanoseconds.
+	 */
+	static uint64_t Now() {
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - s_epoch).count());
+	}
+
+	/**
+	 * \brief Names the calling thread in the call tree and in exported traces.
+	 */
+	void SetThreadName(std::string name);
+
+	/**
+	 * \brief Records a finished zone on the calling thread.
+	 */
+	void RecordZone(const char* name, uint64_t start, uint64_t end, uint32_t depth);
+
+	/**
+	 * \brief Records the current value of a counter on the calling thread.
+	 */
+	void RecordCounter(const char* name, double value);
+
+	/**
+	 * \brief Ends the current frame. Drains every thread's events and updates the call tree.
+	 */
+	void FrameMark();
+
+	/**
+	 * \brief Stops or resumes recording. Zones that are already open when recording stops are still recorded.
+	 */
+	void SetEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+	bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+	/**
+	 * \brief Starts keeping raw events for a Chrome trace.
+	 *
+	 * \param frames Number of frames to capture before the trace is written automatically, or 0 to capture until StopCapture.
+	 * \param path File the trace is written to.
+	 */
+	void StartCapture(std::string path, uint32_t frames = 0);
+
+	/**
+	 * \brief Stops the current capture and writes the trace.
+	 *
+	 * \return True if the trace was written.
+	 */
+	bool StopCapture();
+
+	bool IsCapturing() const { return m_capturing; }
+	std::string const& GetCapturePath() const { return m_capturePath; }
+
+	/**
+	 * \brief Clears the per-zone maximums and the frame history.
+	 */
+	void ResetStats();
+
+	std::vector<Node> const& GetNodes() const { return m_nodes; }
+	std::vector<uint32_t> const& GetThreadRoots() const { return m_threadRoots; }
+	std::vector<Counter> const& GetCounters() const { return m_counters; }
+	std::string GetThreadName(uint32_t threadIndex) const;
+
+	/**
+	 * \brief Frame times in milliseconds, oldest first.
+	 */
+	std::vector<float> GetFrameHistory() const;
+	double GetLastFrameMs() const { return m_lastFrameMs; }
+	uint64_t GetDroppedEvents() const;
+
+private:
+	/**
+	 * \struct ThreadBuffer
+	 * \brief Single-producer, single-consumer ring of events written by one thread and drained by FrameMark.
+	 */
+	struct ThreadBuffer {
+		static constexpr uint64_t CAPACITY = 1 << 14;
+
+		std::array<ProfileEvent, CAPACITY> events;
+		std::atomic<uint64_t> head{ 0 };	// Next slot to write. Only advanced by the owning thread.
+		std::atomic<uint64_t> tail{ 0 };	// Next slot to read. Only advanced by FrameMark.
+		std::atomic<uint64_t> dropped{ 0 };	// Events lost because the buffer was full.
+		uint32_t index = 0;
+		std::string name;
+		std::mutex nameMutex;				// Guards name, which can be set after the buffer is registered.
+
+		void Push(ProfileEvent const& event);
+	};
+
+	Profiler() = default;
+
+	ThreadBuffer& GetThreadBuffer();
+	void Drain(ThreadBuffer& buffer);
+	void AddZonesToTree(uint32_t threadIndex, std::vector<ProfileEvent>& zones);
+	uint32_t GetChild(uint32_t parent, const char* name);
+	bool WriteChromeTrace() const;
+
+	static inline const std::chrono::steady_clock::time_point s_epoch = std::chrono::steady_clock::now();
+
+	std::atomic<bool> m_enabled{ true };
+
+	mutable std::mutex m_buffersMutex;								// Guards registration of new thread buffers.
+	std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+
+	std::vector<Node> m_nodes;
+	std::vector<uint32_t> m_threadRoots;					// Root node of each thread buffer, by buffer index.
+	std::vector<Counter> m_counters;
+	std::vector<ProfileEvent> m_drained;					// Reused while draining.
+
+	std::array<float, FRAME_HISTORY> m_frameHistory{};
+	size_t m_frameHistoryNext = 0;
+	size_t m_frameHistoryCount = 0;
+	uint64_t m_lastFrameMark = 0;
+	double m_lastFrameMs = 0.0;
+
+	bool m_capturing = false;
+	uint32_t m_captureFramesLeft = 0;
+	std::string m_capturePath;
+	std::vector<std::pair<uint32_t, ProfileEvent>> m_captured;	// Thread index and event.
+
+	static constexpr size_t MAX_CAPTURED_EVENTS = 4'000'000;	// Stops a forgotten capture from using unbounded memory.
+};
+
+/**
+ * \class ProfileZone
+ * \brief Times the enclosing scope. Use through PROFILE_SCOPE.
+ */
+class ProfileZone {
+public:
+	explicit ProfileZone(const char* name) : m_name(name), m_start(0), m_depth(s_depth++) {
+		if (Profiler::GetInstance().IsEnabled()) {
+			m_start = Profiler::Now();
+		}
+	}
+
+	~ProfileZone() {
+		--s_depth;
+		if (m_start != 0) {
+			Profiler::GetInstance().RecordZone(m_name, m_start, Profiler::Now(), m_depth);
+		}
+	}
+
+	ProfileZone(ProfileZone const&) = delete;
+	ProfileZone& operator=(ProfileZone const&) = delete;
+
+private:
+	const char* m_name;
+	uint64_t m_start;
+	uint32_t m_depth;
+
+	static inline thread_local uint32_t s_depth = 0;
+};
+
+#define KIGEN_PROFILE_CONCAT_IMPL(a, b) a##b
+#define KIGEN_PROFILE_CONCAT(a, b) KIGEN_PROFILE_CONCAT_IMPL(a, b)
+
+#if KIGEN_PROFILE
+#define PROFILE_SCOPE(name) ProfileZone KIGEN_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_COUNTER(name, value) Profiler::GetInstance().RecordCounter(name, static_cast<double>(value))
+#define PROFILE_FRAME() Profiler::GetInstance().FrameMark()
+#define PROFILE_THREAD(name) Profiler::GetInstance().SetThreadName(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_COUNTER(name, value) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,230 @@
+/*********************************************************************
+ * \file		Reflection.cpp
+ * \brief		Defines the serializer that reads and writes any
+ *				component by walking its field table.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#include "Reflection.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "JSONParser.hpp"
+
+namespace Reflection {
+
+	FieldTable::FieldTable(char const* component, std::initializer_list<FieldDescriptor> fields)
+		: m_component(component), m_fields(fields) {
+		std::vector<FieldDescriptor> values;
+		for (FieldDescriptor const& field : m_fields) {
+			if (field.type == FieldType::STRING) {
+				m_stringOffsets.push_back(field.offset);
+			}
+			else {
+				values.push_back(field);
+			}
+		}
+
+		// Merge the plain fields that follow one another in the component with no padding between
+		std::sort(values.begin(), values.end(), [](FieldDescriptor const& a, FieldDescriptor const& b) { return a.offset < b.offset; });
+		for (FieldDescriptor const& field : values) {
+			if (!m_runs.empty() && m_runs.back().offset + m_runs.back().size == field.offset) {
+				m_runs.back().size += field.size;
+			}
+			else {
+				m_runs.push_back(FieldRun{ field.offset, field.size });
+			}
+			m_binarySize += field.size;
+		}
+		m_binarySize += m_stringOffsets.size() * sizeof(uint32_t);
+	}
+
+	uint32_t StringTable::Intern(std::string_view value) {
+		auto it = m_indices.find(value);
+		if (it != m_indices.end()) {
+			return it->second;
+		}
+		uint32_t index = static_cast<uint32_t>(m_strings.size());
+		m_strings.emplace_back(value);
+		m_indices.emplace(m_strings.back(), index);
+		return index;
+	}
+
+	std::string const& StringTable::Get(uint32_t index) const {
+		static std::string const empty;
+		return index < m_strings.size() ? m_strings[index] : empty;
+	}
+
+	void StringTable::Clear() {
+		m_indices.clear();
+		m_strings.clear();
+	}
+
+	namespace {
+		template<typename T>
+		T& At(void* component, FieldDescriptor const& field) {
+			return *reinterpret_cast<T*>(static_cast<unsigned char*>(component) + field.offset);
+		}
+
+		template<typename T>
+		T const& At(void const* component, FieldDescriptor const& field) {
+			return *reinterpret_cast<T const*>(static_cast<unsigned char const*>(component) + field.offset);
+		}
+
+		// Number members of a vector, read as JSONDeserializer reads them: zero when missing
+		float ReadFloat(rapidjson::Value const& value, char const* name) {
+			auto member = value.FindMember(name);
+			return member != value.MemberEnd() && member->value.IsNumber() ? member->value.GetFloat() : 0.f;
+		}
+
+		void ReadField(void* component, FieldDescriptor const& field, rapidjson::Value const& value) {
+			switch (field.type) {
+			case FieldType::BOOL:
+				if (!value.IsBool()) {
+					throw std::runtime_error(std::string("Field is not a boolean: ") + field.name);
+				}
+				At<bool>(component, field) = value.GetBool();
+				break;
+			case FieldType::INT:
+				At<int>(component, field) = value.IsInt() ? value.GetInt() : 0;
+				break;
+			case FieldType::UINT:
+				At<unsigned>(component, field) = value.IsUint() ? value.GetUint() : 0u;
+				break;
+			case FieldType::UINT8:
+				At<uint8_t>(component, field) = static_cast<uint8_t>(value.IsInt() ? value.GetInt() : 0);
+				break;
+			case FieldType::FLOAT:
+				if (!value.IsNumber()) {
+					throw std::runtime_error(std::string("Field is not a float: ") + field.name);
+				}
+				At<float>(component, field) = value.GetFloat();
+				break;
+			case FieldType::DOUBLE:
+				At<double>(component, field) = value.IsNumber() ? value.GetDouble() : 0.0;
+				break;
+			case FieldType::VEC2:
+				At<Vec2>(component, field) = value.IsObject() ? Vec2(ReadFloat(value, "x"), ReadFloat(value, "y")) : Vec2(0.f, 0.f);
+				break;
+			case FieldType::VEC3:
+				At<Vec3>(component, field) = value.IsObject() ? Vec3(ReadFloat(value, "x"), ReadFloat(value, "y"), ReadFloat(value, "z")) : Vec3(0.f, 0.f, 0.f);
+				break;
+			case FieldType::STRING:
+				if (value.IsString()) {
+					At<std::string>(component, field).assign(value.GetString(), value.GetStringLength());
+				}
+				else {
+					At<std::string>(component, field).clear();
+				}
+				break;
+			}
+		}
+
+		void ZeroField(void* component, FieldDescriptor const& field) {
+			switch (field.type) {
+			case FieldType::BOOL: At<bool>(component, field) = false; break;
+			case FieldType::INT: At<int>(component, field) = 0; break;
+			case FieldType::UINT: At<unsigned>(component, field) = 0u; break;
+			case FieldType::UINT8: At<uint8_t>(component, field) = 0; break;
+			case FieldType::FLOAT: At<float>(component, field) = 0.f; break;
+			case FieldType::DOUBLE: At<double>(component, field) = 0.0; break;
+			case FieldType::VEC2: At<Vec2>(component, field) = Vec2(0.f, 0.f); break;
+			case FieldType::VEC3: At<Vec3>(component, field) = Vec3(0.f, 0.f, 0.f); break;
+			case FieldType::STRING: At<std::string>(component, field).clear(); break;
+			}
+		}
+	}
+
+	void ReadJSON(void* component, FieldTable const& table, rapidjson::Value const& value) {
+		for (FieldDescriptor const& field : table.GetFields()) {
+			auto member = value.FindMember(field.name);
+			if (member != value.MemberEnd()) {
+				ReadField(component, field, member->value);
+			}
+			else if (!(field.flags & FIELD_OPTIONAL)) {
+				ZeroField(component, field);
+			}
+		}
+	}
+
+	void WriteJSON(void const* component, FieldTable const& table, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator) {
+		for (FieldDescriptor const& field : table.GetFields()) {
+			rapidjson::Value::StringRefType key(field.name);
+			switch (field.type) {
+			case FieldType::BOOL:
+				value.AddMember(key, At<bool>(component, field), allocator);
+				break;
+			case FieldType::INT:
+				value.AddMember(key, At<int>(component, field), allocator);
+				break;
+			case FieldType::UINT:
+				value.AddMember(key, At<unsigned>(component, field), allocator);
+				break;
+			case FieldType::UINT8:
+				value.AddMember(key, static_cast<int>(At<uint8_t>(component, field)), allocator);
+				break;
+			case FieldType::FLOAT:
+				value.AddMember(key, At<float>(component, field), allocator);
+				break;
+			case FieldType::DOUBLE:
+				value.AddMember(key, At<double>(component, field), allocator);
+				break;
+			case FieldType::VEC2: {
+				rapidjson::Value vec(rapidjson::kObjectType);
+				JSONSerializer::Vec2ToJSON(At<Vec2>(component, field), allocator, vec);
+				value.AddMember(key, vec, allocator);
+				break;
+			}
+			case FieldType::VEC3: {
+				rapidjson::Value vec(rapidjson::kObjectType);
+				JSONSerializer::Vec3ToJSON(At<Vec3>(component, field), allocator, vec);
+				value.AddMember(key, vec, allocator);
+				break;
+			}
+			case FieldType::STRING: {
+				rapidjson::Value text(rapidjson::kStringType);
+				JSONSerializer::StringToJSON(At<std::string>(component, field), allocator, text);
+				value.AddMember(key, text, allocator);
+				break;
+			}
+			}
+		}
+	}
+
+	void WriteBinary(void const* component, FieldTable const& table, unsigned char* out, StringTable& strings) {
+		unsigned char const* base = static_cast<unsigned char const*>(component);
+		for (FieldRun const& run : table.GetRuns()) {
+			std::memcpy(out, base + run.offset, run.size);
+			out += run.size;
+		}
+		for (uint32_t offset : table.GetStringOffsets()) {
+			uint32_t index = strings.Intern(*reinterpret_cast<std::string const*>(base + offset));
+			std::memcpy(out, &index, sizeof(index));
+			out += sizeof(index);
+		}
+	}
+
+	void ReadBinary(void* component, FieldTable const& table, unsigned char const* in, StringTable const& strings) {
+		unsigned char* base = static_cast<unsigned char*>(component);
+		for (FieldRun const& run : table.GetRuns()) {
+			std::memcpy(base + run.offset, in, run.size);
+			in += run.size;
+		}
+		for (uint32_t offset : table.GetStringOffsets()) {
+			uint32_t index;
+			std::memcpy(&index, in, sizeof(index));
+			in += sizeof(index);
+			*reinterpret_cast<std::string*>(base + offset) = strings.Get(index);
+		}
+	}
+}
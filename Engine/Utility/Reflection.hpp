@@ -0,0 +1,205 @@
+/*********************************************************************
+ * \file		Reflection.hpp
+ * \brief		Declares the field tables components describe
+ *				themselves with, and the serializer that reads and
+ *				writes any component by walking its table.
+ *
+ * \author		Yap Zi Yang Irwen, y.ziyangirwen, 2301345
+ * \email		y.ziyangirwen@digipen.edu
+ * \date		22 October 2024
+ *
+ * \copyright	Copyright(C) 2024 DigiPen Institute of Technology.
+ *				Reproduction or disclosure of this file or its
+ *              contents without the prior written consent of DigiPen
+ *              Institute of Technology is prohibited.
+ *********************************************************************/
+
+#ifndef REFLECTION_HPP
+#define REFLECTION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "Vec.hpp"
+
+namespace Reflection {
+
+	/**
+	 * \enum FieldType
+	 * \brief What a field holds, which decides how it is read and written.
+	 */
+	enum class FieldType : uint8_t {
+		BOOL,
+		INT,
+		UINT,
+		UINT8,		// Layers and sorting layers, saved as numbers
+		FLOAT,
+		DOUBLE,
+		VEC2,
+		VEC3,
+		STRING
+	};
+
+	enum FieldFlags : uint32_t {
+		FIELD_NONE = 0,
+		FIELD_OPTIONAL = 1u << 0	// Left as constructed when the JSON has no value for it, instead of zeroed
+	};
+
+	/**
+	 * \struct FieldDescriptor
+	 * \brief One saved field of a component: its key in JSON, and where it is in the component.
+	 */
+	struct FieldDescriptor {
+		char const* name;
+		uint32_t offset;
+		uint32_t size;
+		FieldType type;
+		uint32_t flags;
+	};
+
+	/**
+	 * \struct FieldRun
+	 * \brief Fields with no gap between them in the component, copied as one block in binary.
+	 */
+	struct FieldRun {
+		uint32_t offset;
+		uint32_t size;
+	};
+
+	/**
+	 * \class FieldTable
+	 * \brief Every saved field of a component, in the order they are saved in JSON.
+	 *
+	 * Built once per component by REFLECTABLE. The fields that are plain values are also merged
+	 * into runs by where they are in the component, so binary output copies a run at a time.
+	 */
+	class FieldTable {
+	public:
+		FieldTable(char const* component, std::initializer_list<FieldDescriptor> fields);
+
+		char const* GetComponentName() const { return m_component; }
+		std::vector<FieldDescriptor> const& GetFields() const { return m_fields; }
+		std::vector<FieldRun> const& GetRuns() const { return m_runs; }
+
+		/**
+		 * \brief Bytes the component takes in binary: its runs, then an interned index per string.
+		 */
+		size_t GetBinarySize() const { return m_binarySize; }
+
+		/**
+		 * \brief Where each string field is in the component, in the order their indices are written.
+		 */
+		std::vector<uint32_t> const& GetStringOffsets() const { return m_stringOffsets; }
+
+	private:
+		char const* m_component;
+		std::vector<FieldDescriptor> m_fields;
+		std::vector<FieldRun> m_runs;
+		std::vector<uint32_t> m_stringOffsets;
+		size_t m_binarySize = 0;
+	};
+
+	/**
+	 * \class StringTable
+	 * \brief Stores each distinct string once, so binary components refer to strings by index.
+	 */
+	class StringTable {
+	public:
+		uint32_t Intern(std::string_view value);
+
+		/**
+		 * \return The string, or an empty one if the index is out of range.
+		 */
+		std::string const& Get(uint32_t index) const;
+		size_t GetCount() const { return m_strings.size(); }
+		void Clear();
+
+	private:
+		std::deque<std::string> m_strings;							// Never moves a string, so the keys stay valid
+		std::unordered_map<std::string_view, uint32_t> m_indices;
+	};
+
+	template<typename T>
+	constexpr bool ALWAYS_FALSE = false;
+
+	/**
+	 * \brief The field type a C++ type is saved as.
+	 */
+	template<typename T>
+	constexpr FieldType TypeOf() {
+		if constexpr (std::is_same_v<T, bool>) return FieldType::BOOL;
+		else if constexpr (std::is_same_v<T, int>) return FieldType::INT;
+		else if constexpr (std::is_same_v<T, unsigned>) return FieldType::UINT;
+		else if constexpr (std::is_same_v<T, uint8_t>) return FieldType::UINT8;
+		else if constexpr (std::is_same_v<T, float>) return FieldType::FLOAT;
+		else if constexpr (std::is_same_v<T, double>) return FieldType::DOUBLE;
+		else if constexpr (std::is_same_v<T, Vec2>) return FieldType::VEC2;
+		else if constexpr (std::is_same_v<T, Vec3>) return FieldType::VEC3;
+		else if constexpr (std::is_same_v<T, std::string>) return FieldType::STRING;
+		else static_assert(ALWAYS_FALSE<T>, "Field type cannot be reflected");
+	}
+
+	/**
+	 * \brief A default constructed component that field offsets are measured against.
+	 */
+	template<typename Component>
+	Component const& GetProbe() {
+		static Component const probe{};
+		return probe;
+	}
+
+	/**
+	 * \brief Describes a field of a component, which may be declared in a base of the component.
+	 */
+	template<typename Component, typename Member, typename Owner>
+	FieldDescriptor MakeField(char const* name, Member Owner::* member, uint32_t flags = FIELD_NONE) {
+		Component const& probe = GetProbe<Component>();
+		auto offset = reinterpret_cast<unsigned char const*>(&(probe.*member)) - reinterpret_cast<unsigned char const*>(&probe);
+		return FieldDescriptor{ name, static_cast<uint32_t>(offset), static_cast<uint32_t>(sizeof(Member)), TypeOf<Member>(), flags };
+	}
+
+	/**
+	 * \brief Sets the fields of a component from the members of a JSON object.
+	 *
+	 * A missing field is zeroed, as JSONDeserializer does, unless it is FIELD_OPTIONAL.
+	 */
+	void ReadJSON(void* component, FieldTable const& table, rapidjson::Value const& value);
+	void WriteJSON(void const* component, FieldTable const& table, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator);
+
+	/**
+	 * \brief Writes GetBinarySize bytes, interning every string field.
+	 */
+	void WriteBinary(void const* component, FieldTable const& table, unsigned char* out, StringTable& strings);
+	void ReadBinary(void* component, FieldTable const& table, unsigned char const* in, StringTable const& strings);
+
+	template<typename Component>
+	void ReadJSON(Component& component, rapidjson::Value const& value) {
+		ReadJSON(&component, Component::Fields(), value);
+	}
+
+	template<typename Component>
+	void WriteJSON(Component const& component, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator) {
+		WriteJSON(&component, Component::Fields(), value, allocator);
+	}
+
+	template<typename Component>
+	void WriteBinary(Component const& component, unsigned char* out, StringTable& strings) {
+		WriteBinary(&component, Component::Fields(), out, strings);
+	}
+
+	template<typename Component>
+	void ReadBinary(Component& component, unsigned char const* in, StringTable const& strings) {
+		ReadBinary(&component, Component::Fields(), in, strings);
+	}
+}
+
+#endif // REFLECTION_HPP
@@ -1,6 +1,6 @@
 /*********************************************************************
  * \file		ReflectionMacros.hpp
- * \brief		Future use to reduce boilerplate code
+ * \brief		Macros components describe their saved fields with
  *
  * \author		y.ziyangirwen, 2301345 (y.ziyangirwen@digipen.edu)
  * \date		1 September 2024
@@ -14,16 +14,21 @@
 #ifndef REFLECTION_MACROS_HPP
 #define REFLECTION_MACROS_HPP
 
-#include <tuple>
-#include <type_traits>
-#include "../ECS/ECSManager.hpp"
-
-//extern ECSManager g_ecsManager;
+#include "Reflection.hpp"
 
+// Lists the saved fields of a component, in the order they are saved, e.g.
+//	REFLECTABLE(UI, FIELD(position), FIELD(scale), FIELD_KEY(rotation, "angle", Reflection::FIELD_OPTIONAL))
 #define REFLECTABLE(name, ...) \
-	constexpr const char* ComponentName() { return #name; } \
-	constexpr auto Reflect() { return std::make_tuple(__VA_ARGS__); }
+	static constexpr const char* ComponentName() { return #name; } \
+	static Reflection::FieldTable const& Fields() { \
+		using Self = name; \
+		static Reflection::FieldTable const table(#name, { __VA_ARGS__ }); \
+		return table; \
+	}
+
+#define FIELD(name) Reflection::MakeField<Self>(#name, &Self::name)
 
-#define FIELD(name) std::make_pair(#name, &std::remove_reference_t<decltype(*this)>::name)
+// A field saved under a key other than its name, or with flags
+#define FIELD_KEY(name, key, flags) Reflection::MakeField<Self>(key, &Self::name, flags)
 
 #endif // !REFLECTION_MACROS_HPP
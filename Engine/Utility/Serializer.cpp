@@ -30,6 +30,8 @@
 #include "../Components/VideoPlayer.hpp"
 
 #include "JSONParser.hpp"
+#include "Reflection.hpp"
+#include "CookedScene.hpp"
 #include "ComponentIDGenerator.hpp"
 #include "MetadataHandler.hpp"
 #include "../Tools/PrefabManager.hpp"
@@ -43,146 +45,389 @@
 #include "../Components/Camera.hpp"
 #include "../Scene/SceneManager.hpp"
 #include "../Layers/LayerManager.hpp"
+#include "Logger.hpp"
+
+namespace {
+	using Allocator = rapidjson::Document::AllocatorType;
+
+	/**
+	 * \struct ComponentSerializer
+	 * \brief Saves and loads one component under its key in the "Components" object of an entity.
+	 *
+	 * The fields come from the component's REFLECTABLE table. Only what is done around them, such
+	 * as handing a collider to the physics system, differs from one component to the next.
+	 */
+	struct ComponentSerializer {
+		const char* key;
+		CookedScene::SectionID section;
+		bool isInPrefabs;
+		bool (*has)(Entity entity);
+		void (*save)(Entity entity, rapidjson::Value& value, Allocator& allocator, bool isPrefab);
+		void (*load)(Entity entity, const rapidjson::Value& value);
+		const Reflection::FieldTable& (*fields)();
+
+		// Prefab templates: a component read once from JSON into a binary row, then cloned from the row.
+		// Cooked scenes are cloned from rows of the same form.
+		void (*cook)(const rapidjson::Value& value, unsigned char* row, PrefabTemplate& prefab);
+		void (*instantiate)(const unsigned char* row, const Reflection::StringTable& strings, const Entity* entities, size_t count, const Transform* transforms);
+	};
+
+	void ReadTransform(Transform& transform, const rapidjson::Value& value) {
+		Reflection::ReadJSON(transform, value);
+		if (transform.uuid == 0) transform.uuid = ComponentIDGenerator::GenerateID('t');
+	}
 
-Serializer& Serializer::GetInstance()
-{
-	static Serializer serializer;
-	return serializer;
-}
+	void ReadAnimation(Animation& animation, const rapidjson::Value& value) {
+		Reflection::ReadJSON(animation, value);
 
-void Serializer::SerializeScene(const std::string& scenePath) {
-#ifndef INSTALLER
-	rapidjson::Document document;
-	document.SetObject();
-	auto& allocator = document.GetAllocator();
+		animation.currentFrame = animation.startFrame;
+		animation.spriteWidth = 1.0f / animation.spritesPerRow;
+		animation.spriteHeight = 1.0f / animation.spritesPerCol;
+	}
 
-	rapidjson::Value entitiesArray(rapidjson::kArrayType);
+	void ReadScriptFields(ScriptFieldMap& entityFields, const rapidjson::Value& value) {
+		if (value.HasMember("parameters") && value["parameters"].IsObject()) {
+			for (auto it = value["parameters"].MemberBegin(); it != value["parameters"].MemberEnd(); ++it) {
+				std::string key = it->name.GetString();
+				const auto& paramObject = it->value;
 
-	for (auto& entt : EditorPanel::sceneEntities) {
-		Entity entity = entt.id;
+				if (paramObject.IsObject() && paramObject.HasMember("type") && paramObject.HasMember("value")) {
+					std::string type = paramObject["type"].GetString();
+				
+					ScriptFieldType fieldType = Utils::ScriptFieldTypeFromString(type);
+
+					ScriptFieldInstance scriptField;
+
+					switch (fieldType) {
+					case ScriptFieldType::None:
+						break;
+					case ScriptFieldType::Float:
+						scriptField.Field.Name = key;
+						scriptField.Field.Type = ScriptFieldType::Float;
+						scriptField.SetValue(paramObject["value"].GetFloat());
+						break;
+					case ScriptFieldType::Double:
+						scriptField.Field.Name = key;
+						scriptField.Field.Type = ScriptFieldType::Double;
+						scriptField.SetValue(paramObject["value"].GetDouble());
+						break;
+					case ScriptFieldType::Bool:
+						scriptField.Field.Name = key;
+						scriptField.Field.Type = ScriptFieldType::Bool;
+						scriptField.SetValue(paramObject["value"].GetBool());
+						break;
+					case ScriptFieldType::Short:
+						scriptField.Field.Name = key;
+						scriptField.Field.Type = ScriptFieldType::Short;
+						scriptField.SetValue<int64_t>(paramObject["value"].GetInt());
+						break;
+					case ScriptFieldType::Int:
+						scriptField.Field.Name = key;
+						scriptField.Field.Type = ScriptFieldType::Int;
+						scriptField.SetValue(paramObject["value"].GetInt());
+						break;
+					case ScriptFieldType::Long:
+						scriptField.Field.Name = key;
+						scriptField.Field.Type = ScriptFieldType::Long;
+						scriptField.SetValue(paramObject["value"].GetInt64());
+						break;
+					case ScriptFieldType::UShort:
+						scriptField.Field.Name = key;
+						scriptField.Field.Type = ScriptFieldType::UShort;
+						scriptField.SetValue<uint16_t>(static_cast<uint16_t>(paramObject["value"].GetUint()));
+						break;
+					case ScriptFieldType::UInt:
+						scriptField.Field.Name = key;
+						scriptField.Field.Type = ScriptFieldType::UInt;
+						scriptField.SetValue(paramObject["value"].GetUint());
+						break;
+					case ScriptFieldType::ULong:
+						scriptField.Field.Name = key;
+						scriptField.Field.Type = ScriptFieldType::ULong;
+						scriptField.SetValue(paramObject["value"].GetUint64());
+						break;
+					case ScriptFieldType::Entity:
+						scriptField.Field.Name = key;
+						scriptField.Field.Type = ScriptFieldType::Entity;
+						scriptField.SetValue(paramObject["value"].GetUint());
+						break;
+					}
+
+					entityFields[key] = scriptField;
+				}
+			}
+		}
+	}
 
-		rapidjson::Value entityData(rapidjson::kObjectType);
+	void ReadScriptComponent(ScriptComponent& script, const Entity& entity, const rapidjson::Value& value) {
+		Reflection::ReadJSON(script, value);
 
-		// Active, tags and layers
-		entityData.AddMember("Active", ECSManager::GetInstance().GetEntityManager().GetActive(entity), allocator);
-		entityData.AddMember("Tag", "", allocator);
-		entityData.AddMember("Layer", ECSManager::GetInstance().GetEntityManager().GetLayer(entity), allocator);
+		// Deserialize class name
+		script.className = JSONDeserializer::JSONToString(value, "className");
 
-		rapidjson::Value componentsData(rapidjson::kObjectType);
+		ReadScriptFields(ScriptEngine::GetScriptFieldMap(entity), value);
+	}
 
-		if (ECSManager::GetInstance().TryGetComponent<Name>(entity)) {
-			//const auto& nameComponent = ECSManager::GetInstance().GetComponent<Name>(entity);
-			rapidjson::Value nameData(rapidjson::kObjectType);
-			SerializeName(ECSManager::GetInstance().GetComponent<Name>(entity), nameData, allocator);
-			componentsData.AddMember("Name", nameData, allocator);
-		}
+	void WriteScriptComponent(const ScriptComponent& script, const Entity& entity, rapidjson::Value& value, Allocator& allocator) {
+		value.SetObject();
+
+		//std::shared_ptr<ScriptClass> entityClass = ScriptEngine::GetEntityClass(script.className);
+		//const auto& fields = entityClass->GetFields();
+		auto& entityFields = ScriptEngine::GetScriptFieldMap(entity);
+
+		// Serialize class name
+		rapidjson::Value classNameValue(rapidjson::kStringType);
+		classNameValue.SetString(script.className.c_str(), allocator);
+		value.AddMember("className", classNameValue, allocator);
+
+		// Serialize parameters with type information
+		rapidjson::Value parametersValue(rapidjson::kObjectType);
+		for (const auto& [fieldname, field] : entityFields) {
+			rapidjson::Value parameterValue(rapidjson::kObjectType);
+
+
+			rapidjson::Value fieldValue(rapidjson::kStringType);
+			JSONSerializer::StringToJSON(Utils::ScriptFieldTypeToString(field.Field.Type), allocator, fieldValue);
+			parameterValue.AddMember("type", fieldValue, allocator);
+
+			ScriptFieldInstance& scriptField = entityFields.at(fieldname);
+
+			switch (field.Field.Type) {
+			case ScriptFieldType::None:
+				break;
+			case ScriptFieldType::Float:
+				parameterValue.AddMember("value", scriptField.GetValue<float>(), allocator);
+				break;
+			case ScriptFieldType::Double:
+				parameterValue.AddMember("value", scriptField.GetValue<double>(), allocator);
+				break;
+			case ScriptFieldType::Bool:
+				parameterValue.AddMember("value", scriptField.GetValue<bool>(), allocator);
+				break;
+			case ScriptFieldType::Short:
+				parameterValue.AddMember("value", scriptField.GetValue<int16_t>(), allocator);
+				break;
+			case ScriptFieldType::Int:
+				parameterValue.AddMember("value", scriptField.GetValue<int32_t>(), allocator);
+				break;
+			case ScriptFieldType::Long:
+				parameterValue.AddMember("value", scriptField.GetValue<int64_t>(), allocator);
+				break;
+			case ScriptFieldType::UShort:
+				parameterValue.AddMember("value", scriptField.GetValue<uint16_t>(), allocator);
+				break;
+			case ScriptFieldType::UInt:
+				parameterValue.AddMember("value", scriptField.GetValue<uint32_t>(), allocator);
+				break;
+			case ScriptFieldType::ULong:
+				parameterValue.AddMember("value", scriptField.GetValue<uint64_t>(), allocator);
+				break;
+			case ScriptFieldType::Entity:
+				parameterValue.AddMember("value", scriptField.GetValue<uint32_t>(), allocator);
+				break;
+			}
 
-		if (ECSManager::GetInstance().TryGetComponent<Transform>(entity)) {
-			rapidjson::Value transformData(rapidjson::kObjectType);
-			SerializeTransform(ECSManager::GetInstance().GetComponent<Transform>(entity), transformData, allocator);
-			componentsData.AddMember("Transform", transformData, allocator);
+			rapidjson::Value keyValue(rapidjson::kStringType);
+			keyValue.SetString(fieldname.c_str(), allocator);
+			parametersValue.AddMember(keyValue, parameterValue , allocator);
 		}
+		value.AddMember("parameters", parametersValue, allocator);
+	}
 
-		if (ECSManager::GetInstance().TryGetComponent<Renderer>(entity)) {
-			const auto& rendererComponent = ECSManager::GetInstance().GetComponent<Renderer>(entity);
-			rapidjson::Value rendererData(rapidjson::kObjectType);
+	template<typename T>
+	bool HasComponent(Entity entity) {
+		return ECSManager::GetInstance().TryGetComponent<T>(entity).has_value();
+	}
 
-			rendererData.AddMember("mesh", rendererComponent.mesh, allocator);
-			rendererData.AddMember("isAnimated", rendererComponent.isAnimated, allocator);
-			rendererData.AddMember("sortingLayer", rendererComponent.sortingLayer, allocator);
+	template<typename T>
+	void SaveComponent(Entity entity, rapidjson::Value& value, Allocator& allocator, bool) {
+		Reflection::WriteJSON(ECSManager::GetInstance().GetComponent<T>(entity), value, allocator);
+	}
 
-			rapidjson::Value uuidStr(rapidjson::kStringType);
-			JSONSerializer::StringToJSON(rendererComponent.uuid, allocator, uuidStr);
-			rendererData.AddMember("textureFile", uuidStr, allocator);
+	template<typename T>
+	void LoadComponent(Entity entity, const rapidjson::Value& value) {
+		T component;
+		Reflection::ReadJSON(component, value);
+		ECSManager::GetInstance().AddComponent(entity, component);
+	}
 
-			componentsData.AddMember("Renderer", rendererData, allocator);
-		}
+	// Every entity is created with a name and a transform, so those two are loaded in place
+	void LoadName(Entity entity, const rapidjson::Value& value) {
+		Reflection::ReadJSON(ECSManager::GetInstance().GetComponent<Name>(entity), value);
+	}
 
-		if (ECSManager::GetInstance().TryGetComponent<AABBCollider2D>(entity)) {
-			const auto& colliderComponent = ECSManager::GetInstance().GetComponent<AABBCollider2D>(entity);
-			rapidjson::Value colliderData(rapidjson::kObjectType);
+	void LoadTransform(Entity entity, const rapidjson::Value& value) {
+		ReadTransform(ECSManager::GetInstance().GetComponent<Transform>(entity), value);
+	}
 
-			colliderData.AddMember("bounciness", colliderComponent.bounciness, allocator);
+	void SaveTransform(Entity entity, rapidjson::Value& value, Allocator& allocator, bool isPrefab) {
+		Reflection::WriteJSON(ECSManager::GetInstance().GetComponent<Transform>(entity), value, allocator);
 
-			rapidjson::Value minColData(rapidjson::kObjectType);
-			JSONSerializer::Vec2ToJSON(colliderComponent.min, allocator, minColData);
-			colliderData.AddMember("min", minColData, allocator);
+		// Every instance of a prefab is given its own UUID when it is loaded
+		if (isPrefab)
+			value["uuid"].SetInt(0);
+	}
 
-			rapidjson::Value maxColData(rapidjson::kObjectType);
-			JSONSerializer::Vec2ToJSON(colliderComponent.max, allocator, maxColData);
-			colliderData.AddMember("max", maxColData, allocator);
+	void LoadAABBCollider2D(Entity entity, const rapidjson::Value& value) {
+		AABBCollider2D collider;
+		Reflection::ReadJSON(collider, value);
+		ECSManager::GetInstance().physicsSystem->AddAABBColliderComponent(entity, collider.bounciness, collider.min, collider.max, collider.isTrigger);
+	}
 
-			colliderData.AddMember("isTrigger", colliderComponent.isTrigger, allocator);
+	void LoadRigidbody2D(Entity entity, const rapidjson::Value& value) {
+		Rigidbody2D rigidbody;
+		Reflection::ReadJSON(rigidbody, value);
+		ECSManager::GetInstance().AddComponent(entity, rigidbody);
+		ECSManager::GetInstance().physicsSystem->AddRigidbodyComponent(entity, rigidbody);
+	}
 
-			componentsData.AddMember("AABBCollider2D", colliderData, allocator);
-		}
+	void LoadAnimation(Entity entity, const rapidjson::Value& value) {
+		Animation animation;
+		ReadAnimation(animation, value);
+		ECSManager::GetInstance().AddComponent(entity, animation);
+	}
 
-		if (ECSManager::GetInstance().TryGetComponent<Rigidbody2D>(entity)) {
-			const auto& rbComponent = ECSManager::GetInstance().GetComponent<Rigidbody2D>(entity);
-			rapidjson::Value rbData(rapidjson::kObjectType);
+	void SaveScriptComponent(Entity entity, rapidjson::Value& value, Allocator& allocator, bool) {
+		WriteScriptComponent(ECSManager::GetInstance().GetComponent<ScriptComponent>(entity), entity, value, allocator);
+	}
 
-			rbData.AddMember("mass", rbComponent.mass, allocator);
-			//rbData.AddMember("inverseMass", rbComponent.mass, allocator);
-			rbData.AddMember("drag", rbComponent.drag, allocator);
-			rbData.AddMember("gravity", rbComponent.gravityScale, allocator);
-			rbData.AddMember("static", rbComponent.isStatic, allocator);
-			rbData.AddMember("kinematic", rbComponent.isKinematic, allocator);
-			rbData.AddMember("grounded", rbComponent.isGrounded, allocator);
+	void LoadScriptComponent(Entity entity, const rapidjson::Value& value) {
+		ScriptComponent script;
+		ReadScriptComponent(script, entity, value);
+		ECSManager::GetInstance().AddComponent(entity, script);
+	}
 
-			rapidjson::Value rbPos(rapidjson::kObjectType);
-			JSONSerializer::Vec2ToJSON(rbComponent.position, allocator, rbPos);
-			rbData.AddMember("pos", rbPos, allocator);
+	template<typename T>
+	void CookComponent(const rapidjson::Value& value, unsigned char* row, PrefabTemplate& prefab) {
+		T component;
+		Reflection::ReadJSON(component, value);
+		Reflection::WriteBinary(component, row, prefab.strings);
+	}
 
-			rapidjson::Value rbVel(rapidjson::kObjectType);
-			JSONSerializer::Vec2ToJSON(rbComponent.velocity, allocator, rbVel);
-			rbData.AddMember("vel", rbVel, allocator);
+	template<typename T>
+	T DecodeRow(const unsigned char* row, const Reflection::StringTable& strings) {
+		T component;
+		Reflection::ReadBinary(component, row, strings);
+		return component;
+	}
 
-			componentsData.AddMember("Rigidbody2D", rbData, allocator);
-		}
+	template<typename T>
+	void InstantiateComponent(const unsigned char* row, const Reflection::StringTable& strings, const Entity* entities, size_t count, const Transform*) {
+		ECSManager::GetInstance().AddComponents(entities, count, DecodeRow<T>(row, strings));
+	}
 
-		if (ECSManager::GetInstance().TryGetComponent<Animation>(entity)) {
-			rapidjson::Value animData(rapidjson::kObjectType);
-			SerializeAnimation(ECSManager::GetInstance().GetComponent<Animation>(entity), animData, allocator);
-			componentsData.AddMember("Animation", animData, allocator);
-		}
+	void CookName(const rapidjson::Value& value, unsigned char* row, PrefabTemplate& prefab) {
+		Name name;
+		Reflection::ReadJSON(name, value);
+		name.prefabID = prefab.prefabID;
+		name.prefabPath = prefab.path;
+		Reflection::WriteBinary(name, row, prefab.strings);
+	}
 
-		if (ECSManager::GetInstance().TryGetComponent<AudioSource>(entity)) {
-			rapidjson::Value asData(rapidjson::kObjectType);
-			SerializeAudioSource(ECSManager::GetInstance().GetComponent<AudioSource>(entity), asData, allocator);
-			componentsData.AddMember("AudioSource", asData, allocator);
+	void InstantiateName(const unsigned char* row, const Reflection::StringTable& strings, const Entity* entities, size_t count, const Transform*) {
+		Name name = DecodeRow<Name>(row, strings);
+		for (size_t i = 0; i < count; ++i) {
+			ECSManager::GetInstance().GetComponent<Name>(entities[i]) = name;
 		}
+	}
 
-		if (ECSManager::GetInstance().TryGetComponent<ScriptComponent>(entity)) {
-			const auto& scriptComponent = ECSManager::GetInstance().GetComponent<ScriptComponent>(entity);
-			rapidjson::Value scriptData(rapidjson::kObjectType);
-			SerializeScriptComponent(scriptComponent, entity, scriptData, allocator);
-			componentsData.AddMember("ScriptComponent", scriptData, allocator);
+	void InstantiateTransform(const unsigned char* row, const Reflection::StringTable& strings, const Entity* entities, size_t count, const Transform* transforms) {
+		Transform transform = DecodeRow<Transform>(row, strings);
+		for (size_t i = 0; i < count; ++i) {
+			Transform& t = ECSManager::GetInstance().GetComponent<Transform>(entities[i]);
+			t = transform;
+			if (transforms) {
+				t.position = transforms[i].position;
+				t.scale = transforms[i].scale;
+				t.rotation = transforms[i].rotation;
+				t.localPosition = transforms[i].localPosition;
+				t.localScale = transforms[i].localScale;
+				t.localRotation = transforms[i].localRotation;
+				t.updated = true;
+			}
+			if (t.uuid == 0) t.uuid = ComponentIDGenerator::GenerateID('t');
 		}
+	}
 
-		if (ECSManager::GetInstance().TryGetComponent<UI>(entity)) {
-			const auto& uiComponent = ECSManager::GetInstance().GetComponent<UI>(entity);
-			rapidjson::Value uiData(rapidjson::kObjectType);
-			SerializeUI(uiComponent, uiData, allocator);
-			componentsData.AddMember("UI", uiData, allocator);
+	void InstantiateAABBCollider2D(const unsigned char* row, const Reflection::StringTable& strings, const Entity* entities, size_t count, const Transform*) {
+		AABBCollider2D collider = DecodeRow<AABBCollider2D>(row, strings);
+		for (size_t i = 0; i < count; ++i) {
+			ECSManager::GetInstance().physicsSystem->AddAABBColliderComponent(entities[i], collider.bounciness, collider.min, collider.max, collider.isTrigger);
 		}
+	}
 
-		if (ECSManager::GetInstance().TryGetComponent<VideoPlayer>(entity)) {
-			rapidjson::Value vpData(rapidjson::kObjectType);
-			SerializeVideoPlayer(ECSManager::GetInstance().GetComponent<VideoPlayer>(entity), vpData, allocator);
-			componentsData.AddMember("VideoPlayer", vpData, allocator);
+	void InstantiateRigidbody2D(const unsigned char* row, const Reflection::StringTable& strings, const Entity* entities, size_t count, const Transform*) {
+		Rigidbody2D rigidbody = DecodeRow<Rigidbody2D>(row, strings);
+		ECSManager::GetInstance().AddComponents(entities, count, rigidbody);
+		for (size_t i = 0; i < count; ++i) {
+			ECSManager::GetInstance().physicsSystem->AddRigidbodyComponent(entities[i], rigidbody);
 		}
+	}
 
-		if (ECSManager::GetInstance().TryGetComponent<Textbox>(entity)) {
-			rapidjson::Value tbData(rapidjson::kObjectType);
-			SerializeTextbox(ECSManager::GetInstance().GetComponent<Textbox>(entity), tbData, allocator);
-			componentsData.AddMember("Textbox", tbData, allocator);
-		}
+	void InstantiateAnimation(const unsigned char* row, const Reflection::StringTable& strings, const Entity* entities, size_t count, const Transform*) {
+		Animation animation = DecodeRow<Animation>(row, strings);
+		animation.currentFrame = animation.startFrame;
+		animation.spriteWidth = 1.0f / animation.spritesPerRow;
+		animation.spriteHeight = 1.0f / animation.spritesPerCol;
+		ECSManager::GetInstance().AddComponents(entities, count, animation);
+	}
 
-		if (ECSManager::GetInstance().TryGetComponent<Camera>(entity)) {
-			rapidjson::Value cameraData(rapidjson::kObjectType);
-			SerializeCamera(ECSManager::GetInstance().GetComponent<Camera>(entity), cameraData, allocator);
-			componentsData.AddMember("Camera", cameraData, allocator);
+	void CookScriptComponent(const rapidjson::Value& value, unsigned char* row, PrefabTemplate& prefab) {
+		ScriptComponent script;
+		Reflection::ReadJSON(script, value);
+		Reflection::WriteBinary(script, row, prefab.strings);
+
+		ScriptFieldMap fields;
+		ReadScriptFields(fields, value);
+		prefab.scriptFields.clear();
+		for (auto& [name, field] : fields) {
+			prefab.scriptFields.push_back(field);
 		}
+	}
+
+	// In the order components are saved and loaded
+	const ComponentSerializer COMPONENT_SERIALIZERS[] = {
+		{ "Name", CookedScene::SECTION_NAME, true, HasComponent<Name>, SaveComponent<Name>, LoadName, Name::Fields, CookName, InstantiateName },
+		{ "Transform", CookedScene::SECTION_TRANSFORM, true, HasComponent<Transform>, SaveTransform, LoadTransform, Transform::Fields, CookComponent<Transform>, InstantiateTransform },
+		{ "Renderer", CookedScene::SECTION_RENDERER, true, HasComponent<Renderer>, SaveComponent<Renderer>, LoadComponent<Renderer>, Renderer::Fields, CookComponent<Renderer>, InstantiateComponent<Renderer> },
+		{ "AABBCollider2D", CookedScene::SECTION_AABB_COLLIDER, true, HasComponent<AABBCollider2D>, SaveComponent<AABBCollider2D>, LoadAABBCollider2D, AABBCollider2D::Fields, CookComponent<AABBCollider2D>, InstantiateAABBCollider2D },
+		{ "Rigidbody2D", CookedScene::SECTION_RIGIDBODY, true, HasComponent<Rigidbody2D>, SaveComponent<Rigidbody2D>, LoadRigidbody2D, Rigidbody2D::Fields, CookComponent<Rigidbody2D>, InstantiateRigidbody2D },
+		{ "Animation", CookedScene::SECTION_ANIMATION, true, HasComponent<Animation>, SaveComponent<Animation>, LoadAnimation, Animation::Fields, CookComponent<Animation>, InstantiateAnimation },
+		{ "AudioSource", CookedScene::SECTION_AUDIO_SOURCE, true, HasComponent<AudioSource>, SaveComponent<AudioSource>, LoadComponent<AudioSource>, AudioSource::Fields, CookComponent<AudioSource>, InstantiateComponent<AudioSource> },
+		{ "ScriptComponent", CookedScene::SECTION_SCRIPT, true, HasComponent<ScriptComponent>, SaveScriptComponent, LoadScriptComponent, ScriptComponent::Fields, CookScriptComponent, InstantiateComponent<ScriptComponent> },
+		{ "UI", CookedScene::SECTION_UI, true, HasComponent<UI>, SaveComponent<UI>, LoadComponent<UI>, UI::Fields, CookComponent<UI>, InstantiateComponent<UI> },
+		{ "VideoPlayer", CookedScene::SECTION_VIDEO_PLAYER, true, HasComponent<VideoPlayer>, SaveComponent<VideoPlayer>, LoadComponent<VideoPlayer>, VideoPlayer::Fields, CookComponent<VideoPlayer>, InstantiateComponent<VideoPlayer> },
+		{ "Textbox", CookedScene::SECTION_TEXTBOX, false, HasComponent<Textbox>, SaveComponent<Textbox>, LoadComponent<Textbox>, Textbox::Fields, CookComponent<Textbox>, InstantiateComponent<Textbox> },	// Prefabs have never saved textboxes
+		{ "Camera", CookedScene::SECTION_CAMERA, true, HasComponent<Camera>, SaveComponent<Camera>, LoadComponent<Camera>, Camera::Fields, CookComponent<Camera>, InstantiateComponent<Camera> }
+	};
+}
+
+Serializer& Serializer::GetInstance()
+{
+	static Serializer serializer;
+	return serializer;
+}
+
+void Serializer::SerializeScene(const std::string& scenePath) {
+#ifndef INSTALLER
+	rapidjson::Document document;
+	document.SetObject();
+	auto& allocator = document.GetAllocator();
+
+	rapidjson::Value entitiesArray(rapidjson::kArrayType);
+
+	for (auto& entt : EditorPanel::sceneEntities) {
+		Entity entity = entt.id;
+
+		rapidjson::Value entityData(rapidjson::kObjectType);
+
+		// Active, tags and layers
+		entityData.AddMember("Active", ECSManager::GetInstance().GetEntityManager().GetActive(entity), allocator);
+		entityData.AddMember("Tag", "", allocator);
+		entityData.AddMember("Layer", ECSManager::GetInstance().GetEntityManager().GetLayer(entity), allocator);
+
+		rapidjson::Value componentsData(rapidjson::kObjectType);
+		SerializeComponents(entity, componentsData, allocator, false);
 
 		// Add components to entity data
 		entityData.AddMember("Components", componentsData, allocator);
@@ -219,6 +464,12 @@ void Serializer::SerializeScene(const std::string& scenePath) {
 
 void Serializer::DeserializeScene(const std::string& scenePath)
 {
+	// A cooked file beside the JSON that turns out unusable falls back to the JSON
+	std::string cookedPath = CookedScene::FindLoadablePath(scenePath);
+	if (!cookedPath.empty() && (DeserializeCookedScene(cookedPath) || cookedPath == scenePath)) {
+		return;
+	}
+
 	std::ifstream ifs(scenePath);
 	std::string jsonContent((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
 
@@ -231,9 +482,13 @@ void Serializer::DeserializeScene(const std::string& scenePath)
 		const auto& entityData = entities[i];
 
 		Entity newEntity = ECSManager::GetInstance().CreateEntity();
+		if (newEntity == NO_ENTITY) {
+			Logger::Instance().Log(Logger::Level::ERR, "[Serializer] DeserializeScene: Loaded ", i, " of ", entities.Size(), " entities of ", scenePath);
+			break;
+		}
 
 		// Active, tags and layers
-		ECSManager::GetInstance().GetEntityManager().SetActive(newEntity, JSONDeserializer::JSONToBool(entityData, "Active"));
+		ECSManager::GetInstance().SetActive(newEntity, JSONDeserializer::JSONToBool(entityData, "Active"));
 		JSONDeserializer::JSONToString(entityData, "Tag");
 		if (entityData.HasMember("Layer"))
 			ECSManager::GetInstance().GetEntityManager().SetLayer(newEntity, static_cast<Layer>(entityData["Layer"].GetInt()));
@@ -246,102 +501,17 @@ void Serializer::DeserializeScene(const std::string& scenePath)
 
 		if (entityData.HasMember("Components")) {
 			const auto& components = entityData["Components"];
+			DeserializeComponents(newEntity, components, false);
 
 			if (components.HasMember("Name")) {
-				const auto& name = components["Name"];
-				Name& n = ECSManager::GetInstance().GetComponent<Name>(newEntity);
-				DeserializeName(n, name);
+				const Name& n = ECSManager::GetInstance().GetComponent<Name>(newEntity);
 				if (n.prefabID != "")
 					PrefabManager::GetInstance().prefabsMap[n.prefabID].push_back(newEntity);
 			}
 			if (components.HasMember("Transform")) {
-				const auto& transformVal = components["Transform"];
-				Transform& t = ECSManager::GetInstance().GetComponent<Transform>(newEntity);
-				DeserializeTransform(t, transformVal);
+				const Transform& t = ECSManager::GetInstance().GetComponent<Transform>(newEntity);
 				TransformSystem::uuidToTransformMap[t.uuid] = newEntity;
 			}
-			if (components.HasMember("Renderer")) {
-				const auto& renderer = components["Renderer"];
-
-				Renderer r;
-				r.mesh = renderer["mesh"].GetInt();
-				if (renderer.HasMember("isAnimated"))
-					r.isAnimated = renderer["isAnimated"].GetBool();
-				//r.currentTextureID = renderer["textureFile"].GetUint64();
-				r.uuid = JSONDeserializer::JSONToString(renderer, "textureFile");
-				if (renderer.HasMember("sortingLayer"))
-					r.sortingLayer = static_cast<SortingLayer>(renderer["sortingLayer"].GetInt());
-
-				ECSManager::GetInstance().AddComponent(newEntity, r);
-			}
-			if (components.HasMember("AABBCollider2D")) {
-				const auto& collider = components["AABBCollider2D"];
-
-				ECSManager::GetInstance().physicsSystem->AddAABBColliderComponent(
-					newEntity,
-					collider["bounciness"].GetFloat(),
-					JSONDeserializer::JSONToVec2(collider, "min"),
-					JSONDeserializer::JSONToVec2(collider, "max"),
-					collider["isTrigger"].GetBool()
-				);
-			}
-			if (components.HasMember("Rigidbody2D")) {
-				const auto& rb = components["Rigidbody2D"];
-
-				Rigidbody2D rigidbody;
-				rigidbody.position = JSONDeserializer::JSONToVec2(rb, "pos");
-				rigidbody.velocity = JSONDeserializer::JSONToVec2(rb, "vel");
-				rigidbody.mass = JSONDeserializer::JSONToFloat(rb, "mass");
-				rigidbody.drag = JSONDeserializer::JSONToFloat(rb, "drag");
-				rigidbody.gravityScale = JSONDeserializer::JSONToFloat(rb, "gravity");
-				rigidbody.isStatic = JSONDeserializer::JSONToBool(rb, "static");
-				rigidbody.isKinematic = JSONDeserializer::JSONToBool(rb, "kinematic");
-				rigidbody.isGrounded = JSONDeserializer::JSONToBool(rb, "grounded");
-				ECSManager::GetInstance().AddComponent(newEntity, rigidbody);
-				ECSManager::GetInstance().physicsSystem->AddRigidbodyComponent(newEntity, rigidbody);
-			}
-			if (components.HasMember("Animation")) {
-				const auto& animationVal = components["Animation"];
-				Animation animation;
-				DeserializeAnimation(animation, animationVal);
-				ECSManager::GetInstance().AddComponent(newEntity, animation);
-			}
-			if (components.HasMember("AudioSource")) {
-				const auto& as = components["AudioSource"];
-				AudioSource audioSource;
-				DeserializeAudioSource(audioSource, as);
-				ECSManager::GetInstance().AddComponent(newEntity, audioSource);
-			}
-			if (components.HasMember("ScriptComponent")) {
-				const auto& scriptVal = components["ScriptComponent"];
-				ScriptComponent script;
-				DeserializeScriptComponent(script, newEntity, scriptVal);
-				ECSManager::GetInstance().AddComponent(newEntity, script);
-			}
-			if (components.HasMember("UI")) {
-				const auto& uiVal = components["UI"];
-				UI ui;
-				DeserializeUI(ui, uiVal);
-				ECSManager::GetInstance().AddComponent(newEntity, ui);
-			}
-			if (components.HasMember("VideoPlayer")) {
-				const auto& as = components["VideoPlayer"];
-				VideoPlayer videoPlayer;
-				DeserializeVideoPlayer(videoPlayer, as);
-				ECSManager::GetInstance().AddComponent(newEntity, videoPlayer);
-			}
-			if (components.HasMember("Textbox")) {
-				const auto& tb = components["Textbox"];
-				Textbox textbox;
-				DeserializeTextbox(textbox, tb);
-				ECSManager::GetInstance().AddComponent(newEntity, textbox);
-			}
-			if (components.HasMember("Camera")) {
-				const auto& camData = components["Camera"];
-				Camera camera;
-				DeserializeCamera(camera, camData);
-				ECSManager::GetInstance().AddComponent(newEntity, camera);
-			}
 		}
 	}
 
@@ -358,6 +528,93 @@ void Serializer::DeserializeScene(const std::string& scenePath)
 	}
 }
 
+bool Serializer::DeserializeCookedScene(const std::string& cookedPath)
+{
+	CookedScene scene;
+	std::string error;
+	if (!scene.Open(cookedPath, error)) {
+		Logger::Instance().Log(Logger::Level::ERR, "[Serializer] DeserializeCookedScene: " + error);
+		return false;
+	}
+
+	CookedSceneCursor cursor;
+	CommitCookedScene(scene, cursor, scene.GetEntityCount());
+	return true;
+}
+
+bool Serializer::CommitCookedScene(const CookedScene& scene, CookedSceneCursor& cursor, uint32_t maxEntities)
+{
+	CookedScene::Column columns[std::size(COMPONENT_SERIALIZERS)];
+	for (uint32_t i = 0; i < std::size(COMPONENT_SERIALIZERS); ++i) {
+		columns[i] = scene.GetColumn(COMPONENT_SERIALIZERS[i].section);
+	}
+	CookedScene::Column scriptFields = scene.GetColumn(CookedScene::SECTION_SCRIPT_FIELDS);
+	auto const* fieldRecords = reinterpret_cast<CookedScene::ScriptFieldRecord const*>(scriptFields.rows);
+	const Reflection::StringTable& strings = scene.GetStrings();
+
+	// Open checked every column against the entity records, so each column is read front to back
+	// alongside the entities, and components are added in the same order the JSON loader adds them
+	auto& ecs = ECSManager::GetInstance();
+	CookedScene::EntityRecord const* entities = scene.GetEntities();
+	uint32_t end = scene.GetEntityCount() - cursor.entity > maxEntities ? cursor.entity + maxEntities : scene.GetEntityCount();
+	for (; cursor.entity < end; ++cursor.entity) {
+		CookedScene::EntityRecord const& entity = entities[cursor.entity];
+
+		Entity newEntity = ecs.CreateEntity();
+		if (newEntity == NO_ENTITY) {
+			// The rest of the scene is skipped, so the collision matrix is still set below
+			Logger::Instance().Log(Logger::Level::ERR, "[Serializer] CommitCookedScene: Loaded ", cursor.entity, " of ", scene.GetEntityCount(), " entities");
+			cursor.entity = scene.GetEntityCount();
+			break;
+		}
+		ecs.SetActive(newEntity, entity.isActive != 0);
+		if (entity.hasLayer)
+			ecs.GetEntityManager().SetLayer(newEntity, static_cast<Layer>(entity.layer));
+
+		for (uint32_t i = 0; i < std::size(COMPONENT_SERIALIZERS); ++i) {
+			const ComponentSerializer& serializer = COMPONENT_SERIALIZERS[i];
+			if (entity.components & (1u << serializer.section)) {
+				serializer.instantiate(columns[i].GetRow(cursor.records[serializer.section]++), strings, &newEntity, 1, nullptr);
+			}
+		}
+
+		uint32_t& field = cursor.records[CookedScene::SECTION_SCRIPT_FIELDS];
+		for (; field < scriptFields.count && scriptFields.entities[field] == cursor.entity; ++field) {
+			CookedScene::ScriptFieldRecord const& record = fieldRecords[field];
+			const std::string& key = strings.Get(record.name);
+			ScriptFieldInstance scriptField;
+			if (static_cast<ScriptFieldType>(record.type) != ScriptFieldType::None) {
+				scriptField.Field.Name = key;
+				scriptField.Field.Type = static_cast<ScriptFieldType>(record.type);
+				scriptField.SetValue(record.value);
+			}
+			ScriptEngine::GetScriptFieldMap(newEntity)[key] = scriptField;
+		}
+
+		if (entity.components & (1u << CookedScene::SECTION_NAME)) {
+			const Name& n = ecs.GetComponent<Name>(newEntity);
+			if (n.prefabID != "")
+				PrefabManager::GetInstance().prefabsMap[n.prefabID].push_back(newEntity);
+		}
+		if (entity.components & (1u << CookedScene::SECTION_TRANSFORM)) {
+			const Transform& t = ecs.GetComponent<Transform>(newEntity);
+			TransformSystem::uuidToTransformMap[t.uuid] = newEntity;
+		}
+	}
+
+	if (cursor.entity < scene.GetEntityCount()) {
+		return false;
+	}
+
+	uint32_t matrixCount = 0;
+	uint8_t const* matrix = scene.GetCollisionMatrix(matrixCount);
+	auto& collisionMatrix = LayerManager::GetInstance().collisionMatrix;
+	for (size_t i = 0; i < collisionMatrix.size(); ++i) {
+		collisionMatrix[i] = matrix ? (i < matrixCount && matrix[i] != 0) : true;
+	}
+	return true;
+}
+
 void Serializer::ReloadScene(const std::string& scenePath)
 {
 	std::ifstream ifs(scenePath);
@@ -386,7 +643,7 @@ void Serializer::ReloadScene(const std::string& scenePath)
 				const auto& transform = components["Transform"];
 
 				Transform& t = ECSManager::GetInstance().GetComponent<Transform>(entity);
-				DeserializeTransform(t, transform);
+				ReadTransform(t, transform);
 				t.updated = true;
 			}
 			if (components.HasMember("Renderer")) {
@@ -405,42 +662,35 @@ void Serializer::ReloadScene(const std::string& scenePath)
 				const auto& colliderVal = components["AABBCollider2D"];
 
 				AABBCollider2D& collider = ECSManager::GetInstance().GetComponent<AABBCollider2D>(entity);
-				DeserializeAABBCollider2D(collider, colliderVal);
+				Reflection::ReadJSON(collider, colliderVal);
 				collider.isUpdated = false;
 			}
 			if (components.HasMember("Rigidbody2D")) {
 				const auto& rb = components["Rigidbody2D"];
 
 				Rigidbody2D& rigidbody = ECSManager::GetInstance().GetComponent<Rigidbody2D>(entity);
-				rigidbody.position = JSONDeserializer::JSONToVec2(rb, "pos");
-				rigidbody.velocity = JSONDeserializer::JSONToVec2(rb, "vel");
-				rigidbody.mass = JSONDeserializer::JSONToFloat(rb, "mass");
-				rigidbody.drag = JSONDeserializer::JSONToFloat(rb, "drag");
-				rigidbody.gravityScale = JSONDeserializer::JSONToFloat(rb, "gravity");
-				rigidbody.isStatic = JSONDeserializer::JSONToBool(rb, "static");
-				rigidbody.isKinematic = JSONDeserializer::JSONToBool(rb, "kinematic");
-				rigidbody.isGrounded = JSONDeserializer::JSONToBool(rb, "grounded");
+				Reflection::ReadJSON(rigidbody, rb);
 			}
 			if (components.HasMember("Animation")) {
 				const auto& anim = components["Animation"];
 
 				Animation& animation = ECSManager::GetInstance().GetComponent<Animation>(entity);
-				DeserializeAnimation(animation, anim);
+				ReadAnimation(animation, anim);
 			}
 			if (components.HasMember("AudioSource")) {
 				const auto& as = components["AudioSource"];
 				AudioSource& audioSource = ECSManager::GetInstance().GetComponent<AudioSource>(entity);
-				DeserializeAudioSource(audioSource, as);
+				Reflection::ReadJSON(audioSource, as);
 			}
 			if (components.HasMember("ScriptComponent")) {
 				const auto& scriptVal = components["ScriptComponent"];
 				ScriptComponent& script = ECSManager::GetInstance().GetComponent<ScriptComponent>(entity);
-				DeserializeScriptComponent(script, entity, scriptVal);
+				ReadScriptComponent(script, entity, scriptVal);
 			}
 			if (components.HasMember("VideoPlayer")) {
 				const auto& vp = components["VideoPlayer"];
 				VideoPlayer& videoPlayer = ECSManager::GetInstance().GetComponent<VideoPlayer>(entity);
-				DeserializeVideoPlayer(videoPlayer, vp);
+				Reflection::ReadJSON(videoPlayer, vp);
 			}
 		}
 		++i;
@@ -455,133 +705,7 @@ void Serializer::SerializePrefab(const std::string& location, Entity entity) {
 	auto& allocator = document.GetAllocator();
 
 	rapidjson::Value componentsData(rapidjson::kObjectType);
-
-	const auto& nameComponent = ECSManager::GetInstance().GetComponent<Name>(entity);
-	rapidjson::Value nameData(rapidjson::kObjectType);
-
-	SerializeName(nameComponent, nameData, allocator);
-
-	//DeserializeName(nameComponent, nameData);
-
-	//rapidjson::Value nameStr(rapidjson::kStringType);
-	//JSONSerializer::StringToJSON(nameComponent.name, allocator, nameStr);
-	//nameData.AddMember("name", nameStr, allocator);
-
-	componentsData.AddMember("Name", nameData, allocator);
-
-	//if (ECSManager::GetInstance().TryGetComponent<Name>(entity)) {
-	//	const auto& nameComponent = ECSManager::GetInstance().GetComponent<Name>(entity);
-	//	rapidjson::Value nameData(rapidjson::kObjectType);
-
-	//	rapidjson::Value nameStr(rapidjson::kStringType);
-	//	JSONSerializer::StringToJSON(nameComponent.name, allocator, nameStr);
-	//	nameData.AddMember("name", nameStr, allocator);
-
-	//	componentsData.AddMember("Name", nameData, allocator);
-	//}
-
-	//if (ECSManager::GetInstance().TryGetComponent<Transform>(entity)) {
-	rapidjson::Value transformData(rapidjson::kObjectType);
-	SerializeTransform(ECSManager::GetInstance().GetComponent<Transform>(entity), transformData, allocator, true);
-	componentsData.AddMember("Transform", transformData, allocator);
-	//}
-
-	if (ECSManager::GetInstance().TryGetComponent<Renderer>(entity)) {
-		const auto& rendererComponent = ECSManager::GetInstance().GetComponent<Renderer>(entity);
-		rapidjson::Value rendererData(rapidjson::kObjectType);
-
-		rendererData.AddMember("mesh", rendererComponent.mesh, allocator);
-		rendererData.AddMember("isAnimated", rendererComponent.isAnimated, allocator);
-		rendererData.AddMember("sortingLayer", rendererComponent.sortingLayer, allocator);
-
-		rapidjson::Value uuidStr(rapidjson::kStringType);
-		JSONSerializer::StringToJSON(rendererComponent.uuid, allocator, uuidStr);
-		rendererData.AddMember("textureFile", uuidStr, allocator);
-
-		componentsData.AddMember("Renderer", rendererData, allocator);
-	}
-
-	if (ECSManager::GetInstance().TryGetComponent<AABBCollider2D>(entity)) {
-		const auto& colliderComponent = ECSManager::GetInstance().GetComponent<AABBCollider2D>(entity);
-		rapidjson::Value colliderData(rapidjson::kObjectType);
-
-		colliderData.AddMember("bounciness", colliderComponent.bounciness, allocator);
-
-		rapidjson::Value minColData(rapidjson::kObjectType);
-		JSONSerializer::Vec2ToJSON(colliderComponent.min, allocator, minColData);
-		colliderData.AddMember("min", minColData, allocator);
-
-		rapidjson::Value maxColData(rapidjson::kObjectType);
-		JSONSerializer::Vec2ToJSON(colliderComponent.max, allocator, maxColData);
-		colliderData.AddMember("max", maxColData, allocator);
-
-		colliderData.AddMember("isTrigger", colliderComponent.isTrigger, allocator);
-
-		componentsData.AddMember("AABBCollider2D", colliderData, allocator);
-	}
-
-	if (ECSManager::GetInstance().TryGetComponent<Rigidbody2D>(entity)) {
-		const auto& rbComponent = ECSManager::GetInstance().GetComponent<Rigidbody2D>(entity);
-		rapidjson::Value rbData(rapidjson::kObjectType);
-
-		rbData.AddMember("mass", rbComponent.mass, allocator);
-		//rbData.AddMember("inverseMass", rbComponent.mass, allocator);
-		rbData.AddMember("drag", rbComponent.drag, allocator);
-		rbData.AddMember("gravity", rbComponent.gravityScale, allocator);
-		rbData.AddMember("static", rbComponent.isStatic, allocator);
-		rbData.AddMember("kinematic", rbComponent.isKinematic, allocator);
-		rbData.AddMember("grounded", rbComponent.isGrounded, allocator);
-
-		rapidjson::Value rbPos(rapidjson::kObjectType);
-		JSONSerializer::Vec2ToJSON(rbComponent.position, allocator, rbPos);
-		rbData.AddMember("pos", rbPos, allocator);
-
-		rapidjson::Value rbVel(rapidjson::kObjectType);
-		JSONSerializer::Vec2ToJSON(rbComponent.velocity, allocator, rbVel);
-		rbData.AddMember("vel", rbVel, allocator);
-
-		componentsData.AddMember("Rigidbody2D", rbData, allocator);
-	}
-
-	if (ECSManager::GetInstance().TryGetComponent<Animation>(entity)) {
-		rapidjson::Value animData(rapidjson::kObjectType);
-		SerializeAnimation(ECSManager::GetInstance().GetComponent<Animation>(entity), animData, allocator);
-		componentsData.AddMember("Animation", animData, allocator);
-	}
-
-	if (ECSManager::GetInstance().TryGetComponent<AudioSource>(entity)) {
-		rapidjson::Value asData(rapidjson::kObjectType);
-		SerializeAudioSource(ECSManager::GetInstance().GetComponent<AudioSource>(entity), asData, allocator);
-		componentsData.AddMember("AudioSource", asData, allocator);
-	}
-
-	if (ECSManager::GetInstance().TryGetComponent<ScriptComponent>(entity)) {
-		const auto& scriptComponent = ECSManager::GetInstance().GetComponent<ScriptComponent>(entity);
-		rapidjson::Value scriptData(rapidjson::kObjectType);
-		SerializeScriptComponent(scriptComponent, entity, scriptData, allocator);
-		componentsData.AddMember("ScriptComponent", scriptData, allocator);
-	}
-
-	if (ECSManager::GetInstance().TryGetComponent<UI>(entity)) {
-		const auto& uiComponent = ECSManager::GetInstance().GetComponent<UI>(entity);
-		rapidjson::Value uiData(rapidjson::kObjectType);
-		SerializeUI(uiComponent, uiData, allocator);
-		componentsData.AddMember("UI", uiData, allocator);
-	}
-
-	if (ECSManager::GetInstance().TryGetComponent<VideoPlayer>(entity)) {
-		const auto& vpComponent = ECSManager::GetInstance().GetComponent<VideoPlayer>(entity);
-		rapidjson::Value vpData(rapidjson::kObjectType);
-		SerializeVideoPlayer(vpComponent, vpData, allocator);
-		componentsData.AddMember("VideoPlayer", vpData, allocator);
-	}
-
-	if (ECSManager::GetInstance().TryGetComponent<Camera>(entity)) {
-		const auto& camComponent = ECSManager::GetInstance().GetComponent<Camera>(entity);
-		rapidjson::Value cameraData(rapidjson::kObjectType);
-		SerializeCamera(camComponent, cameraData, allocator);
-		componentsData.AddMember("Camera", cameraData, allocator);
-	}
+	SerializeComponents(entity, componentsData, allocator, true);
 
 	// Add entities array to the document
 	document.AddMember("Components", componentsData, allocator);
@@ -597,109 +721,75 @@ void Serializer::SerializePrefab(const std::string& location, Entity entity) {
 }
 
 Entity Serializer::DeserializePrefab(const std::string& prefabPath)
+{
+	Entity newEntity = ECSManager::GetInstance().CreateEntity();
+	if (newEntity == NO_ENTITY)
+		return NO_ENTITY;
+
+	const PrefabTemplate* prefab = PrefabManager::GetInstance().GetPrefabTemplate(prefabPath);
+	if (prefab)
+		InstantiatePrefabTemplate(*prefab, &newEntity, 1, nullptr);
+
+	return newEntity;
+}
+
+bool Serializer::BuildPrefabTemplate(const std::string& prefabPath, PrefabTemplate& prefab)
 {
 	std::ifstream ifs(prefabPath);
+	if (!ifs.is_open()) {
+		Logger::Instance().Log(Logger::Level::ERR, "[Serializer] BuildPrefabTemplate: Cannot open ", prefabPath);
+		return false;
+	}
 	std::string jsonContent((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
 
 	rapidjson::Document document;
 	document.Parse(jsonContent.c_str());
-
+	if (document.HasParseError() || !document.IsObject() || !document.HasMember("Components") || !document["Components"].IsObject()) {
+		Logger::Instance().Log(Logger::Level::ERR, "[Serializer] BuildPrefabTemplate: Not a prefab ", prefabPath);
+		return false;
+	}
 	const auto& components = document["Components"];
 
-	Entity newEntity = ECSManager::GetInstance().CreateEntity();
-
-	if (components.HasMember("Name")) {
-		const auto& name = components["Name"];
-		auto& n = ECSManager::GetInstance().GetComponent<Name>(newEntity);
-		DeserializeName(n, name);
-		std::string prefabMeta = prefabPath + ".meta";
-		n.prefabID = MetadataHandler::ParseUUIDFromMeta(prefabMeta);
-		n.prefabPath = prefabPath;
-	}
-	if (components.HasMember("Transform")) {
-		const auto& transformVal = components["Transform"];
-		Transform& t = ECSManager::GetInstance().GetComponent<Transform>(newEntity);
-		t.parentUUID = 0;
-		DeserializeTransform(t, transformVal);
-	}
-	if (components.HasMember("Renderer")) {
-		const auto& renderer = components["Renderer"];
-
-		Renderer r;
-		r.mesh = renderer["mesh"].GetInt();
-		if (renderer.HasMember("isAnimated"))
-			r.isAnimated = renderer["isAnimated"].GetBool();
-		//r.currentTextureID = renderer["textureFile"].GetUint64();
-		r.uuid = JSONDeserializer::JSONToString(renderer, "textureFile");
-		if (renderer.HasMember("sortingLayer"))
-			r.sortingLayer = static_cast<SortingLayer>(renderer["sortingLayer"].GetInt());
-
-		ECSManager::GetInstance().AddComponent(newEntity, r);
+	prefab.path = prefabPath;
+	prefab.prefabID = MetadataHandler::ParseUUIDFromMeta(prefabPath + ".meta");
+	prefab.components = 0;
+	prefab.rows.clear();
+	prefab.strings.Clear();
+	prefab.scriptFields.clear();
+
+	for (uint32_t i = 0; i < std::size(COMPONENT_SERIALIZERS); ++i) {
+		const ComponentSerializer& serializer = COMPONENT_SERIALIZERS[i];
+		auto member = components.FindMember(serializer.key);
+		if (!serializer.isInPrefabs || member == components.MemberEnd())
+			continue;
+
+		size_t offset = prefab.rows.size();
+		prefab.rows.resize(offset + serializer.fields().GetBinarySize());
+		serializer.cook(member->value, prefab.rows.data() + offset, prefab);
+		prefab.components |= 1u << i;
 	}
-	if (components.HasMember("AABBCollider2D")) {
-		const auto& collider = components["AABBCollider2D"];
-
-		ECSManager::GetInstance().physicsSystem->AddAABBColliderComponent(
-			newEntity,
-			collider["bounciness"].GetFloat(),
-			JSONDeserializer::JSONToVec2(collider, "min"),
-			JSONDeserializer::JSONToVec2(collider, "max"),
-			collider["isTrigger"].GetBool()
-		);
-	}
-	if (components.HasMember("Rigidbody2D")) {
-		const auto& rb = components["Rigidbody2D"];
+	return true;
+}
 
-		Rigidbody2D rigidbody;
-		rigidbody.position = JSONDeserializer::JSONToVec2(rb, "pos");
-		rigidbody.velocity = JSONDeserializer::JSONToVec2(rb, "vel");
-		rigidbody.mass = JSONDeserializer::JSONToFloat(rb, "mass");
-		rigidbody.drag = JSONDeserializer::JSONToFloat(rb, "drag");
-		rigidbody.gravityScale = JSONDeserializer::JSONToFloat(rb, "gravity");
-		rigidbody.isStatic = JSONDeserializer::JSONToBool(rb, "static");
-		rigidbody.isKinematic = JSONDeserializer::JSONToBool(rb, "kinematic");
-		rigidbody.isGrounded = JSONDeserializer::JSONToBool(rb, "grounded");
-		ECSManager::GetInstance().AddComponent(newEntity, rigidbody);
-		ECSManager::GetInstance().physicsSystem->AddRigidbodyComponent(newEntity, rigidbody);
-	}
-	if (components.HasMember("Animation")) {
-		const auto& animationVal = components["Animation"];
-		Animation animation;
-		DeserializeAnimation(animation, animationVal);
-		ECSManager::GetInstance().AddComponent(newEntity, animation);
-	}
-	if (components.HasMember("AudioSource")) {
-		const auto& as = components["AudioSource"];
-		AudioSource audioSource;
-		DeserializeAudioSource(audioSource, as);
-		ECSManager::GetInstance().AddComponent(newEntity, audioSource);
-	}
-	if (components.HasMember("ScriptComponent")) {
-		const auto& scriptVal = components["ScriptComponent"];
-		ScriptComponent script;
-		DeserializeScriptComponent(script, newEntity, scriptVal);
-		ECSManager::GetInstance().AddComponent(newEntity, script);
-	}
-	if (components.HasMember("UI")) {
-		const auto& uiVal = components["UI"];
-		UI ui;
-		DeserializeUI(ui, uiVal);
-		ECSManager::GetInstance().AddComponent(newEntity, ui);
-	}
-	if (components.HasMember("VideoPlayer")) {
-		const auto& as = components["VideoPlayer"];
-		VideoPlayer videoPlayer;
-		DeserializeVideoPlayer(videoPlayer, as);
-		ECSManager::GetInstance().AddComponent(newEntity, videoPlayer);
-	}
-	if (components.HasMember("Camera")) {
-		const auto& camData = components["Camera"];
-		Camera camera;
-		DeserializeCamera(camera, camData);
-		ECSManager::GetInstance().AddComponent(newEntity, camera);
+void Serializer::InstantiatePrefabTemplate(const PrefabTemplate& prefab, const Entity* entities, size_t count, const Transform* transforms)
+{
+	const unsigned char* row = prefab.rows.data();
+	for (uint32_t i = 0; i < std::size(COMPONENT_SERIALIZERS); ++i) {
+		if (!(prefab.components & (1u << i)))
+			continue;
+
+		const ComponentSerializer& serializer = COMPONENT_SERIALIZERS[i];
+		serializer.instantiate(row, prefab.strings, entities, count, transforms);
+		row += serializer.fields().GetBinarySize();
 	}
 
-	return newEntity;
+	// Script parameters have no field table, so they are kept beside the rows
+	for (size_t i = 0; i < count && !prefab.scriptFields.empty(); ++i) {
+		auto& entityFields = ScriptEngine::GetScriptFieldMap(entities[i]);
+		for (const ScriptFieldInstance& field : prefab.scriptFields) {
+			entityFields[field.Field.Name] = field;
+		}
+	}
 }
 
 void Serializer::LoadEngineConfig(EngineConfig& config)
@@ -725,372 +815,56 @@ void Serializer::LoadEngineConfig(EngineConfig& config)
 	config.sceneName = document["Scene"].GetString();
 	config.isFullscreen = document["Fullscreen"].GetBool();
 	config.graphicsQuality = document["Graphics Quality"].GetString();
-}
-
-void Serializer::DeserializeName(Name& name, const rapidjson::Value& value) {
-	name.name = JSONDeserializer::JSONToString(value, "name");
-	name.prefabID = JSONDeserializer::JSONToString(value, "prefabID");
-	name.prefabPath = JSONDeserializer::JSONToString(value, "prefabPath");
-}
-
-void Serializer::DeserializeTransform(Transform& transform, const rapidjson::Value& value) {
-	transform.uuid = JSONDeserializer::JSONtoUInt32(value, "uuid");
-	if (transform.uuid == 0) transform.uuid = ComponentIDGenerator::GenerateID('t');
-	transform.parentUUID = JSONDeserializer::JSONtoUInt32(value, "parentUUID");
-	transform.position = JSONDeserializer::JSONToVec3(value, "position");
-	transform.scale = JSONDeserializer::JSONToVec3(value, "scale");
-	transform.rotation = JSONDeserializer::JSONToVec3(value, "rotation");
-	transform.localPosition = JSONDeserializer::JSONToVec3(value, "localPosition");
-	transform.localScale = JSONDeserializer::JSONToVec3(value, "localScale");
-	transform.localRotation = JSONDeserializer::JSONToVec3(value, "localRotation");
-}
-
-void Serializer::DeserializeRenderer(Renderer& renderer, const rapidjson::Value& value)
-{
-	renderer; value;
-}
-
-void Serializer::DeserializeAnimation(Animation& animation, const rapidjson::Value& value) {
-	animation.spritesPerRow = value["spritesPerRow"].GetUint();
-	animation.spritesPerCol = value["spritesPerCol"].GetUint();
-	animation.numFrames = value["numFrames"].GetUint();
-
-	animation.startFrame = value["startFrame"].GetUint();
-	animation.endFrame = value["endFrame"].GetUint();
-
-	animation.currentFrame = animation.startFrame;
-
-	animation.timePerFrame = value["timePerFrame"].GetDouble();
-
-	animation.isLooping = value["isLooping"].GetBool();
-
-	animation.playOnce = JSONDeserializer::JSONToBool(value, "playOnce");
-
-	animation.spriteWidth = 1.0f / animation.spritesPerRow;
-	animation.spriteHeight = 1.0f / animation.spritesPerCol;
-}
-
-void Serializer::DeserializeAudioSource(AudioSource& audioSource, const rapidjson::Value& value) {
-	audioSource.audioClipUUID = value["audioClipUUID"].GetString();
-	audioSource.isPlaying = value["isPlaying"].GetBool();
-	audioSource.isLooping = value["isLooping"].GetBool();
-}
-
-void Serializer::DeserializeAABBCollider2D(AABBCollider2D& collider, const rapidjson::Value& value) {
-	collider.bounciness = value["bounciness"].GetFloat();
-	collider.min = JSONDeserializer::JSONToVec2(value, "min");
-	collider.max = JSONDeserializer::JSONToVec2(value, "max");
-	collider.isTrigger = value["isTrigger"].GetBool();
-}
-
-void Serializer::DeserializeScriptComponent(ScriptComponent& script, const Entity& entity, const rapidjson::Value& value) {
-	// Deserialize class name
-	script.className = JSONDeserializer::JSONToString(value, "className");
-
-	auto& entityFields = ScriptEngine::GetScriptFieldMap(entity);
-
-	if (value.HasMember("parameters") && value["parameters"].IsObject()) {
-		for (auto it = value["parameters"].MemberBegin(); it != value["parameters"].MemberEnd(); ++it) {
-			std::string key = it->name.GetString();
-			const auto& paramObject = it->value;
-
-			if (paramObject.IsObject() && paramObject.HasMember("type") && paramObject.HasMember("value")) {
-				std::string type = paramObject["type"].GetString();
-				
-				ScriptFieldType fieldType = Utils::ScriptFieldTypeFromString(type);
-
-				ScriptFieldInstance scriptField;
-
-				switch (fieldType) {
-				case ScriptFieldType::None:
-					break;
-				case ScriptFieldType::Float:
-					scriptField.Field.Name = key;
-					scriptField.Field.Type = ScriptFieldType::Float;
-					scriptField.SetValue(paramObject["value"].GetFloat());
-					break;
-				case ScriptFieldType::Double:
-					scriptField.Field.Name = key;
-					scriptField.Field.Type = ScriptFieldType::Double;
-					scriptField.SetValue(paramObject["value"].GetDouble());
-					break;
-				case ScriptFieldType::Bool:
-					scriptField.Field.Name = key;
-					scriptField.Field.Type = ScriptFieldType::Bool;
-					scriptField.SetValue(paramObject["value"].GetBool());
-					break;
-				case ScriptFieldType::Short:
-					scriptField.Field.Name = key;
-					scriptField.Field.Type = ScriptFieldType::Short;
-					scriptField.SetValue<int64_t>(paramObject["value"].GetInt());
-					break;
-				case ScriptFieldType::Int:
-					scriptField.Field.Name = key;
-					scriptField.Field.Type = ScriptFieldType::Int;
-					scriptField.SetValue(paramObject["value"].GetInt());
-					break;
-				case ScriptFieldType::Long:
-					scriptField.Field.Name = key;
-					scriptField.Field.Type = ScriptFieldType::Long;
-					scriptField.SetValue(paramObject["value"].GetInt64());
-					break;
-				case ScriptFieldType::UShort:
-					scriptField.Field.Name = key;
-					scriptField.Field.Type = ScriptFieldType::UShort;
-					scriptField.SetValue<uint16_t>(static_cast<uint16_t>(paramObject["value"].GetUint()));
-					break;
-				case ScriptFieldType::UInt:
-					scriptField.Field.Name = key;
-					scriptField.Field.Type = ScriptFieldType::UInt;
-					scriptField.SetValue(paramObject["value"].GetUint());
-					break;
-				case ScriptFieldType::ULong:
-					scriptField.Field.Name = key;
-					scriptField.Field.Type = ScriptFieldType::ULong;
-					scriptField.SetValue(paramObject["value"].GetUint64());
-					break;
-				case ScriptFieldType::Entity:
-					scriptField.Field.Name = key;
-					scriptField.Field.Type = ScriptFieldType::Entity;
-					scriptField.SetValue(paramObject["value"].GetUint());
-					break;
-				}
-
-				entityFields[key] = scriptField;
-			}
-		}
+	if (document.HasMember("Worker Threads") && document["Worker Threads"].IsInt()) {
+		config.workerThreads = document["Worker Threads"].GetInt();
 	}
-}
-
-void Serializer::DeserializeUI(UI& ui, const rapidjson::Value& value) {
-	ui.position = JSONDeserializer::JSONToVec3(value, "position");
-	ui.scale = JSONDeserializer::JSONToVec2(value, "scale");
-	ui.size = JSONDeserializer::JSONToVec2(value, "size");
-	ui.rotation = JSONDeserializer::JSONToFloat(value, "rotation");
-}
-
-void Serializer::DeserializeTextbox(Textbox& tb, const rapidjson::Value& value) {
-	tb.color = JSONDeserializer::JSONToVec3(value, "color");
-	tb.text = JSONDeserializer::JSONToString(value, "text");
-	tb.fontUUID = JSONDeserializer::JSONToString(value, "fontUUID");
-	tb.centerAligned = JSONDeserializer::JSONToBool(value, "centerAligned");
-}
-
-void Serializer::DeserializeVideoPlayer(VideoPlayer& vp, const rapidjson::Value& value) {
-	vp.videoClipUUID = value["videoClipUUID"].GetString();
-	vp.isPlaying = value["isPlaying"].GetBool();
-	vp.playOnAwake = value["playOnAwake"].GetBool();
-	vp.isLooping = value["isLooping"].GetBool();
-}
-
-void Serializer::DeserializeCamera(Camera& cam, const rapidjson::Value& value) {
-	cam.zoom = JSONDeserializer::JSONToFloat(value, "zoom");
-	cam.width = JSONDeserializer::JSONToFloat(value, "width");
-	cam.height = JSONDeserializer::JSONToFloat(value, "height");
-
-	cam.isMainCamera = JSONDeserializer::JSONToBool(value, "isMainCamera");
-	cam.isActive = JSONDeserializer::JSONToBool(value, "isActive");
-	
-	cam.bloomIntensity = JSONDeserializer::JSONToFloat(value, "bloomIntensity");
-
-	cam.vignetteStrength = JSONDeserializer::JSONToFloat(value, "vignetteStrength");
-	cam.vignetteSoftness = JSONDeserializer::JSONToFloat(value, "vignetteSoftness");
-	cam.vignetteCenter = JSONDeserializer::JSONToVec2(value, "vignetteCenter");
-}
-
-void Serializer::SerializeName(const Name& name, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value nameStr(rapidjson::kStringType);
-	JSONSerializer::StringToJSON(name.name, allocator, nameStr);
-	value.AddMember("name", nameStr, allocator);
-
-	rapidjson::Value prefabID(rapidjson::kStringType);
-	JSONSerializer::StringToJSON(name.prefabID, allocator, prefabID);
-	value.AddMember("prefabID", prefabID, allocator);
-
-	rapidjson::Value prefabPath(rapidjson::kStringType);
-	JSONSerializer::StringToJSON(name.prefabPath, allocator, prefabPath);
-	value.AddMember("prefabPath", prefabPath, allocator);
-}
-
-void Serializer::SerializeTransform(const Transform& transform, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator, bool isPrefab) {
-	if (!isPrefab)
-		value.AddMember("uuid", transform.uuid, allocator);
-	else
-		value.AddMember("uuid", 0, allocator);
-
-	value.AddMember("parentUUID", transform.parentUUID, allocator);
-
-	rapidjson::Value positionData(rapidjson::kObjectType);
-	JSONSerializer::Vec3ToJSON(transform.position, allocator, positionData);
-	value.AddMember("position", positionData, allocator);
-
-	rapidjson::Value scaleData(rapidjson::kObjectType);
-	JSONSerializer::Vec3ToJSON(transform.scale, allocator, scaleData);
-	value.AddMember("scale", scaleData, allocator);
-
-	rapidjson::Value rotationData(rapidjson::kObjectType);
-	JSONSerializer::Vec3ToJSON(transform.rotation, allocator, rotationData);
-	value.AddMember("rotation", rotationData, allocator);
-
-	rapidjson::Value lpositionData(rapidjson::kObjectType);
-	JSONSerializer::Vec3ToJSON(transform.localPosition, allocator, lpositionData);
-	value.AddMember("localPosition", lpositionData, allocator);
-
-	rapidjson::Value lscaleData(rapidjson::kObjectType);
-	JSONSerializer::Vec3ToJSON(transform.localScale, allocator, lscaleData);
-	value.AddMember("localScale", lscaleData, allocator);
-
-	rapidjson::Value lrotationData(rapidjson::kObjectType);
-	JSONSerializer::Vec3ToJSON(transform.localRotation, allocator, lrotationData);
-	value.AddMember("localRotation", lrotationData, allocator);
-}
-
-void Serializer::SerializeAnimation(const Animation& animation, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator) {
-	value.AddMember("spritesPerRow", animation.spritesPerRow, allocator);
-	value.AddMember("spritesPerCol", animation.spritesPerCol, allocator);
-	value.AddMember("numFrames", animation.numFrames, allocator);
-
-	value.AddMember("startFrame", animation.startFrame, allocator);
-	value.AddMember("endFrame", animation.endFrame, allocator);
-
-	value.AddMember("timePerFrame", animation.timePerFrame, allocator);
-
-	value.AddMember("isLooping", animation.isLooping, allocator);
-
-	value.AddMember("playOnce", animation.playOnce, allocator);
-}
-
-void Serializer::SerializeAudioSource(const AudioSource& audioSource, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value uuidStr(rapidjson::kStringType);
-	JSONSerializer::StringToJSON(audioSource.audioClipUUID, allocator, uuidStr);
-	value.AddMember("audioClipUUID", uuidStr, allocator);
-
-	value.AddMember("isPlaying", audioSource.isPlaying, allocator);
-	value.AddMember("isLooping", audioSource.isLooping, allocator);
-}
-
-void Serializer::SerializeScriptComponent(const ScriptComponent& script, const Entity& entity, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator) {
-	value.SetObject();
-
-	//std::shared_ptr<ScriptClass> entityClass = ScriptEngine::GetEntityClass(script.className);
-	//const auto& fields = entityClass->GetFields();
-	auto& entityFields = ScriptEngine::GetScriptFieldMap(entity);
-
-	// Serialize class name
-	rapidjson::Value classNameValue(rapidjson::kStringType);
-	classNameValue.SetString(script.className.c_str(), allocator);
-	value.AddMember("className", classNameValue, allocator);
-
-	// Serialize parameters with type information
-	rapidjson::Value parametersValue(rapidjson::kObjectType);
-	for (const auto& [fieldname, field] : entityFields) {
-		rapidjson::Value parameterValue(rapidjson::kObjectType);
-
-
-		rapidjson::Value fieldValue(rapidjson::kStringType);
-		JSONSerializer::StringToJSON(Utils::ScriptFieldTypeToString(field.Field.Type), allocator, fieldValue);
-		parameterValue.AddMember("type", fieldValue, allocator);
-
-		ScriptFieldInstance& scriptField = entityFields.at(fieldname);
-
-		switch (field.Field.Type) {
-		case ScriptFieldType::None:
-			break;
-		case ScriptFieldType::Float:
-			parameterValue.AddMember("value", scriptField.GetValue<float>(), allocator);
-			break;
-		case ScriptFieldType::Double:
-			parameterValue.AddMember("value", scriptField.GetValue<double>(), allocator);
-			break;
-		case ScriptFieldType::Bool:
-			parameterValue.AddMember("value", scriptField.GetValue<bool>(), allocator);
-			break;
-		case ScriptFieldType::Short:
-			parameterValue.AddMember("value", scriptField.GetValue<int16_t>(), allocator);
-			break;
-		case ScriptFieldType::Int:
-			parameterValue.AddMember("value", scriptField.GetValue<int32_t>(), allocator);
-			break;
-		case ScriptFieldType::Long:
-			parameterValue.AddMember("value", scriptField.GetValue<int64_t>(), allocator);
-			break;
-		case ScriptFieldType::UShort:
-			parameterValue.AddMember("value", scriptField.GetValue<uint16_t>(), allocator);
-			break;
-		case ScriptFieldType::UInt:
-			parameterValue.AddMember("value", scriptField.GetValue<uint32_t>(), allocator);
-			break;
-		case ScriptFieldType::ULong:
-			parameterValue.AddMember("value", scriptField.GetValue<uint64_t>(), allocator);
-			break;
-		case ScriptFieldType::Entity:
-			parameterValue.AddMember("value", scriptField.GetValue<uint32_t>(), allocator);
-			break;
-		}
-
-		rapidjson::Value keyValue(rapidjson::kStringType);
-		keyValue.SetString(fieldname.c_str(), allocator);
-		parametersValue.AddMember(keyValue, parameterValue , allocator);
+	if (document.HasMember("Sprite Instancing") && document["Sprite Instancing"].IsBool()) {
+		config.spriteInstancing = document["Sprite Instancing"].GetBool();
+	}
+	if (document.HasMember("Texture Atlas") && document["Texture Atlas"].IsBool()) {
+		config.textureAtlas = document["Texture Atlas"].GetBool();
+	}
+	if (document.HasMember("Texture Upload Budget") && document["Texture Upload Budget"].IsNumber()) {
+		config.textureUploadBudget = document["Texture Upload Budget"].GetDouble();
+	}
+	if (document.HasMember("View Culling") && document["View Culling"].IsBool()) {
+		config.viewCulling = document["View Culling"].GetBool();
+	}
+	if (document.HasMember("Cull Margin") && document["Cull Margin"].IsNumber()) {
+		config.cullMargin = document["Cull Margin"].GetFloat();
+	}
+	if (document.HasMember("Texture Budget") && document["Texture Budget"].IsNumber()) {
+		config.textureBudget = document["Texture Budget"].GetDouble();
+	}
+	if (document.HasMember("Font Budget") && document["Font Budget"].IsNumber()) {
+		config.fontBudget = document["Font Budget"].GetDouble();
+	}
+	if (document.HasMember("Video Budget") && document["Video Budget"].IsNumber()) {
+		config.videoBudget = document["Video Budget"].GetDouble();
+	}
+	if (document.HasMember("Audio Budget") && document["Audio Budget"].IsNumber()) {
+		config.audioBudget = document["Audio Budget"].GetDouble();
 	}
-	value.AddMember("parameters", parametersValue, allocator);
-}
-
-void Serializer::SerializeUI(const UI& ui, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value positionData(rapidjson::kObjectType);
-	JSONSerializer::Vec3ToJSON(ui.position, allocator, positionData);
-	value.AddMember("position", positionData, allocator);
-
-	rapidjson::Value scaleData(rapidjson::kObjectType);
-	JSONSerializer::Vec2ToJSON(ui.scale, allocator, scaleData);
-	value.AddMember("scale", scaleData, allocator);
-
-	rapidjson::Value sizeData(rapidjson::kObjectType);
-	JSONSerializer::Vec2ToJSON(ui.size, allocator, sizeData);
-	value.AddMember("size", sizeData, allocator);
-
-	value.AddMember("rotation", ui.rotation, allocator);
-}
-
-void Serializer::SerializeVideoPlayer(const VideoPlayer& vp, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value uuidStr(rapidjson::kStringType);
-	JSONSerializer::StringToJSON(vp.videoClipUUID, allocator, uuidStr);
-	value.AddMember("videoClipUUID", uuidStr, allocator);
-
-	value.AddMember("isPlaying", vp.isPlaying, allocator);
-	value.AddMember("playOnAwake", vp.playOnAwake, allocator);
-	value.AddMember("isLooping", vp.isLooping, allocator);
 }
 
-void Serializer::SerializeTextbox(const Textbox& tb, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator) {
-	rapidjson::Value colorData(rapidjson::kObjectType);
-	JSONSerializer::Vec3ToJSON(tb.color, allocator, colorData);
-	value.AddMember("color", colorData, allocator);
-
-	rapidjson::Value textData(rapidjson::kStringType);
-	JSONSerializer::StringToJSON(tb.text, allocator, textData);
-	value.AddMember("text", textData, allocator);
-
-	rapidjson::Value fontUUID(rapidjson::kStringType);
-	JSONSerializer::StringToJSON(tb.fontUUID, allocator, fontUUID);
-	value.AddMember("fontUUID", fontUUID, allocator);
+void Serializer::SerializeComponents(Entity entity, rapidjson::Value& components, rapidjson::Document::AllocatorType& allocator, bool isPrefab) {
+	for (const ComponentSerializer& serializer : COMPONENT_SERIALIZERS) {
+		if ((isPrefab && !serializer.isInPrefabs) || !serializer.has(entity))
+			continue;
 
-	value.AddMember("centerAligned", tb.centerAligned, allocator);
+		rapidjson::Value data(rapidjson::kObjectType);
+		serializer.save(entity, data, allocator, isPrefab);
+		components.AddMember(rapidjson::StringRef(serializer.key), data, allocator);
+	}
 }
 
-void Serializer::SerializeCamera(const Camera& cam, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator) {
-	value.AddMember("zoom", cam.zoom, allocator);
-	value.AddMember("width", cam.width, allocator);
-	value.AddMember("height", cam.height, allocator);
-
-	value.AddMember("isMainCamera", cam.isMainCamera, allocator);
-	value.AddMember("isActive", cam.isActive, allocator);
-
-	value.AddMember("bloomIntensity", cam.bloomIntensity, allocator);
+void Serializer::DeserializeComponents(Entity entity, const rapidjson::Value& components, bool isPrefab) {
+	for (const ComponentSerializer& serializer : COMPONENT_SERIALIZERS) {
+		if (isPrefab && !serializer.isInPrefabs)
+			continue;
 
-	value.AddMember("vignetteStrength", cam.vignetteStrength, allocator);
-	value.AddMember("vignetteSoftness", cam.vignetteSoftness, allocator);
-
-	rapidjson::Value vignetteCenter(rapidjson::kObjectType);
-	JSONSerializer::Vec2ToJSON(cam.vignetteCenter, allocator, vignetteCenter);
-	value.AddMember("vignetteCenter", vignetteCenter, allocator);
+		auto member = components.FindMember(serializer.key);
+		if (member != components.MemberEnd())
+			serializer.load(entity, member->value);
+	}
 }
@@ -18,23 +18,16 @@
 #include <rapidjson/document.h>
 #include <rapidjson/prettywriter.h>
 
+#include "CookedScene.hpp"
+
 using Entity = uint32_t;
 
 /**
- \brief Forward declarations for component structures.
+ \brief Forward declarations.
 */
 struct EngineConfig;
-struct Name;
+struct PrefabTemplate;
 struct Transform;
-struct Renderer;
-struct Animation;
-struct AudioSource;
-struct AABBCollider2D;
-struct ScriptComponent;
-struct UI;
-struct VideoPlayer;
-struct Textbox;
-struct Camera;
 
 /**
  \class Serializer
@@ -58,140 +51,102 @@ public:
     void SerializeScene(const std::string& scenePath);
 
     /**
-     \brief Deserializes a scene from a JSON file.
+     \brief Deserializes a scene from a JSON file, or from a cooked scene if the path has the cooked extension.
+
+     The player loads the cooked scene beside the JSON instead when there is one that is up to date.
      \param scenePath The path of the scene file to load.
     */
     void DeserializeScene(const std::string& scenePath);
 
     /**
-     \brief Reloads a scene by deserializing it from the provided file path.
-     \param scenePath The path of the scene file to reload.
+     \brief Loads a scene cooked by CookedScene::Cook, reading its components in place from the mapped file.
+     \param cookedPath The path of the cooked scene.
+     \return False, with nothing loaded, if the file is missing, stale in format or corrupt.
     */
-    void ReloadScene(const std::string& scenePath);
+    bool DeserializeCookedScene(const std::string& cookedPath);
 
     /**
-     \brief Serializes an entity into a prefab JSON file.
-     \param prefabPath The path to save the prefab.
-     \param entity The entity to serialize as a prefab.
+     \brief Where CommitCookedScene is up to: the next entity, and the next row of every section.
     */
-    void SerializePrefab(const std::string& prefabPath, Entity entity);
+    struct CookedSceneCursor {
+        uint32_t entity = 0;
+        uint32_t records[CookedScene::MAX_SECTIONS]{};
+    };
 
     /**
-     \brief Deserializes an entity from a prefab JSON file.
-     \param prefabPath The path of the prefab file to load.
-     \return The deserialized entity.
-    */
-    Entity DeserializePrefab(const std::string& prefabPath);
+     \brief Adds up to maxEntities more entities of an open cooked scene to the ECS, continuing from the cursor.
 
-    /**
-     \brief Loads the engine configuration from a file.
-     \param config The reference to an EngineConfig object to populate.
-    */
-    void LoadEngineConfig(EngineConfig& config);
-
-private:
-
-    /**
-     \brief Deserializes a Name component from a JSON object.
-     \param name The Name object to populate.
-     \param value The JSON object containing the Name data.
+     Lets a scene be added a chunk at a time. The collision matrix is set with the last chunk.
+     \param scene The cooked scene, which must stay open until every entity is added.
+     \param cursor Where the previous call stopped, zeroed for the first call.
+     \param maxEntities The most entities to add.
+     \return True once every entity of the scene has been added.
     */
-    void DeserializeName(Name& name, const rapidjson::Value& value);
+    bool CommitCookedScene(const CookedScene& scene, CookedSceneCursor& cursor, uint32_t maxEntities);
 
     /**
-     \brief Deserializes a Transform component from a JSON object.
-     \param transform The Transform object to populate.
-     \param value The JSON object containing the Transform data.
+     \brief Reloads a scene by deserializing it from the provided file path.
+     \param scenePath The path of the scene file to reload.
     */
-    void DeserializeTransform(Transform& transform, const rapidjson::Value& value);
+    void ReloadScene(const std::string& scenePath);
 
     /**
-     \brief Deserializes a Renderer component from a JSON object.
-     \param renderer The Renderer object to populate.
-     \param value The JSON object containing the Renderer data.
+     \brief Serializes an entity into a prefab JSON file.
+     \param prefabPath The path to save the prefab.
+     \param entity The entity to serialize as a prefab.
     */
-    void DeserializeRenderer(Renderer& renderer, const rapidjson::Value& value);
+    void SerializePrefab(const std::string& prefabPath, Entity entity);
 
     /**
-     \brief Deserializes an Animation component from a JSON object.
-     \param animation The Animation object to populate.
-     \param value The JSON object containing the Animation data.
+     \brief Deserializes an entity from a prefab JSON file, through the template PrefabManager caches for it.
+     \param prefabPath The path of the prefab file to load.
+     \return The deserialized entity.
     */
-    void DeserializeAnimation(Animation& animation, const rapidjson::Value& value);
+    Entity DeserializePrefab(const std::string& prefabPath);
 
     /**
-     \brief Deserializes an AudioSource component from a JSON object.
-     \param audioSource The AudioSource object to populate.
-     \param value The JSON object containing the AudioSource data.
+     \brief Parses a prefab file into a template its instances can be cloned from without reading the file again.
+     \param prefabPath The path of the prefab file.
+     \param prefab The template to fill. Its modification time is left for the caller to set.
+     \return False if the file cannot be read or is not a prefab.
     */
-    void DeserializeAudioSource(AudioSource& audioSource, const rapidjson::Value& value);
+    bool BuildPrefabTemplate(const std::string& prefabPath, PrefabTemplate& prefab);
 
     /**
-     \brief Deserializes an AABBCollider2D component from a JSON object.
-     \param collider The AABBCollider2D object to populate.
-     \param value The JSON object containing the collider data.
+     \brief Adds the components of a prefab template to entities, each component to all of them at once.
+     \param prefab The template to clone.
+     \param entities The entities, newly created, to add the components to.
+     \param count The number of entities.
+     \param transforms Position, scale and rotation of each entity, or nullptr to keep the prefab's.
     */
-    void DeserializeAABBCollider2D(AABBCollider2D& collider, const rapidjson::Value& value);
+    void InstantiatePrefabTemplate(const PrefabTemplate& prefab, const Entity* entities, size_t count, const Transform* transforms);
 
     /**
-     \brief Deserializes a ScriptComponent from a JSON object.
-     \param scriptComponent The ScriptComponent object to populate.
-     \param entity The entity associated with this script component.
-     \param value The JSON object containing the ScriptComponent data.
+     \brief Loads the engine configuration from a file.
+     \param config The reference to an EngineConfig object to populate.
     */
-    void DeserializeScriptComponent(ScriptComponent& scriptComponent, const Entity& entity, const rapidjson::Value& value);
+    void LoadEngineConfig(EngineConfig& config);
 
-    void DeserializeUI(UI& ui, const rapidjson::Value& value);
-    void DeserializeVideoPlayer(VideoPlayer& vp, const rapidjson::Value& value);
-    void DeserializeCamera(Camera& cam, const rapidjson::Value& value);
-    void DeserializeTextbox(Textbox& ui, const rapidjson::Value& value);
+private:
 
     /**
-     \brief Serializes a Name component into a JSON object.
-     \param name The Name object to serialize.
-     \param value The JSON object to populate with Name data.
-     \param allocator The RapidJSON allocator for memory management.
-    */
-    void SerializeName(const Name& name, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator);
+     \brief Saves every component of an entity into the "Components" object of a scene or prefab.
 
-    /**
-     \brief Serializes a Transform component into a JSON object.
-     \param transform The Transform object to serialize.
-     \param value The JSON object to populate with Transform data.
+     Walks the component serializer table, which reads and writes each component through its REFLECTABLE field table.
+     \param entity The entity whose components are saved.
+     \param components The JSON object to add a member to per component.
      \param allocator The RapidJSON allocator for memory management.
      \param isPrefab Flag indicating whether the serialization is for a prefab.
     */
-    void SerializeTransform(const Transform& transform, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator, bool isPrefab = false);
-
-    /**
-     \brief Serializes an Animation component into a JSON object.
-     \param animation The Animation object to serialize.
-     \param value The JSON object to populate with Animation data.
-     \param allocator The RapidJSON allocator for memory management.
-    */
-    void SerializeAnimation(const Animation& animation, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator);
+    void SerializeComponents(Entity entity, rapidjson::Value& components, rapidjson::Document::AllocatorType& allocator, bool isPrefab);
 
     /**
-     \brief Serializes an AudioSource component into a JSON object.
-     \param audioSource The AudioSource object to serialize.
-     \param value The JSON object to populate with AudioSource data.
-     \param allocator The RapidJSON allocator for memory management.
-    */
-    void SerializeAudioSource(const AudioSource& audioSource, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator);
-
-    /**
-     \brief Serializes a ScriptComponent into a JSON object.
-     \param scriptComponent The ScriptComponent object to serialize.
-     \param entity The entity associated with this script component.
-     \param value The JSON object to populate with ScriptComponent data.
-     \param allocator The RapidJSON allocator for memory management.
+     \brief Adds the components in a "Components" object to an entity, in the order they are saved.
+     \param entity The entity to add the components to.
+     \param components The JSON object holding a member per component.
+     \param isPrefab Flag indicating whether the components come from a prefab.
     */
-    void SerializeScriptComponent(const ScriptComponent& scriptComponent, const Entity& entity, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator);
-
-    void SerializeUI(const UI& ui, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator);
-    void SerializeVideoPlayer(const VideoPlayer& vp, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator);
-    void SerializeCamera(const Camera& cam, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator);
-    void SerializeTextbox(const Textbox& ui, rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator);
+    void DeserializeComponents(Entity entity, const rapidjson::Value& components, bool isPrefab);
 };
 
 
@@ -120,6 +120,13 @@ bool VideoClip::LoadFromFile(const std::string& filePath)
     return true;
 }
 
+size_t VideoClip::GetMemorySize() const
+{
+    TextureArray const& textureArray = Texture::textureArrays[texArrayIndex];
+    size_t numFrames = texLayerEndIndex - texLayerStartIndex + 1;
+    return numFrames * static_cast<size_t>(textureArray.width) * static_cast<size_t>(textureArray.height) * 4;
+}
+
 size_t VideoClip::SetTextureArrayToUse(int widthImage, int heightImage)
 {
     bool newArrayFlag{ false };
@@ -131,7 +138,7 @@ size_t VideoClip::SetTextureArrayToUse(int widthImage, int heightImage)
             newArrayFlag = true;
         }
 
-        if (Texture::textureArrays[i].width == widthImage && Texture::textureArrays[i].height == heightImage && Texture::textureArrays[i].id_gl != 0) {
+        if (Texture::textureArrays[i].width == widthImage && Texture::textureArrays[i].height == heightImage && Texture::textureArrays[i].id_gl != 0 && !Texture::textureArrays[i].isAtlas) {
             texArrayIndex = i;
             newArrayFlag = false;
             break;
@@ -23,6 +23,8 @@ public:
 	~VideoClip() = default;
 
 	bool LoadFromFile(const std::string& filePath) override;
+	size_t GetMemorySize() const override;	// Its frames in the texture array, as 4 bytes a pixel
+	bool IsEvictableAlone() const override { return false; }	// Its frames stay in arrays shared by their size
 	size_t SetTextureArrayToUse(int widthImage, int heightImage);
 
 	void CopyAllTextureLayers(GLuint srcTex, GLuint destTex, int width, int height, int numLayers);